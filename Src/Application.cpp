@@ -34,9 +34,24 @@ int Application::Run()
 			return messageResult;
 
 		Update();
+
+		if (!m_benchmarkResultPath.empty() && !cameraPath.IsReplaying())
+			return cameraPath.SaveReplayResult(m_benchmarkResultPath) ? EXIT_SUCCESS : EXIT_FAILURE;
 	}
 }
 
+void Application::StartBenchmark(const std::filesystem::path& cameraPathFile, const std::filesystem::path& resultPath)
+{
+	THROW_INTERNAL_ERROR_IF("Failed to load camera path for benchmark", !cameraPath.LoadFromFile(cameraPathFile));
+
+	cameraPath.StartReplay();
+
+	// without vsync replay frame times aren't clamped to display refresh rate
+	graphics.SetVSync(false);
+
+	m_benchmarkResultPath = resultPath;
+}
+
 void Application::InitializeScene()
 {
 	scene.BeginInitialization(graphics);
@@ -63,7 +78,13 @@ void Application::InitializeScene()
 
 void Application::Update()
 {
-	graphics.BeginFrame(time.Mark());
+	float deltaTime = time.Mark();
+
+	// replay drives camera and timestep, so every run goes through the same frames
+	if (cameraPath.IsReplaying())
+		deltaTime = cameraPath.Replay(*scene.GetCurrentCamera());
+
+	graphics.BeginFrame(deltaTime);
 
 	ImguiLayer& imguiLayer = graphics.GetRenderer().GetImguiLayer();
 
@@ -88,11 +109,18 @@ void Application::Update()
 	graphics.GetRenderer().DrawImguiWindow(graphics);
 	imguiLayer.DrawDemoWindow();
 	graphics.GetProfiler().Draw();
+	cameraPath.Draw();
 
 	if (window.input.GetKeyDown(KEY_P))
 		scene.AddSceneObjectFromFile(graphics, "Assets/Models/glTF/DamagedHelmet/glTF/DamagedHelmet.gltf");
 
-	scene.Update(graphics, window.input, window.GetCursorLocked());
+	if (cameraPath.IsReplaying())
+		scene.Update(graphics, replayInput, false);
+	else
+		scene.Update(graphics, window.input, window.GetCursorLocked());
+
+	if (cameraPath.IsRecording())
+		cameraPath.Record(*scene.GetCurrentCamera());
 
 	graphics.Render(scene, time.Peek());
 
@@ -5,6 +5,7 @@
 #include "Scene/SceneObject.h"
 #include "Scene/Objects/Camera.h"
 #include "Scene/Scene.h"
+#include "Scene/CameraPath.h"
 #include "Graphics/Core/Pipeline.h"
 
 class Application
@@ -19,6 +20,9 @@ public:
 public:
 	int Run();
 
+	// replays camera path over the scene, saves frame time percentiles into resultPath and exits once replay ends
+	void StartBenchmark(const std::filesystem::path& cameraPathFile, const std::filesystem::path& resultPath);
+
 	void InitializeScene();
 
 	void Update();
@@ -31,4 +35,8 @@ private:
 	Window window;
 	Graphics graphics;
 	Scene scene;
+
+	CameraPath cameraPath;
+	Input replayInput; // stays empty, so user can't move camera during replay
+	std::filesystem::path m_benchmarkResultPath;
 };
\ No newline at end of file
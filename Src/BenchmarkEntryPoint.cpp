@@ -0,0 +1,32 @@
+#include "Includes/CppIncludes.h"
+#include "Error/ErrorHandler.h"
+#include "BenchmarkRunner.h"
+
+// entry point of Benchmark configuration. It's a console program without window, so benchmarks can run on build machines
+// and report failures through exit code and stderr instead of message boxes
+int main(int argc, char* argv[])
+{
+	try
+	{
+		std::vector<std::string> arguments(argv + 1, argv + argc);
+
+		if (std::optional<int> benchmarkResult = BenchmarkRunner::RunIfRequested(arguments))
+			return *benchmarkResult;
+
+		std::cerr << "No benchmark requested, use --scene-benchmark, --light-clusters-benchmark or --occlusion-benchmark <output.json>, or --replay-stream <capture.tcmd>\n";
+	}
+	catch (ErrorHandler::Exception& except)
+	{
+		std::cerr << except.GetErrorType() << ": " << except.what() << "\n";
+	}
+	catch (std::exception& except)
+	{
+		std::cerr << "Standard Error: " << except.what() << "\n";
+	}
+	catch (...)
+	{
+		std::cerr << "Unknown Error\n";
+	}
+
+	return EXIT_FAILURE;
+}
\ No newline at end of file
@@ -0,0 +1,153 @@
+#include "BenchmarkRunner.h"
+#include "Scene/SyntheticScene.h"
+#include "Graphics/RenderGraph/LightClusters.h"
+#include "Graphics/Core/OcclusionCuller.h"
+#include "Graphics/Profiler/CommandStreamReplay.h"
+#include "System/JobSystem.h"
+#include "Macros/ErrorMacros.h"
+
+static std::optional<int> RunSceneBenchmarkIfRequested(const std::vector<std::string>& arguments)
+{
+	if (std::find(arguments.begin(), arguments.end(), "--scene-benchmark") == arguments.end())
+		return std::nullopt;
+
+	SyntheticScene::Params params;
+	unsigned int numFrames = 100;
+	std::string outputPath = "scene_benchmark.json";
+
+	for (size_t argumentIndex = 0; argumentIndex + 1 < arguments.size(); argumentIndex++)
+	{
+		const std::string& option = arguments[argumentIndex];
+		const std::string& value = arguments[argumentIndex + 1];
+
+		if (option == "--scene-benchmark")
+			outputPath = value;
+		else if (option == "--objects")
+			params.numObjects = unsigned int(std::stoul(value));
+		else if (option == "--materials")
+			params.numMaterials = unsigned int(std::stoul(value));
+		else if (option == "--lights")
+			params.numLights = unsigned int(std::stoul(value));
+		else if (option == "--depth")
+			params.hierarchyDepth = unsigned int(std::stoul(value));
+		else if (option == "--motion")
+			params.motionFraction = std::stof(value);
+		else if (option == "--seed")
+			params.seed = unsigned int(std::stoul(value));
+		else if (option == "--frames")
+			numFrames = unsigned int(std::stoul(value));
+		else if (option == "--draw-packets")
+			params.drawPackets = value != "0";
+		else if (option == "--instancing")
+			params.instancing = value != "0";
+	}
+
+	SyntheticScene::BenchmarkResult result = SyntheticScene::Benchmark(params, numFrames);
+
+	return SyntheticScene::SaveBenchmarkResult(result, outputPath) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static std::optional<int> RunLightClustersBenchmarkIfRequested(const std::vector<std::string>& arguments)
+{
+	if (std::find(arguments.begin(), arguments.end(), "--light-clusters-benchmark") == arguments.end())
+		return std::nullopt;
+
+	unsigned int numLights = 1024;
+	std::string outputPath = "light_clusters_benchmark.json";
+
+	for (size_t argumentIndex = 0; argumentIndex + 1 < arguments.size(); argumentIndex++)
+	{
+		const std::string& option = arguments[argumentIndex];
+		const std::string& value = arguments[argumentIndex + 1];
+
+		if (option == "--light-clusters-benchmark")
+			outputPath = value;
+		else if (option == "--lights")
+			numLights = unsigned int(std::stoul(value));
+	}
+
+	JobSystem jobSystem;
+
+	LightClusters::BenchmarkResult result = LightClusters::Benchmark(jobSystem, numLights);
+
+	return LightClusters::SaveBenchmarkResult(result, outputPath) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static std::optional<int> RunOcclusionBenchmarkIfRequested(const std::vector<std::string>& arguments)
+{
+	if (std::find(arguments.begin(), arguments.end(), "--occlusion-benchmark") == arguments.end())
+		return std::nullopt;
+
+	unsigned int numOccluders = 128;
+	unsigned int numCandidates = 10000;
+	std::string outputPath = "occlusion_benchmark.json";
+
+	for (size_t argumentIndex = 0; argumentIndex + 1 < arguments.size(); argumentIndex++)
+	{
+		const std::string& option = arguments[argumentIndex];
+		const std::string& value = arguments[argumentIndex + 1];
+
+		if (option == "--occlusion-benchmark")
+			outputPath = value;
+		else if (option == "--occluders")
+			numOccluders = unsigned int(std::stoul(value));
+		else if (option == "--candidates")
+			numCandidates = unsigned int(std::stoul(value));
+	}
+
+	OcclusionCuller::BenchmarkResult result = OcclusionCuller::Benchmark(numOccluders, numCandidates);
+
+	return OcclusionCuller::SaveBenchmarkResult(result, outputPath) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static std::optional<int> RunStreamReplayIfRequested(const std::vector<std::string>& arguments)
+{
+	if (std::find(arguments.begin(), arguments.end(), "--replay-stream") == arguments.end())
+		return std::nullopt;
+
+	std::string streamPath;
+	std::string outputPath = "command_stream_report.txt";
+	unsigned int numRepetitions = 10;
+
+	for (size_t argumentIndex = 0; argumentIndex + 1 < arguments.size(); argumentIndex++)
+	{
+		const std::string& option = arguments[argumentIndex];
+		const std::string& value = arguments[argumentIndex + 1];
+
+		if (option == "--replay-stream")
+			streamPath = value;
+		else if (option == "--report")
+			outputPath = value;
+		else if (option == "--repetitions")
+			numRepetitions = unsigned int(std::stoul(value));
+	}
+
+	THROW_INTERNAL_ERROR_IF("--replay-stream needs path to captured stream", streamPath.empty());
+
+	CommandStreamReplay replay;
+
+	THROW_INTERNAL_ERROR_IF("Stream passed to --replay-stream couldn't be opened or isn't a valid command stream", !replay.LoadFromFile(streamPath));
+
+	std::ofstream file(outputPath);
+
+	if (!file.is_open())
+		return EXIT_FAILURE;
+
+	file << replay.GetReport(std::max(numRepetitions, 1u));
+
+	return file.good() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+std::optional<int> BenchmarkRunner::RunIfRequested(const std::vector<std::string>& arguments)
+{
+	if (std::optional<int> benchmarkResult = RunSceneBenchmarkIfRequested(arguments))
+		return benchmarkResult;
+
+	if (std::optional<int> benchmarkResult = RunLightClustersBenchmarkIfRequested(arguments))
+		return benchmarkResult;
+
+	if (std::optional<int> benchmarkResult = RunOcclusionBenchmarkIfRequested(arguments))
+		return benchmarkResult;
+
+	return RunStreamReplayIfRequested(arguments);
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+#include "Includes/CppIncludes.h"
+
+// headless benchmarks selected by command line, shared by the application and console benchmark build.
+// "--scene-benchmark <output.json>" runs synthetic scene benchmark, scene can be configured with --objects, --materials, --lights,
+// --depth, --motion, --seed and length of the run with --frames.
+// "--draw-packets 0" records geometry straight from bindable containers, to compare draws/ms with draw packets.
+// "--instancing 0" draws every visible job with its own draw, to compare draw calls with automatic instancing.
+// "--light-clusters-benchmark <output.json>" bins --lights random lights on worker threads only, without creating graphics.
+// "--occlusion-benchmark <output.json>" rasterizes --occluders walls and tests --candidates boxes behind them, without creating graphics.
+// "--replay-stream <capture.tcmd>" analyzes command stream captured by CommandStream, report is saved to --report <output.txt>
+// and strategies are timed over --repetitions replays
+namespace BenchmarkRunner
+{
+	// exit code of the benchmark, nullopt when none was requested
+	std::optional<int> RunIfRequested(const std::vector<std::string>& arguments);
+}
\ No newline at end of file
@@ -1,12 +1,34 @@
 #include "Includes/CppIncludes.h"
 #include "Application.h"
 #include "Error/ErrorHandler.h"
+#include "Macros/ErrorMacros.h"
+#include "BenchmarkRunner.h"
+
+static std::vector<std::string> SplitCommandLine(const char* commandLine)
+{
+	std::vector<std::string> arguments;
+
+	for (const char* pArgument = commandLine; *pArgument != '\0';)
+	{
+		const char* pArgumentEnd = pArgument;
+
+		while (*pArgumentEnd != '\0' && *pArgumentEnd != ' ')
+			pArgumentEnd++;
+
+		if (pArgumentEnd != pArgument)
+			arguments.emplace_back(pArgument, pArgumentEnd);
+
+		pArgument = *pArgumentEnd == '\0' ? pArgumentEnd : pArgumentEnd + 1;
+	}
+
+	return arguments;
+}
 
 int WINAPI WinMain
 (
 	_In_ HINSTANCE,
 	_In_opt_ HINSTANCE,
-	_In_ LPSTR,
+	_In_ LPSTR commandLine,
 	_In_ int
 )
 {
@@ -15,11 +37,25 @@ int WINAPI WinMain
 
 	try
 	{
+		std::vector<std::string> arguments = SplitCommandLine(commandLine);
+
+		if (std::optional<int> benchmarkResult = BenchmarkRunner::RunIfRequested(arguments))
+			return *benchmarkResult;
+
 		unsigned int screenWidth = unsigned int(std::round(float(GetSystemMetrics(SM_CXSCREEN)) * 0.625f));
 		unsigned int screenHeight = unsigned int(std::round(float(GetSystemMetrics(SM_CYSCREEN)) * 0.83333333333f));
 
 		Application app(screenWidth, screenHeight, "Teleios Engine");
 
+		// "--flythrough-benchmark <path.tcam> <output.json>" replays recorded camera path and exits
+		for (size_t argumentIndex = 0; argumentIndex < arguments.size(); argumentIndex++)
+			if (arguments[argumentIndex] == "--flythrough-benchmark")
+			{
+				THROW_INTERNAL_ERROR_IF("--flythrough-benchmark expects <path.tcam> <output.json>", argumentIndex + 2 >= arguments.size());
+
+				app.StartBenchmark(arguments[argumentIndex + 1], arguments[argumentIndex + 2]);
+			}
+
 		return app.Run();
 	}
 	catch (ErrorHandler::Exception& except)
@@ -1,5 +1,7 @@
 #include "ErrorHandler.h"
+#ifdef _WIN32
 #include "Includes/DirectXIncludes.h"
+#endif
 
 ErrorHandler::Exception::Exception(unsigned int line, const char* file, const char* function)
 	:
@@ -53,6 +55,7 @@ const char* ErrorHandler::Exception::GetFunction() const
 /*
 		STANDARD EXCEPTION
 */
+#ifdef _WIN32
 
 ErrorHandler::StandardException::StandardException(unsigned int line, const char* file, const char* function, HRESULT hr)
 	:
@@ -122,6 +125,7 @@ std::string ErrorHandler::StandardException::TranslateErrorCode(HRESULT hr)
 
 	return msgBuf;
 }
+#endif
 
 /*
 		INTERNAL EXCEPTION
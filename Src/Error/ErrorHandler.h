@@ -1,6 +1,7 @@
 #pragma once
 #include "Includes/CppIncludes.h"
 #include <exception>
+#include <iostream>
 
 struct ID3D10Blob;
 typedef ID3D10Blob ID3DBlob;
@@ -32,6 +33,7 @@ namespace ErrorHandler
 		const char* m_function;
 	};
 
+#ifdef _WIN32
 	class StandardException : public Exception
 	{
 	public:
@@ -51,6 +53,7 @@ namespace ErrorHandler
 	protected:
 		HRESULT m_hr;
 	};
+#endif
 
 	class InternalException : public Exception
 	{
@@ -115,6 +118,10 @@ namespace ErrorHandler
 
 	static void ThrowError(const char* title, const char* text) noexcept
 	{
+#ifdef _WIN32
 		MessageBoxA(NULL, text, title, MB_OK | MB_ICONEXCLAMATION);
+#else
+		std::cerr << title << "\n" << text << std::endl;
+#endif
 	}
 };
\ No newline at end of file
@@ -11,16 +11,24 @@
 
 InfoQueue::InfoQueue(Graphics& graphics)
 {
-	graphics.GetDeviceResources().GetDevice()->QueryInterface(pInfoQueue.GetAddressOf());
+	// null device doesn't report any messages
+	if (ID3D12Device* pDevice = graphics.GetDevice().GetNativeDevice())
+		pDevice->QueryInterface(pInfoQueue.GetAddressOf());
 }
 
 size_t InfoQueue::GetNumMessages() const
 {
+	if (!pInfoQueue)
+		return 0;
+
 	return static_cast<size_t>(pInfoQueue->GetNumMessagesAllowedByStorageFilter());
 }
 
 std::vector<std::string> InfoQueue::GetMessages() const
 {
+	if (!pInfoQueue)
+		return {};
+
 	HRESULT hr;
 
 	std::vector<std::string> result = {};
@@ -47,6 +55,9 @@ std::vector<std::string> InfoQueue::GetMessages() const
 
 void InfoQueue::SetMuteInfoMessages(bool mute)
 {
+	if (!pInfoQueue)
+		return;
+
 	if (mute)
 	{
 		HRESULT hr;
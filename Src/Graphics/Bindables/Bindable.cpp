@@ -2,10 +2,48 @@
 #include "Macros/ErrorMacros.h"
 
 #include "Graphics/Core/RootSignature.h"
+#include "Graphics/Core/BindableContainer.h"
+
+UpdatableBindable::UpdatableBindable(const UpdatableBindable& other)
+	:
+	m_revision(other.m_revision)
+{
+
+}
+
+UpdatableBindable::UpdatableBindable(UpdatableBindable&& other) noexcept
+	:
+	m_revision(other.m_revision)
+{
+
+}
+
+UpdatableBindable& UpdatableBindable::operator=(const UpdatableBindable& other)
+{
+	m_revision = other.m_revision;
+
+	return *this;
+}
+
+UpdatableBindable& UpdatableBindable::operator=(UpdatableBindable&& other) noexcept
+{
+	m_revision = other.m_revision;
+
+	return *this;
+}
+
+UpdatableBindable::~UpdatableBindable()
+{
+	for (BindableContainer* container : m_dependentContainers)
+		container->StopObserving(this);
+}
 
 void UpdatableBindable::SetUpdated()
 {
 	m_revision++;
+
+	for (BindableContainer* container : m_dependentContainers)
+		container->OnBindableUpdated(this);
 }
 
 unsigned long long UpdatableBindable::GetRevision() const
@@ -13,6 +51,17 @@ unsigned long long UpdatableBindable::GetRevision() const
 	return m_revision;
 }
 
+void UpdatableBindable::AddDependentContainer(BindableContainer* container)
+{
+	if (std::find(m_dependentContainers.begin(), m_dependentContainers.end(), container) == m_dependentContainers.end())
+		m_dependentContainers.push_back(container);
+}
+
+void UpdatableBindable::RemoveDependentContainer(BindableContainer* container)
+{
+	std::erase(m_dependentContainers, container);
+}
+
 void CommandListBindable::BindToComputeCommandList(Graphics& graphics, CommandList* commandList)
 {
 	THROW_INTERNAL_ERROR("Called BindToComputeCommandList that wasn't overloaded");
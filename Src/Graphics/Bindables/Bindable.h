@@ -8,6 +8,7 @@
 
 class Graphics;
 class CommandList;
+class BindableContainer;
 class RootSignatureParams;
 class GraphicsPipelineStateParams;
 class ComputePipelineStateParams;
@@ -38,14 +39,29 @@ public:
 	virtual ~Bindable() = default;
 };
 
+// bindable whose changes are pushed to containers holding it, so only their dependents get rebuilt.
+// Copies and moved-to bindables start without dependents, containers register again when they are initialized
 class UpdatableBindable
 {
+public:
+	UpdatableBindable() = default;
+	UpdatableBindable(const UpdatableBindable& other);
+	UpdatableBindable(UpdatableBindable&& other) noexcept;
+	UpdatableBindable& operator=(const UpdatableBindable& other);
+	UpdatableBindable& operator=(UpdatableBindable&& other) noexcept;
+
+	~UpdatableBindable();
+
 public:
 	void SetUpdated();
 	unsigned long long GetRevision() const;
 
+	void AddDependentContainer(BindableContainer* container);
+	void RemoveDependentContainer(BindableContainer* container);
+
 private:
 	unsigned long long m_revision = 0;
+	std::vector<BindableContainer*> m_dependentContainers;
 };
 
 class CommandListBindable : public virtual UpdatableBindable
@@ -26,5 +26,6 @@ enum class BindableType
 	bindable_vertexBufferEntry,
 	bindable_viewPort,
 	bindable_rootSignatureConstants,
-	bindable_descriptorHeapBindable
+	bindable_descriptorHeapBindable,
+	bindable_instanceBuffer
 };
\ No newline at end of file
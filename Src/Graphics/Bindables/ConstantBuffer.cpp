@@ -49,22 +49,16 @@ void Buffer::Initialize(Graphics& graphics, DescriptorHeap::DescriptorInfo descr
 	{
 		m_descriptorIndexPerFrame.at(descriptorNum) = descriptorInfo.offsetInDescriptorFromStart;
 
-		THROW_INFO_ERROR(graphics.GetDeviceResources().GetDevice()->CreateShaderResourceView(
-			graphics.GetBufferHeap().GetDynamicResource(),
-			&shaderResourceViewDesc,
-			descriptorInfo.descriptorCpuHandle
-		));
+		graphics.GetDevice().CreateShaderResourceView(graphics, graphics.GetBufferHeap().GetDynamicResource(), shaderResourceViewDesc, descriptorInfo.descriptorCpuHandle);
 	}
 }
 
 void Buffer::Initialize(Graphics& graphics)
 {
-	for (unsigned int i = 0; i < graphics.GetBufferCount(); i++)
-	{
-		DescriptorHeap::DescriptorInfo descriptorInfo = graphics.GetDescriptorHeap().GetNextHandle();
+	m_descriptors = graphics.GetDescriptorHeap().Allocate(graphics.GetBufferCount());
 
-		Initialize(graphics, descriptorInfo, i);
-	}
+	for (unsigned int i = 0; i < graphics.GetBufferCount(); i++)
+		Initialize(graphics, graphics.GetDescriptorHeap().GetHandle(m_descriptors.GetOffset() + i), i);
 }
 
 D3D12_GPU_DESCRIPTOR_HANDLE Buffer::GetDescriptorHeapGPUHandle(Graphics& graphics) const
@@ -95,6 +89,11 @@ void Buffer::Update(Graphics& graphics, void* data, size_t size)
 	graphics.GetBufferHeap().UpdateResource(graphics, m_bufferIndex, data, size);
 }
 
+void Buffer::Update(Graphics& graphics, const void* data, std::span<const DataRange> ranges)
+{
+	graphics.GetBufferHeap().UpdateResource(graphics, m_bufferIndex, data, ranges);
+}
+
 void Buffer::Resize(Graphics& graphics, size_t newSize)
 {
 	graphics.GetBufferHeap().ResizeResource(graphics, m_bufferIndex, newSize);
@@ -182,10 +181,22 @@ CachedConstantBuffer::CachedConstantBuffer(Graphics& graphics, DynamicConstantBu
 
 void CachedConstantBuffer::Update(Graphics& graphics)
 {
+	if (!m_data.IsDirty())
+		return;
+
+	const std::vector<DataRange>& dirtyRanges = m_data.GetDirtyRanges();
+
 	if (m_frequentlyUpdated)
-		graphics.GetConstantBufferHeap().UpdateResource(graphics, m_bufferIndex.dynamicIndex, m_data.GetPtr(), m_data.GetLayout().GetSize());
+		graphics.GetConstantBufferHeap().UpdateResource(graphics, m_bufferIndex.dynamicIndex, m_data.GetPtr(), dirtyRanges);
 	else
-		graphics.GetConstantBufferHeap().UpdateResource(graphics, m_bufferIndex.staticIndex, m_data.GetPtr(), m_data.GetLayout().GetSize());
+		graphics.GetConstantBufferHeap().UpdateResource(graphics, m_bufferIndex.staticIndex, m_data.GetPtr(), dirtyRanges);
+
+	m_data.ClearDirtyRanges();
+}
+
+bool CachedConstantBuffer::IsDirty() const
+{
+	return m_data.IsDirty();
 }
 
 D3D12_GPU_VIRTUAL_ADDRESS CachedConstantBuffer::GetGPUAddress(Graphics& graphics) const
@@ -218,13 +229,14 @@ TempConstantBuffer::TempConstantBuffer(Graphics& graphics, DynamicConstantBuffer
 	ConstantBuffer(graphics, data.GetLayout(), targets),
 	m_data(std::move(data))
 {
-	m_bufferIndex = graphics.GetConstantBufferHeap().GetNextTempIndex(m_data.GetLayout().GetSize());
-
 	Update(graphics);
 }
 
 void TempConstantBuffer::Update(Graphics& graphics)
 {
+	// allocating new temp memory every update, so data used by frames in flight stays untouched
+	m_bufferIndex = graphics.GetConstantBufferHeap().GetNextTempIndex(graphics, m_data.GetLayout().GetSize());
+
 	graphics.GetConstantBufferHeap().UpdateResource(graphics, m_bufferIndex, m_data.GetPtr(), m_data.GetLayout().GetSize());
 }
 
@@ -36,6 +36,9 @@ public:
 
 	void Update(Graphics& graphics, void* data, size_t size);
 
+	// uploads only given ranges of data
+	void Update(Graphics& graphics, const void* data, std::span<const DataRange> ranges);
+
 	void Resize(Graphics& graphics, size_t newSize);
 
 	virtual D3D12_GPU_VIRTUAL_ADDRESS GetGPUAddress(Graphics& graphics) const override;
@@ -46,6 +49,7 @@ public:
 
 private:
 	std::vector<unsigned int> m_descriptorIndexPerFrame;
+	DescriptorHeap::Allocation m_descriptors; // one per frame, empty when descriptors were passed to Initialize()
 
 	DynamicConstantBuffer::Layout m_layout;
 	unsigned int m_numElements;
@@ -91,8 +95,11 @@ public:
 
 	CachedConstantBuffer(const CachedConstantBuffer&) = delete;
 
+	// uploads ranges of data that changed since last update
 	void Update(Graphics& graphics);
 
+	bool IsDirty() const;
+
 	virtual D3D12_GPU_VIRTUAL_ADDRESS GetGPUAddress(Graphics& graphics) const override;
 
 	virtual BindableType GetBindableType() const override;
@@ -114,6 +121,7 @@ private:
 };
 
 // this buffer is meant for use without previous knowledgement. Compute pipelines
+// its data lives in per-frame temp memory, so it's valid only in the frame Update() was called
 class TempConstantBuffer : public ConstantBuffer
 {
 public:
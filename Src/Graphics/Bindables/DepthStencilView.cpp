@@ -4,8 +4,6 @@
 
 DepthStencilViewBase::DepthStencilViewBase(Graphics& graphics, unsigned int numDescriptors)
 {
-	HRESULT hr;
-
 	// creating desriptor heap
 	{
 		D3D12_DESCRIPTOR_HEAP_DESC descriptorHeapDesc = {};
@@ -14,10 +12,10 @@ DepthStencilViewBase::DepthStencilViewBase(Graphics& graphics, unsigned int numD
 		descriptorHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
 		descriptorHeapDesc.NodeMask = 0;
 
-		THROW_ERROR(graphics.GetDeviceResources().GetDevice()->CreateDescriptorHeap(
-			&descriptorHeapDesc,
-			IID_PPV_ARGS(&m_descriptorHeap)
-		));
+		RenderDevice::DescriptorHeapAllocation descriptorHeap = graphics.GetDevice().CreateDescriptorHeap(graphics, descriptorHeapDesc);
+
+		m_descriptorHeap = std::move(descriptorHeap.pDescriptorHeap);
+		m_descriptorHeapStart = descriptorHeap.cpuStart;
 	}
 }
 
@@ -29,11 +27,7 @@ void DepthStencilViewBase::CreateDSV(Graphics& graphics, D3D12_CPU_DESCRIPTOR_HA
 	depthStencilViewDesc.Flags = D3D12_DSV_FLAG_NONE;
 	depthStencilViewDesc.Texture2D.MipSlice = 0;
 
-	THROW_INFO_ERROR(graphics.GetDeviceResources().GetDevice()->CreateDepthStencilView(
-		texture->GetResource(),
-		&depthStencilViewDesc,
-		descriptor
-	));
+	graphics.GetDevice().CreateDepthStencilView(graphics, texture->GetResource(), depthStencilViewDesc, descriptor);
 }
 
 void DepthStencilViewBase::CreateDSVArraySlice(Graphics& graphics, D3D12_CPU_DESCRIPTOR_HANDLE& descriptor, GraphicsTexture* texture, unsigned int arraySlice)
@@ -46,18 +40,16 @@ void DepthStencilViewBase::CreateDSVArraySlice(Graphics& graphics, D3D12_CPU_DES
 	depthStencilViewDesc.Texture2DArray.FirstArraySlice = arraySlice;
 	depthStencilViewDesc.Texture2DArray.ArraySize = 1;
 
-	THROW_INFO_ERROR(graphics.GetDeviceResources().GetDevice()->CreateDepthStencilView(
-		texture->GetResource(),
-		&depthStencilViewDesc,
-		descriptor
-	));
+	graphics.GetDevice().CreateDepthStencilView(graphics, texture->GetResource(), depthStencilViewDesc, descriptor);
 }
 
-DepthStencilView::DepthStencilView(Graphics& graphics)
+DepthStencilView::DepthStencilView(Graphics& graphics, DirectX::XMFLOAT2 dimensions)
 	:
 	DepthStencilViewBase(graphics, 1),
-	m_texture(graphics, GraphicsTextureDimensions(graphics.GetWidth(), graphics.GetHeight()), DXGI_FORMAT_D24_UNORM_S8_UINT, DepthStencilClearValue(1.0f, 0), GraphicsResource::CPUAccess::notavailable, D3D12_RESOURCE_STATE_DEPTH_WRITE, D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL)
+	m_texture(graphics, GraphicsTextureDimensions(dimensions.x != 0.0f ? dimensions.x : graphics.GetWidth(), dimensions.y != 0.0f ? dimensions.y : graphics.GetHeight()), DXGI_FORMAT_D24_UNORM_S8_UINT, DepthStencilClearValue(1.0f, 0), GraphicsResource::CPUAccess::notavailable, D3D12_RESOURCE_STATE_DEPTH_WRITE, D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL)
 {
+	m_descriptor = m_descriptorHeapStart;
+
 	CreateDSV(graphics, m_descriptor, &m_texture);
 }
 
@@ -111,8 +103,8 @@ DepthStencilViewMultiResource::DepthStencilViewMultiResource(Graphics& graphics,
 		m_textures.push_back(std::make_shared<GraphicsTexture>(graphics, GraphicsTextureDimensions(dimensions.x, dimensions.y), DXGI_FORMAT_D24_UNORM_S8_UINT, DepthStencilClearValue(1.0f, 0), GraphicsResource::CPUAccess::notavailable, D3D12_RESOURCE_STATE_DEPTH_WRITE, D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL));
 		
 		D3D12_CPU_DESCRIPTOR_HANDLE& descriptor = m_descriptors.at(i);
-		descriptor = m_descriptorHeap->GetCPUDescriptorHandleForHeapStart();
-		descriptor.ptr += graphics.GetDeviceResources().GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_DSV) * i;
+		descriptor = m_descriptorHeapStart;
+		descriptor.ptr += graphics.GetDevice().GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_DSV) * i;
 		
 		CreateDSV(graphics, descriptor, m_textures.at(i).get());
 	}
@@ -183,8 +175,8 @@ DepthStencilViewCubeMultiResource::DepthStencilViewCubeMultiResource(Graphics& g
 		{
 			auto& face = frameDescriptors.faces.at(iFace);
 
-			face = m_descriptorHeap->GetCPUDescriptorHandleForHeapStart();
-			face.ptr += graphics.GetDeviceResources().GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_DSV) * ((iFrame * 6) + iFace);
+			face = m_descriptorHeapStart;
+			face.ptr += graphics.GetDevice().GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_DSV) * ((iFrame * 6) + iFace);
 
 			CreateDSVArraySlice(graphics, face, m_textures.at(iFrame).get(), iFace);
 		}
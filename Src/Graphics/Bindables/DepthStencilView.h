@@ -37,12 +37,13 @@ protected:
 
 protected:
 	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> m_descriptorHeap = {};
+	D3D12_CPU_DESCRIPTOR_HANDLE m_descriptorHeapStart = {};
 };
 
 class DepthStencilView : public DepthStencilViewBase
 {
 public:
-	 DepthStencilView(Graphics& graphics);
+	 DepthStencilView(Graphics& graphics, DirectX::XMFLOAT2 dimensions = {});
 
 public:
 	virtual const D3D12_CPU_DESCRIPTOR_HANDLE& GetDescriptor(Graphics& graphics) const override;
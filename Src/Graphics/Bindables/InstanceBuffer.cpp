@@ -0,0 +1,76 @@
+#include "InstanceBuffer.h"
+#include "Macros/ErrorMacros.h"
+
+#include "Graphics/Core/Graphics.h"
+#include "Graphics/Core/RootSignature.h"
+#include "Graphics/Core/CommandList.h"
+
+InstanceBuffer::InstanceBuffer(ResourceTargets targets)
+	:
+	RootSignatureBindable(std::move(targets))
+{
+
+}
+
+void InstanceBuffer::Update(Graphics& graphics, const std::vector<unsigned int>& sceneIndices)
+{
+	THROW_INTERNAL_ERROR_IF("Instance buffer has to hold at least one instance", sceneIndices.empty());
+
+	size_t size = sceneIndices.size() * sizeof(unsigned int);
+
+	// allocating new temp memory every update, so batches already recorded keep their indices
+	m_bufferIndex = graphics.GetBufferHeap().GetNextTempIndex(graphics, UINT(size));
+
+	graphics.GetBufferHeap().UpdateResource(graphics, m_bufferIndex, sceneIndices.data(), size);
+
+	m_numInstances = unsigned int(sceneIndices.size());
+	m_firstInstance = 0;
+	m_changed = true;
+}
+
+void InstanceBuffer::SetFirstInstance(unsigned int firstInstance)
+{
+	THROW_INTERNAL_ERROR_IF("First instance is outside of instance buffer", firstInstance >= m_numInstances);
+
+	if (m_firstInstance == firstInstance)
+		return;
+
+	m_firstInstance = firstInstance;
+	m_changed = true;
+}
+
+bool InstanceBuffer::IsChanged() const
+{
+	return m_changed;
+}
+
+void InstanceBuffer::SetBound()
+{
+	m_changed = false;
+}
+
+void InstanceBuffer::AddGraphicsRootSignatureParam(RootSignatureParams* rootSignatureParams)
+{
+	for (const auto& target : GetTargets())
+		rootSignatureParams->AddDescriptorParameter(this, target);
+}
+
+void InstanceBuffer::BindToCommandListAsRootParam(Graphics& graphics, CommandList* commandList, const RootBinding& binding)
+{
+	commandList->SetGraphicsInstanceBuffer(graphics, this, binding);
+}
+
+BindableType InstanceBuffer::GetBindableType() const
+{
+	return BindableType::bindable_instanceBuffer;
+}
+
+RootSignatureBindableType InstanceBuffer::GetRootSignatureBindableType() const
+{
+	return RootSignatureBindableType::rootSignature_BufferSRV;
+}
+
+D3D12_GPU_VIRTUAL_ADDRESS InstanceBuffer::GetGPUAddress(Graphics& graphics) const
+{
+	return graphics.GetBufferHeap().GetBufferAddress(m_bufferIndex) + m_firstInstance * sizeof(unsigned int);
+}
\ No newline at end of file
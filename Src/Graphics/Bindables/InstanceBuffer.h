@@ -0,0 +1,42 @@
+#pragma once
+#include "Includes/CppIncludes.h"
+#include "Bindable.h"
+#include "Graphics/Core/ConstantBufferHeap.h"
+
+class Graphics;
+
+// scene indices of objects drawn by instanced draws, vertex shader reads transform of every instance through them.
+// Indices of all batches of a pass are written to temp memory of current frame at once,
+// root parameter is then moved to the first instance of every batch before it's drawn
+class InstanceBuffer : public Bindable, public RootSignatureBindable
+{
+public:
+	InstanceBuffer(ResourceTargets targets = { {ShaderVisibilityGraphic::VertexShader, 1} });
+
+public:
+	// indices are valid only in current frame
+	void Update(Graphics& graphics, const std::vector<unsigned int>& sceneIndices);
+
+	void SetFirstInstance(unsigned int firstInstance);
+
+	// first instance changed since it was last bound
+	bool IsChanged() const;
+	void SetBound();
+
+public:
+	virtual void AddGraphicsRootSignatureParam(RootSignatureParams* rootSignatureParams) override;
+
+	virtual void BindToCommandListAsRootParam(Graphics& graphics, CommandList* commandList, const RootBinding& binding) override;
+
+	virtual BindableType GetBindableType() const override;
+
+	virtual RootSignatureBindableType GetRootSignatureBindableType() const override;
+
+	virtual D3D12_GPU_VIRTUAL_ADDRESS GetGPUAddress(Graphics& graphics) const override;
+
+private:
+	TempBufferIndex m_bufferIndex;
+	unsigned int m_numInstances = 0;
+	unsigned int m_firstInstance = 0;
+	bool m_changed = true;
+};
\ No newline at end of file
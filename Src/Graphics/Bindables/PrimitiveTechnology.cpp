@@ -38,6 +38,11 @@ void PrimitiveTechnology::BindToCommandList(Graphics& graphics, CommandList* com
 	commandList->SetPrimitiveTopology(graphics, m_d3dtype);
 }
 
+D3D_PRIMITIVE_TOPOLOGY PrimitiveTechnology::GetTopology() const
+{
+	return m_d3dtype;
+}
+
 constexpr D3D_PRIMITIVE_TOPOLOGY PrimitiveTechnology::GetD3DPrimitiveFromD3D12(D3D12_PRIMITIVE_TOPOLOGY_TYPE type)
 {
 	switch (type)
@@ -21,6 +21,8 @@ public:
 
 	virtual void BindToCommandList(Graphics& graphics, CommandList* commandList) override;
 
+	D3D_PRIMITIVE_TOPOLOGY GetTopology() const;
+
 private:
 	static constexpr D3D_PRIMITIVE_TOPOLOGY GetD3DPrimitiveFromD3D12(D3D12_PRIMITIVE_TOPOLOGY_TYPE type);
 
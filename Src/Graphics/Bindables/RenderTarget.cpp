@@ -35,6 +35,35 @@ RenderTargetClearValue RenderTarget::GetClearValue() const
 	return RenderTargetClearValue(0.0f, 0.0f, 0.0f, 0.0f);
 }
 
+D3D12_RESOURCE_DESC RenderTarget::GetResourceDesc(Graphics& graphics) const
+{
+	return GetResource(graphics)->GetDesc();
+}
+
+D3D12_CPU_DESCRIPTOR_HANDLE RenderTarget::CreateDescriptorHeap(Graphics& graphics, unsigned int numDescriptors)
+{
+	D3D12_DESCRIPTOR_HEAP_DESC descriptorHeapDesc = {};
+	descriptorHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
+	descriptorHeapDesc.NumDescriptors = numDescriptors;
+	descriptorHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+	descriptorHeapDesc.NodeMask = 0;
+
+	RenderDevice::DescriptorHeapAllocation descriptorHeap = graphics.GetDevice().CreateDescriptorHeap(graphics, descriptorHeapDesc);
+	m_pDescriptorHeap = std::move(descriptorHeap.pDescriptorHeap);
+
+	return descriptorHeap.cpuStart;
+}
+
+void RenderTarget::CreateRenderTargetView(Graphics& graphics, ID3D12Resource* pResource, D3D12_CPU_DESCRIPTOR_HANDLE descriptorHandle) const
+{
+	D3D12_RENDER_TARGET_VIEW_DESC renderTargetViewDesc = {};
+	renderTargetViewDesc.Format = m_format;
+	renderTargetViewDesc.ViewDimension = D3D12_RTV_DIMENSION_TEXTURE2D;
+	renderTargetViewDesc.Texture2D = D3D12_TEX2D_RTV{};
+
+	graphics.GetDevice().CreateRenderTargetView(graphics, pResource, renderTargetViewDesc, descriptorHandle);
+}
+
 /*
 			// Surface Render Target
 */
@@ -43,32 +72,15 @@ SurfaceRenderTarget::SurfaceRenderTarget(Graphics& graphics, DXGI_FORMAT format,
 	:
 	RenderTarget(format)
 {
-	HRESULT hr;
-
 	// creating descriptor for RTV
-	{
-		D3D12_DESCRIPTOR_HEAP_DESC descriptorHeapDesc = {};
-		descriptorHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
-		descriptorHeapDesc.NumDescriptors = 1;
-		descriptorHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
-		descriptorHeapDesc.NodeMask = 0;
-
-		THROW_ERROR(graphics.GetDeviceResources().GetDevice()->CreateDescriptorHeap(&descriptorHeapDesc, IID_PPV_ARGS(&m_pDescriptorHeap)));
-	}
+	m_renderTarget.descriptorHandle = CreateDescriptorHeap(graphics, 1);
 
-	pResource->QueryInterface(m_renderTarget.pRenderTarget.GetAddressOf());
+	// null device doesn't have resources to reference
+	if (pResource != nullptr)
+		pResource->QueryInterface(m_renderTarget.pRenderTarget.GetAddressOf());
 
 	// creating render target view
-	{
-		D3D12_RENDER_TARGET_VIEW_DESC renderTargetViewDesc = {};
-		renderTargetViewDesc.Format = m_format;
-		renderTargetViewDesc.ViewDimension = D3D12_RTV_DIMENSION_TEXTURE2D;
-		renderTargetViewDesc.Texture2D = D3D12_TEX2D_RTV{};
-
-		m_renderTarget.descriptorHandle = m_pDescriptorHeap->GetCPUDescriptorHandleForHeapStart();
-
-		graphics.GetDeviceResources().GetDevice()->CreateRenderTargetView(pResource, &renderTargetViewDesc, m_renderTarget.descriptorHandle);
-	}
+	CreateRenderTargetView(graphics, pResource, m_renderTarget.descriptorHandle);
 
 	m_renderTarget.state = D3D12_RESOURCE_STATE_RENDER_TARGET;
 }
@@ -106,22 +118,12 @@ SwapChainRenderTarget::SwapChainRenderTarget(Graphics& graphics, DXGI_FORMAT for
 	:
 	RenderTarget(format)
 {
-	HRESULT hr;
-
 	UINT accumulatedSizeOfDescriptor = 0;
 	const size_t numBuffers = bufferList.size();
-	static const UINT sizeOfRTVDescriptor = graphics.GetDeviceResources().GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
+	const UINT sizeOfRTVDescriptor = graphics.GetDevice().GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
 
 	// creating descriptor for all RTV's
-	{
-		D3D12_DESCRIPTOR_HEAP_DESC descriptorHeapDesc = {};
-		descriptorHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
-		descriptorHeapDesc.NumDescriptors = numBuffers;
-		descriptorHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
-		descriptorHeapDesc.NodeMask = 0;
-
-		THROW_ERROR(graphics.GetDeviceResources().GetDevice()->CreateDescriptorHeap(&descriptorHeapDesc, IID_PPV_ARGS(&m_pDescriptorHeap)));
-	}
+	D3D12_CPU_DESCRIPTOR_HANDLE descriptorHeapStart = CreateDescriptorHeap(graphics, unsigned int(numBuffers));
 
 
 	// getting space in vector before the pushes
@@ -131,21 +133,18 @@ SwapChainRenderTarget::SwapChainRenderTarget(Graphics& graphics, DXGI_FORMAT for
 	{
 		NonOwningRenderTargetData renderTargetData;
 
-		pResource->QueryInterface(renderTargetData.pRenderTarget.GetAddressOf());
+		// null swap chain doesn't have any buffers
+		if (pResource)
+			pResource->QueryInterface(renderTargetData.pRenderTarget.GetAddressOf());
 
 		// creating render target view
 		{
-			D3D12_RENDER_TARGET_VIEW_DESC renderTargetViewDesc = {};
-			renderTargetViewDesc.Format = m_format;
-			renderTargetViewDesc.ViewDimension = D3D12_RTV_DIMENSION_TEXTURE2D;
-			renderTargetViewDesc.Texture2D = D3D12_TEX2D_RTV{};
-
-			renderTargetData.descriptorHandle = m_pDescriptorHeap->GetCPUDescriptorHandleForHeapStart();
+			renderTargetData.descriptorHandle = descriptorHeapStart;
 			renderTargetData.descriptorHandle.ptr += static_cast<SIZE_T>(accumulatedSizeOfDescriptor);
 
 			accumulatedSizeOfDescriptor += sizeOfRTVDescriptor;
 
-			graphics.GetDeviceResources().GetDevice()->CreateRenderTargetView(renderTargetData.pRenderTarget.Get(), &renderTargetViewDesc, renderTargetData.descriptorHandle);
+			CreateRenderTargetView(graphics, renderTargetData.pRenderTarget.Get(), renderTargetData.descriptorHandle);
 		}
 
 		// setting state
@@ -188,23 +187,13 @@ BackBufferRenderTarget::BackBufferRenderTarget(Graphics& graphics, DXGI_FORMAT f
 	:
 	RenderTarget(format)
 {
-	HRESULT hr;
-	
 	const unsigned int numBuffers = graphics.GetBufferCount();
 
 	UINT accumulatedSizeOfDescriptor = 0;
-	static const UINT sizeOfRTVDescriptor = graphics.GetDeviceResources().GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
+	const UINT sizeOfRTVDescriptor = graphics.GetDevice().GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
 
 	// creating descriptor for all RTV's
-	{
-		D3D12_DESCRIPTOR_HEAP_DESC descriptorHeapDesc = {};
-		descriptorHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
-		descriptorHeapDesc.NumDescriptors = numBuffers;
-		descriptorHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
-		descriptorHeapDesc.NodeMask = 0;
-
-		THROW_ERROR(graphics.GetDeviceResources().GetDevice()->CreateDescriptorHeap(&descriptorHeapDesc, IID_PPV_ARGS(&m_pDescriptorHeap)));
-	}
+	D3D12_CPU_DESCRIPTOR_HANDLE descriptorHeapStart = CreateDescriptorHeap(graphics, numBuffers);
 
 	static constexpr DirectX::XMFLOAT4 optimizedClearValue = { 0.01f, 0.02f, 0.03f, 1.0f };
 	
@@ -218,17 +207,12 @@ BackBufferRenderTarget::BackBufferRenderTarget(Graphics& graphics, DXGI_FORMAT f
 
 		// creating render target view
 		{
-			D3D12_RENDER_TARGET_VIEW_DESC renderTargetViewDesc = {};
-			renderTargetViewDesc.Format = m_format;
-			renderTargetViewDesc.ViewDimension = D3D12_RTV_DIMENSION_TEXTURE2D;
-			renderTargetViewDesc.Texture2D = D3D12_TEX2D_RTV{};
-
-			renderTargetData.descriptorHandle = m_pDescriptorHeap->GetCPUDescriptorHandleForHeapStart();
+			renderTargetData.descriptorHandle = descriptorHeapStart;
 			renderTargetData.descriptorHandle.ptr += static_cast<SIZE_T>(accumulatedSizeOfDescriptor);
 
 			accumulatedSizeOfDescriptor += sizeOfRTVDescriptor;
 
-			graphics.GetDeviceResources().GetDevice()->CreateRenderTargetView(renderTargetData.texture->GetResource(), &renderTargetViewDesc, renderTargetData.descriptorHandle);
+			CreateRenderTargetView(graphics, renderTargetData.texture->GetResource(), renderTargetData.descriptorHandle);
 		}
 
 		m_ownedRenderTargets.push_back(std::move(renderTargetData));
@@ -245,6 +229,11 @@ ID3D12Resource* BackBufferRenderTarget::GetResource(Graphics& graphics) const
 	return m_ownedRenderTargets.at(graphics.GetCurrentBufferIndex()).texture->GetResource();
 }
 
+D3D12_RESOURCE_DESC BackBufferRenderTarget::GetResourceDesc(Graphics& graphics) const
+{
+	return GetTexture(graphics)->GetResourceDesc();
+}
+
 GraphicsTexture* BackBufferRenderTarget::GetTexture(Graphics& graphics) const
 {
 	return GetTexture(graphics.GetCurrentBufferIndex());
@@ -265,6 +254,20 @@ void BackBufferRenderTarget::SetResourceState(Graphics& graphics, D3D12_RESOURCE
 	m_ownedRenderTargets.at(graphics.GetCurrentBufferIndex()).texture->SetResourceState(newState);
 }
 
+void BackBufferRenderTarget::PlaceInHeaps(Graphics& graphics, const std::vector<Microsoft::WRL::ComPtr<ID3D12Heap>>& heaps, size_t heapOffset)
+{
+	THROW_INTERNAL_ERROR_IF("Number of heaps didn't match number of buffers", heaps.size() != m_ownedRenderTargets.size());
+
+	for (size_t i = 0; i < m_ownedRenderTargets.size(); i++)
+	{
+		OwningRenderTargetData& renderTargetData = m_ownedRenderTargets.at(i);
+
+		renderTargetData.texture->PlaceInHeap(graphics, heaps.at(i).Get(), heapOffset);
+
+		CreateRenderTargetView(graphics, renderTargetData.texture->GetResource(), renderTargetData.descriptorHandle);
+	}
+}
+
 RenderTargetType BackBufferRenderTarget::GetRenderTargetType() const
 {
 	return RenderTargetType::backBuffer;
@@ -39,6 +39,7 @@ public:
 public:
 	virtual const D3D12_CPU_DESCRIPTOR_HANDLE& GetDescriptor(Graphics& graphics) const = 0;
 	virtual ID3D12Resource* GetResource(Graphics& graphics) const = 0;
+	virtual D3D12_RESOURCE_DESC GetResourceDesc(Graphics& graphics) const;
 
 	virtual void BindToCommandList(Graphics& graphics, CommandList* commandList) override;
 
@@ -53,6 +54,12 @@ public:
 
 	virtual RenderTargetClearValue GetClearValue() const;
 
+protected:
+	// returns handle to the first descriptor
+	D3D12_CPU_DESCRIPTOR_HANDLE CreateDescriptorHeap(Graphics& graphics, unsigned int numDescriptors);
+
+	void CreateRenderTargetView(Graphics& graphics, ID3D12Resource* pResource, D3D12_CPU_DESCRIPTOR_HANDLE descriptorHandle) const;
+
 protected:
 	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> m_pDescriptorHeap;
 	DXGI_FORMAT m_format;
@@ -105,6 +112,7 @@ public:
 public:
 	virtual const D3D12_CPU_DESCRIPTOR_HANDLE& GetDescriptor(Graphics& graphics) const override;
 	virtual ID3D12Resource* GetResource(Graphics& graphics) const override;
+	virtual D3D12_RESOURCE_DESC GetResourceDesc(Graphics& graphics) const override;
 	GraphicsTexture* GetTexture(Graphics& graphics) const;
 	GraphicsTexture* GetTexture(unsigned int i) const;
 
@@ -115,6 +123,9 @@ public:
 
 	virtual RenderTargetClearValue GetClearValue() const override;
 
+	// moves resources to the same offset of given heaps, one heap per buffer
+	void PlaceInHeaps(Graphics& graphics, const std::vector<Microsoft::WRL::ComPtr<ID3D12Heap>>& heaps, size_t heapOffset);
+
 private:
 	std::vector<OwningRenderTargetData> m_ownedRenderTargets;
 };
\ No newline at end of file
@@ -73,11 +73,7 @@ void ShaderResourceViewBase::InitializeTextureSRV(Graphics& graphics, unsigned i
 		srvDesc.Texture2D.ResourceMinLODClamp = targetMip;
 	}
 
-	THROW_INFO_ERROR(graphics.GetDeviceResources().GetDevice()->CreateShaderResourceView(
-		texture->GetResource(),
-		&srvDesc,
-		descriptor.descriptorCpuHandle
-	));
+	graphics.GetDevice().CreateShaderResourceView(graphics, texture->GetResource(), srvDesc, descriptor.descriptorCpuHandle);
 }
 
 void ShaderResourceViewBase::InitializeBufferSRV(Graphics& graphics, DescriptorHeap::DescriptorInfo& descriptor, const GraphicsBuffer* buffer)
@@ -96,11 +92,7 @@ void ShaderResourceViewBase::InitializeBufferSRV(Graphics& graphics, DescriptorH
 		srvDesc.Buffer.StructureByteStride = buffer->GetByteStride();
 		srvDesc.Buffer.Flags = D3D12_BUFFER_SRV_FLAG_NONE;
 
-		THROW_INFO_ERROR(graphics.GetDeviceResources().GetDevice()->CreateShaderResourceView(
-			buffer->GetResource(),
-			&srvDesc,
-			descriptor.descriptorCpuHandle
-		));
+		graphics.GetDevice().CreateShaderResourceView(graphics, buffer->GetResource(), srvDesc, descriptor.descriptorCpuHandle);
 	}
 }
 
@@ -156,9 +148,9 @@ void ShaderResourceView::Initialize(Graphics& graphics, DescriptorHeap::Descript
 
 void ShaderResourceView::Initialize(Graphics& graphics)
 {
-	auto descriptor = graphics.GetDescriptorHeap().GetNextHandle();
+	m_descriptor = graphics.GetDescriptorHeap().Allocate();
 
-	Initialize(graphics, descriptor, 0);
+	Initialize(graphics, graphics.GetDescriptorHeap().GetHandle(m_descriptor.GetOffset()), 0);
 }
 
 ShaderResourceViewMultiResource::ShaderResourceViewMultiResource(Graphics& graphics, BackBufferRenderTarget* renderTarget, UINT slot)
@@ -167,8 +159,6 @@ ShaderResourceViewMultiResource::ShaderResourceViewMultiResource(Graphics& graph
 {
 	unsigned int numBuffers = graphics.GetBufferCount();
 
-	graphics.GetDescriptorHeap().RequestMoreSpace(numBuffers);
-
 	m_resources.reserve(numBuffers);
 
 	for (int i = 0; i < numBuffers; i++)
@@ -187,8 +177,6 @@ ShaderResourceViewMultiResource::ShaderResourceViewMultiResource(Graphics& graph
 {
 	unsigned int numBuffers = graphics.GetBufferCount();
 
-	graphics.GetDescriptorHeap().RequestMoreSpace(numBuffers);
-
 	m_resources.reserve(numBuffers);
 
 	for (int i = 0; i < numBuffers; i++)
@@ -207,8 +195,6 @@ ShaderResourceViewMultiResource::ShaderResourceViewMultiResource(Graphics& graph
 {
 	unsigned int numBuffers = graphics.GetBufferCount();
 
-	graphics.GetDescriptorHeap().RequestMoreSpace(numBuffers);
-
 	m_resources.reserve(numBuffers);
 
 	for (int i = 0; i < numBuffers; i++)
@@ -223,9 +209,7 @@ ShaderResourceViewMultiResource::ShaderResourceViewMultiResource(Graphics& graph
 
 D3D12_GPU_DESCRIPTOR_HANDLE ShaderResourceViewMultiResource::GetDescriptorHeapGPUHandle(Graphics& graphics) const
 {
-	unsigned int currentFrameDescriptorIndex = m_descriptors.at(graphics.GetCurrentBufferIndex());
-
-	return graphics.GetDescriptorHeap().GetHandle(currentFrameDescriptorIndex).descriptorHeapGpuHandle;
+	return graphics.GetDescriptorHeap().GetHandle(GetFrameDescriptorIndex(graphics)).descriptorHeapGpuHandle;
 }
 
 D3D12_GPU_VIRTUAL_ADDRESS ShaderResourceViewMultiResource::GetGPUAddress(Graphics& graphics) const
@@ -235,9 +219,7 @@ D3D12_GPU_VIRTUAL_ADDRESS ShaderResourceViewMultiResource::GetGPUAddress(Graphic
 
 unsigned int ShaderResourceViewMultiResource::GetOffsetInDescriptor(Graphics& graphics) const
 {
-	unsigned int currentFrameDescriptorIndex = m_descriptors.at(graphics.GetCurrentBufferIndex());
-
-	return graphics.GetDescriptorHeap().GetHandle(currentFrameDescriptorIndex).offsetInDescriptorFromStart;
+	return GetFrameDescriptorIndex(graphics);
 }
 
 void ShaderResourceViewMultiResource::Initialize(Graphics& graphics, DescriptorHeap::DescriptorInfo descriptorInfo, unsigned int descriptorNum)
@@ -247,26 +229,9 @@ void ShaderResourceViewMultiResource::Initialize(Graphics& graphics, DescriptorH
 
 void ShaderResourceViewMultiResource::Initialize(Graphics& graphics)
 {
-	unsigned int numResources = static_cast<unsigned int>(m_resources.size());
-
-	m_descriptors.resize(numResources);
-
-	for (int i = 0; i < numResources; i++)
-	{
-		GraphicsResource* targetResource = m_resources.at(i);
-
-		GraphicsResourceType resourceType = targetResource->GetResourceType();
-
-		THROW_INTERNAL_ERROR_IF("GraphicsResource type was not texture", resourceType != GraphicsResourceType::texture);
-
-		const GraphicsTexture* texture = static_cast<const GraphicsTexture*>(targetResource);
-
-		DescriptorHeap::DescriptorInfo descriptor = graphics.GetDescriptorHeap().GetNextHandle();
-
-		m_descriptors.at(i) = descriptor.offsetInDescriptorFromStart;
-
-		InitializeTextureSRV(graphics, 0, descriptor, texture);
-	}
+	// views are written when they are first used in a frame
+	for (GraphicsResource* targetResource : m_resources)
+		THROW_INTERNAL_ERROR_IF("GraphicsResource type was not texture", targetResource->GetResourceType() != GraphicsResourceType::texture);
 }
 
 std::shared_ptr<ShaderResourceViewMultiResource> ShaderResourceViewMultiResource::GetResource(Graphics& graphics, std::string identifier, BackBufferRenderTarget* renderTarget, UINT slot)
@@ -291,4 +256,22 @@ std::string ShaderResourceViewMultiResource::GetIdentifier(std::string identifie
 GraphicsResource* ShaderResourceViewMultiResource::GetResource(Graphics& graphics) const
 {
 	return m_resources.at(graphics.GetCurrentBufferIndex());
+}
+
+unsigned int ShaderResourceViewMultiResource::GetFrameDescriptorIndex(Graphics& graphics) const
+{
+	DescriptorHeap& descriptorHeap = graphics.GetDescriptorHeap();
+
+	// transient descriptors handed out in earlier frames can't be used anymore
+	if (m_frameDescriptorFrame == graphics.GetFrameNumber())
+		return m_frameDescriptorIndex;
+
+	DescriptorHeap::DescriptorInfo descriptor = descriptorHeap.GetTransientHandles();
+
+	InitializeTextureSRV(graphics, 0, descriptor, static_cast<const GraphicsTexture*>(GetResource(graphics)));
+
+	m_frameDescriptorIndex = descriptor.offsetInDescriptorFromStart;
+	m_frameDescriptorFrame = graphics.GetFrameNumber();
+
+	return m_frameDescriptorIndex;
 }
\ No newline at end of file
@@ -59,6 +59,7 @@ private:
 	unsigned int m_targetSubresource = 0;
 	GraphicsResource* m_resource;
 	unsigned int m_descriptorIndex = 0;
+	DescriptorHeap::Allocation m_descriptor; // empty when descriptor was passed to Initialize()
 };
 
 class ShaderResourceViewMultiResource : public ShaderResourceViewBase
@@ -88,7 +89,13 @@ public:
 
 	GraphicsResource* GetResource(Graphics& graphics) const;
 
+private:
+	// resource changes with back buffer, so its view is written once per frame into transient descriptors
+	unsigned int GetFrameDescriptorIndex(Graphics& graphics) const;
+
 private:
 	std::vector<GraphicsResource*> m_resources;
-	std::vector<unsigned int> m_descriptors = {};
+
+	mutable unsigned int m_frameDescriptorIndex = 0;
+	mutable std::optional<size_t> m_frameDescriptorFrame;
 };
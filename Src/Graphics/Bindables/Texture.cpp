@@ -20,6 +20,7 @@
 #include "Graphics/Core/Pipeline.h"
 
 #include "Graphics/Resources/GraphicsTexture.h"
+#include "Graphics/Profiler/MemoryTracker.h"
 
 Texture::Texture(Graphics& graphics, const char* path, TextureType type, int flags)
 	:
@@ -35,6 +36,8 @@ Texture::Texture(Graphics& graphics, const char* path, TextureType type, int fla
 {
 	graphics.GetDescriptorHeap().RequestMoreSpace();
 
+	MemoryOwnerScope ownerScope(m_path);
+
 	{
 		std::string extension = std::filesystem::path(m_path).extension().string();
 		m_originalFileType = GetTextureDataType(extension);
@@ -106,19 +109,15 @@ void Texture::Initialize(Graphics& graphics, DescriptorHeap::DescriptorInfo desc
 	{
 		m_textureDescriptor = descriptorInfo.offsetInDescriptorFromStart;
 
-		THROW_INFO_ERROR(graphics.GetDeviceResources().GetDevice()->CreateShaderResourceView(
-			m_gpuTexture->GetResource(),
-			&shaderResourceViewDesc,
-			descriptorInfo.descriptorCpuHandle
-		));
+		graphics.GetDevice().CreateShaderResourceView(graphics, m_gpuTexture->GetResource(), shaderResourceViewDesc, descriptorInfo.descriptorCpuHandle);
 	}
 }
 
 void Texture::Initialize(Graphics& graphics)
 {
-	DescriptorHeap::DescriptorInfo descriptorInfo = graphics.GetDescriptorHeap().GetNextHandle();
+	m_descriptor = graphics.GetDescriptorHeap().Allocate();
 
-	Initialize(graphics, descriptorInfo, 0);
+	Initialize(graphics, graphics.GetDescriptorHeap().GetHandle(m_descriptor.GetOffset()), 0);
 }
 
 std::shared_ptr<Texture> Texture::GetResource(Graphics& graphics, const char* path, TextureType type, int flags)
@@ -289,18 +288,26 @@ void Texture::ReadAndUploadData(Graphics& graphics, Pipeline& pipeline)
 	DirectX::ScratchImage mipmappedImage = {};
 	DirectX::ScratchImage compressedImage = {};
 
+	MemoryOwnerScope ownerScope(m_path);
+
 	// reading image from file
 	TextureProcessingStage processingStageRead = LoadImage(graphics, readImage);
 
+	MemoryTracker::Allocation readImageMemory = MemoryTracker::Track(MemoryCategory::StagingImages, readImage.GetPixelsSize());
+
 	// generating mip mapps
 	if (m_generateMipMaps && processingStageRead < TextureProcessingStage::mipmaps)
 	{
 		GenerateMipMaps(graphics, readImage.GetImages()[0], mipmappedImage, m_mipmapLevels);
 
 		readImage.Release();
+		readImageMemory = {};
 	}
 
+	MemoryTracker::Allocation mipmappedImageMemory = MemoryTracker::Track(MemoryCategory::StagingImages, mipmappedImage.GetPixelsSize());
+
 	DirectX::ScratchImage& uncompressedImage = m_generateMipMaps ? mipmappedImage : readImage;
+	MemoryTracker::Allocation& uncompressedImageMemory = m_generateMipMaps ? mipmappedImageMemory : readImageMemory;
 
 	// compressing image to BC format
 	if (m_compressImage && processingStageRead < TextureProcessingStage::compressed)
@@ -308,8 +315,11 @@ void Texture::ReadAndUploadData(Graphics& graphics, Pipeline& pipeline)
 		CompressImage(graphics, uncompressedImage, compressedImage);
 
 		uncompressedImage.Release();
+		uncompressedImageMemory = {};
 	}
 
+	MemoryTracker::Allocation compressedImageMemory = MemoryTracker::Track(MemoryCategory::StagingImages, compressedImage.GetPixelsSize());
+
 	const DirectX::ScratchImage& imageToUpload = processingStageRead == TextureProcessingStage::compressed ? readImage : (m_compressImage ? compressedImage : uncompressedImage);
 
 	// uploading image to gpu
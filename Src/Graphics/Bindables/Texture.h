@@ -142,6 +142,7 @@ private:
 	unsigned int m_mipmapLevels = 1;
 
 	unsigned int m_textureDescriptor = -1;
+	DescriptorHeap::Allocation m_descriptor; // empty when descriptor was passed to Initialize()
 
 	bool m_generateMipMaps;
 	bool m_compressImage;
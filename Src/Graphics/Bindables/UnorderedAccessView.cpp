@@ -19,10 +19,10 @@ UnorderedAccessView::UnorderedAccessView(Graphics& graphics, GraphicsTexture* te
 {
 	THROW_INTERNAL_ERROR_IF("GraphicsTexture was NULL", texture == nullptr);
 
-	HRESULT hr;
+	m_descriptor = graphics.GetDescriptorHeap().Allocate();
+	m_descriptorIndex = m_descriptor.GetOffset();
 
-	auto descriptor = graphics.GetDescriptorHeap().GetNextHandle();
-	m_descriptorIndex = descriptor.offsetInDescriptorFromStart;
+	auto descriptor = graphics.GetDescriptorHeap().GetHandle(m_descriptorIndex);
 
 	// creating UAV itself
 	{
@@ -33,12 +33,7 @@ UnorderedAccessView::UnorderedAccessView(Graphics& graphics, GraphicsTexture* te
 		uavDesc.Texture2D.MipSlice = targetMip;
 		uavDesc.Texture2D.PlaneSlice = 0;
 
-		THROW_INFO_ERROR(graphics.GetDeviceResources().GetDevice()->CreateUnorderedAccessView(
-			texture->GetResource(),
-			nullptr,
-			&uavDesc,
-			descriptor.descriptorCpuHandle
-		));
+		graphics.GetDevice().CreateUnorderedAccessView(graphics, texture->GetResource(), uavDesc, descriptor.descriptorCpuHandle);
 	}
 }
 
@@ -48,10 +43,10 @@ UnorderedAccessView::UnorderedAccessView(Graphics& graphics, GraphicsBuffer* buf
 {
 	THROW_INTERNAL_ERROR_IF("GraphicsBuffer was NULL", buffer == nullptr);
 
-	HRESULT hr;
+	m_descriptor = graphics.GetDescriptorHeap().Allocate();
+	m_descriptorIndex = m_descriptor.GetOffset();
 
-	auto descriptor = graphics.GetDescriptorHeap().GetNextHandle();
-	m_descriptorIndex = descriptor.offsetInDescriptorFromStart;
+	auto descriptor = graphics.GetDescriptorHeap().GetHandle(m_descriptorIndex);
 
 	// creating UAV itself
 	{
@@ -65,12 +60,7 @@ UnorderedAccessView::UnorderedAccessView(Graphics& graphics, GraphicsBuffer* buf
 		uavDesc.Buffer.CounterOffsetInBytes = 0;
 		uavDesc.Buffer.Flags = D3D12_BUFFER_UAV_FLAG_NONE;
 
-		THROW_INFO_ERROR(graphics.GetDeviceResources().GetDevice()->CreateUnorderedAccessView(
-			buffer->GetResource(),
-			nullptr,
-			&uavDesc,
-			descriptor.descriptorCpuHandle
-		));
+		graphics.GetDevice().CreateUnorderedAccessView(graphics, buffer->GetResource(), uavDesc, descriptor.descriptorCpuHandle);
 	}
 }
 
@@ -38,4 +38,5 @@ public:
 
 private:
 	unsigned int m_descriptorIndex = {};
+	DescriptorHeap::Allocation m_descriptor;
 };
@@ -6,23 +6,24 @@
 
 #include "Graphics/Core/ResourceList.h"
 
-ViewPort::ViewPort(Graphics& graphics, DirectX::XMFLOAT2 dimensions)
+ViewPort::ViewPort(Graphics& graphics, DirectX::XMFLOAT2 dimensions, DirectX::XMFLOAT2 offset)
 {
 	if(dimensions.x == 0.0f)
 		dimensions.x = graphics.GetWidth();
 	if(dimensions.y == 0.0f)
 		dimensions.y = graphics.GetHeight();
 
-	m_viewport.TopLeftX = 0;
-	m_viewport.TopLeftY = 0;
+	m_viewport.TopLeftX = offset.x;
+	m_viewport.TopLeftY = offset.y;
 	m_viewport.Width = dimensions.x;
 	m_viewport.Height = dimensions.y;
 	m_viewport.MinDepth = 0.0f;
 	m_viewport.MaxDepth = 1.0f;
 
-	m_viewportRect.left = m_viewportRect.top = 0;
-	m_viewportRect.bottom = dimensions.y;
-	m_viewportRect.right = dimensions.x;
+	m_viewportRect.left = offset.x;
+	m_viewportRect.top = offset.y;
+	m_viewportRect.bottom = offset.y + dimensions.y;
+	m_viewportRect.right = offset.x + dimensions.x;
 }
 
 const D3D12_VIEWPORT& ViewPort::GetViewport() const
@@ -7,7 +7,8 @@ class Pipeline;
 class ViewPort : public Bindable, public CommandListBindable
 {
 public:
-	ViewPort(Graphics& graphics, DirectX::XMFLOAT2 dimensions = {});
+	// offset places viewport inside bigger target, like tile of an atlas
+	ViewPort(Graphics& graphics, DirectX::XMFLOAT2 dimensions = {}, DirectX::XMFLOAT2 offset = {});
 
 public:
 	const D3D12_VIEWPORT& GetViewport() const;
@@ -4,6 +4,25 @@
 
 #include "Includes/BindablesInclude.h"
 
+namespace
+{
+	template<class T>
+	bool ContainsBindable(const std::vector<T*>& bindables, const UpdatableBindable* bindable)
+	{
+		for (const T* element : bindables)
+			if (static_cast<const UpdatableBindable*>(element) == bindable)
+				return true;
+
+		return false;
+	}
+}
+
+BindableContainer::~BindableContainer()
+{
+	for (UpdatableBindable* bindable : m_observers.bindables)
+		bindable->RemoveDependentContainer(this);
+}
+
 void BindableContainer::AddBindable(std::shared_ptr<Bindable> bindable)
 {
 	m_bindables.push_back(bindable);
@@ -28,62 +47,37 @@ void BindableContainer::Initialize(Graphics& graphics, Pipeline& pipeline)
 	for (auto staticBindableName : m_staticBindableNames)
 		SegregateBindableBaseFunctionality(pipeline.GetStaticResource(staticBindableName).get());
 
-	m_commandListLastSeenRevisions.resize(m_commandListBindables.size());
-	m_descriptorLastSeenRevisions.resize(m_descriptorBindables.size());
-	m_rootSignatureLastSeenRevisions.resize(m_rootSignatureBindables.size());
-	m_pipelineStateLastSeenRevisions.resize(m_pipelineStateBindables.size());
-}
+	if (m_observers.observing)
+		return;
 
-template<class T, ENABLE_IF((std::is_base_of_v<UpdatableBindable, T>))>
-bool CheckForRevisionChanged(const std::vector<T*>& bindables, std::vector<CachedRevision>& cachedRevisions)
-{
-	auto RebuildCachedRevisions = [&]()
-		{
-			cachedRevisions.clear();
-			cachedRevisions.reserve(bindables.size());
-			for (size_t i = 0; i < bindables.size(); i++)
-				cachedRevisions.emplace_back(bindables[i], bindables[i]->GetRevision());
-		};
+	m_observers.observing = true;
 
-	if (bindables.size() != cachedRevisions.size())
-	{
-		RebuildCachedRevisions();
-		return true;
-	}
+	for (auto* bindable : m_commandListBindables)
+		Observe(bindable);
 
-	bool result = false;
+	for (auto* bindable : m_descriptorBindables)
+		Observe(bindable);
 
-	for (size_t i = 0; i < bindables.size(); i++)
-	{
-		if (cachedRevisions[i].object != bindables[i])
-		{
-			RebuildCachedRevisions();
-			return true;
-		}
+	for (auto* bindable : m_rootSignatureBindables)
+		Observe(bindable);
 
-		if (bindables[i]->GetRevision() != cachedRevisions[i].revision)
-		{
-			cachedRevisions[i].revision = bindables[i]->GetRevision();
-			result = true;
-		}
-	}
-
-	return result;
+	for (auto* bindable : m_pipelineStateBindables)
+		Observe(bindable);
 }
 
-void BindableContainer::Update()
+void BindableContainer::RegisterForInvalidation(BindableContainerListener* listener) const
 {
-	if (CheckForRevisionChanged(m_commandListBindables, m_commandListLastSeenRevisions))
-		m_revision.commandListRevision++;
-
-	if (CheckForRevisionChanged(m_descriptorBindables, m_descriptorLastSeenRevisions))
-		m_revision.descriptorRevision++;
+	m_observers.listeners.push_back(listener);
+}
 
-	if (CheckForRevisionChanged(m_rootSignatureBindables, m_rootSignatureLastSeenRevisions))
-		m_revision.rootSignatureRevision++;
+void BindableContainer::OnBindableUpdated(const UpdatableBindable* bindable)
+{
+	Invalidate(GetInvalidation(bindable));
+}
 
-	if (CheckForRevisionChanged(m_pipelineStateBindables, m_pipelineStateLastSeenRevisions))
-		m_revision.pipelineStateRevision++;
+void BindableContainer::StopObserving(const UpdatableBindable* bindable)
+{
+	std::erase(m_observers.bindables, bindable);
 }
 
 void BindableContainer::SegregateBindableByClass(Bindable* bindable)
@@ -104,6 +98,16 @@ void BindableContainer::SegregateBindableBaseFunctionality(Bindable* bindable)
 
 	if (auto* pipelineStateBindable = dynamic_cast<PipelineStateBindable*>(bindable))
 		m_pipelineStateBindables.push_back(pipelineStateBindable);
+
+	// bindables added after initialization change container the same way as updated ones
+	if (!m_observers.observing)
+		return;
+
+	if (auto* updatableBindable = dynamic_cast<UpdatableBindable*>(bindable))
+	{
+		Observe(updatableBindable);
+		Invalidate(GetInvalidation(updatableBindable));
+	}
 }
 
 const std::vector<CommandListBindable*>& BindableContainer::GetCommandListBindables() const
@@ -131,6 +135,55 @@ BindableContainerRevision BindableContainer::GetRevision() const
 	return m_revision;
 }
 
+void BindableContainer::Observe(UpdatableBindable* bindable)
+{
+	if (std::find(m_observers.bindables.begin(), m_observers.bindables.end(), bindable) != m_observers.bindables.end())
+		return;
+
+	m_observers.bindables.push_back(bindable);
+	bindable->AddDependentContainer(this);
+}
+
+int BindableContainer::GetInvalidation(const UpdatableBindable* bindable) const
+{
+	int invalidation = invalidation_none;
+
+	if (ContainsBindable(m_commandListBindables, bindable))
+		invalidation |= invalidation_commandList;
+
+	if (ContainsBindable(m_descriptorBindables, bindable))
+		invalidation |= invalidation_descriptor;
+
+	if (ContainsBindable(m_rootSignatureBindables, bindable))
+		invalidation |= invalidation_rootSignature;
+
+	if (ContainsBindable(m_pipelineStateBindables, bindable))
+		invalidation |= invalidation_pipelineState;
+
+	return invalidation;
+}
+
+void BindableContainer::Invalidate(int invalidation)
+{
+	if (invalidation == invalidation_none)
+		return;
+
+	if (invalidation & invalidation_commandList)
+		m_revision.commandListRevision++;
+
+	if (invalidation & invalidation_descriptor)
+		m_revision.descriptorRevision++;
+
+	if (invalidation & invalidation_rootSignature)
+		m_revision.rootSignatureRevision++;
+
+	if (invalidation & invalidation_pipelineState)
+		m_revision.pipelineStateRevision++;
+
+	for (BindableContainerListener* listener : m_observers.listeners)
+		listener->InvalidationCallback(invalidation);
+}
+
 void BindableContainer::AddBindableWrapper(std::shared_ptr<Bindable> wrapper)
 {
 	Bindable* pWrapper = wrapper.get();
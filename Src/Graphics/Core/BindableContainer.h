@@ -20,12 +20,26 @@ struct BindableContainerRevision
 	unsigned long long rootSignatureRevision = 0;
 };
 
-struct CachedRevision
+// parts of container that were changed, listeners get them combined into one int
+enum BindableContainerInvalidation
 {
-	const UpdatableBindable* object = nullptr;
-	unsigned long long revision = 0;
+	invalidation_none = 0,
+	invalidation_commandList = 1 << 0,
+	invalidation_descriptor = 1 << 1,
+	invalidation_rootSignature = 1 << 2,
+	invalidation_pipelineState = 1 << 3,
 };
 
+class BindableContainerListener
+{
+public:
+	virtual ~BindableContainerListener() = default;
+
+	virtual void InvalidationCallback(int invalidation) = 0;
+};
+
+// changes are pushed instead of polled. After Initialize() container observes its bindables, and when one of them
+// calls SetUpdated() or new bindable is added, listeners are notified right away. Nothing is checked on frames without changes
 class BindableContainer
 {
 public:
@@ -36,7 +50,7 @@ public:
 	BindableContainer& operator=(BindableContainer&& other) noexcept = default;
 	BindableContainer& operator=(const BindableContainer& other) = default;
 
-	virtual ~BindableContainer() = default;
+	virtual ~BindableContainer();
 	
 public:
 	void AddBindable(std::shared_ptr<Bindable> bindable);
@@ -52,8 +66,14 @@ public:
 
 public:
 	virtual void Initialize(Graphics& graphics, Pipeline& pipeline);
-	
-	void Update();
+
+	// listeners don't change contents of container, so they can register to const containers.
+	// Registration isn't checked for duplicates and lasts for lifetime of container, listener has to stay alive while container can still be invalidated
+	void RegisterForInvalidation(BindableContainerListener* listener) const;
+
+	// called by observed bindables
+	void OnBindableUpdated(const UpdatableBindable* bindable);
+	void StopObserving(const UpdatableBindable* bindable);
 
 	virtual void SegregateBindableByClass(Bindable* bindable);
 	void SegregateBindableBaseFunctionality(Bindable* bindable);
@@ -69,6 +89,11 @@ public:
 private:
 	void AddBindableWrapper(std::shared_ptr<Bindable> wrapper);
 
+	void Observe(UpdatableBindable* bindable);
+
+	int GetInvalidation(const UpdatableBindable* bindable) const;
+	void Invalidate(int invalidation);
+
 protected:
 	// vector owning potentially shared bindables
 	std::vector<std::shared_ptr<Bindable>> m_bindables;
@@ -82,10 +107,22 @@ protected:
 	std::vector<const char*> m_staticBindableNames;
 
 	BindableContainerRevision m_revision;
-	std::vector<CachedRevision> m_commandListLastSeenRevisions;
-	std::vector<CachedRevision> m_descriptorLastSeenRevisions;
-	std::vector<CachedRevision> m_rootSignatureLastSeenRevisions;
-	std::vector<CachedRevision> m_pipelineStateLastSeenRevisions;
+
+private:
+	// registrations are tied to address of container, so copies and moves start without them
+	// and begin observing when they are initialized
+	struct Observers
+	{
+		Observers() = default;
+		Observers(const Observers& other) noexcept {}
+		Observers& operator=(const Observers& other) noexcept { return *this; }
+
+		std::vector<UpdatableBindable*> bindables;
+		std::vector<BindableContainerListener*> listeners;
+		bool observing = false;
+	};
+
+	mutable Observers m_observers;
 };
 
 class MeshBindableContainer : public BindableContainer
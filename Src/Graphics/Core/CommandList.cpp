@@ -15,14 +15,20 @@
 
 #include "Graphics/Bindables/DescriptorHeapBindable.h"
 
-#include "Pix.h"
+#include "Graphics/Profiler/RenderStats.h"
+#include "Graphics/Profiler/CommandStream.h"
 
 bool CommandListState::SetRootSignature(RootSignature* _rootSignature)
 {
 	THROW_INTERNAL_ERROR_IF("Passed RootSignature was null", _rootSignature == nullptr);
 
 	if (rootSignature == _rootSignature)
+	{
+		RenderStats::Add(RenderCounter::RootSignaturesFiltered);
 		return false;
+	}
+
+	RenderStats::Add(RenderCounter::RootSignatures);
 
 	rootSignature = _rootSignature;
 	rootBindables.assign(rootSignature->GetNumParams(), nullptr);
@@ -35,7 +41,12 @@ bool CommandListState::SetPipelineState(PipelineState* _pipelineState)
 	THROW_INTERNAL_ERROR_IF("Passed PipelineState was null", _pipelineState == nullptr);
 
 	if (pipelineState == _pipelineState)
+	{
+		RenderStats::Add(RenderCounter::PipelineStatesFiltered);
 		return false;
+	}
+
+	RenderStats::Add(RenderCounter::PipelineStates);
 
 	pipelineState = _pipelineState;
 	return true;
@@ -49,7 +60,12 @@ bool CommandListState::SetRootSignatureParam(unsigned int paramIndex, Bindable*
 	auto& currentRootBind = rootBindables.at(paramIndex);
 
 	if (currentRootBind == rootBindable)
+	{
+		RenderStats::Add(RenderCounter::RootParametersFiltered);
 		return false;
+	}
+
+	RenderStats::Add(RenderCounter::RootParameters);
 
 	currentRootBind = rootBindable;
 	return true;
@@ -97,55 +113,40 @@ bool CommandListState::SetViewPort(ViewPort* _viewPort)
 
 CommandList::CommandList(Graphics& graphics, D3D12_COMMAND_LIST_TYPE type, PipelineState* pPipelineState)
 	:
-	m_pCommandAllocators(graphics.GetBufferCount()),
 	m_type(type),
 	m_initialized(true),
-	m_open(false),
-	m_currCommandAllocatorIndex(0)
+	m_open(false)
 {
-	HRESULT hr;
-
-	// initializing command allocators
-	{
-		for(unsigned int currAllocatorIndex = 0; currAllocatorIndex < m_pCommandAllocators.size(); currAllocatorIndex++)
-			THROW_ERROR(graphics.GetDeviceResources().GetDevice()->CreateCommandAllocator(type, IID_PPV_ARGS(&m_pCommandAllocators.at(currAllocatorIndex))));
-	}
-
 	ID3D12PipelineState* pipelineState = (pPipelineState == nullptr) ? nullptr : pPipelineState->Get();
 
-	THROW_ERROR(graphics.GetDeviceResources().GetDevice()->CreateCommandList(0, type, m_pCommandAllocators.at(m_currCommandAllocatorIndex).Get(), pipelineState, IID_PPV_ARGS(&pCommandList)));
-
-	THROW_ERROR(pCommandList->Close());
+	// every frame in flight gets its own allocator
+	m_recorder = graphics.GetDevice().CreateCommandRecorder(graphics, type, graphics.GetBufferCount(), pipelineState);
 }
 
 void CommandList::Open(Graphics& graphics, PipelineState* pPipelineState)
 {
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 
-	HRESULT hr;
 	ID3D12PipelineState* pipelineState = (pPipelineState == nullptr) ? nullptr : pPipelineState->Get();
-	
-	m_currCommandAllocatorIndex = graphics.GetCurrentBufferIndex();
 
-	// reset currently used command allocator
-	THROW_ERROR(m_pCommandAllocators.at(m_currCommandAllocatorIndex)->Reset());
-
-	THROW_ERROR(pCommandList->Reset(m_pCommandAllocators.at(m_currCommandAllocatorIndex).Get(), pipelineState));
+	m_recorder->Reset(graphics, graphics.GetCurrentBufferIndex(), pipelineState);
 
 	m_open = true;
 
 	m_state = CommandListState{}; // reseting state since command list on gpu has no state after reset
+
+	CAPTURE_COMMAND(StreamCommand::OpenList, CommandStream::GetObjectId(this), uint32_t(m_type));
 }
 
 void CommandList::Close(Graphics& graphics)
 {
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 
-	HRESULT hr;
-
-	THROW_ERROR(pCommandList->Close());
+	m_recorder->Close(graphics);
 
 	m_open = false;
+
+	CAPTURE_COMMAND(StreamCommand::CloseList, CommandStream::GetObjectId(this));
 }
 
 void CommandList::DrawIndexed(Graphics& graphics, unsigned int indices, unsigned int baseVertexOffset, unsigned int startIndexOffset)
@@ -153,7 +154,23 @@ void CommandList::DrawIndexed(Graphics& graphics, unsigned int indices, unsigned
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 	THROW_OBJECT_STATE_ERROR_IF("Only Direct and Bundle command lists can DrawIndexed", m_type != D3D12_COMMAND_LIST_TYPE_DIRECT && m_type != D3D12_COMMAND_LIST_TYPE_BUNDLE);
 
-	THROW_INFO_ERROR(pCommandList->DrawIndexedInstanced(indices, 1, startIndexOffset, baseVertexOffset, 0));
+	RenderStats::Add(RenderCounter::DrawCalls);
+	RenderStats::Add(RenderCounter::Instances);
+	CAPTURE_COMMAND(StreamCommand::DrawIndexed, indices, baseVertexOffset, startIndexOffset, 1);
+
+	m_recorder->DrawIndexedInstanced(graphics, indices, 1, startIndexOffset, baseVertexOffset);
+}
+
+void CommandList::DrawIndexedInstanced(Graphics& graphics, unsigned int indices, unsigned int instances, unsigned int baseVertexOffset, unsigned int startIndexOffset)
+{
+	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
+	THROW_OBJECT_STATE_ERROR_IF("Only Direct and Bundle command lists can DrawIndexed", m_type != D3D12_COMMAND_LIST_TYPE_DIRECT && m_type != D3D12_COMMAND_LIST_TYPE_BUNDLE);
+
+	RenderStats::Add(RenderCounter::DrawCalls);
+	RenderStats::Add(RenderCounter::Instances, instances);
+	CAPTURE_COMMAND(StreamCommand::DrawIndexed, indices, baseVertexOffset, startIndexOffset, instances);
+
+	m_recorder->DrawIndexedInstanced(graphics, indices, instances, startIndexOffset, baseVertexOffset);
 }
 
 void CommandList::Dispatch(Graphics& graphics, unsigned int workToProcessX, unsigned int workToProcessY, unsigned int workToProcessZ)
@@ -161,12 +178,20 @@ void CommandList::Dispatch(Graphics& graphics, unsigned int workToProcessX, unsi
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 	THROW_OBJECT_STATE_ERROR_IF("Only Direct and Bundle command lists can dispatch compute pipeline", m_type != D3D12_COMMAND_LIST_TYPE_DIRECT && m_type != D3D12_COMMAND_LIST_TYPE_COMPUTE);
 
-	THROW_INFO_ERROR(pCommandList->Dispatch(workToProcessX, workToProcessY, workToProcessZ));
+	RenderStats::Add(RenderCounter::Dispatches);
+	CAPTURE_COMMAND(StreamCommand::Dispatch, workToProcessX, workToProcessY, workToProcessZ);
+
+	m_recorder->Dispatch(graphics, workToProcessX, workToProcessY, workToProcessZ);
 }
 
 ID3D12GraphicsCommandList* CommandList::Get()
 {
-	return pCommandList.Get();
+	return m_recorder->GetNative();
+}
+
+CommandRecorder* CommandList::GetRecorder()
+{
+	return m_recorder.get();
 }
 
 bool CommandList::IsOpen() const
@@ -177,21 +202,17 @@ bool CommandList::IsOpen() const
 #ifdef _DEBUG
 void CommandList::SetMarker(std::string_view name)
 {
-	static UINT markerColor = PIX_COLOR(0, 255, 255);
-
-	SET_GPU_MARKER(pCommandList.Get(), markerColor, name.data());
+	m_recorder->SetMarker(name);
 }
 
 void CommandList::BeginEvent(std::string_view name)
 {
-	static UINT eventColor = PIX_COLOR(255, 0, 255);
-
-	START_GPU_EVENT(pCommandList.Get(), eventColor, name.data());
+	m_recorder->BeginEvent(name);
 }
 
 void CommandList::EndEvent()
 {
-	END_GPU_EVENT(pCommandList.Get());
+	m_recorder->EndEvent();
 }
 #endif
 
@@ -232,17 +253,16 @@ void CommandList::BeginRenderPass(Graphics& graphics, RenderPass* renderPass)
 	const D3D12_RENDER_PASS_RENDER_TARGET_DESC* targetRTDesc = numRenderTargets > 0 ? renderPasRenderTargetDescs.data() : nullptr;
 	const D3D12_RENDER_PASS_DEPTH_STENCIL_DESC* targetDDSesc = depthStencilView.resource ? &renderPassDepthStencilDesc : nullptr;
 
-	THROW_INFO_ERROR(pCommandList->BeginRenderPass(
-		numRenderTargets,
-		targetRTDesc,
-		targetDDSesc,
-		D3D12_RENDER_PASS_FLAG_NONE
-	));
+	CAPTURE_COMMAND(StreamCommand::BeginRenderPass, numRenderTargets, depthStencilView.resource ? 1 : 0);
+
+	m_recorder->BeginRenderPass(graphics, numRenderTargets, targetRTDesc, targetDDSesc);
 }
 
 void CommandList::EndRenderPass(Graphics& graphics)
 { 
-	THROW_INFO_ERROR(pCommandList->EndRenderPass());
+	CAPTURE_COMMAND(StreamCommand::EndRenderPass);
+
+	m_recorder->EndRenderPass(graphics);
 }
 
 void CommandList::Query(Graphics& graphics, QueryHeap* queryHeap, unsigned int entryIndex, D3D12_QUERY_TYPE queryType)
@@ -250,21 +270,14 @@ void CommandList::Query(Graphics& graphics, QueryHeap* queryHeap, unsigned int e
 	THROW_OBJECT_STATE_ERROR_IF("Cannot call Query on non-executive command list", m_type != D3D12_COMMAND_LIST_TYPE_DIRECT && m_type != D3D12_COMMAND_LIST_TYPE_COMPUTE);
 	THROW_INTERNAL_ERROR_IF("Tried to access entries outside of QueryHeap", queryHeap->GetNumElements() < entryIndex + 1);
 
-	THROW_INFO_ERROR(pCommandList->EndQuery(queryHeap->Get(), queryType, entryIndex));
+	m_recorder->EndQuery(graphics, queryHeap->Get(), queryType, entryIndex);
 }
 
 void CommandList::ResolveQuery(Graphics& graphics, QueryHeap* queryHeap, D3D12_QUERY_TYPE queryType, unsigned int entryIndex, unsigned int numEntries, GraphicsBuffer* resultBuffer, unsigned int destOffset)
 {
 	THROW_INTERNAL_ERROR_IF("Tried to access entries outside of QueryHeap", queryHeap->GetNumElements() < entryIndex + numEntries);
 
-	THROW_INFO_ERROR(pCommandList->ResolveQueryData(
-		queryHeap->Get(),
-		queryType,
-		entryIndex,
-		numEntries,
-		resultBuffer->GetResource(),
-		destOffset
-	));
+	m_recorder->ResolveQueryData(graphics, queryHeap->Get(), queryType, entryIndex, numEntries, resultBuffer->GetResource(), destOffset);
 }
 
 void CommandList::SetResourceToTargetState(Graphics& graphics, GraphicsResource* resource, unsigned int targetSubresource) const
@@ -318,7 +331,24 @@ void CommandList::SetResourceState(Graphics& graphics, ID3D12Resource* resource,
 	resourceBarrier.Transition.StateBefore = prevState;
 	resourceBarrier.Transition.StateAfter = newState;
 
-	THROW_INFO_ERROR(pCommandList->ResourceBarrier(1, &resourceBarrier));
+	RenderStats::Add(RenderCounter::ResourceBarriers);
+	CAPTURE_COMMAND(StreamCommand::ResourceBarrier, 1);
+
+	m_recorder->ResourceBarrier(graphics, 1, &resourceBarrier);
+}
+
+void CommandList::ResourceBarrier(Graphics& graphics, const std::vector<D3D12_RESOURCE_BARRIER>& barriers) const
+{
+	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
+	THROW_OBJECT_STATE_ERROR_IF("Non-direct command list object", m_type != D3D12_COMMAND_LIST_TYPE_DIRECT);
+
+	if (barriers.empty())
+		return;
+
+	RenderStats::Add(RenderCounter::ResourceBarriers, barriers.size());
+	CAPTURE_COMMAND(StreamCommand::ResourceBarrier, uint32_t(barriers.size()));
+
+	m_recorder->ResourceBarrier(graphics, unsigned int(barriers.size()), barriers.data());
 }
 
 void CommandList::SetRenderTarget(Graphics& graphics, RenderTarget* renderTarget, DepthStencilViewBase* depthStencilView)
@@ -326,14 +356,14 @@ void CommandList::SetRenderTarget(Graphics& graphics, RenderTarget* renderTarget
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 	THROW_OBJECT_STATE_ERROR_IF("Non-direct command list object", m_type != D3D12_COMMAND_LIST_TYPE_DIRECT);
 
+	CAPTURE_COMMAND(StreamCommand::SetRenderTarget, CommandStream::GetObjectId(renderTarget), CommandStream::GetObjectId(depthStencilView));
+
 	// binding render target to command list
 	{
 		// here we can set to bind arrays of rtv and dsv descriptors, for now we will just pass ptr to single descriptor
-		const D3D12_CPU_DESCRIPTOR_HANDLE* pRenderTargetViewDescriptor = &renderTarget->GetDescriptor(graphics);
-
 		const D3D12_CPU_DESCRIPTOR_HANDLE* pDepthStencilViewDescriptor = depthStencilView != nullptr ? &depthStencilView->GetDescriptor(graphics) : nullptr;
 
-		THROW_INFO_ERROR(pCommandList->OMSetRenderTargets(1, pRenderTargetViewDescriptor, false, pDepthStencilViewDescriptor));
+		m_recorder->SetRenderTarget(graphics, renderTarget->GetDescriptor(graphics), pDepthStencilViewDescriptor);
 	}
 }
 
@@ -342,10 +372,12 @@ void CommandList::SetVertexBuffer(Graphics& graphics, VertexBuffer* vertexBuffer
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 	THROW_OBJECT_STATE_ERROR_IF("Only Direct and Bundle command lists can set vertex buffers", m_type != D3D12_COMMAND_LIST_TYPE_DIRECT && m_type != D3D12_COMMAND_LIST_TYPE_BUNDLE);
 
+	CAPTURE_COMMAND(StreamCommand::SetVertexBuffer, CommandStream::GetObjectId(vertexBuffer));
+
 	if (!m_state.SetVertexBuffer(vertexBuffer))
 		return;
 
-	THROW_INFO_ERROR(pCommandList->IASetVertexBuffers(0, 1, vertexBuffer->Get()));
+	m_recorder->SetVertexBuffer(graphics, vertexBuffer->Get());
 }
 
 void CommandList::SetIndexBuffer(Graphics& graphics, IndexBuffer* indexBuffer)
@@ -353,10 +385,12 @@ void CommandList::SetIndexBuffer(Graphics& graphics, IndexBuffer* indexBuffer)
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 	THROW_OBJECT_STATE_ERROR_IF("Only Direct and Bundle command lists can set index buffers", m_type != D3D12_COMMAND_LIST_TYPE_DIRECT && m_type != D3D12_COMMAND_LIST_TYPE_BUNDLE);
 
+	CAPTURE_COMMAND(StreamCommand::SetIndexBuffer, CommandStream::GetObjectId(indexBuffer));
+
 	if (!m_state.SetIndexBuffer(indexBuffer))
 		return;
 
-	THROW_INFO_ERROR(pCommandList->IASetIndexBuffer(indexBuffer->Get()));
+	m_recorder->SetIndexBuffer(graphics, indexBuffer->Get());
 }
 
 void CommandList::SetPrimitiveTopology(Graphics& graphics, D3D_PRIMITIVE_TOPOLOGY primitiveTechnology)
@@ -364,10 +398,12 @@ void CommandList::SetPrimitiveTopology(Graphics& graphics, D3D_PRIMITIVE_TOPOLOG
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 	THROW_OBJECT_STATE_ERROR_IF("Only Direct and Bundle command lists can set topology", m_type != D3D12_COMMAND_LIST_TYPE_DIRECT && m_type != D3D12_COMMAND_LIST_TYPE_BUNDLE);
 	
+	CAPTURE_COMMAND(StreamCommand::SetPrimitiveTopology, uint32_t(primitiveTechnology));
+
 	if (!m_state.SetPrimitiveTechnology(primitiveTechnology))
 		return;
 
-	THROW_INFO_ERROR(pCommandList->IASetPrimitiveTopology(primitiveTechnology));
+	m_recorder->SetPrimitiveTopology(graphics, primitiveTechnology);
 }
 
 void CommandList::SetViewPort(Graphics& graphics, ViewPort* viewPort)
@@ -375,11 +411,12 @@ void CommandList::SetViewPort(Graphics& graphics, ViewPort* viewPort)
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 	THROW_OBJECT_STATE_ERROR_IF("Only graphics command list can set viewport", m_type != D3D12_COMMAND_LIST_TYPE_DIRECT);
 
+	CAPTURE_COMMAND(StreamCommand::SetViewPort, CommandStream::GetObjectId(viewPort));
+
 	if (!m_state.SetViewPort(viewPort))
 		return;
 
-	THROW_INFO_ERROR(pCommandList->RSSetViewports(1, &viewPort->GetViewport()));
-	THROW_INFO_ERROR(pCommandList->RSSetScissorRects(1, &viewPort->GetViewportRect()));
+	m_recorder->SetViewport(graphics, viewPort->GetViewport(), viewPort->GetViewportRect());
 }
 
 void CommandList::SetGraphicsRootSignature(Graphics& graphics, RootSignature* rootSignature)
@@ -387,10 +424,12 @@ void CommandList::SetGraphicsRootSignature(Graphics& graphics, RootSignature* ro
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 	THROW_OBJECT_STATE_ERROR_IF("Only Direct and Bundle command lists can set graphics root signature", m_type != D3D12_COMMAND_LIST_TYPE_DIRECT && m_type != D3D12_COMMAND_LIST_TYPE_BUNDLE);
 
+	CAPTURE_COMMAND(StreamCommand::SetGraphicsRootSignature, CommandStream::GetObjectId(rootSignature));
+
 	if (!m_state.SetRootSignature(rootSignature))
 		return;
 
-	THROW_INFO_ERROR(pCommandList->SetGraphicsRootSignature(rootSignature->Get()));
+	m_recorder->SetRootSignature(graphics, CommandRecorder::BindPoint::graphics, rootSignature->Get());
 }
 
 void CommandList::SetGraphicsConstBufferView(Graphics& graphics, ConstantBuffer* constBuffer, const RootBinding& binding)
@@ -398,10 +437,12 @@ void CommandList::SetGraphicsConstBufferView(Graphics& graphics, ConstantBuffer*
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 	THROW_OBJECT_STATE_ERROR_IF("Only Direct and Bundle command lists can set graphics constant buffers", m_type != D3D12_COMMAND_LIST_TYPE_DIRECT && m_type != D3D12_COMMAND_LIST_TYPE_BUNDLE);
 
+	CAPTURE_COMMAND(StreamCommand::SetGraphicsRootParam, binding.rootIndex, CommandStream::GetObjectId(constBuffer));
+
 	if (!m_state.SetRootSignatureParam(binding.rootIndex, constBuffer))
 		return;
 
-	THROW_INFO_ERROR(pCommandList->SetGraphicsRootConstantBufferView(binding.rootIndex, constBuffer->GetGPUAddress(graphics)));
+	m_recorder->SetRootConstantBufferView(graphics, CommandRecorder::BindPoint::graphics, binding.rootIndex, constBuffer->GetGPUAddress(graphics));
 }
 
 void CommandList::SetDescriptorHeap(Graphics& graphics, DescriptorHeap* descriptorHeap)
@@ -409,9 +450,9 @@ void CommandList::SetDescriptorHeap(Graphics& graphics, DescriptorHeap* descript
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 	THROW_OBJECT_STATE_ERROR_IF("Copy command lists cannot set descriptor heaps", m_type == D3D12_COMMAND_LIST_TYPE_COPY);
 
-	ID3D12DescriptorHeap* descriptorHeaps[] = { descriptorHeap->Get()};
+	CAPTURE_COMMAND(StreamCommand::SetDescriptorHeap, CommandStream::GetObjectId(descriptorHeap));
 
-	THROW_INFO_ERROR(pCommandList->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps));
+	m_recorder->SetDescriptorHeap(graphics, descriptorHeap->Get());
 }
 
 void CommandList::SetGraphicsDescriptor(Graphics& graphics, Buffer* buffer, const RootBinding& binding)
@@ -419,10 +460,12 @@ void CommandList::SetGraphicsDescriptor(Graphics& graphics, Buffer* buffer, cons
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 	THROW_OBJECT_STATE_ERROR_IF("Only Direct and Bundle command lists can set graphics Descriptor Tables", m_type != D3D12_COMMAND_LIST_TYPE_DIRECT && m_type != D3D12_COMMAND_LIST_TYPE_BUNDLE);
 
+	CAPTURE_COMMAND(StreamCommand::SetGraphicsRootParam, binding.rootIndex, CommandStream::GetObjectId(buffer));
+
 	if (!m_state.SetRootSignatureParam(binding.rootIndex, buffer))
 		return;
 
-	THROW_INFO_ERROR(pCommandList->SetGraphicsRootShaderResourceView(binding.rootIndex, buffer->GetGPUAddress(graphics)));
+	m_recorder->SetRootShaderResourceView(graphics, CommandRecorder::BindPoint::graphics, binding.rootIndex, buffer->GetGPUAddress(graphics));
 }
 
 void CommandList::SetGraphicsDescriptorTable(Graphics& graphics, DescriptorHeapBindable* descriptorHeapBindable, const RootBinding& binding)
@@ -430,10 +473,12 @@ void CommandList::SetGraphicsDescriptorTable(Graphics& graphics, DescriptorHeapB
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 	THROW_OBJECT_STATE_ERROR_IF("Only Direct and Bundle command lists can set graphics Descriptor Tables", m_type != D3D12_COMMAND_LIST_TYPE_DIRECT && m_type != D3D12_COMMAND_LIST_TYPE_BUNDLE);
 
+	CAPTURE_COMMAND(StreamCommand::SetGraphicsRootParam, binding.rootIndex, CommandStream::GetObjectId(descriptorHeapBindable));
+
 	if (!m_state.SetRootSignatureParam(binding.rootIndex, descriptorHeapBindable))
 		return;
 
-	THROW_INFO_ERROR(pCommandList->SetGraphicsRootDescriptorTable(binding.rootIndex, descriptorHeapBindable->GetDescriptorHeapGPUHandle(graphics)));
+	m_recorder->SetRootDescriptorTable(graphics, CommandRecorder::BindPoint::graphics, binding.rootIndex, descriptorHeapBindable->GetDescriptorHeapGPUHandle(graphics));
 }
 
 void CommandList::SetGraphicsDescriptorTable(Graphics& graphics, ShaderResourceViewBase* srv, const RootBinding& binding)
@@ -441,10 +486,12 @@ void CommandList::SetGraphicsDescriptorTable(Graphics& graphics, ShaderResourceV
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 	THROW_OBJECT_STATE_ERROR_IF("Only Direct and Bundle command lists can set graphics Descriptor Tables", m_type != D3D12_COMMAND_LIST_TYPE_DIRECT && m_type != D3D12_COMMAND_LIST_TYPE_BUNDLE);
 
+	CAPTURE_COMMAND(StreamCommand::SetGraphicsRootParam, binding.rootIndex, CommandStream::GetObjectId(srv));
+
 	if (!m_state.SetRootSignatureParam(binding.rootIndex, srv))
 		return;
 
-	THROW_INFO_ERROR(pCommandList->SetGraphicsRootDescriptorTable(binding.rootIndex, srv->GetDescriptorHeapGPUHandle(graphics)));
+	m_recorder->SetRootDescriptorTable(graphics, CommandRecorder::BindPoint::graphics, binding.rootIndex, srv->GetDescriptorHeapGPUHandle(graphics));
 }
 
 void CommandList::SetGraphicsDescriptorTable(Graphics& graphics, UnorderedAccessView* uav, const RootBinding& binding)
@@ -452,10 +499,12 @@ void CommandList::SetGraphicsDescriptorTable(Graphics& graphics, UnorderedAccess
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 	THROW_OBJECT_STATE_ERROR_IF("Only Direct and Bundle command lists can set graphics Descriptor Tables", m_type != D3D12_COMMAND_LIST_TYPE_DIRECT && m_type != D3D12_COMMAND_LIST_TYPE_BUNDLE);
 
+	CAPTURE_COMMAND(StreamCommand::SetGraphicsRootParam, binding.rootIndex, CommandStream::GetObjectId(uav));
+
 	if (!m_state.SetRootSignatureParam(binding.rootIndex, uav))
 		return;
 
-	THROW_INFO_ERROR(pCommandList->SetGraphicsRootDescriptorTable(binding.rootIndex, uav->GetDescriptorHeapGPUHandle(graphics)));
+	m_recorder->SetRootDescriptorTable(graphics, CommandRecorder::BindPoint::graphics, binding.rootIndex, uav->GetDescriptorHeapGPUHandle(graphics));
 }
 
 void CommandList::SetRootConstants(Graphics& graphics, RootSignatureConstants* constants, const RootBinding& binding)
@@ -463,10 +512,28 @@ void CommandList::SetRootConstants(Graphics& graphics, RootSignatureConstants* c
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 	THROW_OBJECT_STATE_ERROR_IF("Only Direct and Bundle command lists can set graphics constant buffers", m_type != D3D12_COMMAND_LIST_TYPE_DIRECT && m_type != D3D12_COMMAND_LIST_TYPE_BUNDLE);
 
+	CAPTURE_COMMAND(StreamCommand::SetGraphicsRootParam, binding.rootIndex, CommandStream::GetObjectId(constants));
+
 	if (!m_state.SetRootSignatureParam(binding.rootIndex, constants) && !constants->IsUpdated())
 		return;
 
-	THROW_INFO_ERROR(pCommandList->SetGraphicsRoot32BitConstants(binding.rootIndex, constants->GetNumValues(), constants->GetDataPtr(), 0));
+	m_recorder->SetRoot32BitConstants(graphics, CommandRecorder::BindPoint::graphics, binding.rootIndex, constants->GetNumValues(), constants->GetDataPtr());
+}
+
+void CommandList::SetGraphicsInstanceBuffer(Graphics& graphics, InstanceBuffer* instanceBuffer, const RootBinding& binding)
+{
+	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
+	THROW_OBJECT_STATE_ERROR_IF("Only Direct and Bundle command lists can set graphics instance buffers", m_type != D3D12_COMMAND_LIST_TYPE_DIRECT && m_type != D3D12_COMMAND_LIST_TYPE_BUNDLE);
+
+	CAPTURE_COMMAND(StreamCommand::SetGraphicsRootParam, binding.rootIndex, CommandStream::GetObjectId(instanceBuffer));
+
+	// the same instance buffer points to instances of other batch after every batch
+	if (!m_state.SetRootSignatureParam(binding.rootIndex, instanceBuffer) && !instanceBuffer->IsChanged())
+		return;
+
+	instanceBuffer->SetBound();
+
+	m_recorder->SetRootShaderResourceView(graphics, CommandRecorder::BindPoint::graphics, binding.rootIndex, instanceBuffer->GetGPUAddress(graphics));
 }
 
 void CommandList::ExecuteBundle(Graphics& graphics, CommandList* commandList)
@@ -474,7 +541,7 @@ void CommandList::ExecuteBundle(Graphics& graphics, CommandList* commandList)
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 	THROW_OBJECT_STATE_ERROR_IF("Non-direct command list object", m_type != D3D12_COMMAND_LIST_TYPE_DIRECT);
 
-	THROW_INFO_ERROR(pCommandList->ExecuteBundle(commandList->Get()));
+	m_recorder->ExecuteBundle(graphics, commandList->GetRecorder());
 }
 
 void CommandList::ClearRenderTargetView(Graphics& graphics, RenderTarget* renderTarget)
@@ -482,14 +549,11 @@ void CommandList::ClearRenderTargetView(Graphics& graphics, RenderTarget* render
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 	THROW_OBJECT_STATE_ERROR_IF("Non-direct command list object", m_type != D3D12_COMMAND_LIST_TYPE_DIRECT);
 	
+	CAPTURE_COMMAND(StreamCommand::Clear, CommandStream::GetObjectId(renderTarget));
+
 	FLOAT clearColor[] = { 0.01f, 0.02f, 0.03f, 1.0f };
 
-	THROW_INFO_ERROR(pCommandList->ClearRenderTargetView(
-		renderTarget->GetDescriptor(graphics),
-		clearColor,
-		0,
-		nullptr
-	));
+	m_recorder->ClearRenderTargetView(graphics, renderTarget->GetDescriptor(graphics), clearColor);
 };
 
 void CommandList::ClearDepthStencilView(Graphics& graphics, DepthStencilViewBase* depthStencilView)
@@ -497,24 +561,34 @@ void CommandList::ClearDepthStencilView(Graphics& graphics, DepthStencilViewBase
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 	THROW_OBJECT_STATE_ERROR_IF("Non-direct command list object", m_type != D3D12_COMMAND_LIST_TYPE_DIRECT);
 
-	THROW_INFO_ERROR(pCommandList->ClearDepthStencilView(
-		depthStencilView->GetDescriptor(graphics),
-		D3D12_CLEAR_FLAG_DEPTH | D3D12_CLEAR_FLAG_STENCIL,
-		1.0f,
-		0.0f,
-		0,
-		nullptr
-	));
+	CAPTURE_COMMAND(StreamCommand::Clear, CommandStream::GetObjectId(depthStencilView));
+
+	m_recorder->ClearDepthStencilView(graphics, depthStencilView->GetDescriptor(graphics), 1.0f, 0, 0, nullptr);
 };
 
+void CommandList::ClearDepthStencilView(Graphics& graphics, DepthStencilViewBase* depthStencilView, const std::vector<D3D12_RECT>& rects)
+{
+	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
+	THROW_OBJECT_STATE_ERROR_IF("Non-direct command list object", m_type != D3D12_COMMAND_LIST_TYPE_DIRECT);
+
+	if (rects.empty())
+		return;
+
+	CAPTURE_COMMAND(StreamCommand::Clear, CommandStream::GetObjectId(depthStencilView));
+
+	m_recorder->ClearDepthStencilView(graphics, depthStencilView->GetDescriptor(graphics), 1.0f, 0, unsigned int(rects.size()), rects.data());
+}
+
 void CommandList::SetPipelineState(Graphics& graphics, PipelineState* pPipelineState)
 {
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 
+	CAPTURE_COMMAND(StreamCommand::SetPipelineState, CommandStream::GetObjectId(pPipelineState));
+
 	if (!m_state.SetPipelineState(pPipelineState))
 		return;
 
-	THROW_INFO_ERROR(pCommandList->SetPipelineState(pPipelineState->Get()));
+	m_recorder->SetPipelineState(graphics, pPipelineState->Get());
 }
 
 void CommandList::SetComputeRootSignature(Graphics& graphics, RootSignature* rootSignature)
@@ -522,7 +596,9 @@ void CommandList::SetComputeRootSignature(Graphics& graphics, RootSignature* roo
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 	THROW_OBJECT_STATE_ERROR_IF("Only Compute and Direct command lists can set compute root signature", m_type != D3D12_COMMAND_LIST_TYPE_COMPUTE && m_type != D3D12_COMMAND_LIST_TYPE_DIRECT);
 
-	THROW_INFO_ERROR(pCommandList->SetComputeRootSignature(rootSignature->Get()));
+	CAPTURE_COMMAND(StreamCommand::SetComputeRootSignature, CommandStream::GetObjectId(rootSignature));
+
+	m_recorder->SetRootSignature(graphics, CommandRecorder::BindPoint::compute, rootSignature->Get());
 }
 
 void CommandList::SetComputeConstBufferView(Graphics& graphics, ConstantBuffer* constBuffer, const RootBinding& binding)
@@ -530,7 +606,9 @@ void CommandList::SetComputeConstBufferView(Graphics& graphics, ConstantBuffer*
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 	THROW_OBJECT_STATE_ERROR_IF("Only Compute and Direct command lists can set compute constant buffer view", m_type != D3D12_COMMAND_LIST_TYPE_COMPUTE && m_type != D3D12_COMMAND_LIST_TYPE_DIRECT);
 
-	THROW_INFO_ERROR(pCommandList->SetComputeRootConstantBufferView(binding.rootIndex, constBuffer->GetGPUAddress(graphics)));
+	CAPTURE_COMMAND(StreamCommand::SetComputeRootParam, binding.rootIndex, CommandStream::GetObjectId(constBuffer));
+
+	m_recorder->SetRootConstantBufferView(graphics, CommandRecorder::BindPoint::compute, binding.rootIndex, constBuffer->GetGPUAddress(graphics));
 }
 
 void CommandList::SetComputeDescriptorTable(Graphics& graphics, ShaderResourceViewBase* srv, const RootBinding& binding)
@@ -538,7 +616,9 @@ void CommandList::SetComputeDescriptorTable(Graphics& graphics, ShaderResourceVi
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 	THROW_OBJECT_STATE_ERROR_IF("Only Compute and Direct command lists can set compute descriptor table", m_type != D3D12_COMMAND_LIST_TYPE_COMPUTE && m_type != D3D12_COMMAND_LIST_TYPE_DIRECT);
 
-	THROW_INFO_ERROR(pCommandList->SetComputeRootDescriptorTable(binding.rootIndex, srv->GetDescriptorHeapGPUHandle(graphics)));
+	CAPTURE_COMMAND(StreamCommand::SetComputeRootParam, binding.rootIndex, CommandStream::GetObjectId(srv));
+
+	m_recorder->SetRootDescriptorTable(graphics, CommandRecorder::BindPoint::compute, binding.rootIndex, srv->GetDescriptorHeapGPUHandle(graphics));
 }
 
 void CommandList::SetComputeDescriptorTable(Graphics& graphics, UnorderedAccessView* uav, const RootBinding& binding)
@@ -546,7 +626,9 @@ void CommandList::SetComputeDescriptorTable(Graphics& graphics, UnorderedAccessV
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 	THROW_OBJECT_STATE_ERROR_IF("Only Compute and Direct command lists can set compute descriptor table", m_type != D3D12_COMMAND_LIST_TYPE_COMPUTE && m_type != D3D12_COMMAND_LIST_TYPE_DIRECT);
 
-	THROW_INFO_ERROR(pCommandList->SetComputeRootDescriptorTable(binding.rootIndex, uav->GetDescriptorHeapGPUHandle(graphics)));
+	CAPTURE_COMMAND(StreamCommand::SetComputeRootParam, binding.rootIndex, CommandStream::GetObjectId(uav));
+
+	m_recorder->SetRootDescriptorTable(graphics, CommandRecorder::BindPoint::compute, binding.rootIndex, uav->GetDescriptorHeapGPUHandle(graphics));
 }
 
 void CommandList::SetComputeRootShaderResourceView(Graphics& graphics, ConstantBuffer* constBuffer, const RootBinding& binding)
@@ -554,7 +636,9 @@ void CommandList::SetComputeRootShaderResourceView(Graphics& graphics, ConstantB
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 	THROW_OBJECT_STATE_ERROR_IF("Only Compute and Direct command lists can set compute shader resource view", m_type != D3D12_COMMAND_LIST_TYPE_COMPUTE && m_type != D3D12_COMMAND_LIST_TYPE_DIRECT);
 
-	THROW_INFO_ERROR(pCommandList->SetComputeRootShaderResourceView(binding.rootIndex, constBuffer->GetGPUAddress(graphics)));
+	CAPTURE_COMMAND(StreamCommand::SetComputeRootParam, binding.rootIndex, CommandStream::GetObjectId(constBuffer));
+
+	m_recorder->SetRootShaderResourceView(graphics, CommandRecorder::BindPoint::compute, binding.rootIndex, constBuffer->GetGPUAddress(graphics));
 }
 
 void CommandList::SetComputeRootUnorderedAccessView(Graphics& graphics, ConstantBuffer* constBuffer, const RootBinding& binding)
@@ -562,7 +646,9 @@ void CommandList::SetComputeRootUnorderedAccessView(Graphics& graphics, Constant
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 	THROW_OBJECT_STATE_ERROR_IF("Only Compute and Direct command lists can set compute unordered access view", m_type != D3D12_COMMAND_LIST_TYPE_COMPUTE && m_type != D3D12_COMMAND_LIST_TYPE_DIRECT);
 
-	THROW_INFO_ERROR(pCommandList->SetComputeRootUnorderedAccessView(binding.rootIndex, constBuffer->GetGPUAddress(graphics)));
+	CAPTURE_COMMAND(StreamCommand::SetComputeRootParam, binding.rootIndex, CommandStream::GetObjectId(constBuffer));
+
+	m_recorder->SetRootUnorderedAccessView(graphics, CommandRecorder::BindPoint::compute, binding.rootIndex, constBuffer->GetGPUAddress(graphics));
 }
 
 void CommandList::SetComputeRootConstantBufferView(Graphics& graphics, ConstantBuffer* constBuffer, const RootBinding& binding)
@@ -570,26 +656,26 @@ void CommandList::SetComputeRootConstantBufferView(Graphics& graphics, ConstantB
 	THROW_OBJECT_STATE_ERROR_IF("Command list is not initialized", !m_initialized);
 	THROW_OBJECT_STATE_ERROR_IF("Only Compute and Direct command lists can set compute constant buffer view", m_type != D3D12_COMMAND_LIST_TYPE_COMPUTE && m_type != D3D12_COMMAND_LIST_TYPE_DIRECT);
 
-	THROW_INFO_ERROR(pCommandList->SetComputeRootConstantBufferView(binding.rootIndex, constBuffer->GetGPUAddress(graphics)));
+	CAPTURE_COMMAND(StreamCommand::SetComputeRootParam, binding.rootIndex, CommandStream::GetObjectId(constBuffer));
+
+	m_recorder->SetRootConstantBufferView(graphics, CommandRecorder::BindPoint::compute, binding.rootIndex, constBuffer->GetGPUAddress(graphics));
 }
 
 void CommandList::CopyBufferRegion(Graphics& graphics, ID3D12Resource* dstResource, UINT64 dstOffset, ID3D12Resource* srcResource, UINT64 srcOffset, UINT64 numBytes)
 {
 	THROW_OBJECT_STATE_ERROR_IF("Bundle command lists cannot copy resources", m_type == D3D12_COMMAND_LIST_TYPE_BUNDLE);
 
-	THROW_INFO_ERROR(pCommandList->CopyBufferRegion(
-		dstResource,
-		dstOffset,
-		srcResource,
-		srcOffset,
-		numBytes
-	));
+	CAPTURE_COMMAND(StreamCommand::Copy, CommandStream::GetObjectId(dstResource), CommandStream::GetObjectId(srcResource), uint32_t(numBytes));
+
+	m_recorder->CopyBufferRegion(graphics, dstResource, dstOffset, srcResource, srcOffset, numBytes);
 }
 
 void CommandList::CopyTextureRegion(Graphics& graphics, ID3D12Resource* dstResource, ID3D12Resource* srcResource, unsigned int MipMapLvel)
 {
 	THROW_OBJECT_STATE_ERROR_IF("Bundle command lists cannot copy resources", m_type == D3D12_COMMAND_LIST_TYPE_BUNDLE);
 
+	CAPTURE_COMMAND(StreamCommand::Copy, CommandStream::GetObjectId(dstResource), CommandStream::GetObjectId(srcResource), 0);
+
 	D3D12_TEXTURE_COPY_LOCATION dstTexture;
 	dstTexture.pResource = dstResource;
 	dstTexture.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
@@ -600,20 +686,15 @@ void CommandList::CopyTextureRegion(Graphics& graphics, ID3D12Resource* dstResou
 	srcTexture.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
 	srcTexture.SubresourceIndex = MipMapLvel;
 
-	THROW_INFO_ERROR(pCommandList->CopyTextureRegion(
-		&dstTexture,
-		0,
-		0,
-		0,
-		&srcTexture,
-		nullptr
-	));
+	m_recorder->CopyTextureRegion(graphics, dstTexture, srcTexture);
 }
 
 void CommandList::CopyBufferToTexture(Graphics& graphics, ID3D12Resource* dstResource, ResourceFootprint& dstFootprint, ID3D12Resource* srcResource, unsigned int MipMapLvel)
 {
 	THROW_OBJECT_STATE_ERROR_IF("Bundle command lists cannot copy resources", m_type == D3D12_COMMAND_LIST_TYPE_BUNDLE);
 
+	CAPTURE_COMMAND(StreamCommand::Copy, CommandStream::GetObjectId(dstResource), CommandStream::GetObjectId(srcResource), 0);
+
 	D3D12_TEXTURE_COPY_LOCATION dstTexture;
 	dstTexture.pResource = dstResource;
 	dstTexture.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
@@ -624,24 +705,16 @@ void CommandList::CopyBufferToTexture(Graphics& graphics, ID3D12Resource* dstRes
 	srcTexture.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
 	srcTexture.PlacedFootprint = dstFootprint.layout;
 
-	THROW_INFO_ERROR(pCommandList->CopyTextureRegion(
-		&dstTexture,
-		0,
-		0,
-		0,
-		&srcTexture,
-		nullptr
-	));
+	m_recorder->CopyTextureRegion(graphics, dstTexture, srcTexture);
 }
 
 void CommandList::CopyResource(Graphics& graphics, ID3D12Resource* dstResource, ID3D12Resource* srcResource)
 {
 	THROW_OBJECT_STATE_ERROR_IF("Bundle command lists cannot copy resources", m_type == D3D12_COMMAND_LIST_TYPE_BUNDLE);
 
-	THROW_INFO_ERROR(pCommandList->CopyResource(
-		dstResource,
-		srcResource
-	));
+	CAPTURE_COMMAND(StreamCommand::Copy, CommandStream::GetObjectId(dstResource), CommandStream::GetObjectId(srcResource), 0);
+
+	m_recorder->CopyResource(graphics, dstResource, srcResource);
 }
 
 D3D12_RENDER_PASS_BEGINNING_ACCESS_TYPE CommandList::GetBeginningOP(ResourceDataOperation op)
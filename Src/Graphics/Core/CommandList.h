@@ -2,6 +2,7 @@
 #include "Includes/DirectXIncludes.h"
 #include "Includes/WRLNoWarnings.h"
 #include "BindableContainer.h"
+#include "CommandRecorder.h"
 
 class Graphics;
 class PipelineState;
@@ -18,6 +19,7 @@ class DescriptorHeapBindable;
 class Texture;
 class ShaderResourceViewBase;
 class RootSignatureConstants;
+class InstanceBuffer;
 class DescriptorHeap;
 class UnorderedAccessView;
 class GraphicsResource;
@@ -75,10 +77,15 @@ public:
 
 	void DrawIndexed(Graphics& graphics, unsigned int indices, unsigned int baseVertexOffset = 0, unsigned int startIndexOffset = 0);
 
+	void DrawIndexedInstanced(Graphics& graphics, unsigned int indices, unsigned int instances, unsigned int baseVertexOffset = 0, unsigned int startIndexOffset = 0);
+
 	void Dispatch(Graphics& graphics, unsigned int workToProcessX = 1, unsigned int workToProcessY = 1, unsigned int workToProcessZ = 1);
 	
+	// nullptr on null device
 	ID3D12GraphicsCommandList* Get();
 
+	CommandRecorder* GetRecorder();
+
 	bool IsOpen() const;
 
 public:
@@ -110,6 +117,9 @@ public:
 
 	void SetResourceState(Graphics& graphics, ID3D12Resource* resource, D3D12_RESOURCE_STATES prevState, D3D12_RESOURCE_STATES newState, unsigned int targetSubresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES) const;
 
+	// issues all barriers with one call
+	void ResourceBarrier(Graphics& graphics, const std::vector<D3D12_RESOURCE_BARRIER>& barriers) const;
+
 	void SetVertexBuffer(Graphics& graphics, VertexBuffer* vertexBuffer);
 
 	void SetIndexBuffer(Graphics& graphics, IndexBuffer* indexBuffer);
@@ -136,9 +146,12 @@ public:
 
 	void SetRootConstants(Graphics& graphics, RootSignatureConstants* constants, const RootBinding& binding);
 
+	void SetGraphicsInstanceBuffer(Graphics& graphics, InstanceBuffer* instanceBuffer, const RootBinding& binding);
+
 	void ClearRenderTargetView(Graphics& graphics, RenderTarget* renderTarget);
 
 	void ClearDepthStencilView(Graphics& graphics, DepthStencilViewBase* depthStencilView);
+	void ClearDepthStencilView(Graphics& graphics, DepthStencilViewBase* depthStencilView, const std::vector<D3D12_RECT>& rects);
 
 	void ExecuteBundle(Graphics& graphics, CommandList* commandList);
 
@@ -176,10 +189,8 @@ private: // helpers
 private:
 	CommandListState m_state;
 
-	std::vector<Microsoft::WRL::ComPtr<ID3D12CommandAllocator>> m_pCommandAllocators;
-	Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList7> pCommandList;
+	std::unique_ptr<CommandRecorder> m_recorder;
 	D3D12_COMMAND_LIST_TYPE m_type;
 	bool m_initialized;
 	bool m_open;
-	unsigned int m_currCommandAllocatorIndex;
 };
\ No newline at end of file
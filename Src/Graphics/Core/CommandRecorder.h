@@ -0,0 +1,74 @@
+#pragma once
+#include "Includes/CppIncludes.h"
+#include "Includes/DirectXIncludes.h"
+
+class Graphics;
+
+// records commands for backend that created it. CommandList validates and filters calls, recorder only forwards them
+class CommandRecorder
+{
+public:
+	enum class BindPoint
+	{
+		graphics,
+		compute
+	};
+
+public:
+	virtual ~CommandRecorder() = default;
+
+public:
+	// resets allocator used by given frame and starts recording
+	virtual void Reset(Graphics& graphics, unsigned int allocatorIndex, ID3D12PipelineState* pPipelineState) = 0;
+	virtual void Close(Graphics& graphics) = 0;
+
+	// nullptr on null device
+	virtual ID3D12GraphicsCommandList* GetNative() const = 0;
+
+public:
+	virtual void DrawIndexedInstanced(Graphics& graphics, unsigned int indices, unsigned int instances, unsigned int startIndexOffset, unsigned int baseVertexOffset) = 0;
+	virtual void Dispatch(Graphics& graphics, unsigned int workToProcessX, unsigned int workToProcessY, unsigned int workToProcessZ) = 0;
+	virtual void ExecuteBundle(Graphics& graphics, CommandRecorder* bundle) = 0;
+
+	virtual void BeginRenderPass(Graphics& graphics, unsigned int numRenderTargets, const D3D12_RENDER_PASS_RENDER_TARGET_DESC* renderTargets, const D3D12_RENDER_PASS_DEPTH_STENCIL_DESC* depthStencil) = 0;
+	virtual void EndRenderPass(Graphics& graphics) = 0;
+
+	virtual void EndQuery(Graphics& graphics, ID3D12QueryHeap* pQueryHeap, D3D12_QUERY_TYPE queryType, unsigned int entryIndex) = 0;
+	virtual void ResolveQueryData(Graphics& graphics, ID3D12QueryHeap* pQueryHeap, D3D12_QUERY_TYPE queryType, unsigned int entryIndex, unsigned int numEntries, ID3D12Resource* pDestination, UINT64 destOffset) = 0;
+
+	virtual void ResourceBarrier(Graphics& graphics, unsigned int numBarriers, const D3D12_RESOURCE_BARRIER* barriers) = 0;
+
+public:
+	// state
+	virtual void SetRenderTarget(Graphics& graphics, const D3D12_CPU_DESCRIPTOR_HANDLE& renderTarget, const D3D12_CPU_DESCRIPTOR_HANDLE* depthStencil) = 0;
+	virtual void SetVertexBuffer(Graphics& graphics, const D3D12_VERTEX_BUFFER_VIEW* vertexBufferView) = 0;
+	virtual void SetIndexBuffer(Graphics& graphics, const D3D12_INDEX_BUFFER_VIEW* indexBufferView) = 0;
+	virtual void SetPrimitiveTopology(Graphics& graphics, D3D_PRIMITIVE_TOPOLOGY primitiveTopology) = 0;
+	virtual void SetViewport(Graphics& graphics, const D3D12_VIEWPORT& viewport, const D3D12_RECT& scissorRect) = 0;
+	virtual void SetDescriptorHeap(Graphics& graphics, ID3D12DescriptorHeap* pDescriptorHeap) = 0;
+	virtual void SetPipelineState(Graphics& graphics, ID3D12PipelineState* pPipelineState) = 0;
+
+public:
+	// root bindings
+	virtual void SetRootSignature(Graphics& graphics, BindPoint bindPoint, ID3D12RootSignature* pRootSignature) = 0;
+	virtual void SetRootConstantBufferView(Graphics& graphics, BindPoint bindPoint, unsigned int rootIndex, D3D12_GPU_VIRTUAL_ADDRESS address) = 0;
+	virtual void SetRootShaderResourceView(Graphics& graphics, BindPoint bindPoint, unsigned int rootIndex, D3D12_GPU_VIRTUAL_ADDRESS address) = 0;
+	virtual void SetRootUnorderedAccessView(Graphics& graphics, BindPoint bindPoint, unsigned int rootIndex, D3D12_GPU_VIRTUAL_ADDRESS address) = 0;
+	virtual void SetRootDescriptorTable(Graphics& graphics, BindPoint bindPoint, unsigned int rootIndex, D3D12_GPU_DESCRIPTOR_HANDLE descriptor) = 0;
+	virtual void SetRoot32BitConstants(Graphics& graphics, BindPoint bindPoint, unsigned int rootIndex, unsigned int numValues, const void* data) = 0;
+
+public:
+	// clears and copies
+	virtual void ClearRenderTargetView(Graphics& graphics, D3D12_CPU_DESCRIPTOR_HANDLE renderTarget, const float clearColor[4]) = 0;
+	virtual void ClearDepthStencilView(Graphics& graphics, D3D12_CPU_DESCRIPTOR_HANDLE depthStencil, float depth, UINT8 stencil, unsigned int numRects, const D3D12_RECT* rects) = 0;
+
+	virtual void CopyBufferRegion(Graphics& graphics, ID3D12Resource* dstResource, UINT64 dstOffset, ID3D12Resource* srcResource, UINT64 srcOffset, UINT64 numBytes) = 0;
+	virtual void CopyTextureRegion(Graphics& graphics, const D3D12_TEXTURE_COPY_LOCATION& destination, const D3D12_TEXTURE_COPY_LOCATION& source) = 0;
+	virtual void CopyResource(Graphics& graphics, ID3D12Resource* dstResource, ID3D12Resource* srcResource) = 0;
+
+public:
+	// debug markers, ignored where there is no tool to see them
+	virtual void SetMarker(std::string_view name) = 0;
+	virtual void BeginEvent(std::string_view name) = 0;
+	virtual void EndEvent() = 0;
+};
\ No newline at end of file
@@ -11,14 +11,20 @@ void BufferHeapBase::Initialize(Graphics& graphics)
 	m_dynamicHeap.heap = graphics.GetGraphicsBufferAllocatorManager()->RequestBufferAllocator(graphics, 0, 1, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER, BufferType::Dynamic);
 }
 
-D3D12_GPU_VIRTUAL_ADDRESS BufferHeapBase::GetBufferAddress(TempBufferIndex bufferIndex)
+void BufferHeapBase::BeginFrame(Graphics& graphics)
 {
-	THROW_INTERNAL_ERROR_IF("Tried to access buffer outside of range", bufferIndex.GetIndex() > m_numberOfTempBuffers);
+	m_tempRing.FinishFrame(m_frameNumber);
+	m_frameNumber = graphics.GetFrameNumber();
 
-	D3D12_GPU_VIRTUAL_ADDRESS bufferAddress = m_dynamicHeap.heap->GetResource()->GetGPUAddress();
-	bufferAddress += m_dynamicHeap.buffers.at(bufferIndex.GetIndex())->byteOffset;
+	if (std::optional<size_t> lastRetiredFrame = graphics.GetLastRetiredFrame())
+		m_tempRing.Retire(*lastRetiredFrame);
 
-	return bufferAddress;
+	m_tempAllocations.clear();
+}
+
+D3D12_GPU_VIRTUAL_ADDRESS BufferHeapBase::GetBufferAddress(TempBufferIndex bufferIndex)
+{
+	return GetTempAllocation(bufferIndex).gpuAddress;
 }
 
 D3D12_GPU_VIRTUAL_ADDRESS BufferHeapBase::GetBufferAddress(Graphics& graphics, DynamicBufferIndex bufferIndex)
@@ -49,12 +55,16 @@ ID3D12Resource* BufferHeapBase::GetStaticResource() const
 
 ID3D12Resource* BufferHeapBase::GetTempResource() const
 {
-	return m_dynamicHeap.heap->GetResource()->GetResource();
+	return m_tempBuffer ? m_tempBuffer->GetResource() : nullptr;
 }
 
-void BufferHeapBase::UpdateResource(Graphics& graphics, TempBufferIndex bufferIndex, void* data, size_t size)
+void BufferHeapBase::UpdateResource(Graphics& graphics, TempBufferIndex bufferIndex, const void* data, size_t size)
 {
-	THROW_INTERNAL_ERROR("Temp buffers currently unsupported");
+	const TempAllocation& allocation = GetTempAllocation(bufferIndex);
+
+	THROW_INTERNAL_ERROR_IF("Tried to write more data than temp buffer can hold", size > allocation.size);
+
+	std::memcpy(allocation.cpuAddress, data, size);
 }
 
 void BufferHeapBase::UpdateResource(Graphics& graphics, DynamicBufferIndex bufferIndex, void* data, size_t size)
@@ -71,9 +81,23 @@ void BufferHeapBase::UpdateResource(Graphics& graphics, StaticBufferIndex buffer
 	m_staticHeap.heap->Write(graphics, chunk, data, size, 0);
 }
 
+void BufferHeapBase::UpdateResource(Graphics& graphics, DynamicBufferIndex bufferIndex, const void* data, std::span<const DataRange> ranges)
+{
+	BufferAllocatorChunk* chunk = m_dynamicHeap.buffers.at(bufferIndex.GetIndex()).get();
+
+	m_dynamicHeap.heap->Write(graphics, chunk, data, ranges, 0);
+}
+
+void BufferHeapBase::UpdateResource(Graphics& graphics, StaticBufferIndex bufferIndex, const void* data, std::span<const DataRange> ranges)
+{
+	BufferAllocatorChunk* chunk = m_staticHeap.buffers.at(bufferIndex.GetIndex()).get();
+
+	m_staticHeap.heap->Write(graphics, chunk, data, ranges, 0);
+}
+
 void BufferHeapBase::ResizeResource(Graphics& graphics, TempBufferIndex bufferIndex, size_t size)
 {
-	THROW_INTERNAL_ERROR("Temp buffers currently unsupported");
+	THROW_INTERNAL_ERROR("Temp buffers can't be resized, new temp buffer has to be requested instead");
 }
 
 void BufferHeapBase::ResizeResource(Graphics& graphics, DynamicBufferIndex bufferIndex, size_t size)
@@ -101,9 +125,7 @@ UINT64 BufferHeapBase::GetOffsetOfBuffer(Graphics& graphics, DynamicBufferIndex
 
 UINT64 BufferHeapBase::GetOffsetOfBuffer(TempBufferIndex bufferIndex)
 {
-	THROW_INTERNAL_ERROR("Temp buffers currently unsupported");
-
-	return 0;
+	return GetTempAllocation(bufferIndex).offset;
 }
 
 UINT64 BufferHeapBase::GetOffsetOfBuffer(StaticBufferIndex bufferIndex)
@@ -125,6 +147,51 @@ UINT64 BufferHeapBase::GetSizeOfBuffer(Graphics& graphics, StaticBufferIndex buf
 	return m_staticHeap.buffers.at(bufferIndex.GetIndex())->size;
 }
 
+TempBufferIndex BufferHeapBase::AllocateTemp(Graphics& graphics, size_t size, size_t alignment)
+{
+	std::optional<size_t> offset = m_tempRing.Allocate(size, alignment);
+
+	if (!offset)
+	{
+		GrowTempBuffer(graphics, size);
+
+		offset = m_tempRing.Allocate(size, alignment);
+
+		THROW_INTERNAL_ERROR_IF("Failed to allocate temp buffer after growing", !offset);
+	}
+
+	m_tempAllocations.push_back({ m_tempBuffer->GetGPUAddress() + offset.value(), m_tempBufferData + offset.value(), offset.value(), size });
+
+	return TempBufferIndex(unsigned int(m_tempAllocations.size() - 1), m_frameNumber);
+}
+
+const BufferHeapBase::TempAllocation& BufferHeapBase::GetTempAllocation(TempBufferIndex bufferIndex) const
+{
+	THROW_INTERNAL_ERROR_IF("Tried to access temp buffer from previous frame", bufferIndex.GetFrameNumber() != m_frameNumber);
+	THROW_INTERNAL_ERROR_IF("Tried to access temp buffer outside of current frame allocations", bufferIndex.GetIndex() >= m_tempAllocations.size());
+
+	return m_tempAllocations[bufferIndex.GetIndex()];
+}
+
+void BufferHeapBase::GrowTempBuffer(Graphics& graphics, size_t minSize)
+{
+	size_t newSize = std::max(m_tempRing.GetCapacity() * 2, initialTempBufferSize);
+
+	while (newSize < minSize)
+		newSize *= 2;
+
+	// previous buffer has to live as long as frames in flight can use allocations from it
+	if (m_tempBuffer)
+		graphics.GetFrameResourceDeleter()->DeleteResource(graphics, std::move(m_tempBuffer));
+
+	m_tempBuffer = std::make_unique<GraphicsBuffer>(graphics, unsigned int(newSize), 1, GraphicsResource::CPUAccess::write);
+
+	// upload heap memory can stay mapped for whole lifetime of resource
+	m_tempBufferData = static_cast<unsigned char*>(m_tempBuffer->Map(graphics));
+
+	m_tempRing.Reset(newSize);
+}
+
 UINT64 BufferHeapBase::GetBufferOffsetAtIndex(const HeapData& heapData, unsigned int bufferIndex)
 {
 	THROW_INTERNAL_ERROR_IF("Tried to access offset outside constant buffer heap", bufferIndex > heapData.buffers.size());
@@ -132,13 +199,9 @@ UINT64 BufferHeapBase::GetBufferOffsetAtIndex(const HeapData& heapData, unsigned
 	return heapData.buffers.at(bufferIndex)->byteOffset;
 }
 
-TempBufferIndex ConstantBufferHeap::GetNextTempIndex(UINT resourceSize)
+TempBufferIndex ConstantBufferHeap::GetNextTempIndex(Graphics& graphics, UINT resourceSize)
 {
-	THROW_INTERNAL_ERROR("Temp buffers currently unsupported");
-
-	m_numTempBuffersUsed++;
-
-	return TempBufferIndex(m_numTempBuffersUsed - 1);
+	return AllocateTemp(graphics, resourceSize, D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
 }
 
 StaticBufferIndex ConstantBufferHeap::RequestMoreStaticSpace(Graphics& graphics, UINT resourceSize)
@@ -167,8 +230,6 @@ UINT64 ConstantBufferHeap::GetAligned(UINT64 offset, UINT stride)
 void BufferHeap::Initialize(Graphics& graphics)
 {
 	BufferHeapBase::Initialize(graphics);
-
-	m_numberOfTempBuffers = 0; // we won't use temp buffers in regular buffer heap for now
 }
 
 StaticBufferIndex BufferHeap::RequestMoreStaticSpace(Graphics& graphics, UINT resourceSize, UINT stride)
@@ -185,6 +246,11 @@ DynamicBufferIndex BufferHeap::RequestMoreSpace(Graphics& graphics, UINT resourc
 	return DynamicBufferIndex(m_dynamicHeap.buffers.size() - 1);
 }
 
+TempBufferIndex BufferHeap::GetNextTempIndex(Graphics& graphics, UINT resourceSize)
+{
+	return AllocateTemp(graphics, resourceSize, D3D12_RAW_UAV_SRV_BYTE_ALIGNMENT);
+}
+
 UINT64 BufferHeap::GetOffsetOfBuffer(Graphics& graphics, unsigned int bufferIndex)
 {
 	return GetOffsetOfBuffer(graphics.GetCurrentBufferIndex(), bufferIndex);
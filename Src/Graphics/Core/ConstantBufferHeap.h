@@ -4,6 +4,7 @@
 #include "Includes/WRLNoWarnings.h"
 #include "Macros/ErrorMacros.h"
 #include "Graphics/Resources/GraphicsBufferSuballocator.h"
+#include "Graphics/Resources/FrameRingAllocator.h"
 
 class Graphics;
 class CommandList;
@@ -43,12 +44,50 @@ private:
 
 struct DynamicBufferTag {};
 struct StaticBufferTag {};
-struct TempBufferTag {};
 
 // Stronly typed index varibles for clean interface
 using DynamicBufferIndex = BufferIndex<DynamicBufferTag>;
 using StaticBufferIndex = BufferIndex<StaticBufferTag>;
-using TempBufferIndex = BufferIndex<TempBufferTag>;
+
+// temp allocations are valid only in the frame they were made in, so index remembers that frame
+class TempBufferIndex
+{
+	friend class BufferHeapBase;
+public:
+	explicit TempBufferIndex()
+		:
+		index(0),
+		frameNumber(0),
+		initialized(false)
+	{}
+private:
+	explicit TempBufferIndex(unsigned int index_, size_t frameNumber_)
+		:
+		index(index_),
+		frameNumber(frameNumber_),
+		initialized(true)
+	{}
+
+public:
+	unsigned int GetIndex() const
+	{
+		THROW_INTERNAL_ERROR_IF("Tried to use invalid buffer index", !initialized);
+
+		return index;
+	}
+
+	size_t GetFrameNumber() const
+	{
+		THROW_INTERNAL_ERROR_IF("Tried to use invalid buffer index", !initialized);
+
+		return frameNumber;
+	}
+
+private:
+	unsigned int index;
+	size_t frameNumber;
+	bool initialized;
+};
 
 class BufferHeapBase
 {
@@ -59,12 +98,23 @@ protected:
 		std::vector<std::shared_ptr<BufferAllocatorChunk>> buffers = {};
 	};
 
+	struct TempAllocation
+	{
+		D3D12_GPU_VIRTUAL_ADDRESS gpuAddress;
+		unsigned char* cpuAddress;
+		size_t offset;
+		size_t size;
+	};
+
 public:
 	virtual ~BufferHeapBase() = default;
 
 	void Initialize(Graphics& graphics);
 
 public:	// At runtime
+	// retires temp allocations of frames that GPU already finished and invalidates temp indices from previous frame
+	void BeginFrame(Graphics& graphics);
+
 	D3D12_GPU_VIRTUAL_ADDRESS GetBufferAddress(TempBufferIndex bufferIndex);
 	D3D12_GPU_VIRTUAL_ADDRESS GetBufferAddress(Graphics& graphics, DynamicBufferIndex bufferIndex);
 	D3D12_GPU_VIRTUAL_ADDRESS GetBufferAddress(StaticBufferIndex bufferIndex);
@@ -73,14 +123,26 @@ public:	// At runtime
 	ID3D12Resource* GetStaticResource() const;
 	ID3D12Resource* GetTempResource() const;
 
-	void UpdateResource(Graphics& graphics, TempBufferIndex bufferIndex, void* data, size_t size);
+	void UpdateResource(Graphics& graphics, TempBufferIndex bufferIndex, const void* data, size_t size);
 	void UpdateResource(Graphics& graphics, DynamicBufferIndex bufferIndex, void* data, size_t size);
 	void UpdateResource(Graphics& graphics, StaticBufferIndex bufferIndex, void* data, size_t size);
 
+	// partial updates, ranges have to be sorted
+	void UpdateResource(Graphics& graphics, DynamicBufferIndex bufferIndex, const void* data, std::span<const DataRange> ranges);
+	void UpdateResource(Graphics& graphics, StaticBufferIndex bufferIndex, const void* data, std::span<const DataRange> ranges);
+
 	void ResizeResource(Graphics& graphics, TempBufferIndex bufferIndex, size_t size);
 	void ResizeResource(Graphics& graphics, DynamicBufferIndex bufferIndex, size_t size);
 	void ResizeResource(Graphics& graphics, StaticBufferIndex bufferIndex, size_t size);
 
+protected:
+	TempBufferIndex AllocateTemp(Graphics& graphics, size_t size, size_t alignment);
+
+	// throws when index comes from other frame, its memory can already belong to other allocation
+	const TempAllocation& GetTempAllocation(TempBufferIndex bufferIndex) const;
+
+	void GrowTempBuffer(Graphics& graphics, size_t minSize);
+
 private:
 	UINT64 GetOffsetOfBuffer(Graphics& graphics, DynamicBufferIndex bufferIndex);
 	UINT64 GetOffsetOfBuffer(TempBufferIndex bufferIndex);
@@ -98,16 +160,20 @@ protected:
 	// non static resources - on shared memory; size multiplied by n frames-in-flight
 	HeapData m_dynamicHeap;
 
-	// temp resources
-	// each buffer is 256 bytes
-	UINT64 m_numberOfTempBuffers = 1024;
-	UINT64 m_numTempBuffersUsed = 0;
+	// temp resources - persistently mapped upload memory, valid only during frame they were allocated in
+	std::unique_ptr<GraphicsBuffer> m_tempBuffer;
+	unsigned char* m_tempBufferData = nullptr;
+	FrameRingAllocator m_tempRing;
+	std::vector<TempAllocation> m_tempAllocations;
+	size_t m_frameNumber = 0;
+
+	static constexpr size_t initialTempBufferSize = 256 * 1024;
 };
 
 class ConstantBufferHeap : public BufferHeapBase
 {
 public:  // At program initialization
-	TempBufferIndex GetNextTempIndex(UINT resourceSize);
+	TempBufferIndex GetNextTempIndex(Graphics& graphics, UINT resourceSize);
 	StaticBufferIndex RequestMoreStaticSpace(Graphics& graphics, UINT resourceSize);
 	DynamicBufferIndex RequestMoreSpace(Graphics& graphics, UINT resourceSize);
 
@@ -125,6 +191,9 @@ public:  // At program initialization
 	DynamicBufferIndex RequestMoreSpace(Graphics& graphics, UINT resourceSize, UINT stride);
 
 public: // At runtime
+	// temp memory of current frame, it can be read through root shader resource views
+	TempBufferIndex GetNextTempIndex(Graphics& graphics, UINT resourceSize);
+
 	// returns index offset of element in buffer
 	UINT64 GetOffsetOfBuffer(Graphics& graphics, unsigned int bufferIndex);
 	UINT64 GetOffsetOfBuffer(unsigned int frameIndex, unsigned int bufferIndex);
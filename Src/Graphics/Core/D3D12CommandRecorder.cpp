@@ -0,0 +1,249 @@
+#include "D3D12CommandRecorder.h"
+#include "Graphics.h"
+#include "Macros/ErrorMacros.h"
+
+#include "Pix.h"
+
+D3D12CommandRecorder::D3D12CommandRecorder(Graphics& graphics, ID3D12Device* pDevice, D3D12_COMMAND_LIST_TYPE type, unsigned int numAllocators, ID3D12PipelineState* pInitialState)
+	:
+	m_pCommandAllocators(numAllocators)
+{
+	HRESULT hr;
+
+	// initializing command allocators
+	{
+		for (unsigned int currAllocatorIndex = 0; currAllocatorIndex < m_pCommandAllocators.size(); currAllocatorIndex++)
+			THROW_ERROR(pDevice->CreateCommandAllocator(type, IID_PPV_ARGS(&m_pCommandAllocators.at(currAllocatorIndex))));
+	}
+
+	THROW_ERROR(pDevice->CreateCommandList(0, type, m_pCommandAllocators.front().Get(), pInitialState, IID_PPV_ARGS(&pCommandList)));
+
+	THROW_ERROR(pCommandList->Close());
+}
+
+void D3D12CommandRecorder::Reset(Graphics& graphics, unsigned int allocatorIndex, ID3D12PipelineState* pPipelineState)
+{
+	HRESULT hr;
+
+	// reset currently used command allocator
+	THROW_ERROR(m_pCommandAllocators.at(allocatorIndex)->Reset());
+
+	THROW_ERROR(pCommandList->Reset(m_pCommandAllocators.at(allocatorIndex).Get(), pPipelineState));
+}
+
+void D3D12CommandRecorder::Close(Graphics& graphics)
+{
+	HRESULT hr;
+
+	THROW_ERROR(pCommandList->Close());
+}
+
+ID3D12GraphicsCommandList* D3D12CommandRecorder::GetNative() const
+{
+	return pCommandList.Get();
+}
+
+void D3D12CommandRecorder::DrawIndexedInstanced(Graphics& graphics, unsigned int indices, unsigned int instances, unsigned int startIndexOffset, unsigned int baseVertexOffset)
+{
+	THROW_INFO_ERROR(pCommandList->DrawIndexedInstanced(indices, instances, startIndexOffset, baseVertexOffset, 0));
+}
+
+void D3D12CommandRecorder::Dispatch(Graphics& graphics, unsigned int workToProcessX, unsigned int workToProcessY, unsigned int workToProcessZ)
+{
+	THROW_INFO_ERROR(pCommandList->Dispatch(workToProcessX, workToProcessY, workToProcessZ));
+}
+
+void D3D12CommandRecorder::ExecuteBundle(Graphics& graphics, CommandRecorder* bundle)
+{
+	THROW_INFO_ERROR(pCommandList->ExecuteBundle(bundle->GetNative()));
+}
+
+void D3D12CommandRecorder::BeginRenderPass(Graphics& graphics, unsigned int numRenderTargets, const D3D12_RENDER_PASS_RENDER_TARGET_DESC* renderTargets, const D3D12_RENDER_PASS_DEPTH_STENCIL_DESC* depthStencil)
+{
+	THROW_INFO_ERROR(pCommandList->BeginRenderPass(numRenderTargets, renderTargets, depthStencil, D3D12_RENDER_PASS_FLAG_NONE));
+}
+
+void D3D12CommandRecorder::EndRenderPass(Graphics& graphics)
+{
+	THROW_INFO_ERROR(pCommandList->EndRenderPass());
+}
+
+void D3D12CommandRecorder::EndQuery(Graphics& graphics, ID3D12QueryHeap* pQueryHeap, D3D12_QUERY_TYPE queryType, unsigned int entryIndex)
+{
+	THROW_INFO_ERROR(pCommandList->EndQuery(pQueryHeap, queryType, entryIndex));
+}
+
+void D3D12CommandRecorder::ResolveQueryData(Graphics& graphics, ID3D12QueryHeap* pQueryHeap, D3D12_QUERY_TYPE queryType, unsigned int entryIndex, unsigned int numEntries, ID3D12Resource* pDestination, UINT64 destOffset)
+{
+	THROW_INFO_ERROR(pCommandList->ResolveQueryData(pQueryHeap, queryType, entryIndex, numEntries, pDestination, destOffset));
+}
+
+void D3D12CommandRecorder::ResourceBarrier(Graphics& graphics, unsigned int numBarriers, const D3D12_RESOURCE_BARRIER* barriers)
+{
+	THROW_INFO_ERROR(pCommandList->ResourceBarrier(numBarriers, barriers));
+}
+
+void D3D12CommandRecorder::SetRenderTarget(Graphics& graphics, const D3D12_CPU_DESCRIPTOR_HANDLE& renderTarget, const D3D12_CPU_DESCRIPTOR_HANDLE* depthStencil)
+{
+	THROW_INFO_ERROR(pCommandList->OMSetRenderTargets(1, &renderTarget, false, depthStencil));
+}
+
+void D3D12CommandRecorder::SetVertexBuffer(Graphics& graphics, const D3D12_VERTEX_BUFFER_VIEW* vertexBufferView)
+{
+	THROW_INFO_ERROR(pCommandList->IASetVertexBuffers(0, 1, vertexBufferView));
+}
+
+void D3D12CommandRecorder::SetIndexBuffer(Graphics& graphics, const D3D12_INDEX_BUFFER_VIEW* indexBufferView)
+{
+	THROW_INFO_ERROR(pCommandList->IASetIndexBuffer(indexBufferView));
+}
+
+void D3D12CommandRecorder::SetPrimitiveTopology(Graphics& graphics, D3D_PRIMITIVE_TOPOLOGY primitiveTopology)
+{
+	THROW_INFO_ERROR(pCommandList->IASetPrimitiveTopology(primitiveTopology));
+}
+
+void D3D12CommandRecorder::SetViewport(Graphics& graphics, const D3D12_VIEWPORT& viewport, const D3D12_RECT& scissorRect)
+{
+	THROW_INFO_ERROR(pCommandList->RSSetViewports(1, &viewport));
+	THROW_INFO_ERROR(pCommandList->RSSetScissorRects(1, &scissorRect));
+}
+
+void D3D12CommandRecorder::SetDescriptorHeap(Graphics& graphics, ID3D12DescriptorHeap* pDescriptorHeap)
+{
+	ID3D12DescriptorHeap* descriptorHeaps[] = { pDescriptorHeap };
+
+	THROW_INFO_ERROR(pCommandList->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps));
+}
+
+void D3D12CommandRecorder::SetPipelineState(Graphics& graphics, ID3D12PipelineState* pPipelineState)
+{
+	THROW_INFO_ERROR(pCommandList->SetPipelineState(pPipelineState));
+}
+
+void D3D12CommandRecorder::SetRootSignature(Graphics& graphics, BindPoint bindPoint, ID3D12RootSignature* pRootSignature)
+{
+	if (bindPoint == BindPoint::graphics)
+	{
+		THROW_INFO_ERROR(pCommandList->SetGraphicsRootSignature(pRootSignature));
+	}
+	else
+	{
+		THROW_INFO_ERROR(pCommandList->SetComputeRootSignature(pRootSignature));
+	}
+}
+
+void D3D12CommandRecorder::SetRootConstantBufferView(Graphics& graphics, BindPoint bindPoint, unsigned int rootIndex, D3D12_GPU_VIRTUAL_ADDRESS address)
+{
+	if (bindPoint == BindPoint::graphics)
+	{
+		THROW_INFO_ERROR(pCommandList->SetGraphicsRootConstantBufferView(rootIndex, address));
+	}
+	else
+	{
+		THROW_INFO_ERROR(pCommandList->SetComputeRootConstantBufferView(rootIndex, address));
+	}
+}
+
+void D3D12CommandRecorder::SetRootShaderResourceView(Graphics& graphics, BindPoint bindPoint, unsigned int rootIndex, D3D12_GPU_VIRTUAL_ADDRESS address)
+{
+	if (bindPoint == BindPoint::graphics)
+	{
+		THROW_INFO_ERROR(pCommandList->SetGraphicsRootShaderResourceView(rootIndex, address));
+	}
+	else
+	{
+		THROW_INFO_ERROR(pCommandList->SetComputeRootShaderResourceView(rootIndex, address));
+	}
+}
+
+void D3D12CommandRecorder::SetRootUnorderedAccessView(Graphics& graphics, BindPoint bindPoint, unsigned int rootIndex, D3D12_GPU_VIRTUAL_ADDRESS address)
+{
+	if (bindPoint == BindPoint::graphics)
+	{
+		THROW_INFO_ERROR(pCommandList->SetGraphicsRootUnorderedAccessView(rootIndex, address));
+	}
+	else
+	{
+		THROW_INFO_ERROR(pCommandList->SetComputeRootUnorderedAccessView(rootIndex, address));
+	}
+}
+
+void D3D12CommandRecorder::SetRootDescriptorTable(Graphics& graphics, BindPoint bindPoint, unsigned int rootIndex, D3D12_GPU_DESCRIPTOR_HANDLE descriptor)
+{
+	if (bindPoint == BindPoint::graphics)
+	{
+		THROW_INFO_ERROR(pCommandList->SetGraphicsRootDescriptorTable(rootIndex, descriptor));
+	}
+	else
+	{
+		THROW_INFO_ERROR(pCommandList->SetComputeRootDescriptorTable(rootIndex, descriptor));
+	}
+}
+
+void D3D12CommandRecorder::SetRoot32BitConstants(Graphics& graphics, BindPoint bindPoint, unsigned int rootIndex, unsigned int numValues, const void* data)
+{
+	if (bindPoint == BindPoint::graphics)
+	{
+		THROW_INFO_ERROR(pCommandList->SetGraphicsRoot32BitConstants(rootIndex, numValues, data, 0));
+	}
+	else
+	{
+		THROW_INFO_ERROR(pCommandList->SetComputeRoot32BitConstants(rootIndex, numValues, data, 0));
+	}
+}
+
+void D3D12CommandRecorder::ClearRenderTargetView(Graphics& graphics, D3D12_CPU_DESCRIPTOR_HANDLE renderTarget, const float clearColor[4])
+{
+	THROW_INFO_ERROR(pCommandList->ClearRenderTargetView(renderTarget, clearColor, 0, nullptr));
+}
+
+void D3D12CommandRecorder::ClearDepthStencilView(Graphics& graphics, D3D12_CPU_DESCRIPTOR_HANDLE depthStencil, float depth, UINT8 stencil, unsigned int numRects, const D3D12_RECT* rects)
+{
+	THROW_INFO_ERROR(pCommandList->ClearDepthStencilView(
+		depthStencil,
+		D3D12_CLEAR_FLAG_DEPTH | D3D12_CLEAR_FLAG_STENCIL,
+		depth,
+		stencil,
+		numRects,
+		rects
+	));
+}
+
+void D3D12CommandRecorder::CopyBufferRegion(Graphics& graphics, ID3D12Resource* dstResource, UINT64 dstOffset, ID3D12Resource* srcResource, UINT64 srcOffset, UINT64 numBytes)
+{
+	THROW_INFO_ERROR(pCommandList->CopyBufferRegion(dstResource, dstOffset, srcResource, srcOffset, numBytes));
+}
+
+void D3D12CommandRecorder::CopyTextureRegion(Graphics& graphics, const D3D12_TEXTURE_COPY_LOCATION& destination, const D3D12_TEXTURE_COPY_LOCATION& source)
+{
+	THROW_INFO_ERROR(pCommandList->CopyTextureRegion(&destination, 0, 0, 0, &source, nullptr));
+}
+
+void D3D12CommandRecorder::CopyResource(Graphics& graphics, ID3D12Resource* dstResource, ID3D12Resource* srcResource)
+{
+	THROW_INFO_ERROR(pCommandList->CopyResource(dstResource, srcResource));
+}
+
+void D3D12CommandRecorder::SetMarker(std::string_view name)
+{
+#ifdef _DEBUG
+	static UINT markerColor = PIX_COLOR(0, 255, 255);
+
+	SET_GPU_MARKER(pCommandList.Get(), markerColor, name.data());
+#endif
+}
+
+void D3D12CommandRecorder::BeginEvent(std::string_view name)
+{
+#ifdef _DEBUG
+	static UINT eventColor = PIX_COLOR(255, 0, 255);
+
+	START_GPU_EVENT(pCommandList.Get(), eventColor, name.data());
+#endif
+}
+
+void D3D12CommandRecorder::EndEvent()
+{
+	END_GPU_EVENT(pCommandList.Get());
+}
\ No newline at end of file
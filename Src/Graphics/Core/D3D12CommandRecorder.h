@@ -0,0 +1,59 @@
+#pragma once
+#include "CommandRecorder.h"
+#include "Includes/WRLNoWarnings.h"
+
+class D3D12CommandRecorder : public CommandRecorder
+{
+public:
+	// command list is created closed, one allocator is kept for every frame in flight
+	D3D12CommandRecorder(Graphics& graphics, ID3D12Device* pDevice, D3D12_COMMAND_LIST_TYPE type, unsigned int numAllocators, ID3D12PipelineState* pInitialState);
+
+public:
+	void Reset(Graphics& graphics, unsigned int allocatorIndex, ID3D12PipelineState* pPipelineState) override;
+	void Close(Graphics& graphics) override;
+
+	ID3D12GraphicsCommandList* GetNative() const override;
+
+public:
+	void DrawIndexedInstanced(Graphics& graphics, unsigned int indices, unsigned int instances, unsigned int startIndexOffset, unsigned int baseVertexOffset) override;
+	void Dispatch(Graphics& graphics, unsigned int workToProcessX, unsigned int workToProcessY, unsigned int workToProcessZ) override;
+	void ExecuteBundle(Graphics& graphics, CommandRecorder* bundle) override;
+
+	void BeginRenderPass(Graphics& graphics, unsigned int numRenderTargets, const D3D12_RENDER_PASS_RENDER_TARGET_DESC* renderTargets, const D3D12_RENDER_PASS_DEPTH_STENCIL_DESC* depthStencil) override;
+	void EndRenderPass(Graphics& graphics) override;
+
+	void EndQuery(Graphics& graphics, ID3D12QueryHeap* pQueryHeap, D3D12_QUERY_TYPE queryType, unsigned int entryIndex) override;
+	void ResolveQueryData(Graphics& graphics, ID3D12QueryHeap* pQueryHeap, D3D12_QUERY_TYPE queryType, unsigned int entryIndex, unsigned int numEntries, ID3D12Resource* pDestination, UINT64 destOffset) override;
+
+	void ResourceBarrier(Graphics& graphics, unsigned int numBarriers, const D3D12_RESOURCE_BARRIER* barriers) override;
+
+	void SetRenderTarget(Graphics& graphics, const D3D12_CPU_DESCRIPTOR_HANDLE& renderTarget, const D3D12_CPU_DESCRIPTOR_HANDLE* depthStencil) override;
+	void SetVertexBuffer(Graphics& graphics, const D3D12_VERTEX_BUFFER_VIEW* vertexBufferView) override;
+	void SetIndexBuffer(Graphics& graphics, const D3D12_INDEX_BUFFER_VIEW* indexBufferView) override;
+	void SetPrimitiveTopology(Graphics& graphics, D3D_PRIMITIVE_TOPOLOGY primitiveTopology) override;
+	void SetViewport(Graphics& graphics, const D3D12_VIEWPORT& viewport, const D3D12_RECT& scissorRect) override;
+	void SetDescriptorHeap(Graphics& graphics, ID3D12DescriptorHeap* pDescriptorHeap) override;
+	void SetPipelineState(Graphics& graphics, ID3D12PipelineState* pPipelineState) override;
+
+	void SetRootSignature(Graphics& graphics, BindPoint bindPoint, ID3D12RootSignature* pRootSignature) override;
+	void SetRootConstantBufferView(Graphics& graphics, BindPoint bindPoint, unsigned int rootIndex, D3D12_GPU_VIRTUAL_ADDRESS address) override;
+	void SetRootShaderResourceView(Graphics& graphics, BindPoint bindPoint, unsigned int rootIndex, D3D12_GPU_VIRTUAL_ADDRESS address) override;
+	void SetRootUnorderedAccessView(Graphics& graphics, BindPoint bindPoint, unsigned int rootIndex, D3D12_GPU_VIRTUAL_ADDRESS address) override;
+	void SetRootDescriptorTable(Graphics& graphics, BindPoint bindPoint, unsigned int rootIndex, D3D12_GPU_DESCRIPTOR_HANDLE descriptor) override;
+	void SetRoot32BitConstants(Graphics& graphics, BindPoint bindPoint, unsigned int rootIndex, unsigned int numValues, const void* data) override;
+
+	void ClearRenderTargetView(Graphics& graphics, D3D12_CPU_DESCRIPTOR_HANDLE renderTarget, const float clearColor[4]) override;
+	void ClearDepthStencilView(Graphics& graphics, D3D12_CPU_DESCRIPTOR_HANDLE depthStencil, float depth, UINT8 stencil, unsigned int numRects, const D3D12_RECT* rects) override;
+
+	void CopyBufferRegion(Graphics& graphics, ID3D12Resource* dstResource, UINT64 dstOffset, ID3D12Resource* srcResource, UINT64 srcOffset, UINT64 numBytes) override;
+	void CopyTextureRegion(Graphics& graphics, const D3D12_TEXTURE_COPY_LOCATION& destination, const D3D12_TEXTURE_COPY_LOCATION& source) override;
+	void CopyResource(Graphics& graphics, ID3D12Resource* dstResource, ID3D12Resource* srcResource) override;
+
+	void SetMarker(std::string_view name) override;
+	void BeginEvent(std::string_view name) override;
+	void EndEvent() override;
+
+private:
+	std::vector<Microsoft::WRL::ComPtr<ID3D12CommandAllocator>> m_pCommandAllocators;
+	Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList7> pCommandList;
+};
\ No newline at end of file
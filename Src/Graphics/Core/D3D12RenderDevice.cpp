@@ -0,0 +1,459 @@
+#include "D3D12RenderDevice.h"
+#include "Macros/ErrorMacros.h"
+
+#include "Graphics.h"
+#include "D3D12CommandRecorder.h"
+
+namespace
+{
+	class D3D12DeviceResource : public DeviceResource
+	{
+	public:
+		D3D12DeviceResource(Microsoft::WRL::ComPtr<ID3D12Resource> pResource)
+			:
+			m_pResource(std::move(pResource))
+		{
+
+		}
+
+	public:
+		ID3D12Resource* GetNative() const override
+		{
+			return m_pResource.Get();
+		}
+
+		D3D12_RESOURCE_DESC GetDesc() const override
+		{
+			return m_pResource->GetDesc();
+		}
+
+		D3D12_GPU_VIRTUAL_ADDRESS GetGPUAddress() const override
+		{
+			return m_pResource->GetGPUVirtualAddress();
+		}
+
+		void* Map(Graphics& graphics, const D3D12_RANGE* readRange) override
+		{
+			HRESULT hr;
+			void* pMappedData = nullptr;
+
+			THROW_ERROR(m_pResource->Map(0, readRange, &pMappedData));
+
+			return pMappedData;
+		}
+
+		void Unmap(const D3D12_RANGE* writtenRange) override
+		{
+			m_pResource->Unmap(0, writtenRange);
+		}
+
+		void WriteToSubresource(Graphics& graphics, const void* data, unsigned int rowPitch, unsigned int numRows) override
+		{
+			HRESULT hr;
+
+			THROW_ERROR(m_pResource->WriteToSubresource(
+				0,
+				nullptr,
+				data,
+				rowPitch,
+				0
+			));
+		}
+
+	private:
+		Microsoft::WRL::ComPtr<ID3D12Resource> m_pResource;
+	};
+
+	class D3D12DeviceFence : public DeviceFence
+	{
+	public:
+		D3D12DeviceFence(Graphics& graphics, ID3D12Device* pDevice, ID3D12CommandQueue* pCommandQueue)
+			:
+			m_pCommandQueue(pCommandQueue)
+		{
+			HRESULT hr;
+
+			THROW_ERROR(pDevice->CreateFence(
+				0,
+				D3D12_FENCE_FLAG_NONE,
+				IID_PPV_ARGS(&pFence)
+			));
+
+			m_fenceEvent = CreateEventA(nullptr, false, false, nullptr);
+
+			if (m_fenceEvent == NULL)
+				THROW_LAST_ERROR;
+		}
+
+		~D3D12DeviceFence()
+		{
+			CloseHandle(m_fenceEvent);
+		}
+
+		D3D12DeviceFence(const D3D12DeviceFence&) = delete;
+
+	public:
+		ID3D12Fence* GetNative() const override
+		{
+			return pFence.Get();
+		}
+
+		void Signal(Graphics& graphics, size_t value) override
+		{
+			HRESULT hr;
+
+			THROW_ERROR(m_pCommandQueue->Signal(pFence.Get(), value));
+		}
+
+		void WaitForValue(Graphics& graphics, size_t value) override
+		{
+			if (pFence->GetCompletedValue() >= value)
+				return;
+
+			HRESULT hr;
+
+			THROW_ERROR(pFence->SetEventOnCompletion(value, m_fenceEvent));
+			WaitForSingleObject(m_fenceEvent, INFINITE);
+		}
+
+	private:
+		Microsoft::WRL::ComPtr<ID3D12Fence> pFence;
+		ID3D12CommandQueue* m_pCommandQueue;
+		HANDLE m_fenceEvent = NULL;
+	};
+}
+
+D3D12RenderDevice::D3D12RenderDevice()
+{
+	HRESULT hr;
+
+#ifdef _DEBUG
+	// Enabling debug layer
+	{
+		THROW_ERROR_NO_MSGS(D3D12GetDebugInterface(IID_PPV_ARGS(&pDebugController)));
+
+		pDebugController->EnableDebugLayer();
+	}
+#endif
+
+	// Creating dxgi factory
+	{
+		UINT dxgiFactoryFlags = 0;
+
+#ifdef _DEBUG
+		dxgiFactoryFlags |= DXGI_CREATE_FACTORY_DEBUG;
+#endif
+
+		THROW_ERROR_NO_MSGS(CreateDXGIFactory2(dxgiFactoryFlags, IID_PPV_ARGS(&pFactory)));
+	}
+
+	// Checking tearing support, needed to present without vsync on variable refresh rate displays
+	{
+		Microsoft::WRL::ComPtr<IDXGIFactory5> pFactory5;
+		BOOL allowTearing = FALSE;
+
+		if (SUCCEEDED(pFactory.As(&pFactory5)) && SUCCEEDED(pFactory5->CheckFeatureSupport(DXGI_FEATURE_PRESENT_ALLOW_TEARING, &allowTearing, sizeof(allowTearing))))
+			m_tearingSupported = allowTearing == TRUE;
+	}
+
+	// Creating device
+	{
+		THROW_ERROR_NO_MSGS(D3D12CreateDevice(NULL, D3D_FEATURE_LEVEL_12_0, IID_PPV_ARGS(&pDevice)));
+	}
+}
+
+void D3D12RenderDevice::InitializeSwapChain(Graphics& graphics, HWND hWnd, DXGI_FORMAT format, unsigned int bufferCount)
+{
+	HRESULT hr;
+
+	// Creating command queue
+	{
+		D3D12_COMMAND_QUEUE_DESC commandQueueDesc = {};
+		commandQueueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+		commandQueueDesc.Priority = D3D12_COMMAND_QUEUE_PRIORITY_NORMAL;
+		commandQueueDesc.Type = D3D12_COMMAND_LIST_TYPE_DIRECT;
+		commandQueueDesc.NodeMask = 0;
+
+		THROW_ERROR(pDevice->CreateCommandQueue(&commandQueueDesc, IID_PPV_ARGS(&pCommandQueue)));
+	}
+
+	// Creating swap chain
+	{
+		DXGI_SWAP_CHAIN_DESC swapChainDesc = {};
+		swapChainDesc.BufferDesc.Width = 0;
+		swapChainDesc.BufferDesc.Height = 0;
+		swapChainDesc.BufferDesc.Format = format;
+		swapChainDesc.BufferDesc.RefreshRate.Numerator = 1;
+		swapChainDesc.BufferDesc.RefreshRate.Denominator = 144;
+		swapChainDesc.BufferDesc.Scaling = DXGI_MODE_SCALING_UNSPECIFIED;
+		swapChainDesc.BufferDesc.ScanlineOrdering = DXGI_MODE_SCANLINE_ORDER_UNSPECIFIED;
+		swapChainDesc.SampleDesc.Count = 1;
+		swapChainDesc.SampleDesc.Quality = 0;
+		swapChainDesc.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
+		swapChainDesc.BufferCount = bufferCount;
+		swapChainDesc.OutputWindow = hWnd;
+		swapChainDesc.Windowed = TRUE;
+		swapChainDesc.SwapEffect = DXGI_SWAP_EFFECT_FLIP_DISCARD;
+		swapChainDesc.Flags = m_tearingSupported ? DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING : 0;
+
+		Microsoft::WRL::ComPtr<IDXGISwapChain> pCreatedSwapChain;
+
+		THROW_ERROR(pFactory->CreateSwapChain(pCommandQueue.Get(), &swapChainDesc, &pCreatedSwapChain));
+		THROW_ERROR(pCreatedSwapChain.As(&pSwapChain));
+	}
+}
+
+std::unique_ptr<DeviceResource> D3D12RenderDevice::CreateCommittedResource(Graphics& graphics, const D3D12_HEAP_PROPERTIES& heapProperties, const D3D12_RESOURCE_DESC& resourceDesc, const D3D12_CLEAR_VALUE* clearValue, bool cpuAccess)
+{
+	HRESULT hr;
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> pResource;
+
+	THROW_ERROR(pDevice->CreateCommittedResource(
+		&heapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&resourceDesc,
+		D3D12_RESOURCE_STATE_COMMON,
+		clearValue,
+		IID_PPV_ARGS(&pResource)
+	));
+
+	return std::make_unique<D3D12DeviceResource>(std::move(pResource));
+}
+
+std::unique_ptr<DeviceResource> D3D12RenderDevice::CreatePlacedResource(Graphics& graphics, ID3D12Heap* pHeap, size_t heapOffset, const D3D12_RESOURCE_DESC& resourceDesc, const D3D12_CLEAR_VALUE* clearValue)
+{
+	THROW_INTERNAL_ERROR_IF("Heap for placed resource was NULL", pHeap == nullptr);
+
+	HRESULT hr;
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> pResource;
+
+	THROW_ERROR(pDevice->CreatePlacedResource(
+		pHeap,
+		UINT64(heapOffset),
+		&resourceDesc,
+		D3D12_RESOURCE_STATE_COMMON,
+		clearValue,
+		IID_PPV_ARGS(&pResource)
+	));
+
+	return std::make_unique<D3D12DeviceResource>(std::move(pResource));
+}
+
+Microsoft::WRL::ComPtr<ID3D12Heap> D3D12RenderDevice::CreateHeap(Graphics& graphics, const D3D12_HEAP_DESC& heapDesc)
+{
+	HRESULT hr;
+
+	Microsoft::WRL::ComPtr<ID3D12Heap> pHeap;
+
+	THROW_ERROR(pDevice->CreateHeap(&heapDesc, IID_PPV_ARGS(&pHeap)));
+
+	return pHeap;
+}
+
+ResourceFootprint D3D12RenderDevice::GetCopyableFootprint(Graphics& graphics, const D3D12_RESOURCE_DESC& resourceDesc, unsigned int subresource)
+{
+	ResourceFootprint footprint = {};
+
+	THROW_INFO_ERROR(pDevice->GetCopyableFootprints(
+		&resourceDesc,
+		subresource,
+		1,
+		0,
+		&footprint.layout,
+		&footprint.numRows,
+		&footprint.rowSizeInBytes,
+		&footprint.totalBytes
+	));
+
+	return footprint;
+}
+
+D3D12_RESOURCE_ALLOCATION_INFO D3D12RenderDevice::GetResourceAllocationInfo(const D3D12_RESOURCE_DESC& resourceDesc)
+{
+	return pDevice->GetResourceAllocationInfo(0, 1, &resourceDesc);
+}
+
+unsigned int D3D12RenderDevice::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE type)
+{
+	return pDevice->GetDescriptorHandleIncrementSize(type);
+}
+
+RenderDevice::DescriptorHeapAllocation D3D12RenderDevice::CreateDescriptorHeap(Graphics& graphics, const D3D12_DESCRIPTOR_HEAP_DESC& descriptorHeapDesc)
+{
+	HRESULT hr;
+
+	DescriptorHeapAllocation allocation = {};
+
+	THROW_ERROR(pDevice->CreateDescriptorHeap(&descriptorHeapDesc, IID_PPV_ARGS(&allocation.pDescriptorHeap)));
+
+	allocation.cpuStart = allocation.pDescriptorHeap->GetCPUDescriptorHandleForHeapStart();
+
+	if (descriptorHeapDesc.Flags & D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE)
+		allocation.gpuStart = allocation.pDescriptorHeap->GetGPUDescriptorHandleForHeapStart();
+
+	return allocation;
+}
+
+void D3D12RenderDevice::CopyDescriptorsSimple(Graphics& graphics, unsigned int numDescriptors, D3D12_CPU_DESCRIPTOR_HANDLE destination, D3D12_CPU_DESCRIPTOR_HANDLE source, D3D12_DESCRIPTOR_HEAP_TYPE type)
+{
+	THROW_INFO_ERROR(pDevice->CopyDescriptorsSimple(numDescriptors, destination, source, type));
+}
+
+void D3D12RenderDevice::CreateShaderResourceView(Graphics& graphics, ID3D12Resource* pResource, const D3D12_SHADER_RESOURCE_VIEW_DESC& viewDesc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor)
+{
+	THROW_INFO_ERROR(pDevice->CreateShaderResourceView(pResource, &viewDesc, descriptor));
+}
+
+void D3D12RenderDevice::CreateUnorderedAccessView(Graphics& graphics, ID3D12Resource* pResource, const D3D12_UNORDERED_ACCESS_VIEW_DESC& viewDesc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor)
+{
+	THROW_INFO_ERROR(pDevice->CreateUnorderedAccessView(pResource, nullptr, &viewDesc, descriptor));
+}
+
+void D3D12RenderDevice::CreateRenderTargetView(Graphics& graphics, ID3D12Resource* pResource, const D3D12_RENDER_TARGET_VIEW_DESC& viewDesc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor)
+{
+	THROW_INFO_ERROR(pDevice->CreateRenderTargetView(pResource, &viewDesc, descriptor));
+}
+
+void D3D12RenderDevice::CreateDepthStencilView(Graphics& graphics, ID3D12Resource* pResource, const D3D12_DEPTH_STENCIL_VIEW_DESC& viewDesc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor)
+{
+	THROW_INFO_ERROR(pDevice->CreateDepthStencilView(pResource, &viewDesc, descriptor));
+}
+
+Microsoft::WRL::ComPtr<ID3D12RootSignature> D3D12RenderDevice::CreateRootSignature(Graphics& graphics, ID3DBlob* pRootSignatureBlob)
+{
+	HRESULT hr;
+
+	Microsoft::WRL::ComPtr<ID3D12RootSignature> pRootSignature;
+
+	THROW_ERROR(pDevice->CreateRootSignature(
+		0,
+		pRootSignatureBlob->GetBufferPointer(),
+		pRootSignatureBlob->GetBufferSize(),
+		IID_PPV_ARGS(&pRootSignature)
+	));
+
+	return pRootSignature;
+}
+
+Microsoft::WRL::ComPtr<ID3D12PipelineState> D3D12RenderDevice::CreateGraphicsPipelineState(Graphics& graphics, const D3D12_GRAPHICS_PIPELINE_STATE_DESC* pipelineStateDesc)
+{
+	HRESULT hr;
+
+	Microsoft::WRL::ComPtr<ID3D12PipelineState> pPipelineState;
+
+	THROW_ERROR(pDevice->CreateGraphicsPipelineState(pipelineStateDesc, IID_PPV_ARGS(&pPipelineState)));
+
+	return pPipelineState;
+}
+
+Microsoft::WRL::ComPtr<ID3D12PipelineState> D3D12RenderDevice::CreateComputePipelineState(Graphics& graphics, const D3D12_COMPUTE_PIPELINE_STATE_DESC* pipelineStateDesc)
+{
+	HRESULT hr;
+
+	Microsoft::WRL::ComPtr<ID3D12PipelineState> pPipelineState;
+
+	THROW_ERROR(pDevice->CreateComputePipelineState(pipelineStateDesc, IID_PPV_ARGS(&pPipelineState)));
+
+	return pPipelineState;
+}
+
+Microsoft::WRL::ComPtr<ID3D12QueryHeap> D3D12RenderDevice::CreateQueryHeap(Graphics& graphics, const D3D12_QUERY_HEAP_DESC& queryHeapDesc)
+{
+	HRESULT hr;
+
+	Microsoft::WRL::ComPtr<ID3D12QueryHeap> pQueryHeap;
+
+	THROW_ERROR(pDevice->CreateQueryHeap(&queryHeapDesc, IID_PPV_ARGS(&pQueryHeap)));
+
+	return pQueryHeap;
+}
+
+std::unique_ptr<CommandRecorder> D3D12RenderDevice::CreateCommandRecorder(Graphics& graphics, D3D12_COMMAND_LIST_TYPE type, unsigned int numAllocators, ID3D12PipelineState* pInitialState)
+{
+	return std::make_unique<D3D12CommandRecorder>(graphics, pDevice.Get(), type, numAllocators, pInitialState);
+}
+
+void D3D12RenderDevice::ExecuteCommandLists(Graphics& graphics, std::span<CommandRecorder* const> commandRecorders)
+{
+	std::vector<ID3D12CommandList*> pCommandLists;
+	pCommandLists.reserve(commandRecorders.size());
+
+	for (CommandRecorder* commandRecorder : commandRecorders)
+		pCommandLists.push_back(commandRecorder->GetNative());
+
+	THROW_INFO_ERROR(pCommandQueue->ExecuteCommandLists(unsigned int(pCommandLists.size()), pCommandLists.data()));
+}
+
+std::unique_ptr<DeviceFence> D3D12RenderDevice::CreateFence(Graphics& graphics)
+{
+	return std::make_unique<D3D12DeviceFence>(graphics, pDevice.Get(), pCommandQueue.Get());
+}
+
+void D3D12RenderDevice::QueueWait(Graphics& graphics, DeviceFence* fence, size_t value)
+{
+	THROW_INFO_ERROR(pCommandQueue->Wait(fence->GetNative(), value));
+}
+
+bool D3D12RenderDevice::IsRemoved()
+{
+	// if GetDeviceRemovedReason() returns S_OK, then device was not removed
+	return pDevice->GetDeviceRemovedReason() != S_OK;
+}
+
+std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> D3D12RenderDevice::GetSwapChainBuffers(Graphics& graphics, unsigned int bufferCount)
+{
+	HRESULT hr;
+
+	std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> bufferList(bufferCount);
+
+	for (unsigned int bufferIndex = 0; bufferIndex < bufferCount; bufferIndex++)
+		THROW_ERROR(pSwapChain->GetBuffer(bufferIndex, IID_PPV_ARGS(&bufferList.at(bufferIndex))));
+
+	return bufferList;
+}
+
+void D3D12RenderDevice::Present(Graphics& graphics, unsigned int syncInterval, unsigned int flags)
+{
+	HRESULT hr;
+
+	THROW_ERROR(pSwapChain->Present(syncInterval, flags));
+}
+
+bool D3D12RenderDevice::SupportsTearing()
+{
+	return m_tearingSupported;
+}
+
+unsigned int D3D12RenderDevice::GetCurrentBackBufferIndex(unsigned int bufferCount)
+{
+	return pSwapChain->GetCurrentBackBufferIndex();
+}
+
+UINT64 D3D12RenderDevice::GetTimestampFrequency()
+{
+	UINT64 gpuTimestampFrequency = 0;
+	pCommandQueue->GetTimestampFrequency(&gpuTimestampFrequency);
+
+	return gpuTimestampFrequency;
+}
+
+bool D3D12RenderDevice::GetClockCalibration(Graphics& graphics, UINT64& gpuTimestamp, UINT64& cpuTimestamp)
+{
+	HRESULT hr;
+
+	THROW_ERROR(pCommandQueue->GetClockCalibration(&gpuTimestamp, &cpuTimestamp));
+
+	return true;
+}
+
+ID3D12Device* D3D12RenderDevice::GetNativeDevice()
+{
+	return pDevice.Get();
+}
+
+ID3D12CommandQueue* D3D12RenderDevice::GetNativeCommandQueue()
+{
+	return pCommandQueue.Get();
+}
\ No newline at end of file
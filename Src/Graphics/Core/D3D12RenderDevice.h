@@ -0,0 +1,61 @@
+#pragma once
+#include "RenderDevice.h"
+
+// render device talking to GPU through D3D12 and presenting through DXGI swap chain
+class D3D12RenderDevice : public RenderDevice
+{
+public:
+	// creates factory and device, swap chain needs graphics for error reporting so it's created separately
+	D3D12RenderDevice();
+
+	void InitializeSwapChain(Graphics& graphics, HWND hWnd, DXGI_FORMAT format, unsigned int bufferCount);
+
+public:
+	std::unique_ptr<DeviceResource> CreateCommittedResource(Graphics& graphics, const D3D12_HEAP_PROPERTIES& heapProperties, const D3D12_RESOURCE_DESC& resourceDesc, const D3D12_CLEAR_VALUE* clearValue, bool cpuAccess) override;
+	std::unique_ptr<DeviceResource> CreatePlacedResource(Graphics& graphics, ID3D12Heap* pHeap, size_t heapOffset, const D3D12_RESOURCE_DESC& resourceDesc, const D3D12_CLEAR_VALUE* clearValue) override;
+	Microsoft::WRL::ComPtr<ID3D12Heap> CreateHeap(Graphics& graphics, const D3D12_HEAP_DESC& heapDesc) override;
+
+	ResourceFootprint GetCopyableFootprint(Graphics& graphics, const D3D12_RESOURCE_DESC& resourceDesc, unsigned int subresource) override;
+	D3D12_RESOURCE_ALLOCATION_INFO GetResourceAllocationInfo(const D3D12_RESOURCE_DESC& resourceDesc) override;
+
+	unsigned int GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE type) override;
+	DescriptorHeapAllocation CreateDescriptorHeap(Graphics& graphics, const D3D12_DESCRIPTOR_HEAP_DESC& descriptorHeapDesc) override;
+	void CopyDescriptorsSimple(Graphics& graphics, unsigned int numDescriptors, D3D12_CPU_DESCRIPTOR_HANDLE destination, D3D12_CPU_DESCRIPTOR_HANDLE source, D3D12_DESCRIPTOR_HEAP_TYPE type) override;
+
+	void CreateShaderResourceView(Graphics& graphics, ID3D12Resource* pResource, const D3D12_SHADER_RESOURCE_VIEW_DESC& viewDesc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor) override;
+	void CreateUnorderedAccessView(Graphics& graphics, ID3D12Resource* pResource, const D3D12_UNORDERED_ACCESS_VIEW_DESC& viewDesc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor) override;
+	void CreateRenderTargetView(Graphics& graphics, ID3D12Resource* pResource, const D3D12_RENDER_TARGET_VIEW_DESC& viewDesc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor) override;
+	void CreateDepthStencilView(Graphics& graphics, ID3D12Resource* pResource, const D3D12_DEPTH_STENCIL_VIEW_DESC& viewDesc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor) override;
+
+	Microsoft::WRL::ComPtr<ID3D12RootSignature> CreateRootSignature(Graphics& graphics, ID3DBlob* pRootSignatureBlob) override;
+	Microsoft::WRL::ComPtr<ID3D12PipelineState> CreateGraphicsPipelineState(Graphics& graphics, const D3D12_GRAPHICS_PIPELINE_STATE_DESC* pipelineStateDesc) override;
+	Microsoft::WRL::ComPtr<ID3D12PipelineState> CreateComputePipelineState(Graphics& graphics, const D3D12_COMPUTE_PIPELINE_STATE_DESC* pipelineStateDesc) override;
+	Microsoft::WRL::ComPtr<ID3D12QueryHeap> CreateQueryHeap(Graphics& graphics, const D3D12_QUERY_HEAP_DESC& queryHeapDesc) override;
+
+	std::unique_ptr<CommandRecorder> CreateCommandRecorder(Graphics& graphics, D3D12_COMMAND_LIST_TYPE type, unsigned int numAllocators, ID3D12PipelineState* pInitialState) override;
+	void ExecuteCommandLists(Graphics& graphics, std::span<CommandRecorder* const> commandRecorders) override;
+
+	std::unique_ptr<DeviceFence> CreateFence(Graphics& graphics) override;
+	void QueueWait(Graphics& graphics, DeviceFence* fence, size_t value) override;
+	bool IsRemoved() override;
+
+	std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> GetSwapChainBuffers(Graphics& graphics, unsigned int bufferCount) override;
+	void Present(Graphics& graphics, unsigned int syncInterval, unsigned int flags) override;
+	bool SupportsTearing() override;
+	unsigned int GetCurrentBackBufferIndex(unsigned int bufferCount) override;
+
+	UINT64 GetTimestampFrequency() override;
+	bool GetClockCalibration(Graphics& graphics, UINT64& gpuTimestamp, UINT64& cpuTimestamp) override;
+
+	ID3D12Device* GetNativeDevice() override;
+	ID3D12CommandQueue* GetNativeCommandQueue() override;
+
+private:
+	Microsoft::WRL::ComPtr<IDXGIFactory2> pFactory;
+	Microsoft::WRL::ComPtr<ID3D12Debug6> pDebugController;
+	Microsoft::WRL::ComPtr<ID3D12Device15> pDevice;
+	Microsoft::WRL::ComPtr<ID3D12CommandQueue> pCommandQueue;
+	Microsoft::WRL::ComPtr<IDXGISwapChain3> pSwapChain;
+
+	bool m_tearingSupported = false;
+};
\ No newline at end of file
@@ -3,15 +3,85 @@
 #include "Macros/ErrorMacros.h"
 
 #define ADDITIONAL_DESCRIPTOR_HEAP_SIZE 4096
+#define TRANSIENT_DESCRIPTOR_RING_SIZE 1024
+
+DescriptorHeap::Allocation::Allocation(std::weak_ptr<DescriptorHeap*> heap, unsigned int offset, unsigned int count)
+	:
+	m_heap(std::move(heap)),
+	m_offset(offset),
+	m_count(count)
+{
+
+}
+
+DescriptorHeap::Allocation::~Allocation()
+{
+	Free();
+}
+
+DescriptorHeap::Allocation::Allocation(Allocation&& other) noexcept
+	:
+	m_heap(std::move(other.m_heap)),
+	m_offset(other.m_offset),
+	m_count(other.m_count)
+{
+	other.m_heap.reset();
+	other.m_offset = 0;
+	other.m_count = 0;
+}
+
+DescriptorHeap::Allocation& DescriptorHeap::Allocation::operator=(Allocation&& other) noexcept
+{
+	if (this == &other)
+		return *this;
+
+	Free();
+
+	m_heap = std::move(other.m_heap);
+	m_offset = other.m_offset;
+	m_count = other.m_count;
+
+	other.m_heap.reset();
+	other.m_offset = 0;
+	other.m_count = 0;
+
+	return *this;
+}
+
+unsigned int DescriptorHeap::Allocation::GetOffset() const
+{
+	return m_offset;
+}
+
+unsigned int DescriptorHeap::Allocation::GetCount() const
+{
+	return m_count;
+}
+
+void DescriptorHeap::Allocation::Free()
+{
+	if (m_count == 0)
+		return;
+
+	if (std::shared_ptr<DescriptorHeap*> heap = m_heap.lock())
+		(*heap)->Free(m_offset, m_count);
+
+	m_heap.reset();
+	m_count = 0;
+}
 
 void DescriptorHeap::Initialize(Graphics& graphics)
 {
 	THROW_OBJECT_STATE_ERROR_IF("Tried to initialize DescriptorHeap twice", m_initialized);
 
-	m_size = ADDITIONAL_DESCRIPTOR_HEAP_SIZE;
+	m_size = TRANSIENT_DESCRIPTOR_RING_SIZE + ADDITIONAL_DESCRIPTOR_HEAP_SIZE;
 	CreateHeaps(graphics, m_size);
 
-	m_descriptorIncrementSize = graphics.GetDeviceResources().GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+	m_persistentAllocator = DescriptorAllocator(ADDITIONAL_DESCRIPTOR_HEAP_SIZE);
+	m_transientRing.Reset(TRANSIENT_DESCRIPTOR_RING_SIZE);
+
+	m_descriptorIncrementSize = graphics.GetDevice().GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+	m_self = std::make_shared<DescriptorHeap*>(this);
 	m_initialized = true;
 }
 
@@ -22,12 +92,12 @@ void DescriptorHeap::RequestMoreSpace(unsigned int space)
 	m_pendingGrowth += space;
 }
 
-void DescriptorHeap::Free(unsigned int descriptorOffset)
+void DescriptorHeap::Free(unsigned int descriptorOffset, unsigned int numDescriptors)
 {
 	THROW_OBJECT_STATE_ERROR_IF("Tried to free a descriptor before DescriptorHeap was initialized", !m_initialized);
-	THROW_INTERNAL_ERROR_IF("Tried to free a descriptor index that was never allocated", descriptorOffset >= m_nextHandleIndex);
+	THROW_INTERNAL_ERROR_IF("Transient descriptors are released with their frame", descriptorOffset < TRANSIENT_DESCRIPTOR_RING_SIZE);
 
-	m_freeList.push_back(descriptorOffset);
+	m_persistentAllocator.Free(descriptorOffset - TRANSIENT_DESCRIPTOR_RING_SIZE, numDescriptors, m_frameNumber);
 }
 
 DescriptorHeap::DescriptorInfo DescriptorHeap::GetHandle(unsigned int descriptorOffset) const
@@ -39,20 +109,44 @@ DescriptorHeap::DescriptorInfo DescriptorHeap::GetHandle(unsigned int descriptor
 }
 
 DescriptorHeap::DescriptorInfo DescriptorHeap::GetNextHandle()
+{
+	return GetNextHandles(1);
+}
+
+DescriptorHeap::DescriptorInfo DescriptorHeap::GetNextHandles(unsigned int numDescriptors)
 {
 	THROW_OBJECT_STATE_ERROR_IF("Tried to get a handle before DescriptorHeap was initialized", !m_initialized);
 
-	if (!m_freeList.empty())
-	{
-		unsigned int index = m_freeList.back();
-		m_freeList.pop_back();
-		return BuildDescriptorInfo(index);
-	}
+	std::optional<unsigned int> first = m_persistentAllocator.Allocate(numDescriptors);
+
+	THROW_INTERNAL_ERROR_IF("Tried to get descriptor handle out of bounds", !first.has_value());
+
+	unsigned int index = TRANSIENT_DESCRIPTOR_RING_SIZE + first.value();
+
+	MarkUncommitted(index, numDescriptors);
+
+	return BuildDescriptorInfo(index);
+}
+
+DescriptorHeap::Allocation DescriptorHeap::Allocate(unsigned int numDescriptors)
+{
+	DescriptorInfo first = GetNextHandles(numDescriptors);
+
+	return Allocation(m_self, first.offsetInDescriptorFromStart, numDescriptors);
+}
+
+DescriptorHeap::DescriptorInfo DescriptorHeap::GetTransientHandles(unsigned int numDescriptors)
+{
+	THROW_OBJECT_STATE_ERROR_IF("Tried to get a handle before DescriptorHeap was initialized", !m_initialized);
+
+	std::optional<size_t> first = m_transientRing.Allocate(numDescriptors, 1);
+
+	THROW_INTERNAL_ERROR_IF("Transient descriptor ring is full", !first.has_value());
 
-	THROW_INTERNAL_ERROR_IF("Tried to get descriptor handle out of bounds", m_nextHandleIndex >= m_size);
+	unsigned int index = static_cast<unsigned int>(first.value());
+
+	MarkUncommitted(index, numDescriptors);
 
-	unsigned int index = m_nextHandleIndex;
-	m_nextHandleIndex++;
 	return BuildDescriptorInfo(index);
 }
 
@@ -61,44 +155,74 @@ ID3D12DescriptorHeap* DescriptorHeap::Get() const
 	return pDescriptorHeap.Get();
 }
 
+void DescriptorHeap::BeginFrame(Graphics& graphics)
+{
+	m_transientRing.FinishFrame(m_frameNumber);
+	m_frameNumber = graphics.GetFrameNumber();
+
+	if (std::optional<size_t> lastRetiredFrame = graphics.GetLastRetiredFrame())
+	{
+		m_transientRing.Retire(*lastRetiredFrame);
+		m_persistentAllocator.Retire(*lastRetiredFrame);
+	}
+}
+
 void DescriptorHeap::Update(Graphics& graphics)
 {
 	THROW_OBJECT_STATE_ERROR_IF("Tried to update DescriptorHeap before it was initialized", !m_initialized);
 
-	unsigned int spareCapacity = m_size - m_nextHandleIndex;
+	unsigned int spareCapacity = m_persistentAllocator.GetNumFree();
 
 	if (m_pendingGrowth <= spareCapacity)
 		return;
 
 	unsigned int newCapacity = m_size + m_pendingGrowth;
-	ID3D12Device* device = graphics.GetDeviceResources().GetDevice();
+	unsigned int numUsedDescriptors = TRANSIENT_DESCRIPTOR_RING_SIZE + m_persistentAllocator.GetUsedExtent();
 
 	auto pOldMasterHeap = std::move(pMasterHeap);
+	auto pOldDescriptorHeap = std::move(pDescriptorHeap);
+	D3D12_CPU_DESCRIPTOR_HANDLE oldMasterCpuStart = m_masterCpuStart;
+	MemoryTracker::Allocation oldTrackedMemory = std::move(m_trackedMemory);
 
 	CreateHeaps(graphics, newCapacity);
 
-	if (m_nextHandleIndex > 0)
-	{
-		THROW_INFO_ERROR(device->CopyDescriptorsSimple(
-			m_nextHandleIndex,
-			pMasterHeap->GetCPUDescriptorHandleForHeapStart(),
-			pOldMasterHeap->GetCPUDescriptorHandleForHeapStart(),
-			D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV)
-		);
-
-		THROW_INFO_ERROR(device->CopyDescriptorsSimple(
-			m_nextHandleIndex,
-			pDescriptorHeap->GetCPUDescriptorHandleForHeapStart(),
-			pMasterHeap->GetCPUDescriptorHandleForHeapStart(),
-			D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV)
-		);
-	}
+	// only master heap can be copy source, new shader visible heap gets filled by the next commit
+	graphics.GetDevice().CopyDescriptorsSimple(graphics, numUsedDescriptors, m_masterCpuStart, oldMasterCpuStart, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+	m_uncommittedRanges.clear();
+	MarkUncommitted(0, numUsedDescriptors);
+
+	m_persistentAllocator.Grow(newCapacity - TRANSIENT_DESCRIPTOR_RING_SIZE);
 
 	m_size = newCapacity;
 	m_pendingGrowth = 0;
 
-	graphics.GetFrameResourceDeleter()->DeleteResource(graphics, std::move(pMasterHeap));
-	graphics.GetFrameResourceDeleter()->DeleteResource(graphics, std::move(pDescriptorHeap));
+	// frames in flight can still read from old heaps
+	graphics.GetFrameResourceDeleter()->DeleteResource(graphics, std::move(pOldMasterHeap));
+	graphics.GetFrameResourceDeleter()->DeleteResource(graphics, std::move(pOldDescriptorHeap));
+	graphics.GetFrameResourceDeleter()->DeleteResource(graphics, std::move(oldTrackedMemory));
+}
+
+void DescriptorHeap::CommitDescriptors(Graphics& graphics)
+{
+	THROW_OBJECT_STATE_ERROR_IF("Tried to commit descriptors before DescriptorHeap was initialized", !m_initialized);
+
+	RenderDevice& device = graphics.GetDevice();
+
+	for (const auto& [first, count] : m_uncommittedRanges)
+	{
+		SIZE_T rangeOffset = static_cast<SIZE_T>(m_descriptorIncrementSize) * first;
+
+		D3D12_CPU_DESCRIPTOR_HANDLE destination = m_visibleCpuStart;
+		destination.ptr += rangeOffset;
+
+		D3D12_CPU_DESCRIPTOR_HANDLE source = m_masterCpuStart;
+		source.ptr += rangeOffset;
+
+		device.CopyDescriptorsSimple(graphics, count, destination, source, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+	}
+
+	m_uncommittedRanges.clear();
 }
 
 DescriptorHeap::DescriptorInfo DescriptorHeap::BuildDescriptorInfo(unsigned int index) const
@@ -106,9 +230,9 @@ DescriptorHeap::DescriptorInfo DescriptorHeap::BuildDescriptorInfo(unsigned int
 	SIZE_T resourceOffset = static_cast<SIZE_T>(m_descriptorIncrementSize) * index;
 
 	DescriptorInfo descriptorInfo = {};
-	descriptorInfo.descriptorCpuHandle = pDescriptorHeap->GetCPUDescriptorHandleForHeapStart();
+	descriptorInfo.descriptorCpuHandle = m_masterCpuStart;
 	descriptorInfo.descriptorCpuHandle.ptr += resourceOffset;
-	descriptorInfo.descriptorHeapGpuHandle = pDescriptorHeap->GetGPUDescriptorHandleForHeapStart();
+	descriptorInfo.descriptorHeapGpuHandle = m_visibleGpuStart;
 	descriptorInfo.descriptorHeapGpuHandle.ptr += resourceOffset;
 	descriptorInfo.offsetInDescriptorFromStart = index;
 	return descriptorInfo;
@@ -116,18 +240,41 @@ DescriptorHeap::DescriptorInfo DescriptorHeap::BuildDescriptorInfo(unsigned int
 
 void DescriptorHeap::CreateHeaps(Graphics& graphics, unsigned int numDescriptors)
 {
-	HRESULT hr;
-
-	ID3D12Device* device = graphics.GetDeviceResources().GetDevice();
-
 	D3D12_DESCRIPTOR_HEAP_DESC masterDesc = {};
 	masterDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
 	masterDesc.NumDescriptors = numDescriptors;
 	masterDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
 	masterDesc.NodeMask = 0;
-	THROW_ERROR(device->CreateDescriptorHeap(&masterDesc, IID_PPV_ARGS(&pMasterHeap)));
 
 	D3D12_DESCRIPTOR_HEAP_DESC visibleDesc = masterDesc;
 	visibleDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-	THROW_ERROR(device->CreateDescriptorHeap(&visibleDesc, IID_PPV_ARGS(&pDescriptorHeap)));
+
+	{
+		MemoryOwnerScope ownerScope("Descriptor heap");
+
+		size_t heapBytes = size_t(numDescriptors) * graphics.GetDevice().GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+		m_trackedMemory = MemoryTracker::Track(MemoryCategory::DescriptorHeaps, heapBytes * 2);
+	}
+
+	RenderDevice::DescriptorHeapAllocation masterHeap = graphics.GetDevice().CreateDescriptorHeap(graphics, masterDesc);
+	RenderDevice::DescriptorHeapAllocation visibleHeap = graphics.GetDevice().CreateDescriptorHeap(graphics, visibleDesc);
+
+	pMasterHeap = std::move(masterHeap.pDescriptorHeap);
+	pDescriptorHeap = std::move(visibleHeap.pDescriptorHeap);
+
+	m_masterCpuStart = masterHeap.cpuStart;
+	m_visibleCpuStart = visibleHeap.cpuStart;
+	m_visibleGpuStart = visibleHeap.gpuStart;
+}
+
+void DescriptorHeap::MarkUncommitted(unsigned int first, unsigned int count)
+{
+	// allocations mostly follow each other, so neighbouring ranges are merged into one copy
+	if (!m_uncommittedRanges.empty() && m_uncommittedRanges.back().first + m_uncommittedRanges.back().second == first)
+	{
+		m_uncommittedRanges.back().second += count;
+		return;
+	}
+
+	m_uncommittedRanges.push_back({ first, count });
 }
\ No newline at end of file
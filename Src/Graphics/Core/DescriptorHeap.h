@@ -4,8 +4,16 @@
 #include "Includes/DirectXIncludes.h"
 #include "Includes/WRLNoWarnings.h"
 
+#include "Graphics/Resources/DescriptorAllocator.h"
+#include "Graphics/Resources/FrameRingAllocator.h"
+#include "Graphics/Profiler/MemoryTracker.h"
+
 class Graphics;
 
+// descriptors are written to CPU only master heap and copied to shader visible heap before command list gets executed.
+// Start of the heap is a ring of transient descriptors that live for one frame, rest are persistent ranges
+// which are recycled only after GPU finished frames that could still read them
+
 class DescriptorHeap
 {
 public:
@@ -16,35 +24,93 @@ public:
 		UINT offsetInDescriptorFromStart;
 	};
 
+	// persistent descriptors that are freed when destroyed. Cached bindables can outlive graphics at exit, then there is no heap to return them to
+	class Allocation
+	{
+	public:
+		Allocation() = default;
+		~Allocation();
+
+		Allocation(Allocation&& other) noexcept;
+		Allocation& operator=(Allocation&& other) noexcept;
+
+		Allocation(const Allocation&) = delete;
+		Allocation& operator=(const Allocation&) = delete;
+
+	public:
+		unsigned int GetOffset() const; // of the first descriptor, from the start of the heap
+		unsigned int GetCount() const;
+
+	private:
+		friend class DescriptorHeap;
+
+		Allocation(std::weak_ptr<DescriptorHeap*> heap, unsigned int offset, unsigned int count);
+
+		void Free();
+
+	private:
+		std::weak_ptr<DescriptorHeap*> m_heap;
+		unsigned int m_offset = 0;
+		unsigned int m_count = 0;
+	};
+
 public:
 	void Initialize(Graphics& graphics); // allocates 1000 entries at the start
 
 	void RequestMoreSpace(unsigned int space = 1);
 
-	void Free(unsigned int descriptorOffset);
+	// descriptors can be handed out again after frames in flight are finished
+	void Free(unsigned int descriptorOffset, unsigned int numDescriptors = 1);
 
 	DescriptorInfo GetHandle(unsigned int descriptorOffset = 0) const;
 
 	DescriptorInfo GetNextHandle();
+
+	// contiguous range of descriptors for descriptor tables, returns the first one
+	DescriptorInfo GetNextHandles(unsigned int numDescriptors);
+
+	// the same as GetNextHandles(), but range is freed together with returned allocation
+	Allocation Allocate(unsigned int numDescriptors = 1);
+
+	// descriptors that are valid only in current frame, they don't need space requested beforehand
+	DescriptorInfo GetTransientHandles(unsigned int numDescriptors = 1);
 	
 	ID3D12DescriptorHeap* Get() const;
 
+	void BeginFrame(Graphics& graphics);
+
 	void Update(Graphics& graphics);
 
+	// copies descriptors written since last call to shader visible heap
+	void CommitDescriptors(Graphics& graphics);
+
 private:
 	DescriptorInfo BuildDescriptorInfo(unsigned int index) const;
 
 	void CreateHeaps(Graphics& graphics, unsigned int numDescriptors);
 
+	void MarkUncommitted(unsigned int first, unsigned int count);
+
 private:
 	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> pMasterHeap;
 	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> pDescriptorHeap;
 
+	// starts of both heaps, null device has only handles without heap objects
+	D3D12_CPU_DESCRIPTOR_HANDLE m_masterCpuStart = {};
+	D3D12_CPU_DESCRIPTOR_HANDLE m_visibleCpuStart = {};
+	D3D12_GPU_DESCRIPTOR_HANDLE m_visibleGpuStart = {};
+	MemoryTracker::Allocation m_trackedMemory; // both heaps
+
 	unsigned int m_size = 0;
 	unsigned int m_pendingGrowth = 0;
-	unsigned int m_nextHandleIndex = 0;
 	unsigned int m_descriptorIncrementSize = 0;
 	bool m_initialized = false;
 
-	std::vector<unsigned int> m_freeList;
+	DescriptorAllocator m_persistentAllocator; // indices are relative to the end of transient ring
+	FrameRingAllocator m_transientRing;
+	size_t m_frameNumber = 0;
+
+	std::shared_ptr<DescriptorHeap*> m_self; // allocations only keep weak reference to it
+
+	std::vector<std::pair<unsigned int, unsigned int>> m_uncommittedRanges; // first index and count
 };
\ No newline at end of file
@@ -2,42 +2,20 @@
 #include "Graphics.h"
 #include "macros/ErrorMacros.h"
 
-Fence::Fence(Fence&& other) noexcept
-	:
-	m_fenceEvent(other.m_fenceEvent),
-	pFence(other.pFence),
-	m_fenceValue(other.m_fenceValue),
-	m_valueSet(other.m_valueSet)
-{
-	other.m_moved = true;
-}
+Fence::Fence(Fence&& other) noexcept = default;
 
 Fence::Fence(Graphics& graphics)
+	:
+	m_fence(graphics.GetDevice().CreateFence(graphics))
 {
-	HRESULT hr;
-
-	THROW_ERROR(graphics.GetDeviceResources().GetDevice()->CreateFence(
-		0,
-		D3D12_FENCE_FLAG_NONE,
-		IID_PPV_ARGS(&pFence)
-	));
-
 
-	m_fenceEvent = CreateEventA(nullptr, false, false, nullptr);
-
-	if (m_fenceEvent == NULL)
-		THROW_LAST_ERROR;
 }
 
-Fence::~Fence()
-{
-	if(!m_moved)
-		CloseHandle(m_fenceEvent);
-}
+Fence::~Fence() = default;
 
-ID3D12Fence* Fence::Get() const
+DeviceFence* Fence::Get() const
 {
-	return pFence.Get();
+	return m_fence.get();
 }
 
 size_t Fence::GetValue() const
@@ -54,15 +32,13 @@ void Fence::WaitForGPU(Graphics& graphics)
 
 void Fence::SetWaitValue(Graphics& graphics)
 {
-	HRESULT hr;
-
 	// if device got removed we don't want to process further since call on commandQueue will not be valid
-	if (graphics.GetDeviceResources().GetDevice()->GetDeviceRemovedReason() != S_OK) //  if GetDeviceRemovedReason() returns S_OK, then device was not removed
+	if (graphics.GetDevice().IsRemoved())
 		return;
 
 	m_fenceValue++; // increasing value of fence
 
-	THROW_ERROR(graphics.GetDeviceResources().GetCommandQueue()->Signal(pFence.Get(), m_fenceValue));
+	m_fence->Signal(graphics, m_fenceValue);
 
 	m_valueSet = true;
 }
@@ -72,14 +48,8 @@ void Fence::WaitForValue(Graphics& graphics)
 	if (!m_valueSet)
 		return;
 
-	HRESULT hr;
-
-	if (graphics.GetDeviceResources().GetDevice()->GetDeviceRemovedReason() != S_OK)
+	if (graphics.GetDevice().IsRemoved())
 		return;
 
-	if (pFence->GetCompletedValue() < m_fenceValue)
-	{
-		THROW_ERROR(pFence->SetEventOnCompletion(m_fenceValue, m_fenceEvent));
-		WaitForSingleObject(m_fenceEvent, INFINITE);
-	}
+	m_fence->WaitForValue(graphics, m_fenceValue);
 }
\ No newline at end of file
@@ -1,8 +1,8 @@
 #pragma once
-#include "Includes/DirectXIncludes.h"
-#include "Includes/WRLNoWarnings.h"
+#include "Includes/CppIncludes.h"
 
 class Graphics;
+class DeviceFence;
 
 class Fence
 {
@@ -14,7 +14,7 @@ public:
 	~Fence();
 
 public:
-	ID3D12Fence* Get() const;
+	DeviceFence* Get() const;
 
 	size_t GetValue() const;
 
@@ -27,10 +27,7 @@ public:
 	void WaitForValue(Graphics& graphics);
 
 private:
-	Microsoft::WRL::ComPtr<ID3D12Fence> pFence;
-	HANDLE m_fenceEvent = NULL;
+	std::unique_ptr<DeviceFence> m_fence;
 	size_t m_fenceValue = 0;
 	bool m_valueSet = false;
-	bool m_moved = false;
-};
-
+};
\ No newline at end of file
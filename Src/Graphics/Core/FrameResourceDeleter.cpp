@@ -1,42 +1,81 @@
 #include "FrameResourceDeleter.h"
 #include "Graphics.h"
 
-FrameResourceDeleter::FrameIdentifier::FrameIdentifier(unsigned int _frameIndex, size_t _fenceValue)
-	:
-	frameIndex(_frameIndex),
-	fenceValue(_fenceValue)
+FrameResourceDeleter::FrameResourceDeleter()
 {
+	m_deletionThread = std::thread(&FrameResourceDeleter::DeletionThreadLoop, this);
 
+	// releasing memory is never urgent, so it shouldn't take time from render thread or job workers
+	SetThreadPriority(m_deletionThread.native_handle(), THREAD_PRIORITY_LOWEST);
 }
 
-bool FrameResourceDeleter::FrameIdentifier::operator==(const FrameIdentifier& other) const
+FrameResourceDeleter::~FrameResourceDeleter()
 {
-	return other.frameIndex == frameIndex &&
-		other.fenceValue == fenceValue;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+
+	m_resourcesAvailable.notify_one();
+	m_deletionThread.join();
 }
 
 void FrameResourceDeleter::Update(Graphics& graphics)
 {
-	unsigned int curentGraphicsBufferIndex = graphics.GetCurrentBufferIndex();
-	size_t currentBufferCurrentFenceValue = graphics.GetFence(curentGraphicsBufferIndex)->GetValue();
+	// at the end of frame N we already waited for GPU to finish frame N - bufferCount,
+	// its retire list is the one that next frame would fill
+	m_frameNumber++;
+
+	RetireList& retireList = GetRetireList(graphics, m_frameNumber);
+
+	retireList.resources.clear();
 
-	if (curentGraphicsBufferIndex == 0)
-		currentBufferCurrentFenceValue--; // we use first graphics frame for initialization where we needed to force-sync after to start drawing
+	if (retireList.backgroundResources.empty())
+		return;
 
-	std::erase_if(m_resources, [&](const auto& entry) {
-		const auto& [key, res] = entry;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
 
-		return key.frameIndex == curentGraphicsBufferIndex &&
-			key.fenceValue < currentBufferCurrentFenceValue;
-	});
+		if (m_backgroundQueue.empty())
+			std::swap(m_backgroundQueue, retireList.backgroundResources);
+		else
+			std::move(retireList.backgroundResources.begin(), retireList.backgroundResources.end(), std::back_inserter(m_backgroundQueue));
+	}
+
+	retireList.backgroundResources.clear();
+
+	m_resourcesAvailable.notify_one();
 }
 
-unsigned int FrameResourceDeleter::GetFrameIndex(Graphics& graphics)
+FrameResourceDeleter::RetireList& FrameResourceDeleter::GetRetireList(Graphics& graphics, size_t frameNumber)
 {
-	return graphics.GetCurrentBufferIndex();
+	if (m_retireLists.empty())
+		m_retireLists.resize(graphics.GetBufferCount() + 1);
+
+	return m_retireLists[frameNumber % m_retireLists.size()];
 }
 
-unsigned int FrameResourceDeleter::GetFenceValueForCurrentFrame(Graphics& graphics)
+void FrameResourceDeleter::DeletionThreadLoop()
 {
-	return graphics.GetFence(GetFrameIndex(graphics))->GetValue();
+	std::vector<ResourceForDeletion> resources;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+
+			m_resourcesAvailable.wait(lock, [this]()
+				{
+					return m_stop || !m_backgroundQueue.empty();
+				});
+
+			if (m_backgroundQueue.empty())
+				return;
+
+			std::swap(resources, m_backgroundQueue);
+		}
+
+		// resources are released outside of lock so render thread can keep queueing
+		resources.clear();
+	}
 }
\ No newline at end of file
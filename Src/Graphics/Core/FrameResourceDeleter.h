@@ -1,49 +1,104 @@
 #pragma once
 #include "Includes/CppIncludes.h"
+#include "Includes/WRLNoWarnings.h"
+
+#include "Graphics/Resources/GraphicsResource.h"
 
 class Graphics;
 
-// purpose of this class is to hang onto the resource as long as frames-in-flight could potentially use the resource
+// purpose of this class is to hang onto the resource as long as frames-in-flight could potentially use the resource.
+// Resources are kept in ring of retire lists, one for each frame that can be in flight plus the current one.
+// GPU memory and descriptor heaps are released on low priority thread, so freeing thousands of upload buffers doesn't stall a frame
 class FrameResourceDeleter
 {
-	struct FrameIdentifier
-	{
-		FrameIdentifier(unsigned int _frameIndex, size_t _fenceValue);
-		bool operator==(const FrameIdentifier& other) const;
-
-		unsigned int frameIndex;
-		size_t fenceValue;
-	};
-
 	using ResourceForDeletion = std::move_only_function<void()>;
-	using ResourcesPerFrame = std::vector<ResourceForDeletion>;
 
-	struct FrameIdentifierHash
+	struct RetireList
 	{
-		size_t operator()(const FrameIdentifier& key) const
-		{
-			return std::hash<unsigned int>{}(key.frameIndex) ^ 
-				std::hash<size_t>{}(key.fenceValue);
-		}
+		std::vector<ResourceForDeletion> resources;
+		std::vector<ResourceForDeletion> backgroundResources; // only own D3D objects, so they can be released from any thread
 	};
 
+	template<class T>
+	struct IsBackgroundDeletable : std::false_type {};
+
+	template<class T>
+	struct IsBackgroundDeletable<std::unique_ptr<T>> : std::is_base_of<GraphicsResource, T> {};
+
+	template<class T>
+	struct IsBackgroundDeletable<std::shared_ptr<T>> : std::is_base_of<GraphicsResource, T> {};
+
+	template<class T>
+	struct IsBackgroundDeletable<Microsoft::WRL::ComPtr<T>> : std::true_type {};
+
+	template<class T>
+	struct IsGraphicsResourcePointer : std::false_type {};
+
+	template<class T>
+	struct IsGraphicsResourcePointer<std::unique_ptr<T>> : std::is_base_of<GraphicsResource, T> {};
+
+	template<class T>
+	struct IsGraphicsResourcePointer<std::shared_ptr<T>> : std::is_base_of<GraphicsResource, T> {};
+
+public:
+	FrameResourceDeleter();
+	FrameResourceDeleter(const FrameResourceDeleter&) = delete;
+
+	~FrameResourceDeleter();
+
 public:
 	template<class T>
 	void DeleteResource(Graphics& graphics, T&& resource)
 	{
 		static_assert(!std::is_trivial<T>());
 
-		FrameIdentifier frameIdentifier = FrameIdentifier(GetFrameIndex(graphics), GetFenceValueForCurrentFrame(graphics));
+		MarkPendingDeletion(resource);
 
-		m_resources[frameIdentifier].push_back(ResourceForDeletion([res = std::move(resource)]() mutable {}));
+		ResourceForDeletion resourceForDeletion([res = std::move(resource)]() mutable {});
+
+		if constexpr (IsBackgroundDeletable<std::remove_cvref_t<T>>::value)
+			GetRetireList(graphics, m_frameNumber).backgroundResources.push_back(std::move(resourceForDeletion));
+		else
+			GetRetireList(graphics, m_frameNumber).resources.push_back(std::move(resourceForDeletion));
 	};
 
+	// has to be called once at the end of every frame
 	void Update(Graphics& graphics);
 
 private:
-	static unsigned int GetFrameIndex(Graphics& graphics);
-	static unsigned int GetFenceValueForCurrentFrame(Graphics& graphics);
+	// memory of tracked resources is shown as pending until their retire list is released
+	template<class T>
+	static void MarkPendingDeletion(T& resource)
+	{
+		using Type = std::remove_cvref_t<T>;
+
+		if constexpr (std::is_same_v<Type, MemoryTracker::Allocation>)
+		{
+			resource.MarkPendingDeletion();
+		}
+		else if constexpr (IsGraphicsResourcePointer<Type>::value)
+		{
+			bool isLastOwner = true;
+
+			if constexpr (std::is_same_v<Type, std::shared_ptr<typename Type::element_type>>)
+				isLastOwner = resource.use_count() == 1;
+
+			if (resource && isLastOwner)
+				resource->MarkPendingDeletion();
+		}
+	}
+
+	RetireList& GetRetireList(Graphics& graphics, size_t frameNumber);
+
+	void DeletionThreadLoop();
 
 private:
-	std::unordered_map<FrameIdentifier, ResourcesPerFrame, FrameIdentifierHash> m_resources;
+	std::vector<RetireList> m_retireLists;
+	size_t m_frameNumber = 0;
+
+	std::thread m_deletionThread;
+	std::mutex m_mutex;
+	std::condition_variable m_resourcesAvailable;
+	std::vector<ResourceForDeletion> m_backgroundQueue;
+	bool m_stop = false;
 };
\ No newline at end of file
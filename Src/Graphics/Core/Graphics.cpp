@@ -2,6 +2,8 @@
 #include "Macros/ErrorMacros.h"
 
 #include "Graphics/Core/Pix.h"
+#include "D3D12RenderDevice.h"
+#include "NullRenderDevice.h"
 #include "ResourceList.h"
 #include "Includes/DirectXIncludes.h"
 
@@ -20,9 +22,7 @@ Graphics::Graphics(HWND hWnd, DXGI_FORMAT renderTargetFormat)
 
 	// Initializing pipeline components
 	{
-		HRESULT hr;
-
-		deviceResources.InitializeEntryResources();
+		renderDevice = std::make_unique<D3D12RenderDevice>();
 
 #ifdef _DEBUG
 		// creating info queue
@@ -31,14 +31,11 @@ Graphics::Graphics(HWND hWnd, DXGI_FORMAT renderTargetFormat)
 		}
 #endif
 
-		deviceResources.InitializeGraphicsResources(*this, hWnd, renderTargetFormat, swapChainBufferCount);
+		static_cast<D3D12RenderDevice&>(*renderDevice).InitializeSwapChain(*this, hWnd, renderTargetFormat, swapChainBufferCount);
 
 		// Initializing swapchain holding RenderTarget class
 		{
-			std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> bufferList(swapChainBufferCount);
-
-			for (unsigned int bufferIndex = 0; bufferIndex < swapChainBufferCount; bufferIndex++)
-				THROW_ERROR_AT_GFX_INIT(deviceResources.GetSwapChain()->GetBuffer(bufferIndex, IID_PPV_ARGS(&bufferList.at(bufferIndex))));
+			std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> bufferList = renderDevice->GetSwapChainBuffers(*this, swapChainBufferCount);
 
 			// getting width and height out of gotten resource
 			{
@@ -50,24 +47,36 @@ Graphics::Graphics(HWND hWnd, DXGI_FORMAT renderTargetFormat)
 
 			m_swapChainBuffer = std::make_shared<SwapChainRenderTarget>(*this, renderTargetFormat, bufferList);
 		}
+	}
 
-		// intializing back buffers
-		m_backBuffer = std::make_shared<BackBufferRenderTarget>(*this, renderTargetFormat);
+	InitializeFrameResources(renderTargetFormat);
+}
 
+Graphics::Graphics(unsigned int width, unsigned int height, DXGI_FORMAT renderTargetFormat)
+	:
+	m_width(width),
+	m_height(height),
+	m_windowHwnd(NULL)
+{
+	THROW_OBJECT_STATE_ERROR_IF("Given format is not valid swap chain buffer", !CheckValidRenderTargetFormat(renderTargetFormat));
 
-		// initializing depth stencil view
-		m_depthStencilView = std::make_shared<DepthStencilViewMultiResource>(*this);
+	renderDevice = std::make_unique<NullRenderDevice>();
 
-		// initializing graphic fence for each frame buffer
-		for (unsigned int bufferIndex = 0; bufferIndex < swapChainBufferCount; bufferIndex++)
-			m_graphicFences.push_back(Fence(*this));
+#ifdef _DEBUG
+	// creating info queue
+	{
+		m_infoQueue = std::make_unique<InfoQueue>(*this);
 	}
+#endif
 
-	descriptorHeap.Initialize(*this);
-	constantBufferHeap.Initialize(*this);
-	bufferHeap.Initialize(*this);
-	renderer.Initialize(*this);
-	profiler.Initialize(*this);
+	// null swap chain doesn't own any buffers
+	{
+		std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> bufferList = renderDevice->GetSwapChainBuffers(*this, swapChainBufferCount);
+
+		m_swapChainBuffer = std::make_shared<SwapChainRenderTarget>(*this, renderTargetFormat, bufferList);
+	}
+
+	InitializeFrameResources(renderTargetFormat);
 }
 
 Graphics::~Graphics()
@@ -95,9 +104,24 @@ unsigned int Graphics::GetBufferCount() const
 	return swapChainBufferCount;
 }
 
+size_t Graphics::GetFrameNumber() const
+{
+	return m_frameNumber;
+}
+
+std::optional<size_t> Graphics::GetLastRetiredFrame() const
+{
+	// at the start of frame we already waited for GPU to finish frame that used the same back buffer
+	if (m_frameNumber < GetBufferCount())
+		return std::nullopt;
+
+	return m_frameNumber - GetBufferCount();
+}
+
 void Graphics::BeginFrame(float deltaTime)
 {
-	m_currentBufferIndex = GetCurrentBufferIndexFromSwapchain();
+	m_frameNumber++;
+	m_currentBufferIndex = renderDevice->GetCurrentBackBufferIndex(GetBufferCount());
 
 	m_imguiManager->BeginFrame(*this);
 
@@ -108,6 +132,10 @@ void Graphics::BeginFrame(float deltaTime)
 	profiler.SetBeginData(*this, renderer.GetPipeline().GetGraphicCommandList(), deltaTime);
 
 	graphicsBufferAllocatorManager.Update(*this);
+
+	constantBufferHeap.BeginFrame(*this);
+	bufferHeap.BeginFrame(*this);
+	descriptorHeap.BeginFrame(*this);
 }
 
 void Graphics::FinishFrame()
@@ -134,17 +162,43 @@ void Graphics::Render(Scene& scene, float deltaTime)
 	renderer.Draw(*this, scene, deltaTime);
 }
 
-void Graphics::PresentFrame(Graphics& graphics)
+void Graphics::InitializeFrameResources(DXGI_FORMAT renderTargetFormat)
 {
-	HRESULT hr;
+	// intializing back buffers
+	m_backBuffer = std::make_shared<BackBufferRenderTarget>(*this, renderTargetFormat);
+
+
+	// initializing depth stencil view
+	m_depthStencilView = std::make_shared<DepthStencilViewMultiResource>(*this);
+
+	// initializing graphic fence for each frame buffer
+	for (unsigned int bufferIndex = 0; bufferIndex < swapChainBufferCount; bufferIndex++)
+		m_graphicFences.push_back(Fence(*this));
+
+	descriptorHeap.Initialize(*this);
+	constantBufferHeap.Initialize(*this);
+	bufferHeap.Initialize(*this);
+	renderer.Initialize(*this);
+	profiler.Initialize(*this);
+}
 
+void Graphics::PresentFrame(Graphics& graphics)
+{
 	Fence* pPreviousFrameFence = &m_graphicFences.at(GetPreviousBufferIndex());
 
 	// forcing this frame on GPU side to wait till previous frame is presented
 	if(pPreviousFrameFence->GetValue() != 0)
-		THROW_INFO_ERROR(GetDeviceResources().GetCommandQueue()->Wait(pPreviousFrameFence->Get(), pPreviousFrameFence->GetValue()));
+		renderDevice->QueueWait(graphics, pPreviousFrameFence->Get(), pPreviousFrameFence->GetValue());
+
+	if (m_vsync)
+		renderDevice->Present(graphics, 1, 0);
+	else
+		renderDevice->Present(graphics, 0, renderDevice->SupportsTearing() ? DXGI_PRESENT_ALLOW_TEARING : 0);
+}
 
-	THROW_ERROR_AT_GFX_INIT(GetDeviceResources().GetSwapChain()->Present(1, NULL));
+void Graphics::SetVSync(bool enabled)
+{
+	m_vsync = enabled;
 }
 
 void Graphics::WaitForGPU()
@@ -189,14 +243,19 @@ Profiler& Graphics::GetProfiler()
 	return profiler;
 }
 
+JobSystem& Graphics::GetJobSystem()
+{
+	return jobSystem;
+}
+
 Renderer& Graphics::GetRenderer()
 {
 	return renderer;
 }
 
-DeviceResources& Graphics::GetDeviceResources()
+RenderDevice& Graphics::GetDevice()
 {
-	return deviceResources;
+	return *renderDevice;
 }
 
 ConstantBufferHeap& Graphics::GetConstantBufferHeap()
@@ -281,13 +340,4 @@ constexpr bool Graphics::CheckValidRenderTargetFormat(DXGI_FORMAT format)
 	}
 }
 
-#pragma warning(pop)
-
-unsigned int Graphics::GetCurrentBufferIndexFromSwapchain()
-{
-	Microsoft::WRL::ComPtr<IDXGISwapChain3> swapChain3;
-
-	GetDeviceResources().GetSwapChain()->QueryInterface(swapChain3.GetAddressOf());
-
-	return swapChain3->GetCurrentBackBufferIndex();
-}
\ No newline at end of file
+#pragma warning(pop)
\ No newline at end of file
@@ -12,9 +12,10 @@
 #include "FrameResourceDeleter.h"
 #include "Graphics/Core/DescriptorHeap.h"
 #include "ConstantBufferHeap.h"
-#include "Graphics/Core/DeviceResources.h"
+#include "Graphics/Core/RenderDevice.h"
 #include "Graphics/Core/Renderer.h"
 #include "Graphics/Profiler/Profiler.h"
+#include "System/JobSystem.h"
 #include "Graphics/Core/GraphicsBufferAllocatorManager.h"
 
 class Graphics
@@ -22,6 +23,9 @@ class Graphics
 public:
 	Graphics(HWND hWnd, DXGI_FORMAT renderTargetFormat);
 
+	// headless graphics running on null device, nothing is sent to GPU or presented
+	Graphics(unsigned int width, unsigned int height, DXGI_FORMAT renderTargetFormat);
+
 	Graphics(const Graphics&) = delete;
 	
 	~Graphics();
@@ -32,6 +36,11 @@ public:
 	unsigned int GetNextBufferIndex() const;
 	unsigned int GetBufferCount() const;
 
+	size_t GetFrameNumber() const; // increases by one in every BeginFrame()
+
+	// latest frame that GPU has finished, resources it used can be reused. Empty until the first back buffer comes around again
+	std::optional<size_t> GetLastRetiredFrame() const;
+
 	void BeginFrame(float deltaTime);
 	void FinishFrame();
 	void Render(Scene& scene, float deltaTime);
@@ -41,7 +50,12 @@ public:
 
 	void FinishInitialization();
 
+	// presenting with vsync off lets frame time reflect actual CPU and GPU cost, used by benchmarks
+	void SetVSync(bool enabled);
+
 private:
+	void InitializeFrameResources(DXGI_FORMAT renderTargetFormat);
+
 	void PresentFrame(Graphics& graphics);
 	void CleanupResources();
 
@@ -49,8 +63,9 @@ public:
 	Fence* GetFence(unsigned int frameIndex);
 	GraphicsBufferAllocatorManager* GetGraphicsBufferAllocatorManager();
 	Profiler& GetProfiler();
+	JobSystem& GetJobSystem();
 	Renderer& GetRenderer();
-	DeviceResources& GetDeviceResources();
+	RenderDevice& GetDevice();
 	ConstantBufferHeap& GetConstantBufferHeap();
 	BufferHeap& GetBufferHeap();
 	DescriptorHeap& GetDescriptorHeap();
@@ -69,16 +84,16 @@ public:
 
 private:
 	static constexpr bool CheckValidRenderTargetFormat(DXGI_FORMAT format);
-	unsigned int GetCurrentBufferIndexFromSwapchain();
 
 private:
-	DeviceResources deviceResources;
+	std::unique_ptr<RenderDevice> renderDevice;
 	ConstantBufferHeap constantBufferHeap;
 	BufferHeap bufferHeap;
 	DescriptorHeap descriptorHeap;
 	FrameResourceDeleter resourceDeleter;
 	Renderer renderer;
 	Profiler profiler;
+	JobSystem jobSystem;
 	GraphicsBufferAllocatorManager graphicsBufferAllocatorManager;
 
 private:
@@ -98,6 +113,8 @@ private:
 
 	const unsigned int swapChainBufferCount = 2;
 	unsigned int m_currentBufferIndex = 0;
+	size_t m_frameNumber = 0;
+	bool m_vsync = true;
 
 	HWND m_windowHwnd;
 };
\ No newline at end of file
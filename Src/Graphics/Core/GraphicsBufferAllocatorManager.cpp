@@ -9,7 +9,7 @@ std::shared_ptr<GraphicsBufferSuballocator> GraphicsBufferAllocatorManager::Requ
 	auto [iterator, inserted] = m_allocators.try_emplace(identifier);
 
 	if (inserted)
-		iterator->second = std::make_shared<GraphicsBufferSuballocator>(graphics, numElements, stride, bufferState, type);
+		iterator->second = std::make_shared<GraphicsBufferSuballocator>(graphics, numElements, stride, bufferState, type, GetSuballocatorName(bufferState, type));
 
 	return iterator->second;
 }
@@ -17,7 +17,23 @@ std::shared_ptr<GraphicsBufferSuballocator> GraphicsBufferAllocatorManager::Requ
 void GraphicsBufferAllocatorManager::Update(Graphics& graphics)
 {
 	for (auto& [key, allocator] : m_allocators)
+	{
 		allocator->Update(graphics);
+
+		MemoryTracker::Get().SetSuballocatorStats(allocator->GetName(), allocator->GetMemoryStats());
+	}
+}
+
+const char* GraphicsBufferAllocatorManager::GetSuballocatorName(D3D12_RESOURCE_STATES bufferState, BufferType type)
+{
+	bool isStatic = type == BufferType::Static;
+
+	switch (bufferState)
+	{
+	case D3D12_RESOURCE_STATE_INDEX_BUFFER:					return isStatic ? "Static index buffers" : "Dynamic index buffers";
+	case D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER:	return isStatic ? "Static vertex and constant buffers" : "Dynamic constant buffers";
+	default:												return isStatic ? "Static buffers" : "Dynamic buffers";
+	}
 }
 
 bool GraphicsBufferAllocatorManager::SuballocatorIdentifier::operator==(const SuballocatorIdentifier& other) const
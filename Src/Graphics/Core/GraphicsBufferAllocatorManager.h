@@ -11,6 +11,9 @@ public:
 
 	void Update(Graphics& graphics);
 
+private:
+	static const char* GetSuballocatorName(D3D12_RESOURCE_STATES bufferState, BufferType type);
+
 private:
 	struct SuballocatorIdentifier
 	{
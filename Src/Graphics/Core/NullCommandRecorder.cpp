@@ -0,0 +1,169 @@
+#include "NullCommandRecorder.h"
+#include "NullDevice.h"
+
+NullCommandRecorder::NullCommandRecorder(NullDevice& nullDevice)
+	:
+	m_nullDevice(nullDevice)
+{
+
+}
+
+void NullCommandRecorder::Reset(Graphics& graphics, unsigned int allocatorIndex, ID3D12PipelineState* pPipelineState)
+{
+
+}
+
+void NullCommandRecorder::Close(Graphics& graphics)
+{
+
+}
+
+ID3D12GraphicsCommandList* NullCommandRecorder::GetNative() const
+{
+	return nullptr;
+}
+
+void NullCommandRecorder::DrawIndexedInstanced(Graphics& graphics, unsigned int indices, unsigned int instances, unsigned int startIndexOffset, unsigned int baseVertexOffset)
+{
+	m_nullDevice.RecordCommand();
+}
+
+void NullCommandRecorder::Dispatch(Graphics& graphics, unsigned int workToProcessX, unsigned int workToProcessY, unsigned int workToProcessZ)
+{
+	m_nullDevice.RecordCommand();
+}
+
+void NullCommandRecorder::ExecuteBundle(Graphics& graphics, CommandRecorder* bundle)
+{
+	m_nullDevice.RecordCommand();
+}
+
+void NullCommandRecorder::BeginRenderPass(Graphics& graphics, unsigned int numRenderTargets, const D3D12_RENDER_PASS_RENDER_TARGET_DESC* renderTargets, const D3D12_RENDER_PASS_DEPTH_STENCIL_DESC* depthStencil)
+{
+	m_nullDevice.RecordCommand();
+}
+
+void NullCommandRecorder::EndRenderPass(Graphics& graphics)
+{
+	m_nullDevice.RecordCommand();
+}
+
+void NullCommandRecorder::EndQuery(Graphics& graphics, ID3D12QueryHeap* pQueryHeap, D3D12_QUERY_TYPE queryType, unsigned int entryIndex)
+{
+	m_nullDevice.RecordCommand();
+}
+
+void NullCommandRecorder::ResolveQueryData(Graphics& graphics, ID3D12QueryHeap* pQueryHeap, D3D12_QUERY_TYPE queryType, unsigned int entryIndex, unsigned int numEntries, ID3D12Resource* pDestination, UINT64 destOffset)
+{
+	m_nullDevice.RecordCommand();
+}
+
+void NullCommandRecorder::ResourceBarrier(Graphics& graphics, unsigned int numBarriers, const D3D12_RESOURCE_BARRIER* barriers)
+{
+	m_nullDevice.RecordCommand();
+}
+
+void NullCommandRecorder::SetRenderTarget(Graphics& graphics, const D3D12_CPU_DESCRIPTOR_HANDLE& renderTarget, const D3D12_CPU_DESCRIPTOR_HANDLE* depthStencil)
+{
+	m_nullDevice.RecordCommand();
+}
+
+void NullCommandRecorder::SetVertexBuffer(Graphics& graphics, const D3D12_VERTEX_BUFFER_VIEW* vertexBufferView)
+{
+	m_nullDevice.RecordCommand();
+}
+
+void NullCommandRecorder::SetIndexBuffer(Graphics& graphics, const D3D12_INDEX_BUFFER_VIEW* indexBufferView)
+{
+	m_nullDevice.RecordCommand();
+}
+
+void NullCommandRecorder::SetPrimitiveTopology(Graphics& graphics, D3D_PRIMITIVE_TOPOLOGY primitiveTopology)
+{
+	m_nullDevice.RecordCommand();
+}
+
+void NullCommandRecorder::SetViewport(Graphics& graphics, const D3D12_VIEWPORT& viewport, const D3D12_RECT& scissorRect)
+{
+	m_nullDevice.RecordCommand();
+}
+
+void NullCommandRecorder::SetDescriptorHeap(Graphics& graphics, ID3D12DescriptorHeap* pDescriptorHeap)
+{
+	m_nullDevice.RecordCommand();
+}
+
+void NullCommandRecorder::SetPipelineState(Graphics& graphics, ID3D12PipelineState* pPipelineState)
+{
+	m_nullDevice.RecordCommand();
+}
+
+void NullCommandRecorder::SetRootSignature(Graphics& graphics, BindPoint bindPoint, ID3D12RootSignature* pRootSignature)
+{
+	m_nullDevice.RecordCommand();
+}
+
+void NullCommandRecorder::SetRootConstantBufferView(Graphics& graphics, BindPoint bindPoint, unsigned int rootIndex, D3D12_GPU_VIRTUAL_ADDRESS address)
+{
+	m_nullDevice.RecordCommand();
+}
+
+void NullCommandRecorder::SetRootShaderResourceView(Graphics& graphics, BindPoint bindPoint, unsigned int rootIndex, D3D12_GPU_VIRTUAL_ADDRESS address)
+{
+	m_nullDevice.RecordCommand();
+}
+
+void NullCommandRecorder::SetRootUnorderedAccessView(Graphics& graphics, BindPoint bindPoint, unsigned int rootIndex, D3D12_GPU_VIRTUAL_ADDRESS address)
+{
+	m_nullDevice.RecordCommand();
+}
+
+void NullCommandRecorder::SetRootDescriptorTable(Graphics& graphics, BindPoint bindPoint, unsigned int rootIndex, D3D12_GPU_DESCRIPTOR_HANDLE descriptor)
+{
+	m_nullDevice.RecordCommand();
+}
+
+void NullCommandRecorder::SetRoot32BitConstants(Graphics& graphics, BindPoint bindPoint, unsigned int rootIndex, unsigned int numValues, const void* data)
+{
+	m_nullDevice.RecordCommand();
+}
+
+void NullCommandRecorder::ClearRenderTargetView(Graphics& graphics, D3D12_CPU_DESCRIPTOR_HANDLE renderTarget, const float clearColor[4])
+{
+	m_nullDevice.RecordCommand();
+}
+
+void NullCommandRecorder::ClearDepthStencilView(Graphics& graphics, D3D12_CPU_DESCRIPTOR_HANDLE depthStencil, float depth, UINT8 stencil, unsigned int numRects, const D3D12_RECT* rects)
+{
+	m_nullDevice.RecordCommand();
+}
+
+void NullCommandRecorder::CopyBufferRegion(Graphics& graphics, ID3D12Resource* dstResource, UINT64 dstOffset, ID3D12Resource* srcResource, UINT64 srcOffset, UINT64 numBytes)
+{
+	m_nullDevice.RecordCommand();
+}
+
+void NullCommandRecorder::CopyTextureRegion(Graphics& graphics, const D3D12_TEXTURE_COPY_LOCATION& destination, const D3D12_TEXTURE_COPY_LOCATION& source)
+{
+	m_nullDevice.RecordCommand();
+}
+
+void NullCommandRecorder::CopyResource(Graphics& graphics, ID3D12Resource* dstResource, ID3D12Resource* srcResource)
+{
+	m_nullDevice.RecordCommand();
+}
+
+void NullCommandRecorder::SetMarker(std::string_view name)
+{
+
+}
+
+void NullCommandRecorder::BeginEvent(std::string_view name)
+{
+
+}
+
+void NullCommandRecorder::EndEvent()
+{
+
+}
\ No newline at end of file
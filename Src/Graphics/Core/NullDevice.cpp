@@ -0,0 +1,258 @@
+#include "NullDevice.h"
+#include "Macros/ErrorMacros.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+	size_t Align(size_t value, size_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	// packed size of one row and number of rows, rows of block compressed formats are rows of blocks
+	void GetSubresourcePitch(const NullDevice::ResourceDesc& desc, unsigned int mipLevel, size_t& rowSize, size_t& numRows)
+	{
+		if (desc.dimension == NullDevice::ResourceDesc::Dimension::buffer)
+		{
+			rowSize = size_t(desc.width);
+			numRows = 1;
+			return;
+		}
+
+		size_t width = (std::max)(size_t(desc.width >> mipLevel), size_t(1));
+		size_t height = (std::max)(size_t(desc.height >> mipLevel), size_t(1));
+
+		if (desc.blockCompressed)
+		{
+			// one block is 4x4 texels
+			rowSize = (std::max)((width + 3) / 4, size_t(1)) * desc.bitsPerTexel * 2;
+			numRows = (std::max)((height + 3) / 4, size_t(1));
+			return;
+		}
+
+		rowSize = (width * desc.bitsPerTexel + 7) / 8;
+		numRows = height;
+	}
+}
+
+/*
+			Resource
+*/
+
+NullDevice::Resource::Resource(std::shared_ptr<Counters> counters, const ResourceDesc& desc, size_t byteSize, uint64_t gpuAddress, bool cpuAccess)
+	:
+	m_counters(std::move(counters)),
+	m_desc(desc),
+	m_byteSize(byteSize),
+	m_gpuAddress(gpuAddress)
+{
+	if (cpuAccess)
+		m_memory.resize(byteSize);
+
+	m_counters->numResources++;
+	m_counters->numCreatedResources++;
+
+	size_t resourceBytes = m_counters->resourceBytes.fetch_add(byteSize) + byteSize;
+	size_t peakResourceBytes = m_counters->peakResourceBytes.load();
+
+	while (resourceBytes > peakResourceBytes && !m_counters->peakResourceBytes.compare_exchange_weak(peakResourceBytes, resourceBytes));
+}
+
+NullDevice::Resource::~Resource()
+{
+	m_counters->numResources--;
+	m_counters->resourceBytes -= m_byteSize;
+}
+
+const NullDevice::ResourceDesc& NullDevice::Resource::GetDesc() const
+{
+	return m_desc;
+}
+
+uint64_t NullDevice::Resource::GetGPUVirtualAddress() const
+{
+	return m_gpuAddress;
+}
+
+size_t NullDevice::Resource::GetByteSize() const
+{
+	return m_byteSize;
+}
+
+void* NullDevice::Resource::Map()
+{
+	return m_memory.empty() ? nullptr : m_memory.data();
+}
+
+void NullDevice::Resource::WriteToSubresource(const void* data, size_t rowSize, size_t numRows, size_t rowPitch)
+{
+	THROW_INTERNAL_ERROR_IF("Tried to write to null resource without CPU access", m_memory.empty());
+	THROW_INTERNAL_ERROR_IF("Tried to write out of null resource", rowSize * numRows > m_memory.size());
+
+	const unsigned char* pData = static_cast<const unsigned char*>(data);
+
+	for (size_t row = 0; row < numRows; row++)
+		std::memcpy(m_memory.data() + row * rowSize, pData + row * rowPitch, rowSize);
+}
+
+/*
+			NullDevice
+*/
+
+NullDevice::NullDevice()
+	:
+	m_counters(std::make_shared<Counters>()),
+	m_nextGPUAddress(placementAlignment), // zero is reserved for null address
+	m_nextDescriptorAddress(placementAlignment)
+{
+
+}
+
+std::unique_ptr<NullDevice::Resource> NullDevice::CreateResource(const ResourceDesc& desc, bool cpuAccess)
+{
+	AllocationInfo allocationInfo = GetResourceAllocationInfo(desc);
+
+	uint64_t gpuAddress = m_nextGPUAddress.fetch_add(allocationInfo.sizeInBytes);
+
+	// buffers report their exact size, textures the size they would take in memory
+	size_t byteSize = desc.dimension == ResourceDesc::Dimension::buffer ? size_t(desc.width) : allocationInfo.sizeInBytes;
+
+	return std::make_unique<Resource>(m_counters, desc, byteSize, gpuAddress, cpuAccess);
+}
+
+NullDevice::DescriptorHeap NullDevice::CreateDescriptorHeap(unsigned int numDescriptors, bool shaderVisible)
+{
+	size_t heapSize = Align(size_t(numDescriptors) * descriptorHandleIncrementSize, placementAlignment);
+
+	DescriptorHeap descriptorHeap = {};
+	descriptorHeap.cpuStart = m_nextDescriptorAddress.fetch_add(heapSize);
+
+	if (shaderVisible)
+		descriptorHeap.gpuStart = descriptorHeap.cpuStart;
+
+	m_numDescriptorHeaps++;
+
+	return descriptorHeap;
+}
+
+void NullDevice::CreateView()
+{
+	m_numViews++;
+}
+
+void NullDevice::CreateRootSignature()
+{
+	m_numRootSignatures++;
+}
+
+void NullDevice::CreatePipelineState()
+{
+	m_numPipelineStates++;
+}
+
+void NullDevice::CreateQueryHeap()
+{
+	m_numQueryHeaps++;
+}
+
+void NullDevice::CreateCommandList()
+{
+	m_numCommandLists++;
+}
+
+void NullDevice::RecordCommand()
+{
+	m_numRecordedCommands.fetch_add(1, std::memory_order_relaxed);
+}
+
+void NullDevice::ExecuteCommandLists(unsigned int numCommandLists)
+{
+	m_numExecutedCommandLists += numCommandLists;
+}
+
+void NullDevice::Signal()
+{
+	m_numSignals++;
+}
+
+void NullDevice::Present()
+{
+	m_numPresents++;
+}
+
+NullDevice::AllocationInfo NullDevice::GetResourceAllocationInfo(const ResourceDesc& desc) const
+{
+	size_t byteSize = 0;
+
+	if (desc.dimension == ResourceDesc::Dimension::buffer)
+	{
+		byteSize = size_t(desc.width);
+	}
+	else
+	{
+		unsigned int mipLevels = (std::max)(desc.mipLevels, 1u);
+
+		for (unsigned int mipLevel = 0; mipLevel < mipLevels; mipLevel++)
+		{
+			size_t rowSize = 0;
+			size_t numRows = 0;
+			GetSubresourcePitch(desc, mipLevel, rowSize, numRows);
+
+			byteSize += Align(rowSize, pitchAlignment) * numRows;
+		}
+
+		byteSize *= desc.depthOrArraySize;
+	}
+
+	AllocationInfo allocationInfo = {};
+	allocationInfo.sizeInBytes = Align((std::max)(byteSize, size_t(1)), placementAlignment);
+	allocationInfo.alignment = placementAlignment;
+
+	return allocationInfo;
+}
+
+NullDevice::Footprint NullDevice::GetCopyableFootprint(const ResourceDesc& desc, unsigned int subresource) const
+{
+	const bool isBuffer = desc.dimension == ResourceDesc::Dimension::buffer;
+
+	unsigned int mipLevels = (std::max)(desc.mipLevels, 1u);
+	unsigned int mipLevel = subresource % mipLevels;
+
+	Footprint footprint = {};
+	GetSubresourcePitch(desc, mipLevel, footprint.rowSize, footprint.numRows);
+
+	footprint.width = isBuffer ? static_cast<unsigned int>(desc.width) : (std::max)(static_cast<unsigned int>(desc.width >> mipLevel), 1u);
+	footprint.height = (std::max)(desc.height >> mipLevel, 1u);
+	footprint.rowPitch = isBuffer ? footprint.rowSize : Align(footprint.rowSize, pitchAlignment);
+	footprint.totalBytes = (footprint.numRows - 1) * footprint.rowPitch + footprint.rowSize;
+
+	return footprint;
+}
+
+unsigned int NullDevice::GetCurrentBackBufferIndex(unsigned int bufferCount) const
+{
+	return static_cast<unsigned int>(m_numPresents.load() % bufferCount);
+}
+
+NullDevice::Stats NullDevice::GetStats() const
+{
+	Stats stats = {};
+	stats.numResources = m_counters->numResources;
+	stats.numCreatedResources = m_counters->numCreatedResources;
+	stats.resourceBytes = m_counters->resourceBytes;
+	stats.peakResourceBytes = m_counters->peakResourceBytes;
+	stats.numDescriptorHeaps = m_numDescriptorHeaps;
+	stats.numViews = m_numViews;
+	stats.numRootSignatures = m_numRootSignatures;
+	stats.numPipelineStates = m_numPipelineStates;
+	stats.numQueryHeaps = m_numQueryHeaps;
+	stats.numCommandLists = m_numCommandLists;
+	stats.numRecordedCommands = m_numRecordedCommands;
+	stats.numExecutedCommandLists = m_numExecutedCommandLists;
+	stats.numSignals = m_numSignals;
+	stats.numPresents = m_numPresents;
+
+	return stats;
+}
\ No newline at end of file
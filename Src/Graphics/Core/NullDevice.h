@@ -0,0 +1,159 @@
+#pragma once
+#include "Includes/CppIncludes.h"
+
+// device used when engine runs headless, without GPU, window or swap chain. It accepts creation of every object
+// and recording of every command, but only keeps their sizes and counts, so CPU cost of whole frame can be measured in benchmarks.
+// Buffers and textures with CPU access get system memory, so mapping and writing them works like on real device.
+// It doesn't know about any graphics API, NullRenderDevice translates engine's descriptions into its types
+class NullDevice
+{
+private:
+	// shared with resources, since static resource lists can outlive graphics
+	struct Counters
+	{
+		std::atomic<size_t> numResources = 0;
+		std::atomic<size_t> numCreatedResources = 0;
+		std::atomic<size_t> resourceBytes = 0;
+		std::atomic<size_t> peakResourceBytes = 0;
+	};
+
+public:
+	static constexpr size_t placementAlignment = 65536;
+	static constexpr size_t pitchAlignment = 256;
+	static constexpr unsigned int descriptorHandleIncrementSize = 32;
+
+	struct Stats
+	{
+		size_t numResources = 0; // alive at the moment
+		size_t numCreatedResources = 0;
+		size_t resourceBytes = 0;
+		size_t peakResourceBytes = 0;
+		size_t numDescriptorHeaps = 0;
+		size_t numViews = 0;
+		size_t numRootSignatures = 0;
+		size_t numPipelineStates = 0;
+		size_t numQueryHeaps = 0;
+		size_t numCommandLists = 0;
+		size_t numRecordedCommands = 0;
+		size_t numExecutedCommandLists = 0;
+		size_t numSignals = 0;
+		size_t numPresents = 0;
+	};
+
+	struct ResourceDesc
+	{
+		enum class Dimension
+		{
+			buffer,
+			texture
+		};
+
+		Dimension dimension = Dimension::buffer;
+		uint64_t width = 0; // bytes for buffers
+		unsigned int height = 1;
+		unsigned int depthOrArraySize = 1;
+		unsigned int mipLevels = 1;
+		unsigned int bitsPerTexel = 0;
+		bool blockCompressed = false; // texels are stored in 4x4 blocks
+	};
+
+	// layout of one subresource in upload buffer
+	struct Footprint
+	{
+		unsigned int width = 0;
+		unsigned int height = 0;
+		size_t rowPitch = 0;
+		size_t numRows = 0;
+		size_t rowSize = 0;
+		size_t totalBytes = 0;
+	};
+
+	struct AllocationInfo
+	{
+		size_t sizeInBytes = 0;
+		size_t alignment = 0;
+	};
+
+	class Resource
+	{
+	public:
+		Resource(std::shared_ptr<Counters> counters, const ResourceDesc& desc, size_t byteSize, uint64_t gpuAddress, bool cpuAccess);
+		~Resource();
+
+		Resource(const Resource&) = delete;
+
+	public:
+		const ResourceDesc& GetDesc() const;
+		uint64_t GetGPUVirtualAddress() const;
+		size_t GetByteSize() const;
+
+		// nullptr for resources without CPU access
+		void* Map();
+
+		// rows are written one after another, since null resources don't have any tiling
+		void WriteToSubresource(const void* data, size_t rowSize, size_t numRows, size_t rowPitch);
+
+	private:
+		std::shared_ptr<Counters> m_counters;
+		ResourceDesc m_desc;
+		size_t m_byteSize;
+		uint64_t m_gpuAddress;
+		std::vector<unsigned char> m_memory;
+	};
+
+	struct DescriptorHeap
+	{
+		size_t cpuStart = 0;
+		uint64_t gpuStart = 0; // zero unless heap is shader visible
+	};
+
+public:
+	NullDevice();
+
+public:
+	std::unique_ptr<Resource> CreateResource(const ResourceDesc& desc, bool cpuAccess);
+
+	// handles are unique fake addresses, they can be offset like real ones but can't be dereferenced
+	DescriptorHeap CreateDescriptorHeap(unsigned int numDescriptors, bool shaderVisible);
+
+	void CreateView();
+	void CreateRootSignature();
+	void CreatePipelineState();
+	void CreateQueryHeap();
+	void CreateCommandList();
+
+	void RecordCommand();
+
+	// null queue finishes work as soon as it gets it, so signaled fence values are completed right away
+	void ExecuteCommandLists(unsigned int numCommandLists);
+	void Signal();
+	void Present();
+
+public:
+	AllocationInfo GetResourceAllocationInfo(const ResourceDesc& desc) const;
+
+	// rows are aligned the same way as on real device
+	Footprint GetCopyableFootprint(const ResourceDesc& desc, unsigned int subresource) const;
+
+	// swap chain index of the back buffer that will be drawn next
+	unsigned int GetCurrentBackBufferIndex(unsigned int bufferCount) const;
+
+	Stats GetStats() const;
+
+private:
+	std::shared_ptr<Counters> m_counters;
+
+	std::atomic<uint64_t> m_nextGPUAddress;
+	std::atomic<size_t> m_nextDescriptorAddress;
+
+	std::atomic<size_t> m_numDescriptorHeaps = 0;
+	std::atomic<size_t> m_numViews = 0;
+	std::atomic<size_t> m_numRootSignatures = 0;
+	std::atomic<size_t> m_numPipelineStates = 0;
+	std::atomic<size_t> m_numQueryHeaps = 0;
+	std::atomic<size_t> m_numCommandLists = 0;
+	std::atomic<size_t> m_numRecordedCommands = 0;
+	std::atomic<size_t> m_numExecutedCommandLists = 0;
+	std::atomic<size_t> m_numSignals = 0;
+	std::atomic<size_t> m_numPresents = 0;
+};
\ No newline at end of file
@@ -0,0 +1,294 @@
+#include "NullRenderDevice.h"
+#include "Macros/ErrorMacros.h"
+
+#include "NullCommandRecorder.h"
+
+#include <DirectXTex.h>
+
+namespace
+{
+	class NullDeviceResource : public DeviceResource
+	{
+	public:
+		NullDeviceResource(std::unique_ptr<NullDevice::Resource> pResource, const D3D12_RESOURCE_DESC& resourceDesc)
+			:
+			m_pResource(std::move(pResource)),
+			m_resourceDesc(resourceDesc)
+		{
+
+		}
+
+	public:
+		ID3D12Resource* GetNative() const override
+		{
+			return nullptr;
+		}
+
+		D3D12_RESOURCE_DESC GetDesc() const override
+		{
+			return m_resourceDesc;
+		}
+
+		D3D12_GPU_VIRTUAL_ADDRESS GetGPUAddress() const override
+		{
+			return m_pResource->GetGPUVirtualAddress();
+		}
+
+		void* Map(Graphics& graphics, const D3D12_RANGE* readRange) override
+		{
+			return m_pResource->Map();
+		}
+
+		void Unmap(const D3D12_RANGE* writtenRange) override
+		{
+
+		}
+
+		void WriteToSubresource(Graphics& graphics, const void* data, unsigned int rowPitch, unsigned int numRows) override
+		{
+			m_pResource->WriteToSubresource(data, rowPitch, numRows, rowPitch);
+		}
+
+	private:
+		std::unique_ptr<NullDevice::Resource> m_pResource;
+		D3D12_RESOURCE_DESC m_resourceDesc;
+	};
+
+	// null queue completes work right away, so there is nothing to wait for
+	class NullDeviceFence : public DeviceFence
+	{
+	public:
+		NullDeviceFence(NullDevice& nullDevice)
+			:
+			m_nullDevice(nullDevice)
+		{
+
+		}
+
+	public:
+		ID3D12Fence* GetNative() const override
+		{
+			return nullptr;
+		}
+
+		void Signal(Graphics& graphics, size_t value) override
+		{
+			m_nullDevice.Signal();
+		}
+
+		void WaitForValue(Graphics& graphics, size_t value) override
+		{
+
+		}
+
+	private:
+		NullDevice& m_nullDevice;
+	};
+}
+
+std::unique_ptr<DeviceResource> NullRenderDevice::CreateCommittedResource(Graphics& graphics, const D3D12_HEAP_PROPERTIES& heapProperties, const D3D12_RESOURCE_DESC& resourceDesc, const D3D12_CLEAR_VALUE* clearValue, bool cpuAccess)
+{
+	return std::make_unique<NullDeviceResource>(m_nullDevice.CreateResource(TranslateResourceDesc(resourceDesc), cpuAccess), resourceDesc);
+}
+
+std::unique_ptr<DeviceResource> NullRenderDevice::CreatePlacedResource(Graphics& graphics, ID3D12Heap* pHeap, size_t heapOffset, const D3D12_RESOURCE_DESC& resourceDesc, const D3D12_CLEAR_VALUE* clearValue)
+{
+	return std::make_unique<NullDeviceResource>(m_nullDevice.CreateResource(TranslateResourceDesc(resourceDesc), false), resourceDesc);
+}
+
+Microsoft::WRL::ComPtr<ID3D12Heap> NullRenderDevice::CreateHeap(Graphics& graphics, const D3D12_HEAP_DESC& heapDesc)
+{
+	return nullptr;
+}
+
+ResourceFootprint NullRenderDevice::GetCopyableFootprint(Graphics& graphics, const D3D12_RESOURCE_DESC& resourceDesc, unsigned int subresource)
+{
+	NullDevice::Footprint nullFootprint = m_nullDevice.GetCopyableFootprint(TranslateResourceDesc(resourceDesc), subresource);
+
+	ResourceFootprint footprint = {};
+	footprint.layout.Offset = 0;
+	footprint.layout.Footprint.Format = resourceDesc.Format;
+	footprint.layout.Footprint.Width = nullFootprint.width;
+	footprint.layout.Footprint.Height = nullFootprint.height;
+	footprint.layout.Footprint.Depth = 1;
+	footprint.layout.Footprint.RowPitch = UINT(nullFootprint.rowPitch);
+	footprint.numRows = UINT(nullFootprint.numRows);
+	footprint.rowSizeInBytes = nullFootprint.rowSize;
+	footprint.totalBytes = nullFootprint.totalBytes;
+
+	return footprint;
+}
+
+D3D12_RESOURCE_ALLOCATION_INFO NullRenderDevice::GetResourceAllocationInfo(const D3D12_RESOURCE_DESC& resourceDesc)
+{
+	NullDevice::AllocationInfo nullAllocationInfo = m_nullDevice.GetResourceAllocationInfo(TranslateResourceDesc(resourceDesc));
+
+	D3D12_RESOURCE_ALLOCATION_INFO allocationInfo = {};
+	allocationInfo.SizeInBytes = nullAllocationInfo.sizeInBytes;
+	allocationInfo.Alignment = nullAllocationInfo.alignment;
+
+	return allocationInfo;
+}
+
+unsigned int NullRenderDevice::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE type)
+{
+	return NullDevice::descriptorHandleIncrementSize;
+}
+
+RenderDevice::DescriptorHeapAllocation NullRenderDevice::CreateDescriptorHeap(Graphics& graphics, const D3D12_DESCRIPTOR_HEAP_DESC& descriptorHeapDesc)
+{
+	NullDevice::DescriptorHeap nullDescriptorHeap = m_nullDevice.CreateDescriptorHeap(descriptorHeapDesc.NumDescriptors, (descriptorHeapDesc.Flags & D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE) != 0);
+
+	DescriptorHeapAllocation allocation = {};
+	allocation.cpuStart.ptr = SIZE_T(nullDescriptorHeap.cpuStart);
+	allocation.gpuStart.ptr = UINT64(nullDescriptorHeap.gpuStart);
+
+	return allocation;
+}
+
+void NullRenderDevice::CopyDescriptorsSimple(Graphics& graphics, unsigned int numDescriptors, D3D12_CPU_DESCRIPTOR_HANDLE destination, D3D12_CPU_DESCRIPTOR_HANDLE source, D3D12_DESCRIPTOR_HEAP_TYPE type)
+{
+
+}
+
+void NullRenderDevice::CreateShaderResourceView(Graphics& graphics, ID3D12Resource* pResource, const D3D12_SHADER_RESOURCE_VIEW_DESC& viewDesc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor)
+{
+	m_nullDevice.CreateView();
+}
+
+void NullRenderDevice::CreateUnorderedAccessView(Graphics& graphics, ID3D12Resource* pResource, const D3D12_UNORDERED_ACCESS_VIEW_DESC& viewDesc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor)
+{
+	m_nullDevice.CreateView();
+}
+
+void NullRenderDevice::CreateRenderTargetView(Graphics& graphics, ID3D12Resource* pResource, const D3D12_RENDER_TARGET_VIEW_DESC& viewDesc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor)
+{
+	m_nullDevice.CreateView();
+}
+
+void NullRenderDevice::CreateDepthStencilView(Graphics& graphics, ID3D12Resource* pResource, const D3D12_DEPTH_STENCIL_VIEW_DESC& viewDesc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor)
+{
+	m_nullDevice.CreateView();
+}
+
+Microsoft::WRL::ComPtr<ID3D12RootSignature> NullRenderDevice::CreateRootSignature(Graphics& graphics, ID3DBlob* pRootSignatureBlob)
+{
+	m_nullDevice.CreateRootSignature();
+
+	return nullptr;
+}
+
+Microsoft::WRL::ComPtr<ID3D12PipelineState> NullRenderDevice::CreateGraphicsPipelineState(Graphics& graphics, const D3D12_GRAPHICS_PIPELINE_STATE_DESC* pipelineStateDesc)
+{
+	m_nullDevice.CreatePipelineState();
+
+	return nullptr;
+}
+
+Microsoft::WRL::ComPtr<ID3D12PipelineState> NullRenderDevice::CreateComputePipelineState(Graphics& graphics, const D3D12_COMPUTE_PIPELINE_STATE_DESC* pipelineStateDesc)
+{
+	m_nullDevice.CreatePipelineState();
+
+	return nullptr;
+}
+
+Microsoft::WRL::ComPtr<ID3D12QueryHeap> NullRenderDevice::CreateQueryHeap(Graphics& graphics, const D3D12_QUERY_HEAP_DESC& queryHeapDesc)
+{
+	m_nullDevice.CreateQueryHeap();
+
+	return nullptr;
+}
+
+std::unique_ptr<CommandRecorder> NullRenderDevice::CreateCommandRecorder(Graphics& graphics, D3D12_COMMAND_LIST_TYPE type, unsigned int numAllocators, ID3D12PipelineState* pInitialState)
+{
+	m_nullDevice.CreateCommandList();
+
+	return std::make_unique<NullCommandRecorder>(m_nullDevice);
+}
+
+void NullRenderDevice::ExecuteCommandLists(Graphics& graphics, std::span<CommandRecorder* const> commandRecorders)
+{
+	m_nullDevice.ExecuteCommandLists(unsigned int(commandRecorders.size()));
+}
+
+std::unique_ptr<DeviceFence> NullRenderDevice::CreateFence(Graphics& graphics)
+{
+	return std::make_unique<NullDeviceFence>(m_nullDevice);
+}
+
+void NullRenderDevice::QueueWait(Graphics& graphics, DeviceFence* fence, size_t value)
+{
+
+}
+
+bool NullRenderDevice::IsRemoved()
+{
+	return false;
+}
+
+std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> NullRenderDevice::GetSwapChainBuffers(Graphics& graphics, unsigned int bufferCount)
+{
+	// null swap chain doesn't own any buffers
+	return std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>>(bufferCount);
+}
+
+void NullRenderDevice::Present(Graphics& graphics, unsigned int syncInterval, unsigned int flags)
+{
+	m_nullDevice.Present();
+}
+
+bool NullRenderDevice::SupportsTearing()
+{
+	return false;
+}
+
+unsigned int NullRenderDevice::GetCurrentBackBufferIndex(unsigned int bufferCount)
+{
+	return m_nullDevice.GetCurrentBackBufferIndex(bufferCount);
+}
+
+UINT64 NullRenderDevice::GetTimestampFrequency()
+{
+	return 0;
+}
+
+bool NullRenderDevice::GetClockCalibration(Graphics& graphics, UINT64& gpuTimestamp, UINT64& cpuTimestamp)
+{
+	return false;
+}
+
+ID3D12Device* NullRenderDevice::GetNativeDevice()
+{
+	return nullptr;
+}
+
+ID3D12CommandQueue* NullRenderDevice::GetNativeCommandQueue()
+{
+	return nullptr;
+}
+
+NullDevice::Stats NullRenderDevice::GetStats() const
+{
+	return m_nullDevice.GetStats();
+}
+
+NullDevice::ResourceDesc NullRenderDevice::TranslateResourceDesc(const D3D12_RESOURCE_DESC& resourceDesc)
+{
+	NullDevice::ResourceDesc nullResourceDesc = {};
+	nullResourceDesc.width = resourceDesc.Width;
+
+	if (resourceDesc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+	{
+		nullResourceDesc.dimension = NullDevice::ResourceDesc::Dimension::buffer;
+		return nullResourceDesc;
+	}
+
+	nullResourceDesc.dimension = NullDevice::ResourceDesc::Dimension::texture;
+	nullResourceDesc.height = resourceDesc.Height;
+	nullResourceDesc.depthOrArraySize = resourceDesc.DepthOrArraySize;
+	nullResourceDesc.mipLevels = resourceDesc.MipLevels;
+	nullResourceDesc.bitsPerTexel = unsigned int(DirectX::BitsPerPixel(resourceDesc.Format));
+	nullResourceDesc.blockCompressed = DirectX::IsCompressed(resourceDesc.Format);
+
+	return nullResourceDesc;
+}
\ No newline at end of file
@@ -0,0 +1,727 @@
+#include "OcclusionCuller.h"
+
+#include "Macros/ErrorMacros.h"
+
+namespace
+{
+	DirectX::XMFLOAT3 Subtract(const DirectX::XMFLOAT3& first, const DirectX::XMFLOAT3& second)
+	{
+		return { first.x - second.x, first.y - second.y, first.z - second.z };
+	}
+
+	DirectX::XMFLOAT3 Cross(const DirectX::XMFLOAT3& first, const DirectX::XMFLOAT3& second)
+	{
+		return { first.y * second.z - first.z * second.y, first.z * second.x - first.x * second.z, first.x * second.y - first.y * second.x };
+	}
+
+	float Dot(const DirectX::XMFLOAT3& first, const DirectX::XMFLOAT3& second)
+	{
+		return first.x * second.x + first.y * second.y + first.z * second.z;
+	}
+
+	float GetLength(const DirectX::XMFLOAT3& vector)
+	{
+		return std::sqrt(Dot(vector, vector));
+	}
+
+	DirectX::XMFLOAT3 Normalize(const DirectX::XMFLOAT3& vector)
+	{
+		float length = GetLength(vector);
+
+		return length > 0.0f ? DirectX::XMFLOAT3(vector.x / length, vector.y / length, vector.z / length) : DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+	}
+
+	// twice the area along normal of triangle, following its winding
+	DirectX::XMFLOAT3 GetTriangleCross(const DirectX::XMFLOAT3& v0, const DirectX::XMFLOAT3& v1, const DirectX::XMFLOAT3& v2)
+	{
+		return Cross(Subtract(v1, v0), Subtract(v2, v0));
+	}
+}
+
+OcclusionCuller::OcclusionCuller(unsigned int width, unsigned int height)
+	:
+	m_width(width),
+	m_height(height),
+	m_tilesX((width + tileSize - 1) / tileSize),
+	m_tilesY((height + tileSize - 1) / tileSize)
+{
+	THROW_INTERNAL_ERROR_IF("Width of occlusion buffer has to be multiple of 4", width == 0 || width % 4 != 0);
+	THROW_INTERNAL_ERROR_IF("Occlusion buffer had no height", height == 0);
+
+	m_depth.resize(m_width * m_height, 1.0f);
+	m_tileMaxDepth.resize(m_tilesX * m_tilesY, 1.0f);
+
+	DirectX::XMStoreFloat4x4(&m_viewProjection, DirectX::XMMatrixIdentity());
+}
+
+void OcclusionCuller::BeginFrame(DirectX::XMMATRIX viewProjection)
+{
+	DirectX::XMStoreFloat4x4(&m_viewProjection, viewProjection);
+
+	std::fill(m_depth.begin(), m_depth.end(), 1.0f);
+	std::fill(m_tileMaxDepth.begin(), m_tileMaxDepth.end(), 1.0f);
+
+	m_occluders.clear();
+	m_stats = {};
+}
+
+void OcclusionCuller::AddOccluder(const OccluderMesh* occluderMesh, DirectX::XMMATRIX world)
+{
+	DirectX::XMMATRIX worldViewProjection = world * DirectX::XMLoadFloat4x4(&m_viewProjection);
+
+	ScreenRect rect = GetScreenRect(occluderMesh->boundingBox, worldViewProjection);
+
+	OccluderEntry entry = {};
+	entry.mesh = occluderMesh;
+	DirectX::XMStoreFloat4x4(&entry.worldViewProjection, worldViewProjection);
+
+	// camera inside of occluder's box, it can cover the whole screen
+	if (rect.crossesNearPlane)
+		entry.screenArea = float(m_width * m_height);
+	else
+		entry.screenArea = std::max(std::min(rect.maxX, float(m_width)) - std::max(rect.minX, 0.0f), 0.0f) *
+			std::max(std::min(rect.maxY, float(m_height)) - std::max(rect.minY, 0.0f), 0.0f);
+
+	if (entry.screenArea > 0.0f)
+		m_occluders.push_back(entry);
+}
+
+void OcclusionCuller::RasterizeOccluders()
+{
+	std::sort(m_occluders.begin(), m_occluders.end(),
+		[](const OccluderEntry& first, const OccluderEntry& second)
+		{
+			return first.screenArea > second.screenArea;
+		});
+
+	for (const auto& occluder : m_occluders)
+	{
+		if (m_stats.numOccluders == m_budget.maxOccluders)
+			break;
+
+		unsigned int numTriangles = static_cast<unsigned int>(occluder.mesh->indices.size() / 3);
+
+		// smaller occluder with fewer triangles can still fit
+		if (m_stats.numTriangles + numTriangles > m_budget.maxTriangles)
+			continue;
+
+		RasterizeOccluder(*occluder.mesh, DirectX::XMLoadFloat4x4(&occluder.worldViewProjection));
+
+		m_stats.numOccluders++;
+		m_stats.numTriangles += numTriangles;
+	}
+
+	UpdateTileDepths();
+}
+
+bool OcclusionCuller::IsVisible(const BoundingBox& boundingBox, DirectX::XMMATRIX world)
+{
+	m_stats.numTested++;
+
+	// objects without geometry are left for frustum culling
+	if (boundingBox.min.x > boundingBox.max.x)
+		return true;
+
+	ScreenRect rect = GetScreenRect(boundingBox, world * DirectX::XMLoadFloat4x4(&m_viewProjection));
+
+	if (rect.crossesNearPlane)
+		return true;
+
+	// pixels touched by the box, parts outside of the screen are left for frustum culling
+	int minX = int(std::clamp(std::floor(rect.minX), 0.0f, float(m_width)));
+	int maxX = int(std::clamp(std::ceil(rect.maxX), 0.0f, float(m_width)));
+	int minY = int(std::clamp(std::floor(rect.minY), 0.0f, float(m_height)));
+	int maxY = int(std::clamp(std::ceil(rect.maxY), 0.0f, float(m_height)));
+
+	if (minX >= maxX || minY >= maxY)
+		return true;
+
+	for (int tileY = minY / int(tileSize); tileY <= (maxY - 1) / int(tileSize); tileY++)
+	{
+		for (int tileX = minX / int(tileSize); tileX <= (maxX - 1) / int(tileSize); tileX++)
+		{
+			// every occluder in the tile is closer than the box
+			if (rect.minDepth > m_tileMaxDepth[tileY * m_tilesX + tileX])
+				continue;
+
+			int tileMinY = std::max(minY, tileY * int(tileSize));
+			int tileMaxY = std::min(maxY, (tileY + 1) * int(tileSize));
+			int tileMinX = std::max(minX, tileX * int(tileSize));
+			int tileMaxX = std::min(maxX, (tileX + 1) * int(tileSize));
+
+			for (int y = tileMinY; y < tileMaxY; y++)
+				for (int x = tileMinX; x < tileMaxX; x++)
+					if (m_depth[y * m_width + x] >= rect.minDepth)
+						return true;
+		}
+	}
+
+	m_stats.numOccluded++;
+
+	return false;
+}
+
+void OcclusionCuller::SetBudget(Budget budget)
+{
+	m_budget = budget;
+}
+
+const OcclusionCuller::Stats& OcclusionCuller::GetStats() const
+{
+	return m_stats;
+}
+
+const std::vector<float>& OcclusionCuller::GetDepth() const
+{
+	return m_depth;
+}
+
+unsigned int OcclusionCuller::GetWidth() const
+{
+	return m_width;
+}
+
+unsigned int OcclusionCuller::GetHeight() const
+{
+	return m_height;
+}
+
+std::optional<OccluderMesh> OcclusionCuller::CreateSimplifiedOccluder(std::span<const DirectX::XMFLOAT3> positions, std::span<const unsigned int> indices, unsigned int maxTriangles)
+{
+	// cosine of the largest angle between normals of triangles that are still treated as one plane, about a quarter of a degree
+	static constexpr float planarCosine = 0.99999f;
+	static constexpr float angleTolerance = 0.001f;
+
+	// bounds work spent on one vertex, fans around vertices grow as their neighbours are removed
+	static constexpr size_t maxRingSize = 64;
+	static constexpr size_t maxTargets = 4;
+
+	// vertices at the same position are welded, so seams of texture coordinates don't split planar regions
+	std::vector<unsigned int> welded(positions.size());
+	{
+		std::vector<unsigned int> sortedVertices(positions.size());
+
+		for (unsigned int vertex = 0; vertex < sortedVertices.size(); vertex++)
+			sortedVertices[vertex] = vertex;
+
+		auto getKey = [&](unsigned int vertex) { return std::make_tuple(positions[vertex].x, positions[vertex].y, positions[vertex].z); };
+
+		std::sort(sortedVertices.begin(), sortedVertices.end(), [&](unsigned int first, unsigned int second) { return getKey(first) < getKey(second); });
+
+		for (size_t sortedIndex = 0; sortedIndex < sortedVertices.size(); sortedIndex++)
+		{
+			unsigned int vertex = sortedVertices[sortedIndex];
+
+			bool sameAsPrevious = sortedIndex != 0 && getKey(sortedVertices[sortedIndex - 1]) == getKey(vertex);
+			welded[vertex] = sameAsPrevious ? welded[sortedVertices[sortedIndex - 1]] : vertex;
+		}
+	}
+
+	std::vector<std::array<unsigned int, 3>> triangles;
+	std::vector<bool> triangleAlive;
+	std::vector<std::vector<unsigned int>> vertexTriangles(positions.size());
+
+	for (size_t index = 0; index + 2 < indices.size(); index += 3)
+	{
+		std::array<unsigned int, 3> triangle = { welded[indices[index]], welded[indices[index + 1]], welded[indices[index + 2]] };
+
+		if (triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[0] == triangle[2])
+			continue;
+
+		if (GetLength(GetTriangleCross(positions[triangle[0]], positions[triangle[1]], positions[triangle[2]])) == 0.0f)
+			continue;
+
+		for (unsigned int vertex : triangle)
+			vertexTriangles[vertex].push_back(static_cast<unsigned int>(triangles.size()));
+
+		triangles.push_back(triangle);
+		triangleAlive.push_back(true);
+	}
+
+	size_t numTriangles = triangles.size();
+
+	if (numTriangles == 0)
+		return std::nullopt;
+
+	// every edge (a, b) of triangles around vertex v, in winding order of triangles (v, a, b)
+	struct RingEdge
+	{
+		unsigned int triangle;
+		unsigned int a;
+		unsigned int b;
+	};
+
+	std::vector<RingEdge> ring;
+	std::vector<unsigned int> targets;
+	std::vector<unsigned int> edgeStarts;
+	std::vector<unsigned int> edgeEnds;
+
+	// vertex is removed only when triangles around it lie in one plane, it's then collapsed into neighbour whose fan covers
+	// exactly the same polygon. Proxy never covers more than original mesh, meshes that don't fit this way are left out
+	auto tryRemoveVertex = [&](unsigned int vertex)
+		{
+			std::vector<unsigned int>& aroundVertex = vertexTriangles[vertex];
+			std::erase_if(aroundVertex, [&](unsigned int triangle) { return !triangleAlive[triangle]; });
+
+			if (aroundVertex.size() < 2 || aroundVertex.size() > maxRingSize)
+				return false;
+
+			ring.clear();
+
+			for (unsigned int triangle : aroundVertex)
+			{
+				const auto& corners = triangles[triangle];
+				unsigned int corner = corners[0] == vertex ? 0 : (corners[1] == vertex ? 1 : 2);
+
+				ring.push_back({ triangle, corners[(corner + 1) % 3], corners[(corner + 2) % 3] });
+			}
+
+			const DirectX::XMFLOAT3& center = positions[vertex];
+			DirectX::XMFLOAT3 planeNormal = Normalize(GetTriangleCross(center, positions[ring[0].a], positions[ring[0].b]));
+
+			float angleSum = 0.0f;
+
+			for (const RingEdge& edge : ring)
+			{
+				if (Dot(Normalize(GetTriangleCross(center, positions[edge.a], positions[edge.b])), planeNormal) < planarCosine)
+					return false;
+
+				DirectX::XMFLOAT3 toA = Subtract(positions[edge.a], center);
+				DirectX::XMFLOAT3 toB = Subtract(positions[edge.b], center);
+				angleSum += std::atan2(GetLength(Cross(toA, toB)), Dot(toA, toB));
+			}
+
+			// each neighbour has to start and end one edge, except two ends of open ring on boundary of the mesh
+			edgeStarts.clear();
+			edgeEnds.clear();
+
+			for (const RingEdge& edge : ring)
+			{
+				edgeStarts.push_back(edge.a);
+				edgeEnds.push_back(edge.b);
+			}
+
+			std::sort(edgeStarts.begin(), edgeStarts.end());
+			std::sort(edgeEnds.begin(), edgeEnds.end());
+
+			if (std::adjacent_find(edgeStarts.begin(), edgeStarts.end()) != edgeStarts.end() || std::adjacent_find(edgeEnds.begin(), edgeEnds.end()) != edgeEnds.end())
+				return false;
+
+			targets.clear();
+			std::set_difference(edgeStarts.begin(), edgeStarts.end(), edgeEnds.begin(), edgeEnds.end(), std::back_inserter(targets));
+			std::set_difference(edgeEnds.begin(), edgeEnds.end(), edgeStarts.begin(), edgeStarts.end(), std::back_inserter(targets));
+
+			// closed ring goes once around vertex, boundary vertex can be removed only from straight part of boundary into one of its ends
+			bool closed = targets.empty();
+
+			if ((!closed && targets.size() != 2) || std::abs(angleSum - (closed ? 2.0f : 1.0f) * _pi) > angleTolerance)
+				return false;
+
+			// neighbours with the fewest triangles first, so fans don't pile up on few vertices
+			if (closed)
+			{
+				targets = edgeStarts;
+
+				std::sort(targets.begin(), targets.end(), [&](unsigned int first, unsigned int second) { return vertexTriangles[first].size() < vertexTriangles[second].size(); });
+
+				if (targets.size() > maxTargets)
+					targets.resize(maxTargets);
+			}
+
+			for (unsigned int target : targets)
+			{
+				// fan from target covers the same polygon only when none of its triangles flips or collapses
+				bool validFan = std::all_of(ring.begin(), ring.end(), [&](const RingEdge& edge)
+					{
+						if (edge.a == target || edge.b == target)
+							return true;
+
+						DirectX::XMFLOAT3 cross = GetTriangleCross(positions[target], positions[edge.a], positions[edge.b]);
+						float length = GetLength(cross);
+
+						float longestEdge = std::max(GetLength(Subtract(positions[edge.a], positions[target])), GetLength(Subtract(positions[edge.b], positions[target])));
+
+						return length > 1e-6f * longestEdge * longestEdge && Dot(cross, planeNormal) >= planarCosine * length;
+					});
+
+				if (!validFan)
+					continue;
+
+				for (const RingEdge& edge : ring)
+				{
+					if (edge.a == target || edge.b == target)
+					{
+						triangleAlive[edge.triangle] = false;
+						numTriangles--;
+					}
+					else
+					{
+						triangles[edge.triangle] = { target, edge.a, edge.b };
+						vertexTriangles[target].push_back(edge.triangle);
+					}
+				}
+
+				aroundVertex.clear();
+
+				return true;
+			}
+
+			return false;
+		};
+
+	for (bool removedAny = true; removedAny && numTriangles > maxTriangles;)
+	{
+		removedAny = false;
+
+		for (unsigned int vertex = 0; vertex < positions.size() && numTriangles > maxTriangles; vertex++)
+			removedAny = tryRemoveVertex(vertex) || removedAny;
+	}
+
+	if (numTriangles > maxTriangles)
+		return std::nullopt;
+
+	OccluderMesh occluderMesh;
+
+	std::vector<unsigned int> remap(positions.size(), UINT_MAX);
+
+	for (size_t triangle = 0; triangle < triangles.size(); triangle++)
+	{
+		if (!triangleAlive[triangle])
+			continue;
+
+		for (unsigned int vertex : triangles[triangle])
+		{
+			if (remap[vertex] == UINT_MAX)
+			{
+				remap[vertex] = static_cast<unsigned int>(occluderMesh.positions.size());
+				occluderMesh.positions.push_back(positions[vertex]);
+				occluderMesh.boundingBox.min = { std::min(occluderMesh.boundingBox.min.x, positions[vertex].x), std::min(occluderMesh.boundingBox.min.y, positions[vertex].y), std::min(occluderMesh.boundingBox.min.z, positions[vertex].z) };
+				occluderMesh.boundingBox.max = { std::max(occluderMesh.boundingBox.max.x, positions[vertex].x), std::max(occluderMesh.boundingBox.max.y, positions[vertex].y), std::max(occluderMesh.boundingBox.max.z, positions[vertex].z) };
+			}
+
+			occluderMesh.indices.push_back(remap[vertex]);
+		}
+	}
+
+	return occluderMesh;
+}
+
+OcclusionCuller::BenchmarkResult OcclusionCuller::Benchmark(unsigned int numOccluders, unsigned int numCandidates)
+{
+	using Clock = std::chrono::steady_clock;
+
+	auto getElapsedMs = [](Clock::time_point start)
+		{
+			return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+		};
+
+	// unit cube used by every wall
+	OccluderMesh wallMesh;
+	{
+		wallMesh.boundingBox = BoundingBox(0.5f);
+
+		for (unsigned int corner = 0; corner < 8; corner++)
+			wallMesh.positions.push_back({ corner & 1 ? 0.5f : -0.5f, corner & 2 ? 0.5f : -0.5f, corner & 4 ? 0.5f : -0.5f });
+
+		wallMesh.indices = {
+			0, 2, 1, 1, 2, 3, // -z
+			4, 5, 6, 5, 7, 6, // +z
+			0, 1, 4, 1, 5, 4, // -y
+			2, 6, 3, 3, 6, 7, // +y
+			0, 4, 2, 2, 4, 6, // -x
+			1, 3, 5, 3, 7, 5  // +x
+		};
+	}
+
+	DirectX::XMMATRIX view = DirectX::XMMatrixLookToLH(DirectX::XMVectorZero(), DirectX::XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), DirectX::XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+	DirectX::XMMATRIX projection = DirectX::XMMatrixPerspectiveFovLH(DirectX::XM_PIDIV2, 16.0f / 9.0f, 0.1f, 400.0f);
+
+	OcclusionCuller culler;
+	culler.SetBudget({ numOccluders, numOccluders * 12 });
+
+	BenchmarkResult result = {};
+	result.numCandidates = numCandidates;
+
+	Clock::time_point start = Clock::now();
+
+	culler.BeginFrame(view * projection);
+
+	// rows of walls 8 wide and 4 tall, every next row 5 units further
+	for (unsigned int occluder = 0; occluder < numOccluders; occluder++)
+	{
+		float x = (float(occluder % 8) - 3.5f) * 4.0f;
+		float y = (float(occluder / 8 % 4) - 1.5f) * 3.0f;
+		float z = 15.0f + float(occluder / 32) * 5.0f;
+
+		culler.AddOccluder(&wallMesh, DirectX::XMMatrixScaling(3.8f, 2.8f, 0.5f) * DirectX::XMMatrixTranslation(x, y, z));
+	}
+
+	culler.RasterizeOccluders();
+
+	result.rasterizeMs = getElapsedMs(start);
+	result.numOccluders = culler.GetStats().numOccluders;
+	result.numTriangles = culler.GetStats().numTriangles;
+
+	// small objects in front of and behind the walls
+	std::vector<DirectX::XMMATRIX> candidateTransforms(numCandidates);
+	{
+		std::mt19937 randomEngine(12345);
+		std::uniform_real_distribution<float> unitDistribution(0.0f, 1.0f);
+
+		for (auto& transform : candidateTransforms)
+		{
+			float z = 2.0f + unitDistribution(randomEngine) * 98.0f;
+			float x = (unitDistribution(randomEngine) * 2.0f - 1.0f) * 20.0f;
+			float y = (unitDistribution(randomEngine) * 2.0f - 1.0f) * 8.0f;
+
+			transform = DirectX::XMMatrixTranslation(x, y, z);
+		}
+	}
+
+	BoundingBox candidateBox(0.25f);
+
+	start = Clock::now();
+
+	for (const auto& transform : candidateTransforms)
+		if (!culler.IsVisible(candidateBox, transform))
+			result.numOccluded++;
+
+	result.testMs = getElapsedMs(start);
+
+	return result;
+}
+
+bool OcclusionCuller::SaveBenchmarkResult(const BenchmarkResult& result, const std::filesystem::path& path)
+{
+	std::ofstream file(path);
+
+	if (!file.is_open())
+		return false;
+
+	file << "{\n";
+	file << "\"occluders\":" << result.numOccluders << ",\n";
+	file << "\"triangles\":" << result.numTriangles << ",\n";
+	file << "\"candidates\":" << result.numCandidates << ",\n";
+	file << "\"occluded\":" << result.numOccluded << ",\n";
+	file << "\"rasterizeMs\":" << result.rasterizeMs << ",\n";
+	file << "\"testMs\":" << result.testMs << "\n";
+	file << "}\n";
+
+	return true;
+}
+
+OcclusionCuller::ScreenRect OcclusionCuller::GetScreenRect(const BoundingBox& boundingBox, DirectX::XMMATRIX worldViewProjection) const
+{
+	ScreenRect rect = {};
+	rect.minX = FLT_MAX;
+	rect.minY = FLT_MAX;
+	rect.maxX = -FLT_MAX;
+	rect.maxY = -FLT_MAX;
+	rect.minDepth = FLT_MAX;
+
+	for (unsigned int corner = 0; corner < 8; corner++)
+	{
+		DirectX::XMVECTOR position = DirectX::XMVectorSet(
+			corner & 1 ? boundingBox.max.x : boundingBox.min.x,
+			corner & 2 ? boundingBox.max.y : boundingBox.min.y,
+			corner & 4 ? boundingBox.max.z : boundingBox.min.z,
+			1.0f
+		);
+
+		DirectX::XMFLOAT4 clipPosition;
+		DirectX::XMStoreFloat4(&clipPosition, DirectX::XMVector4Transform(position, worldViewProjection));
+
+		// corner in front of near plane can't be projected
+		if (clipPosition.z < 0.0f)
+		{
+			rect.crossesNearPlane = true;
+			return rect;
+		}
+
+		DirectX::XMFLOAT3 screenPosition = ToScreen(clipPosition);
+
+		rect.minX = std::min(rect.minX, screenPosition.x);
+		rect.minY = std::min(rect.minY, screenPosition.y);
+		rect.maxX = std::max(rect.maxX, screenPosition.x);
+		rect.maxY = std::max(rect.maxY, screenPosition.y);
+		rect.minDepth = std::min(rect.minDepth, screenPosition.z);
+	}
+
+	return rect;
+}
+
+void OcclusionCuller::RasterizeOccluder(const OccluderMesh& occluderMesh, DirectX::XMMATRIX worldViewProjection)
+{
+	for (size_t index = 0; index + 2 < occluderMesh.indices.size(); index += 3)
+	{
+		DirectX::XMFLOAT4 clipVertices[3];
+
+		for (unsigned int vertex = 0; vertex < 3; vertex++)
+		{
+			DirectX::XMVECTOR position = DirectX::XMLoadFloat3(&occluderMesh.positions[occluderMesh.indices[index + vertex]]);
+			DirectX::XMStoreFloat4(&clipVertices[vertex], DirectX::XMVector3Transform(position, worldViewProjection));
+		}
+
+		RasterizeClippedTriangle(clipVertices);
+	}
+}
+
+void OcclusionCuller::RasterizeClippedTriangle(const DirectX::XMFLOAT4 (&clipVertices)[3])
+{
+	bool allInFront = clipVertices[0].z >= 0.0f && clipVertices[1].z >= 0.0f && clipVertices[2].z >= 0.0f;
+
+	if (allInFront)
+	{
+		RasterizeTriangle(ToScreen(clipVertices[0]), ToScreen(clipVertices[1]), ToScreen(clipVertices[2]));
+		return;
+	}
+
+	// cutting triangle with near plane, at most one corner is added
+	DirectX::XMFLOAT3 polygon[4];
+	unsigned int numVertices = 0;
+
+	for (unsigned int vertex = 0; vertex < 3; vertex++)
+	{
+		const DirectX::XMFLOAT4& current = clipVertices[vertex];
+		const DirectX::XMFLOAT4& next = clipVertices[(vertex + 1) % 3];
+
+		if (current.z >= 0.0f)
+			polygon[numVertices++] = ToScreen(current);
+
+		if ((current.z >= 0.0f) != (next.z >= 0.0f))
+		{
+			float t = current.z / (current.z - next.z);
+
+			DirectX::XMFLOAT4 intersection = {
+				current.x + (next.x - current.x) * t,
+				current.y + (next.y - current.y) * t,
+				0.0f,
+				current.w + (next.w - current.w) * t
+			};
+
+			polygon[numVertices++] = ToScreen(intersection);
+		}
+	}
+
+	for (unsigned int vertex = 2; vertex < numVertices; vertex++)
+		RasterizeTriangle(polygon[0], polygon[vertex - 1], polygon[vertex]);
+}
+
+void OcclusionCuller::RasterizeTriangle(DirectX::XMFLOAT3 v0, DirectX::XMFLOAT3 v1, DirectX::XMFLOAT3 v2)
+{
+	float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+
+	if (area == 0.0f)
+		return;
+
+	// occluders are rasterized from both sides, so winding is made the same for every triangle
+	if (area < 0.0f)
+	{
+		std::swap(v1, v2);
+		area = -area;
+	}
+
+	float boundsMinX = std::clamp(std::min({ v0.x, v1.x, v2.x }), 0.0f, float(m_width));
+	float boundsMaxX = std::clamp(std::max({ v0.x, v1.x, v2.x }), 0.0f, float(m_width));
+	float boundsMinY = std::clamp(std::min({ v0.y, v1.y, v2.y }), 0.0f, float(m_height));
+	float boundsMaxY = std::clamp(std::max({ v0.y, v1.y, v2.y }), 0.0f, float(m_height));
+
+	// rows are processed in groups of four pixels aligned in the buffer
+	int minX = int(boundsMinX) & ~3;
+	int maxX = int(std::ceil(boundsMaxX));
+	int minY = int(boundsMinY);
+	int maxY = int(std::ceil(boundsMaxY));
+
+	if (minX >= maxX || minY >= maxY)
+		return;
+
+	// edge functions a * x + b * y + c, positive inside of the triangle. Each is opposite to one of vertices
+	auto getEdge = [](DirectX::XMFLOAT3 start, DirectX::XMFLOAT3 end)
+		{
+			return DirectX::XMFLOAT3(start.y - end.y, end.x - start.x, start.x * end.y - start.y * end.x);
+		};
+
+	DirectX::XMFLOAT3 edges[3] = { getEdge(v1, v2), getEdge(v2, v0), getEdge(v0, v1) };
+
+	// depth is linear in screen space, its plane is made of edge functions weighted by vertex depths
+	DirectX::XMFLOAT3 depthPlane = {
+		(edges[0].x * v0.z + edges[1].x * v1.z + edges[2].x * v2.z) / area,
+		(edges[0].y * v0.z + edges[1].y * v1.z + edges[2].y * v2.z) / area,
+		(edges[0].z * v0.z + edges[1].z * v1.z + edges[2].z * v2.z) / area
+	};
+
+	DirectX::XMVECTOR edgeA[3];
+	for (unsigned int edge = 0; edge < 3; edge++)
+		edgeA[edge] = DirectX::XMVectorReplicate(edges[edge].x);
+
+	DirectX::XMVECTOR depthA = DirectX::XMVectorReplicate(depthPlane.x);
+	DirectX::XMVECTOR zero = DirectX::XMVectorZero();
+	DirectX::XMVECTOR rowStartX = DirectX::XMVectorAdd(DirectX::XMVectorReplicate(float(minX)), DirectX::XMVectorSet(0.5f, 1.5f, 2.5f, 3.5f));
+	DirectX::XMVECTOR step = DirectX::XMVectorReplicate(4.0f);
+
+	for (int y = minY; y < maxY; y++)
+	{
+		float pixelY = float(y) + 0.5f;
+
+		DirectX::XMVECTOR edgeRow[3];
+		for (unsigned int edge = 0; edge < 3; edge++)
+			edgeRow[edge] = DirectX::XMVectorReplicate(edges[edge].y * pixelY + edges[edge].z);
+
+		DirectX::XMVECTOR depthRow = DirectX::XMVectorReplicate(depthPlane.y * pixelY + depthPlane.z);
+		DirectX::XMVECTOR pixelX = rowStartX;
+
+		float* rowDepth = &m_depth[y * m_width];
+
+		for (int x = minX; x < maxX; x += 4, pixelX = DirectX::XMVectorAdd(pixelX, step))
+		{
+			DirectX::XMVECTOR inside = DirectX::XMVectorAndInt(
+				DirectX::XMVectorAndInt(
+					DirectX::XMVectorGreaterOrEqual(DirectX::XMVectorMultiplyAdd(edgeA[0], pixelX, edgeRow[0]), zero),
+					DirectX::XMVectorGreaterOrEqual(DirectX::XMVectorMultiplyAdd(edgeA[1], pixelX, edgeRow[1]), zero)
+				),
+				DirectX::XMVectorGreaterOrEqual(DirectX::XMVectorMultiplyAdd(edgeA[2], pixelX, edgeRow[2]), zero)
+			);
+
+			if (DirectX::XMVector4EqualInt(inside, zero))
+				continue;
+
+			DirectX::XMVECTOR depth = DirectX::XMVectorMultiplyAdd(depthA, pixelX, depthRow);
+
+			DirectX::XMFLOAT4* pixels = reinterpret_cast<DirectX::XMFLOAT4*>(&rowDepth[x]);
+			DirectX::XMVECTOR previousDepth = DirectX::XMLoadFloat4(pixels);
+
+			DirectX::XMStoreFloat4(pixels, DirectX::XMVectorSelect(previousDepth, DirectX::XMVectorMin(previousDepth, depth), inside));
+		}
+	}
+}
+
+void OcclusionCuller::UpdateTileDepths()
+{
+	for (unsigned int tileY = 0; tileY < m_tilesY; tileY++)
+	{
+		for (unsigned int tileX = 0; tileX < m_tilesX; tileX++)
+		{
+			unsigned int tileMaxY = std::min((tileY + 1) * tileSize, m_height);
+			unsigned int tileMaxX = std::min((tileX + 1) * tileSize, m_width);
+
+			float maxDepth = 0.0f;
+
+			for (unsigned int y = tileY * tileSize; y < tileMaxY; y++)
+				for (unsigned int x = tileX * tileSize; x < tileMaxX; x++)
+					maxDepth = std::max(maxDepth, m_depth[y * m_width + x]);
+
+			m_tileMaxDepth[tileY * m_tilesX + tileX] = maxDepth;
+		}
+	}
+}
+
+DirectX::XMFLOAT3 OcclusionCuller::ToScreen(DirectX::XMFLOAT4 clipPosition) const
+{
+	float inverseW = 1.0f / clipPosition.w;
+
+	return {
+		(clipPosition.x * inverseW * 0.5f + 0.5f) * float(m_width),
+		(0.5f - clipPosition.y * inverseW * 0.5f) * float(m_height),
+		clipPosition.z * inverseW
+	};
+}
\ No newline at end of file
@@ -0,0 +1,134 @@
+#pragma once
+#include "Includes/CppIncludes.h"
+#include "Includes/DirectXIncludes.h"
+
+#include "OcclusionPrimitives.h"
+
+// simplified triangles of a mesh kept on CPU, so it can hide other objects in software depth buffer
+struct OccluderMesh
+{
+	std::vector<DirectX::XMFLOAT3> positions;
+	std::vector<unsigned int> indices;
+	BoundingBox boundingBox;
+};
+
+// software rasterized depth buffer used to hide objects that are inside of camera frustum but behind large meshes.
+// Biggest occluders on screen are rasterized into low resolution buffer four pixels at the time,
+// then bounding boxes of objects are tested against max depth of 8x8 tiles and pixels of tiles that weren't conclusive.
+// It doesn't touch any graphics objects, depth follows D3D convention where 0 is near plane
+class OcclusionCuller
+{
+public:
+	// meshes with more triangles are too expensive to be rasterized every frame, they are replaced by simplified proxy
+	static constexpr unsigned int maxOccluderTriangles = 2048;
+
+	struct Budget
+	{
+		unsigned int maxOccluders = 32;
+		unsigned int maxTriangles = 16384;
+	};
+
+	struct Stats
+	{
+		unsigned int numOccluders = 0;
+		unsigned int numTriangles = 0;
+		unsigned int numTested = 0;
+		unsigned int numOccluded = 0;
+	};
+
+	struct BenchmarkResult
+	{
+		unsigned int numOccluders = 0;
+		unsigned int numTriangles = 0;
+		unsigned int numCandidates = 0;
+		unsigned int numOccluded = 0;
+		float rasterizeMs = 0.0f;
+		float testMs = 0.0f;
+	};
+
+public:
+	OcclusionCuller(unsigned int width = 256, unsigned int height = 144);
+
+public:
+	// clears depth and forgets occluders of previous frame
+	void BeginFrame(DirectX::XMMATRIX viewProjection);
+
+	// occluders are only gathered here, the ones that cover the most of the screen are rasterized in RasterizeOccluders()
+	void AddOccluder(const OccluderMesh* occluderMesh, DirectX::XMMATRIX world);
+
+	void RasterizeOccluders();
+
+	// true when any part of the box can be seen, boxes crossing near plane are always visible
+	bool IsVisible(const BoundingBox& boundingBox, DirectX::XMMATRIX world);
+
+	void SetBudget(Budget budget);
+
+	const Stats& GetStats() const;
+
+	const std::vector<float>& GetDepth() const;
+
+	unsigned int GetWidth() const;
+	unsigned int GetHeight() const;
+
+public:
+	// removes vertices whose triangles lie in one plane by collapsing them into a neighbour, whose new fan covers the same polygon.
+	// Proxy never covers more than the mesh, so openings like doors and windows stay open. std::nullopt when mesh has too few
+	// flat regions to get under maxTriangles, such meshes are better left out of occluders than approximated
+	static std::optional<OccluderMesh> CreateSimplifiedOccluder(std::span<const DirectX::XMFLOAT3> positions, std::span<const unsigned int> indices, unsigned int maxTriangles = maxOccluderTriangles);
+
+public:
+	// rasterizes walls of a synthetic corridor and tests boxes scattered behind and in front of them
+	static BenchmarkResult Benchmark(unsigned int numOccluders, unsigned int numCandidates);
+
+	// false when file couldn't be opened
+	static bool SaveBenchmarkResult(const BenchmarkResult& result, const std::filesystem::path& path);
+
+private:
+	struct ScreenRect
+	{
+		float minX = 0.0f;
+		float minY = 0.0f;
+		float maxX = 0.0f;
+		float maxY = 0.0f;
+		float minDepth = 0.0f;
+		bool crossesNearPlane = false;
+	};
+
+	ScreenRect GetScreenRect(const BoundingBox& boundingBox, DirectX::XMMATRIX worldViewProjection) const;
+
+	void RasterizeOccluder(const OccluderMesh& occluderMesh, DirectX::XMMATRIX worldViewProjection);
+
+	// vertices are in clip space, the part in front of near plane is rasterized
+	void RasterizeClippedTriangle(const DirectX::XMFLOAT4 (&clipVertices)[3]);
+
+	// vertices are in screen space with depth in z
+	void RasterizeTriangle(DirectX::XMFLOAT3 v0, DirectX::XMFLOAT3 v1, DirectX::XMFLOAT3 v2);
+
+	void UpdateTileDepths();
+
+	DirectX::XMFLOAT3 ToScreen(DirectX::XMFLOAT4 clipPosition) const;
+
+private:
+	static constexpr unsigned int tileSize = 8;
+
+	struct OccluderEntry
+	{
+		const OccluderMesh* mesh = nullptr;
+		DirectX::XMFLOAT4X4 worldViewProjection;
+		float screenArea = 0.0f;
+	};
+
+	unsigned int m_width;
+	unsigned int m_height;
+	unsigned int m_tilesX;
+	unsigned int m_tilesY;
+
+	std::vector<float> m_depth; // closest occluder depth of every pixel, row major
+	std::vector<float> m_tileMaxDepth; // the farthest depth in each tile
+
+	DirectX::XMFLOAT4X4 m_viewProjection;
+	std::vector<OccluderEntry> m_occluders;
+
+	Budget m_budget = {};
+	Stats m_stats = {};
+};
\ No newline at end of file
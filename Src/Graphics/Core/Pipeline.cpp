@@ -6,6 +6,8 @@
 #include "Graphics/Bindables/ViewPort.h"
 #include "Graphics/Bindables/IndexBuffer.h"
 
+#include "Graphics/Profiler/RenderStats.h"
+
 void Pipeline::Initialize(Graphics& graphics)
 {
 	m_graphicsCommandList = std::make_shared<CommandList>(graphics, D3D12_COMMAND_LIST_TYPE_DIRECT);
@@ -68,13 +70,18 @@ void Pipeline::AddBufferRegionToCopyPipeline(DestinationBufferRegionCopyData dst
 
 void Pipeline::Execute(Graphics& graphics)
 {
-	ID3D12CommandList* pCommandLists[] = {m_graphicsCommandList->Get()};
+	CommandRecorder* commandRecorders[] = { m_graphicsCommandList->GetRecorder() };
+
+	// descriptors created while recording were written only to master heap
+	graphics.GetDescriptorHeap().CommitDescriptors(graphics);
 
-	graphics.GetDeviceResources().GetCommandQueue()->ExecuteCommandLists(_countof(pCommandLists), pCommandLists);
+	graphics.GetDevice().ExecuteCommandLists(graphics, commandRecorders);
 }
 
 void Pipeline::ExecuteCopyCalls(Graphics& graphics)
 {
+	RenderStats::Add(RenderCounter::CopyCalls, m_copyCalls.size());
+
 	for (auto& copyCall : m_copyCalls)
 		copyCall->Execute(graphics, m_graphicsCommandList.get());
 
@@ -376,9 +376,7 @@ GraphicsPipelineState::GraphicsPipelineState(Graphics& graphics, GraphicsPipelin
 	if (!m_params.isFinished())
 		m_params.Finish();
 
-	HRESULT hr;
-
-	THROW_ERROR(graphics.GetDeviceResources().GetDevice()->CreateGraphicsPipelineState(m_params.GetDesc(), IID_PPV_ARGS(&pPipelineState)));
+	pPipelineState = graphics.GetDevice().CreateGraphicsPipelineState(graphics, m_params.GetDesc());
 }
 
 std::shared_ptr<GraphicsPipelineState> GraphicsPipelineState::GetResource(Graphics& graphics, GraphicsPipelineStateParams&& params)
@@ -401,9 +399,7 @@ ComputePipelineState::ComputePipelineState(Graphics& graphics, ComputePipelineSt
 	if (!m_params.isFinished())
 		m_params.Finish();
 
-	HRESULT hr;
-
-	THROW_ERROR(graphics.GetDeviceResources().GetDevice()->CreateComputePipelineState(m_params.GetDesc(), IID_PPV_ARGS(&pPipelineState)));
+	pPipelineState = graphics.GetDevice().CreateComputePipelineState(graphics, m_params.GetDesc());
 }
 
 std::shared_ptr<ComputePipelineState> ComputePipelineState::GetResource(Graphics& graphics, ComputePipelineStateParams&& params)
@@ -1,18 +1,21 @@
 #pragma once
+#include "Graphics/Profiler/ZoneProfiler.h"
 
-#ifdef _DEBUG
+// CPU events are always recorded by ZoneProfiler, PIX gets them only in debug builds on Windows
+#if defined(_DEBUG) && defined(_WIN32)
 	#include <pix3.h>
 	#pragma comment(lib, "WinPixEventRuntime.lib")
 	
-	#define START_CPU_EVENT(color, name) PIXBeginEvent(color, name)
-	#define END_CPU_EVENT() PIXEndEvent()
+	// both calls have to stay one statement, so unbraced if can't split them
+	#define START_CPU_EVENT(color, name) do { PIXBeginEvent(color, name); ZoneProfiler::BeginZone(name); } while (0)
+	#define END_CPU_EVENT() do { ZoneProfiler::EndZone(); PIXEndEvent(); } while (0)
 	
 	#define SET_GPU_MARKER(commandList, color, name) PIXSetMarker(commandList, color, name)
 	#define START_GPU_EVENT(commandList, color, name) PIXBeginEvent(commandList, color, name)
 	#define END_GPU_EVENT(commandList) PIXEndEvent(commandList)
 #else
-	#define START_CPU_EVENT(color, name)
-	#define END_CPU_EVENT()
+	#define START_CPU_EVENT(color, name) do { ZoneProfiler::BeginZone(name); } while (0)
+	#define END_CPU_EVENT() do { ZoneProfiler::EndZone(); } while (0)
 	
 	#define SET_GPU_MARKER(commandList, color, name)
 	#define START_GPU_EVENT(commandList, color, name)
@@ -0,0 +1,126 @@
+#pragma once
+#include "Includes/CppIncludes.h"
+#include "Includes/DirectXIncludes.h"
+#include "Includes/WRLNoWarnings.h"
+
+class Graphics;
+class CommandRecorder;
+
+struct ResourceFootprint
+{
+	D3D12_PLACED_SUBRESOURCE_FOOTPRINT layout = {};
+	UINT numRows = 0;
+	UINT64 rowSizeInBytes = 0;
+	UINT64 totalBytes = 0;
+};
+
+// buffer or texture created by render device
+class DeviceResource
+{
+public:
+	virtual ~DeviceResource() = default;
+
+public:
+	// nullptr when resource doesn't exist on GPU
+	virtual ID3D12Resource* GetNative() const = 0;
+
+	virtual D3D12_RESOURCE_DESC GetDesc() const = 0;
+	virtual D3D12_GPU_VIRTUAL_ADDRESS GetGPUAddress() const = 0;
+
+	virtual void* Map(Graphics& graphics, const D3D12_RANGE* readRange) = 0;
+	virtual void Unmap(const D3D12_RANGE* writtenRange) = 0;
+
+	// writes first subresource, rows of source are rowPitch bytes apart
+	virtual void WriteToSubresource(Graphics& graphics, const void* data, unsigned int rowPitch, unsigned int numRows) = 0;
+};
+
+// fence signaled on the device's queue
+class DeviceFence
+{
+public:
+	virtual ~DeviceFence() = default;
+
+public:
+	// nullptr when fence doesn't exist on GPU
+	virtual ID3D12Fence* GetNative() const = 0;
+
+	virtual void Signal(Graphics& graphics, size_t value) = 0;
+
+	// blocks until GPU reaches the value
+	virtual void WaitForValue(Graphics& graphics, size_t value) = 0;
+};
+
+// everything engine asks from graphics API goes through this interface. D3D12RenderDevice talks to GPU,
+// NullRenderDevice only counts what was asked from it, so engine can run headless in benchmarks and tests.
+// Descriptions are D3D12 structures, since the rest of engine is built around them
+class RenderDevice
+{
+public:
+	struct DescriptorHeapAllocation
+	{
+		Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> pDescriptorHeap; // nullptr on null device
+		D3D12_CPU_DESCRIPTOR_HANDLE cpuStart = {};
+		D3D12_GPU_DESCRIPTOR_HANDLE gpuStart = {};
+	};
+
+public:
+	virtual ~RenderDevice() = default;
+
+public:
+	// resources
+	virtual std::unique_ptr<DeviceResource> CreateCommittedResource(Graphics& graphics, const D3D12_HEAP_PROPERTIES& heapProperties, const D3D12_RESOURCE_DESC& resourceDesc, const D3D12_CLEAR_VALUE* clearValue, bool cpuAccess) = 0;
+	virtual std::unique_ptr<DeviceResource> CreatePlacedResource(Graphics& graphics, ID3D12Heap* pHeap, size_t heapOffset, const D3D12_RESOURCE_DESC& resourceDesc, const D3D12_CLEAR_VALUE* clearValue) = 0;
+
+	// nullptr on null device, placed resources ignore the heap there
+	virtual Microsoft::WRL::ComPtr<ID3D12Heap> CreateHeap(Graphics& graphics, const D3D12_HEAP_DESC& heapDesc) = 0;
+
+	virtual ResourceFootprint GetCopyableFootprint(Graphics& graphics, const D3D12_RESOURCE_DESC& resourceDesc, unsigned int subresource) = 0;
+	virtual D3D12_RESOURCE_ALLOCATION_INFO GetResourceAllocationInfo(const D3D12_RESOURCE_DESC& resourceDesc) = 0;
+
+public:
+	// descriptors
+	virtual unsigned int GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE type) = 0;
+	virtual DescriptorHeapAllocation CreateDescriptorHeap(Graphics& graphics, const D3D12_DESCRIPTOR_HEAP_DESC& descriptorHeapDesc) = 0;
+	virtual void CopyDescriptorsSimple(Graphics& graphics, unsigned int numDescriptors, D3D12_CPU_DESCRIPTOR_HANDLE destination, D3D12_CPU_DESCRIPTOR_HANDLE source, D3D12_DESCRIPTOR_HEAP_TYPE type) = 0;
+
+	virtual void CreateShaderResourceView(Graphics& graphics, ID3D12Resource* pResource, const D3D12_SHADER_RESOURCE_VIEW_DESC& viewDesc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor) = 0;
+	virtual void CreateUnorderedAccessView(Graphics& graphics, ID3D12Resource* pResource, const D3D12_UNORDERED_ACCESS_VIEW_DESC& viewDesc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor) = 0;
+	virtual void CreateRenderTargetView(Graphics& graphics, ID3D12Resource* pResource, const D3D12_RENDER_TARGET_VIEW_DESC& viewDesc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor) = 0;
+	virtual void CreateDepthStencilView(Graphics& graphics, ID3D12Resource* pResource, const D3D12_DEPTH_STENCIL_VIEW_DESC& viewDesc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor) = 0;
+
+public:
+	// pipeline objects, nullptr on null device
+	virtual Microsoft::WRL::ComPtr<ID3D12RootSignature> CreateRootSignature(Graphics& graphics, ID3DBlob* pRootSignatureBlob) = 0;
+	virtual Microsoft::WRL::ComPtr<ID3D12PipelineState> CreateGraphicsPipelineState(Graphics& graphics, const D3D12_GRAPHICS_PIPELINE_STATE_DESC* pipelineStateDesc) = 0;
+	virtual Microsoft::WRL::ComPtr<ID3D12PipelineState> CreateComputePipelineState(Graphics& graphics, const D3D12_COMPUTE_PIPELINE_STATE_DESC* pipelineStateDesc) = 0;
+	virtual Microsoft::WRL::ComPtr<ID3D12QueryHeap> CreateQueryHeap(Graphics& graphics, const D3D12_QUERY_HEAP_DESC& queryHeapDesc) = 0;
+
+public:
+	// submission
+	virtual std::unique_ptr<CommandRecorder> CreateCommandRecorder(Graphics& graphics, D3D12_COMMAND_LIST_TYPE type, unsigned int numAllocators, ID3D12PipelineState* pInitialState) = 0;
+	virtual void ExecuteCommandLists(Graphics& graphics, std::span<CommandRecorder* const> commandRecorders) = 0;
+
+	virtual std::unique_ptr<DeviceFence> CreateFence(Graphics& graphics) = 0;
+
+	// makes queue wait on GPU side until fence reaches the value
+	virtual void QueueWait(Graphics& graphics, DeviceFence* fence, size_t value) = 0;
+
+	virtual bool IsRemoved() = 0;
+
+public:
+	// swap chain
+	virtual std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> GetSwapChainBuffers(Graphics& graphics, unsigned int bufferCount) = 0;
+	virtual void Present(Graphics& graphics, unsigned int syncInterval, unsigned int flags) = 0;
+	virtual bool SupportsTearing() = 0; // whether DXGI_PRESENT_ALLOW_TEARING can be passed to Present
+	virtual unsigned int GetCurrentBackBufferIndex(unsigned int bufferCount) = 0;
+
+public:
+	// timing, null device has no GPU clock and returns zero frequency
+	virtual UINT64 GetTimestampFrequency() = 0;
+	virtual bool GetClockCalibration(Graphics& graphics, UINT64& gpuTimestamp, UINT64& cpuTimestamp) = 0;
+
+public:
+	// for code talking to D3D12 directly, like imgui backend. nullptr on null device
+	virtual ID3D12Device* GetNativeDevice() = 0;
+	virtual ID3D12CommandQueue* GetNativeCommandQueue() = 0;
+};
\ No newline at end of file
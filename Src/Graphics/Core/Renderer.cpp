@@ -60,13 +60,17 @@ void Renderer::Draw(Graphics& graphics, Scene& scene, float deltaTime)
 
 		//scene.InitializeGraphicResources(graphics);
 
+		START_CPU_EVENT(PIX_COLOR(255, 0, 255), "Copy calls");
 		m_pipeline.ExecuteCopyCalls(graphics);
+		END_CPU_EVENT();
 
 		auto* graphicsCommandList = m_pipeline.GetGraphicCommandList();
 
 		graphicsCommandList->SetDescriptorHeap(graphics, &graphics.GetDescriptorHeap());
 
+		START_CPU_EVENT(PIX_COLOR(255, 0, 255), "Recording");
 		m_renderGraph.Execute(graphics, graphicsCommandList, scene);
+		END_CPU_EVENT();
 
 		graphics.GetProfiler().SetEndData(graphics, graphicsCommandList, deltaTime);
 
@@ -81,7 +85,7 @@ void Renderer::Draw(Graphics& graphics, Scene& scene, float deltaTime)
 
 void Renderer::DrawImguiWindow(Graphics& graphics)
 {
-	//m_renderGraph.Update(graphics, m_pipeline);
+	m_renderGraph.DrawImguiWindow(graphics);
 }
 
 void Renderer::SubmitRenderData(GraphicsRenderData renderData)
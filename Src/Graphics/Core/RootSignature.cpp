@@ -140,10 +140,20 @@ void RootSignatureParams::AddDescriptorTableParameter(ShaderResourceViewBase* sr
 }
 
 void RootSignatureParams::AddDescriptorParameter(Buffer* buffer, const const TargetSlotAndShader& target)
+{
+	m_AddDescriptorParameter(buffer, target);
+}
+
+void RootSignatureParams::AddDescriptorParameter(InstanceBuffer* instanceBuffer, const TargetSlotAndShader& target)
+{
+	m_AddDescriptorParameter(instanceBuffer, target);
+}
+
+void RootSignatureParams::m_AddDescriptorParameter(RootSignatureBindable* bindable, const TargetSlotAndShader& target)
 {
 	THROW_INTERNAL_ERROR_IF("RootSignatureParams were already finished", m_finished);
 
-	m_layout.AddParam(buffer, RootBinding(target, m_rootSignatureDesc.NumParameters));
+	m_layout.AddParam(bindable, RootBinding(target, m_rootSignatureDesc.NumParameters));
 
 	m_rootSignatureDesc.NumParameters++;
 
@@ -429,12 +439,8 @@ RootSignature::RootSignature(Graphics& graphics, RootSignatureParams&& params)
 		&pErrorMessages
 	));
 
-	THROW_ERROR(graphics.GetDeviceResources().GetDevice()->CreateRootSignature(
-		0,
-		pRootSignatureBlob->GetBufferPointer(),
-		pRootSignatureBlob->GetBufferSize(),
-		IID_PPV_ARGS(&pRootSignature)
-	));
+	// serialization is kept on null device, since it validates description and is part of CPU cost
+	pRootSignature = graphics.GetDevice().CreateRootSignature(graphics, pRootSignatureBlob.Get());
 }
 
 std::shared_ptr<RootSignature> RootSignature::GetResource(Graphics& graphics, RootSignatureParams&& params)
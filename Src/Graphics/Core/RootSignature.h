@@ -14,6 +14,7 @@ class Buffer;
 class UnorderedAccessView;
 class RootSignatureConstants;
 class StaticSampler;
+class InstanceBuffer;
 
 class RootSignatureParams
 {
@@ -41,6 +42,7 @@ public:
 	void AddDescriptorTableParameter(ShaderResourceViewBase* srv, const TargetSlotAndShader& target);
 
 	void AddDescriptorParameter(Buffer* buffer, const TargetSlotAndShader& target);
+	void AddDescriptorParameter(InstanceBuffer* instanceBuffer, const TargetSlotAndShader& target);
 
 	void AddUnorderedAccessViewParameter(UnorderedAccessView* uav, const TargetSlotAndShader& target);
 
@@ -53,6 +55,7 @@ private:
 
 	void m_AddDescriptorTableParameter(D3D12_DESCRIPTOR_RANGE_TYPE descriptorType, const TargetSlotAndShader& target, unsigned int numDescriptors = 1, D3D12_DESCRIPTOR_RANGE_FLAGS flags = D3D12_DESCRIPTOR_RANGE_FLAG_NONE);
 	void m_AddStaticSampler(StaticSampler* staticSampler, const TargetSlotAndShader& target);
+	void m_AddDescriptorParameter(RootSignatureBindable* bindable, const TargetSlotAndShader& target);
 
 private:
 	void CreateIdentifier();
@@ -9,4 +9,9 @@ void RootSignatureLayout::BindToCommandList(Graphics& graphics, CommandList* com
 {
 	for (const auto& binding : m_bindings)
 		binding.bindable->BindToCommandListAsRootParam(graphics, commandList, binding.binding);
+}
+
+const std::vector<RootSignatureLayout::RootSignatureLayoutBinding>& RootSignatureLayout::GetBindings() const
+{
+	return m_bindings;
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 
 class RootSignatureLayout
 {
+public:
 	struct RootSignatureLayoutBinding
 	{
 		RootSignatureBindable* bindable;
@@ -16,6 +17,8 @@ public:
 
 	void BindToCommandList(Graphics& graphics, CommandList* commandList) const;
 
+	const std::vector<RootSignatureLayoutBinding>& GetBindings() const;
+
 private:
 	std::vector<RootSignatureLayoutBinding> m_bindings = {};
 };
\ No newline at end of file
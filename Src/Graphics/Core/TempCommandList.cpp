@@ -19,7 +19,8 @@ TempComputeCommandList::TempComputeCommandList(const TempComputeCommandList& cop
 	m_bindableContainer(copied.m_bindableContainer),
 	m_commandList(copied.m_commandList),
 	m_rootSignature(copied.m_rootSignature),
-	m_pipelineState(copied.m_pipelineState)
+	m_pipelineState(copied.m_pipelineState),
+	m_rootSignatureLayout(copied.m_rootSignatureLayout)
 {
 	THROW_INTERNAL_ERROR("Called copy constructor for temp compute command list\n");
 }
@@ -39,6 +40,10 @@ void TempComputeCommandList::Dispatch(Graphics& graphics, unsigned int workToPro
 
 	m_commandList->SetDescriptorHeap(graphics, &graphics.GetDescriptorHeap());
 
+	for (const auto& layoutBinding : m_rootSignatureLayout.GetBindings())
+		if (auto* constantBuffer = dynamic_cast<TempConstantBuffer*>(layoutBinding.bindable))
+			m_commandList->SetComputeConstBufferView(graphics, constantBuffer, layoutBinding.binding);
+
 	for (auto commandListBindable : m_bindableContainer.GetCommandListBindables())
 		commandListBindable->BindToComputeCommandList(graphics, m_commandList);
 
@@ -60,6 +65,11 @@ void TempComputeCommandList::Bind(Bindable* bindable)
 	m_bindableContainer.AddBindable(bindable);
 }
 
+void TempComputeCommandList::BindConstants(Graphics& graphics, DynamicConstantBuffer::Data& data, unsigned int slot)
+{
+	m_bindableContainer.AddBindable(std::make_shared<TempConstantBuffer>(graphics, data, ResourceTargets{ {ShaderVisibilityGraphic::AllShaders, slot} }));
+}
+
 void TempComputeCommandList::Finish(Graphics& graphics)
 {
 	unsigned int frameIndex = graphics.GetCurrentBufferIndex();
@@ -71,6 +81,7 @@ void TempComputeCommandList::Finish(Graphics& graphics)
 		for (auto rootSignatureBindable : m_bindableContainer.GetRootSignatureBindables())
 			rootSignatureBindable->AddGraphicsRootSignatureParam(&rootParams);
 
+		m_rootSignatureLayout = rootParams.GetLayout();
 		m_rootSignature = RootSignature::GetResource(graphics, std::move(rootParams));
 	}
 
@@ -2,6 +2,7 @@
 #include "BindableContainer.h"
 #include "RootSignature.h"
 #include "PipelineState.h"
+#include "Graphics/Data/DynamicConstantBuffer.h"
 
 class CommandList;
 
@@ -29,6 +30,9 @@ public:
 	void Bind(std::shared_ptr<Bindable> bindable);
 	void Bind(Bindable* bindable);
 
+	// constants are copied to temp memory of current frame, dispatches don't take persistent constant buffer slots
+	void BindConstants(Graphics& graphics, DynamicConstantBuffer::Data& data, unsigned int slot);
+
 private:
 	void Finish(Graphics& graphics);
 
@@ -38,6 +42,7 @@ private:
 
 	std::shared_ptr<RootSignature> m_rootSignature;
 	std::shared_ptr<ComputePipelineState> m_pipelineState;
+	RootSignatureLayout m_rootSignatureLayout;
 };
 
 class TempGraphicsCommandList
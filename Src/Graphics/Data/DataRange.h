@@ -0,0 +1,14 @@
+#pragma once
+#include "Includes/CppIncludes.h"
+
+// byte range inside of cpu or gpu buffer
+struct DataRange
+{
+	size_t offset;
+	size_t size;
+
+	size_t GetEnd() const
+	{
+		return offset + size;
+	}
+};
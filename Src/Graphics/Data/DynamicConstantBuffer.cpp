@@ -94,6 +94,31 @@ void DynamicConstantBuffer::Layout::AddArray(const char* name, ArrayDataInfo& ar
 	m_size = element.offset + element.size;
 }
 
+void DynamicConstantBuffer::Layout::Add(ElementType elementType, const char* name)
+{
+	switch (elementType)
+	{
+		case ElementType::Uint:
+			return Add<ElementType::Uint>(name);
+		case ElementType::Int:
+			return Add<ElementType::Int>(name);
+		case ElementType::Bool:
+			return Add<ElementType::Bool>(name);
+		case ElementType::Float:
+			return Add<ElementType::Float>(name);
+		case ElementType::Float2:
+			return Add<ElementType::Float2>(name);
+		case ElementType::Float3:
+			return Add<ElementType::Float3>(name);
+		case ElementType::Float4:
+			return Add<ElementType::Float4>(name);
+		case ElementType::Matrix:
+			return Add<ElementType::Matrix>(name);
+		default:
+			THROW_INTERNAL_ERROR("Arrays should be added through AddArray");
+	}
+}
+
 unsigned int DynamicConstantBuffer::Layout::GetSize() const
 {
 	THROW_OBJECT_STATE_ERROR_IF("Layout was unfinished", !m_finished);
@@ -134,39 +159,36 @@ const DynamicConstantBuffer::Layout::Element& DynamicConstantBuffer::Layout::Get
 	THROW_INTERNAL_ERROR(errorStr.c_str());
 }
 
-unsigned int DynamicConstantBuffer::Layout::GetDesiredSize(LayoutType layoutType) const
+DynamicConstantBuffer::Layout::ArrayElementLocation DynamicConstantBuffer::Layout::GetArrayElementLocation(const char* arrayName, const char* name) const
 {
-	switch (layoutType)
-	{
-		case LayoutType::normal:
-			return GetAlignedSize();
-		case LayoutType::partial:
-			return GetPackedSize();
-		case LayoutType::data:
-			return m_size;
-	}
+	const Element& arrayElement = GetElement(arrayName);
+
+	THROW_INTERNAL_ERROR_IF("Element was not Array type", arrayElement.type != ElementType::List);
+
+	const ArrayDataInfo* arrayDataInfo = static_cast<const ArrayDataInfo*>(arrayElement.additionalData.get());
+	const Element& element = arrayDataInfo->layout.GetElement(name);
+
+	return { element.type, arrayElement.offset + element.offset, arrayDataInfo->layout.GetSize(), unsigned int(arrayDataInfo->numElements) };
 }
 
-unsigned int DynamicConstantBuffer::Layout::GetAlignedSize() const
+unsigned int DynamicConstantBuffer::Layout::GetDesiredSize(LayoutType layoutType) const
 {
-	float numPacks = float(m_size) / float(bufferSizeAlignment);
-
-	return (numPacks != std::floor(numPacks)) ? std::ceil(numPacks) * bufferSizeAlignment : m_size;
+	return GetSizeForLayoutType(m_size, layoutType);
 }
 
 unsigned int DynamicConstantBuffer::Layout::GetPackedSize() const
 {
-	float numPacks = float(m_size) / float(alignment);
-
-	return (numPacks != std::floor(numPacks)) ? std::ceil(numPacks) * alignment : m_size;
+	return GetAligned(m_size, alignment);
 }
 
 
-DynamicConstantBuffer::ArrayData::ArrayData(const Layout& layout, char* data, unsigned int numElements)
+DynamicConstantBuffer::ArrayData::ArrayData(const Layout& layout, char* data, unsigned int numElements, Data* owner, unsigned int offsetInOwner)
 	:
 	m_layout(layout),
 	m_data(data),
-	m_numElements(numElements)
+	m_numElements(numElements),
+	m_owner(owner),
+	m_offsetInOwner(offsetInOwner)
 {
 
 }
@@ -181,7 +203,7 @@ bool DynamicConstantBuffer::ArrayData::DrawImguiProperties(bool asArray)
 		};
 
 	for (int i = 0; i < m_numElements; i++)
-		DrawImguiProperties(i, asArray);
+		checkChanged(DrawImguiProperties(i, asArray));
 
 	return changed;
 }
@@ -213,13 +235,24 @@ bool DynamicConstantBuffer::ArrayData::DrawImguiProperties(unsigned int i, bool
 		}
 	}
 
+	// whole entry is marked, imgui can change any of its elements
+	if (changed)
+		MarkDirty(offsetInArray, m_layout.GetSize());
+
 	return changed;
 }
 
+void DynamicConstantBuffer::ArrayData::MarkDirty(unsigned int offset, unsigned int size)
+{
+	if (m_owner)
+		m_owner->MarkDirty(m_offsetInOwner + offset, size);
+}
+
 DynamicConstantBuffer::Data::Data(Data&& data) noexcept
 	:
 	m_data(std::move(data.m_data)),
-	m_layout(std::move(data.m_layout))
+	m_layout(std::move(data.m_layout)),
+	m_dirtyRanges(std::move(data.m_dirtyRanges))
 {
 
 }
@@ -229,6 +262,9 @@ DynamicConstantBuffer::Data::Data(Layout& layout)
 	m_layout(std::move(layout.GetFinished()))
 {
 	m_data.resize(layout.GetSize());
+
+	// fresh data was never uploaded
+	MarkAllDirty();
 }
 
 DynamicConstantBuffer::ArrayData DynamicConstantBuffer::Data::GetArrayData(const char* name)
@@ -239,7 +275,7 @@ DynamicConstantBuffer::ArrayData DynamicConstantBuffer::Data::GetArrayData(const
 
 	const ArrayDataInfo* arrayDataInfo = static_cast<const ArrayDataInfo*>(element.additionalData.get());
 
-	return ArrayData(arrayDataInfo->layout, &m_data.at(element.offset), arrayDataInfo->numElements);
+	return ArrayData(arrayDataInfo->layout, &m_data.at(element.offset), arrayDataInfo->numElements, this, element.offset);
 }
 
 const void* DynamicConstantBuffer::Data::GetPtr() const
@@ -271,14 +307,76 @@ bool DynamicConstantBuffer::Data::DrawImguiProperties()
 		auto& element = m_layout.GetElement(itemIndex);
 		void* elementData = &m_data.at(element.offset);
 
-		if(static_cast<ImguiData*>(element.imguiData.get()));
-
-		checkChanged(DrawImguiPropety(element, elementData, element.name));
+		if (DrawImguiPropety(element, elementData, element.name))
+		{
+			MarkDirty(element.offset, element.size);
+			changed = true;
+		}
 	}
 
 	return changed;
 }
 
+void DynamicConstantBuffer::Data::MarkAllDirty()
+{
+	m_dirtyRanges.clear();
+	m_dirtyRanges.push_back({ 0, m_data.size() });
+}
+
+bool DynamicConstantBuffer::Data::IsDirty() const
+{
+	return !m_dirtyRanges.empty();
+}
+
+const std::vector<DataRange>& DynamicConstantBuffer::Data::GetDirtyRanges()
+{
+	CoalesceDirtyRanges();
+
+	return m_dirtyRanges;
+}
+
+void DynamicConstantBuffer::Data::ClearDirtyRanges()
+{
+	m_dirtyRanges.clear();
+}
+
+void DynamicConstantBuffer::Data::CoalesceDirtyRanges()
+{
+	if (m_dirtyRanges.size() < 2)
+		return;
+
+	std::sort(m_dirtyRanges.begin(), m_dirtyRanges.end(),
+		[](const DataRange& a, const DataRange& b)
+		{
+			return a.offset < b.offset;
+		}
+	);
+
+	size_t lastMerged = 0;
+
+	for (size_t i = 1; i < m_dirtyRanges.size(); i++)
+	{
+		DataRange& mergedRange = m_dirtyRanges.at(lastMerged);
+		const DataRange& range = m_dirtyRanges.at(i);
+
+		if (range.offset <= mergedRange.GetEnd() + dirtyRangeMergeDistance)
+			mergedRange.size = std::max(mergedRange.GetEnd(), range.GetEnd()) - mergedRange.offset;
+		else
+			m_dirtyRanges.at(++lastMerged) = range;
+	}
+
+	m_dirtyRanges.resize(lastMerged + 1);
+
+	// if writes are scattered all over the buffer we stop tracking them separately
+	if (m_dirtyRanges.size() >= maxDirtyRanges)
+	{
+		DataRange boundingRange = { m_dirtyRanges.front().offset, m_dirtyRanges.back().GetEnd() - m_dirtyRanges.front().offset };
+
+		m_dirtyRanges.clear();
+		m_dirtyRanges.push_back(boundingRange);
+	}
+}
+
 bool DynamicConstantBuffer::DrawImguiPropety(const DynamicConstantBuffer::Layout::Element& element, void* elementData, const char* elementName)
 {
 	if (element.type == DynamicConstantBuffer::ElementType::List)
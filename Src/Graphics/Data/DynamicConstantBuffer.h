@@ -2,6 +2,7 @@
 #include "Includes/CppIncludes.h"
 #include "Includes/DirectXIncludes.h"
 #include "macros/ErrorMacros.h"
+#include "DataRange.h"
 
 namespace DynamicConstantBuffer
 {
@@ -166,6 +167,32 @@ namespace DynamicConstantBuffer
 	struct DataInfo;
 	struct ArrayDataInfo;
 
+	// typed handle to layout element. Resolved once by name, later accesses are plain offset stores
+	template<ElementType elementType>
+	struct ElementHandle
+	{
+		unsigned int offset = UINT_MAX;
+
+		constexpr bool IsValid() const
+		{
+			return offset != UINT_MAX;
+		}
+	};
+
+	// typed handle to element of array layout, element of i'th entry lives at offset + i * stride
+	template<ElementType elementType>
+	struct ArrayElementHandle
+	{
+		unsigned int offset = UINT_MAX;
+		unsigned int stride = 0;
+		unsigned int numElements = 0;
+
+		constexpr bool IsValid() const
+		{
+			return offset != UINT_MAX;
+		}
+	};
+
 	class Layout
 	{
 		static constexpr unsigned int alignment = 16;
@@ -208,6 +235,9 @@ namespace DynamicConstantBuffer
 
 		void AddArray(const char* name, ArrayDataInfo& arrayData);
 
+		// adds element of type known only at runtime, used when building layout from StaticLayout
+		void Add(ElementType elementType, const char* name);
+
 		// Adding layout elements that can be displayed in imgui
 		template<ElementType elementType, typename imguiDataType = ElementMap<elementType>::imguiDataType, ENABLE_IF(elementType != DynamicConstantBuffer::ElementType::List)>
 		void Add(const char* name, imguiDataType imguiData = {})
@@ -253,6 +283,64 @@ namespace DynamicConstantBuffer
 
 		const Element& GetElement(const char* name) const;
 
+		template<ElementType elementType, ENABLE_IF(ElementMap<elementType>::valid)>
+		ElementHandle<elementType> GetHandle(const char* name) const
+		{
+			const Element& element = GetElement(name);
+
+			THROW_INTERNAL_ERROR_IF("Tried to get handle with different type than given layout element type", element.type != elementType);
+
+			return { element.offset };
+		}
+
+		template<ElementType elementType, ENABLE_IF(ElementMap<elementType>::valid)>
+		ArrayElementHandle<elementType> GetArrayHandle(const char* arrayName, const char* name) const
+		{
+			ArrayElementLocation location = GetArrayElementLocation(arrayName, name);
+
+			THROW_INTERNAL_ERROR_IF("Tried to get handle with different type than given layout element type", location.type != elementType);
+
+			return { location.offset, location.stride, location.numElements };
+		}
+
+	public:
+		// offset that element will get when added after currentSize bytes of data, elements can't cross 16 byte boundary
+		static constexpr unsigned int GetPackedElementOffset(unsigned int currentSize, unsigned int elementSize)
+		{
+			unsigned int sizeOfLastPack = currentSize % alignment;
+
+			return sizeOfLastPack + elementSize > alignment ? GetAligned(currentSize, alignment) : currentSize;
+		}
+
+		static constexpr unsigned int GetAligned(unsigned int size, unsigned int alignmentValue)
+		{
+			return (size + alignmentValue - 1) / alignmentValue * alignmentValue;
+		}
+
+		static constexpr unsigned int GetSizeForLayoutType(unsigned int size, LayoutType layoutType)
+		{
+			switch (layoutType)
+			{
+				case LayoutType::normal:
+					return GetAligned(size, bufferSizeAlignment);
+				case LayoutType::partial:
+					return GetAligned(size, alignment);
+				default:
+					return size;
+			}
+		}
+
+	private:
+		struct ArrayElementLocation
+		{
+			ElementType type;
+			unsigned int offset;
+			unsigned int stride;
+			unsigned int numElements;
+		};
+
+		ArrayElementLocation GetArrayElementLocation(const char* arrayName, const char* name) const;
+
 	private:
 		template<ElementType elementType, ENABLE_IF(elementType != DynamicConstantBuffer::ElementType::List)>
 		consteval static unsigned int GetNewElementSize()
@@ -263,16 +351,11 @@ namespace DynamicConstantBuffer
 		template<ElementType elementType, ENABLE_IF(elementType != DynamicConstantBuffer::ElementType::List)>
 		unsigned int GetNewElementOffset() const
 		{
-			float numPacks = float(m_size) / float(alignment); // number of packs so far we went through
-			unsigned int sizeOfLastPack = (numPacks - std::floor(numPacks)) * alignment;
-			unsigned int lastPackSizeWithNewElement = sizeOfLastPack + GetNewElementSize<elementType>();
-
-			return lastPackSizeWithNewElement > alignment ? std::ceil(numPacks) * alignment : m_size;
+			return GetPackedElementOffset(m_size, GetNewElementSize<elementType>());
 		}
 
 		unsigned int GetDesiredSize(LayoutType layoutType) const;
 
-		unsigned int GetAlignedSize() const;
 		unsigned int GetPackedSize() const;
 
 	private:
@@ -302,10 +385,13 @@ namespace DynamicConstantBuffer
 		int numElements = -1;
 	};
 
+	class Data;
+
 	class ArrayData
 	{
 	public:
-		ArrayData(const Layout& layout, char* data, unsigned int numElements);
+		// owner is used to mark written entries as dirty, arrays without owner are not tracked
+		ArrayData(const Layout& layout, char* data, unsigned int numElements, Data* owner = nullptr, unsigned int offsetInOwner = 0);
 
 		template<ElementType elementType, ENABLE_IF(ElementMap<elementType>::valid)>
 		ElementMap<elementType>::dataType* Get(unsigned int i, const char* name)
@@ -318,16 +404,24 @@ namespace DynamicConstantBuffer
 
 			unsigned int offsetInArray = i * m_layout.GetSize();
 			unsigned int offsetOfElementInLayout = layoutElement.offset;
+
+			MarkDirty(offsetInArray + offsetOfElementInLayout, layoutElement.size);
+
 			return reinterpret_cast<ElementMap<elementType>::dataType*>(m_data + offsetInArray + offsetOfElementInLayout);
 		}
 
 		bool DrawImguiProperties(bool asArray = true);
 		bool DrawImguiProperties(unsigned int i, bool asArray = true);
 
+	private:
+		void MarkDirty(unsigned int offset, unsigned int size);
+
 	private:
 		const Layout& m_layout;
 		char* m_data;
 		int m_numElements;
+		Data* m_owner;
+		unsigned int m_offsetInOwner;
 	};
 
 	class Data
@@ -338,6 +432,7 @@ namespace DynamicConstantBuffer
 		Data(Layout& layout);
 
 	public:
+		// every non-const access marks accessed element as dirty, so only changed ranges are uploaded
 		template<ElementType elementType, ENABLE_IF(ElementMap<elementType>::valid)>
 		ElementMap<elementType>::dataType* Get(unsigned int index)
 		{
@@ -345,6 +440,8 @@ namespace DynamicConstantBuffer
 
 			THROW_INTERNAL_ERROR_IF("Tried to get value with different type than given layout element type", layoutElement.type != elementType);
 
+			MarkDirty(layoutElement.offset, layoutElement.size);
+
 			return reinterpret_cast<ElementMap<elementType>::dataType*>(&m_data.at(layoutElement.offset));
 		}
 
@@ -355,9 +452,45 @@ namespace DynamicConstantBuffer
 
 			THROW_INTERNAL_ERROR_IF("Tried to get value with different type than given layout element type", layoutElement.type != elementType);
 
+			MarkDirty(layoutElement.offset, layoutElement.size);
+
 			return reinterpret_cast<ElementMap<elementType>::dataType*>(&m_data.at(layoutElement.offset));
 		}
 
+		// handle based access, no name lookup and no type checks. Handles should be resolved once from layout
+		template<ElementType elementType>
+		ElementMap<elementType>::dataType* Get(ElementHandle<elementType> handle)
+		{
+			MarkDirty(handle.offset, ElementMap<elementType>::size);
+
+			return reinterpret_cast<ElementMap<elementType>::dataType*>(m_data.data() + handle.offset);
+		}
+
+		template<ElementType elementType>
+		ElementMap<elementType>::dataType* Get(ArrayElementHandle<elementType> handle, unsigned int i)
+		{
+#ifdef _DEBUG
+			THROW_INTERNAL_ERROR_IF("Tried to access index out of bounds", i >= handle.numElements);
+#endif
+
+			unsigned int offset = handle.offset + i * handle.stride;
+
+			MarkDirty(offset, ElementMap<elementType>::size);
+
+			return reinterpret_cast<ElementMap<elementType>::dataType*>(m_data.data() + offset);
+		}
+
+		// read only access, doesn't mark anything as dirty
+		template<ElementType elementType>
+		const ElementMap<elementType>::dataType* Get(ArrayElementHandle<elementType> handle, unsigned int i) const
+		{
+#ifdef _DEBUG
+			THROW_INTERNAL_ERROR_IF("Tried to access index out of bounds", i >= handle.numElements);
+#endif
+
+			return reinterpret_cast<const ElementMap<elementType>::dataType*>(m_data.data() + handle.offset + i * handle.stride);
+		}
+
 		ArrayData GetArrayData(const char* name);
 
 	public:
@@ -369,9 +502,47 @@ namespace DynamicConstantBuffer
 
 		bool DrawImguiProperties(); // returns true if buffer was updated
 
+	public: // dirty range tracking
+		void MarkDirty(size_t offset, size_t size)
+		{
+			if (!m_dirtyRanges.empty())
+			{
+				DataRange& lastRange = m_dirtyRanges.back();
+
+				// most writes go element after element, so extending last range is the common case
+				if (offset >= lastRange.offset && offset <= lastRange.GetEnd())
+				{
+					lastRange.size = std::max(lastRange.GetEnd(), offset + size) - lastRange.offset;
+					return;
+				}
+			}
+
+			if (m_dirtyRanges.size() >= maxDirtyRanges)
+				CoalesceDirtyRanges();
+
+			m_dirtyRanges.push_back({ offset, size });
+		}
+
+		void MarkAllDirty();
+
+		bool IsDirty() const;
+
+		// returns sorted, merged ranges that were written since last ClearDirtyRanges()
+		const std::vector<DataRange>& GetDirtyRanges();
+
+		void ClearDirtyRanges();
+
+	private:
+		void CoalesceDirtyRanges();
+
 	private:
+		// ranges closer than this are merged, one bigger copy is cheaper than few small ones
+		static constexpr size_t dirtyRangeMergeDistance = 64;
+		static constexpr size_t maxDirtyRanges = 32;
+
 		std::vector<char> m_data;
 		Layout m_layout;
+		std::vector<DataRange> m_dirtyRanges;
 	};
 
 	bool DrawImguiPropety(const DynamicConstantBuffer::Layout::Element& element, void* elementData, const char* elementName);
@@ -1,7 +1,7 @@
 #pragma once
 #include "Includes/CppIncludes.h"
 #include "Includes/DirectXIncludes.h"
-#include "macros/ErrorMacros.h"
+#include "Macros/ErrorMacros.h"
 
 struct D3D12_INPUT_ELEMENT_DESC;
 
@@ -0,0 +1,176 @@
+#pragma once
+#include "DynamicConstantBuffer.h"
+
+#include <string_view>
+
+namespace DynamicConstantBuffer
+{
+	struct StaticElement
+	{
+		ElementType type;
+		const char* name;
+	};
+
+	// Layout with offsets resolved at compile time. Elements follow the same packing rules as runtime Layout,
+	// so handles taken from StaticLayout can be used on Data created from GetLayout()
+	template<size_t numElements>
+	class StaticLayout
+	{
+	public:
+		struct Element
+		{
+			ElementType type = ElementType::Uint;
+			const char* name = nullptr;
+			unsigned int size = 0;
+			unsigned int offset = 0;
+		};
+
+	public:
+		consteval StaticLayout(const StaticElement (&elements)[numElements])
+		{
+			unsigned int currentSize = 0;
+
+			for (size_t i = 0; i < numElements; i++)
+			{
+				if (elements[i].type == ElementType::List)
+					throw "Arrays are not supported in static layouts";
+
+				Element& element = m_elements[i];
+				element.type = elements[i].type;
+				element.name = elements[i].name;
+				element.size = GetElementSize(element.type);
+				element.offset = Layout::GetPackedElementOffset(currentSize, element.size);
+
+				currentSize = element.offset + element.size;
+			}
+
+			m_size = currentSize;
+		}
+
+	public:
+		template<ElementType elementType>
+		consteval ElementHandle<elementType> GetHandle(const char* name) const
+		{
+			const Element& element = GetElement(name);
+
+			if (element.type != elementType)
+				throw "Tried to get handle with different type than given layout element type";
+
+			return { element.offset };
+		}
+
+		consteval const Element& GetElement(const char* name) const
+		{
+			for (const Element& element : m_elements)
+				if (std::string_view(element.name) == std::string_view(name))
+					return element;
+
+			throw "Failed to find element in static layout";
+		}
+
+		constexpr unsigned int GetSize(Layout::LayoutType layoutType = Layout::LayoutType::normal) const
+		{
+			return Layout::GetSizeForLayoutType(m_size, layoutType);
+		}
+
+		constexpr unsigned int GetNumElements() const
+		{
+			return numElements;
+		}
+
+		// creates unfinished runtime layout with the same elements
+		Layout GetLayout() const
+		{
+			Layout layout;
+
+			for (const Element& element : m_elements)
+				layout.Add(element.type, element.name);
+
+			return layout;
+		}
+
+		// emits hlsl struct matching this layout. Gaps are filled with padding so it also matches structured buffer packing
+		std::string GetHLSLStruct(const char* structName) const
+		{
+			std::string result = "struct ";
+			result += structName;
+			result += "\n{\n";
+
+			unsigned int currentSize = 0;
+			unsigned int paddingIndex = 0;
+
+			for (const Element& element : m_elements)
+			{
+				for (; currentSize < element.offset; currentSize += sizeof(float))
+					result += "    float _padding" + std::to_string(paddingIndex++) + ";\n";
+
+				result += "    ";
+				result += GetHLSLTypeName(element.type);
+				result += ' ';
+				result += element.name;
+				result += ";\n";
+
+				currentSize = element.offset + element.size;
+			}
+
+			result += "};\n";
+
+			return result;
+		}
+
+	private:
+		static constexpr unsigned int GetElementSize(ElementType elementType)
+		{
+			switch (elementType)
+			{
+				case ElementType::Uint:
+					return ElementMap<ElementType::Uint>::size;
+				case ElementType::Int:
+					return ElementMap<ElementType::Int>::size;
+				case ElementType::Bool:
+					return ElementMap<ElementType::Bool>::size;
+				case ElementType::Float:
+					return ElementMap<ElementType::Float>::size;
+				case ElementType::Float2:
+					return ElementMap<ElementType::Float2>::size;
+				case ElementType::Float3:
+					return ElementMap<ElementType::Float3>::size;
+				case ElementType::Float4:
+					return ElementMap<ElementType::Float4>::size;
+				case ElementType::Matrix:
+					return ElementMap<ElementType::Matrix>::size;
+				default:
+					return 0;
+			}
+		}
+
+		static constexpr const char* GetHLSLTypeName(ElementType elementType)
+		{
+			switch (elementType)
+			{
+				case ElementType::Uint:
+					return "uint";
+				case ElementType::Int:
+					return "int";
+				case ElementType::Bool:
+					return "bool";
+				case ElementType::Float:
+					return "float";
+				case ElementType::Float2:
+					return "float2";
+				case ElementType::Float3:
+					return "float3";
+				case ElementType::Float4:
+					return "float4";
+				case ElementType::Matrix:
+					return "row_major matrix";
+				default:
+					return "";
+			}
+		}
+
+	private:
+		Element m_elements[numElements] = {};
+		unsigned int m_size = 0;
+	};
+};
@@ -29,6 +29,9 @@ void ImguiLayer::GetImguiCommands(Graphics& graphics, ID3D12GraphicsCommandList*
 
 void ImguiLayer::Draw(Graphics& graphics, CommandList* commandList)
 {
+	if (!m_imguiManager->IsRendering())
+		return;
+
 	GetImguiCommands(graphics, commandList->Get());
 }
 
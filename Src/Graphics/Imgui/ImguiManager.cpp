@@ -35,11 +35,21 @@ ImguiManager::ImguiManager(Graphics& graphics, HWND hWnd)
 	// setting style for our imgui layer
 	ImGui::StyleColorsDark();
 
+	// without device and window imgui only builds its frames, so UI code is still part of CPU cost
+	if (graphics.GetDevice().GetNativeDevice() == nullptr)
+	{
+		ImGuiIO& io = ImGui::GetIO();
+		io.DisplaySize = ImVec2(float(graphics.GetWidth()), float(graphics.GetHeight()));
+		io.Fonts->Build();
+
+		return;
+	}
+
 	THROW_INTERNAL_ERROR_IF("Failed to initialize imgui win32 backend", !ImGui_ImplWin32_Init(hWnd));
 
 	ImGui_ImplDX12_InitInfo initInfo = {};
-	initInfo.Device = graphics.GetDeviceResources().GetDevice();
-	initInfo.CommandQueue = graphics.GetDeviceResources().GetCommandQueue();
+	initInfo.Device = graphics.GetDevice().GetNativeDevice();
+	initInfo.CommandQueue = graphics.GetDevice().GetNativeCommandQueue();
 	initInfo.NumFramesInFlight = graphics.GetBufferCount();
 	initInfo.RTVFormat = graphics.GetBackBuffer()->GetFormat();
 	initInfo.DSVFormat = graphics.GetDepthStencil()->GetFormat();
@@ -49,17 +59,29 @@ ImguiManager::ImguiManager(Graphics& graphics, HWND hWnd)
 	initInfo.SrvDescriptorFreeFn = SrvDescriptorFreeFn;
 
 	THROW_INTERNAL_ERROR_IF("Failed to initialize imgui directx12 backend", !ImGui_ImplDX12_Init(&initInfo));
+
+	m_backendsInitialized = true;
 }
 
 ImguiManager::~ImguiManager()
 {
-	ImGui_ImplDX12_Shutdown();
-	ImGui_ImplWin32_Shutdown();
+	if (m_backendsInitialized)
+	{
+		ImGui_ImplDX12_Shutdown();
+		ImGui_ImplWin32_Shutdown();
+	}
+
 	ImGui::DestroyContext();
 }
 
 void ImguiManager::BeginFrame(Graphics& graphics)
 {
+	if (!m_backendsInitialized)
+	{
+		ImGui::NewFrame();
+		return;
+	}
+
 #ifdef _DEBUG
 	InfoQueue* infoQueue = graphics.GetInfoQueue();
 
@@ -83,4 +105,9 @@ extern IMGUI_IMPL_API LRESULT ImGui_ImplWin32_WndProcHandler(HWND hWnd, UINT msg
 LRESULT ImguiManager::HandleMessages(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
 {
 	return ImGui_ImplWin32_WndProcHandler(hWnd, msg, wParam, lParam);
+}
+
+bool ImguiManager::IsRendering() const
+{
+	return m_backendsInitialized;
 }
\ No newline at end of file
@@ -16,4 +16,10 @@ public:
 	void BeginFrame(Graphics& graphics);
 
 	static LRESULT HandleMessages(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
+
+	// false when running on null device
+	bool IsRendering() const;
+
+private:
+	bool m_backendsInitialized = false;
 };
\ No newline at end of file
@@ -0,0 +1,234 @@
+#include "CommandStream.h"
+#include "CommandStreamReplay.h"
+
+#include <imgui.h>
+#include <cstring>
+
+namespace
+{
+	template<typename T>
+	void Write(std::vector<uint8_t>& data, T value)
+	{
+		size_t offset = data.size();
+		data.resize(offset + sizeof(T));
+		std::memcpy(data.data() + offset, &value, sizeof(T));
+	}
+}
+
+CommandStream& CommandStream::Get()
+{
+	static CommandStream stream;
+	return stream;
+}
+
+void CommandStream::Record(StreamCommand command, uint32_t argument0, uint32_t argument1, uint32_t argument2, uint32_t argument3)
+{
+	std::vector<uint8_t>& commands = Get().m_commands;
+
+	const uint32_t arguments[maxArguments] = { argument0, argument1, argument2, argument3 };
+	unsigned int numArguments = GetNumArguments(command);
+
+	size_t offset = commands.size();
+	commands.resize(offset + 1 + sizeof(uint32_t) * numArguments);
+	commands[offset] = uint8_t(command);
+	std::memcpy(commands.data() + offset + 1, arguments, sizeof(uint32_t) * numArguments);
+}
+
+uint32_t CommandStream::GetObjectId(const void* object)
+{
+	if (object == nullptr)
+		return 0;
+
+	std::unordered_map<const void*, uint32_t>& objectIds = Get().m_objectIds;
+
+	return objectIds.emplace(object, uint32_t(objectIds.size() + 1)).first->second;
+}
+
+uint32_t CommandStream::GetNameIndex(const char* name)
+{
+	std::vector<const char*>& names = Get().m_names;
+
+	for (uint32_t nameIndex = 0; nameIndex < names.size(); nameIndex++)
+		if (names[nameIndex] == name || std::strcmp(names[nameIndex], name) == 0)
+			return nameIndex;
+
+	names.push_back(name);
+	return uint32_t(names.size() - 1);
+}
+
+unsigned int CommandStream::GetNumArguments(StreamCommand command)
+{
+	switch (command)
+	{
+	case StreamCommand::BeginFrame:
+	case StreamCommand::EndPass:
+	case StreamCommand::EndRenderPass:
+		return 0;
+
+	case StreamCommand::OpenList:
+	case StreamCommand::SetGraphicsRootParam:
+	case StreamCommand::SetComputeRootParam:
+	case StreamCommand::SetRenderTarget:
+	case StreamCommand::BeginRenderPass:
+		return 2;
+
+	case StreamCommand::Dispatch:
+	case StreamCommand::Copy:
+		return 3;
+
+	case StreamCommand::DrawIndexed:
+		return 4;
+
+	default:
+		return 1;
+	}
+}
+
+const char* CommandStream::GetCommandName(StreamCommand command)
+{
+	switch (command)
+	{
+	case StreamCommand::BeginFrame:					return "BeginFrame";
+	case StreamCommand::OpenList:					return "OpenList";
+	case StreamCommand::CloseList:					return "CloseList";
+	case StreamCommand::BeginPass:					return "BeginPass";
+	case StreamCommand::EndPass:					return "EndPass";
+	case StreamCommand::SetPipelineState:			return "SetPipelineState";
+	case StreamCommand::SetGraphicsRootSignature:	return "SetGraphicsRootSignature";
+	case StreamCommand::SetComputeRootSignature:	return "SetComputeRootSignature";
+	case StreamCommand::SetGraphicsRootParam:		return "SetGraphicsRootParam";
+	case StreamCommand::SetComputeRootParam:		return "SetComputeRootParam";
+	case StreamCommand::SetVertexBuffer:			return "SetVertexBuffer";
+	case StreamCommand::SetIndexBuffer:				return "SetIndexBuffer";
+	case StreamCommand::SetPrimitiveTopology:		return "SetPrimitiveTopology";
+	case StreamCommand::SetViewPort:				return "SetViewPort";
+	case StreamCommand::SetRenderTarget:			return "SetRenderTarget";
+	case StreamCommand::SetDescriptorHeap:			return "SetDescriptorHeap";
+	case StreamCommand::DrawIndexed:				return "DrawIndexed";
+	case StreamCommand::Dispatch:					return "Dispatch";
+	case StreamCommand::ResourceBarrier:			return "ResourceBarrier";
+	case StreamCommand::Copy:						return "Copy";
+	case StreamCommand::BeginRenderPass:			return "BeginRenderPass";
+	case StreamCommand::EndRenderPass:				return "EndRenderPass";
+	case StreamCommand::Clear:						return "Clear";
+	default:										return "Unknown";
+	}
+}
+
+void CommandStream::StartCapture(unsigned int numFrames, const std::filesystem::path& path)
+{
+	m_pendingFrames = numFrames;
+	m_path = path;
+}
+
+bool CommandStream::IsCapturePending() const
+{
+	return m_pendingFrames > 0;
+}
+
+void CommandStream::EndFrame()
+{
+	if (m_framesLeft > 0)
+	{
+		m_framesLeft--;
+
+		if (m_framesLeft == 0)
+		{
+			FinishCapture();
+			return;
+		}
+
+		Record(StreamCommand::BeginFrame);
+		return;
+	}
+
+	if (m_pendingFrames == 0)
+		return;
+
+	m_framesLeft = m_pendingFrames;
+	m_pendingFrames = 0;
+
+	m_commands.clear();
+	m_objectIds.clear();
+	m_names.clear();
+
+	Record(StreamCommand::BeginFrame);
+}
+
+void CommandStream::Draw()
+{
+	if (!ImGui::Begin("Command Stream"))
+	{
+		ImGui::End();
+		return;
+	}
+
+	if (IsCapturing() || IsCapturePending())
+	{
+		ImGui::Text("Capturing, %u frames left", m_framesLeft + m_pendingFrames);
+	}
+	else if (ImGui::Button("Capture 10 frames"))
+	{
+		StartCapture(10, "command_stream.tcmd");
+	}
+
+	if (!m_lastCaptureResult.empty())
+		ImGui::Text("%s", m_lastCaptureResult.c_str());
+
+	if (!m_lastCapture.empty() && ImGui::Button("Analyze last capture"))
+	{
+		CommandStreamReplay replay;
+
+		if (replay.Load(m_lastCapture))
+			m_lastReplayResult = replay.GetReport();
+		else
+			m_lastReplayResult = "Failed to load last capture";
+	}
+
+	if (!m_lastReplayResult.empty())
+		ImGui::TextUnformatted(m_lastReplayResult.c_str());
+
+	ImGui::End();
+}
+
+const std::vector<uint8_t>& CommandStream::GetLastCapture() const
+{
+	return m_lastCapture;
+}
+
+void CommandStream::FinishCapture()
+{
+	m_lastCapture.clear();
+
+	Write(m_lastCapture, fileMagic);
+	Write(m_lastCapture, fileVersion);
+	Write(m_lastCapture, uint32_t(m_names.size()));
+
+	for (const char* name : m_names)
+	{
+		uint32_t length = uint32_t(std::strlen(name));
+
+		Write(m_lastCapture, length);
+		m_lastCapture.insert(m_lastCapture.end(), name, name + length);
+	}
+
+	Write(m_lastCapture, uint64_t(m_commands.size()));
+	m_lastCapture.insert(m_lastCapture.end(), m_commands.begin(), m_commands.end());
+
+	m_commands.clear();
+	m_commands.shrink_to_fit();
+	m_objectIds.clear();
+	m_names.clear();
+
+	std::ofstream file(m_path, std::ios::binary);
+
+	if (!file.is_open())
+	{
+		m_lastCaptureResult = "Failed to open " + m_path.string();
+		return;
+	}
+
+	file.write(reinterpret_cast<const char*>(m_lastCapture.data()), std::streamsize(m_lastCapture.size()));
+
+	m_lastCaptureResult = "Saved " + std::to_string(m_lastCapture.size() / 1024) + " KB to " + m_path.string();
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+#include "Includes/CppIncludes.h"
+
+// commands are written as one byte followed by fixed number of 32 bit arguments, see CommandStream::GetNumArguments()
+enum class StreamCommand : uint8_t
+{
+	BeginFrame,
+	OpenList,					// list, list type
+	CloseList,					// list
+	BeginPass,					// name index
+	EndPass,
+	SetPipelineState,			// pipeline state
+	SetGraphicsRootSignature,	// root signature
+	SetComputeRootSignature,	// root signature
+	SetGraphicsRootParam,		// root index, bindable
+	SetComputeRootParam,		// root index, bindable
+	SetVertexBuffer,			// vertex buffer
+	SetIndexBuffer,				// index buffer
+	SetPrimitiveTopology,		// topology
+	SetViewPort,				// viewport
+	SetRenderTarget,			// render target, depth stencil
+	SetDescriptorHeap,			// descriptor heap
+	DrawIndexed,				// indices, base vertex, start index, instances
+	Dispatch,					// groups x, y, z
+	ResourceBarrier,			// number of barriers
+	Copy,						// destination, source, bytes (0 for textures)
+	BeginRenderPass,			// number of render targets, has depth stencil
+	EndRenderPass,
+	Clear,						// view
+	Count
+};
+
+// only evaluates arguments while capture is running
+#define CAPTURE_COMMAND(...) \
+	do { if (CommandStream::IsCapturing()) CommandStream::Record(__VA_ARGS__); } while (0)
+
+// captures every call made on command lists into compact binary stream, so recording can be analyzed offline without scene or GPU.
+// Calls are captured as they were requested, before CommandListState filters redundant ones.
+// Objects are written as ids given in order of first use, so streams of the same scene can be compared between runs.
+// Recording happens only on render thread, the same as RenderStats
+class CommandStream
+{
+public:
+	static constexpr uint32_t fileMagic = 0x444D4354; // "TCMD"
+	static constexpr uint32_t fileVersion = 2;
+	static constexpr unsigned int maxArguments = 4;
+
+public:
+	static CommandStream& Get();
+
+	static bool IsCapturing()
+	{
+		return Get().m_framesLeft > 0;
+	}
+
+	static void Record(StreamCommand command, uint32_t argument0 = 0, uint32_t argument1 = 0, uint32_t argument2 = 0, uint32_t argument3 = 0);
+
+	// 0 is reserved for nullptr
+	static uint32_t GetObjectId(const void* object);
+
+	// name has to outlive capture, type names of passes are used
+	static uint32_t GetNameIndex(const char* name);
+
+	static unsigned int GetNumArguments(StreamCommand command);
+
+	static const char* GetCommandName(StreamCommand command);
+
+public:
+	// capture starts on next frame and records numFrames whole frames, then saves them to path
+	void StartCapture(unsigned int numFrames, const std::filesystem::path& path);
+
+	bool IsCapturePending() const;
+
+	void EndFrame();
+
+	void Draw();
+
+	// stream of last finished capture, in the same format as the file
+	const std::vector<uint8_t>& GetLastCapture() const;
+
+private:
+	CommandStream() = default;
+
+	void FinishCapture();
+
+private:
+	unsigned int m_pendingFrames = 0;
+	unsigned int m_framesLeft = 0;
+	std::filesystem::path m_path;
+
+	std::vector<uint8_t> m_commands;
+	std::unordered_map<const void*, uint32_t> m_objectIds;
+	std::vector<const char*> m_names;
+
+	std::vector<uint8_t> m_lastCapture;
+	std::string m_lastCaptureResult;
+	std::string m_lastReplayResult;
+};
\ No newline at end of file
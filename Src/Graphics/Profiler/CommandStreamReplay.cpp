@@ -0,0 +1,540 @@
+#include "CommandStreamReplay.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+#include <sstream>
+
+namespace
+{
+	template<typename T>
+	bool Read(std::span<const uint8_t> data, size_t& offset, T& value)
+	{
+		if (data.size() - offset < sizeof(T))
+			return false;
+
+		std::memcpy(&value, data.data() + offset, sizeof(T));
+		offset += sizeof(T);
+
+		return true;
+	}
+
+	// commands that draws can't be moved over
+	bool EndsDrawSegment(StreamCommand command)
+	{
+		switch (command)
+		{
+		case StreamCommand::BeginFrame:
+		case StreamCommand::OpenList:
+		case StreamCommand::CloseList:
+		case StreamCommand::BeginPass:
+		case StreamCommand::EndPass:
+		case StreamCommand::SetViewPort:
+		case StreamCommand::SetRenderTarget:
+		case StreamCommand::SetDescriptorHeap:
+		case StreamCommand::Dispatch:
+		case StreamCommand::ResourceBarrier:
+		case StreamCommand::Copy:
+		case StreamCommand::BeginRenderPass:
+		case StreamCommand::EndRenderPass:
+		case StreamCommand::Clear:
+			return true;
+		default:
+			return false;
+		}
+	}
+}
+
+bool CommandStreamReplay::Load(std::span<const uint8_t> data)
+{
+	m_commands.clear();
+	m_names.clear();
+	m_numFrames = 0;
+
+	size_t offset = 0;
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	uint32_t numNames = 0;
+
+	if (!Read(data, offset, magic) || !Read(data, offset, version) || !Read(data, offset, numNames))
+		return false;
+
+	if (magic != CommandStream::fileMagic || version != CommandStream::fileVersion)
+		return false;
+
+	for (uint32_t nameIndex = 0; nameIndex < numNames; nameIndex++)
+	{
+		uint32_t length = 0;
+
+		if (!Read(data, offset, length) || data.size() - offset < length)
+			return false;
+
+		m_names.emplace_back(reinterpret_cast<const char*>(data.data() + offset), length);
+		offset += length;
+	}
+
+	uint64_t commandBytes = 0;
+
+	if (!Read(data, offset, commandBytes) || data.size() - offset < commandBytes)
+		return false;
+
+	size_t end = offset + size_t(commandBytes);
+
+	while (offset < end)
+	{
+		StreamCommand streamCommand = StreamCommand(data[offset]);
+		offset++;
+
+		if (streamCommand >= StreamCommand::Count)
+			return false;
+
+		Command command = { streamCommand, {} };
+		unsigned int numArguments = CommandStream::GetNumArguments(streamCommand);
+
+		if (end - offset < sizeof(uint32_t) * numArguments)
+			return false;
+
+		std::memcpy(command.arguments.data(), data.data() + offset, sizeof(uint32_t) * numArguments);
+		offset += sizeof(uint32_t) * numArguments;
+
+		// root params are tracked in fixed arrays
+		bool isRootParam = streamCommand == StreamCommand::SetGraphicsRootParam || streamCommand == StreamCommand::SetComputeRootParam;
+
+		if (isRootParam && command.arguments[0] >= maxRootParams)
+			return false;
+
+		if (streamCommand == StreamCommand::BeginFrame)
+			m_numFrames++;
+
+		m_commands.push_back(command);
+	}
+
+	BuildDrawSegments();
+
+	return true;
+}
+
+bool CommandStreamReplay::LoadFromFile(const std::filesystem::path& path)
+{
+	std::ifstream file(path, std::ios::binary);
+
+	if (!file.is_open())
+		return false;
+
+	std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	return Load(data);
+}
+
+CommandStreamReplay::RedundancyStats CommandStreamReplay::AnalyzeRedundancy() const
+{
+	RedundancyStats stats = {};
+
+	std::unordered_map<StreamCommand, uint32_t> boundObjects;
+	std::array<uint32_t, maxRootParams> graphicsRootParams = {};
+	std::array<uint32_t, maxRootParams> computeRootParams = {};
+	uint32_t boundDepthStencil = 0;
+
+	std::unordered_set<uint32_t> pipelineStates;
+	std::unordered_set<uint32_t> rootSignatures;
+
+	for (const Command& command : m_commands)
+	{
+		CommandRedundancy& redundancy = stats.commands[size_t(command.command)];
+		redundancy.requested++;
+
+		switch (command.command)
+		{
+		case StreamCommand::OpenList:
+			// command list has no state after reset
+			boundObjects.clear();
+			graphicsRootParams = {};
+			computeRootParams = {};
+			boundDepthStencil = 0;
+			break;
+
+		case StreamCommand::SetGraphicsRootParam:
+		case StreamCommand::SetComputeRootParam:
+		{
+			std::array<uint32_t, maxRootParams>& rootParams = command.command == StreamCommand::SetGraphicsRootParam ? graphicsRootParams : computeRootParams;
+			uint32_t& boundParam = rootParams.at(command.arguments[0]);
+
+			if (boundParam == command.arguments[1])
+				redundancy.redundant++;
+
+			boundParam = command.arguments[1];
+			break;
+		}
+
+		case StreamCommand::SetRenderTarget:
+		{
+			uint32_t& boundRenderTarget = boundObjects[command.command];
+
+			if (boundRenderTarget == command.arguments[0] && boundDepthStencil == command.arguments[1])
+				redundancy.redundant++;
+
+			boundRenderTarget = command.arguments[0];
+			boundDepthStencil = command.arguments[1];
+			break;
+		}
+
+		case StreamCommand::SetPipelineState:
+		case StreamCommand::SetGraphicsRootSignature:
+		case StreamCommand::SetComputeRootSignature:
+		case StreamCommand::SetVertexBuffer:
+		case StreamCommand::SetIndexBuffer:
+		case StreamCommand::SetPrimitiveTopology:
+		case StreamCommand::SetViewPort:
+		case StreamCommand::SetDescriptorHeap:
+		{
+			uint32_t& boundObject = boundObjects[command.command];
+
+			if (boundObject == command.arguments[0])
+				redundancy.redundant++;
+			else if (command.command == StreamCommand::SetGraphicsRootSignature)
+				graphicsRootParams = {}; // changing root signature unbinds its params
+			else if (command.command == StreamCommand::SetComputeRootSignature)
+				computeRootParams = {};
+
+			boundObject = command.arguments[0];
+
+			if (command.command == StreamCommand::SetPipelineState)
+				pipelineStates.insert(command.arguments[0]);
+			else if (command.command == StreamCommand::SetGraphicsRootSignature || command.command == StreamCommand::SetComputeRootSignature)
+				rootSignatures.insert(command.arguments[0]);
+
+			break;
+		}
+
+		case StreamCommand::DrawIndexed:
+			stats.numDraws++;
+			stats.numInstances += command.arguments[3];
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	stats.numDrawSegments = m_drawSegments.size();
+	stats.numPipelineStates = static_cast<unsigned int>(pipelineStates.size());
+	stats.numRootSignatures = static_cast<unsigned int>(rootSignatures.size());
+
+	return stats;
+}
+
+CommandStreamReplay::StrategyResult CommandStreamReplay::Retime(Strategy strategy, unsigned int numRepetitions) const
+{
+	using Clock = std::chrono::steady_clock;
+
+	auto getElapsedMs = [](Clock::time_point start)
+		{
+			return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+		};
+
+	StrategyResult result = {};
+	result.strategy = strategy;
+
+	std::vector<DrawPacket> packets;
+	packets.reserve(m_drawPackets.size());
+
+	std::vector<Command> output;
+	output.reserve(m_drawPackets.size() * 4);
+
+	for (unsigned int repetition = 0; repetition < numRepetitions; repetition++)
+	{
+		packets = m_drawPackets;
+
+		Clock::time_point start = Clock::now();
+
+		if (strategy != Strategy::AsRecorded)
+		{
+			for (const DrawSegment& segment : m_drawSegments)
+			{
+				auto first = packets.begin() + segment.firstPacket;
+				auto last = first + segment.numPackets;
+
+				if (strategy == Strategy::SortByPipelineState)
+					std::stable_sort(first, last, [](const DrawPacket& left, const DrawPacket& right) { return left.pipelineState < right.pipelineState; });
+				else
+					std::stable_sort(first, last, [this](const DrawPacket& left, const DrawPacket& right) { return CompareState(left, right); });
+			}
+		}
+
+		result.sortMs += getElapsedMs(start);
+
+		output.clear();
+		RecordState state = {};
+
+		start = Clock::now();
+
+		for (const DrawSegment& segment : m_drawSegments)
+		{
+			if (segment.resetsState)
+				state = {};
+
+			RecordSegment(std::span(packets.data() + segment.firstPacket, segment.numPackets), strategy == Strategy::SortByStateAndBatch, state, output);
+		}
+
+		result.recordMs += getElapsedMs(start);
+	}
+
+	for (const Command& command : output)
+	{
+		if (command.command == StreamCommand::DrawIndexed)
+			result.numDrawCalls++;
+		else
+			result.numStateChanges++;
+	}
+
+	return result;
+}
+
+const std::vector<CommandStreamReplay::Command>& CommandStreamReplay::GetCommands() const
+{
+	return m_commands;
+}
+
+const std::vector<std::string>& CommandStreamReplay::GetNames() const
+{
+	return m_names;
+}
+
+unsigned int CommandStreamReplay::GetNumFrames() const
+{
+	return m_numFrames;
+}
+
+const char* CommandStreamReplay::GetStrategyName(Strategy strategy)
+{
+	switch (strategy)
+	{
+	case Strategy::AsRecorded:			return "As recorded";
+	case Strategy::SortByPipelineState:	return "Sort by PSO";
+	case Strategy::SortByState:			return "Sort by state";
+	case Strategy::SortByStateAndBatch:	return "Sort by state and batch";
+	default:							return "Unknown";
+	}
+}
+
+std::string CommandStreamReplay::GetReport(unsigned int numRepetitions) const
+{
+	RedundancyStats redundancy = AnalyzeRedundancy();
+
+	std::ostringstream report;
+	report << std::fixed << std::setprecision(3);
+
+	report << m_numFrames << " frames, " << m_commands.size() << " commands, " << redundancy.numDraws << " draws of " << redundancy.numInstances << " instances in " << redundancy.numDrawSegments << " segments\n";
+	report << redundancy.numPipelineStates << " unique PSOs, " << redundancy.numRootSignatures << " unique root signatures\n\n";
+
+	for (unsigned int command = 0; command < static_cast<unsigned int>(StreamCommand::Count); command++)
+	{
+		const CommandRedundancy& commandRedundancy = redundancy.commands[command];
+
+		if (commandRedundancy.redundant == 0)
+			continue;
+
+		report << CommandStream::GetCommandName(StreamCommand(command)) << ": " << commandRedundancy.redundant << " of " << commandRedundancy.requested << " redundant\n";
+	}
+
+	report << "\n";
+
+	for (unsigned int strategy = 0; strategy < static_cast<unsigned int>(Strategy::Count); strategy++)
+	{
+		StrategyResult result = Retime(Strategy(strategy), numRepetitions);
+
+		report << GetStrategyName(result.strategy) << ": " << result.numDrawCalls << " draw calls, " << result.numStateChanges << " state changes, "
+			<< "sort " << result.sortMs / float(numRepetitions) << " ms, record " << result.recordMs / float(numRepetitions) << " ms\n";
+	}
+
+	return report.str();
+}
+
+void CommandStreamReplay::BuildDrawSegments()
+{
+	m_drawPackets.clear();
+	m_rootParams.clear();
+	m_drawSegments.clear();
+
+	DrawPacket state = {};
+	std::array<uint32_t, maxRootParams> rootParams = {};
+	bool resetsState = true;
+
+	DrawSegment segment = {};
+
+	auto closeSegment = [&]()
+		{
+			segment.numPackets = m_drawPackets.size() - segment.firstPacket;
+
+			if (segment.numPackets > 0)
+			{
+				m_drawSegments.push_back(segment);
+				resetsState = false;
+			}
+
+			segment = {};
+			segment.firstPacket = m_drawPackets.size();
+			segment.resetsState = resetsState;
+		};
+
+	for (const Command& command : m_commands)
+	{
+		if (EndsDrawSegment(command.command))
+			closeSegment();
+
+		switch (command.command)
+		{
+		case StreamCommand::OpenList:
+			state = {};
+			rootParams = {};
+			resetsState = true;
+			segment.resetsState = true;
+			break;
+
+		case StreamCommand::SetPipelineState:
+			state.pipelineState = command.arguments[0];
+			break;
+
+		case StreamCommand::SetGraphicsRootSignature:
+			if (state.rootSignature != command.arguments[0])
+				rootParams = {};
+
+			state.rootSignature = command.arguments[0];
+			break;
+
+		case StreamCommand::SetGraphicsRootParam:
+			rootParams.at(command.arguments[0]) = command.arguments[1];
+			break;
+
+		case StreamCommand::SetVertexBuffer:
+			state.vertexBuffer = command.arguments[0];
+			break;
+
+		case StreamCommand::SetIndexBuffer:
+			state.indexBuffer = command.arguments[0];
+			break;
+
+		case StreamCommand::SetPrimitiveTopology:
+			state.topology = command.arguments[0];
+			break;
+
+		case StreamCommand::DrawIndexed:
+		{
+			DrawPacket packet = state;
+			packet.firstRootParam = uint32_t(m_rootParams.size());
+			packet.indices = command.arguments[0];
+			packet.baseVertex = command.arguments[1];
+			packet.startIndex = command.arguments[2];
+			packet.instances = command.arguments[3];
+
+			for (uint32_t rootIndex = 0; rootIndex < maxRootParams; rootIndex++)
+				if (rootParams[rootIndex] != 0)
+					m_rootParams.push_back({ rootIndex, rootParams[rootIndex] });
+
+			packet.numRootParams = uint32_t(m_rootParams.size()) - packet.firstRootParam;
+
+			m_drawPackets.push_back(packet);
+			break;
+		}
+
+		default:
+			break;
+		}
+	}
+
+	closeSegment();
+}
+
+bool CommandStreamReplay::CompareState(const DrawPacket& left, const DrawPacket& right) const
+{
+	auto leftKey = std::tie(left.pipelineState, left.rootSignature, left.vertexBuffer, left.indexBuffer, left.topology);
+	auto rightKey = std::tie(right.pipelineState, right.rootSignature, right.vertexBuffer, right.indexBuffer, right.topology);
+
+	if (leftKey != rightKey)
+		return leftKey < rightKey;
+
+	std::span<const RootParam> leftParams(m_rootParams.data() + left.firstRootParam, left.numRootParams);
+	std::span<const RootParam> rightParams(m_rootParams.data() + right.firstRootParam, right.numRootParams);
+
+	return std::lexicographical_compare(leftParams.begin(), leftParams.end(), rightParams.begin(), rightParams.end(),
+		[](const RootParam& leftParam, const RootParam& rightParam)
+		{
+			return std::tie(leftParam.rootIndex, leftParam.bindable) < std::tie(rightParam.rootIndex, rightParam.bindable);
+		});
+}
+
+void CommandStreamReplay::RecordSegment(std::span<const DrawPacket> packets, bool batch, RecordState& state, std::vector<Command>& output) const
+{
+	// draws can't be merged over commands that ended previous segment
+	state.lastDraw = nullptr;
+
+	for (const DrawPacket& packet : packets)
+	{
+		// merged draw adds its instances to the last one, its root params would be moved into instance data
+		if (batch && state.lastDraw != nullptr && CanBatch(*state.lastDraw, packet))
+		{
+			output[state.lastDrawCommand].arguments[3] += packet.instances;
+			continue;
+		}
+
+		if (state.pipelineState != packet.pipelineState)
+		{
+			state.pipelineState = packet.pipelineState;
+			output.push_back({ StreamCommand::SetPipelineState, { packet.pipelineState } });
+		}
+
+		if (state.rootSignature != packet.rootSignature)
+		{
+			state.rootSignature = packet.rootSignature;
+			state.rootParams = {};
+			output.push_back({ StreamCommand::SetGraphicsRootSignature, { packet.rootSignature } });
+		}
+
+		if (state.vertexBuffer != packet.vertexBuffer)
+		{
+			state.vertexBuffer = packet.vertexBuffer;
+			output.push_back({ StreamCommand::SetVertexBuffer, { packet.vertexBuffer } });
+		}
+
+		if (state.indexBuffer != packet.indexBuffer)
+		{
+			state.indexBuffer = packet.indexBuffer;
+			output.push_back({ StreamCommand::SetIndexBuffer, { packet.indexBuffer } });
+		}
+
+		if (state.topology != packet.topology)
+		{
+			state.topology = packet.topology;
+			output.push_back({ StreamCommand::SetPrimitiveTopology, { packet.topology } });
+		}
+
+		for (uint32_t param = packet.firstRootParam; param < packet.firstRootParam + packet.numRootParams; param++)
+		{
+			const RootParam& rootParam = m_rootParams[param];
+			uint32_t& boundParam = state.rootParams[rootParam.rootIndex];
+
+			if (boundParam == rootParam.bindable)
+				continue;
+
+			boundParam = rootParam.bindable;
+			output.push_back({ StreamCommand::SetGraphicsRootParam, { rootParam.rootIndex, rootParam.bindable } });
+		}
+
+		output.push_back({ StreamCommand::DrawIndexed, { packet.indices, packet.baseVertex, packet.startIndex, packet.instances } });
+
+		state.lastDraw = &packet;
+		state.lastDrawCommand = output.size() - 1;
+	}
+}
+
+bool CommandStreamReplay::CanBatch(const DrawPacket& left, const DrawPacket& right)
+{
+	return left.pipelineState == right.pipelineState &&
+		left.rootSignature == right.rootSignature &&
+		left.vertexBuffer == right.vertexBuffer &&
+		left.indexBuffer == right.indexBuffer &&
+		left.topology == right.topology &&
+		left.indices == right.indices &&
+		left.baseVertex == right.baseVertex &&
+		left.startIndex == right.startIndex;
+}
\ No newline at end of file
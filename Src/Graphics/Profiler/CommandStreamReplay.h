@@ -0,0 +1,136 @@
+#pragma once
+#include "Includes/CppIncludes.h"
+#include "CommandStream.h"
+
+// loads command stream captured by CommandStream and analyzes it without scene, graphics or GPU.
+// Redundancy is measured by replaying calls through the same filtering CommandListState does.
+// Draws between two non-draw commands (barriers, render passes, dispatches, copies, clears) can be reordered freely,
+// so their recording can be re-timed with different sort and batching strategies
+class CommandStreamReplay
+{
+public:
+	struct Command
+	{
+		StreamCommand command;
+		std::array<uint32_t, CommandStream::maxArguments> arguments;
+	};
+
+	struct CommandRedundancy
+	{
+		uint64_t requested = 0;
+		uint64_t redundant = 0; // the same as already bound state
+	};
+
+	struct RedundancyStats
+	{
+		std::array<CommandRedundancy, size_t(StreamCommand::Count)> commands = {};
+		uint64_t numDraws = 0;
+		uint64_t numInstances = 0;
+		uint64_t numDrawSegments = 0;
+		unsigned int numPipelineStates = 0; // unique
+		unsigned int numRootSignatures = 0;
+	};
+
+	enum class Strategy : uint8_t
+	{
+		AsRecorded,
+		SortByPipelineState,
+		SortByState, // pipeline state, root signature, buffers and root params
+		SortByStateAndBatch, // sorted, consecutive draws with the same state and geometry are merged into one instanced draw
+		Count
+	};
+
+	struct StrategyResult
+	{
+		Strategy strategy = Strategy::AsRecorded;
+		uint64_t numDrawCalls = 0;
+		uint64_t numStateChanges = 0; // pipeline, root signature, root param and buffer sets that reached command list
+		float sortMs = 0.0f;
+		float recordMs = 0.0f;
+	};
+
+public:
+	// false when data is not a command stream of current version, is truncated or has commands out of range
+	bool Load(std::span<const uint8_t> data);
+	bool LoadFromFile(const std::filesystem::path& path);
+
+	RedundancyStats AnalyzeRedundancy() const;
+
+	// times are summed over numRepetitions replays of whole stream
+	StrategyResult Retime(Strategy strategy, unsigned int numRepetitions = 10) const;
+
+	const std::vector<Command>& GetCommands() const;
+
+	const std::vector<std::string>& GetNames() const;
+
+	unsigned int GetNumFrames() const;
+
+	static const char* GetStrategyName(Strategy strategy);
+
+	// redundancy and results of all strategies as readable text
+	std::string GetReport(unsigned int numRepetitions = 10) const;
+
+private:
+	static constexpr unsigned int maxRootParams = 64;
+
+	// state at the moment of a draw
+	struct DrawPacket
+	{
+		uint32_t pipelineState = 0;
+		uint32_t rootSignature = 0;
+		uint32_t vertexBuffer = 0;
+		uint32_t indexBuffer = 0;
+		uint32_t topology = 0;
+		uint32_t firstRootParam = 0; // in m_rootParams
+		uint32_t numRootParams = 0;
+		uint32_t indices = 0;
+		uint32_t baseVertex = 0;
+		uint32_t startIndex = 0;
+		uint32_t instances = 1;
+	};
+
+	struct RootParam
+	{
+		uint32_t rootIndex;
+		uint32_t bindable;
+	};
+
+	struct DrawSegment
+	{
+		size_t firstPacket = 0;
+		size_t numPackets = 0;
+		bool resetsState = false; // first segment after command list was opened
+	};
+
+	// the same filtering CommandListState does
+	struct RecordState
+	{
+		uint32_t pipelineState = 0;
+		uint32_t rootSignature = 0;
+		uint32_t vertexBuffer = 0;
+		uint32_t indexBuffer = 0;
+		uint32_t topology = 0;
+		std::array<uint32_t, maxRootParams> rootParams = {};
+		const DrawPacket* lastDraw = nullptr;
+		size_t lastDrawCommand = 0; // in output, merged draws add their instances to it
+	};
+
+	// builds draw packets with root params that were bound at the time of each draw
+	void BuildDrawSegments();
+
+	bool CompareState(const DrawPacket& left, const DrawPacket& right) const;
+
+	// writes calls that pass filtering into output, the way CommandList would record them
+	void RecordSegment(std::span<const DrawPacket> packets, bool batch, RecordState& state, std::vector<Command>& output) const;
+
+	static bool CanBatch(const DrawPacket& left, const DrawPacket& right);
+
+private:
+	std::vector<Command> m_commands;
+	std::vector<std::string> m_names;
+	unsigned int m_numFrames = 0;
+
+	std::vector<DrawPacket> m_drawPackets;
+	std::vector<RootParam> m_rootParams;
+	std::vector<DrawSegment> m_drawSegments;
+};
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "GPUProfiler.h"
+#include "Macros/ErrorMacros.h"
 
 #include "Graphics/Core/Graphics.h"
 #include "Graphics/Resources/GraphicsBuffer.h"
@@ -8,9 +9,14 @@ void GPUProfiler::Initialize(Graphics& graphics)
 {
 	unsigned int bufferCount = graphics.GetBufferCount();
 
-	m_timestampHeap = std::make_unique<QueryHeap>(graphics, 2 * bufferCount);
+	m_timestampFrames = std::make_unique<GPUTimestampFrames>(bufferCount, maxQueriesPerFrame);
 
-	m_timestapReadbackBuffer = std::make_unique<GraphicsBuffer>(graphics, 2 * bufferCount, sizeof(UINT64), GraphicsResource::CPUAccess::readwrite, D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_FLAG_NONE);
+	m_timestampHeap = std::make_unique<QueryHeap>(graphics, m_timestampFrames->GetNumQueriesTotal());
+
+	m_timestapReadbackBuffer = std::make_unique<GraphicsBuffer>(graphics, m_timestampFrames->GetNumQueriesTotal(), sizeof(UINT64), GraphicsResource::CPUAccess::readwrite, D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_FLAG_NONE);
+
+	m_timestamps.resize(maxQueriesPerFrame);
+	m_zones.reserve(maxQueriesPerFrame / 2);
 }
 
 double GPUProfiler::GetData() const
@@ -22,48 +28,101 @@ void GPUProfiler::SetBeginData(Graphics& graphics, CommandList* commandList)
 {
 	unsigned int bufferIndex = graphics.GetCurrentBufferIndex();
 
-	commandList->Query(
-		graphics, 
-		m_timestampHeap.get(),
-		2 * bufferIndex,
-		D3D12_QUERY_TYPE_TIMESTAMP
-	);
+	// frame that used the same back buffer was retired, its timestamps are ready
+	if (std::optional<size_t> lastRetiredFrame = graphics.GetLastRetiredFrame())
+		ReadResults(graphics, bufferIndex, *lastRetiredFrame);
+
+	m_timestampFrames->BeginFrame(bufferIndex, graphics.GetFrameNumber(), GetClockCalibration(graphics));
+
+	BeginZone(graphics, commandList, "Frame");
 }
 
 void GPUProfiler::SetEndData(Graphics& graphics, CommandList* commandList)
 {
-	unsigned int bufferIndex = graphics.GetCurrentBufferIndex();
+	EndZone(graphics, commandList);
 
-	commandList->Query(
-		graphics, 
-		m_timestampHeap.get(),
-		2 * bufferIndex + 1, 
-		D3D12_QUERY_TYPE_TIMESTAMP
-	);
+	unsigned int frameSlot = m_timestampFrames->GetCurrentFrameSlot();
+	unsigned int firstQuery = m_timestampFrames->GetFirstQuery(frameSlot);
 
 	commandList->ResolveQuery(
 		graphics,
 		m_timestampHeap.get(),
 		D3D12_QUERY_TYPE_TIMESTAMP,
-		bufferIndex * 2,
-		2,
+		firstQuery,
+		m_timestampFrames->GetNumQueries(frameSlot),
 		m_timestapReadbackBuffer.get(),
-		sizeof(UINT64) * 2 * bufferIndex
+		sizeof(UINT64) * firstQuery
 	);
+}
+
+void GPUProfiler::BeginZone(Graphics& graphics, CommandList* commandList, const char* name)
+{
+	std::optional<unsigned int> query = m_timestampFrames->BeginZone(name);
+
+	if (query.has_value())
+		commandList->Query(graphics, m_timestampHeap.get(), query.value(), D3D12_QUERY_TYPE_TIMESTAMP);
+}
+
+void GPUProfiler::EndZone(Graphics& graphics, CommandList* commandList)
+{
+	std::optional<unsigned int> query = m_timestampFrames->EndZone();
 
-	struct TimeStampData
+	if (query.has_value())
+		commandList->Query(graphics, m_timestampHeap.get(), query.value(), D3D12_QUERY_TYPE_TIMESTAMP);
+}
+
+void GPUProfiler::ReadResults(Graphics& graphics, unsigned int frameSlot, size_t lastRetiredFrame)
+{
+	unsigned int numQueries = m_timestampFrames->GetNumQueries(frameSlot);
+
+	// null device doesn't write any timestamps and reports no frequency
+	UINT64 gpuTimestampFrequency = graphics.GetDevice().GetTimestampFrequency();
+
+	if (numQueries == 0 || gpuTimestampFrequency == 0)
+		return;
+
+	m_timestapReadbackBuffer->Read(graphics, m_timestamps.data(), sizeof(UINT64) * numQueries, sizeof(UINT64) * m_timestampFrames->GetFirstQuery(frameSlot));
+
+	if (!m_timestampFrames->ResolveFrame(frameSlot, lastRetiredFrame, std::span(m_timestamps.data(), numQueries), gpuTimestampFrequency))
+		return;
+
+	m_zones.clear();
+
+	for (const GPUTimestampFrames::ResolvedZone& resolvedZone : m_timestampFrames->GetResolvedZones())
 	{
-		UINT64 start, end;
-	};
+		// frame zone brackets all the others
+		if (resolvedZone.depth == 0)
+			m_data = resolvedZone.durationMs / 1000.0;
+
+		ZoneProfiler::ExternalZone zone = {};
+		zone.name = resolvedZone.name;
+		zone.depth = resolvedZone.depth;
+		zone.start = resolvedZone.cpuStartTime;
+		zone.duration = uint64_t(resolvedZone.durationMs * 1000000.0);
+
+		m_zones.push_back(zone);
+	}
+
+	ZoneProfiler::Get().AddExternalZones("GPU", m_zones);
+}
+
+GPUTimestampFrames::ClockCalibration GPUProfiler::GetClockCalibration(Graphics& graphics) const
+{
+	UINT64 gpuTimestamp = 0;
+	UINT64 cpuTimestamp = 0;
 
-	TimeStampData timeStampData = {};
-	m_timestapReadbackBuffer->Read(graphics, &timeStampData, sizeof(timeStampData), sizeof(timeStampData) * bufferIndex);
+	if (!graphics.GetDevice().GetClockCalibration(graphics, gpuTimestamp, cpuTimestamp))
+		return {};
 
+	LARGE_INTEGER performanceFrequency = {};
+	QueryPerformanceFrequency(&performanceFrequency);
 
-	UINT64 gpuTimestampFrequency = 0;
-	graphics.GetDeviceResources().GetCommandQueue()->GetTimestampFrequency(&gpuTimestampFrequency);
+	// cpu timestamp comes from QueryPerformanceCounter, which steady_clock is built on
+	uint64_t frequency = uint64_t(performanceFrequency.QuadPart);
 
-	double gpuTime = static_cast<double>(timeStampData.end - timeStampData.start) / static_cast<double>(gpuTimestampFrequency);
+	GPUTimestampFrames::ClockCalibration calibration = {};
+	calibration.gpuTimestamp = gpuTimestamp;
+	calibration.cpuTime = GPUTimestampFrames::TicksToNanoseconds(cpuTimestamp, frequency);
 
-	m_data = gpuTime;
+	return calibration;
 }
\ No newline at end of file
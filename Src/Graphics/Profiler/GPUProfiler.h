@@ -2,26 +2,50 @@
 #include "Includes/CppIncludes.h"
 #include "Includes/DirectXIncludes.h"
 
+#include "GPUTimestampFrames.h"
+#include "ZoneProfiler.h"
+
 #include "Graphics/Resources/QueryHeap.h"
 #include "Graphics/Resources/GraphicsBuffer.h"
 
 class Graphics;
 class CommandList;
 
+// times frame and zones inside of it with timestamp queries. Every back buffer has its own range of queries,
+// results are read when the same back buffer comes back, so GPU finished with them for sure.
+// Resolved zones are added to ZoneProfiler as GPU track, aligned with CPU zones through clock calibration
 class GPUProfiler
 {
+public:
+	static constexpr unsigned int maxQueriesPerFrame = 512;
+
 public:
 	void Initialize(Graphics& graphics);
 
 public:
+	// seconds of last frame that GPU finished
 	double GetData() const;
 
+	// reads results of the frame that used the same back buffer and starts frame zone
 	void SetBeginData(Graphics& graphics, CommandList* commandList);
 
 	void SetEndData(Graphics& graphics, CommandList* commandList);
 
+	void BeginZone(Graphics& graphics, CommandList* commandList, const char* name);
+	void EndZone(Graphics& graphics, CommandList* commandList);
+
+private:
+	void ReadResults(Graphics& graphics, unsigned int frameSlot, size_t lastRetiredFrame);
+
+	GPUTimestampFrames::ClockCalibration GetClockCalibration(Graphics& graphics) const;
+
 private:
 	std::unique_ptr<GraphicsBuffer> m_timestapReadbackBuffer;
 	std::unique_ptr<QueryHeap> m_timestampHeap;
-	double m_data;
+	std::unique_ptr<GPUTimestampFrames> m_timestampFrames;
+
+	std::vector<uint64_t> m_timestamps;
+	std::vector<ZoneProfiler::ExternalZone> m_zones;
+
+	double m_data = 0.0;
 };
\ No newline at end of file
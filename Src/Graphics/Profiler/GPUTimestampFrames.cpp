@@ -0,0 +1,151 @@
+#include "GPUTimestampFrames.h"
+#include "Macros/ErrorMacros.h"
+
+GPUTimestampFrames::GPUTimestampFrames(unsigned int numFrameSlots, unsigned int maxQueriesPerFrame)
+	:
+	m_frameSlots(numFrameSlots),
+	m_maxQueriesPerFrame(maxQueriesPerFrame)
+{
+	THROW_INTERNAL_ERROR_IF("GPUTimestampFrames needs at least one frame slot", numFrameSlots == 0);
+}
+
+void GPUTimestampFrames::BeginFrame(unsigned int frameSlot, size_t frameNumber, ClockCalibration calibration)
+{
+	THROW_INTERNAL_ERROR_IF("Frame slot out of bounds", frameSlot >= m_frameSlots.size());
+
+	m_currentFrameSlot = frameSlot;
+
+	m_frameSlots[frameSlot].zones.clear();
+	m_frameSlots[frameSlot].numQueries = 0;
+	m_frameSlots[frameSlot].frameNumber = frameNumber;
+	m_frameSlots[frameSlot].calibration = calibration;
+
+	m_openZones.clear();
+	m_droppedDepth = 0;
+}
+
+std::optional<unsigned int> GPUTimestampFrames::BeginZone(const char* name)
+{
+	FrameSlot& frameSlot = m_frameSlots[m_currentFrameSlot];
+
+	// space for end queries of all open zones has to stay available
+	if (m_droppedDepth > 0 || frameSlot.numQueries + static_cast<unsigned int>(m_openZones.size()) + 2 > m_maxQueriesPerFrame)
+	{
+		m_droppedDepth++;
+		return std::nullopt;
+	}
+
+	RecordedZone& zone = frameSlot.zones.emplace_back();
+
+	size_t nameLength = std::min(std::strlen(name), size_t(maxNameLength - 1));
+	std::memcpy(zone.name, name, nameLength);
+	zone.name[nameLength] = '\0';
+
+	zone.depth = static_cast<unsigned int>(m_openZones.size());
+	zone.beginQuery = frameSlot.numQueries;
+	zone.endQuery = std::nullopt;
+
+	m_openZones.push_back(static_cast<unsigned int>(frameSlot.zones.size() - 1));
+	frameSlot.numQueries++;
+
+	return GetFirstQuery(m_currentFrameSlot) + zone.beginQuery;
+}
+
+std::optional<unsigned int> GPUTimestampFrames::EndZone()
+{
+	if (m_droppedDepth > 0)
+	{
+		m_droppedDepth--;
+		return std::nullopt;
+	}
+
+	THROW_INTERNAL_ERROR_IF("Tried to end GPU zone that wasn't started", m_openZones.empty());
+
+	FrameSlot& frameSlot = m_frameSlots[m_currentFrameSlot];
+
+	RecordedZone& zone = frameSlot.zones[m_openZones.back()];
+	m_openZones.pop_back();
+
+	zone.endQuery = frameSlot.numQueries;
+	frameSlot.numQueries++;
+
+	return GetFirstQuery(m_currentFrameSlot) + zone.endQuery.value();
+}
+
+unsigned int GPUTimestampFrames::GetCurrentFrameSlot() const
+{
+	return m_currentFrameSlot;
+}
+
+unsigned int GPUTimestampFrames::GetFirstQuery(unsigned int frameSlot) const
+{
+	return frameSlot * m_maxQueriesPerFrame;
+}
+
+unsigned int GPUTimestampFrames::GetNumQueries(unsigned int frameSlot) const
+{
+	return m_frameSlots.at(frameSlot).numQueries;
+}
+
+unsigned int GPUTimestampFrames::GetNumQueriesTotal() const
+{
+	return static_cast<unsigned int>(m_frameSlots.size()) * m_maxQueriesPerFrame;
+}
+
+bool GPUTimestampFrames::ResolveFrame(unsigned int frameSlot, size_t lastRetiredFrame, std::span<const uint64_t> timestamps, uint64_t frequency)
+{
+	const FrameSlot& slot = m_frameSlots.at(frameSlot);
+
+	if (slot.numQueries == 0 || frequency == 0 || slot.frameNumber > lastRetiredFrame)
+		return false;
+
+	THROW_INTERNAL_ERROR_IF("Not enough timestamps to resolve frame", timestamps.size() < slot.numQueries);
+
+	m_resolvedZones.clear();
+
+	for (const RecordedZone& zone : slot.zones)
+	{
+		// zone that was never closed has no end timestamp
+		if (!zone.endQuery.has_value())
+			continue;
+
+		uint64_t startTimestamp = timestamps[zone.beginQuery];
+		uint64_t endTimestamp = timestamps[zone.endQuery.value()];
+
+		if (endTimestamp < startTimestamp)
+			continue;
+
+		ResolvedZone resolvedZone = {};
+		resolvedZone.name = zone.name;
+		resolvedZone.depth = zone.depth;
+		resolvedZone.startTimestamp = startTimestamp;
+		resolvedZone.endTimestamp = endTimestamp;
+		resolvedZone.cpuStartTime = ToCpuTime(slot.calibration, startTimestamp, frequency);
+		resolvedZone.durationMs = double(endTimestamp - startTimestamp) * 1000.0 / double(frequency);
+
+		m_resolvedZones.push_back(resolvedZone);
+	}
+
+	return true;
+}
+
+const std::vector<GPUTimestampFrames::ResolvedZone>& GPUTimestampFrames::GetResolvedZones() const
+{
+	return m_resolvedZones;
+}
+
+uint64_t GPUTimestampFrames::TicksToNanoseconds(uint64_t ticks, uint64_t frequency)
+{
+	return (ticks / frequency) * 1000000000ull + (ticks % frequency) * 1000000000ull / frequency;
+}
+
+uint64_t GPUTimestampFrames::ToCpuTime(const ClockCalibration& calibration, uint64_t gpuTimestamp, uint64_t frequency)
+{
+	if (gpuTimestamp >= calibration.gpuTimestamp)
+		return calibration.cpuTime + TicksToNanoseconds(gpuTimestamp - calibration.gpuTimestamp, frequency);
+
+	// queries written before calibration was taken
+	uint64_t nanoseconds = TicksToNanoseconds(calibration.gpuTimestamp - gpuTimestamp, frequency);
+
+	return calibration.cpuTime > nanoseconds ? calibration.cpuTime - nanoseconds : 0;
+}
\ No newline at end of file
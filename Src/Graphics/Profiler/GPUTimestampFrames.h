@@ -0,0 +1,89 @@
+#pragma once
+#include "Includes/CppIncludes.h"
+
+#include <cstring>
+
+// assigns timestamp queries to GPU zones of every frame in flight and turns timestamps read back from them into zone durations.
+// Every frame slot has its own range of queries, so frame can be resolved only after GPU finished it and before slot is recorded again.
+// Class doesn't touch any graphics objects, timestamps, their frequency and clock calibration are passed in
+class GPUTimestampFrames
+{
+public:
+	static constexpr unsigned int maxNameLength = 48;
+
+	// pair of GPU timestamp and CPU time taken at the same moment
+	struct ClockCalibration
+	{
+		uint64_t gpuTimestamp = 0;
+		uint64_t cpuTime = 0; // nanoseconds on steady clock
+	};
+
+	struct ResolvedZone
+	{
+		const char* name; // valid until the same frame slot gets recorded again
+		unsigned int depth;
+		uint64_t startTimestamp;
+		uint64_t endTimestamp;
+		uint64_t cpuStartTime; // nanoseconds on steady clock, through calibration of the frame
+		double durationMs;
+	};
+
+private:
+	struct RecordedZone
+	{
+		char name[maxNameLength];
+		unsigned int depth;
+		unsigned int beginQuery;
+		std::optional<unsigned int> endQuery;
+	};
+
+	struct FrameSlot
+	{
+		std::vector<RecordedZone> zones; // in order of begin, so parents are always before their children
+		unsigned int numQueries = 0;
+		size_t frameNumber = 0;
+		ClockCalibration calibration;
+	};
+
+public:
+	GPUTimestampFrames(unsigned int numFrameSlots, unsigned int maxQueriesPerFrame);
+
+public:
+	// forgets zones recorded in slot, they have to be resolved before
+	void BeginFrame(unsigned int frameSlot, size_t frameNumber, ClockCalibration calibration);
+
+	// returns query that has to be written with timestamp or std::nullopt when frame ran out of queries.
+	// Zone that didn't fit is skipped together with all its children
+	std::optional<unsigned int> BeginZone(const char* name);
+	std::optional<unsigned int> EndZone();
+
+	unsigned int GetCurrentFrameSlot() const;
+
+	// queries of slot start at GetFirstQuery() and are used continuously
+	unsigned int GetFirstQuery(unsigned int frameSlot) const;
+	unsigned int GetNumQueries(unsigned int frameSlot) const;
+
+	unsigned int GetNumQueriesTotal() const;
+
+	// timestamps are values of queries of the slot starting from its first query. Returns false when slot has nothing to resolve
+	// or its frame is newer than lastRetiredFrame, then GPU may still be writing the timestamps
+	bool ResolveFrame(unsigned int frameSlot, size_t lastRetiredFrame, std::span<const uint64_t> timestamps, uint64_t frequency);
+
+	// zones of last resolved frame, ordered the same way as they began
+	const std::vector<ResolvedZone>& GetResolvedZones() const;
+
+	// splits division so large tick counts don't overflow
+	static uint64_t TicksToNanoseconds(uint64_t ticks, uint64_t frequency);
+
+	static uint64_t ToCpuTime(const ClockCalibration& calibration, uint64_t gpuTimestamp, uint64_t frequency);
+
+private:
+	std::vector<FrameSlot> m_frameSlots;
+	unsigned int m_maxQueriesPerFrame;
+	unsigned int m_currentFrameSlot = 0;
+
+	std::vector<unsigned int> m_openZones;
+	unsigned int m_droppedDepth = 0;
+
+	std::vector<ResolvedZone> m_resolvedZones;
+};
\ No newline at end of file
@@ -0,0 +1,490 @@
+#include "MemoryTracker.h"
+
+#include <imgui.h>
+
+namespace
+{
+	thread_local std::string_view currentOwner = "Unassigned";
+
+	float ToMegabytes(size_t bytes)
+	{
+		return float(bytes) / (1024.0f * 1024.0f);
+	}
+
+	// owners are often file paths, which contain backslashes
+	void WriteJsonString(std::ofstream& file, std::string_view text)
+	{
+		file << "\"";
+
+		for (char character : text)
+		{
+			if (character == '\\' || character == '"')
+				file << "\\";
+
+			file << character;
+		}
+
+		file << "\"";
+	}
+}
+
+MemoryOwnerScope::MemoryOwnerScope(std::string_view owner)
+	:
+	m_previousOwner(currentOwner)
+{
+	currentOwner = owner;
+}
+
+MemoryOwnerScope::~MemoryOwnerScope()
+{
+	currentOwner = m_previousOwner;
+}
+
+MemoryTracker::Allocation::Allocation(uint32_t id, size_t bytes)
+	:
+	m_id(id),
+	m_bytes(bytes)
+{
+
+}
+
+MemoryTracker::Allocation::~Allocation()
+{
+	if (m_id != 0)
+		MemoryTracker::Get().Free(m_id);
+}
+
+MemoryTracker::Allocation::Allocation(Allocation&& other) noexcept
+	:
+	m_id(other.m_id),
+	m_bytes(other.m_bytes)
+{
+	other.m_id = 0;
+	other.m_bytes = 0;
+}
+
+MemoryTracker::Allocation& MemoryTracker::Allocation::operator=(Allocation&& other) noexcept
+{
+	if (this == &other)
+		return *this;
+
+	if (m_id != 0)
+		MemoryTracker::Get().Free(m_id);
+
+	m_id = other.m_id;
+	m_bytes = other.m_bytes;
+
+	other.m_id = 0;
+	other.m_bytes = 0;
+
+	return *this;
+}
+
+size_t MemoryTracker::Allocation::GetByteSize() const
+{
+	return m_bytes;
+}
+
+void MemoryTracker::Allocation::MarkPendingDeletion()
+{
+	if (m_id != 0)
+		MemoryTracker::Get().MarkPendingDeletion(m_id);
+}
+
+float MemoryTracker::SuballocatorStats::GetFragmentation() const
+{
+	if (freeBytes == 0)
+		return 0.0f;
+
+	return 1.0f - float(largestFreeChunk) / float(freeBytes);
+}
+
+MemoryTracker& MemoryTracker::Get()
+{
+	// never destroyed, static resource lists release their allocations after other statics are gone
+	static MemoryTracker* tracker = new MemoryTracker();
+	return *tracker;
+}
+
+MemoryTracker::Allocation MemoryTracker::Track(MemoryCategory category, size_t bytes)
+{
+	MemoryTracker& tracker = Get();
+
+	std::lock_guard<std::mutex> lock(tracker.m_mutex);
+
+	uint32_t id = tracker.m_nextId++;
+	std::string_view owner = *tracker.m_owners.emplace(currentOwner).first;
+
+	tracker.m_allocations.emplace(id, AllocationInfo{ category, owner, tracker.m_frame, bytes });
+
+	size_t& liveBytes = tracker.m_liveBytes[size_t(category)];
+	liveBytes += bytes;
+
+	tracker.m_peakBytes[size_t(category)] = std::max(tracker.m_peakBytes[size_t(category)], liveBytes);
+
+	size_t totalBytes = 0;
+
+	for (size_t categoryBytes : tracker.m_liveBytes)
+		totalBytes += categoryBytes;
+
+	tracker.m_peakTotalBytes = std::max(tracker.m_peakTotalBytes, totalBytes);
+
+	return Allocation(id, bytes);
+}
+
+const char* MemoryTracker::GetCategoryName(MemoryCategory category)
+{
+	switch (category)
+	{
+	case MemoryCategory::Buffers:			return "Buffers";
+	case MemoryCategory::UploadBuffers:		return "Upload buffers";
+	case MemoryCategory::Textures:			return "Textures";
+	case MemoryCategory::RenderTargets:		return "Render targets";
+	case MemoryCategory::DescriptorHeaps:	return "Descriptor heaps";
+	case MemoryCategory::StagingImages:		return "Staging images";
+	default:								return "Unknown";
+	}
+}
+
+void MemoryTracker::SetSuballocatorStats(const char* name, const SuballocatorStats& stats)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	for (auto& [suballocatorName, suballocatorStats] : m_suballocators)
+	{
+		if (suballocatorName == name || std::strcmp(suballocatorName, name) == 0)
+		{
+			suballocatorStats = stats;
+			return;
+		}
+	}
+
+	m_suballocators.push_back({ name, stats });
+}
+
+void MemoryTracker::EndFrame()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	for (unsigned int category = 0; category < numCategories; category++)
+	{
+		m_lastFrameOverBudget[category] = m_budgets[category].has_value() && m_liveBytes[category] > m_budgets[category].value();
+
+		if (m_lastFrameOverBudget[category])
+			m_numBudgetWarnings[category]++;
+	}
+
+	m_frame++;
+}
+
+void MemoryTracker::Draw()
+{
+	if (!ImGui::Begin("Memory"))
+	{
+		ImGui::End();
+		return;
+	}
+
+	if (ImGui::Button("Save snapshot"))
+		SaveSnapshot("memory_snapshot.json");
+
+	if (!m_lastSnapshotResult.empty())
+		ImGui::Text("%s", m_lastSnapshotResult.c_str());
+
+	std::vector<OwnerBytes> ownerBytes = GetOwnerBytes();
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (ImGui::BeginTable("MemoryCategoriesTable", 4, ImGuiTableFlags_Resizable | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_RowBg))
+	{
+		ImGui::TableSetupColumn("Category");
+		ImGui::TableSetupColumn("Live MB");
+		ImGui::TableSetupColumn("Peak MB");
+		ImGui::TableSetupColumn("Budget MB");
+		ImGui::TableHeadersRow();
+
+		size_t totalBytes = 0;
+
+		for (unsigned int category = 0; category < numCategories; category++)
+		{
+			totalBytes += m_liveBytes[category];
+
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::Text("%s", GetCategoryName(MemoryCategory(category)));
+
+			ImGui::TableNextColumn();
+
+			// categories over budget are shown red together with number of frames that went over
+			if (m_lastFrameOverBudget[category])
+				ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%.2f (%u)", ToMegabytes(m_liveBytes[category]), m_numBudgetWarnings[category]);
+			else
+				ImGui::Text("%.2f", ToMegabytes(m_liveBytes[category]));
+
+			ImGui::TableNextColumn();
+			ImGui::Text("%.2f", ToMegabytes(m_peakBytes[category]));
+
+			ImGui::TableNextColumn();
+
+			if (m_budgets[category].has_value())
+				ImGui::Text("%.2f", ToMegabytes(m_budgets[category].value()));
+			else
+				ImGui::Text("-");
+		}
+
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		ImGui::Text("Total");
+		ImGui::TableNextColumn();
+		ImGui::Text("%.2f", ToMegabytes(totalBytes));
+		ImGui::TableNextColumn();
+		ImGui::Text("%.2f", ToMegabytes(m_peakTotalBytes));
+		ImGui::TableNextColumn();
+
+		ImGui::EndTable();
+	}
+
+	ImGui::Text("Pending deletion: %.2f MB", ToMegabytes(m_pendingDeletionBytes));
+
+	if (ImGui::CollapsingHeader("Suballocators") &&
+		ImGui::BeginTable("MemorySuballocatorsTable", 6, ImGuiTableFlags_Resizable | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_RowBg))
+	{
+		ImGui::TableSetupColumn("Suballocator");
+		ImGui::TableSetupColumn("Capacity MB");
+		ImGui::TableSetupColumn("Used end MB");
+		ImGui::TableSetupColumn("Free MB");
+		ImGui::TableSetupColumn("Free chunks");
+		ImGui::TableSetupColumn("Fragmentation");
+		ImGui::TableHeadersRow();
+
+		for (const auto& [name, stats] : m_suballocators)
+		{
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::Text("%s", name);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.2f", ToMegabytes(stats.capacity));
+			ImGui::TableNextColumn();
+			ImGui::Text("%.2f", ToMegabytes(stats.usedEnd));
+			ImGui::TableNextColumn();
+			ImGui::Text("%.2f", ToMegabytes(stats.freeBytes));
+			ImGui::TableNextColumn();
+			ImGui::Text("%u", stats.numFreeChunks);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f%%", stats.GetFragmentation() * 100.0f);
+		}
+
+		ImGui::EndTable();
+	}
+
+	if (ImGui::CollapsingHeader("Owners") &&
+		ImGui::BeginTable("MemoryOwnersTable", numCategories + 2, ImGuiTableFlags_Resizable | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollX))
+	{
+		ImGui::TableSetupColumn("Owner");
+		ImGui::TableSetupColumn("Total MB");
+
+		for (unsigned int category = 0; category < numCategories; category++)
+			ImGui::TableSetupColumn(GetCategoryName(MemoryCategory(category)));
+
+		ImGui::TableHeadersRow();
+
+		for (const OwnerBytes& owner : ownerBytes)
+		{
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::Text("%.*s", int(owner.owner.size()), owner.owner.data());
+			ImGui::TableNextColumn();
+			ImGui::Text("%.2f", ToMegabytes(owner.total));
+
+			for (unsigned int category = 0; category < numCategories; category++)
+			{
+				ImGui::TableNextColumn();
+				ImGui::Text("%.2f", ToMegabytes(owner.bytes[category]));
+			}
+		}
+
+		ImGui::EndTable();
+	}
+
+	ImGui::End();
+}
+
+void MemoryTracker::SetBudget(MemoryCategory category, size_t maxBytes)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_budgets[size_t(category)] = maxBytes;
+	m_numBudgetWarnings[size_t(category)] = 0;
+}
+
+void MemoryTracker::ClearBudgets()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_budgets = {};
+	m_numBudgetWarnings = {};
+	m_lastFrameOverBudget = {};
+}
+
+unsigned int MemoryTracker::GetNumBudgetWarnings(MemoryCategory category) const
+{
+	return m_numBudgetWarnings[size_t(category)];
+}
+
+MemoryTracker::Bytes MemoryTracker::GetLiveBytes()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_liveBytes;
+}
+
+MemoryTracker::Bytes MemoryTracker::GetPeakBytes()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_peakBytes;
+}
+
+size_t MemoryTracker::GetPeakTotalBytes()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_peakTotalBytes;
+}
+
+size_t MemoryTracker::GetPendingDeletionBytes()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_pendingDeletionBytes;
+}
+
+bool MemoryTracker::SaveSnapshot(const std::filesystem::path& path)
+{
+	std::ofstream file(path);
+
+	if (!file.is_open())
+	{
+		m_lastSnapshotResult = "Failed to open " + path.string();
+		return false;
+	}
+
+	std::vector<OwnerBytes> ownerBytes = GetOwnerBytes();
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	file << "{\n\"frame\":" << m_frame << ",\n\"categories\":[";
+
+	for (unsigned int category = 0; category < numCategories; category++)
+	{
+		file << (category == 0 ? "\n" : ",\n") << "{\"name\":\"" << GetCategoryName(MemoryCategory(category)) << "\""
+			<< ",\"liveBytes\":" << m_liveBytes[category]
+			<< ",\"peakBytes\":" << m_peakBytes[category];
+
+		if (m_budgets[category].has_value())
+			file << ",\"budgetBytes\":" << m_budgets[category].value();
+
+		file << ",\"budgetWarnings\":" << m_numBudgetWarnings[category] << "}";
+	}
+
+	file << "\n],\n\"peakTotalBytes\":" << m_peakTotalBytes << ",\n\"pendingDeletionBytes\":" << m_pendingDeletionBytes << ",\n\"suballocators\":[";
+
+	for (size_t i = 0; i < m_suballocators.size(); i++)
+	{
+		const auto& [name, stats] = m_suballocators[i];
+
+		file << (i == 0 ? "\n" : ",\n") << "{\"name\":\"" << name << "\""
+			<< ",\"capacityBytes\":" << stats.capacity
+			<< ",\"usedEndBytes\":" << stats.usedEnd
+			<< ",\"freeBytes\":" << stats.freeBytes
+			<< ",\"largestFreeChunkBytes\":" << stats.largestFreeChunk
+			<< ",\"numFreeChunks\":" << stats.numFreeChunks
+			<< ",\"fragmentation\":" << stats.GetFragmentation() << "}";
+	}
+
+	file << "\n],\n\"owners\":[";
+
+	for (size_t i = 0; i < ownerBytes.size(); i++)
+	{
+		file << (i == 0 ? "\n" : ",\n") << "{\"name\":";
+		WriteJsonString(file, ownerBytes[i].owner);
+		file << ",\"totalBytes\":" << ownerBytes[i].total;
+
+		for (unsigned int category = 0; category < numCategories; category++)
+			if (ownerBytes[i].bytes[category] != 0)
+				file << ",\"" << GetCategoryName(MemoryCategory(category)) << "\":" << ownerBytes[i].bytes[category];
+
+		file << "}";
+	}
+
+	file << "\n],\n\"allocations\":[";
+
+	bool first = true;
+
+	for (const auto& [id, allocation] : m_allocations)
+	{
+		file << (first ? "\n" : ",\n") << "{\"category\":\"" << GetCategoryName(allocation.category) << "\",\"owner\":";
+		WriteJsonString(file, allocation.owner);
+		file << ",\"frame\":" << allocation.frame << ",\"bytes\":" << allocation.bytes << ",\"pendingDeletion\":" << (allocation.pendingDeletion ? "true" : "false") << "}";
+
+		first = false;
+	}
+
+	file << "\n]\n}\n";
+
+	m_lastSnapshotResult = "Saved " + std::to_string(m_allocations.size()) + " allocations to " + path.string();
+
+	return true;
+}
+
+void MemoryTracker::Free(uint32_t id)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	auto found = m_allocations.find(id);
+
+	// called from destructors, so missing allocation is ignored instead of thrown
+	if (found == m_allocations.end())
+		return;
+
+	m_liveBytes[size_t(found->second.category)] -= found->second.bytes;
+
+	if (found->second.pendingDeletion)
+		m_pendingDeletionBytes -= found->second.bytes;
+
+	m_allocations.erase(found);
+}
+
+void MemoryTracker::MarkPendingDeletion(uint32_t id)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	auto found = m_allocations.find(id);
+
+	if (found == m_allocations.end() || found->second.pendingDeletion)
+		return;
+
+	found->second.pendingDeletion = true;
+	m_pendingDeletionBytes += found->second.bytes;
+}
+
+std::vector<MemoryTracker::OwnerBytes> MemoryTracker::GetOwnerBytes()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	std::unordered_map<std::string_view, OwnerBytes> owners;
+
+	for (const auto& [id, allocation] : m_allocations)
+	{
+		OwnerBytes& owner = owners[allocation.owner];
+		owner.owner = allocation.owner;
+		owner.bytes[size_t(allocation.category)] += allocation.bytes;
+		owner.total += allocation.bytes;
+	}
+
+	std::vector<OwnerBytes> result;
+	result.reserve(owners.size());
+
+	for (auto& [name, owner] : owners)
+		result.push_back(owner);
+
+	std::sort(result.begin(), result.end(), [](const OwnerBytes& left, const OwnerBytes& right) { return left.total > right.total; });
+
+	return result;
+}
\ No newline at end of file
@@ -0,0 +1,161 @@
+#pragma once
+#include "Includes/CppIncludes.h"
+
+#include <unordered_set>
+
+enum class MemoryCategory : uint8_t
+{
+	Buffers,
+	UploadBuffers,
+	Textures,
+	RenderTargets, // render targets and depth stencils
+	DescriptorHeaps,
+	StagingImages, // images kept in system memory while textures are processed
+	Count
+};
+
+// sets owner of every allocation tracked on this thread until the scope ends. Scopes can be nested,
+// the innermost one wins. Allocations made outside of any scope are owned by "Unassigned"
+class MemoryOwnerScope
+{
+public:
+	MemoryOwnerScope(std::string_view owner);
+	~MemoryOwnerScope();
+
+	MemoryOwnerScope(const MemoryOwnerScope&) = delete;
+
+private:
+	std::string_view m_previousOwner;
+};
+
+// accounting of memory held by GPU resources, descriptor heaps and CPU staging images. Every allocation is tagged with category,
+// owner and frame it was made in. Allocations are tracked from any thread, they are released when their handle is destroyed,
+// which for resources handed to FrameResourceDeleter happens only after frames in flight are done with them.
+// Sizes come from device, so null device used by headless benchmarks is accounted for the same way
+class MemoryTracker
+{
+public:
+	static constexpr unsigned int numCategories = unsigned int(MemoryCategory::Count);
+
+	using Bytes = std::array<size_t, numCategories>;
+
+	// releases tracked allocation when destroyed
+	class Allocation
+	{
+	public:
+		Allocation() = default;
+		~Allocation();
+
+		Allocation(Allocation&& other) noexcept;
+		Allocation& operator=(Allocation&& other) noexcept;
+
+		Allocation(const Allocation&) = delete;
+		Allocation& operator=(const Allocation&) = delete;
+
+	public:
+		size_t GetByteSize() const;
+
+		// allocation is still alive, but is only waiting for GPU to finish with it
+		void MarkPendingDeletion();
+
+	private:
+		friend class MemoryTracker;
+
+		Allocation(uint32_t id, size_t bytes);
+
+	private:
+		uint32_t m_id = 0;
+		size_t m_bytes = 0;
+	};
+
+	// state of GraphicsBufferSuballocator, pushed every frame
+	struct SuballocatorStats
+	{
+		size_t capacity = 0; // bytes of current buffer
+		size_t usedEnd = 0; // end of last chunk ever allocated, buffer grows when it goes over capacity
+		size_t freeBytes = 0; // freed chunks and space left after end
+		size_t largestFreeChunk = 0;
+		unsigned int numFreeChunks = 0;
+
+		// 0 when all free space is one chunk, close to 1 when it's scattered into small ones
+		float GetFragmentation() const;
+	};
+
+public:
+	static MemoryTracker& Get();
+
+	static Allocation Track(MemoryCategory category, size_t bytes);
+
+	static const char* GetCategoryName(MemoryCategory category);
+
+public:
+	// name has to outlive MemoryTracker
+	void SetSuballocatorStats(const char* name, const SuballocatorStats& stats);
+
+	// checks budgets against live bytes of the frame
+	void EndFrame();
+
+	void Draw();
+
+	// frames whose live bytes go over budget are counted as warnings
+	void SetBudget(MemoryCategory category, size_t maxBytes);
+	void ClearBudgets();
+
+	unsigned int GetNumBudgetWarnings(MemoryCategory category) const;
+
+	Bytes GetLiveBytes();
+	Bytes GetPeakBytes();
+	size_t GetPeakTotalBytes();
+	size_t GetPendingDeletionBytes();
+
+	// writes totals, suballocators and live bytes grouped by owner to JSON file
+	bool SaveSnapshot(const std::filesystem::path& path);
+
+private:
+	MemoryTracker() = default;
+
+	void Free(uint32_t id);
+	void MarkPendingDeletion(uint32_t id);
+
+private:
+	struct AllocationInfo
+	{
+		MemoryCategory category;
+		std::string_view owner;
+		unsigned int frame;
+		size_t bytes;
+		bool pendingDeletion = false;
+	};
+
+	struct OwnerBytes
+	{
+		std::string_view owner;
+		Bytes bytes = {};
+		size_t total = 0;
+	};
+
+	// live bytes of every owner, biggest first
+	std::vector<OwnerBytes> GetOwnerBytes();
+
+private:
+	// allocations are tracked by loading threads and released by deletion thread
+	std::mutex m_mutex;
+
+	std::unordered_map<uint32_t, AllocationInfo> m_allocations;
+	std::unordered_set<std::string> m_owners; // owner names are interned, allocations only point to them
+	uint32_t m_nextId = 1;
+	unsigned int m_frame = 0;
+
+	Bytes m_liveBytes = {};
+	Bytes m_peakBytes = {};
+	size_t m_peakTotalBytes = 0;
+	size_t m_pendingDeletionBytes = 0;
+
+	std::vector<std::pair<const char*, SuballocatorStats>> m_suballocators;
+
+	std::array<std::optional<size_t>, numCategories> m_budgets = {};
+	std::array<unsigned int, numCategories> m_numBudgetWarnings = {};
+	std::array<bool, numCategories> m_lastFrameOverBudget = {};
+
+	std::string m_lastSnapshotResult;
+};
\ No newline at end of file
@@ -1,9 +1,15 @@
 #include "Profiler.h"
+#include "ZoneProfiler.h"
+#include "RenderStats.h"
+#include "CommandStream.h"
+#include "MemoryTracker.h"
 
 #include <imgui.h>
 
 void Profiler::Initialize(Graphics& graphics)
 {
+	ZoneProfiler::SetThreadName("Main");
+
 	m_gpuProfiler.Initialize(graphics);
 }
 
@@ -28,11 +34,17 @@ void Profiler::Draw()
 		ImGui::Text("FPS: %.1f", m_fpsSmoothed.value);
 		ImGui::Text("CPU: %.2f ms", m_cpuSmoothedData.value * 1000.0f);
 		ImGui::Text("GPU: %.2f ms", m_gpuSmoothedData.value * 1000.0f);
+		ImGui::Text("Upload: %.2f KB", float(m_lastFrameUploadedBytes) / 1024.0f);
 	}
 
 	ImGui::End();
 
 	ImGui::PopStyleColor();
+
+	ZoneProfiler::Get().Draw();
+	RenderStats::Get().Draw();
+	CommandStream::Get().Draw();
+	MemoryTracker::Get().Draw();
 }
 
 void Profiler::UpdateData()
@@ -49,12 +61,37 @@ void Profiler::UpdateData()
 
 void Profiler::SetBeginData(Graphics& graphics, CommandList* commandList, float deltaTime)
 {
-	m_cpuProfiler.SetBeginData(deltaTime);
+	// GPU zones read back now are counted into the frame that is closed
 	m_gpuProfiler.SetBeginData(graphics, commandList);
+
+	ZoneProfiler::Get().EndFrame();
+	RenderStats::Get().EndFrame();
+	CommandStream::Get().EndFrame();
+	MemoryTracker::Get().EndFrame();
+
+	m_cpuProfiler.SetBeginData(deltaTime);
+
+	m_lastFrameUploadedBytes = m_uploadedBytes;
+	m_uploadedBytes = 0;
 }
 
 void Profiler::SetEndData(Graphics& graphics, CommandList* commandList, float deltaTime)
 {
 	m_cpuProfiler.SetEndData(deltaTime);
 	m_gpuProfiler.SetEndData(graphics, commandList);
+}
+
+void Profiler::BeginGPUZone(Graphics& graphics, CommandList* commandList, const char* name)
+{
+	m_gpuProfiler.BeginZone(graphics, commandList, name);
+}
+
+void Profiler::EndGPUZone(Graphics& graphics, CommandList* commandList)
+{
+	m_gpuProfiler.EndZone(graphics, commandList);
+}
+
+void Profiler::AddUploadedBytes(size_t bytes)
+{
+	m_uploadedBytes += bytes;
 }
\ No newline at end of file
@@ -25,6 +25,13 @@ public:
 	void SetBeginData(Graphics& graphics, CommandList* commandList, float deltaTime);
 	void SetEndData(Graphics& graphics, CommandList* commandList, float deltaTime);
 
+	// GPU zones are shown with delay of frames in flight
+	void BeginGPUZone(Graphics& graphics, CommandList* commandList, const char* name);
+	void EndGPUZone(Graphics& graphics, CommandList* commandList);
+
+	// bytes written by CPU to upload memory during current frame
+	void AddUploadedBytes(size_t bytes);
+
 	template<class T>
 	void SmoothData(SmoothedData<T>& val, T newVal)
 	{
@@ -48,4 +55,7 @@ private:
 	SmoothedData<float> m_fpsSmoothed = SmoothedData(0.0f);
 	SmoothedData<float> m_cpuSmoothedData = SmoothedData(0.0f);	// seconds
 	SmoothedData<double> m_gpuSmoothedData = SmoothedData(0.0); // seconds
+
+	size_t m_uploadedBytes = 0;
+	size_t m_lastFrameUploadedBytes = 0;
 };
\ No newline at end of file
@@ -0,0 +1,266 @@
+#include "RenderStats.h"
+
+#include <imgui.h>
+
+RenderStats::RenderStats()
+{
+	m_scopeNames[0] = "Outside of passes";
+}
+
+RenderStats& RenderStats::Get()
+{
+	static RenderStats stats;
+	return stats;
+}
+
+const char* RenderStats::GetCounterName(RenderCounter counter)
+{
+	switch (counter)
+	{
+	case RenderCounter::DrawCalls:				return "Draws";
+	case RenderCounter::Instances:				return "Instances";
+	case RenderCounter::Dispatches:				return "Dispatches";
+	case RenderCounter::PipelineStates:			return "PSO sets";
+	case RenderCounter::PipelineStatesFiltered:	return "PSO filtered";
+	case RenderCounter::RootSignatures:			return "Root signature sets";
+	case RenderCounter::RootSignaturesFiltered:	return "Root signature filtered";
+	case RenderCounter::RootParameters:			return "Root param binds";
+	case RenderCounter::RootParametersFiltered:	return "Root param filtered";
+	case RenderCounter::ResourceBarriers:		return "Barriers";
+	case RenderCounter::CopyCalls:				return "Copy calls";
+	case RenderCounter::UploadedBytes:			return "Uploaded bytes";
+	case RenderCounter::DroppedLightIndices:	return "Dropped light indices";
+	default:									return "Unknown";
+	}
+}
+
+void RenderStats::BeginPass(const char* name)
+{
+	for (unsigned int scope = 1; scope < m_numScopes; scope++)
+	{
+		if (m_scopeNames[scope] == name || std::strcmp(m_scopeNames[scope], name) == 0)
+		{
+			m_currentScope = scope;
+			return;
+		}
+	}
+
+	// passes over the limit share one scope
+	if (m_numScopes == maxScopes)
+	{
+		m_scopeNames[maxScopes - 1] = "Other passes";
+		m_currentScope = maxScopes - 1;
+		return;
+	}
+
+	m_scopeNames[m_numScopes] = name;
+	m_currentScope = m_numScopes;
+	m_numScopes++;
+}
+
+void RenderStats::EndPass()
+{
+	m_currentScope = 0;
+}
+
+void RenderStats::EndFrame()
+{
+	m_lastFrameTotals = {};
+
+	for (unsigned int scope = 0; scope < m_numScopes; scope++)
+	{
+		const Counters& counters = m_currentCounters[scope];
+
+		m_lastFrameActive[scope] = std::any_of(counters.begin(), counters.end(), [](uint64_t value) { return value != 0; });
+
+		for (unsigned int counter = 0; counter < numCounters; counter++)
+			m_lastFrameTotals[counter] += counters[counter];
+
+		if (m_dumpFramesLeft > 0 && m_lastFrameActive[scope])
+			m_dumpedScopes.push_back({ m_dumpFrame, scope, counters });
+	}
+
+	for (unsigned int counter = 0; counter < numCounters; counter++)
+	{
+		m_lastFrameOverThreshold[counter] = m_thresholds[counter].has_value() && m_lastFrameTotals[counter] > m_thresholds[counter].value();
+
+		if (m_lastFrameOverThreshold[counter])
+			m_numRegressions[counter]++;
+	}
+
+	m_lastFrameCounters = m_currentCounters;
+	m_currentCounters = {};
+
+	if (m_dumpFramesLeft > 0)
+	{
+		m_dumpFrame++;
+		m_dumpFramesLeft--;
+
+		if (m_dumpFramesLeft == 0)
+			SaveDump();
+	}
+}
+
+void RenderStats::Draw()
+{
+	if (!ImGui::Begin("Render Stats"))
+	{
+		ImGui::End();
+		return;
+	}
+
+	if (!IsDumping())
+	{
+		if (ImGui::Button("Dump 120 frames"))
+			StartDump(120, "render_stats");
+	}
+	else
+	{
+		ImGui::Text("Dumping, %u frames left", m_dumpFramesLeft);
+	}
+
+	if (!m_lastDumpResult.empty())
+		ImGui::Text("%s", m_lastDumpResult.c_str());
+
+	if (ImGui::BeginTable("RenderStatsTable", numCounters + 1, ImGuiTableFlags_Resizable | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollX))
+	{
+		ImGui::TableSetupColumn("Pass");
+
+		for (unsigned int counter = 0; counter < numCounters; counter++)
+			ImGui::TableSetupColumn(GetCounterName(RenderCounter(counter)));
+
+		ImGui::TableHeadersRow();
+
+		for (unsigned int scope = 0; scope < m_numScopes; scope++)
+		{
+			if (!m_lastFrameActive[scope])
+				continue;
+
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::Text("%s", m_scopeNames[scope]);
+
+			for (unsigned int counter = 0; counter < numCounters; counter++)
+			{
+				ImGui::TableNextColumn();
+				ImGui::Text("%llu", (unsigned long long)m_lastFrameCounters[scope][counter]);
+			}
+		}
+
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		ImGui::Text("Frame");
+
+		for (unsigned int counter = 0; counter < numCounters; counter++)
+		{
+			ImGui::TableNextColumn();
+
+			// totals over threshold are shown red together with number of frames that went over
+			if (m_lastFrameOverThreshold[counter])
+				ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%llu (%u)", (unsigned long long)m_lastFrameTotals[counter], m_numRegressions[counter]);
+			else
+				ImGui::Text("%llu", (unsigned long long)m_lastFrameTotals[counter]);
+		}
+
+		ImGui::EndTable();
+	}
+
+	ImGui::End();
+}
+
+void RenderStats::SetThreshold(RenderCounter counter, uint64_t maxPerFrame)
+{
+	m_thresholds[size_t(counter)] = maxPerFrame;
+	m_numRegressions[size_t(counter)] = 0;
+}
+
+void RenderStats::ClearThresholds()
+{
+	m_thresholds = {};
+	m_numRegressions = {};
+	m_lastFrameOverThreshold = {};
+}
+
+unsigned int RenderStats::GetNumRegressions(RenderCounter counter) const
+{
+	return m_numRegressions[size_t(counter)];
+}
+
+const RenderStats::Counters& RenderStats::GetLastFrameTotals() const
+{
+	return m_lastFrameTotals;
+}
+
+std::optional<RenderStats::Counters> RenderStats::GetLastFrameCounters(std::string_view passName) const
+{
+	for (unsigned int scope = 0; scope < m_numScopes; scope++)
+		if (m_lastFrameActive[scope] && passName == m_scopeNames[scope])
+			return m_lastFrameCounters[scope];
+
+	return std::nullopt;
+}
+
+void RenderStats::StartDump(unsigned int numFrames, const std::filesystem::path& path)
+{
+	m_dumpFramesLeft = numFrames;
+	m_dumpFrame = 0;
+	m_dumpPath = path;
+	m_dumpedScopes.clear();
+}
+
+bool RenderStats::IsDumping() const
+{
+	return m_dumpFramesLeft > 0;
+}
+
+void RenderStats::SaveDump()
+{
+	std::filesystem::path csvPath = m_dumpPath;
+	csvPath.replace_extension(".csv");
+
+	std::filesystem::path jsonPath = m_dumpPath;
+	jsonPath.replace_extension(".json");
+
+	std::ofstream csvFile(csvPath);
+	std::ofstream jsonFile(jsonPath);
+
+	if (!csvFile.is_open() || !jsonFile.is_open())
+	{
+		m_lastDumpResult = "Failed to open " + csvPath.string() + " or " + jsonPath.string();
+		return;
+	}
+
+	csvFile << "frame,pass";
+
+	for (unsigned int counter = 0; counter < numCounters; counter++)
+		csvFile << "," << GetCounterName(RenderCounter(counter));
+
+	csvFile << "\n";
+
+	jsonFile << "[";
+
+	for (size_t i = 0; i < m_dumpedScopes.size(); i++)
+	{
+		const DumpedScope& dumpedScope = m_dumpedScopes[i];
+
+		// pass names are C++ type names, they don't contain characters that need escaping
+		csvFile << dumpedScope.frame << "," << m_scopeNames[dumpedScope.scope];
+		jsonFile << (i == 0 ? "\n" : ",\n") << "{\"frame\":" << dumpedScope.frame << ",\"pass\":\"" << m_scopeNames[dumpedScope.scope] << "\"";
+
+		for (unsigned int counter = 0; counter < numCounters; counter++)
+		{
+			csvFile << "," << dumpedScope.counters[counter];
+			jsonFile << ",\"" << GetCounterName(RenderCounter(counter)) << "\":" << dumpedScope.counters[counter];
+		}
+
+		csvFile << "\n";
+		jsonFile << "}";
+	}
+
+	jsonFile << "\n]\n";
+
+	m_lastDumpResult = "Saved " + std::to_string(m_dumpFrame) + " frames to " + csvPath.string() + " and " + jsonPath.string();
+
+	m_dumpedScopes.clear();
+	m_dumpedScopes.shrink_to_fit();
+}
\ No newline at end of file
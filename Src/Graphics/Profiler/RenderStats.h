@@ -0,0 +1,101 @@
+#pragma once
+#include "Includes/CppIncludes.h"
+
+enum class RenderCounter : uint8_t
+{
+	DrawCalls,
+	Instances, // drawn by all draw calls, the same as draw calls when nothing is instanced
+	Dispatches,
+	PipelineStates,
+	PipelineStatesFiltered, // skipped by CommandListState because the same state was already set
+	RootSignatures,
+	RootSignaturesFiltered,
+	RootParameters,
+	RootParametersFiltered,
+	ResourceBarriers,
+	CopyCalls,
+	UploadedBytes,
+	DroppedLightIndices, // didn't fit into cluster light list, those lights are missing from lighting of their clusters
+	Count
+};
+
+// counters of work submitted by CPU, kept per render pass and per frame. Counting is just an increment,
+// so it stays on in release builds. Counters have to be touched only by render thread.
+// Totals can be compared against thresholds and dumped over several frames into CSV and JSON
+class RenderStats
+{
+public:
+	static constexpr unsigned int numCounters = unsigned int(RenderCounter::Count);
+	static constexpr unsigned int maxScopes = 64; // passes + work done outside of them
+
+	using Counters = std::array<uint64_t, numCounters>;
+
+public:
+	static RenderStats& Get();
+
+	static void Add(RenderCounter counter, uint64_t value = 1)
+	{
+		RenderStats& stats = Get();
+		stats.m_currentCounters[stats.m_currentScope][size_t(counter)] += value;
+	}
+
+	static const char* GetCounterName(RenderCounter counter);
+
+public:
+	// name has to outlive RenderStats, type names of passes are used
+	void BeginPass(const char* name);
+	void EndPass();
+
+	// moves counters of the frame into last frame values, checks thresholds and records dump
+	void EndFrame();
+
+	void Draw();
+
+	// frames whose total goes over maximum are counted as regressions
+	void SetThreshold(RenderCounter counter, uint64_t maxPerFrame);
+	void ClearThresholds();
+
+	unsigned int GetNumRegressions(RenderCounter counter) const;
+
+	const Counters& GetLastFrameTotals() const;
+
+	// std::nullopt when pass didn't run in last frame
+	std::optional<Counters> GetLastFrameCounters(std::string_view passName) const;
+
+	// records next numFrames frames and saves them to path with .csv and .json extensions
+	void StartDump(unsigned int numFrames, const std::filesystem::path& path);
+
+	bool IsDumping() const;
+
+private:
+	RenderStats();
+
+	void SaveDump();
+
+private:
+	struct DumpedScope
+	{
+		unsigned int frame;
+		unsigned int scope;
+		Counters counters;
+	};
+
+	std::array<const char*, maxScopes> m_scopeNames = {};
+	unsigned int m_numScopes = 1; // first scope gathers everything outside of passes
+	unsigned int m_currentScope = 0;
+
+	std::array<Counters, maxScopes> m_currentCounters = {};
+	std::array<Counters, maxScopes> m_lastFrameCounters = {};
+	std::array<bool, maxScopes> m_lastFrameActive = {};
+	Counters m_lastFrameTotals = {};
+
+	std::array<std::optional<uint64_t>, numCounters> m_thresholds = {};
+	std::array<unsigned int, numCounters> m_numRegressions = {};
+	std::array<bool, numCounters> m_lastFrameOverThreshold = {};
+
+	unsigned int m_dumpFramesLeft = 0;
+	unsigned int m_dumpFrame = 0;
+	std::filesystem::path m_dumpPath;
+	std::vector<DumpedScope> m_dumpedScopes;
+	std::string m_lastDumpResult;
+};
\ No newline at end of file
@@ -0,0 +1,508 @@
+#include "ZoneProfiler.h"
+
+#include <imgui.h>
+
+thread_local ZoneProfiler::ThreadBuffer* ZoneProfiler::s_threadBuffer = nullptr;
+
+namespace
+{
+	void CopyName(char (&destination)[ZoneProfiler::maxNameLength], const char* source)
+	{
+		size_t length = std::min(std::strlen(source), size_t(ZoneProfiler::maxNameLength - 1));
+
+		std::memcpy(destination, source, length);
+		destination[length] = '\0';
+	}
+
+	void WriteJsonString(std::ofstream& file, std::string_view text)
+	{
+		file << '"';
+
+		for (char character : text)
+		{
+			if (character == '"' || character == '\\')
+				file << '\\' << character;
+			else if (static_cast<unsigned char>(character) >= 0x20)
+				file << character;
+		}
+
+		file << '"';
+	}
+}
+
+ZoneProfiler::ZoneProfiler()
+	:
+	m_startTime(GetTimestamp())
+{
+
+}
+
+ZoneProfiler& ZoneProfiler::Get()
+{
+	static ZoneProfiler profiler;
+	return profiler;
+}
+
+void ZoneProfiler::BeginZone(const char* name)
+{
+	ThreadBuffer* buffer = Get().GetThreadBuffer();
+
+	if (buffer->droppedDepth > 0)
+	{
+		buffer->droppedDepth++;
+		return;
+	}
+
+	uint64_t writeIndex = buffer->writeIndex.load(std::memory_order_relaxed);
+	uint64_t usedEvents = writeIndex - buffer->readIndex.load(std::memory_order_acquire);
+
+	// zone gets in only if its end event and end events of all open zones will fit too
+	if (usedEvents + buffer->openDepth + 2 > eventsPerThread)
+	{
+		buffer->droppedDepth++;
+		buffer->numDroppedEvents.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	buffer->openDepth++;
+
+	ZoneEvent& event = buffer->events[writeIndex % eventsPerThread];
+	event.timestamp = GetTimestamp();
+	event.begin = true;
+	CopyName(event.name, name);
+
+	buffer->writeIndex.store(writeIndex + 1, std::memory_order_release);
+}
+
+void ZoneProfiler::EndZone()
+{
+	ThreadBuffer* buffer = Get().GetThreadBuffer();
+
+	if (buffer->droppedDepth > 0)
+	{
+		buffer->droppedDepth--;
+		return;
+	}
+
+	if (buffer->openDepth == 0)
+		return;
+
+	buffer->openDepth--;
+
+	uint64_t writeIndex = buffer->writeIndex.load(std::memory_order_relaxed);
+
+	ZoneEvent& event = buffer->events[writeIndex % eventsPerThread];
+	event.timestamp = GetTimestamp();
+	event.begin = false;
+
+	buffer->writeIndex.store(writeIndex + 1, std::memory_order_release);
+}
+
+void ZoneProfiler::SetThreadName(const char* name)
+{
+	ZoneProfiler& profiler = Get();
+	ThreadBuffer* buffer = profiler.GetThreadBuffer();
+
+	std::lock_guard<std::mutex> lock(profiler.m_threadsMutex);
+	CopyName(buffer->name, name);
+}
+
+void ZoneProfiler::EndFrame()
+{
+	std::lock_guard<std::mutex> lock(m_threadsMutex);
+
+	for (unsigned int threadIndex = 0; threadIndex < m_threadBuffers.size(); threadIndex++)
+		DrainThread(threadIndex);
+
+	for (ZoneNode& node : m_nodes)
+	{
+		node.lastCalls = node.frameCalls;
+
+		if (node.frameCalls == 0)
+			continue;
+
+		node.history[node.historyCount % historySize] = float(double(node.frameTime) / 1000000.0);
+		node.historyCount++;
+
+		node.frameTime = 0;
+		node.frameCalls = 0;
+	}
+}
+
+void ZoneProfiler::Draw()
+{
+	if (!ImGui::Begin("CPU Zones"))
+	{
+		ImGui::End();
+		return;
+	}
+
+	if (!m_capturing)
+	{
+		if (ImGui::Button("Start capture"))
+			BeginCapture();
+	}
+	else
+	{
+		if (ImGui::Button("Stop capture"))
+			EndCapture("cpu_trace.json");
+
+		ImGui::SameLine();
+		ImGui::Text("%u zones", unsigned int(m_capturedZones.size()));
+	}
+
+	if (!m_lastCaptureResult.empty())
+		ImGui::Text("%s", m_lastCaptureResult.c_str());
+
+	unsigned int numDroppedEvents = 0;
+
+	{
+		std::lock_guard<std::mutex> lock(m_threadsMutex);
+
+		for (const auto& buffer : m_threadBuffers)
+			numDroppedEvents += buffer->numDroppedEvents.load(std::memory_order_relaxed);
+	}
+
+	if (numDroppedEvents > 0)
+		ImGui::Text("Dropped events: %u", numDroppedEvents);
+
+	if (ImGui::BeginTable("CPUZonesTable", 6, ImGuiTableFlags_Resizable | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_RowBg))
+	{
+		ImGui::TableSetupColumn("Zone");
+		ImGui::TableSetupColumn("Calls");
+		ImGui::TableSetupColumn("Last ms");
+		ImGui::TableSetupColumn("Min ms");
+		ImGui::TableSetupColumn("Avg ms");
+		ImGui::TableSetupColumn("P99 ms");
+		ImGui::TableHeadersRow();
+
+		for (unsigned int rootNode : m_trackRootNodes)
+			DrawNode(rootNode);
+
+		ImGui::EndTable();
+	}
+
+	ImGui::End();
+}
+
+void ZoneProfiler::BeginCapture()
+{
+	m_capturedZones.clear();
+	m_capturing = true;
+}
+
+void ZoneProfiler::EndCapture(const std::filesystem::path& path)
+{
+	m_capturing = false;
+
+	std::ofstream file(path);
+
+	if (!file.is_open())
+	{
+		m_lastCaptureResult = "Failed to open " + path.string();
+		return;
+	}
+
+	file << "{\"traceEvents\":[";
+
+	bool firstEvent = true;
+
+	auto startEvent = [&]()
+		{
+			if (!firstEvent)
+				file << ",";
+
+			file << "\n";
+			firstEvent = false;
+		};
+
+	for (unsigned int track = 0; track < m_trackRootNodes.size(); track++)
+	{
+		startEvent();
+		file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << track << ",\"args\":{\"name\":";
+		WriteJsonString(file, m_nodes[m_trackRootNodes[track]].name);
+		file << "}}";
+	}
+
+	file << std::fixed << std::setprecision(3);
+
+	// complete events with timestamps and durations in microseconds
+	for (const CapturedZone& zone : m_capturedZones)
+	{
+		const ZoneNode& node = m_nodes[zone.node];
+
+		startEvent();
+		file << "{\"name\":";
+		WriteJsonString(file, node.name);
+		file << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << node.track
+			<< ",\"ts\":" << double(zone.start - m_startTime) / 1000.0
+			<< ",\"dur\":" << double(zone.duration) / 1000.0 << "}";
+	}
+
+	file << "\n]}\n";
+
+	m_lastCaptureResult = "Saved " + std::to_string(m_capturedZones.size()) + " zones to " + path.string();
+
+	m_capturedZones.clear();
+	m_capturedZones.shrink_to_fit();
+}
+
+bool ZoneProfiler::IsCapturing() const
+{
+	return m_capturing;
+}
+
+void ZoneProfiler::AddExternalZones(const char* trackName, std::span<const ExternalZone> zones)
+{
+	auto trackIt = std::find_if(m_externalTrackRootNodes.begin(), m_externalTrackRootNodes.end(), [&](unsigned int rootNode)
+		{
+			return m_nodes[rootNode].name == trackName;
+		});
+
+	unsigned int rootNode = 0;
+
+	if (trackIt != m_externalTrackRootNodes.end())
+	{
+		rootNode = *trackIt;
+	}
+	else
+	{
+		rootNode = AddTrack(trackName);
+		m_externalTrackRootNodes.push_back(rootNode);
+	}
+
+	std::array<unsigned int, maxDepth> parents;
+	unsigned int depth = 0;
+
+	for (const ExternalZone& zone : zones)
+	{
+		// parent of zone was skipped
+		if (zone.depth > depth || zone.depth >= maxDepth)
+			continue;
+
+		depth = zone.depth;
+
+		unsigned int parent = depth == 0 ? rootNode : parents[depth - 1];
+		unsigned int node = FindChild(parent, zone.name);
+
+		parents[depth] = node;
+		depth++;
+
+		AddZoneTime(node, zone.start, zone.duration);
+	}
+}
+
+std::optional<ZoneProfiler::ZoneStats> ZoneProfiler::GetZoneStats(std::string_view name) const
+{
+	for (const ZoneNode& node : m_nodes)
+		if (node.depth > 0 && node.name == name)
+			return CalculateStats(node);
+
+	return std::nullopt;
+}
+
+std::optional<ZoneProfiler::ZoneStats> ZoneProfiler::GetZoneStats(std::string_view trackName, std::string_view name) const
+{
+	for (const ZoneNode& node : m_nodes)
+		if (node.depth > 0 && node.name == name && m_nodes[m_trackRootNodes[node.track]].name == trackName)
+			return CalculateStats(node);
+
+	return std::nullopt;
+}
+
+ZoneProfiler::ThreadBuffer* ZoneProfiler::GetThreadBuffer()
+{
+	if (s_threadBuffer != nullptr)
+		return s_threadBuffer;
+
+	// only first zone of every thread takes the lock and allocates
+	std::lock_guard<std::mutex> lock(m_threadsMutex);
+
+	auto& buffer = m_threadBuffers.emplace_back(std::make_unique<ThreadBuffer>());
+
+	std::string defaultName = "Thread " + std::to_string(m_threadBuffers.size() - 1);
+	CopyName(buffer->name, defaultName.c_str());
+
+	s_threadBuffer = buffer.get();
+
+	return buffer.get();
+}
+
+void ZoneProfiler::DrainThread(unsigned int threadIndex)
+{
+	ThreadBuffer& buffer = *m_threadBuffers[threadIndex];
+
+	if (threadIndex >= m_threadStates.size())
+	{
+		m_threadStates.push_back({});
+		m_threadStates.back().rootNode = AddTrack(buffer.name);
+	}
+
+	ThreadState& threadState = m_threadStates[threadIndex];
+
+	if (m_nodes[threadState.rootNode].name != buffer.name)
+		m_nodes[threadState.rootNode].name = buffer.name;
+
+	uint64_t readIndex = buffer.readIndex.load(std::memory_order_relaxed);
+	uint64_t writeIndex = buffer.writeIndex.load(std::memory_order_acquire);
+
+	for (; readIndex < writeIndex; readIndex++)
+	{
+		const ZoneEvent& event = buffer.events[readIndex % eventsPerThread];
+
+		if (event.begin)
+		{
+			if (threadState.depth >= maxDepth)
+			{
+				threadState.overflowDepth++;
+				continue;
+			}
+
+			unsigned int parent = threadState.depth == 0 ? threadState.rootNode : threadState.openZones[threadState.depth - 1].node;
+
+			threadState.openZones[threadState.depth] = { event.timestamp, FindChild(parent, event.name) };
+			threadState.depth++;
+		}
+		else
+		{
+			if (threadState.overflowDepth > 0)
+			{
+				threadState.overflowDepth--;
+				continue;
+			}
+
+			// unbalanced end event
+			if (threadState.depth == 0)
+				continue;
+
+			threadState.depth--;
+
+			const OpenZone& openZone = threadState.openZones[threadState.depth];
+			uint64_t duration = event.timestamp - openZone.start;
+
+			AddZoneTime(openZone.node, openZone.start, duration);
+		}
+	}
+
+	buffer.readIndex.store(writeIndex, std::memory_order_release);
+}
+
+unsigned int ZoneProfiler::AddTrack(const char* name)
+{
+	ZoneNode rootNode = {};
+	rootNode.name = name;
+	rootNode.track = unsigned int(m_trackRootNodes.size());
+
+	unsigned int nodeIndex = unsigned int(m_nodes.size());
+
+	m_nodes.push_back(std::move(rootNode));
+	m_trackRootNodes.push_back(nodeIndex);
+
+	return nodeIndex;
+}
+
+unsigned int ZoneProfiler::FindChild(unsigned int parent, const char* name)
+{
+	for (unsigned int child : m_nodes[parent].children)
+		if (m_nodes[child].name == name)
+			return child;
+
+	ZoneNode node = {};
+	node.name = name;
+	node.parent = parent;
+	node.depth = m_nodes[parent].depth + 1;
+	node.track = m_nodes[parent].track;
+
+	unsigned int nodeIndex = unsigned int(m_nodes.size());
+
+	m_nodes.push_back(std::move(node));
+	m_nodes[parent].children.push_back(nodeIndex);
+
+	return nodeIndex;
+}
+
+void ZoneProfiler::AddZoneTime(unsigned int nodeIndex, uint64_t start, uint64_t duration)
+{
+	ZoneNode& node = m_nodes[nodeIndex];
+	node.frameTime += duration;
+	node.frameCalls++;
+
+	if (m_capturing)
+		m_capturedZones.push_back({ nodeIndex, start, duration });
+}
+
+ZoneProfiler::ZoneStats ZoneProfiler::CalculateStats(const ZoneNode& node) const
+{
+	ZoneStats stats = {};
+	stats.calls = node.lastCalls;
+
+	unsigned int numSamples = std::min(node.historyCount, historySize);
+
+	if (numSamples == 0)
+		return stats;
+
+	std::array<float, historySize> samples;
+	std::copy_n(node.history.begin(), numSamples, samples.begin());
+	std::sort(samples.begin(), samples.begin() + numSamples);
+
+	float sum = 0.0f;
+
+	for (unsigned int i = 0; i < numSamples; i++)
+		sum += samples[i];
+
+	stats.lastMs = node.history[(node.historyCount - 1) % historySize];
+	stats.minMs = samples[0];
+	stats.avgMs = sum / float(numSamples);
+	stats.p99Ms = samples[std::min(numSamples - 1, unsigned int(std::ceil(float(numSamples) * 0.99f)) - 1)];
+
+	return stats;
+}
+
+void ZoneProfiler::DrawNode(unsigned int nodeIndex)
+{
+	const ZoneNode& node = m_nodes[nodeIndex];
+
+	ImGui::TableNextRow();
+	ImGui::TableNextColumn();
+
+	ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_SpanFullWidth;
+
+	if (node.depth == 0)
+		flags |= ImGuiTreeNodeFlags_DefaultOpen;
+
+	if (node.children.empty())
+		flags |= ImGuiTreeNodeFlags_Leaf;
+
+	ImGui::PushID(int(nodeIndex));
+	const bool nodeExpanded = ImGui::TreeNodeEx(node.name.c_str(), flags);
+	ImGui::PopID();
+
+	if (node.depth > 0)
+	{
+		ZoneStats stats = CalculateStats(node);
+
+		ImGui::TableNextColumn();
+		ImGui::Text("%u", stats.calls);
+		ImGui::TableNextColumn();
+		ImGui::Text("%.3f", stats.lastMs);
+		ImGui::TableNextColumn();
+		ImGui::Text("%.3f", stats.minMs);
+		ImGui::TableNextColumn();
+		ImGui::Text("%.3f", stats.avgMs);
+		ImGui::TableNextColumn();
+		ImGui::Text("%.3f", stats.p99Ms);
+	}
+
+	if (!nodeExpanded)
+		return;
+
+	for (unsigned int child : node.children)
+		DrawNode(child);
+
+	ImGui::TreePop();
+}
+
+uint64_t ZoneProfiler::GetTimestamp()
+{
+	return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
\ No newline at end of file
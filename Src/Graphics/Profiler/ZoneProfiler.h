@@ -0,0 +1,178 @@
+#pragma once
+#include "Includes/CppIncludes.h"
+
+// engine side CPU instrumentation. Every thread records begin and end events of zones into its own ring, without locks or allocations.
+// Once per frame rings are drained into tree of zones per thread that keeps timing history of every zone.
+// Zones can be captured over several frames and saved in chrome trace format, that can be opened in chrome://tracing or Perfetto.
+// Zones timed elsewhere, like GPU passes, can be added as separate tracks
+class ZoneProfiler
+{
+public:
+	static constexpr unsigned int maxNameLength = 48;
+	static constexpr unsigned int eventsPerThread = 16384;
+	static constexpr unsigned int historySize = 128; // frames in which zone was active
+	static constexpr unsigned int maxDepth = 64;
+
+	struct ZoneStats
+	{
+		unsigned int calls = 0; // in last frame
+		float lastMs = 0.0f;
+		float minMs = 0.0f;
+		float avgMs = 0.0f;
+		float p99Ms = 0.0f;
+	};
+
+	struct ExternalZone
+	{
+		const char* name;
+		unsigned int depth; // zones have to be ordered so parents are before their children
+		uint64_t start; // nanoseconds on the same clock as std::chrono::steady_clock
+		uint64_t duration;
+	};
+
+private:
+	struct ZoneEvent
+	{
+		uint64_t timestamp; // nanoseconds
+		bool begin;
+		char name[maxNameLength];
+	};
+
+	// written only by owning thread and read only by thread that calls EndFrame()
+	struct ThreadBuffer
+	{
+		std::array<ZoneEvent, eventsPerThread> events;
+		std::atomic<uint64_t> writeIndex = 0;
+		std::atomic<uint64_t> readIndex = 0;
+		std::atomic<unsigned int> numDroppedEvents = 0;
+
+		unsigned int openDepth = 0; // end events of open zones always have reserved space
+		unsigned int droppedDepth = 0; // zones that didn't fit are skipped with all their children
+		char name[maxNameLength] = {}; // guarded by m_threadsMutex
+	};
+
+	struct OpenZone
+	{
+		uint64_t start;
+		unsigned int node;
+	};
+
+	struct ZoneNode
+	{
+		std::string name;
+		unsigned int parent = 0;
+		unsigned int depth = 0;
+		unsigned int track = 0; // thread or external track, id of thread in captures
+		std::vector<unsigned int> children;
+
+		uint64_t frameTime = 0; // nanoseconds
+		unsigned int frameCalls = 0;
+
+		std::array<float, historySize> history = {}; // milliseconds
+		unsigned int historyCount = 0;
+		unsigned int lastCalls = 0;
+	};
+
+	struct ThreadState
+	{
+		unsigned int rootNode = 0;
+		std::array<OpenZone, maxDepth> openZones;
+		unsigned int depth = 0;
+		unsigned int overflowDepth = 0;
+	};
+
+	struct CapturedZone
+	{
+		unsigned int node;
+		uint64_t start;
+		uint64_t duration;
+	};
+
+public:
+	static ZoneProfiler& Get();
+
+	// name is copied, so it doesn't need to outlive the zone
+	static void BeginZone(const char* name);
+	static void EndZone();
+
+	// has to be called by the thread that gets the name
+	static void SetThreadName(const char* name);
+
+public:
+	// drains events of all threads, has to be called once per frame and always from the same thread
+	void EndFrame();
+
+	void Draw();
+
+	void BeginCapture();
+
+	// saves zones that ended since BeginCapture()
+	void EndCapture(const std::filesystem::path& path);
+
+	bool IsCapturing() const;
+
+	// zones are counted into current frame, has to be called from the same thread as EndFrame()
+	void AddExternalZones(const char* trackName, std::span<const ExternalZone> zones);
+
+	// statistics of first zone with given name, mostly for benchmarks
+	std::optional<ZoneStats> GetZoneStats(std::string_view name) const;
+
+	// same as above, but only zones of track with given name, like "GPU"
+	std::optional<ZoneStats> GetZoneStats(std::string_view trackName, std::string_view name) const;
+
+private:
+	ZoneProfiler();
+
+	ThreadBuffer* GetThreadBuffer();
+
+	void DrainThread(unsigned int threadIndex);
+
+	unsigned int AddTrack(const char* name);
+
+	unsigned int FindChild(unsigned int parent, const char* name);
+
+	void AddZoneTime(unsigned int nodeIndex, uint64_t start, uint64_t duration);
+
+	ZoneStats CalculateStats(const ZoneNode& node) const;
+
+	void DrawNode(unsigned int nodeIndex);
+
+	static uint64_t GetTimestamp();
+
+private:
+	static thread_local ThreadBuffer* s_threadBuffer;
+
+	std::mutex m_threadsMutex;
+	std::vector<std::unique_ptr<ThreadBuffer>> m_threadBuffers;
+	std::vector<ThreadState> m_threadStates;
+
+	std::vector<ZoneNode> m_nodes;
+	std::vector<unsigned int> m_trackRootNodes;
+	std::vector<unsigned int> m_externalTrackRootNodes;
+
+	bool m_capturing = false;
+	std::vector<CapturedZone> m_capturedZones;
+
+	uint64_t m_startTime = 0;
+	std::string m_lastCaptureResult;
+};
+
+class ProfilerZoneScope
+{
+public:
+	ProfilerZoneScope(const char* name)
+	{
+		ZoneProfiler::BeginZone(name);
+	}
+
+	~ProfilerZoneScope()
+	{
+		ZoneProfiler::EndZone();
+	}
+};
+
+#define PROFILER_ZONE_CONCAT_INNER(a, b) a##b
+#define PROFILER_ZONE_CONCAT(a, b) PROFILER_ZONE_CONCAT_INNER(a, b)
+
+// zone that lasts until the end of current scope
+#define PROFILE_ZONE(name) ProfilerZoneScope PROFILER_ZONE_CONCAT(profilerZone, __LINE__)(name)
\ No newline at end of file
@@ -0,0 +1,231 @@
+#include "BarrierPlanner.h"
+#include "Macros/ErrorMacros.h"
+
+BarrierPlanner::BarrierPlanner(ResourceState readOnlyStates)
+	:
+	m_readOnlyStates(readOnlyStates)
+{
+
+}
+
+void BarrierPlanner::SetUsageState(FrameGraphCompiler::PassHandle pass, FrameGraphCompiler::ResourceHandle resource, ResourceState state)
+{
+	if (pass >= m_usageStates.size())
+		m_usageStates.resize(pass + 1);
+
+	for (UsageState& usageState : m_usageStates.at(pass))
+	{
+		if (usageState.resource == resource)
+		{
+			THROW_INTERNAL_ERROR_IF("Pass uses resource in two states that can't be combined", !CanCombineStates(usageState.state, state));
+
+			usageState.state |= state;
+
+			return;
+		}
+	}
+
+	m_usageStates.at(pass).push_back({ resource, state });
+}
+
+void BarrierPlanner::SetFinalState(FrameGraphCompiler::ResourceHandle resource, ResourceState state)
+{
+	if (resource >= m_finalStates.size())
+		m_finalStates.resize(resource + 1);
+
+	m_finalStates.at(resource) = state;
+}
+
+BarrierPlanner::Plan BarrierPlanner::Compile(const FrameGraphCompiler& frameGraph, const FrameGraphCompiler::CompiledGraph& compiledGraph) const
+{
+	struct Use
+	{
+		unsigned int position;
+		ResourceState state;
+	};
+
+	struct StateRange
+	{
+		unsigned int firstPosition;
+		unsigned int lastPosition;
+		ResourceState state;
+	};
+
+	const unsigned int numPositions = static_cast<unsigned int>(compiledGraph.passOrder.size());
+	const unsigned int numResources = frameGraph.GetNumResources();
+
+	// gathering uses of every resource in execution order
+	std::vector<std::vector<Use>> resourceUses(numResources);
+
+	for (unsigned int position = 0; position < numPositions; position++)
+	{
+		FrameGraphCompiler::PassHandle pass = compiledGraph.passOrder.at(position);
+		const FrameGraphCompiler::PassInfo& passInfo = frameGraph.GetPass(pass);
+
+		auto addUse = [&](FrameGraphCompiler::ResourceHandle resource)
+			{
+				std::vector<Use>& uses = resourceUses.at(resource);
+
+				if (uses.empty() || uses.back().position != position)
+					uses.push_back({ position, GetUsageState(pass, resource) });
+			};
+
+		for (FrameGraphCompiler::ResourceHandle resource : passInfo.reads)
+			addUse(resource);
+
+		for (FrameGraphCompiler::ResourceHandle resource : passInfo.writes)
+			addUse(resource);
+	}
+
+	Plan plan = {};
+	plan.passBarriers.resize(numPositions);
+	plan.frameStartStates.resize(numResources);
+
+	for (FrameGraphCompiler::ResourceHandle resource = 0; resource < numResources; resource++)
+	{
+		const std::vector<Use>& uses = resourceUses.at(resource);
+
+		if (uses.empty())
+			continue;
+
+		// neighbouring uses in compatible states don't need transitions between them
+		std::vector<StateRange> stateRanges;
+
+		for (const Use& use : uses)
+		{
+			if (!stateRanges.empty() && CanCombineStates(stateRanges.back().state, use.state))
+			{
+				stateRanges.back().lastPosition = use.position;
+				stateRanges.back().state |= use.state;
+			}
+			else
+				stateRanges.push_back({ use.position, use.position, use.state });
+		}
+
+		std::optional<ResourceState> finalState = resource < m_finalStates.size() ? m_finalStates.at(resource) : std::nullopt;
+		ResourceState frameEndState = finalState.value_or(stateRanges.back().state);
+
+		plan.frameStartStates.at(resource) = frameEndState;
+
+		// transitions that would be issued for every use separately
+		{
+			ResourceState unbatchedEndState = finalState.value_or(uses.back().state);
+			ResourceState previousState = unbatchedEndState;
+
+			for (const Use& use : uses)
+			{
+				if (use.state != previousState)
+					plan.numUnbatchedBarriers++;
+
+				previousState = use.state;
+			}
+
+			if (previousState != unbatchedEndState)
+				plan.numUnbatchedBarriers++;
+		}
+
+		ResourceState currentState = frameEndState;
+		int lastUsePosition = -1;
+
+		for (const StateRange& stateRange : stateRanges)
+		{
+			if (stateRange.state != currentState)
+			{
+				Barrier barrier = { resource, currentState, stateRange.state, BarrierType::full };
+
+				// when there are passes between uses the transition can overlap with them
+				if (static_cast<unsigned int>(lastUsePosition + 1) < stateRange.firstPosition)
+				{
+					barrier.type = BarrierType::begin;
+					plan.passBarriers.at(lastUsePosition + 1).push_back(barrier);
+
+					barrier.type = BarrierType::end;
+					plan.numSplitBarriers++;
+				}
+
+				plan.passBarriers.at(stateRange.firstPosition).push_back(barrier);
+				plan.numBarriers++;
+			}
+
+			currentState = stateRange.state;
+			lastUsePosition = int(stateRange.lastPosition);
+		}
+
+		if (currentState != frameEndState)
+		{
+			plan.finalBarriers.push_back({ resource, currentState, frameEndState, BarrierType::full });
+			plan.numBarriers++;
+		}
+	}
+
+	for (const std::vector<Barrier>& barriers : plan.passBarriers)
+		if (!barriers.empty())
+			plan.numBatches++;
+
+	if (!plan.finalBarriers.empty())
+		plan.numBatches++;
+
+	return plan;
+}
+
+std::string BarrierPlanner::GetReport(const FrameGraphCompiler& frameGraph, const FrameGraphCompiler::CompiledGraph& compiledGraph, const Plan& plan) const
+{
+	std::string report;
+
+	auto addBarriers = [&](const std::vector<Barrier>& barriers)
+		{
+			for (const Barrier& barrier : barriers)
+			{
+				report += "  " + frameGraph.GetResource(barrier.resource).name;
+
+				if (barrier.type == BarrierType::begin)
+					report += " (begin)";
+				else if (barrier.type == BarrierType::end)
+					report += " (end)";
+
+				report += "\n";
+			}
+		};
+
+	for (unsigned int position = 0; position < plan.passBarriers.size(); position++)
+	{
+		if (plan.passBarriers.at(position).empty())
+			continue;
+
+		report += "Before " + frameGraph.GetPass(compiledGraph.passOrder.at(position)).name + ":\n";
+		addBarriers(plan.passBarriers.at(position));
+	}
+
+	if (!plan.finalBarriers.empty())
+	{
+		report += "After last pass:\n";
+		addBarriers(plan.finalBarriers);
+	}
+
+	report += "Barriers: " + std::to_string(plan.numBarriers) + " in " + std::to_string(plan.numBatches) + " batches, " + std::to_string(plan.numSplitBarriers) + " split";
+	report += " (" + std::to_string(plan.numUnbatchedBarriers) + " separate barriers without planning)\n";
+
+	return report;
+}
+
+bool BarrierPlanner::CanCombineStates(ResourceState first, ResourceState second) const
+{
+	if (first == second)
+		return true;
+
+	// common state can't be combined with anything
+	if (first == 0 || second == 0)
+		return false;
+
+	return ((first | second) & ~m_readOnlyStates) == 0;
+}
+
+BarrierPlanner::ResourceState BarrierPlanner::GetUsageState(FrameGraphCompiler::PassHandle pass, FrameGraphCompiler::ResourceHandle resource) const
+{
+	if (pass < m_usageStates.size())
+		for (const UsageState& usageState : m_usageStates.at(pass))
+			if (usageState.resource == resource)
+				return usageState.state;
+
+	THROW_INTERNAL_ERROR("Pass uses resource without declared state");
+}
\ No newline at end of file
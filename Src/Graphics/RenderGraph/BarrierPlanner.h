@@ -0,0 +1,73 @@
+#pragma once
+#include "Includes/CppIncludes.h"
+#include "FrameGraphCompiler.h"
+
+// plans resource transitions of compiled frame graph. All transitions needed before a pass are issued as one batch,
+// consecutive uses in read only states are combined into one state and transitions with unused passes in between are split.
+// States are opaque bitmasks here, RenderGraph feeds it D3D12_RESOURCE_STATES
+class BarrierPlanner
+{
+public:
+	using ResourceState = unsigned int;
+
+	enum class BarrierType : uint8_t
+	{
+		full,
+		begin,	// split barrier started right after previous use of resource
+		end		// split barrier finished right before next use of resource
+	};
+
+	struct Barrier
+	{
+		FrameGraphCompiler::ResourceHandle resource = 0;
+		ResourceState stateBefore = 0;
+		ResourceState stateAfter = 0;
+		BarrierType type = BarrierType::full;
+	};
+
+	struct Plan
+	{
+		std::vector<std::vector<Barrier>> passBarriers; // batch issued before pass at the same position of CompiledGraph::passOrder
+		std::vector<Barrier> finalBarriers; // batch issued after the last pass
+
+		// states of resources expected at the start of the frame, the same in which previous frame left them. Indexed by resource handle
+		std::vector<std::optional<ResourceState>> frameStartStates;
+
+		unsigned int numBarriers = 0; // split barrier counts as one
+		unsigned int numSplitBarriers = 0;
+		unsigned int numBatches = 0;
+		unsigned int numUnbatchedBarriers = 0; // transitions needed when every use sets its own state with separate call
+	};
+
+public:
+	// combination of states that can be merged together when resource is only read
+	BarrierPlanner(ResourceState readOnlyStates);
+
+public:
+	// every resource read or written by pass needs a state
+	void SetUsageState(FrameGraphCompiler::PassHandle pass, FrameGraphCompiler::ResourceHandle resource, ResourceState state);
+
+	// state resource has to be in after the last pass, by default it stays in the state of last use
+	void SetFinalState(FrameGraphCompiler::ResourceHandle resource, ResourceState state);
+
+	Plan Compile(const FrameGraphCompiler& frameGraph, const FrameGraphCompiler::CompiledGraph& compiledGraph) const;
+
+	std::string GetReport(const FrameGraphCompiler& frameGraph, const FrameGraphCompiler::CompiledGraph& compiledGraph, const Plan& plan) const;
+
+private:
+	bool CanCombineStates(ResourceState first, ResourceState second) const;
+
+	ResourceState GetUsageState(FrameGraphCompiler::PassHandle pass, FrameGraphCompiler::ResourceHandle resource) const;
+
+private:
+	struct UsageState
+	{
+		FrameGraphCompiler::ResourceHandle resource;
+		ResourceState state;
+	};
+
+	ResourceState m_readOnlyStates;
+
+	std::vector<std::vector<UsageState>> m_usageStates; // indexed by pass handle
+	std::vector<std::optional<ResourceState>> m_finalStates; // indexed by resource handle
+};
\ No newline at end of file
@@ -0,0 +1,397 @@
+#include "FrameGraphCompiler.h"
+#include "Macros/ErrorMacros.h"
+
+bool FrameGraphCompiler::ResourceLifetime::IsUsed() const
+{
+	return firstUse <= lastUse;
+}
+
+bool FrameGraphCompiler::ResourceLifetime::Overlaps(const ResourceLifetime& other) const
+{
+	return firstUse <= other.lastUse && other.firstUse <= lastUse;
+}
+
+FrameGraphCompiler::ResourceHandle FrameGraphCompiler::CreateTransientResource(std::string name, size_t size, size_t alignment)
+{
+	THROW_INTERNAL_ERROR_IF("Alignment of transient resource has to be power of 2", alignment == 0 || (alignment & (alignment - 1)) != 0);
+
+	m_resources.push_back({ std::move(name), size, alignment, false });
+
+	return ResourceHandle(m_resources.size() - 1);
+}
+
+FrameGraphCompiler::ResourceHandle FrameGraphCompiler::ImportResource(std::string name)
+{
+	m_resources.push_back({ std::move(name), 0, 1, true });
+
+	return ResourceHandle(m_resources.size() - 1);
+}
+
+FrameGraphCompiler::PassHandle FrameGraphCompiler::AddPass(std::string name, std::vector<ResourceHandle> reads, std::vector<ResourceHandle> writes)
+{
+	for (ResourceHandle resource : reads)
+		THROW_INTERNAL_ERROR_IF("Pass reads resource that wasn't declared", resource >= m_resources.size());
+
+	for (ResourceHandle resource : writes)
+		THROW_INTERNAL_ERROR_IF("Pass writes resource that wasn't declared", resource >= m_resources.size());
+
+	m_passes.push_back({ std::move(name), std::move(reads), std::move(writes) });
+
+	return PassHandle(m_passes.size() - 1);
+}
+
+void FrameGraphCompiler::MarkOutput(ResourceHandle resource)
+{
+	m_resources.at(resource).output = true;
+}
+
+FrameGraphCompiler::CompiledGraph FrameGraphCompiler::Compile() const
+{
+	CompiledGraph compiledGraph = {};
+	compiledGraph.passOrder = SortPasses();
+	compiledGraph.lifetimes = CalculateLifetimes(compiledGraph.passOrder);
+
+	PlaceTransientResources(compiledGraph);
+	PlanAliasingBarriers(compiledGraph);
+
+	return compiledGraph;
+}
+
+std::vector<bool> FrameGraphCompiler::GetLivePasses(const CompiledGraph& compiledGraph, const std::vector<bool>& enabledPasses) const
+{
+	THROW_INTERNAL_ERROR_IF("Enabled passes don't match declared passes", enabledPasses.size() != m_passes.size());
+
+	std::vector<bool> livePasses(m_passes.size(), false);
+	std::vector<bool> neededResources(m_resources.size(), false);
+
+	for (ResourceHandle resource = 0; resource < m_resources.size(); resource++)
+		neededResources.at(resource) = m_resources.at(resource).output;
+
+	// going from the last pass, every live pass makes resources it reads needed by passes before it.
+	// Earlier writers of needed resource stay live too, passes only add to what was written before
+	for (auto passIt = compiledGraph.passOrder.rbegin(); passIt != compiledGraph.passOrder.rend(); passIt++)
+	{
+		PassHandle pass = *passIt;
+		const PassInfo& passInfo = m_passes.at(pass);
+
+		if (!enabledPasses.at(pass))
+			continue;
+
+		// pass without outputs is there only for its side effects
+		bool live = passInfo.writes.empty();
+
+		for (ResourceHandle resource : passInfo.writes)
+			if (neededResources.at(resource))
+				live = true;
+
+		if (!live)
+			continue;
+
+		livePasses.at(pass) = true;
+
+		for (ResourceHandle resource : passInfo.reads)
+			neededResources.at(resource) = true;
+	}
+
+	return livePasses;
+}
+
+std::string FrameGraphCompiler::GetMemoryReport(const CompiledGraph& compiledGraph) const
+{
+	std::string report;
+
+	auto toKB = [](size_t size)
+		{
+			return std::to_string((size + 1023) / 1024) + " KB";
+		};
+
+	report += "Pass order:";
+
+	for (PassHandle pass : compiledGraph.passOrder)
+		report += " " + m_passes.at(pass).name;
+
+	report += "\n";
+
+	for (ResourceHandle resource = 0; resource < m_resources.size(); resource++)
+	{
+		const ResourceInfo& resourceInfo = m_resources.at(resource);
+		const ResourceLifetime& lifetime = compiledGraph.lifetimes.at(resource);
+
+		report += resourceInfo.name + ": ";
+
+		if (!lifetime.IsUsed())
+		{
+			report += "unused\n";
+			continue;
+		}
+
+		report += "passes [" + std::to_string(lifetime.firstUse) + ", " + std::to_string(lifetime.lastUse) + "]";
+
+		if (resourceInfo.imported)
+			report += ", imported\n";
+		else
+			report += ", " + toKB(resourceInfo.size) + " at offset " + toKB(compiledGraph.memoryOffsets.at(resource)) + "\n";
+	}
+
+	size_t savedMemory = compiledGraph.unaliasedMemorySize - compiledGraph.aliasedMemorySize;
+	size_t savedPercent = compiledGraph.unaliasedMemorySize != 0 ? savedMemory * 100 / compiledGraph.unaliasedMemorySize : 0;
+
+	report += "Transient memory: " + toKB(compiledGraph.aliasedMemorySize) + " aliased, " + toKB(compiledGraph.unaliasedMemorySize) + " without aliasing";
+	report += " (saved " + toKB(savedMemory) + ", " + std::to_string(savedPercent) + "%)\n";
+
+	return report;
+}
+
+const FrameGraphCompiler::ResourceInfo& FrameGraphCompiler::GetResource(ResourceHandle resource) const
+{
+	return m_resources.at(resource);
+}
+
+const FrameGraphCompiler::PassInfo& FrameGraphCompiler::GetPass(PassHandle pass) const
+{
+	return m_passes.at(pass);
+}
+
+unsigned int FrameGraphCompiler::GetNumResources() const
+{
+	return static_cast<unsigned int>(m_resources.size());
+}
+
+unsigned int FrameGraphCompiler::GetNumPasses() const
+{
+	return static_cast<unsigned int>(m_passes.size());
+}
+
+std::vector<FrameGraphCompiler::PassHandle> FrameGraphCompiler::SortPasses() const
+{
+	const unsigned int numPasses = GetNumPasses();
+
+	std::vector<std::vector<PassHandle>> dependentPasses(numPasses);
+	std::vector<unsigned int> numDependencies(numPasses, 0);
+
+	auto addDependency = [&](PassHandle from, PassHandle to)
+		{
+			if (from == to)
+				return;
+
+			dependentPasses.at(from).push_back(to);
+			numDependencies.at(to)++;
+		};
+
+	// building dependencies for every resource separately
+	{
+		std::vector<std::vector<PassHandle>> writers(m_resources.size());
+
+		for (PassHandle pass = 0; pass < numPasses; pass++)
+			for (ResourceHandle resource : m_passes.at(pass).writes)
+				if (writers.at(resource).empty() || writers.at(resource).back() != pass)
+					writers.at(resource).push_back(pass);
+
+		for (ResourceHandle resource = 0; resource < m_resources.size(); resource++)
+		{
+			const std::vector<PassHandle>& resourceWriters = writers.at(resource);
+
+			// writers are chained in declaration order
+			for (size_t i = 1; i < resourceWriters.size(); i++)
+				addDependency(resourceWriters.at(i - 1), resourceWriters.at(i));
+		}
+
+		for (PassHandle pass = 0; pass < numPasses; pass++)
+		{
+			const PassInfo& passInfo = m_passes.at(pass);
+
+			for (ResourceHandle resource : passInfo.reads)
+			{
+				const std::vector<PassHandle>& resourceWriters = writers.at(resource);
+
+				// pass that also writes resource is already chained after previous writer
+				bool alsoWrites = std::find(passInfo.writes.begin(), passInfo.writes.end(), resource) != passInfo.writes.end();
+
+				if (resourceWriters.empty() || alsoWrites)
+					continue;
+
+				// reading result of the last writer declared before the pass, or of the first writer if all of them were declared later
+				auto nextWriter = std::upper_bound(resourceWriters.begin(), resourceWriters.end(), pass);
+				auto readWriter = nextWriter == resourceWriters.begin() ? nextWriter : nextWriter - 1;
+
+				addDependency(*readWriter, pass);
+
+				// next writer can't overwrite resource before it was read
+				if (readWriter + 1 != resourceWriters.end())
+					addDependency(pass, *(readWriter + 1));
+			}
+		}
+	}
+
+	// topological sort, when there is a choice passes keep declaration order
+	std::vector<PassHandle> passOrder;
+	passOrder.reserve(numPasses);
+
+	std::priority_queue<PassHandle, std::vector<PassHandle>, std::greater<PassHandle>> readyPasses;
+
+	for (PassHandle pass = 0; pass < numPasses; pass++)
+		if (numDependencies.at(pass) == 0)
+			readyPasses.push(pass);
+
+	while (!readyPasses.empty())
+	{
+		PassHandle pass = readyPasses.top();
+		readyPasses.pop();
+
+		passOrder.push_back(pass);
+
+		for (PassHandle dependentPass : dependentPasses.at(pass))
+			if (--numDependencies.at(dependentPass) == 0)
+				readyPasses.push(dependentPass);
+	}
+
+	THROW_INTERNAL_ERROR_IF("Frame graph contains a cycle", passOrder.size() != numPasses);
+
+	return passOrder;
+}
+
+std::vector<FrameGraphCompiler::ResourceLifetime> FrameGraphCompiler::CalculateLifetimes(const std::vector<PassHandle>& passOrder) const
+{
+	std::vector<ResourceLifetime> lifetimes(m_resources.size());
+
+	auto markUse = [&](ResourceHandle resource, unsigned int orderIndex)
+		{
+			ResourceLifetime& lifetime = lifetimes.at(resource);
+
+			lifetime.firstUse = std::min(lifetime.firstUse, orderIndex);
+			lifetime.lastUse = std::max(lifetime.lastUse, orderIndex);
+		};
+
+	for (unsigned int orderIndex = 0; orderIndex < passOrder.size(); orderIndex++)
+	{
+		const PassInfo& passInfo = m_passes.at(passOrder.at(orderIndex));
+
+		for (ResourceHandle resource : passInfo.reads)
+			markUse(resource, orderIndex);
+
+		for (ResourceHandle resource : passInfo.writes)
+			markUse(resource, orderIndex);
+	}
+
+	return lifetimes;
+}
+
+void FrameGraphCompiler::PlaceTransientResources(CompiledGraph& compiledGraph) const
+{
+	compiledGraph.memoryOffsets.assign(m_resources.size(), 0);
+	compiledGraph.aliasedMemorySize = 0;
+	compiledGraph.unaliasedMemorySize = 0;
+
+	auto getAligned = [](size_t offset, size_t alignment)
+		{
+			return (offset + alignment - 1) & ~(alignment - 1);
+		};
+
+	std::vector<ResourceHandle> transientResources;
+
+	for (ResourceHandle resource = 0; resource < m_resources.size(); resource++)
+	{
+		if (m_resources.at(resource).imported || !compiledGraph.lifetimes.at(resource).IsUsed())
+			continue;
+
+		transientResources.push_back(resource);
+		compiledGraph.unaliasedMemorySize = getAligned(compiledGraph.unaliasedMemorySize, m_resources.at(resource).alignment) + m_resources.at(resource).size;
+	}
+
+	// placing biggest resources first gives less fragmentation
+	std::stable_sort(transientResources.begin(), transientResources.end(), [&](ResourceHandle a, ResourceHandle b)
+		{
+			return m_resources.at(a).size > m_resources.at(b).size;
+		});
+
+	std::vector<ResourceHandle> placedResources;
+
+	for (ResourceHandle resource : transientResources)
+	{
+		const ResourceInfo& resourceInfo = m_resources.at(resource);
+		const ResourceLifetime& lifetime = compiledGraph.lifetimes.at(resource);
+
+		// only resources alive at the same time can't share memory
+		std::vector<ResourceHandle> conflictingResources;
+
+		for (ResourceHandle placedResource : placedResources)
+			if (compiledGraph.lifetimes.at(placedResource).Overlaps(lifetime))
+				conflictingResources.push_back(placedResource);
+
+		std::sort(conflictingResources.begin(), conflictingResources.end(), [&](ResourceHandle a, ResourceHandle b)
+			{
+				return compiledGraph.memoryOffsets.at(a) < compiledGraph.memoryOffsets.at(b);
+			});
+
+		// lowest offset that fits between conflicting resources
+		size_t offset = 0;
+
+		for (ResourceHandle conflictingResource : conflictingResources)
+		{
+			size_t conflictingOffset = compiledGraph.memoryOffsets.at(conflictingResource);
+			size_t conflictingEnd = conflictingOffset + m_resources.at(conflictingResource).size;
+
+			if (getAligned(offset, resourceInfo.alignment) + resourceInfo.size <= conflictingOffset)
+				break;
+
+			offset = std::max(offset, conflictingEnd);
+		}
+
+		offset = getAligned(offset, resourceInfo.alignment);
+
+		compiledGraph.memoryOffsets.at(resource) = offset;
+		compiledGraph.aliasedMemorySize = std::max(compiledGraph.aliasedMemorySize, offset + resourceInfo.size);
+
+		placedResources.push_back(resource);
+	}
+}
+
+void FrameGraphCompiler::PlanAliasingBarriers(CompiledGraph& compiledGraph) const
+{
+	compiledGraph.aliasingBarriers.assign(compiledGraph.passOrder.size(), {});
+
+	auto isPlaced = [&](ResourceHandle resource)
+		{
+			return !m_resources.at(resource).imported && compiledGraph.lifetimes.at(resource).IsUsed();
+		};
+
+	auto sharesMemory = [&](ResourceHandle a, ResourceHandle b)
+		{
+			size_t offsetA = compiledGraph.memoryOffsets.at(a);
+			size_t offsetB = compiledGraph.memoryOffsets.at(b);
+
+			return offsetA < offsetB + m_resources.at(b).size && offsetB < offsetA + m_resources.at(a).size;
+		};
+
+	for (ResourceHandle resource = 0; resource < m_resources.size(); resource++)
+	{
+		if (!isPlaced(resource))
+			continue;
+
+		const ResourceLifetime& lifetime = compiledGraph.lifetimes.at(resource);
+
+		bool aliased = false;
+		unsigned int numPreviousUsers = 0;
+		ResourceHandle previousUser = invalidResource;
+
+		for (ResourceHandle otherResource = 0; otherResource < m_resources.size(); otherResource++)
+		{
+			if (otherResource == resource || !isPlaced(otherResource) || !sharesMemory(resource, otherResource))
+				continue;
+
+			aliased = true;
+
+			if (compiledGraph.lifetimes.at(otherResource).lastUse < lifetime.firstUse)
+			{
+				previousUser = otherResource;
+				numPreviousUsers++;
+			}
+		}
+
+		// memory that isn't shared needs no barrier. When resource is the first user in the frame, memory was last used by previous frame
+		if (!aliased)
+			continue;
+
+		compiledGraph.aliasingBarriers.at(lifetime.firstUse).push_back({ numPreviousUsers == 1 ? previousUser : invalidResource, resource });
+	}
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+#include "Includes/CppIncludes.h"
+
+// resolves pass order and resource lifetimes out of declared reads and writes of virtual resources.
+// It doesn't touch any graphics objects, RenderGraph maps its handles to real passes and resources
+class FrameGraphCompiler
+{
+public:
+	using ResourceHandle = unsigned int;
+	using PassHandle = unsigned int;
+
+	static constexpr ResourceHandle invalidResource = UINT_MAX;
+
+	struct ResourceInfo
+	{
+		std::string name;
+		size_t size = 0;
+		size_t alignment = 1;
+		bool imported = false; // owned outside of frame graph, never aliased
+		bool output = false; // consumed outside of frame graph, passes writing it are never culled
+	};
+
+	struct PassInfo
+	{
+		std::string name;
+		std::vector<ResourceHandle> reads;
+		std::vector<ResourceHandle> writes;
+	};
+
+	struct ResourceLifetime
+	{
+		// positions in CompiledGraph::passOrder
+		unsigned int firstUse = UINT_MAX;
+		unsigned int lastUse = 0;
+
+		bool IsUsed() const;
+		bool Overlaps(const ResourceLifetime& other) const;
+	};
+
+	// transient resource takes over memory that other transient resources used before it
+	struct AliasingBarrier
+	{
+		ResourceHandle resourceBefore = invalidResource; // invalidResource when it isn't known which resource used the memory last
+		ResourceHandle resourceAfter = invalidResource;
+	};
+
+	struct CompiledGraph
+	{
+		std::vector<PassHandle> passOrder;
+		std::vector<ResourceLifetime> lifetimes; // indexed by resource handle
+
+		// placement of transient resources in shared memory, indexed by resource handle
+		std::vector<size_t> memoryOffsets;
+		size_t aliasedMemorySize = 0;
+		size_t unaliasedMemorySize = 0;
+
+		// issued before pass at the same position of passOrder, for every transient resource first used there that shares memory
+		std::vector<std::vector<AliasingBarrier>> aliasingBarriers;
+	};
+
+public:
+	ResourceHandle CreateTransientResource(std::string name, size_t size, size_t alignment);
+	ResourceHandle ImportResource(std::string name);
+
+	// passes writing the same resource keep their declaration order. Pass reading resource is ordered after the last writer declared before it
+	// (or the first writer if all of them are declared later) and before the next one
+	PassHandle AddPass(std::string name, std::vector<ResourceHandle> reads, std::vector<ResourceHandle> writes);
+
+	// marks resource that is used after the frame graph, like swap chain
+	void MarkOutput(ResourceHandle resource);
+
+	CompiledGraph Compile() const;
+
+	// pass is live when it's enabled and something it writes is read by a live pass after it or is an output. Indexed by pass handle
+	std::vector<bool> GetLivePasses(const CompiledGraph& compiledGraph, const std::vector<bool>& enabledPasses) const;
+
+	std::string GetMemoryReport(const CompiledGraph& compiledGraph) const;
+
+public:
+	const ResourceInfo& GetResource(ResourceHandle resource) const;
+	const PassInfo& GetPass(PassHandle pass) const;
+
+	unsigned int GetNumResources() const;
+	unsigned int GetNumPasses() const;
+
+private:
+	std::vector<PassHandle> SortPasses() const;
+
+	std::vector<ResourceLifetime> CalculateLifetimes(const std::vector<PassHandle>& passOrder) const;
+
+	void PlaceTransientResources(CompiledGraph& compiledGraph) const;
+
+	void PlanAliasingBarriers(CompiledGraph& compiledGraph) const;
+
+private:
+	std::vector<ResourceInfo> m_resources;
+	std::vector<PassInfo> m_passes;
+};
\ No newline at end of file
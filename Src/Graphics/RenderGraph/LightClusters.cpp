@@ -0,0 +1,397 @@
+#include "LightClusters.h"
+#include "System/JobSystem.h"
+
+#include "Macros/ErrorMacros.h"
+
+LightClusters::LightClusters(unsigned int tilesX, unsigned int tilesY, unsigned int slicesZ)
+	:
+	m_tilesX(tilesX),
+	m_tilesY(tilesY),
+	m_slicesZ(slicesZ)
+{
+	THROW_INTERNAL_ERROR_IF("Light clusters need at least one cluster in every dimension", tilesX == 0 || tilesY == 0 || slicesZ == 0);
+
+	m_slices.resize(slicesZ);
+	m_sliceOffsets.resize(slicesZ);
+	m_clusterRanges.resize(GetNumClusters());
+}
+
+void LightClusters::SetProjection(float fovAngleY, float aspectRatio, float nearZ, float farZ)
+{
+	THROW_INTERNAL_ERROR_IF("Invalid depth range of light clusters", nearZ <= 0.0f || farZ <= nearZ);
+
+	m_nearZ = nearZ;
+	m_farZ = farZ;
+
+	// exponential slices keep clusters close to cube shaped at every distance
+	m_sliceDepths.resize(m_slicesZ + 1);
+
+	for (unsigned int slice = 0; slice <= m_slicesZ; slice++)
+		m_sliceDepths[slice] = nearZ * std::pow(farZ / nearZ, float(slice) / float(m_slicesZ));
+
+	m_sliceDepths.back() = farZ;
+
+	// half extents of view plane at depth 1
+	float tanHalfFovY = std::tan(fovAngleY * 0.5f);
+	float tanHalfFovX = tanHalfFovY * aspectRatio;
+
+	m_clusterBounds.resize(GetNumClusters());
+
+	for (unsigned int slice = 0; slice < m_slicesZ; slice++)
+	{
+		float sliceNear = m_sliceDepths[slice];
+		float sliceFar = m_sliceDepths[slice + 1];
+
+		for (unsigned int tileY = 0; tileY < m_tilesY; tileY++)
+		{
+			// tiles go from the top of the screen
+			float ndcTop = 1.0f - 2.0f * float(tileY) / float(m_tilesY);
+			float ndcBottom = 1.0f - 2.0f * float(tileY + 1) / float(m_tilesY);
+
+			for (unsigned int tileX = 0; tileX < m_tilesX; tileX++)
+			{
+				float ndcLeft = -1.0f + 2.0f * float(tileX) / float(m_tilesX);
+				float ndcRight = -1.0f + 2.0f * float(tileX + 1) / float(m_tilesX);
+
+				ClusterBounds& bounds = m_clusterBounds[(slice * m_tilesY + tileY) * m_tilesX + tileX];
+
+				// frustum part of the cluster grows with depth, so box has to contain its sides at both depths
+				bounds.min.x = std::min(ndcLeft * sliceNear, ndcLeft * sliceFar) * tanHalfFovX;
+				bounds.max.x = std::max(ndcRight * sliceNear, ndcRight * sliceFar) * tanHalfFovX;
+				bounds.min.y = std::min(ndcBottom * sliceNear, ndcBottom * sliceFar) * tanHalfFovY;
+				bounds.max.y = std::max(ndcTop * sliceNear, ndcTop * sliceFar) * tanHalfFovY;
+				bounds.min.z = sliceNear;
+				bounds.max.z = sliceFar;
+			}
+		}
+	}
+}
+
+void LightClusters::Update(JobSystem& jobSystem, std::span<const DirectX::XMFLOAT4> lights)
+{
+	GatherLights(lights);
+
+	jobSystem.ParallelFor(m_slicesZ, [this](unsigned int slice)
+		{
+			BinSlice(slice);
+		});
+
+	CalculateSliceOffsets();
+
+	jobSystem.ParallelFor(m_slicesZ, [this](unsigned int slice)
+		{
+			CopySlice(slice);
+		});
+}
+
+void LightClusters::Update(std::span<const DirectX::XMFLOAT4> lights)
+{
+	GatherLights(lights);
+
+	for (unsigned int slice = 0; slice < m_slicesZ; slice++)
+		BinSlice(slice);
+
+	CalculateSliceOffsets();
+
+	for (unsigned int slice = 0; slice < m_slicesZ; slice++)
+		CopySlice(slice);
+}
+
+const std::vector<LightClusters::ClusterRange>& LightClusters::GetClusterRanges() const
+{
+	return m_clusterRanges;
+}
+
+const std::vector<unsigned int>& LightClusters::GetLightIndices() const
+{
+	return m_lightIndices;
+}
+
+unsigned int LightClusters::GetNumClusters() const
+{
+	return m_tilesX * m_tilesY * m_slicesZ;
+}
+
+LightClusters::ShaderParams LightClusters::GetShaderParams() const
+{
+	float logDepthRange = std::log(m_farZ / m_nearZ);
+
+	ShaderParams params = {};
+	params.tilesX = m_tilesX;
+	params.tilesY = m_tilesY;
+	params.slicesZ = m_slicesZ;
+	params.sliceScale = float(m_slicesZ) / logDepthRange;
+	params.sliceBias = -float(m_slicesZ) * std::log(m_nearZ) / logDepthRange;
+
+	return params;
+}
+
+LightClusters::BenchmarkResult LightClusters::Benchmark(JobSystem& jobSystem, unsigned int numLights)
+{
+	using Clock = std::chrono::steady_clock;
+
+	auto getElapsedMs = [](Clock::time_point start)
+		{
+			return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+		};
+
+	constexpr float fovAngleY = DirectX::XM_PIDIV2;
+	constexpr float aspectRatio = 16.0f / 9.0f;
+	constexpr float nearZ = 0.1f;
+	constexpr float farZ = 400.0f;
+
+	// lights scattered over the first part of the frustum, where most of the scene usually is
+	std::vector<DirectX::XMFLOAT4> lights(numLights);
+	{
+		std::mt19937 randomEngine(12345);
+		std::uniform_real_distribution<float> unitDistribution(0.0f, 1.0f);
+
+		for (auto& light : lights)
+		{
+			float z = nearZ + unitDistribution(randomEngine) * 100.0f;
+			float x = (unitDistribution(randomEngine) * 2.0f - 1.0f) * z * aspectRatio;
+			float y = (unitDistribution(randomEngine) * 2.0f - 1.0f) * z;
+
+			light = { x, y, z, 1.0f + unitDistribution(randomEngine) * 9.0f };
+		}
+	}
+
+	LightClusters clusters;
+	clusters.SetProjection(fovAngleY, aspectRatio, nearZ, farZ);
+
+	BenchmarkResult result = {};
+	result.numLights = numLights;
+	result.numClusters = clusters.GetNumClusters();
+	result.numThreads = jobSystem.GetNumThreads();
+
+	Clock::time_point start = Clock::now();
+	clusters.Update(lights);
+	result.singleThreadMs = getElapsedMs(start);
+
+	start = Clock::now();
+	clusters.Update(jobSystem, lights);
+	result.parallelMs = getElapsedMs(start);
+
+	result.numLightIndices = unsigned int(clusters.GetLightIndices().size());
+
+	// every light tested against every cluster
+	std::vector<unsigned int> referenceIndices;
+	std::vector<ClusterRange> referenceRanges(clusters.GetNumClusters());
+
+	start = Clock::now();
+
+	for (unsigned int cluster = 0; cluster < clusters.GetNumClusters(); cluster++)
+	{
+		const ClusterBounds& bounds = clusters.m_clusterBounds[cluster];
+
+		referenceRanges[cluster].offset = unsigned int(referenceIndices.size());
+
+		for (unsigned int lightIndex = 0; lightIndex < numLights; lightIndex++)
+			if (SphereIntersectsBox(lights[lightIndex], bounds.min, bounds.max))
+				referenceIndices.push_back(lightIndex);
+
+		referenceRanges[cluster].count = unsigned int(referenceIndices.size()) - referenceRanges[cluster].offset;
+	}
+
+	result.bruteForceMs = getElapsedMs(start);
+
+	bool sameRanges = std::equal(referenceRanges.begin(), referenceRanges.end(), clusters.GetClusterRanges().begin(), clusters.GetClusterRanges().end(),
+		[](const ClusterRange& first, const ClusterRange& second)
+		{
+			return first.offset == second.offset && first.count == second.count;
+		});
+
+	THROW_INTERNAL_ERROR_IF("Light clusters don't match brute force binning", !sameRanges || referenceIndices != clusters.GetLightIndices());
+
+	return result;
+}
+
+bool LightClusters::SaveBenchmarkResult(const BenchmarkResult& result, const std::filesystem::path& path)
+{
+	std::ofstream file(path);
+
+	if (!file.is_open())
+		return false;
+
+	file << "{\n";
+	file << "\"lights\":" << result.numLights << ",\n";
+	file << "\"clusters\":" << result.numClusters << ",\n";
+	file << "\"threads\":" << result.numThreads << ",\n";
+	file << "\"lightIndices\":" << result.numLightIndices << ",\n";
+	file << "\"singleThreadMs\":" << result.singleThreadMs << ",\n";
+	file << "\"parallelMs\":" << result.parallelMs << ",\n";
+	file << "\"bruteForceMs\":" << result.bruteForceMs << "\n";
+	file << "}\n";
+
+	return true;
+}
+
+void LightClusters::GatherLights(std::span<const DirectX::XMFLOAT4> lights)
+{
+	THROW_INTERNAL_ERROR_IF("Light clusters were updated before projection was set", m_clusterBounds.empty());
+
+	m_numLights = unsigned int(lights.size());
+
+	// padding lights have negative radius, so they never reach any depth range
+	unsigned int paddedNumLights = (m_numLights + 3) & ~3u;
+
+	m_lightX.assign(paddedNumLights, 0.0f);
+	m_lightY.assign(paddedNumLights, 0.0f);
+	m_lightZ.assign(paddedNumLights, 0.0f);
+	m_lightRadius.assign(paddedNumLights, -1.0f);
+
+	for (unsigned int lightIndex = 0; lightIndex < m_numLights; lightIndex++)
+	{
+		m_lightX[lightIndex] = lights[lightIndex].x;
+		m_lightY[lightIndex] = lights[lightIndex].y;
+		m_lightZ[lightIndex] = lights[lightIndex].z;
+		m_lightRadius[lightIndex] = lights[lightIndex].w;
+	}
+}
+
+void LightClusters::BinSlice(unsigned int slice)
+{
+	SliceData& sliceData = m_slices[slice];
+
+	sliceData.x.clear();
+	sliceData.y.clear();
+	sliceData.z.clear();
+	sliceData.radiusSquared.clear();
+	sliceData.candidates.clear();
+	sliceData.lightIndices.clear();
+
+	// lights overlapping depth range of the slice
+	{
+		DirectX::XMVECTOR sliceNear = DirectX::XMVectorReplicate(m_sliceDepths[slice]);
+		DirectX::XMVECTOR sliceFar = DirectX::XMVectorReplicate(m_sliceDepths[slice + 1]);
+
+		for (unsigned int lightIndex = 0; lightIndex < m_lightZ.size(); lightIndex += 4)
+		{
+			DirectX::XMVECTOR z = DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4*>(&m_lightZ[lightIndex]));
+			DirectX::XMVECTOR radius = DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4*>(&m_lightRadius[lightIndex]));
+
+			DirectX::XMVECTOR overlaps = DirectX::XMVectorAndInt(
+				DirectX::XMVectorGreaterOrEqual(DirectX::XMVectorAdd(z, radius), sliceNear),
+				DirectX::XMVectorLessOrEqual(DirectX::XMVectorSubtract(z, radius), sliceFar)
+			);
+
+			DirectX::XMUINT4 lanes;
+			DirectX::XMStoreUInt4(&lanes, overlaps);
+
+			if ((lanes.x | lanes.y | lanes.z | lanes.w) == 0)
+				continue;
+
+			const uint32_t laneMasks[4] = { lanes.x, lanes.y, lanes.z, lanes.w };
+
+			for (unsigned int lane = 0; lane < 4; lane++)
+			{
+				if (laneMasks[lane] == 0)
+					continue;
+
+				unsigned int candidate = lightIndex + lane;
+
+				sliceData.candidates.push_back(candidate);
+				sliceData.x.push_back(m_lightX[candidate]);
+				sliceData.y.push_back(m_lightY[candidate]);
+				sliceData.z.push_back(m_lightZ[candidate]);
+				sliceData.radiusSquared.push_back(m_lightRadius[candidate] * m_lightRadius[candidate]);
+			}
+		}
+
+		// padding candidates can't pass the test, distance is never lower than negative radius
+		while (sliceData.candidates.size() % 4 != 0)
+		{
+			sliceData.candidates.push_back(0);
+			sliceData.x.push_back(0.0f);
+			sliceData.y.push_back(0.0f);
+			sliceData.z.push_back(0.0f);
+			sliceData.radiusSquared.push_back(-1.0f);
+		}
+	}
+
+	// testing candidates against boxes of clusters in the slice
+	unsigned int numCandidates = unsigned int(sliceData.candidates.size());
+	unsigned int firstCluster = slice * m_tilesX * m_tilesY;
+
+	for (unsigned int cluster = firstCluster; cluster < firstCluster + m_tilesX * m_tilesY; cluster++)
+	{
+		const ClusterBounds& bounds = m_clusterBounds[cluster];
+		ClusterRange& range = m_clusterRanges[cluster];
+
+		range.offset = unsigned int(sliceData.lightIndices.size());
+
+		DirectX::XMVECTOR minX = DirectX::XMVectorReplicate(bounds.min.x);
+		DirectX::XMVECTOR minY = DirectX::XMVectorReplicate(bounds.min.y);
+		DirectX::XMVECTOR minZ = DirectX::XMVectorReplicate(bounds.min.z);
+		DirectX::XMVECTOR maxX = DirectX::XMVectorReplicate(bounds.max.x);
+		DirectX::XMVECTOR maxY = DirectX::XMVectorReplicate(bounds.max.y);
+		DirectX::XMVECTOR maxZ = DirectX::XMVectorReplicate(bounds.max.z);
+
+		for (unsigned int candidateIndex = 0; candidateIndex < numCandidates; candidateIndex += 4)
+		{
+			DirectX::XMVECTOR x = DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4*>(&sliceData.x[candidateIndex]));
+			DirectX::XMVECTOR y = DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4*>(&sliceData.y[candidateIndex]));
+			DirectX::XMVECTOR z = DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4*>(&sliceData.z[candidateIndex]));
+			DirectX::XMVECTOR radiusSquared = DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4*>(&sliceData.radiusSquared[candidateIndex]));
+
+			// distance from sphere center to the closest point of the box, per axis
+			DirectX::XMVECTOR zero = DirectX::XMVectorZero();
+			DirectX::XMVECTOR distanceX = DirectX::XMVectorAdd(DirectX::XMVectorMax(DirectX::XMVectorSubtract(minX, x), zero), DirectX::XMVectorMax(DirectX::XMVectorSubtract(x, maxX), zero));
+			DirectX::XMVECTOR distanceY = DirectX::XMVectorAdd(DirectX::XMVectorMax(DirectX::XMVectorSubtract(minY, y), zero), DirectX::XMVectorMax(DirectX::XMVectorSubtract(y, maxY), zero));
+			DirectX::XMVECTOR distanceZ = DirectX::XMVectorAdd(DirectX::XMVectorMax(DirectX::XMVectorSubtract(minZ, z), zero), DirectX::XMVectorMax(DirectX::XMVectorSubtract(z, maxZ), zero));
+
+			DirectX::XMVECTOR distanceSquared = DirectX::XMVectorAdd(
+				DirectX::XMVectorAdd(DirectX::XMVectorMultiply(distanceX, distanceX), DirectX::XMVectorMultiply(distanceY, distanceY)),
+				DirectX::XMVectorMultiply(distanceZ, distanceZ)
+			);
+
+			DirectX::XMUINT4 lanes;
+			DirectX::XMStoreUInt4(&lanes, DirectX::XMVectorLessOrEqual(distanceSquared, radiusSquared));
+
+			if ((lanes.x | lanes.y | lanes.z | lanes.w) == 0)
+				continue;
+
+			const uint32_t laneMasks[4] = { lanes.x, lanes.y, lanes.z, lanes.w };
+
+			for (unsigned int lane = 0; lane < 4; lane++)
+				if (laneMasks[lane] != 0)
+					sliceData.lightIndices.push_back(sliceData.candidates[candidateIndex + lane]);
+		}
+
+		range.count = unsigned int(sliceData.lightIndices.size()) - range.offset;
+	}
+}
+
+void LightClusters::CalculateSliceOffsets()
+{
+	unsigned int numLightIndices = 0;
+
+	for (unsigned int slice = 0; slice < m_slicesZ; slice++)
+	{
+		m_sliceOffsets[slice] = numLightIndices;
+		numLightIndices += unsigned int(m_slices[slice].lightIndices.size());
+	}
+
+	m_lightIndices.resize(numLightIndices);
+}
+
+void LightClusters::CopySlice(unsigned int slice)
+{
+	const SliceData& sliceData = m_slices[slice];
+	unsigned int sliceOffset = m_sliceOffsets[slice];
+	unsigned int firstCluster = slice * m_tilesX * m_tilesY;
+
+	for (unsigned int cluster = firstCluster; cluster < firstCluster + m_tilesX * m_tilesY; cluster++)
+		m_clusterRanges[cluster].offset += sliceOffset;
+
+	std::copy(sliceData.lightIndices.begin(), sliceData.lightIndices.end(), m_lightIndices.begin() + sliceOffset);
+}
+
+bool LightClusters::SphereIntersectsBox(DirectX::XMFLOAT4 light, DirectX::XMFLOAT3 boxMin, DirectX::XMFLOAT3 boxMax)
+{
+	float distanceX = std::max(boxMin.x - light.x, 0.0f) + std::max(light.x - boxMax.x, 0.0f);
+	float distanceY = std::max(boxMin.y - light.y, 0.0f) + std::max(light.y - boxMax.y, 0.0f);
+	float distanceZ = std::max(boxMin.z - light.z, 0.0f) + std::max(light.z - boxMax.z, 0.0f);
+
+	return distanceX * distanceX + distanceY * distanceY + distanceZ * distanceZ <= light.w * light.w;
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+#pragma once
+#include "Includes/CppIncludes.h"
+#include "Includes/DirectXIncludes.h"
+
+class JobSystem;
+
+// assigns point lights to froxels, clusters made by splitting camera frustum into screen tiles and exponential depth slices.
+// Every cluster gets range in one compact list of light indices, so lighting shader loops only over lights that can reach it.
+// Lights are tested against view space bounding boxes of clusters, four at the time
+class LightClusters
+{
+public:
+	struct ClusterRange
+	{
+		unsigned int offset = 0;
+		unsigned int count = 0;
+	};
+
+	struct BenchmarkResult
+	{
+		unsigned int numLights = 0;
+		unsigned int numClusters = 0;
+		unsigned int numThreads = 0;
+		unsigned int numLightIndices = 0;
+		float singleThreadMs = 0.0f;
+		float parallelMs = 0.0f;
+		float bruteForceMs = 0.0f; // the same tests without depth culling and SIMD, as reference
+	};
+
+	// shader needs these to find cluster of a pixel, slice = log(viewZ) * sliceScale + sliceBias
+	struct ShaderParams
+	{
+		unsigned int tilesX = 0;
+		unsigned int tilesY = 0;
+		unsigned int slicesZ = 0;
+		float sliceScale = 0.0f;
+		float sliceBias = 0.0f;
+	};
+
+public:
+	LightClusters(unsigned int tilesX = 16, unsigned int tilesY = 9, unsigned int slicesZ = 24);
+
+public:
+	// rebuilds bounds of clusters, has to be called before first update and every time camera perspective changes
+	void SetProjection(float fovAngleY, float aspectRatio, float nearZ, float farZ);
+
+	// lights are view space positions in xyz and ranges in w
+	void Update(JobSystem& jobSystem, std::span<const DirectX::XMFLOAT4> lights);
+
+	// single threaded version of Update()
+	void Update(std::span<const DirectX::XMFLOAT4> lights);
+
+	// indexed by (slice * tilesY + tileY) * tilesX + tileX, tileY grows down the screen
+	const std::vector<ClusterRange>& GetClusterRanges() const;
+
+	const std::vector<unsigned int>& GetLightIndices() const;
+
+	unsigned int GetNumClusters() const;
+
+	ShaderParams GetShaderParams() const;
+
+public:
+	// bins numLights random lights scattered over the frustum and checks results against brute force binning
+	static BenchmarkResult Benchmark(JobSystem& jobSystem, unsigned int numLights);
+
+	// false when file couldn't be opened
+	static bool SaveBenchmarkResult(const BenchmarkResult& result, const std::filesystem::path& path);
+
+private:
+	void GatherLights(std::span<const DirectX::XMFLOAT4> lights);
+
+	void BinSlice(unsigned int slice);
+
+	// light indices of slices are stored one after another
+	void CalculateSliceOffsets();
+
+	void CopySlice(unsigned int slice);
+
+	static bool SphereIntersectsBox(DirectX::XMFLOAT4 light, DirectX::XMFLOAT3 boxMin, DirectX::XMFLOAT3 boxMax);
+
+private:
+	struct ClusterBounds
+	{
+		DirectX::XMFLOAT3 min;
+		DirectX::XMFLOAT3 max;
+	};
+
+	// lights sorted into one slice, ranges are offsets in slice's own index list
+	struct SliceData
+	{
+		std::vector<float> x, y, z, radiusSquared; // struct of arrays of lights that reach slice depth range, padded to multiple of 4
+		std::vector<unsigned int> candidates;
+		std::vector<unsigned int> lightIndices;
+	};
+
+	unsigned int m_tilesX;
+	unsigned int m_tilesY;
+	unsigned int m_slicesZ;
+
+	float m_nearZ = 0.1f;
+	float m_farZ = 400.0f;
+
+	std::vector<float> m_sliceDepths; // m_slicesZ + 1 boundaries
+	std::vector<ClusterBounds> m_clusterBounds;
+
+	// struct of arrays of all lights, padded to multiple of 4 with lights that can't reach any cluster
+	std::vector<float> m_lightX, m_lightY, m_lightZ, m_lightRadius;
+	unsigned int m_numLights = 0;
+
+	std::vector<SliceData> m_slices;
+	std::vector<unsigned int> m_sliceOffsets;
+
+	std::vector<ClusterRange> m_clusterRanges;
+	std::vector<unsigned int> m_lightIndices;
+};
\ No newline at end of file
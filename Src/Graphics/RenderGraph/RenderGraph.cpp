@@ -1,5 +1,7 @@
 #include "RenderGraph.h"
 #include "Graphics/Core/Graphics.h"
+#include "Macros/ErrorMacros.h"
+#include "Graphics/Profiler/MemoryTracker.h"
 
 #include "RenderPass/Geometry/PreDepthPass.h"
 #include "RenderPass/Geometry/GBufferPass.h"
@@ -12,27 +14,46 @@
 #include "RenderPass/Geometry/OccludedDebugPass.h"
 #include "RenderPass/Geometry/VisibleDebugPass.h"
 
+#include <imgui.h>
+
 void RenderGraph::Initialize(Graphics& graphics)
 {
+	MemoryOwnerScope ownerScope("Render graph");
+
+	using ResourceHandle = FrameGraphCompiler::ResourceHandle;
+
+	// resources owned by Graphics
+	ResourceHandle depthStencilResource = ImportResource("depthStencil", graphics.GetDepthStencil());
+	ResourceHandle backBufferResource = ImportResource("backBuffer", graphics.GetBackBuffer());
+	ResourceHandle swapChainResource = ImportResource("swapChain", graphics.GetSwapChainBuffer());
+
 	{
 		std::shared_ptr<PreDepthPass> preDepthPass = std::make_shared<PreDepthPass>(graphics);
 		preDepthPass->SetDepthStencilView(graphics.GetDepthStencil(), ResourceDataOperation::clear);
 
-		AddRenderPass(preDepthPass);
+		AddRenderPass(preDepthPass, "PreDepth", {}, { depthStencilResource });
 	}
 
-	std::shared_ptr<DepthStencilViewCubeMultiResource> lightDepthData = std::make_shared<DepthStencilViewCubeMultiResource>(graphics);
+	std::shared_ptr<DepthStencilView> shadowAtlas = std::make_shared<DepthStencilView>(graphics, DirectX::XMFLOAT2(ShadowPass::atlasSize, ShadowPass::atlasSize));
+	// shadow faces are cached between frames, so the atlas can't share memory with other resources
+	ResourceHandle shadowMapResource = ImportResource("shadowAtlas", shadowAtlas);
 	{
+		// tiles are cleared one by one when their faces are rendered again
 		std::shared_ptr<ShadowPass> shadowPass = std::make_shared<ShadowPass>(graphics);
-		shadowPass->SetDepthStencilView(lightDepthData, ResourceDataOperation::clear);
+		shadowPass->SetDepthStencilView(shadowAtlas);
 	
-		AddRenderPass(shadowPass);
+		AddRenderPass(shadowPass, "Shadow", {}, { shadowMapResource });
 	}
 
 	DXGI_FORMAT backBufferFormat = graphics.GetBackBuffer()->GetFormat();
 	std::shared_ptr<BackBufferRenderTarget> rt0 = std::make_shared<BackBufferRenderTarget>(graphics, backBufferFormat);
 	std::shared_ptr<BackBufferRenderTarget> rt1 = std::make_shared<BackBufferRenderTarget>(graphics, backBufferFormat);
 	std::shared_ptr<BackBufferRenderTarget> rt2 = std::make_shared<BackBufferRenderTarget>(graphics, backBufferFormat);
+	ResourceHandle gBufferResources[] = {
+		CreateTransientResource(graphics, "gBuffer0", rt0),
+		CreateTransientResource(graphics, "gBuffer1", rt1),
+		CreateTransientResource(graphics, "gBuffer2", rt2),
+	};
 	{
 		std::shared_ptr<GBufferPass> geometryPass = std::make_shared<GBufferPass>(graphics);
 		geometryPass->AddRenderTarget(rt0, ResourceDataOperation::clear);
@@ -40,14 +61,14 @@ void RenderGraph::Initialize(Graphics& graphics)
 		geometryPass->AddRenderTarget(rt2, ResourceDataOperation::clear);
 		geometryPass->SetDepthStencilView(graphics.GetDepthStencil());
 	
-		AddRenderPass(geometryPass);
+		AddRenderPass(geometryPass, "GBuffer", { depthStencilResource }, { gBufferResources[0], gBufferResources[1], gBufferResources[2] });
 	}
 
 	std::shared_ptr<ShaderResourceViewMultiResource> rt0srv = std::make_shared<ShaderResourceViewMultiResource>(graphics, rt0.get(), 0);
 	std::shared_ptr<ShaderResourceViewMultiResource> rt1srv = std::make_shared<ShaderResourceViewMultiResource>(graphics, rt1.get(), 1);
 	std::shared_ptr<ShaderResourceViewMultiResource> rt2srv = std::make_shared<ShaderResourceViewMultiResource>(graphics, rt2.get(), 2);
 	std::shared_ptr<ShaderResourceViewMultiResource> depthsrv = std::make_shared<ShaderResourceViewMultiResource>(graphics, graphics.GetDepthStencil().get(), 3);
-	std::shared_ptr<ShaderResourceViewMultiResource> shadowMap = std::make_shared<ShaderResourceViewMultiResource>(graphics, lightDepthData.get(), 4);
+	std::shared_ptr<ShaderResourceView> shadowMap = std::make_shared<ShaderResourceView>(graphics, shadowAtlas->GetResource(graphics), 0, 4);
 	{
 		std::shared_ptr<LightningPass> lightningPass = std::make_shared<LightningPass>(graphics);
 		lightningPass->AddRenderTarget(graphics.GetBackBuffer());
@@ -57,7 +78,7 @@ void RenderGraph::Initialize(Graphics& graphics)
 		lightningPass->AddBindable(depthsrv);
 		lightningPass->AddBindable(shadowMap);
 
-		AddRenderPass(lightningPass);
+		AddRenderPass(lightningPass, "Lightning", { gBufferResources[0], gBufferResources[1], gBufferResources[2], depthStencilResource, shadowMapResource }, { backBufferResource });
 	}
 
 	{
@@ -65,14 +86,15 @@ void RenderGraph::Initialize(Graphics& graphics)
 		emissivePass->AddRenderTarget(graphics.GetBackBuffer());
 		emissivePass->SetDepthStencilView(graphics.GetDepthStencil());
 
-		AddRenderPass(emissivePass);
+		AddRenderPass(emissivePass, "Emissive", { depthStencilResource }, { backBufferResource });
 	}
 
 	{
 		std::shared_ptr<SkyboxPass> skyBoxPass = std::make_shared<SkyboxPass>(graphics);
 		skyBoxPass->AddRenderTarget(graphics.GetBackBuffer());
 		skyBoxPass->SetDepthStencilView(graphics.GetDepthStencil());
-		AddRenderPass(skyBoxPass);
+
+		AddRenderPass(skyBoxPass, "Skybox", { depthStencilResource }, { backBufferResource });
 	}
 
 	{
@@ -80,7 +102,7 @@ void RenderGraph::Initialize(Graphics& graphics)
 		visibleDebugPass->AddRenderTarget(graphics.GetBackBuffer());
 		visibleDebugPass->SetDepthStencilView(graphics.GetDepthStencil());
 
-		AddRenderPass(visibleDebugPass);
+		AddRenderPass(visibleDebugPass, "VisibleDebug", { depthStencilResource }, { backBufferResource });
 	}
 
 	{
@@ -88,20 +110,27 @@ void RenderGraph::Initialize(Graphics& graphics)
 		occludedDebugPass->AddRenderTarget(graphics.GetBackBuffer());
 		occludedDebugPass->SetDepthStencilView(graphics.GetDepthStencil());
 
-		AddRenderPass(occludedDebugPass);
+		AddRenderPass(occludedDebugPass, "OccludedDebug", { depthStencilResource }, { backBufferResource });
 	}
 
 	{
 		std::shared_ptr<FullscreenPlaceholderPass> fullscreenPass = std::make_shared<FullscreenPlaceholderPass>(graphics);
 		fullscreenPass->AddRenderTarget(graphics.GetSwapChainBuffer(), ResourceDataOperation::discard);
-		AddRenderPass(fullscreenPass);
+
+		AddRenderPass(fullscreenPass, "Fullscreen", { backBufferResource }, { swapChainResource });
 	}
 
 	{
 		std::shared_ptr<GuiPass> guiPass = std::make_shared<GuiPass>(graphics);
 		guiPass->AddRenderTarget(graphics.GetSwapChainBuffer());
-		AddRenderPass(guiPass);
+
+		AddRenderPass(guiPass, "Gui", {}, { swapChainResource });
 	}
+
+	m_frameGraph.MarkOutput(swapChainResource);
+	m_barrierPlanner.SetFinalState(swapChainResource, D3D12_RESOURCE_STATE_PRESENT);
+
+	CompileFrameGraph(graphics);
 }
 
 void RenderGraph::GatherJobBindables()
@@ -127,8 +156,17 @@ void RenderGraph::InitializePasses(Graphics& graphics, Pipeline& pipeline, Scene
 
 void RenderGraph::UpdatePasses(Graphics& graphics, Pipeline& pipeline, Scene& scene)
 {
-	for (auto& renderPass : m_renderPasses)
+	CullPasses();
+
+	for (size_t position = 0; position < m_renderPasses.size(); position++)
+	{
+		RenderPass* renderPass = m_renderPasses.at(position).get();
+
+		if (m_culledPasses.at(position) && !renderPass->UpdatesWhenCulled())
+			continue;
+
 		renderPass->Update(graphics, pipeline, scene);
+	}
 }
 
 void RenderGraph::SubmitPassesJobs()
@@ -144,11 +182,40 @@ void RenderGraph::AssignNewJobsToPasses()
 
 void RenderGraph::Execute(Graphics& graphics, CommandList* commandList, Scene& scene)
 {
-	for (auto& renderPass : m_renderPasses)
+	// resources can be left in different states by code outside of the graph, in steady state this batch is empty
 	{
-		renderPass->SetCorrectStates(graphics, commandList);
-		renderPass->Execute(graphics, commandList, scene);
+		std::vector<BarrierPlanner::Barrier> frameStartBarriers;
+
+		for (FrameGraphCompiler::ResourceHandle resource = 0; resource < m_barrierPlan.frameStartStates.size(); resource++)
+			if (std::optional<BarrierPlanner::ResourceState> state = m_barrierPlan.frameStartStates.at(resource))
+				frameStartBarriers.push_back({ resource, *state, *state, BarrierPlanner::BarrierType::full });
+
+		m_barrierBatch.clear();
+		AddTransitionBarriers(graphics, frameStartBarriers);
+		commandList->ResourceBarrier(graphics, m_barrierBatch);
+	}
+
+	unsigned int nextAliasingPosition = 0;
+
+	for (size_t livePosition = 0; livePosition < m_livePassPositions.size(); livePosition++)
+	{
+		unsigned int position = m_livePassPositions.at(livePosition);
+
+		m_barrierBatch.clear();
+
+		// resources first used by culled passes are taken over by the next live pass
+		for (; nextAliasingPosition <= position; nextAliasingPosition++)
+			AddAliasingBarriers(graphics, m_compiledFrameGraph.aliasingBarriers.at(nextAliasingPosition));
+
+		AddTransitionBarriers(graphics, m_barrierPlan.passBarriers.at(livePosition));
+		commandList->ResourceBarrier(graphics, m_barrierBatch);
+
+		m_renderPasses.at(position)->Execute(graphics, commandList, scene);
 	}
+
+	m_barrierBatch.clear();
+	AddTransitionBarriers(graphics, m_barrierPlan.finalBarriers);
+	commandList->ResourceBarrier(graphics, m_barrierBatch);
 }
 
 RenderManager& RenderGraph::GetRenderManager()
@@ -156,10 +223,275 @@ RenderManager& RenderGraph::GetRenderManager()
 	return m_renderManager;
 }
 
-void RenderGraph::AddRenderPass(std::shared_ptr<RenderPass> renderPass)
+void RenderGraph::DrawImguiWindow(Graphics& graphics)
+{
+	if (!graphics.GetRenderer().GetImguiLayer().IsVisible())
+		return;
+
+	if (ImGui::Begin("Frame graph"))
+	{
+		for (size_t position = 0; position < m_renderPasses.size(); position++)
+		{
+			RenderPass* renderPass = m_renderPasses.at(position).get();
+			const std::string& passName = m_frameGraph.GetPass(m_compiledFrameGraph.passOrder.at(position)).name;
+
+			bool enabled = renderPass->IsEnabled();
+
+			if (ImGui::Checkbox(passName.c_str(), &enabled))
+				renderPass->SetEnabled(enabled);
+
+			if (m_culledPasses.at(position))
+			{
+				ImGui::SameLine();
+				ImGui::TextDisabled("culled");
+			}
+		}
+
+		ImGui::Separator();
+		ImGui::TextUnformatted(m_frameGraphReport.c_str());
+		ImGui::TextUnformatted(m_barrierReport.c_str());
+	}
+
+	ImGui::End();
+}
+
+void RenderGraph::AddRenderPass(std::shared_ptr<RenderPass> renderPass, std::string name, std::vector<FrameGraphCompiler::ResourceHandle> reads, std::vector<FrameGraphCompiler::ResourceHandle> writes)
 {
 	if (GeometryPass* geometryPass = dynamic_cast<GeometryPass*>(renderPass.get()))
 		m_geometryPasses.push_back(geometryPass);
 
+	FrameGraphCompiler::PassHandle passHandle = m_frameGraph.AddPass(std::move(name), reads, writes);
+
+	THROW_INTERNAL_ERROR_IF("Frame graph pass handle doesn't match pass index", passHandle != m_renderPasses.size());
+
+	for (FrameGraphCompiler::ResourceHandle resource : reads)
+		m_barrierPlanner.SetUsageState(passHandle, resource, GetPassResourceState(renderPass.get(), resource));
+
+	for (FrameGraphCompiler::ResourceHandle resource : writes)
+		m_barrierPlanner.SetUsageState(passHandle, resource, GetPassResourceState(renderPass.get(), resource));
+
 	m_renderPasses.push_back(renderPass);
+}
+
+FrameGraphCompiler::ResourceHandle RenderGraph::ImportResource(std::string name, std::shared_ptr<RenderTarget> renderTarget)
+{
+	m_frameGraphResources.push_back({ renderTarget, nullptr });
+
+	return m_frameGraph.ImportResource(std::move(name));
+}
+
+FrameGraphCompiler::ResourceHandle RenderGraph::ImportResource(std::string name, std::shared_ptr<DepthStencilViewBase> depthStencil)
+{
+	m_frameGraphResources.push_back({ nullptr, depthStencil });
+
+	return m_frameGraph.ImportResource(std::move(name));
+}
+
+FrameGraphCompiler::ResourceHandle RenderGraph::CreateTransientResource(Graphics& graphics, std::string name, std::shared_ptr<BackBufferRenderTarget> renderTarget)
+{
+	m_frameGraphResources.push_back({ renderTarget, nullptr, renderTarget.get() });
+
+	D3D12_RESOURCE_DESC resourceDesc = renderTarget->GetResourceDesc(graphics);
+	D3D12_RESOURCE_ALLOCATION_INFO allocationInfo = graphics.GetDevice().GetResourceAllocationInfo(resourceDesc);
+
+	return m_frameGraph.CreateTransientResource(std::move(name), allocationInfo.SizeInBytes, allocationInfo.Alignment);
+}
+
+void RenderGraph::CompileFrameGraph(Graphics& graphics)
+{
+	m_compiledFrameGraph = m_frameGraph.Compile();
+	m_splitBarriers.assign(m_frameGraphResources.size(), {});
+
+	PlaceTransientResources(graphics);
+
+	m_frameGraphReport = m_frameGraph.GetMemoryReport(m_compiledFrameGraph);
+
+	// passes were added in declaration order, executing them in compiled order
+	std::vector<std::shared_ptr<RenderPass>> declaredPasses = std::move(m_renderPasses);
+
+	m_renderPasses.clear();
+	m_renderPasses.reserve(declaredPasses.size());
+
+	for (FrameGraphCompiler::PassHandle pass : m_compiledFrameGraph.passOrder)
+		m_renderPasses.push_back(declaredPasses.at(pass));
+
+	CullPasses();
+}
+
+void RenderGraph::PlaceTransientResources(Graphics& graphics)
+{
+	const size_t heapSize = m_compiledFrameGraph.aliasedMemorySize;
+
+	if (heapSize == 0)
+		return;
+
+	m_transientHeaps.resize(graphics.GetBufferCount());
+	m_transientMemory = MemoryTracker::Track(MemoryCategory::RenderTargets, heapSize * m_transientHeaps.size());
+
+	D3D12_HEAP_DESC heapDesc = {};
+	heapDesc.SizeInBytes = UINT64(heapSize);
+	heapDesc.Properties.Type = D3D12_HEAP_TYPE_DEFAULT;
+	heapDesc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+	heapDesc.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES;
+
+	for (Microsoft::WRL::ComPtr<ID3D12Heap>& heap : m_transientHeaps)
+		heap = graphics.GetDevice().CreateHeap(graphics, heapDesc);
+
+	// nothing was recorded yet, so committed resources created with render targets can be released right away
+	for (FrameGraphCompiler::ResourceHandle resource = 0; resource < m_frameGraphResources.size(); resource++)
+	{
+		BackBufferRenderTarget* transientRenderTarget = m_frameGraphResources.at(resource).transientRenderTarget;
+
+		if (transientRenderTarget == nullptr || !m_compiledFrameGraph.lifetimes.at(resource).IsUsed())
+			continue;
+
+		transientRenderTarget->PlaceInHeaps(graphics, m_transientHeaps, m_compiledFrameGraph.memoryOffsets.at(resource));
+	}
+}
+
+void RenderGraph::CullPasses()
+{
+	const unsigned int numPasses = m_frameGraph.GetNumPasses();
+
+	bool enabledPassesChanged = m_enabledPasses.size() != numPasses;
+	m_enabledPasses.resize(numPasses);
+
+	for (size_t position = 0; position < m_renderPasses.size(); position++)
+	{
+		const RenderPass* renderPass = m_renderPasses.at(position).get();
+		FrameGraphCompiler::PassHandle pass = m_compiledFrameGraph.passOrder.at(position);
+
+		bool enabled = renderPass->IsEnabled() && renderPass->HasWork();
+
+		if (m_enabledPasses.at(pass) != enabled)
+		{
+			m_enabledPasses.at(pass) = enabled;
+			enabledPassesChanged = true;
+		}
+	}
+
+	if (!enabledPassesChanged)
+		return;
+
+	// barriers are planned only between passes that will be executed
+	std::vector<bool> livePasses = m_frameGraph.GetLivePasses(m_compiledFrameGraph, m_enabledPasses);
+
+	FrameGraphCompiler::CompiledGraph liveFrameGraph = m_compiledFrameGraph;
+	liveFrameGraph.passOrder.clear();
+
+	m_livePassPositions.clear();
+	m_culledPasses.assign(m_renderPasses.size(), true);
+
+	for (unsigned int position = 0; position < m_renderPasses.size(); position++)
+	{
+		FrameGraphCompiler::PassHandle pass = m_compiledFrameGraph.passOrder.at(position);
+
+		if (!livePasses.at(pass))
+			continue;
+
+		liveFrameGraph.passOrder.push_back(pass);
+		m_livePassPositions.push_back(position);
+		m_culledPasses.at(position) = false;
+	}
+
+	m_barrierPlan = m_barrierPlanner.Compile(m_frameGraph, liveFrameGraph);
+	m_barrierReport = m_barrierPlanner.GetReport(m_frameGraph, liveFrameGraph, m_barrierPlan);
+}
+
+D3D12_RESOURCE_STATES RenderGraph::GetPassResourceState(const RenderPass* renderPass, FrameGraphCompiler::ResourceHandle resource) const
+{
+	const FrameGraphResource& frameGraphResource = m_frameGraphResources.at(resource);
+
+	if (frameGraphResource.renderTarget)
+		for (const RenderPass::RenderTargetData& renderTarget : renderPass->GetRenderTargets())
+			if (renderTarget.resource == frameGraphResource.renderTarget)
+				return D3D12_RESOURCE_STATE_RENDER_TARGET;
+
+	if (frameGraphResource.depthStencil && renderPass->GetDepthStencilView().resource == frameGraphResource.depthStencil)
+		return D3D12_RESOURCE_STATE_DEPTH_WRITE;
+
+	// everything not bound as output is read through shader resource view
+	return D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE;
+}
+
+void RenderGraph::AddTransitionBarriers(Graphics& graphics, const std::vector<BarrierPlanner::Barrier>& barriers)
+{
+	for (const BarrierPlanner::Barrier& barrier : barriers)
+	{
+		const FrameGraphResource& frameGraphResource = m_frameGraphResources.at(barrier.resource);
+		D3D12_RESOURCE_BARRIER& splitBarrier = m_splitBarriers.at(barrier.resource);
+
+		if (barrier.type == BarrierPlanner::BarrierType::end)
+		{
+			// begin could be skipped when resource already was in the right state
+			if (splitBarrier.Transition.pResource == nullptr)
+				continue;
+
+			splitBarrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_END_ONLY;
+			m_barrierBatch.push_back(splitBarrier);
+
+			splitBarrier = {};
+			continue;
+		}
+
+		// planned states assume steady state, the tracked one is always right
+		D3D12_RESOURCE_STATES stateBefore = frameGraphResource.GetResourceState(graphics);
+		D3D12_RESOURCE_STATES stateAfter = D3D12_RESOURCE_STATES(barrier.stateAfter);
+
+		if (stateBefore == stateAfter)
+			continue;
+
+		D3D12_RESOURCE_BARRIER resourceBarrier = {};
+		resourceBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+		resourceBarrier.Flags = barrier.type == BarrierPlanner::BarrierType::begin ? D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY : D3D12_RESOURCE_BARRIER_FLAG_NONE;
+		resourceBarrier.Transition.pResource = frameGraphResource.GetResource(graphics);
+		resourceBarrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+		resourceBarrier.Transition.StateBefore = stateBefore;
+		resourceBarrier.Transition.StateAfter = stateAfter;
+
+		m_barrierBatch.push_back(resourceBarrier);
+
+		if (barrier.type == BarrierPlanner::BarrierType::begin)
+			splitBarrier = resourceBarrier;
+
+		frameGraphResource.SetResourceState(graphics, stateAfter);
+	}
+}
+
+void RenderGraph::AddAliasingBarriers(Graphics& graphics, const std::vector<FrameGraphCompiler::AliasingBarrier>& barriers)
+{
+	for (const FrameGraphCompiler::AliasingBarrier& barrier : barriers)
+	{
+		D3D12_RESOURCE_BARRIER resourceBarrier = {};
+		resourceBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_ALIASING;
+		resourceBarrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+		resourceBarrier.Aliasing.pResourceBefore = barrier.resourceBefore != FrameGraphCompiler::invalidResource ? m_frameGraphResources.at(barrier.resourceBefore).GetResource(graphics) : nullptr;
+		resourceBarrier.Aliasing.pResourceAfter = m_frameGraphResources.at(barrier.resourceAfter).GetResource(graphics);
+
+		m_barrierBatch.push_back(resourceBarrier);
+	}
+}
+
+ID3D12Resource* RenderGraph::FrameGraphResource::GetResource(Graphics& graphics) const
+{
+	if (renderTarget)
+		return renderTarget->GetResource(graphics);
+
+	return depthStencil->GetResource(graphics)->GetResource();
+}
+
+D3D12_RESOURCE_STATES RenderGraph::FrameGraphResource::GetResourceState(Graphics& graphics) const
+{
+	if (renderTarget)
+		return renderTarget->GetResourceState(graphics);
+
+	return depthStencil->GetResource(graphics)->GetResourceState(0);
+}
+
+void RenderGraph::FrameGraphResource::SetResourceState(Graphics& graphics, D3D12_RESOURCE_STATES newState) const
+{
+	if (renderTarget)
+		renderTarget->SetResourceState(graphics, newState);
+	else
+		depthStencil->GetResource(graphics)->SetAllResourceStates(newState);
 }
\ No newline at end of file
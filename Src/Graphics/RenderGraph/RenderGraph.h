@@ -2,6 +2,9 @@
 #include "Includes/CppIncludes.h"
 #include "RenderPass/RenderPass.h"
 #include "RenderManager.h"
+#include "FrameGraphCompiler.h"
+#include "BarrierPlanner.h"
+#include "Graphics/Profiler/MemoryTracker.h"
 
 class Graphics;
 class Pipeline;
@@ -30,11 +33,67 @@ public:
 	void Execute(Graphics& graphics, CommandList* commandList, Scene& scene);
 
 	RenderManager& GetRenderManager();
+
+	void DrawImguiWindow(Graphics& graphics);
 	
 private:
-	void AddRenderPass(std::shared_ptr<RenderPass> renderPass);
+	// declares which frame graph resources pass reads and writes, execution order is resolved in CompileFrameGraph()
+	void AddRenderPass(std::shared_ptr<RenderPass> renderPass, std::string name, std::vector<FrameGraphCompiler::ResourceHandle> reads, std::vector<FrameGraphCompiler::ResourceHandle> writes);
+
+	FrameGraphCompiler::ResourceHandle ImportResource(std::string name, std::shared_ptr<RenderTarget> renderTarget);
+	FrameGraphCompiler::ResourceHandle ImportResource(std::string name, std::shared_ptr<DepthStencilViewBase> depthStencil);
+
+	// resources of render target are moved to shared transient heaps once the frame graph is compiled
+	FrameGraphCompiler::ResourceHandle CreateTransientResource(Graphics& graphics, std::string name, std::shared_ptr<BackBufferRenderTarget> renderTarget);
+
+	void CompileFrameGraph(Graphics& graphics);
+
+	// creates one heap per buffer and places transient resources at offsets chosen by frame graph compiler
+	void PlaceTransientResources(Graphics& graphics);
+
+	// finds passes that have to be executed this frame and plans barriers between them when that changes
+	void CullPasses();
+
+	// state in which pass expects resource, decided by the way pass binds it
+	D3D12_RESOURCE_STATES GetPassResourceState(const RenderPass* renderPass, FrameGraphCompiler::ResourceHandle resource) const;
+
+	// adds planned transitions to current barrier batch
+	void AddTransitionBarriers(Graphics& graphics, const std::vector<BarrierPlanner::Barrier>& barriers);
+
+	// adds barriers of transient resources taking over shared memory to current barrier batch
+	void AddAliasingBarriers(Graphics& graphics, const std::vector<FrameGraphCompiler::AliasingBarrier>& barriers);
 
 private:
+	// real resource behind frame graph handle, only one of them is set
+	struct FrameGraphResource
+	{
+		std::shared_ptr<RenderTarget> renderTarget;
+		std::shared_ptr<DepthStencilViewBase> depthStencil;
+		BackBufferRenderTarget* transientRenderTarget = nullptr; // set when resource lives in transient heaps
+
+		ID3D12Resource* GetResource(Graphics& graphics) const;
+		D3D12_RESOURCE_STATES GetResourceState(Graphics& graphics) const;
+		void SetResourceState(Graphics& graphics, D3D12_RESOURCE_STATES newState) const;
+	};
+
+	FrameGraphCompiler m_frameGraph;
+	FrameGraphCompiler::CompiledGraph m_compiledFrameGraph;
+	std::vector<FrameGraphResource> m_frameGraphResources;
+	std::string m_frameGraphReport;
+
+	std::vector<Microsoft::WRL::ComPtr<ID3D12Heap>> m_transientHeaps; // indexed by buffer index
+	MemoryTracker::Allocation m_transientMemory;
+
+	std::vector<bool> m_enabledPasses; // indexed by pass handle
+	std::vector<bool> m_culledPasses; // indexed by position in m_renderPasses
+	std::vector<unsigned int> m_livePassPositions;
+
+	BarrierPlanner m_barrierPlanner = BarrierPlanner(D3D12_RESOURCE_STATE_GENERIC_READ | D3D12_RESOURCE_STATE_DEPTH_READ);
+	BarrierPlanner::Plan m_barrierPlan;
+	std::string m_barrierReport;
+	std::vector<D3D12_RESOURCE_BARRIER> m_barrierBatch;
+	std::vector<D3D12_RESOURCE_BARRIER> m_splitBarriers; // begun split barriers, indexed by resource handle
+
 	std::vector<std::shared_ptr<RenderPass>> m_renderPasses;
 	std::vector<GeometryPass*> m_geometryPasses;
 	RenderManager m_renderManager;
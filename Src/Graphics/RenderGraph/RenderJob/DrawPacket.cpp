@@ -0,0 +1,197 @@
+#include "DrawPacket.h"
+
+#include "Graphics/Core/CommandList.h"
+#include "Graphics/Core/RootSignatureLayout.h"
+
+#include "Includes/BindablesInclude.h"
+#include "Graphics/Bindables/DescriptorHeapBindable.h"
+
+#include "Macros/ErrorMacros.h"
+
+const void* DrawPacketRootParam::GetBoundObject() const
+{
+	switch (type)
+	{
+	case Type::ConstBufferView:				return constBuffer;
+	case Type::BufferView:					return buffer;
+	case Type::ShaderResourceViewTable:		return srv;
+	case Type::DescriptorHeapTable:			return descriptorHeapBindable;
+	case Type::Constants:					return constants;
+	case Type::InstanceBuffer:				return instanceBuffer;
+	default:								return bindable;
+	}
+}
+
+void DrawPacket::SetRootParams(const RootSignatureLayout& layout)
+{
+	numRootParams = 0;
+
+	for (const auto& layoutBinding : layout.GetBindings())
+	{
+		RootSignatureBindable* bindable = layoutBinding.bindable;
+
+		DrawPacketRootParam rootParam = {};
+		rootParam.binding = layoutBinding.binding;
+
+		// static samplers are part of root signature and are never bound
+		if (dynamic_cast<StaticSampler*>(bindable))
+			continue;
+
+		if (auto* constants = dynamic_cast<RootSignatureConstants*>(bindable))
+		{
+			rootParam.type = DrawPacketRootParam::Type::Constants;
+			rootParam.constants = constants;
+		}
+		else if (auto* constBuffer = dynamic_cast<ConstantBuffer*>(bindable))
+		{
+			rootParam.type = DrawPacketRootParam::Type::ConstBufferView;
+			rootParam.constBuffer = constBuffer;
+		}
+		else if (auto* buffer = dynamic_cast<Buffer*>(bindable))
+		{
+			rootParam.type = DrawPacketRootParam::Type::BufferView;
+			rootParam.buffer = buffer;
+		}
+		else if (auto* srv = dynamic_cast<ShaderResourceViewBase*>(bindable))
+		{
+			rootParam.type = DrawPacketRootParam::Type::ShaderResourceViewTable;
+			rootParam.srv = srv;
+		}
+		else if (auto* descriptorHeapBindable = dynamic_cast<DescriptorHeapBindable*>(bindable))
+		{
+			rootParam.type = DrawPacketRootParam::Type::DescriptorHeapTable;
+			rootParam.descriptorHeapBindable = descriptorHeapBindable;
+		}
+		else if (auto* instanceBuffer = dynamic_cast<InstanceBuffer*>(bindable))
+		{
+			rootParam.type = DrawPacketRootParam::Type::InstanceBuffer;
+			rootParam.instanceBuffer = instanceBuffer;
+		}
+		else
+		{
+			rootParam.type = DrawPacketRootParam::Type::Bindable;
+			rootParam.bindable = bindable;
+		}
+
+		THROW_INTERNAL_ERROR_IF("Draw packet can't hold all root parameters", numRootParams == maxRootParams);
+
+		rootParams[numRootParams++] = rootParam;
+	}
+}
+
+void DrawPacket::AddCommandListBindables(const std::vector<CommandListBindable*>& bindables)
+{
+	for (CommandListBindable* bindable : bindables)
+	{
+		if (auto* primitiveTechnology = dynamic_cast<PrimitiveTechnology*>(bindable))
+			topology = primitiveTechnology->GetTopology();
+		else if (auto* bindableViewPort = dynamic_cast<ViewPort*>(bindable))
+			viewPort = bindableViewPort;
+		else
+		{
+			THROW_INTERNAL_ERROR_IF("Draw packet can't hold all command list bindables", numCommandListBindables == maxCommandListBindables);
+
+			commandListBindables[numCommandListBindables++] = bindable;
+		}
+	}
+}
+
+std::span<const DrawPacketRootParam> DrawPacket::GetRootParams() const
+{
+	return { rootParams.data(), numRootParams };
+}
+
+std::span<CommandListBindable* const> DrawPacket::GetCommandListBindables() const
+{
+	return { commandListBindables.data(), numCommandListBindables };
+}
+
+void DrawPacket::Execute(Graphics& graphics, CommandList* commandList, unsigned int instances) const
+{
+	commandList->SetPipelineState(graphics, pipelineState);
+	commandList->SetGraphicsRootSignature(graphics, rootSignature);
+
+	for (const DrawPacketRootParam& rootParam : GetRootParams())
+	{
+		switch (rootParam.type)
+		{
+		case DrawPacketRootParam::Type::ConstBufferView:
+			commandList->SetGraphicsConstBufferView(graphics, rootParam.constBuffer, rootParam.binding);
+			break;
+		case DrawPacketRootParam::Type::BufferView:
+			commandList->SetGraphicsDescriptor(graphics, rootParam.buffer, rootParam.binding);
+			break;
+		case DrawPacketRootParam::Type::ShaderResourceViewTable:
+			commandList->SetGraphicsDescriptorTable(graphics, rootParam.srv, rootParam.binding);
+			break;
+		case DrawPacketRootParam::Type::DescriptorHeapTable:
+			commandList->SetGraphicsDescriptorTable(graphics, rootParam.descriptorHeapBindable, rootParam.binding);
+			break;
+		case DrawPacketRootParam::Type::Constants:
+			commandList->SetRootConstants(graphics, rootParam.constants, rootParam.binding);
+			break;
+		case DrawPacketRootParam::Type::InstanceBuffer:
+			commandList->SetGraphicsInstanceBuffer(graphics, rootParam.instanceBuffer, rootParam.binding);
+			break;
+		case DrawPacketRootParam::Type::Bindable:
+			rootParam.bindable->BindToCommandListAsRootParam(graphics, commandList, rootParam.binding);
+			break;
+		}
+	}
+
+	if (topology != D3D_PRIMITIVE_TOPOLOGY_UNDEFINED)
+		commandList->SetPrimitiveTopology(graphics, topology);
+
+	if (viewPort)
+		commandList->SetViewPort(graphics, viewPort);
+
+	for (CommandListBindable* bindable : GetCommandListBindables())
+		bindable->BindToCommandList(graphics, commandList);
+
+	commandList->SetVertexBuffer(graphics, vertexBuffer);
+	commandList->SetIndexBuffer(graphics, indexBuffer);
+
+	commandList->DrawIndexedInstanced(graphics, indices, instances, baseVertexOffset, startIndexOffset);
+}
+
+bool DrawPacket::IsInstanceOf(const DrawPacket& other) const
+{
+	return !IsOrderedBefore(*this, other) && !IsOrderedBefore(other, *this);
+}
+
+bool DrawPacket::IsOrderedBefore(const DrawPacket& left, const DrawPacket& right)
+{
+	// the most expensive state changes go first, so sorted packets change them the least
+	auto getState = [](const DrawPacket& packet)
+		{
+			return std::make_tuple(
+				packet.pipelineState, packet.rootSignature, packet.vertexBuffer, packet.indexBuffer,
+				packet.baseVertexOffset, packet.startIndexOffset, packet.indices, packet.topology, packet.viewPort
+			);
+		};
+
+	auto leftState = getState(left);
+	auto rightState = getState(right);
+
+	if (leftState != rightState)
+		return leftState < rightState;
+
+	auto isRootParamBefore = [](const DrawPacketRootParam& leftParam, const DrawPacketRootParam& rightParam)
+		{
+			return std::make_tuple(leftParam.binding.rootIndex, leftParam.GetBoundObject()) < std::make_tuple(rightParam.binding.rootIndex, rightParam.GetBoundObject());
+		};
+
+	std::span<const DrawPacketRootParam> leftParams = left.GetRootParams();
+	std::span<const DrawPacketRootParam> rightParams = right.GetRootParams();
+
+	if (std::lexicographical_compare(leftParams.begin(), leftParams.end(), rightParams.begin(), rightParams.end(), isRootParamBefore))
+		return true;
+
+	if (std::lexicographical_compare(rightParams.begin(), rightParams.end(), leftParams.begin(), leftParams.end(), isRootParamBefore))
+		return false;
+
+	std::span<CommandListBindable* const> leftBindables = left.GetCommandListBindables();
+	std::span<CommandListBindable* const> rightBindables = right.GetCommandListBindables();
+
+	return std::lexicographical_compare(leftBindables.begin(), leftBindables.end(), rightBindables.begin(), rightBindables.end());
+}
\ No newline at end of file
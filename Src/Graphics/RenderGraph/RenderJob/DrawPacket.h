@@ -0,0 +1,94 @@
+#pragma once
+#include "Includes/CppIncludes.h"
+#include "Includes/DirectXIncludes.h"
+#include "Graphics/Bindables/Bindable.h"
+
+class PipelineState;
+class RootSignature;
+class RootSignatureLayout;
+class VertexBuffer;
+class IndexBuffer;
+class ViewPort;
+class ConstantBuffer;
+class Buffer;
+class ShaderResourceViewBase;
+class DescriptorHeapBindable;
+class RootSignatureConstants;
+class InstanceBuffer;
+
+// root parameter with CommandList call that binds it chosen when packet is built
+struct DrawPacketRootParam
+{
+	enum class Type : uint8_t
+	{
+		ConstBufferView,
+		BufferView,
+		ShaderResourceViewTable,
+		DescriptorHeapTable,
+		Constants,
+		InstanceBuffer,
+		Bindable, // not known to packet, bound through virtual call
+	};
+
+	Type type;
+	RootBinding binding;
+
+	union
+	{
+		ConstantBuffer* constBuffer;
+		Buffer* buffer;
+		ShaderResourceViewBase* srv;
+		DescriptorHeapBindable* descriptorHeapBindable;
+		RootSignatureConstants* constants;
+		InstanceBuffer* instanceBuffer;
+		RootSignatureBindable* bindable;
+	};
+
+public:
+	const void* GetBoundObject() const;
+};
+
+// everything one indexed draw binds, resolved from bindable containers once instead of on every draw.
+// Only pointers to bindables are kept, so GPU addresses and descriptors that change between frames
+// and buffer views that change when suballocators grow are still read while recording.
+// Bindings are stored inline so packets of sorted jobs are compared and executed without chasing heap allocations
+struct DrawPacket
+{
+	static constexpr unsigned int maxRootParams = 16;
+	static constexpr unsigned int maxCommandListBindables = 8;
+
+	PipelineState* pipelineState = nullptr;
+	RootSignature* rootSignature = nullptr;
+
+	VertexBuffer* vertexBuffer = nullptr;
+	IndexBuffer* indexBuffer = nullptr;
+
+	D3D_PRIMITIVE_TOPOLOGY topology = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED; // not set when undefined
+	ViewPort* viewPort = nullptr;
+
+	unsigned int indices = 0;
+	unsigned int baseVertexOffset = 0;
+	unsigned int startIndexOffset = 0;
+
+	std::array<DrawPacketRootParam, maxRootParams> rootParams = {};
+	std::array<CommandListBindable*, maxCommandListBindables> commandListBindables = {}; // not known to packet, bound through virtual call
+	uint8_t numRootParams = 0;
+	uint8_t numCommandListBindables = 0;
+
+public:
+	std::span<const DrawPacketRootParam> GetRootParams() const;
+	std::span<CommandListBindable* const> GetCommandListBindables() const;
+
+	void SetRootParams(const RootSignatureLayout& layout);
+
+	// topology and viewport are taken out of list, later ones override earlier ones like when they were bound in order
+	void AddCommandListBindables(const std::vector<CommandListBindable*>& bindables);
+
+	void Execute(Graphics& graphics, CommandList* commandList, unsigned int instances = 1) const;
+
+	// packets that bind the same things and draw the same geometry can be drawn as instances of one draw
+	bool IsInstanceOf(const DrawPacket& other) const;
+
+	// strict ordering that keeps packets drawable as instances of one draw next to each other
+	static bool IsOrderedBefore(const DrawPacket& left, const DrawPacket& right);
+};
\ No newline at end of file
@@ -43,8 +43,6 @@ void RenderGraphicsFullscreenJob::InitializeGraphicResources(Graphics& graphics,
 
 void RenderGraphicsFullscreenJob::Execute(Graphics& graphics, CommandList* commandList) const
 {
-	START_CPU_EVENT(PIX_COLOR(0, 127, 127), "DrawIndexed");
-
 	commandList->SetPipelineState(graphics, m_pipelineState.get());
 
 	commandList->SetGraphicsRootSignature(graphics, m_rootSignature.get());
@@ -82,8 +80,6 @@ void RenderGraphicsFullscreenJob::Execute(Graphics& graphics, CommandList* comma
 	unsigned int startIndexOffset = indexBufferEntry->GetEntryInfo()->elementOffset;
 
 	commandList->DrawIndexed(graphics, indices, baseVertexOffset, startIndexOffset);
-
-	END_CPU_EVENT();
 }
 
 void RenderGraphicsFullscreenJob::BuildRootSignature(Graphics& graphics)
@@ -37,47 +37,45 @@ void RenderGraphicsGeometryJob::Initialize(Graphics& graphics, Pipeline& pipelin
 
 	InitializeGraphicResources(graphics, pipeline);
 
-	m_stepLastRevision = m_step->GetBindableContainer().GetRevision();
+	BuildDrawPacket();
+
+	m_step->GetBindableContainer().RegisterForInvalidation(this);
 
 	if(material)
-		m_materialLastRevision = material->GetBindableContainer().GetRevision();
+		material->GetBindableContainer().RegisterForInvalidation(this);
 
 	if(m_pass)
-		m_passLastRevision = m_pass->GetBindableContainer().GetRevision();
+		m_pass->GetBindableContainer().RegisterForInvalidation(this);
 }
 
-void HandleRevision(auto* obj, BindableContainerRevision& cached, bool& rsDirty, bool& psoDirty)
+void RenderGraphicsGeometryJob::Update(Graphics& graphics)
 {
-	if (!obj)
-		return;
+	int invalidation = m_pendingInvalidation;
+	m_pendingInvalidation = invalidation_none;
 
-	const auto& revision = obj->GetBindableContainer().GetRevision();
+	auto* stepMaterial = m_step->GetMaterial();
 
-	if (revision.rootSignatureRevision != cached.rootSignatureRevision)
-		rsDirty = true;
+	if (invalidation & invalidation_rootSignature)
+		BuildRootSignature(graphics, stepMaterial);
 
-	if (revision.pipelineStateRevision != cached.pipelineStateRevision)
-		psoDirty = true;
+	if (invalidation & (invalidation_rootSignature | invalidation_pipelineState))
+		BuildPipelineState(graphics, stepMaterial);
 
-	cached = revision;
+	BuildDrawPacket();
 }
 
-void RenderGraphicsGeometryJob::Update(Graphics& graphics)
+void RenderGraphicsGeometryJob::InvalidationCallback(int invalidation)
 {
-	bool psoDirty = false;
-	bool rsDirty = false;
-
-	auto* stepMaterial = m_step->GetMaterial();
+	// descriptors are read while recording through bindables packet points to, so they don't need rebuilding
+	invalidation &= invalidation_commandList | invalidation_rootSignature | invalidation_pipelineState;
 
-	HandleRevision(m_step, m_stepLastRevision, rsDirty, psoDirty);
-	HandleRevision(stepMaterial, m_materialLastRevision, rsDirty, psoDirty);
-	HandleRevision(m_pass, m_passLastRevision, rsDirty, psoDirty);
+	if (invalidation == invalidation_none)
+		return;
 
-	if (rsDirty)
-		BuildRootSignature(graphics, stepMaterial);
+	if (m_pendingInvalidation == invalidation_none)
+		m_pass->AddInvalidatedJob(this);
 
-	if (psoDirty || rsDirty)
-		BuildPipelineState(graphics, stepMaterial);
+	m_pendingInvalidation |= invalidation;
 }
 
 void RenderGraphicsGeometryJob::InitializeGraphicResources(Graphics& graphics, Pipeline& pipeline)
@@ -105,8 +103,39 @@ bool RenderGraphicsGeometryJob::IsValid(RenderPass* pass, Scene& scene) const
 
 void RenderGraphicsGeometryJob::Execute(Graphics& graphics, CommandList* commandList) const
 {
-	START_CPU_EVENT(PIX_COLOR(0, 127, 127), "DrawIndexed");
+	ExecuteInstanced(graphics, commandList, 1);
+}
+
+void RenderGraphicsGeometryJob::ExecuteInstanced(Graphics& graphics, CommandList* commandList, unsigned int instances) const
+{
+	if (s_drawPacketsEnabled)
+		m_drawPacket.Execute(graphics, commandList, instances);
+	else
+		ExecuteFromBindables(graphics, commandList, instances);
+}
+
+RenderGraphicsGeometryStep* RenderGraphicsGeometryJob::GetStep() const
+{
+	return m_step;
+}
+
+const DrawPacket& RenderGraphicsGeometryJob::GetDrawPacket() const
+{
+	return m_drawPacket;
+}
+
+void RenderGraphicsGeometryJob::SetDrawPacketsEnabled(bool enabled)
+{
+	s_drawPacketsEnabled = enabled;
+}
+
+bool RenderGraphicsGeometryJob::AreDrawPacketsEnabled()
+{
+	return s_drawPacketsEnabled;
+}
 
+void RenderGraphicsGeometryJob::ExecuteFromBindables(Graphics& graphics, CommandList* commandList, unsigned int instances) const
+{
 	commandList->SetPipelineState(graphics, m_pipelineState.get());
 
 	commandList->SetGraphicsRootSignature(graphics, m_rootSignature.get());
@@ -159,26 +188,57 @@ void RenderGraphicsGeometryJob::Execute(Graphics& graphics, CommandList* command
 	unsigned int baseVertexOffset = vertexBufferEntry->GetEntryInfo()->elementOffset;
 	unsigned int startIndexOffset = indexBufferEntry->GetEntryInfo()->elementOffset;
 
-	commandList->DrawIndexed(graphics, indices, baseVertexOffset, startIndexOffset);
-
-	END_CPU_EVENT();
+	commandList->DrawIndexedInstanced(graphics, indices, instances, baseVertexOffset, startIndexOffset);
 }
 
-RenderGraphicsGeometryStep* RenderGraphicsGeometryJob::GetStep() const
+void RenderGraphicsGeometryJob::BuildDrawPacket()
 {
-	return m_step;
+	const auto& stepBindableContainer = m_step->GetBindableContainer();
+	Material* material = m_step->GetMaterial();
+
+	// offsets of suballocated entries never move, only buffers that hold them can be recreated
+	auto indexBufferEntry = stepBindableContainer.GetIndexBufferEntry();
+	auto vertexBufferEntry = stepBindableContainer.GetAttributeVertexBufferEntry();
+
+	if (!vertexBufferEntry)
+		vertexBufferEntry = stepBindableContainer.GetPositionVertexBufferEntry();
+
+	THROW_INTERNAL_ERROR_IF("Position buffer and Attribute buffer were both NULL", !vertexBufferEntry);
+	THROW_INTERNAL_ERROR_IF("Index buffer hasn't been bound", !indexBufferEntry);
+
+	DrawPacket drawPacket = {};
+	drawPacket.pipelineState = m_pipelineState.get();
+	drawPacket.rootSignature = m_rootSignature.get();
+
+	drawPacket.SetRootParams(m_rootSignatureLayout);
+
+	// ExecuteFromBindables() binds material twice, only the second bind decides what is bound at the draw
+	drawPacket.AddCommandListBindables(stepBindableContainer.GetCommandListBindables());
+
+	if (m_pass)
+		drawPacket.AddCommandListBindables(m_pass->GetBindableContainer().GetCommandListBindables());
+
+	if (material)
+		drawPacket.AddCommandListBindables(material->GetBindableContainer().GetCommandListBindables());
+
+	drawPacket.vertexBuffer = vertexBufferEntry->GetVertexBuffer();
+	drawPacket.indexBuffer = indexBufferEntry->GetIndexBuffer();
+
+	drawPacket.indices = indexBufferEntry->GetIndexCount();
+	drawPacket.baseVertexOffset = unsigned int(vertexBufferEntry->GetEntryInfo()->elementOffset);
+	drawPacket.startIndexOffset = unsigned int(indexBufferEntry->GetEntryInfo()->elementOffset);
+
+	m_drawPacket = std::move(drawPacket);
 }
 
 RasterizerState* RenderGraphicsGeometryJob::BuildAndGetRasterizerState(Graphics& graphics, Material* material)
 {
 	ObjectRasterizerStateOptions objectRasterizerOptions = material ? material->GetRasterizerOptions() : m_step->GetRasterizerOptions();
 
-	std::shared_ptr<RasterizerState> rasterizerState = RasterizerState::GetResource(graphics, m_pass->GetRasterizerOptions(), objectRasterizerOptions);
-	RasterizerState* pRasterizerState = rasterizerState.get();
-
-	m_step->AddBindable(std::move(rasterizerState));
+	// kept by job instead of step, adding it to step would invalidate every job of the step
+	m_rasterizerState = RasterizerState::GetResource(graphics, m_pass->GetRasterizerOptions(), objectRasterizerOptions);
 
-	return pRasterizerState;
+	return m_rasterizerState.get();
 }
 
 void RenderGraphicsGeometryJob::BuildRootSignature(Graphics& graphics, Material* material)
@@ -1,13 +1,18 @@
 #pragma once
 #include "GraphicsRenderJob.h"
 #include "Graphics/RenderGraph/RenderJob/GraphicsRenderData.h"
+#include "Graphics/RenderGraph/RenderJob/DrawPacket.h"
 #include "Graphics/Core/BindableContainer.h"
 
 class RenderGraphicsGeometryStep;
 class GeometryPass;
 class Material;
 
-class RenderGraphicsGeometryJob : public GraphicsRenderJob
+// rebuilds its root signature and pipeline state only when step, material or pass pushes invalidation.
+// Containers of steps and materials are destroyed with scene before render graph and pass container isn't invalidated
+// while its jobs are destroyed, so job never unregisters and containers keep no way to do it.
+// Everything the draw binds is baked into DrawPacket whenever it's rebuilt, so Execute() doesn't walk containers
+class RenderGraphicsGeometryJob : public GraphicsRenderJob, public BindableContainerListener
 {
 public:
 	RenderGraphicsGeometryJob(GraphicsRenderData renderData, GeometryPass* pass);
@@ -15,17 +20,33 @@ public:
 public:
 	virtual void Initialize(Graphics& graphics, Pipeline& pipeline) override;
 
+	// rebuilds what was invalidated since last update
 	virtual void Update(Graphics& graphics) override;
 
+	virtual void InvalidationCallback(int invalidation) override;
+
 	void InitializeGraphicResources(Graphics& graphics, Pipeline& pipeline);
 
 	virtual bool IsValid(RenderPass* pass, Scene& scene) const override;
 
 	virtual void Execute(Graphics& graphics, CommandList* commandList) const override;
 
+	// draws instances of geometry, pass points instance buffer at their scene indices before
+	void ExecuteInstanced(Graphics& graphics, CommandList* commandList, unsigned int instances) const;
+
 	RenderGraphicsGeometryStep* GetStep() const;
 
+	const DrawPacket& GetDrawPacket() const;
+
+	// when disabled, jobs bind straight from bindable containers like before draw packets, used to compare both paths
+	static void SetDrawPacketsEnabled(bool enabled);
+	static bool AreDrawPacketsEnabled();
+
 private:
+	void ExecuteFromBindables(Graphics& graphics, CommandList* commandList, unsigned int instances) const;
+
+	void BuildDrawPacket();
+
 	RasterizerState* BuildAndGetRasterizerState(Graphics& graphics, Material* material);
 
 	void BuildRootSignature(Graphics& graphics, Material* material);
@@ -36,7 +57,12 @@ protected:
 	RenderGraphicsGeometryStep* m_step;
 	GeometryPass* m_pass;
 
-	BindableContainerRevision m_stepLastRevision;
-	BindableContainerRevision m_materialLastRevision;
-	BindableContainerRevision m_passLastRevision;
+	std::shared_ptr<RasterizerState> m_rasterizerState;
+
+	int m_pendingInvalidation = invalidation_none;
+
+	DrawPacket m_drawPacket;
+
+private:
+	static inline bool s_drawPacketsEnabled = true;
 };
\ No newline at end of file
@@ -2,6 +2,15 @@
 #include "Scene/Objects/Camera.h"
 #include "Scene/Scene.h"
 #include "Graphics/Core/Graphics.h"
+#include "Graphics/Data/StaticLayout.h"
+
+static constexpr DynamicConstantBuffer::StaticLayout cameraDataLayout({
+	{ DynamicConstantBuffer::ElementType::Float, "nearPlane" },
+	{ DynamicConstantBuffer::ElementType::Float, "farPlane" }
+});
+
+static constexpr auto nearPlaneHandle = cameraDataLayout.GetHandle<DynamicConstantBuffer::ElementType::Float>("nearPlane");
+static constexpr auto farPlaneHandle = cameraDataLayout.GetHandle<DynamicConstantBuffer::ElementType::Float>("farPlane");
 
 FullscreenPlaceholderPass::FullscreenPlaceholderPass(Graphics& graphics)
 	:
@@ -11,13 +20,11 @@ FullscreenPlaceholderPass::FullscreenPlaceholderPass(Graphics& graphics)
 
 	// camera data
 	{
-		DynamicConstantBuffer::Layout layout;
-		layout.Add<DynamicConstantBuffer::ElementType::Float>("nearPlane");
-		layout.Add<DynamicConstantBuffer::ElementType::Float>("farPlane");
+		DynamicConstantBuffer::Layout layout = cameraDataLayout.GetLayout();
 
 		DynamicConstantBuffer::Data bufferData(layout);
-		*bufferData.Get<DynamicConstantBuffer::ElementType::Float>("nearPlane") = defaultCameraSettings.NearZ;
-		*bufferData.Get<DynamicConstantBuffer::ElementType::Float>("farPlane") = defaultCameraSettings.FarZ;
+		*bufferData.Get(nearPlaneHandle) = defaultCameraSettings.NearZ;
+		*bufferData.Get(farPlaneHandle) = defaultCameraSettings.FarZ;
 
 		m_pCameraData = std::make_shared<CachedConstantBuffer>(graphics, bufferData, ResourceTargets{ {ShaderVisibilityGraphic::PixelShader, 0} }, true);
 	}
@@ -35,8 +42,8 @@ void FullscreenPlaceholderPass::Initialize(Graphics& graphics, Scene& scene)
 			const Camera::Settings* currentCameraSettings = currentCamera->GetSettings();
 
 			DynamicConstantBuffer::Data& cameraData = m_pCameraData->GetData();
-			*cameraData.Get<DynamicConstantBuffer::ElementType::Float>("nearPlane") = currentCameraSettings->NearZ;
-			*cameraData.Get<DynamicConstantBuffer::ElementType::Float>("farPlane") = currentCameraSettings->FarZ;
+			*cameraData.Get(nearPlaneHandle) = currentCameraSettings->NearZ;
+			*cameraData.Get(farPlaneHandle) = currentCameraSettings->FarZ;
 
 			m_pCameraData->Update(graphics);
 		}
@@ -70,16 +77,12 @@ void FullscreenPlaceholderPass::Update(Graphics& graphics, Pipeline& pipeline, S
 
 void FullscreenPlaceholderPass::PreDraw(Graphics& graphics, CommandList* commandList)
 {
-	GraphicsTexture* backBuffer = graphics.GetBackBuffer()->GetTexture(graphics);
-
-	commandList->SetResourceState(graphics, backBuffer, D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE);
+	// back buffer is transitioned to shader resource state by render graph
 }
 
 void FullscreenPlaceholderPass::PostDraw(Graphics& graphics, CommandList* commandList)
 {
-	GraphicsTexture* backBuffer = graphics.GetBackBuffer()->GetTexture(graphics);
 
-	commandList->SetResourceState(graphics, backBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
 }
 
 void FullscreenPlaceholderPass::UpdateCameraData(Graphics& graphics, Scene& scene)
@@ -89,8 +92,8 @@ void FullscreenPlaceholderPass::UpdateCameraData(Graphics& graphics, Scene& scen
 	const Camera::Settings* currentCameraSettings = currentCamera->GetSettings();
 
 	DynamicConstantBuffer::Data& cameraData = m_pCameraData->GetData();
-	*cameraData.Get<DynamicConstantBuffer::ElementType::Float>("nearPlane") = currentCameraSettings->NearZ;
-	*cameraData.Get<DynamicConstantBuffer::ElementType::Float>("farPlane") = currentCameraSettings->FarZ;
+	*cameraData.Get(nearPlaneHandle) = currentCameraSettings->NearZ;
+	*cameraData.Get(farPlaneHandle) = currentCameraSettings->FarZ;
 
 	m_pCameraData->Update(graphics);
 }
\ No newline at end of file
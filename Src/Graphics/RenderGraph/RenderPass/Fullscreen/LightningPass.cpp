@@ -1,28 +1,104 @@
 #include "LightningPass.h"
 
 #include "Graphics/Core/Pipeline.h"
+#include "Graphics/Core/Graphics.h"
 #include "Scene/Objects/Camera.h"
+#include "Scene/Objects/PointLight.h"
 #include "Scene/Scene.h"
+#include "Graphics/Data/StaticLayout.h"
+#include "Graphics/Profiler/RenderStats.h"
+
+static constexpr DynamicConstantBuffer::StaticLayout inverseMatricesLayout({
+	{ DynamicConstantBuffer::ElementType::Matrix, "inverseProjection" },
+	{ DynamicConstantBuffer::ElementType::Matrix, "inverseView" }
+});
+
+static constexpr auto inverseProjectionHandle = inverseMatricesLayout.GetHandle<DynamicConstantBuffer::ElementType::Matrix>("inverseProjection");
+static constexpr auto inverseViewHandle = inverseMatricesLayout.GetHandle<DynamicConstantBuffer::ElementType::Matrix>("inverseView");
+
+static constexpr DynamicConstantBuffer::StaticLayout clusterParamsLayout({
+	{ DynamicConstantBuffer::ElementType::Uint, "tilesX" },
+	{ DynamicConstantBuffer::ElementType::Uint, "tilesY" },
+	{ DynamicConstantBuffer::ElementType::Uint, "slicesZ" },
+	{ DynamicConstantBuffer::ElementType::Float, "sliceScale" },
+	{ DynamicConstantBuffer::ElementType::Float, "sliceBias" }
+});
+
+static constexpr auto tilesXHandle = clusterParamsLayout.GetHandle<DynamicConstantBuffer::ElementType::Uint>("tilesX");
+static constexpr auto tilesYHandle = clusterParamsLayout.GetHandle<DynamicConstantBuffer::ElementType::Uint>("tilesY");
+static constexpr auto slicesZHandle = clusterParamsLayout.GetHandle<DynamicConstantBuffer::ElementType::Uint>("slicesZ");
+static constexpr auto sliceScaleHandle = clusterParamsLayout.GetHandle<DynamicConstantBuffer::ElementType::Float>("sliceScale");
+static constexpr auto sliceBiasHandle = clusterParamsLayout.GetHandle<DynamicConstantBuffer::ElementType::Float>("sliceBias");
 
 LightningPass::LightningPass(Graphics& graphics)
 	:
 	FullscreenPass(graphics)
 {
-	// inverse projection matrix constant buffer
+	// inverse projection and view matrix constant buffer
 	{
-		DynamicConstantBuffer::Layout layout;
-		layout.Add<DynamicConstantBuffer::ElementType::Matrix>("inverseProjection");
-		layout.Add<DynamicConstantBuffer::ElementType::Matrix>("inverseView");
+		DynamicConstantBuffer::Layout layout = inverseMatricesLayout.GetLayout();
 
 		DynamicConstantBuffer::Data bufferData(layout);
-		*bufferData.Get<DynamicConstantBuffer::ElementType::Matrix>("inverseProjection") = {};
-		*bufferData.Get<DynamicConstantBuffer::ElementType::Matrix>("inverseView") = {};
+		*bufferData.Get(inverseProjectionHandle) = {};
+		*bufferData.Get(inverseViewHandle) = {};
 
-		std::shared_ptr<CachedConstantBuffer> inverseMatriesBuffer = std::make_shared<CachedConstantBuffer>(graphics, bufferData, ResourceTargets{{ShaderVisibilityGraphic::PixelShader, 2}}, true);
+		// view changes almost every frame, so matrices are written to temp memory of current frame
+		std::shared_ptr<TempConstantBuffer> inverseMatriesBuffer = std::make_shared<TempConstantBuffer>(graphics, bufferData, ResourceTargets{{ShaderVisibilityGraphic::PixelShader, 2}});
 
 		m_pInverseMatriesBuffer = inverseMatriesBuffer.get();
 		m_bindables.push_back(std::move(inverseMatriesBuffer));
 	}
+
+	// cluster parameters constant buffer, filled when camera perspective is known
+	{
+		DynamicConstantBuffer::Layout layout = clusterParamsLayout.GetLayout();
+
+		DynamicConstantBuffer::Data bufferData(layout);
+
+		std::shared_ptr<CachedConstantBuffer> clusterParamsBuffer = std::make_shared<CachedConstantBuffer>(graphics, bufferData, ResourceTargets{{ShaderVisibilityGraphic::PixelShader, 3}}, true);
+
+		m_pClusterParamsBuffer = clusterParamsBuffer.get();
+		m_bindables.push_back(std::move(clusterParamsBuffer));
+	}
+
+	// cluster ranges and light indices, structured buffer elements are 16 bytes so two ranges or four indices are packed in each of them
+	{
+		unsigned int numClusters = m_lightClusters.GetNumClusters();
+		unsigned int numRangeElements = (numClusters + 1) / 2;
+
+		DynamicConstantBuffer::ArrayDataInfo rangesArray = {};
+		rangesArray.numElements = numRangeElements;
+		rangesArray.layout.Add<DynamicConstantBuffer::ElementType::Uint>("firstOffset");
+		rangesArray.layout.Add<DynamicConstantBuffer::ElementType::Uint>("firstCount");
+		rangesArray.layout.Add<DynamicConstantBuffer::ElementType::Uint>("secondOffset");
+		rangesArray.layout.Add<DynamicConstantBuffer::ElementType::Uint>("secondCount");
+
+		DynamicConstantBuffer::Layout rangesLayout;
+		rangesLayout.AddArray("clusterRanges", rangesArray);
+
+		std::shared_ptr<Buffer> clusterRangesBuffer = std::make_shared<Buffer>(graphics, numRangeElements, rangesLayout, ResourceTargets{{ShaderVisibilityGraphic::PixelShader, 5}});
+
+		m_pClusterRangesBuffer = clusterRangesBuffer.get();
+		m_bindables.push_back(std::move(clusterRangesBuffer));
+
+		m_maxLightIndices = numClusters * maxLightIndicesPerCluster;
+		unsigned int numIndexElements = (m_maxLightIndices + 3) / 4;
+
+		DynamicConstantBuffer::ArrayDataInfo indicesArray = {};
+		indicesArray.numElements = numIndexElements;
+		indicesArray.layout.Add<DynamicConstantBuffer::ElementType::Uint>("index0");
+		indicesArray.layout.Add<DynamicConstantBuffer::ElementType::Uint>("index1");
+		indicesArray.layout.Add<DynamicConstantBuffer::ElementType::Uint>("index2");
+		indicesArray.layout.Add<DynamicConstantBuffer::ElementType::Uint>("index3");
+
+		DynamicConstantBuffer::Layout indicesLayout;
+		indicesLayout.AddArray("clusterLightIndices", indicesArray);
+
+		std::shared_ptr<Buffer> clusterLightIndicesBuffer = std::make_shared<Buffer>(graphics, numIndexElements, indicesLayout, ResourceTargets{{ShaderVisibilityGraphic::PixelShader, 6}});
+
+		m_pClusterLightIndicesBuffer = clusterLightIndicesBuffer.get();
+		m_bindables.push_back(std::move(clusterLightIndicesBuffer));
+	}
 }
 
 void LightningPass::Initialize(Graphics& graphics, Scene& scene)
@@ -67,30 +143,36 @@ void LightningPass::InitializeFullscreenResources(Graphics& graphics, Pipeline&
 		rt1 = static_cast<ShaderResourceViewMultiResource*>(m_bindables.at(bindablesLastIndex - 3).get());
 		rt2 = static_cast<ShaderResourceViewMultiResource*>(m_bindables.at(bindablesLastIndex - 2).get());
 		ds = static_cast<ShaderResourceViewMultiResource*>(m_bindables.at(bindablesLastIndex - 1).get());
-		shadowMap = static_cast<ShaderResourceViewMultiResource*>(m_bindables.at(bindablesLastIndex).get());
+		shadowMap = static_cast<ShaderResourceView*>(m_bindables.at(bindablesLastIndex).get());
 	}
 
 	// Updating inverse projection matrix
 	UpdateInverseProjectionMatrix(graphics, scene);
+
+	UpdateClusterProjection(graphics, scene);
+	UpdateLightClusters(graphics, scene);
 }
 
 void LightningPass::Update(Graphics& graphics, Pipeline& pipeline, Scene& scene)
 {
 	Camera* currentCamera = scene.GetCurrentCamera();
 
+	// temp memory of previous frame can't be used anymore
+	UpdateInverseProjectionMatrix(graphics, scene);
+
 	if (currentCamera->PerspectiveChanged())
-		UpdateInverseProjectionMatrix(graphics, scene);
+		UpdateClusterProjection(graphics, scene);
+
+	UpdateLightClusters(graphics, scene);
+
+	if (m_numDroppedLightIndices != 0)
+		RenderStats::Add(RenderCounter::DroppedLightIndices, m_numDroppedLightIndices);
 }
 
 void LightningPass::PreDraw(Graphics& graphics, CommandList* commandList)
 {
+	// inputs are transitioned to shader resource state by render graph
 	THROW_INTERNAL_ERROR_IF("One of inputs was null", rt0 == nullptr || rt1 == nullptr || rt2 == nullptr || ds == nullptr || shadowMap == nullptr);
-
-	commandList->SetResourceState(graphics, rt0->GetResource(graphics), D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE);
-	commandList->SetResourceState(graphics, rt1->GetResource(graphics), D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE);
-	commandList->SetResourceState(graphics, rt2->GetResource(graphics), D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE);
-	commandList->SetAllResourcesStates(graphics, ds->GetResource(graphics), D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE);
-	commandList->SetAllResourcesStates(graphics, shadowMap->GetResource(graphics), D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE);
 }
 
 void LightningPass::PostDraw(Graphics& graphics, CommandList* commandList)
@@ -107,8 +189,85 @@ void LightningPass::UpdateInverseProjectionMatrix(Graphics& graphics, Scene& sce
 	DirectX::XMMATRIX inverseView = DirectX::XMMatrixInverse(nullptr, currentCamera->GetViewMatrix());
 
 	DynamicConstantBuffer::Data& cameraData = m_pInverseMatriesBuffer->GetData();
-	*cameraData.Get<DynamicConstantBuffer::ElementType::Matrix>("inverseProjection") = inverseProjection;
-	*cameraData.Get<DynamicConstantBuffer::ElementType::Matrix>("inverseView") = inverseView;
+	*cameraData.Get(inverseProjectionHandle) = inverseProjection;
+	*cameraData.Get(inverseViewHandle) = inverseView;
 
 	m_pInverseMatriesBuffer->Update(graphics);
+}
+
+void LightningPass::UpdateClusterProjection(Graphics& graphics, Scene& scene)
+{
+	const Camera::Settings* currentCameraSettings = scene.GetCurrentCamera()->GetSettings();
+
+	m_lightClusters.SetProjection(currentCameraSettings->FovAngleY, currentCameraSettings->AspectRatio, currentCameraSettings->NearZ, currentCameraSettings->FarZ);
+
+	LightClusters::ShaderParams shaderParams = m_lightClusters.GetShaderParams();
+
+	DynamicConstantBuffer::Data& clusterParamsData = m_pClusterParamsBuffer->GetData();
+	*clusterParamsData.Get(tilesXHandle) = shaderParams.tilesX;
+	*clusterParamsData.Get(tilesYHandle) = shaderParams.tilesY;
+	*clusterParamsData.Get(slicesZHandle) = shaderParams.slicesZ;
+	*clusterParamsData.Get(sliceScaleHandle) = shaderParams.sliceScale;
+	*clusterParamsData.Get(sliceBiasHandle) = shaderParams.sliceBias;
+
+	m_pClusterParamsBuffer->Update(graphics);
+
+	// cluster bounds changed, every light has to be binned again
+	m_clusterLights.clear();
+}
+
+void LightningPass::UpdateLightClusters(Graphics& graphics, Scene& scene)
+{
+	const std::vector<PointLight*>& pointLights = scene.GetPointLights();
+
+	bool lightsChanged = m_clusterLights.size() != pointLights.size();
+	m_clusterLights.resize(pointLights.size());
+
+	for (const auto pointLight : pointLights)
+	{
+		DirectX::XMFLOAT3 position = pointLight->GetPositionInCameraSpace();
+		DirectX::XMFLOAT4 light = { position.x, position.y, position.z, pointLight->GetRange() };
+		DirectX::XMFLOAT4& binnedLight = m_clusterLights.at(pointLight->GetLightIndex());
+
+		if (std::memcmp(&light, &binnedLight, sizeof(light)) != 0)
+		{
+			binnedLight = light;
+			lightsChanged = true;
+		}
+	}
+
+	if (!lightsChanged)
+		return;
+
+	m_lightClusters.Update(graphics.GetJobSystem(), m_clusterLights);
+
+	const std::vector<unsigned int>& lightIndices = m_lightClusters.GetLightIndices();
+	const std::vector<LightClusters::ClusterRange>* clusterRanges = &m_lightClusters.GetClusterRanges();
+
+	m_numDroppedLightIndices = unsigned int(lightIndices.size() - std::min(lightIndices.size(), size_t(m_maxLightIndices)));
+
+	// clusters that didn't fit are cut, they will miss some of the lights instead of reading outside of the buffer
+	if (m_numDroppedLightIndices != 0)
+	{
+		m_clampedClusterRanges = *clusterRanges;
+
+		for (auto& range : m_clampedClusterRanges)
+		{
+			range.offset = std::min(range.offset, m_maxLightIndices);
+			range.count = std::min(range.count, m_maxLightIndices - range.offset);
+		}
+
+		clusterRanges = &m_clampedClusterRanges;
+	}
+
+	DataRange rangesDataRange = { 0, clusterRanges->size() * sizeof(LightClusters::ClusterRange) };
+	m_pClusterRangesBuffer->Update(graphics, clusterRanges->data(), std::span<const DataRange>(&rangesDataRange, 1));
+
+	size_t numLightIndices = std::min(lightIndices.size(), size_t(m_maxLightIndices));
+
+	if (numLightIndices == 0)
+		return;
+
+	DataRange indicesDataRange = { 0, numLightIndices * sizeof(unsigned int) };
+	m_pClusterLightIndicesBuffer->Update(graphics, lightIndices.data(), std::span<const DataRange>(&indicesDataRange, 1));
 }
\ No newline at end of file
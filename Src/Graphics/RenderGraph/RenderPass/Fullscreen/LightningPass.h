@@ -1,5 +1,6 @@
 #pragma once
 #include "FullscreenPass.h"
+#include "Graphics/RenderGraph/LightClusters.h"
 
 class LightningPass : public FullscreenPass
 {
@@ -19,11 +20,30 @@ public:
 private:
 	void UpdateInverseProjectionMatrix(Graphics& graphics, Scene& scene);
 
+	void UpdateClusterProjection(Graphics& graphics, Scene& scene);
+
+	// bins lights into clusters and uploads their lists when any light or camera moved
+	void UpdateLightClusters(Graphics& graphics, Scene& scene);
+
+private:
+	// light index buffer has fixed size, lights that don't fit are dropped from the last clusters and counted as DroppedLightIndices
+	static constexpr unsigned int maxLightIndicesPerCluster = 32;
+
 private:
-	CachedConstantBuffer* m_pInverseMatriesBuffer = nullptr;
+	TempConstantBuffer* m_pInverseMatriesBuffer = nullptr;
 	ShaderResourceViewMultiResource* rt0 = nullptr;
 	ShaderResourceViewMultiResource* rt1 = nullptr;
 	ShaderResourceViewMultiResource* rt2 = nullptr;
 	ShaderResourceViewMultiResource* ds = nullptr;
-	ShaderResourceViewMultiResource* shadowMap = nullptr;
+	ShaderResourceView* shadowMap = nullptr;
+
+	LightClusters m_lightClusters;
+	std::vector<DirectX::XMFLOAT4> m_clusterLights; // view space positions and ranges of lights binned last time
+	std::vector<LightClusters::ClusterRange> m_clampedClusterRanges;
+	unsigned int m_maxLightIndices = 0;
+	unsigned int m_numDroppedLightIndices = 0; // of last binning, reported every frame until lights change
+
+	Buffer* m_pClusterRangesBuffer = nullptr;
+	Buffer* m_pClusterLightIndicesBuffer = nullptr;
+	CachedConstantBuffer* m_pClusterParamsBuffer = nullptr;
 };
\ No newline at end of file
@@ -6,35 +6,48 @@
 #include "Graphics/Core/Pipeline.h"
 #include "Scene/Objects/Camera.h"
 #include "Scene/Scene.h"
+#include "Graphics/Data/StaticLayout.h"
+
+static constexpr DynamicConstantBuffer::StaticLayout inverseMatricesLayout({
+	{ DynamicConstantBuffer::ElementType::Matrix, "inverseProjection" },
+	{ DynamicConstantBuffer::ElementType::Matrix, "inverseView" }
+});
+
+static constexpr auto inverseProjectionHandle = inverseMatricesLayout.GetHandle<DynamicConstantBuffer::ElementType::Matrix>("inverseProjection");
+static constexpr auto inverseViewHandle = inverseMatricesLayout.GetHandle<DynamicConstantBuffer::ElementType::Matrix>("inverseView");
+
+static constexpr DynamicConstantBuffer::StaticLayout skyboxConstantsLayout({
+	{ DynamicConstantBuffer::ElementType::Int, "skyboxTextureIndex" }
+});
+
+static constexpr auto skyboxTextureIndexHandle = skyboxConstantsLayout.GetHandle<DynamicConstantBuffer::ElementType::Int>("skyboxTextureIndex");
 
 SkyboxPass::SkyboxPass(Graphics& graphics)
 	:
 	FullscreenPass(graphics)
 {
-	// inverse projection matrix constant buffer
+	// inverse projection and view matrix constant buffer
 	{
-		DynamicConstantBuffer::Layout layout;
-		layout.Add<DynamicConstantBuffer::ElementType::Matrix>("inverseProjection");
-		layout.Add<DynamicConstantBuffer::ElementType::Matrix>("inverseView");
+		DynamicConstantBuffer::Layout layout = inverseMatricesLayout.GetLayout();
 
 		DynamicConstantBuffer::Data bufferData(layout);
-		*bufferData.Get<DynamicConstantBuffer::ElementType::Matrix>("inverseProjection") = {};
-		*bufferData.Get<DynamicConstantBuffer::ElementType::Matrix>("inverseView") = {};
+		*bufferData.Get(inverseProjectionHandle) = {};
+		*bufferData.Get(inverseViewHandle) = {};
 
-		std::shared_ptr<CachedConstantBuffer> inverseMatriesBuffer = std::make_shared<CachedConstantBuffer>(graphics, bufferData, ResourceTargets{ {ShaderVisibilityGraphic::PixelShader, 1} }, true);
+		// view changes almost every frame, so matrices are written to temp memory of current frame
+		std::shared_ptr<TempConstantBuffer> inverseMatriesBuffer = std::make_shared<TempConstantBuffer>(graphics, bufferData, ResourceTargets{ {ShaderVisibilityGraphic::PixelShader, 1} });
 
 		m_pInverseMatriesBuffer = inverseMatriesBuffer.get();
 		m_bindables.push_back(std::move(inverseMatriesBuffer));
 	}
 
 	{
-		DynamicConstantBuffer::Layout layout;
-		layout.Add<DynamicConstantBuffer::ElementType::Int>("skyboxTextureIndex");
+		DynamicConstantBuffer::Layout layout = skyboxConstantsLayout.GetLayout();
 
 		layout.GetFinished(DynamicConstantBuffer::Layout::LayoutType::data);
 
 		DynamicConstantBuffer::Data bufferData(layout);
-		*bufferData.Get<DynamicConstantBuffer::ElementType::Int>("skyboxTextureIndex") = 0;
+		*bufferData.Get(skyboxTextureIndexHandle) = 0;
 
 		std::shared_ptr<RootSignatureConstants> skyboxTextureIndexConstants = std::make_shared<RootSignatureConstants>(bufferData, ResourceTargets{ {ShaderVisibilityGraphic::PixelShader, 0} });
 
@@ -72,16 +85,14 @@ void SkyboxPass::Initialize(Graphics& graphics, Scene& scene)
 
 void SkyboxPass::InitializeFullscreenResources(Graphics& graphics, Pipeline& pipeline, Scene& scene)
 {
-	*m_pSkyboxTextureIndexConstants->GetData().Get<DynamicConstantBuffer::ElementType::Int>("skyboxTextureIndex") = m_skyboxTexture->GetOffsetInDescriptor();
+	*m_pSkyboxTextureIndexConstants->GetData().Get(skyboxTextureIndexHandle) = m_skyboxTexture->GetOffsetInDescriptor();
 	m_pSkyboxTextureIndexConstants->SetUpdated(true);
 }
 
 void SkyboxPass::Update(Graphics& graphics, Pipeline& pipeline, Scene& scene)
 {
-	Camera* currentCamera = scene.GetCurrentCamera();
-
-	if (currentCamera->PerspectiveChanged())
-		UpdateInverseProjectionMatrix(graphics, scene);
+	// temp memory of previous frame can't be used anymore
+	UpdateInverseProjectionMatrix(graphics, scene);
 }
 
 void SkyboxPass::UpdateInverseProjectionMatrix(Graphics& graphics, Scene& scene)
@@ -93,8 +104,8 @@ void SkyboxPass::UpdateInverseProjectionMatrix(Graphics& graphics, Scene& scene)
 	DirectX::XMMATRIX inverseView = DirectX::XMMatrixInverse(nullptr, currentCamera->GetViewMatrix());
 
 	DynamicConstantBuffer::Data& cameraData = m_pInverseMatriesBuffer->GetData();
-	*cameraData.Get<DynamicConstantBuffer::ElementType::Matrix>("inverseProjection") = inverseProjection;
-	*cameraData.Get<DynamicConstantBuffer::ElementType::Matrix>("inverseView") = inverseView;
+	*cameraData.Get(inverseProjectionHandle) = inverseProjection;
+	*cameraData.Get(inverseViewHandle) = inverseView;
 
 	m_pInverseMatriesBuffer->Update(graphics);
 }
\ No newline at end of file
@@ -2,7 +2,7 @@
 #include "FullscreenPass.h"
 #include "Graphics/Bindables/Texture.h"
 
-class CachedConstantBuffer;
+class TempConstantBuffer;
 
 class SkyboxPass : public FullscreenPass
 {
@@ -22,5 +22,5 @@ private:
 private:
 	std::shared_ptr<Texture> m_skyboxTexture;
 	RootSignatureConstants* m_pSkyboxTextureIndexConstants = nullptr;
-	CachedConstantBuffer* m_pInverseMatriesBuffer = nullptr;
+	TempConstantBuffer* m_pInverseMatriesBuffer = nullptr;
 };
\ No newline at end of file
@@ -4,27 +4,40 @@
 #include "Scene/Objects/Camera.h"
 
 #include "Graphics/Bindables/RootSignatureConstants.h"
+#include "Graphics/Bindables/InstanceBuffer.h"
+#include "Graphics/Data/StaticLayout.h"
 
 #include "Graphics/RenderGraph/RenderJob/RenderGraphicsGeometryJob.h"
+#include "Graphics/RenderGraph/Steps/RenderGraphicsGeometryStep.h"
 
 #include "Graphics/Core/Graphics.h"
+#include "Graphics/Core/Pix.h"
+
+static constexpr DynamicConstantBuffer::StaticLayout cameraConstantsLayout({
+	{ DynamicConstantBuffer::ElementType::Int, "cameraTransformIndex" }
+});
+
+static constexpr auto cameraTransformIndexHandle = cameraConstantsLayout.GetHandle<DynamicConstantBuffer::ElementType::Int>("cameraTransformIndex");
 
 GeometryPass::GeometryPass()
 {
 	AddStaticBindable("cameraBuffer");
 	AddStaticBindable("transformBuffer");
 	
-	DynamicConstantBuffer::Layout layout;
-	layout.Add<DynamicConstantBuffer::ElementType::Int>("cameraTransformIndex");
+	DynamicConstantBuffer::Layout layout = cameraConstantsLayout.GetLayout();
 
 	layout.GetFinished(DynamicConstantBuffer::Layout::LayoutType::data);
 
 	DynamicConstantBuffer::Data bufferData(layout);
-	*bufferData.Get<DynamicConstantBuffer::ElementType::Int>("cameraTransformIndex") = 0;
+	*bufferData.Get(cameraTransformIndexHandle) = 0;
 
 	m_cameraRootConstant = std::make_shared<RootSignatureConstants>(bufferData, ResourceTargets{{ShaderVisibilityGraphic::VertexShader, 2}});
 
 	AddBindable(m_cameraRootConstant);
+
+	m_instanceBuffer = std::make_shared<InstanceBuffer>();
+
+	AddBindable(m_instanceBuffer);
 }
 
 void GeometryPass::Initialize(Graphics& graphics, Scene& scene)
@@ -40,7 +53,33 @@ void GeometryPass::Update(Graphics& graphics, Pipeline& pipeline, Scene& scene)
 
 	SetCameraTransformIndex(currentCameraIndex);
 
-	m_bindableContainer.Update();
+	// jobs invalidated while rebuilding are queued again for next frame
+	std::vector<RenderGraphicsGeometryJob*> invalidatedJobs;
+	std::swap(invalidatedJobs, m_invalidatedJobs);
+
+	for (RenderGraphicsGeometryJob* job : invalidatedJobs)
+		job->Update(graphics);
+
+	// rebuilt draw packets can belong to other instance groups
+	if (!invalidatedJobs.empty())
+		m_jobsSorted = false;
+}
+
+bool GeometryPass::HasWork() const
+{
+	for (const RenderTargetData& renderTarget : GetRenderTargets())
+		if (renderTarget.loadOperation == ResourceDataOperation::clear)
+			return true;
+
+	if (GetDepthStencilView().loadOperation == ResourceDataOperation::clear)
+		return true;
+
+	return m_numEnabledJobs != 0;
+}
+
+bool GeometryPass::UpdatesWhenCulled() const
+{
+	return false;
 }
 
 void GeometryPass::AddBindable(std::shared_ptr<Bindable> bindable)
@@ -60,14 +99,42 @@ const BindableContainer& GeometryPass::GetBindableContainer() const
 
 void GeometryPass::SortJobs()
 {
-	std::sort(
+	START_CPU_EVENT(PIX_COLOR(0, 127, 127), "Job sort");
+
+	std::stable_sort(
 		m_jobs.begin(), m_jobs.end(),
 		[](const std::unique_ptr<RenderGraphicsGeometryJob>& a, const std::unique_ptr<RenderGraphicsGeometryJob>& b)
 		{
-			// currently sorting by pointers, our only goal for now is just grouping the same-material render jobs together
-			return a->GetStep()->GetMaterial() < b->GetStep()->GetMaterial();
+			// draw packets are ordered by pipeline state first, materials then end up grouped by their root params
+			return DrawPacket::IsOrderedBefore(a->GetDrawPacket(), b->GetDrawPacket());
 		}
 	);
+
+	m_jobInstanceGroups.resize(m_jobs.size());
+
+	unsigned int instanceGroup = 0;
+
+	for (size_t jobIndex = 0; jobIndex < m_jobs.size(); jobIndex++)
+	{
+		if (jobIndex > 0 && !m_jobs[jobIndex]->GetDrawPacket().IsInstanceOf(m_jobs[jobIndex - 1]->GetDrawPacket()))
+			instanceGroup++;
+
+		m_jobInstanceGroups[jobIndex] = instanceGroup;
+	}
+
+	END_CPU_EVENT();
+
+	m_jobsSorted = true;
+}
+
+void GeometryPass::SetInstancingEnabled(bool enabled)
+{
+	s_instancingEnabled = enabled;
+}
+
+bool GeometryPass::IsInstancingEnabled()
+{
+	return s_instancingEnabled;
 }
 
 RenderJob::JobType GeometryPass::GetWantedJob() const
@@ -80,6 +147,14 @@ void GeometryPass::AssignRenderData(GraphicsRenderData renderData)
 	THROW_INTERNAL_ERROR_IF("Tried to push non-geometry render job to GeometryPass", RenderJob::GetJobGroup(renderData.type) != RenderJob::JobGroup::Geometry);
 
 	m_jobs.push_back(std::make_unique<RenderGraphicsGeometryJob>(renderData, this));
+
+	RenderGraphicsGeometryStep* step = m_jobs.back()->GetStep();
+	step->RegisterListener(this);
+
+	if (step->IsEnabled())
+		m_numEnabledJobs++;
+
+	m_jobsSorted = false;
 }
 
 void GeometryPass::GatherJobBindables()
@@ -92,6 +167,21 @@ void GeometryPass::InitializeJobs(Graphics& graphics, Pipeline& pipeline)
 {
 	for (auto& job : m_jobs)
 		job->Initialize(graphics, pipeline);
+
+	m_jobsSorted = false;
+}
+
+void GeometryPass::StepEnabledChanged(bool enabled)
+{
+	if (enabled)
+		m_numEnabledJobs++;
+	else
+		m_numEnabledJobs--;
+}
+
+void GeometryPass::AddInvalidatedJob(RenderGraphicsGeometryJob* job)
+{
+	m_invalidatedJobs.push_back(job);
 }
 
 RenderPassRasterizerStateOptions GeometryPass::GetRasterizerOptions() const
@@ -109,7 +199,7 @@ void GeometryPass::SetCameraTransformIndex(unsigned int cameraIndex)
 	if (m_currentCameraIndex == cameraIndex)
 		return;
 
-	*m_cameraRootConstant->GetData().Get<DynamicConstantBuffer::ElementType::Int>("cameraTransformIndex") = cameraIndex;
+	*m_cameraRootConstant->GetData().Get(cameraTransformIndexHandle) = cameraIndex;
 	m_cameraRootConstant->SetUpdated(true);
 
 	m_currentCameraIndex = cameraIndex;
@@ -119,9 +209,46 @@ void GeometryPass::ExecutePass(Graphics& graphics, CommandList* commandList, Sce
 {
 	commandList->BeginRenderPass(graphics, this);
 
-	for (auto& job : m_jobs)
-		if(job->IsValid(this, scene))
-			job->Execute(graphics, commandList);
+	START_CPU_EVENT(PIX_COLOR(0, 127, 127), "Batching");
+	BatchVisibleJobs(scene);
+	END_CPU_EVENT();
+
+	if (!m_instanceSceneIndices.empty())
+		m_instanceBuffer->Update(graphics, m_instanceSceneIndices);
+
+	for (const InstanceBatch& batch : m_batches)
+	{
+		m_instanceBuffer->SetFirstInstance(batch.firstInstance);
+
+		batch.job->ExecuteInstanced(graphics, commandList, batch.instances);
+	}
 
 	commandList->EndRenderPass(graphics);
+}
+
+void GeometryPass::BatchVisibleJobs(Scene& scene)
+{
+	if (!m_jobsSorted)
+		SortJobs();
+
+	m_batches.clear();
+	m_instanceSceneIndices.clear();
+
+	for (size_t jobIndex = 0; jobIndex < m_jobs.size(); jobIndex++)
+	{
+		RenderGraphicsGeometryJob* job = m_jobs[jobIndex].get();
+
+		if (!job->IsValid(this, scene))
+			continue;
+
+		unsigned int instanceGroup = m_jobInstanceGroups[jobIndex];
+
+		// culled jobs of the group can be between visible ones, they are just skipped
+		if (s_instancingEnabled && !m_batches.empty() && m_batches.back().instanceGroup == instanceGroup)
+			m_batches.back().instances++;
+		else
+			m_batches.push_back({ job, instanceGroup, unsigned int(m_instanceSceneIndices.size()), 1 });
+
+		m_instanceSceneIndices.push_back(job->GetStep()->GetSceneObject()->GetSceneIndex());
+	}
 }
\ No newline at end of file
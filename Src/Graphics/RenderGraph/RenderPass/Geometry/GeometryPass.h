@@ -2,6 +2,7 @@
 #include "Graphics/RenderGraph/RenderPass/RenderPass.h"
 #include "Graphics/RenderGraph/RenderJob/GraphicsRenderData.h"
 #include "Graphics/RenderGraph/RenderJob/RenderGraphicsGeometryJob.h"
+#include "Graphics/RenderGraph/Steps/RenderStep.h"
 #include "Graphics/Bindables/RasterizerState.h"
 #include "Graphics/Core/BindableContainer.h"
 
@@ -9,8 +10,11 @@ class RenderJob;
 class Material;
 
 class RootSignatureConstants;
+class InstanceBuffer;
 
-class GeometryPass : public RenderPass
+// visible jobs whose draw packets are the same are drawn as instances of one draw. Vertex shader reads
+// scene index of every instance from instance buffer, which is moved to first instance of every batch
+class GeometryPass : public RenderPass, public RenderStepListener
 {
 public:
 	GeometryPass();
@@ -19,15 +23,25 @@ public:
 
 	virtual void Update(Graphics& graphics, Pipeline& pipeline, Scene& scene) override;
 
+	// pass has work when it clears its targets or has any enabled job
+	virtual bool HasWork() const override;
+
+	// invalidated jobs stay queued, so skipped updates are caught up after pass is executed again
+	virtual bool UpdatesWhenCulled() const override;
+
 public: // Handling for pass specific bindables
 	void AddBindable(std::shared_ptr<Bindable> bindable);
 	void AddStaticBindable(const char* staticBindableName);
 	const BindableContainer& GetBindableContainer() const;
 
 public: // job handling
-	// sort jobs so executing them on GPU is more effecient
+	// sort jobs so executing them on GPU is more effecient and jobs that can be instanced are next to each other
 	void SortJobs();
 
+	// when disabled, every visible job is drawn with its own draw, used to compare both paths
+	static void SetInstancingEnabled(bool enabled);
+	static bool IsInstancingEnabled();
+
 public:  // enlisting and pushing jobs
 	// every renderPass that will inherit will return its own wanted jobs, like "Albedo"
 	virtual RenderJob::JobType GetWantedJob() const;
@@ -38,6 +52,12 @@ public:  // enlisting and pushing jobs
 	void GatherJobBindables();
 	void InitializeJobs(Graphics& graphics, Pipeline& pipeline);
 
+	// job is rebuilt in next Update(), jobs add themselves once when their bindables change
+	void AddInvalidatedJob(RenderGraphicsGeometryJob* job);
+
+	// pass is registered to step of every its job, so it's called once per job
+	virtual void StepEnabledChanged(bool enabled) override;
+
 	RenderPassRasterizerStateOptions GetRasterizerOptions() const;
 
 	unsigned int GetActiveCameraIndex() const;
@@ -48,16 +68,41 @@ protected:
 protected:
 	virtual void ExecutePass(Graphics& graphics, CommandList* commandList, Scene& scene) override;
 
+private:
+	// groups visible jobs into batches and gathers scene indices of their instances
+	void BatchVisibleJobs(Scene& scene);
+
 protected:
 	std::shared_ptr<RootSignatureConstants> m_cameraRootConstant;
+	std::shared_ptr<InstanceBuffer> m_instanceBuffer;
 
 	BindableContainer m_bindableContainer;
 
 	std::vector<std::unique_ptr<RenderGraphicsGeometryJob>> m_jobs;
+	std::vector<RenderGraphicsGeometryJob*> m_invalidatedJobs;
+	unsigned int m_numEnabledJobs = 0;
+
+	// jobs are sorted again when their draw packets changed, jobs with the same instance group share draw packet
+	bool m_jobsSorted = false;
+	std::vector<unsigned int> m_jobInstanceGroups; // indexed the same as jobs
+
+	struct InstanceBatch
+	{
+		RenderGraphicsGeometryJob* job;
+		unsigned int instanceGroup;
+		unsigned int firstInstance;
+		unsigned int instances;
+	};
+
+	std::vector<InstanceBatch> m_batches;
+	std::vector<unsigned int> m_instanceSceneIndices;
 
 	unsigned int m_currentCameraIndex = UINT_MAX;
 
 	Material* currentlyBoundMaterial = nullptr;
 
 	RenderPassRasterizerStateOptions m_rasterizerOptions = {};
+
+private:
+	static inline bool s_instancingEnabled = true;
 };
\ No newline at end of file
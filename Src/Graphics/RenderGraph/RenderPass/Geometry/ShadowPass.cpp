@@ -5,14 +5,18 @@
 #include "Graphics/Core/Graphics.h"
 
 #include "Scene/Scene.h"
+#include "Scene/SceneObject.h"
+#include "Graphics/RenderGraph/Steps/RenderGraphicsGeometryStep.h"
 
 #include "Graphics/Core/Pix.h"
 
-ShadowPass::ShadowPass(Graphics& graphics)
+ShadowPass::ShadowPass(Graphics& graphics, ShadowAtlas::Budget budget)
 {
+	// there is no pass viewport, every face sets viewport of its own tile in atlas
 	AddBindable(DepthStencilState::GetResource(graphics, DepthStencilStateOptions{}));
-	AddBindable(ViewPort::GetResource(graphics, DirectX::XMFLOAT2(graphics.GetWidth(), graphics.GetWidth())));
 	m_rasterizerOptions.SetIsShadowRasterizer(true);
+
+	m_shadowAtlas.SetBudget(budget);
 }
 
 void ShadowPass::Initialize(Graphics& graphics, Scene& scene)
@@ -23,9 +27,21 @@ void ShadowPass::Initialize(Graphics& graphics, Scene& scene)
 
 	auto depthStencil = GetDepthStencilView();
 
-	THROW_INTERNAL_ERROR_IF("Passed depth stencil to ShadowPass was of invalid type", depthStencil.resource == nullptr || depthStencil.resource->GetDepthStencilType() != DepthStencilType::cubeMultiResource);
+	THROW_INTERNAL_ERROR_IF("Passed depth stencil to ShadowPass was of invalid type", depthStencil.resource == nullptr || depthStencil.resource->GetDepthStencilType() != DepthStencilType::singleResource);
+	THROW_INTERNAL_ERROR_IF("ShadowPass would clear whole shadow atlas", depthStencil.loadOperation == ResourceDataOperation::clear);
+
+	m_atlasDepthStencil = static_cast<DepthStencilView*>(depthStencil.resource.get());
+
+	Pipeline& pipeline = graphics.GetRenderer().GetPipeline();
+
+	m_pLightBuffer = static_cast<CachedConstantBuffer*>(pipeline.GetStaticResource("lightBuffer").get());
+
+	const DynamicConstantBuffer::Layout& lightBufferLayout = m_pLightBuffer->GetData().GetLayout();
+
+	for (unsigned int face = 0; face < ShadowAtlas::numFaces; face++)
+		m_shadowFaceHandles.at(face) = lightBufferLayout.GetArrayHandle<DynamicConstantBuffer::ElementType::Float4>("lightBuffers", PointLight::shadowFaceNames[face]);
 
-	m_depthStencilViewCube = static_cast<DepthStencilViewCubeMultiResource*>(depthStencil.resource.get());
+	ResizeLights(unsigned int(scene.GetPointLights().size()));
 }
 
 void ShadowPass::Update(Graphics& graphics, Pipeline& pipeline, Scene& scene)
@@ -40,38 +56,248 @@ RenderJob::JobType ShadowPass::GetWantedJob() const
 
 void ShadowPass::ExecutePass(Graphics& graphics, CommandList* commandList, Scene& scene)
 {
-	PointLight* pointLight = m_scene->GetPointLights().front();
-	ShadowCamera* shadowCamera = pointLight->GetShadowCamera();
+	const std::vector<PointLight*>& pointLights = m_scene->GetPointLights();
+
+	if (pointLights.empty())
+		return;
+
+	Camera* camera = scene.GetCurrentCamera();
+
+	if (m_lightInputs.size() != pointLights.size())
+		ResizeLights(unsigned int(pointLights.size()));
+
+	CalibrateDrawCost();
+
+	// new casters invalidate every face
+	bool shadowCastersChanged = UpdateShadowCasters();
 
-	bool needsUpdating = shadowCamera->ViewChanged() || shadowCamera->PerspectiveChanged();
-	static unsigned int framesLeftToUpdate = graphics.GetBufferCount();
+	UpdateOutdatedFaces(scene, shadowCastersChanged);
 
-	if (needsUpdating)
-		framesLeftToUpdate = graphics.GetBufferCount();
-	
-	if (framesLeftToUpdate == 0)
+	for (unsigned int light = 0; light < pointLights.size(); light++)
+	{
+		PointLight* pointLight = pointLights.at(light);
+		ShadowCamera* shadowCamera = pointLight->GetShadowCamera();
+		ShadowAtlas::LightInput& lightInput = m_lightInputs.at(light);
+
+		lightInput.screenCoverage = GetScreenCoverage(camera, pointLight);
+
+		for (unsigned int face = 0; face < ShadowAtlas::numFaces; face++)
+		{
+			if (shadowCastersChanged || scene.VisibilityChanged(shadowCamera->GetCameraIndex() + face))
+				m_faceDraws.at(light * ShadowAtlas::numFaces + face) = UINT_MAX;
+
+			lightInput.outdatedFaces.at(face) = m_outdatedFaces.at(light * ShadowAtlas::numFaces + face);
+		}
+	}
+
+	const std::vector<ShadowAtlas::FaceUpdate>& faceUpdates = m_shadowAtlas.Update(m_lightInputs,
+		[&](unsigned int light, unsigned int face)
+		{
+			return GetFaceCost(scene, light, face);
+		}
+	);
+
+	UpdateChangedLights(graphics);
+
+	if (faceUpdates.empty())
 		return;
 
-	framesLeftToUpdate--;
+	// only tiles that are rendered again are cleared, the rest of atlas keeps depth from previous frames
+	m_clearRects.clear();
+
+	for (const ShadowAtlas::FaceUpdate& faceUpdate : faceUpdates)
+		m_clearRects.push_back(m_faceViewPorts.at(faceUpdate.light * ShadowAtlas::numFaces + faceUpdate.face)->GetViewportRect());
+
+	graphics.GetProfiler().BeginGPUZone(graphics, commandList, facesZoneName);
+
+	commandList->ClearDepthStencilView(graphics, m_atlasDepthStencil, m_clearRects);
+
+	m_numFrameDraws = 0;
 
-	for(int i = 0; i < 6; i++)
+	for (const ShadowAtlas::FaceUpdate& faceUpdate : faceUpdates)
 	{
-		BEGIN_COMMAND_LIST_EVENT(commandList, std::to_string(i));
-		START_CPU_EVENT(PIX_COLOR(255, 0, 0), std::to_string(i).c_str());
+		unsigned int faceDraws = m_faceDraws.at(faceUpdate.light * ShadowAtlas::numFaces + faceUpdate.face);
 
-		SetActiveShadowCamera(pointLight, i);
+		if (faceDraws != UINT_MAX)
+			m_numFrameDraws += faceDraws;
+
+		const char* eventName = faceEventNames[faceUpdate.face];
+
+		BEGIN_COMMAND_LIST_EVENT(commandList, eventName);
+		START_CPU_EVENT(PIX_COLOR(255, 0, 0), eventName);
+		graphics.GetProfiler().BeginGPUZone(graphics, commandList, eventName);
+
+		SetActiveFace(graphics, commandList, faceUpdate.light, faceUpdate.face);
 		GeometryPass::ExecutePass(graphics, commandList, scene);
 
+		graphics.GetProfiler().EndGPUZone(graphics, commandList);
 		END_CPU_EVENT();
 		END_COMMAND_LIST_EVENT(commandList);
 	}
+
+	graphics.GetProfiler().EndGPUZone(graphics, commandList);
+
+	static constexpr float averageWeight = 0.05f;
+	m_averageDraws += (float(m_numFrameDraws) - m_averageDraws) * averageWeight;
+}
+
+void ShadowPass::SetActiveFace(Graphics& graphics, CommandList* commandList, unsigned int light, unsigned int face)
+{
+	ShadowCamera* shadowCamera = m_scene->GetPointLights().at(light)->GetShadowCamera();
+
+	SetCameraTransformIndex(shadowCamera->GetCameraIndex() + face);
+
+	commandList->SetViewPort(graphics, m_faceViewPorts.at(light * ShadowAtlas::numFaces + face).get());
+}
+
+void ShadowPass::UpdateOutdatedFaces(Scene& scene, bool shadowCastersChanged)
+{
+	const std::vector<PointLight*>& pointLights = m_scene->GetPointLights();
+
+	m_outdatedFaces.assign(pointLights.size() * ShadowAtlas::numFaces, shadowCastersChanged);
+
+	if (shadowCastersChanged)
+		return;
+
+	// most of changed transforms don't cast shadows, so they are filtered once instead of for every face
+	m_changedCasters.clear();
+
+	for (unsigned int sceneIndex : scene.GetChangedTransforms())
+		if (sceneIndex < m_shadowCasters.size() && m_shadowCasters.at(sceneIndex))
+			m_changedCasters.push_back(sceneIndex);
+
+	for (unsigned int light = 0; light < pointLights.size(); light++)
+	{
+		ShadowCamera* shadowCamera = pointLights.at(light)->GetShadowCamera();
+		bool lightChanged = shadowCamera->ViewChanged() || shadowCamera->PerspectiveChanged();
+
+		for (unsigned int face = 0; face < ShadowAtlas::numFaces; face++)
+		{
+			unsigned int faceCameraIndex = shadowCamera->GetCameraIndex() + face;
+
+			// covers casters that just left the face too
+			bool outdated = lightChanged || scene.VisibilityChanged(faceCameraIndex);
+
+			for (size_t caster = 0; caster < m_changedCasters.size() && !outdated; caster++)
+				outdated = scene.IsVisible(faceCameraIndex, m_changedCasters.at(caster));
+
+			m_outdatedFaces.at(light * ShadowAtlas::numFaces + face) = outdated;
+		}
+	}
+}
+
+float ShadowPass::GetFaceCost(Scene& scene, unsigned int light, unsigned int face)
+{
+	unsigned int& faceDraws = m_faceDraws.at(light * ShadowAtlas::numFaces + face);
+
+	if (faceDraws == UINT_MAX)
+	{
+		unsigned int faceCameraIndex = m_scene->GetPointLights().at(light)->GetShadowCamera()->GetCameraIndex() + face;
+
+		faceDraws = 0;
+
+		for (unsigned int sceneIndex = 0; sceneIndex < m_shadowCasters.size(); sceneIndex++)
+			if (m_shadowCasters.at(sceneIndex) && scene.IsVisible(faceCameraIndex, sceneIndex))
+				faceDraws++;
+	}
+
+	// empty face still costs its clear and viewport change
+	return float(std::max(faceDraws, 1u)) * m_msPerDraw;
+}
+
+void ShadowPass::CalibrateDrawCost()
+{
+	static constexpr float minMsPerDraw = 0.00001f;
+
+	// GPU times arrive few frames later, so they are compared with draws averaged over the same frames
+	std::optional<ZoneProfiler::ZoneStats> facesStats = ZoneProfiler::Get().GetZoneStats("GPU", facesZoneName);
+
+	if (!facesStats || m_averageDraws < 1.0f)
+		return;
+
+	m_msPerDraw = std::max(facesStats->avgMs / m_averageDraws, minMsPerDraw);
 }
 
-void ShadowPass::SetActiveShadowCamera(PointLight* pointLight, unsigned int stage)
+void ShadowPass::ResizeLights(unsigned int numLights)
 {
-	ShadowCamera* shadowCamera = pointLight->GetShadowCamera();
+	m_lightInputs.resize(numLights);
+	m_faceViewPorts.resize(numLights * ShadowAtlas::numFaces);
+	m_faceDraws.assign(numLights * ShadowAtlas::numFaces, UINT_MAX);
+}
+
+float ShadowPass::GetScreenCoverage(Camera* camera, PointLight* pointLight)
+{
+	// objects can be parented, so local positions don't have to be in the same space
+	DirectX::XMFLOAT3 cameraPosition = camera->GetTransform()->GetWorldPosition();
+	DirectX::XMFLOAT3 lightPosition = pointLight->GetTransform()->GetWorldPosition();
+
+	float distance = DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&lightPosition), DirectX::XMLoadFloat3(&cameraPosition))));
+	float range = pointLight->GetRange();
+
+	if (distance <= range)
+		return 1.0f;
+
+	// projected radius of sphere lit by the light, relative to half of the screen height
+	return std::min(range / (distance * std::tan(camera->GetSettings()->FovAngleY / 2.0f)), 1.0f);
+}
+
+void ShadowPass::UpdateChangedLights(Graphics& graphics)
+{
+	const std::vector<PointLight*>& pointLights = m_scene->GetPointLights();
+	DynamicConstantBuffer::Data& lightBufferData = m_pLightBuffer->GetData();
+
+	const float atlasSizeInverse = 1.0f / float(m_shadowAtlas.GetAtlasSize());
+
+	for (unsigned int light : m_shadowAtlas.GetChangedLights())
+	{
+		unsigned int lightIndex = pointLights.at(light)->GetLightIndex();
+		bool lightReady = m_shadowAtlas.IsLightReady(light);
+
+		for (unsigned int face = 0; face < ShadowAtlas::numFaces; face++)
+		{
+			const ShadowAtlas::Tile& tile = m_shadowAtlas.GetFaceTile(light, face);
+
+			if (tile.IsValid())
+			{
+				DirectX::XMFLOAT2 tileSize = { float(tile.size), float(tile.size) };
+				DirectX::XMFLOAT2 tileOffset = { float(tile.x), float(tile.y) };
+
+				m_faceViewPorts.at(light * ShadowAtlas::numFaces + face) = std::make_unique<ViewPort>(graphics, tileSize, tileOffset);
+			}
+
+			// faces of light that isn't ready can hold depth of other lights, so the light isn't shadowed until all of them are rendered
+			DirectX::XMFLOAT4 faceRect = {};
+
+			if (lightReady)
+				faceRect = { tile.x * atlasSizeInverse, tile.y * atlasSizeInverse, tile.size * atlasSizeInverse, tile.size * atlasSizeInverse };
+
+			*lightBufferData.Get(m_shadowFaceHandles.at(face), lightIndex) = faceRect;
+		}
+	}
+
+	// light buffer was already uploaded this frame, lightning pass has to see the new rects
+	if (m_pLightBuffer->IsDirty())
+		m_pLightBuffer->Update(graphics);
+}
+
+bool ShadowPass::UpdateShadowCasters()
+{
+	if (m_numShadowCasterJobs == m_jobs.size())
+		return false;
+
+	m_shadowCasters.clear();
+
+	for (const auto& job : m_jobs)
+	{
+		unsigned int sceneIndex = job->GetStep()->GetSceneObject()->GetSceneIndex();
+
+		if (sceneIndex >= m_shadowCasters.size())
+			m_shadowCasters.resize(sceneIndex + 1, false);
+
+		m_shadowCasters.at(sceneIndex) = true;
+	}
 
-	SetCameraTransformIndex(shadowCamera->GetCameraIndex() + stage);
+	m_numShadowCasterJobs = m_jobs.size();
 
-	m_depthStencilViewCube->SetCurrentDepthBuffer(stage);
+	return true;
 }
\ No newline at end of file
@@ -1,12 +1,30 @@
 #pragma once
 #include "GeometryPass.h"
+#include "Graphics/RenderGraph/ShadowAtlas.h"
+#include "Graphics/Data/DynamicConstantBuffer.h"
+#include "Graphics/Bindables/ViewPort.h"
 
 class PointLight;
+class ShadowCamera;
+class Camera;
+class CachedConstantBuffer;
 
+// renders cube faces of every point light into tiles of one shadow atlas
 class ShadowPass : public GeometryPass
 {
 public:
-	ShadowPass(Graphics& graphics);
+	static constexpr unsigned int atlasSize = 4096;
+	static constexpr unsigned int minTileSize = 128;
+	static constexpr unsigned int maxTileSize = 1024;
+
+	// GPU zone around rendering of all faces, its time calibrates cost of one draw
+	static constexpr const char* facesZoneName = "Shadow faces";
+
+	// faces of all lights share labels, so events aren't formatted every frame and their zones are averaged together
+	static constexpr const char* faceEventNames[ShadowAtlas::numFaces] = { "Shadow face 0", "Shadow face 1", "Shadow face 2", "Shadow face 3", "Shadow face 4", "Shadow face 5" };
+
+public:
+	ShadowPass(Graphics& graphics, ShadowAtlas::Budget budget = {});
 
 	virtual void Initialize(Graphics& graphics, Scene& scene) override;
 
@@ -17,9 +35,48 @@ public:
 	virtual void ExecutePass(Graphics& graphics, CommandList* commandList, Scene& scene) override;
 
 private:
-	void SetActiveShadowCamera(PointLight* pointLight, unsigned int stage);
+	void SetActiveFace(Graphics& graphics, CommandList* commandList, unsigned int light, unsigned int face);
+
+	// lights can be added after initialization, per light state follows their count
+	void ResizeLights(unsigned int numLights);
+
+	// face is rendered again only when shadow caster inside it changed or something entered or left it
+	void UpdateOutdatedFaces(Scene& scene, bool shadowCastersChanged);
+
+	// estimated GPU time of face, draws visible from face are counted only after its visibility changed
+	float GetFaceCost(Scene& scene, unsigned int light, unsigned int face);
+
+	// moves estimated time of one draw towards measured GPU time of rendered faces
+	void CalibrateDrawCost();
+
+	// part of screen height that light's range covers, decides size of its tiles
+	static float GetScreenCoverage(Camera* camera, PointLight* pointLight);
+
+	// moves viewports and rects in light buffer of lights that got new tiles or finished rendering them
+	void UpdateChangedLights(Graphics& graphics);
+
+	// returns true when set of shadow casters changed
+	bool UpdateShadowCasters();
 
 private:
 	Scene* m_scene = nullptr;
-	class DepthStencilViewCubeMultiResource* m_depthStencilViewCube = nullptr;
+	DepthStencilView* m_atlasDepthStencil = nullptr;
+
+	ShadowAtlas m_shadowAtlas = ShadowAtlas(atlasSize, minTileSize, maxTileSize);
+	std::vector<ShadowAtlas::LightInput> m_lightInputs;
+	std::vector<std::unique_ptr<ViewPort>> m_faceViewPorts; // indexed by light * 6 + face
+	std::vector<unsigned int> m_faceDraws; // indexed by light * 6 + face, UINT_MAX when it has to be counted again
+	std::vector<bool> m_outdatedFaces; // indexed by light * 6 + face, filled once per frame
+	std::vector<unsigned int> m_changedCasters; // scene indices of shadow casters that moved this frame
+	std::vector<D3D12_RECT> m_clearRects;
+
+	CachedConstantBuffer* m_pLightBuffer = nullptr;
+	std::array<DynamicConstantBuffer::ArrayElementHandle<DynamicConstantBuffer::ElementType::Float4>, ShadowAtlas::numFaces> m_shadowFaceHandles = {};
+
+	std::vector<bool> m_shadowCasters; // indexed by scene index
+	size_t m_numShadowCasterJobs = 0;
+
+	float m_msPerDraw = 0.0005f;
+	float m_averageDraws = 0.0f; // draws of frames in which faces were rendered
+	unsigned int m_numFrameDraws = 0;
 };
\ No newline at end of file
@@ -1,8 +1,11 @@
 #include "RenderPass.h"
 #include "Graphics/Core/CommandList.h"
+#include "Graphics/Core/Graphics.h"
 #include "Graphics/RenderGraph/RenderJob/RenderJob.h"
 
 #include "Graphics/Core/Pix.h"
+#include "Graphics/Profiler/RenderStats.h"
+#include "Graphics/Profiler/CommandStream.h"
 
 void RenderPass::Initialize(Graphics& graphics, Scene& scene)
 {
@@ -34,32 +37,49 @@ void RenderPass::SetDepthStencilView(std::shared_ptr<DepthStencilViewBase> depth
 	m_depthStencil = { depthStencil, loadop, storeop };
 }
 
-const std::vector<RenderPass::RenderTargetData>& RenderPass::GetRenderTargets() const
+void RenderPass::SetEnabled(bool enabled)
 {
-	return m_renderTargets;
+	m_enabled = enabled;
 }
 
-RenderPass::DepthStencilData RenderPass::GetDepthStencilView() const
+bool RenderPass::IsEnabled() const
 {
-	return m_depthStencil;
+	return m_enabled;
+}
+
+bool RenderPass::HasWork() const
+{
+	return true;
+}
+
+bool RenderPass::UpdatesWhenCulled() const
+{
+	return true;
 }
 
-void RenderPass::SetCorrectStates(Graphics& graphics, CommandList* commandList)
+const std::vector<RenderPass::RenderTargetData>& RenderPass::GetRenderTargets() const
 {
-	for (auto& renderTarget : m_renderTargets)
-		commandList->SetResourceState(graphics, renderTarget.resource.get(), D3D12_RESOURCE_STATE_RENDER_TARGET);
+	return m_renderTargets;
+}
 
-	if (m_depthStencil.resource)
-		commandList->SetAllResourcesStates(graphics, m_depthStencil.resource->GetResource(graphics), D3D12_RESOURCE_STATE_DEPTH_WRITE);
+RenderPass::DepthStencilData RenderPass::GetDepthStencilView() const
+{
+	return m_depthStencil;
 }
 
 void RenderPass::Execute(Graphics& graphics, CommandList* commandList, Scene& scene)
 {
 	START_CPU_EVENT(PIX_COLOR(0, 255, 0), typeid(*this).name() + 6);
 	BEGIN_COMMAND_LIST_EVENT(commandList, typeid(*this).name() + 6); // + 6 skips "class " from type info literal
+	graphics.GetProfiler().BeginGPUZone(graphics, commandList, typeid(*this).name() + 6);
+	RenderStats::Get().BeginPass(typeid(*this).name() + 6);
+	CAPTURE_COMMAND(StreamCommand::BeginPass, CommandStream::GetNameIndex(typeid(*this).name() + 6));
 
 	ExecutePass(graphics, commandList, scene);
 
+	CAPTURE_COMMAND(StreamCommand::EndPass);
+	RenderStats::Get().EndPass();
+	graphics.GetProfiler().EndGPUZone(graphics, commandList);
 	END_COMMAND_LIST_EVENT(commandList);
 	END_CPU_EVENT();
 }
\ No newline at end of file
@@ -43,11 +43,20 @@ public:
 
 	virtual void SubmitJobs(RenderManager& renderManager);
 
-	void SetCorrectStates(Graphics& graphics, CommandList* commandList);
-
 	// record jobs on command list
 	void Execute(Graphics& graphics, CommandList* commandList, Scene& scene);
 
+public: // culling
+	// RenderGraph skips disabled passes and passes which outputs aren't used by any executed pass
+	void SetEnabled(bool enabled);
+	bool IsEnabled() const;
+
+	// pass without any work is skipped the same way as disabled one
+	virtual bool HasWork() const;
+
+	// culled passes keep getting Update when they react to per frame events, like camera changes
+	virtual bool UpdatesWhenCulled() const;
+
 public: // RenderTargets and DepthStecilViews
 	void AddRenderTarget(std::shared_ptr<RenderTarget> renderTarget, ResourceDataOperation loadop = ResourceDataOperation::keep, ResourceDataOperation storeop = ResourceDataOperation::keep);
 	void SetDepthStencilView(std::shared_ptr<DepthStencilViewBase> depthStencil, ResourceDataOperation loadop = ResourceDataOperation::keep, ResourceDataOperation storeop = ResourceDataOperation::keep);
@@ -61,4 +70,6 @@ protected:
 private:
 	std::vector<RenderTargetData> m_renderTargets;
 	DepthStencilData m_depthStencil;
+
+	bool m_enabled = true;
 };
@@ -0,0 +1,404 @@
+#include "ShadowAtlas.h"
+#include "Macros/ErrorMacros.h"
+
+// light keeps its bigger tiles until coverage drops this much below the size they were picked for, so they aren't reallocated every frame
+static constexpr float shrinkHysteresis = 1.25f;
+
+// added to coverage so faces of lights outside of the screen still get updated
+static constexpr float minFacePriority = 0.01f;
+
+bool ShadowAtlas::Tile::IsValid() const
+{
+	return size != 0;
+}
+
+ShadowAtlas::ShadowAtlas(unsigned int atlasSize, unsigned int minTileSize, unsigned int maxTileSize)
+	:
+	m_atlasSize(atlasSize),
+	m_minTileSize(minTileSize),
+	m_maxTileSize(maxTileSize)
+{
+	auto isPowerOfTwo = [](unsigned int value)
+		{
+			return value != 0 && (value & (value - 1)) == 0;
+		};
+
+	THROW_INTERNAL_ERROR_IF("Shadow atlas sizes have to be powers of two", !isPowerOfTwo(atlasSize) || !isPowerOfTwo(minTileSize) || !isPowerOfTwo(maxTileSize));
+	THROW_INTERNAL_ERROR_IF("Shadow atlas tile sizes were out of order", minTileSize > maxTileSize || maxTileSize > atlasSize);
+
+	m_freeTiles.resize(GetLevel(minTileSize) + 1);
+	m_freeTiles.front().push_back({ 0, 0, atlasSize });
+}
+
+const std::vector<ShadowAtlas::FaceUpdate>& ShadowAtlas::Update(const std::vector<LightInput>& lights, const FaceCostCallback& getFaceCost)
+{
+	m_frame++;
+	m_changedLights.clear();
+
+	// removed lights give back their tiles
+	for (unsigned int light = static_cast<unsigned int>(lights.size()); light < m_lights.size(); light++)
+		FreeLight(light);
+
+	m_lights.resize(lights.size());
+
+	AssignTiles(lights);
+	ScheduleFaces(lights, getFaceCost);
+
+	return m_faceUpdates;
+}
+
+void ShadowAtlas::SetBudget(Budget budget)
+{
+	m_budget = budget;
+}
+
+const ShadowAtlas::Tile& ShadowAtlas::GetFaceTile(unsigned int light, unsigned int face) const
+{
+	THROW_INTERNAL_ERROR_IF("Tried to access invalid face of shadow atlas light", light >= m_lights.size() || face >= numFaces);
+
+	return m_lights.at(light).tiles.at(face);
+}
+
+bool ShadowAtlas::IsLightReady(unsigned int light) const
+{
+	return light < m_lights.size() && m_lights.at(light).ready;
+}
+
+const std::vector<unsigned int>& ShadowAtlas::GetChangedLights() const
+{
+	return m_changedLights;
+}
+
+unsigned int ShadowAtlas::GetAtlasSize() const
+{
+	return m_atlasSize;
+}
+
+unsigned int ShadowAtlas::GetTileSize(float screenCoverage) const
+{
+	float wantedSize = screenCoverage * float(m_maxTileSize);
+	unsigned int tileSize = m_minTileSize;
+
+	while (float(tileSize) < wantedSize && tileSize < m_maxTileSize)
+		tileSize *= 2;
+
+	return tileSize;
+}
+
+bool ShadowAtlas::AllocateLight(unsigned int light, unsigned int tileSize)
+{
+	LightState& lightState = m_lights.at(light);
+
+	for (unsigned int face = 0; face < numFaces; face++)
+	{
+		std::optional<Tile> tile = AllocateTile(tileSize);
+
+		if (!tile)
+		{
+			FreeLight(light);
+			return false;
+		}
+
+		lightState.tiles.at(face) = *tile;
+	}
+
+	// new tiles can hold depth of any other light
+	lightState.pending.fill(true);
+	lightState.ready = false;
+
+	return true;
+}
+
+void ShadowAtlas::FreeLight(unsigned int light)
+{
+	LightState& lightState = m_lights.at(light);
+
+	for (Tile& tile : lightState.tiles)
+	{
+		if (tile.IsValid())
+			FreeTile(tile);
+
+		tile = {};
+	}
+
+	lightState.pending.fill(false);
+	lightState.ready = false;
+}
+
+std::optional<ShadowAtlas::Tile> ShadowAtlas::AllocateTile(unsigned int size)
+{
+	unsigned int level = GetLevel(size);
+
+	// looking for the smallest free tile that can be split into wanted size
+	unsigned int sourceLevel = level;
+
+	while (m_freeTiles.at(sourceLevel).empty())
+	{
+		if (sourceLevel == 0)
+			return std::nullopt;
+
+		sourceLevel--;
+	}
+
+	Tile tile = m_freeTiles.at(sourceLevel).back();
+	m_freeTiles.at(sourceLevel).pop_back();
+
+	// top left quarter is split further, the rest becomes free
+	for (; sourceLevel < level; sourceLevel++)
+	{
+		unsigned int childSize = tile.size / 2;
+
+		m_freeTiles.at(sourceLevel + 1).push_back({ tile.x + childSize, tile.y + childSize, childSize });
+		m_freeTiles.at(sourceLevel + 1).push_back({ tile.x, tile.y + childSize, childSize });
+		m_freeTiles.at(sourceLevel + 1).push_back({ tile.x + childSize, tile.y, childSize });
+
+		tile.size = childSize;
+	}
+
+	return tile;
+}
+
+void ShadowAtlas::FreeTile(Tile tile)
+{
+	unsigned int level = GetLevel(tile.size);
+
+	// merging with siblings as long as all of them are free
+	while (level > 0)
+	{
+		std::vector<Tile>& freeTiles = m_freeTiles.at(level);
+
+		unsigned int parentSize = tile.size * 2;
+		unsigned int parentX = tile.x - tile.x % parentSize;
+		unsigned int parentY = tile.y - tile.y % parentSize;
+
+		std::array<size_t, 3> siblingIndices = {};
+		unsigned int numFreeSiblings = 0;
+
+		for (size_t i = 0; i < freeTiles.size() && numFreeSiblings < 3; i++)
+		{
+			const Tile& freeTile = freeTiles.at(i);
+
+			bool isSibling = freeTile.x - freeTile.x % parentSize == parentX && freeTile.y - freeTile.y % parentSize == parentY;
+
+			if (isSibling)
+				siblingIndices.at(numFreeSiblings++) = i;
+		}
+
+		if (numFreeSiblings < 3)
+			break;
+
+		// removing from the back so indices stay valid
+		for (int i = 2; i >= 0; i--)
+		{
+			freeTiles.at(siblingIndices.at(i)) = freeTiles.back();
+			freeTiles.pop_back();
+		}
+
+		tile = { parentX, parentY, parentSize };
+		level--;
+	}
+
+	m_freeTiles.at(level).push_back(tile);
+}
+
+unsigned int ShadowAtlas::GetLevel(unsigned int size) const
+{
+	unsigned int level = 0;
+
+	for (unsigned int levelSize = m_atlasSize; levelSize > size; levelSize /= 2)
+		level++;
+
+	return level;
+}
+
+void ShadowAtlas::AssignTiles(const std::vector<LightInput>& lights)
+{
+	unsigned int numLights = static_cast<unsigned int>(lights.size());
+
+	// lights covering bigger part of the screen get their tiles first
+	std::vector<unsigned int> lightOrder(numLights);
+
+	for (unsigned int light = 0; light < numLights; light++)
+		lightOrder.at(light) = light;
+
+	std::stable_sort(lightOrder.begin(), lightOrder.end(),
+		[&lights](unsigned int a, unsigned int b)
+		{
+			return lights.at(a).screenCoverage > lights.at(b).screenCoverage;
+		}
+	);
+
+	std::vector<unsigned int> wantedSizes(numLights);
+	size_t wantedArea = 0;
+
+	for (unsigned int light = 0; light < numLights; light++)
+	{
+		float screenCoverage = lights.at(light).screenCoverage;
+		unsigned int currentSize = m_lights.at(light).tiles.front().size;
+		unsigned int wantedSize = GetTileSize(screenCoverage);
+
+		if (wantedSize < currentSize && GetTileSize(screenCoverage * shrinkHysteresis) >= currentSize)
+			wantedSize = currentSize;
+
+		wantedSizes.at(light) = wantedSize;
+		wantedArea += size_t(numFaces) * wantedSize * wantedSize;
+	}
+
+	// when everything can't fit, the biggest tiles of the least important lights are halved first
+	const size_t atlasArea = size_t(m_atlasSize) * m_atlasSize;
+
+	for (unsigned int tileSize = m_maxTileSize; tileSize > m_minTileSize && wantedArea > atlasArea; tileSize /= 2)
+	{
+		for (unsigned int position = numLights; position-- > 0 && wantedArea > atlasArea;)
+		{
+			unsigned int& wantedSize = wantedSizes.at(lightOrder.at(position));
+
+			if (wantedSize != tileSize)
+				continue;
+
+			wantedSize = tileSize / 2;
+			wantedArea -= size_t(numFaces) * (tileSize * tileSize - wantedSize * wantedSize);
+		}
+	}
+
+	// lights that want different size give back their tiles first, so freed space can be merged for others
+	for (unsigned int light = 0; light < numLights; light++)
+	{
+		unsigned int currentSize = m_lights.at(light).tiles.front().size;
+
+		if (currentSize != 0 && currentSize != wantedSizes.at(light))
+		{
+			FreeLight(light);
+			MarkChanged(light);
+		}
+	}
+
+	auto allocateLight = [&](unsigned int light)
+		{
+			// smaller tiles are better than no shadows at all
+			for (unsigned int tileSize = wantedSizes.at(light); tileSize >= m_minTileSize; tileSize /= 2)
+				if (AllocateLight(light, tileSize))
+					return true;
+
+			return false;
+		};
+
+	for (unsigned int position = 0; position < numLights; position++)
+	{
+		unsigned int light = lightOrder.at(position);
+
+		if (m_lights.at(light).tiles.front().IsValid())
+			continue;
+
+		bool allocated = allocateLight(light);
+
+		// taking tiles of the least important lights, they try again when their turn comes
+		for (unsigned int victimPosition = numLights - 1; !allocated && victimPosition > position; victimPosition--)
+		{
+			unsigned int victim = lightOrder.at(victimPosition);
+
+			if (!m_lights.at(victim).tiles.front().IsValid())
+				continue;
+
+			FreeLight(victim);
+			MarkChanged(victim);
+
+			allocated = allocateLight(light);
+		}
+
+		if (allocated)
+			MarkChanged(light);
+	}
+}
+
+void ShadowAtlas::ScheduleFaces(const std::vector<LightInput>& lights, const FaceCostCallback& getFaceCost)
+{
+	struct Candidate
+	{
+		FaceUpdate faceUpdate;
+		bool lightReady;
+		float priority;
+	};
+
+	std::vector<Candidate> candidates;
+
+	for (unsigned int light = 0; light < m_lights.size(); light++)
+	{
+		LightState& lightState = m_lights.at(light);
+
+		if (!lightState.tiles.front().IsValid())
+			continue;
+
+		for (unsigned int face = 0; face < numFaces; face++)
+		{
+			if (lights.at(light).outdatedFaces.at(face))
+				lightState.pending.at(face) = true;
+
+			if (!lightState.pending.at(face))
+				continue;
+
+			// waiting faces gain priority every frame, so lights far away aren't starved
+			float framesWaiting = float(m_frame - lightState.lastUpdateFrame.at(face));
+			float priority = (lights.at(light).screenCoverage + minFacePriority) * framesWaiting;
+
+			candidates.push_back({ { light, face }, lightState.ready, priority });
+		}
+	}
+
+	// lights without complete cube can't be sampled at all, so finishing them goes first
+	std::sort(candidates.begin(), candidates.end(),
+		[](const Candidate& a, const Candidate& b)
+		{
+			if (a.lightReady != b.lightReady)
+				return !a.lightReady;
+
+			return a.priority > b.priority;
+		}
+	);
+
+	m_faceUpdates.clear();
+	float frameMilliseconds = 0.0f;
+
+	for (const Candidate& candidate : candidates)
+	{
+		if (m_faceUpdates.size() >= m_budget.maxFaces)
+			break;
+
+		unsigned int light = candidate.faceUpdate.light;
+		unsigned int face = candidate.faceUpdate.face;
+		float faceCost = getFaceCost(light, face);
+
+		// at least one face is rendered every frame, so face above the budget can't block others forever
+		if (!m_faceUpdates.empty() && frameMilliseconds + faceCost > m_budget.maxMilliseconds)
+			continue;
+
+		frameMilliseconds += faceCost;
+		m_faceUpdates.push_back(candidate.faceUpdate);
+
+		LightState& lightState = m_lights.at(light);
+		lightState.pending.at(face) = false;
+		lightState.lastUpdateFrame.at(face) = m_frame;
+	}
+
+	for (unsigned int light = 0; light < m_lights.size(); light++)
+	{
+		LightState& lightState = m_lights.at(light);
+
+		if (lightState.ready || !lightState.tiles.front().IsValid())
+			continue;
+
+		bool allFacesRendered = std::none_of(lightState.pending.begin(), lightState.pending.end(), [](bool pending) { return pending; });
+
+		if (allFacesRendered)
+		{
+			lightState.ready = true;
+			MarkChanged(light);
+		}
+	}
+}
+
+void ShadowAtlas::MarkChanged(unsigned int light)
+{
+	if (std::find(m_changedLights.begin(), m_changedLights.end(), light) == m_changedLights.end())
+		m_changedLights.push_back(light);
+}
\ No newline at end of file
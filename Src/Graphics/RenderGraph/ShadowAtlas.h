@@ -0,0 +1,101 @@
+#pragma once
+#include "Includes/CppIncludes.h"
+
+// packs cube faces of point lights into one square depth texture and picks faces that get rendered this frame.
+// Tiles are power of two squares taken from quadtree, their size follows part of the screen light can affect.
+// Faces that don't fit in the frame budget keep depth rendered in previous frames.
+// It doesn't touch any graphics objects, ShadowPass maps tiles to viewports
+class ShadowAtlas
+{
+public:
+	static constexpr unsigned int numFaces = 6;
+
+	struct Tile
+	{
+		unsigned int x = 0;
+		unsigned int y = 0;
+		unsigned int size = 0; // 0 when face has no place in atlas
+
+		bool IsValid() const;
+	};
+
+	struct Budget
+	{
+		unsigned int maxFaces = 12;
+		float maxMilliseconds = 2.0f; // estimated GPU time of all faces rendered in one frame
+	};
+
+	// state of light gathered every frame
+	struct LightInput
+	{
+		float screenCoverage = 0.0f; // part of screen height covered by light's range, 1 when camera is inside of it
+		std::array<bool, numFaces> outdatedFaces = {}; // something inside face changed since it was rendered
+	};
+
+	struct FaceUpdate
+	{
+		unsigned int light = 0;
+		unsigned int face = 0;
+	};
+
+	// estimated milliseconds of GPU time needed to render face, asked only for faces that are considered this frame
+	using FaceCostCallback = std::function<float(unsigned int light, unsigned int face)>;
+
+public:
+	ShadowAtlas(unsigned int atlasSize, unsigned int minTileSize, unsigned int maxTileSize);
+
+public:
+	// assigns tiles to lights and returns faces which have to be rendered into them this frame
+	const std::vector<FaceUpdate>& Update(const std::vector<LightInput>& lights, const FaceCostCallback& getFaceCost);
+
+	void SetBudget(Budget budget);
+
+	const Tile& GetFaceTile(unsigned int light, unsigned int face) const;
+
+	// light can be sampled only when all of its faces were rendered into their current tiles
+	bool IsLightReady(unsigned int light) const;
+
+	// lights which tiles or readiness changed during last update
+	const std::vector<unsigned int>& GetChangedLights() const;
+
+	unsigned int GetAtlasSize() const;
+
+	// tile size for part of the screen light covers, rounded up to power of two
+	unsigned int GetTileSize(float screenCoverage) const;
+
+private:
+	bool AllocateLight(unsigned int light, unsigned int tileSize);
+	void FreeLight(unsigned int light);
+
+	std::optional<Tile> AllocateTile(unsigned int size);
+	void FreeTile(Tile tile);
+
+	unsigned int GetLevel(unsigned int size) const;
+
+	void AssignTiles(const std::vector<LightInput>& lights);
+
+	void ScheduleFaces(const std::vector<LightInput>& lights, const FaceCostCallback& getFaceCost);
+
+	void MarkChanged(unsigned int light);
+
+private:
+	struct LightState
+	{
+		std::array<Tile, numFaces> tiles;
+		std::array<bool, numFaces> pending = {}; // face has to be rendered, its tile is new or content is outdated
+		std::array<unsigned int, numFaces> lastUpdateFrame = {};
+		bool ready = false;
+	};
+
+	unsigned int m_atlasSize;
+	unsigned int m_minTileSize;
+	unsigned int m_maxTileSize;
+	Budget m_budget = {};
+
+	std::vector<std::vector<Tile>> m_freeTiles; // indexed by quadtree level, level 0 is the whole atlas
+
+	std::vector<LightState> m_lights;
+	std::vector<unsigned int> m_changedLights;
+	std::vector<FaceUpdate> m_faceUpdates;
+	unsigned int m_frame = 0;
+};
\ No newline at end of file
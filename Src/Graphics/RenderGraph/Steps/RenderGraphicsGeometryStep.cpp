@@ -43,6 +43,16 @@ const BoundingBox& RenderGraphicsGeometryStep::GetBoundingBox() const
 	return m_boundingBox;
 }
 
+void RenderGraphicsGeometryStep::SetOccluderMesh(std::shared_ptr<const OccluderMesh> occluderMesh)
+{
+	m_occluderMesh = std::move(occluderMesh);
+}
+
+const OccluderMesh* RenderGraphicsGeometryStep::GetOccluderMesh() const
+{
+	return m_occluderMesh.get();
+}
+
 SceneObject* RenderGraphicsGeometryStep::GetSceneObject() const
 {
 	return m_sceneObject;
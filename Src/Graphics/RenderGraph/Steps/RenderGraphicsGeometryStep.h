@@ -6,6 +6,7 @@
 #include "Graphics/Core/PipelineState.h"
 #include "Graphics/Core/RootSignature.h"
 #include "Graphics/Core/OcclusionPrimitives.h"
+#include "Graphics/Core/OcclusionCuller.h"
 #include "Graphics/Bindables/RasterizerState.h"
 #include "Graphics/Bindables/MaterialBindings.h"
 
@@ -28,6 +29,11 @@ public: // bindable container functions
 
 	const BoundingBox& GetBoundingBox() const;
 
+	// CPU copy of geometry for occlusion culling, null when step is not used as occluder
+	void SetOccluderMesh(std::shared_ptr<const OccluderMesh> occluderMesh);
+
+	const OccluderMesh* GetOccluderMesh() const;
+
 	SceneObject* GetSceneObject() const;
 
 	void SetMaterial(std::shared_ptr<Material> material);
@@ -51,5 +57,6 @@ private:
 	std::shared_ptr<MaterialBindings> m_materialBindings;
 
 	BoundingBox m_boundingBox = {};
+	std::shared_ptr<const OccluderMesh> m_occluderMesh;
 	SceneObject* m_sceneObject;
 };
\ No newline at end of file
@@ -52,9 +52,4 @@ const MeshBindableContainer& RenderGraphicsStep::GetBindableContainer() const
 void RenderGraphicsStep::Initialize(Graphics& graphics, Pipeline& pipeline)
 {
 	m_bindableContainer.Initialize(graphics, pipeline);
-}
-
-void RenderGraphicsStep::Update()
-{
-	m_bindableContainer.Update();
 }
\ No newline at end of file
@@ -26,8 +26,6 @@ public:
 
 	virtual void Initialize(Graphics& graphics, Pipeline& pipeline) override;
 
-	virtual void Update() override;
-
 protected:
 	MeshBindableContainer m_bindableContainer;
 };
\ No newline at end of file
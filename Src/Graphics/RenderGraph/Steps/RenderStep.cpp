@@ -26,7 +26,18 @@ bool RenderStep::IsEnabled() const
 
 void RenderStep::SetEnabled(bool enabled)
 {
+	if (m_enabled == enabled)
+		return;
+
 	m_enabled = enabled;
+
+	for (RenderStepListener* listener : m_listeners)
+		listener->StepEnabledChanged(enabled);
+}
+
+void RenderStep::RegisterListener(RenderStepListener* listener)
+{
+	m_listeners.push_back(listener);
 }
 
 void RenderStep::Initialize(Graphics& graphics, Pipeline& pipeline)
@@ -5,6 +5,14 @@ class Graphics;
 class Pipeline;
 class CommandList;
 
+class RenderStepListener
+{
+public:
+	virtual ~RenderStepListener() = default;
+
+	virtual void StepEnabledChanged(bool enabled) = 0;
+};
+
 class RenderStep
 {
 protected:
@@ -15,8 +23,13 @@ public:
 	const std::string& GetName() const;
 
 	bool IsEnabled() const;
+
+	// listeners are notified only when state actually changes
 	void SetEnabled(bool enabled);
 
+	// listener is notified once per registration, steps are destroyed with scene before listening passes
+	void RegisterListener(RenderStepListener* listener);
+
 	virtual void Initialize(Graphics& graphics, Pipeline& pipeline);
 	virtual void Update();
 
@@ -28,4 +41,6 @@ private:
 	std::string m_name;
 	bool m_enabled = true;
 	bool m_submittedJob = false;
+
+	std::vector<RenderStepListener*> m_listeners;
 };
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include "DescriptorAllocator.h"
+#include "Macros/ErrorMacros.h"
+
+DescriptorAllocator::DescriptorAllocator(unsigned int capacity)
+	:
+	m_capacity(capacity)
+{
+
+}
+
+std::optional<unsigned int> DescriptorAllocator::Allocate(unsigned int count)
+{
+	THROW_INTERNAL_ERROR_IF("Tried to allocate empty descriptor range", count == 0);
+
+	// first fit over freed ranges keeps the used part of heap compact
+	for (auto it = m_freeRanges.begin(); it != m_freeRanges.end(); it++)
+	{
+		if (it->count < count)
+			continue;
+
+		unsigned int first = it->first;
+
+		it->first += count;
+		it->count -= count;
+
+		if (it->count == 0)
+			m_freeRanges.erase(it);
+
+		m_numFreeInRanges -= count;
+
+		return first;
+	}
+
+	if (m_usedExtent + count > m_capacity)
+		return std::nullopt;
+
+	unsigned int first = m_usedExtent;
+	m_usedExtent += count;
+
+	return first;
+}
+
+void DescriptorAllocator::Free(unsigned int first, unsigned int count, size_t frameNumber)
+{
+	THROW_INTERNAL_ERROR_IF("Tried to free empty descriptor range", count == 0);
+	THROW_INTERNAL_ERROR_IF("Tried to free descriptor range that was never allocated", first + count > m_usedExtent);
+
+	m_pendingRanges.push_back({ { first, count }, frameNumber });
+	m_numPending += count;
+}
+
+void DescriptorAllocator::Retire(size_t lastCompletedFrameNumber)
+{
+	auto retiredRangesStart = std::stable_partition(m_pendingRanges.begin(), m_pendingRanges.end(), [lastCompletedFrameNumber](const PendingRange& pendingRange)
+		{
+			return pendingRange.frameNumber > lastCompletedFrameNumber;
+		});
+
+	for (auto it = retiredRangesStart; it != m_pendingRanges.end(); it++)
+	{
+		m_numPending -= it->range.count;
+		AddFreeRange(it->range);
+	}
+
+	m_pendingRanges.erase(retiredRangesStart, m_pendingRanges.end());
+}
+
+void DescriptorAllocator::Grow(unsigned int capacity)
+{
+	THROW_INTERNAL_ERROR_IF("DescriptorAllocator can't shrink", capacity < m_capacity);
+
+	m_capacity = capacity;
+}
+
+unsigned int DescriptorAllocator::GetCapacity() const
+{
+	return m_capacity;
+}
+
+unsigned int DescriptorAllocator::GetUsedExtent() const
+{
+	return m_usedExtent;
+}
+
+unsigned int DescriptorAllocator::GetNumFree() const
+{
+	return m_capacity - m_usedExtent + m_numFreeInRanges;
+}
+
+unsigned int DescriptorAllocator::GetNumPending() const
+{
+	return m_numPending;
+}
+
+void DescriptorAllocator::AddFreeRange(Range range)
+{
+	auto next = std::lower_bound(m_freeRanges.begin(), m_freeRanges.end(), range.first, [](const Range& freeRange, unsigned int first)
+		{
+			return freeRange.first < first;
+		});
+
+	THROW_INTERNAL_ERROR_IF("Descriptor range was freed twice", next != m_freeRanges.end() && range.first + range.count > next->first);
+	THROW_INTERNAL_ERROR_IF("Descriptor range was freed twice", next != m_freeRanges.begin() && std::prev(next)->first + std::prev(next)->count > range.first);
+
+	m_numFreeInRanges += range.count;
+
+	if (next != m_freeRanges.end() && range.first + range.count == next->first)
+	{
+		range.count += next->count;
+		next = m_freeRanges.erase(next);
+	}
+
+	if (next != m_freeRanges.begin() && std::prev(next)->first + std::prev(next)->count == range.first)
+	{
+		next = std::prev(next);
+		range.first = next->first;
+		range.count += next->count;
+		next = m_freeRanges.erase(next);
+	}
+
+	// range touching the end of used part goes back to bump allocation
+	if (range.first + range.count == m_usedExtent)
+	{
+		m_usedExtent = range.first;
+		m_numFreeInRanges -= range.count;
+		return;
+	}
+
+	m_freeRanges.insert(next, range);
+}
\ No newline at end of file
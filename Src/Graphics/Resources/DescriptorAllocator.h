@@ -0,0 +1,54 @@
+#pragma once
+#include "Includes/CppIncludes.h"
+
+// hands out contiguous ranges of descriptor indices, so descriptor tables can point at them.
+// Freed ranges are held back until the frame that freed them is retired, so GPU never reads descriptor that was already overwritten.
+// Class only manages indices, so it doesn't depend on any graphics resource
+class DescriptorAllocator
+{
+	struct Range
+	{
+		unsigned int first;
+		unsigned int count;
+	};
+
+	struct PendingRange
+	{
+		Range range;
+		size_t frameNumber;
+	};
+
+public:
+	DescriptorAllocator(unsigned int capacity = 0);
+
+public:
+	// returns index of first descriptor in the range or std::nullopt if there is no free range big enough
+	std::optional<unsigned int> Allocate(unsigned int count = 1);
+
+	// range can be handed out again once given frame number gets retired
+	void Free(unsigned int first, unsigned int count, size_t frameNumber);
+
+	// returns ranges freed in frames with frame number lower or equal to given one back to allocator
+	void Retire(size_t lastCompletedFrameNumber);
+
+	// indices that were already handed out stay valid
+	void Grow(unsigned int capacity);
+
+public:
+	unsigned int GetCapacity() const;
+	unsigned int GetUsedExtent() const; // one past the highest index that can be in use
+	unsigned int GetNumFree() const; // descriptors that can be allocated right now
+	unsigned int GetNumPending() const; // descriptors waiting for their frame to be retired
+
+private:
+	void AddFreeRange(Range range);
+
+private:
+	std::vector<Range> m_freeRanges; // sorted by first index, touching ranges are merged
+	std::vector<PendingRange> m_pendingRanges;
+
+	unsigned int m_capacity = 0;
+	unsigned int m_usedExtent = 0;
+	unsigned int m_numFreeInRanges = 0;
+	unsigned int m_numPending = 0;
+};
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include "FrameRingAllocator.h"
+#include "Macros/ErrorMacros.h"
+
+FrameRingAllocator::FrameRingAllocator(size_t capacity)
+	:
+	m_capacity(capacity)
+{
+
+}
+
+std::optional<size_t> FrameRingAllocator::Allocate(size_t size, size_t alignment)
+{
+	THROW_INTERNAL_ERROR_IF("Alignment has to be power of 2", alignment == 0 || (alignment & (alignment - 1)) != 0);
+
+	size_t offset = (m_head + alignment - 1) & ~(alignment - 1);
+
+	// allocation can't be split, so if it doesn't fit at the end of ring we skip to its beginning
+	if (offset + size > m_capacity)
+		offset = 0;
+
+	size_t padding = offset >= m_head ? offset - m_head : m_capacity - m_head;
+
+	// free space is continuous region from head to oldest alive allocation
+	if (m_usedSize + padding + size > m_capacity)
+		return std::nullopt;
+
+	m_head = offset + size;
+	m_usedSize += padding + size;
+	m_currentFrameSize += padding + size;
+
+	return offset;
+}
+
+void FrameRingAllocator::FinishFrame(size_t frameNumber)
+{
+	THROW_INTERNAL_ERROR_IF("Frame numbers have to increase", !m_frames.empty() && m_frames.back().frameNumber >= frameNumber);
+
+	if (m_currentFrameSize == 0)
+		return;
+
+	m_frames.push_back({ frameNumber, m_currentFrameSize });
+	m_currentFrameSize = 0;
+}
+
+void FrameRingAllocator::Retire(size_t lastCompletedFrameNumber)
+{
+	unsigned int numRetiredFrames = 0;
+
+	for (const FrameMarker& frame : m_frames)
+	{
+		if (frame.frameNumber > lastCompletedFrameNumber)
+			break;
+
+		m_usedSize -= frame.size;
+		numRetiredFrames++;
+	}
+
+	m_frames.erase(m_frames.begin(), m_frames.begin() + numRetiredFrames);
+
+	// nothing is alive, so next allocations can start from beginning without wrap padding
+	if (m_usedSize == 0)
+		m_head = 0;
+}
+
+void FrameRingAllocator::Reset(size_t capacity)
+{
+	m_frames.clear();
+
+	m_capacity = capacity;
+	m_head = 0;
+	m_usedSize = 0;
+	m_currentFrameSize = 0;
+}
+
+size_t FrameRingAllocator::GetCapacity() const
+{
+	return m_capacity;
+}
+
+size_t FrameRingAllocator::GetUsedSize() const
+{
+	return m_usedSize;
+}
+
+unsigned int FrameRingAllocator::GetNumFramesInFlight() const
+{
+	return static_cast<unsigned int>(m_frames.size());
+}
\ No newline at end of file
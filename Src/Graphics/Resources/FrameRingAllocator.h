@@ -0,0 +1,42 @@
+#pragma once
+#include "Includes/CppIncludes.h"
+
+// bump allocator over ring of memory. Allocations are grouped by frames and whole frame is released at once,
+// after GPU finished using it. Class only manages offsets, so it doesn't depend on any graphics resource
+class FrameRingAllocator
+{
+	struct FrameMarker
+	{
+		size_t frameNumber;
+		size_t size;
+	};
+
+public:
+	FrameRingAllocator(size_t capacity = 0);
+
+public:
+	// returns offset of allocated memory or std::nullopt if ring doesn't have enough free space
+	std::optional<size_t> Allocate(size_t size, size_t alignment);
+
+	// closes allocations made since previous call, they are kept until frame number gets retired
+	void FinishFrame(size_t frameNumber);
+
+	// releases memory of all frames with frame number lower or equal to given one
+	void Retire(size_t lastCompletedFrameNumber);
+
+	// drops all allocations, used when ring is moved to new memory
+	void Reset(size_t capacity);
+
+public:
+	size_t GetCapacity() const;
+	size_t GetUsedSize() const;
+	unsigned int GetNumFramesInFlight() const;
+
+private:
+	std::vector<FrameMarker> m_frames;
+
+	size_t m_capacity = 0;
+	size_t m_head = 0;
+	size_t m_usedSize = 0; // bytes between oldest alive allocation and head, including alignment and wrap padding
+	size_t m_currentFrameSize = 0;
+};
\ No newline at end of file
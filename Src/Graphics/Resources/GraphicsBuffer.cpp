@@ -11,7 +11,6 @@ GraphicsBuffer::GraphicsBuffer(Graphics& graphics, unsigned int numElements, uns
 	m_byteStride(byteStride),
 	m_numElements(numElements)
 {
-	HRESULT hr;
 	unsigned int numberOfBuffers = graphics.GetBufferCount();
 	
 	// creating resource
@@ -35,15 +34,7 @@ GraphicsBuffer::GraphicsBuffer(Graphics& graphics, unsigned int numElements, uns
 		resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
 		resourceDesc.Flags = flags; 
 
-		// this is very incorrect practice since creating many different commited resources for one purpose is bad practice. It is only temporary solution
-		THROW_ERROR(graphics.GetDeviceResources().GetDevice()->CreateCommittedResource(
-			&heapPropeties,
-			D3D12_HEAP_FLAG_NONE,
-			&resourceDesc,
-			D3D12_RESOURCE_STATE_COMMON,
-			nullptr,
-			IID_PPV_ARGS(&m_pResource)
-		));
+		CreateCommittedResource(graphics, heapPropeties, resourceDesc, nullptr);
 	}
 }
 
@@ -93,21 +84,12 @@ void GraphicsBuffer::Read(Graphics& graphics, void* data, unsigned int size, uns
 	THROW_INTERNAL_ERROR_IF("Tried to read resource without cpu access", m_cpuAccess != CPUAccess::readwrite);
 	THROW_INTERNAL_ERROR_IF("Tried to read out of buffer", m_byteSize < offset + size);
 
-	HRESULT hr;
-	ID3D12Resource* pConstBuffer = GetResource();
-
 	{
-		unsigned char* pMappedData = nullptr;
-
-		THROW_ERROR(pConstBuffer->Map(
-			0,
-			nullptr,
-			reinterpret_cast<void**>(&pMappedData)
-		));
+		unsigned char* pMappedData = static_cast<unsigned char*>(MapResource(graphics, nullptr));
 
 		memcpy_s(data, size, pMappedData + offset, size);
 
-		pConstBuffer->Unmap(0, nullptr);
+		UnmapResource(nullptr);
 	}
 }
 
@@ -135,6 +117,24 @@ void GraphicsBuffer::Update(Graphics& graphics, const void* data, size_t rowSize
 	}
 }
 
+void GraphicsBuffer::Update(Graphics& graphics, const void* data, std::span<const DataRange> ranges, size_t offset)
+{
+	if (ranges.empty())
+		return;
+
+	if (m_cpuAccess == CPUAccess::readwrite || m_cpuAccess == CPUAccess::write)
+	{
+		const unsigned char* pData = static_cast<const unsigned char*>(data);
+
+		for (const DataRange& range : ranges)
+			UpdateLocalResource(graphics, pData + range.offset, range.size, 1, range.size, range.size, offset + range.offset);
+	}
+	else
+	{
+		UpdateRangesUsingTempResource(graphics, data, ranges, offset);
+	}
+}
+
 void* GraphicsBuffer::Map(Graphics& graphics, SIZE_T readStart, SIZE_T readEnd)
 {
 	THROW_INTERNAL_ERROR_IF("Tried to read out of buffer data", readStart > m_byteSize || readEnd > m_byteSize );
@@ -142,11 +142,8 @@ void* GraphicsBuffer::Map(Graphics& graphics, SIZE_T readStart, SIZE_T readEnd)
 	THROW_INTERNAL_ERROR_IF("Tried to map and read buffer that doesn't have CPU read access", m_cpuAccess == CPUAccess::write && (readStart != 0 || readEnd != 0));
 	THROW_INTERNAL_ERROR_IF("Tried to map already mapped buffer", m_mapped);
 
-	HRESULT hr;
-
 	D3D12_RANGE readRange = { .Begin = readStart , .End = readEnd };
-	void* pMappedData = nullptr;
-	THROW_ERROR(m_pResource->Map(0, &readRange, &pMappedData));
+	void* pMappedData = MapResource(graphics, &readRange);
 
 	m_mapped = true;
 
@@ -159,7 +156,7 @@ void GraphicsBuffer::UnMap(SIZE_T writeStart, SIZE_T writeEnd)
 	THROW_INTERNAL_ERROR_IF("Tried to unmap not mapped buffer", !m_mapped);
 
 	D3D12_RANGE writeRange = { .Begin = writeStart , .End = writeEnd };
-	m_pResource->Unmap(0, &writeRange);
+	UnmapResource(&writeRange);
 
 	m_mapped = false;
 }
@@ -192,25 +189,61 @@ void GraphicsBuffer::UpdateUsingTempResource(Graphics& graphics, const void* dat
 	graphics.GetFrameResourceDeleter()->DeleteResource(graphics, std::move(uploadBuffer));
 }
 
-void GraphicsBuffer::UpdateLocalResource(Graphics& graphics, const void* data, size_t rowSize, size_t rows, size_t dataRowPitch, size_t targetRowPitch, size_t offset)
+void GraphicsBuffer::UpdateRangesUsingTempResource(Graphics& graphics, const void* data, std::span<const DataRange> ranges, size_t offset)
 {
-	THROW_INTERNAL_ERROR_IF("GraphicsBuffer was larger than resource itself", targetRowPitch * rows + offset - (targetRowPitch - rowSize) > m_byteSize);
+	const unsigned char* pData = static_cast<const unsigned char*>(data);
 
-	ID3D12Resource* pConstBuffer = GetResource();
+	size_t uploadSize = 0;
+	for (const DataRange& range : ranges)
+		uploadSize += range.size;
 
-	HRESULT hr;
+	// all ranges are packed into one upload buffer, so we create only one temp resource per update
+	std::shared_ptr<GraphicsBuffer> uploadBuffer = std::make_shared<GraphicsBuffer>(graphics, uploadSize, 1, CPUAccess::write);
+
+	{
+		size_t uploadOffset = 0;
+
+		for (const DataRange& range : ranges)
+		{
+			uploadBuffer->UpdateLocalResource(graphics, pData + range.offset, range.size, 1, range.size, range.size, uploadOffset);
+			uploadOffset += range.size;
+		}
+	}
+
+	CommandList* commandList = graphics.GetRenderer().GetPipeline().GetGraphicCommandList();
+
+	BEGIN_COMMAND_LIST_EVENT(commandList, "Copying GraphicsBuffer ranges");
+
+	commandList->SetResourceState(graphics, uploadBuffer.get(), D3D12_RESOURCE_STATE_COPY_SOURCE);
+	commandList->SetResourceState(graphics, this, D3D12_RESOURCE_STATE_COPY_DEST);
+
+	{
+		size_t uploadOffset = 0;
+
+		for (const DataRange& range : ranges)
+		{
+			commandList->CopyBufferRegion(graphics, GetResource(), offset + range.offset, uploadBuffer->GetResource(), uploadOffset, range.size);
+			uploadOffset += range.size;
+		}
+	}
+
+	commandList->SetResourceState(graphics, this, GetResourceTargetState());
+	commandList->SetResourceState(graphics, uploadBuffer.get(), uploadBuffer->GetResourceTargetState());
+
+	END_COMMAND_LIST_EVENT(commandList);
+
+	graphics.GetFrameResourceDeleter()->DeleteResource(graphics, std::move(uploadBuffer));
+}
+
+void GraphicsBuffer::UpdateLocalResource(Graphics& graphics, const void* data, size_t rowSize, size_t rows, size_t dataRowPitch, size_t targetRowPitch, size_t offset)
+{
+	THROW_INTERNAL_ERROR_IF("GraphicsBuffer was larger than resource itself", targetRowPitch * rows + offset - (targetRowPitch - rowSize) > m_byteSize);
 
 	// passing data to constant buffer resource
 	{
-		unsigned char* pMappedData = nullptr;
+		unsigned char* pMappedData = static_cast<unsigned char*>(MapResource(graphics, nullptr));
 		const unsigned char* pData = static_cast<const unsigned char*>(data);
 
-		THROW_ERROR(pConstBuffer->Map(
-			0,
-			nullptr,
-			reinterpret_cast<void**>(&pMappedData)
-		));
-
 		for(int row = 0; row < rows; row++)
 		{
 			memcpy_s(
@@ -221,6 +254,8 @@ void GraphicsBuffer::UpdateLocalResource(Graphics& graphics, const void* data, s
 			);
 		}
 
-		pConstBuffer->Unmap(0, nullptr);
+		UnmapResource(nullptr);
 	}
+
+	graphics.GetProfiler().AddUploadedBytes(rowSize * rows);
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "Includes/WRLNoWarnings.h"
 
 #include "GraphicsResource.h"
+#include "Graphics/Data/DataRange.h"
 
 #include "Graphics/Bindables/Bindable.h"
 
@@ -27,6 +28,9 @@ public:
 	void Update(Graphics& graphics, const void* data, size_t size, size_t offset = 0);
 	void Update(Graphics& graphics, const void* data, size_t rowSize, size_t rows, size_t dataRowPitch, size_t targetRowPitch, size_t offset = 0);
 
+	// updates only given ranges of data, range offsets are relative to both data and offset in buffer
+	void Update(Graphics& graphics, const void* data, std::span<const DataRange> ranges, size_t offset = 0);
+
 	template<class T>
 	void Update(Graphics& graphics, std::initializer_list<T> list)
 	{
@@ -42,6 +46,7 @@ public:
 
 private:
 	void UpdateUsingTempResource(Graphics& graphics, const void* data, size_t size, size_t offset = 0);
+	void UpdateRangesUsingTempResource(Graphics& graphics, const void* data, std::span<const DataRange> ranges, size_t offset = 0);
 	void UpdateLocalResource(Graphics& graphics, const void* data, size_t rowSize, size_t rows, size_t dataRowPitch, size_t targetRowPitch, size_t offset = 0);
 
 protected:
@@ -1,6 +1,8 @@
 #include "GraphicsBufferSuballocator.h"
 #include "Graphics/Core/Graphics.h"
 
+#include "Graphics/Profiler/RenderStats.h"
+
 BufferAllocatorChunk::BufferAllocatorChunk(size_t byteOffset_, size_t elementOffset_, size_t size_, unsigned int stride_, GraphicsBufferSuballocator* allocator_)
 	:
 	byteOffset(byteOffset_),
@@ -46,14 +48,17 @@ BufferAllocatorChunk& BufferAllocatorChunk::operator=(BufferAllocatorChunk&& oth
 	return *this;
 }
 
-GraphicsBufferSuballocator::GraphicsBufferSuballocator(Graphics& graphics, unsigned int numElements, unsigned int byteStride, D3D12_RESOURCE_STATES bufferState, BufferType type)
+GraphicsBufferSuballocator::GraphicsBufferSuballocator(Graphics& graphics, unsigned int numElements, unsigned int byteStride, D3D12_RESOURCE_STATES bufferState, BufferType type, const char* name)
 	:
 	m_stride(byteStride),
-	m_type(type)
+	m_type(type),
+	m_name(name)
 {
 	if (numElements == 0)
 		return;
 
+	MemoryOwnerScope ownerScope(m_name);
+
 	GraphicsResource::CPUAccess cpuAccess = m_type == BufferType::Static ? GraphicsResource::CPUAccess::notavailable : GraphicsResource::CPUAccess::readwrite;
 
 	m_buffer = std::make_unique<GraphicsBuffer>(graphics, numElements, byteStride, cpuAccess, bufferState);
@@ -82,6 +87,8 @@ std::shared_ptr<BufferAllocatorChunk> GraphicsBufferSuballocator::Push(Graphics&
 		m_buffer->Update(graphics, data, size, chunk.offset);
 	else
 	{
+		MemoryOwnerScope ownerScope(m_name);
+
 		auto uploadBuffer = std::make_unique<GraphicsBuffer>(graphics, size, 1, GraphicsResource::CPUAccess::write);
 		uploadBuffer->Update(graphics, data, size);
 
@@ -118,9 +125,27 @@ void GraphicsBufferSuballocator::Write(Graphics& graphics, BufferAllocatorChunk*
 	THROW_INTERNAL_ERROR_IF("Tried to access memory out of resource bounds", chunkInfo->byteOffset + offset + size > m_buffer->GetByteSize());
 	THROW_INTERNAL_ERROR_IF("Tried to access memory out of chunk bounds", size > chunkInfo->size);
 
+	RenderStats::Add(RenderCounter::UploadedBytes, size);
+
 	m_buffer->Update(graphics, data, size, chunkInfo->byteOffset + offset);
 }
 
+void GraphicsBufferSuballocator::Write(Graphics& graphics, BufferAllocatorChunk* chunkInfo, const void* data, std::span<const DataRange> ranges, size_t offset)
+{
+	if (ranges.empty())
+		return;
+
+	size_t rangesEnd = ranges.back().GetEnd();
+
+	THROW_INTERNAL_ERROR_IF("Tried to access memory out of resource bounds", chunkInfo->byteOffset + offset + rangesEnd > m_buffer->GetByteSize());
+	THROW_INTERNAL_ERROR_IF("Tried to access memory out of chunk bounds", offset + rangesEnd > chunkInfo->size);
+
+	for (const DataRange& range : ranges)
+		RenderStats::Add(RenderCounter::UploadedBytes, range.size);
+
+	m_buffer->Update(graphics, data, ranges, chunkInfo->byteOffset + offset);
+}
+
 std::shared_ptr<BufferAllocatorChunk> GraphicsBufferSuballocator::Resize(Graphics& graphics, std::shared_ptr<BufferAllocatorChunk>& chunkInfo, size_t newSize, unsigned int stride)
 {
 	// return the same size
@@ -168,6 +193,8 @@ void GraphicsBufferSuballocator::Update(Graphics& graphics)
 	Pipeline& pipeline = graphics.GetRenderer().GetPipeline();
 
 	{
+		MemoryOwnerScope ownerScope(m_name);
+
 		unsigned int numElements = m_usedSpace / m_stride;
 		std::unique_ptr<GraphicsBuffer> newBuffer = std::make_unique<GraphicsBuffer>(graphics, numElements, m_stride, GraphicsResource::CPUAccess::notavailable);
 
@@ -199,7 +226,7 @@ void GraphicsBufferSuballocator::Update(Graphics& graphics)
 			SourceBufferRegionCopyData{ uploadBuffer.buffer.get(), 0, uploadBuffer.buffer->GetByteSize() }
 		);
 
-		graphics.GetFrameResourceDeleter()->DeleteResource(graphics, std::move(uploadBuffer));
+		graphics.GetFrameResourceDeleter()->DeleteResource(graphics, std::move(uploadBuffer.buffer));
 	}
 
 	m_pendingUploadBuffers.clear();
@@ -215,6 +242,37 @@ unsigned int GraphicsBufferSuballocator::GetByteStride() const
 	return m_stride;
 }
 
+const char* GraphicsBufferSuballocator::GetName() const
+{
+	return m_name;
+}
+
+MemoryTracker::SuballocatorStats GraphicsBufferSuballocator::GetMemoryStats() const
+{
+	MemoryTracker::SuballocatorStats stats = {};
+	stats.capacity = m_buffer ? m_buffer->GetByteSize() : 0;
+	stats.usedEnd = m_usedSpace;
+	stats.numFreeChunks = unsigned int(m_freeChunks.size());
+
+	for (const FreedChunkInfo& freeChunk : m_freeChunks)
+	{
+		stats.freeBytes += freeChunk.chunk.size;
+		stats.largestFreeChunk = std::max(stats.largestFreeChunk, freeChunk.chunk.size);
+	}
+
+	// space after the last chunk is one more free chunk
+	if (stats.capacity > m_usedSpace)
+	{
+		size_t remainingSpace = stats.capacity - m_usedSpace;
+
+		stats.freeBytes += remainingSpace;
+		stats.largestFreeChunk = std::max(stats.largestFreeChunk, remainingSpace);
+		stats.numFreeChunks++;
+	}
+
+	return stats;
+}
+
 void GraphicsBufferSuballocator::RegisterForUpdates(BufferAllocatorUpdateListener* listener)
 {
 	m_updateListeners.push_back(listener);
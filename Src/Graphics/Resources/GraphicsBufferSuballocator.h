@@ -1,6 +1,7 @@
 #pragma once
 #include "Includes/CppIncludes.h"
 #include "Graphics/Resources/GraphicsBuffer.h"
+#include "Graphics/Profiler/MemoryTracker.h"
 
 class BufferAllocatorUpdateListener
 {
@@ -69,13 +70,15 @@ private:
 	};
 
 public:
-	GraphicsBufferSuballocator(Graphics& graphics, unsigned int numElements, unsigned int byteStride, D3D12_RESOURCE_STATES bufferState, BufferType type);
+	// name has to outlive suballocator, it is owner of its buffers in MemoryTracker
+	GraphicsBufferSuballocator(Graphics& graphics, unsigned int numElements, unsigned int byteStride, D3D12_RESOURCE_STATES bufferState, BufferType type, const char* name);
 
 public:
 	std::shared_ptr<BufferAllocatorChunk> Allocate(Graphics& graphics, size_t size, unsigned int stride);
 	std::shared_ptr<BufferAllocatorChunk> Push(Graphics& graphics, void* data, size_t size, unsigned int stride);
 	void Free(BufferAllocatorChunk* chunkInfo);
 	void Write(Graphics& graphics, BufferAllocatorChunk* chunkInfo, void* data, size_t size, size_t offset);
+	void Write(Graphics& graphics, BufferAllocatorChunk* chunkInfo, const void* data, std::span<const DataRange> ranges, size_t offset);
 	std::shared_ptr<BufferAllocatorChunk> Resize(Graphics& graphics, std::shared_ptr<BufferAllocatorChunk>& chunkInfo, size_t newSize, unsigned int stride);
 
 	// takes all upload buffers and reallocates main data if needed
@@ -85,6 +88,10 @@ public:
 
 	unsigned int GetByteStride() const;
 
+	const char* GetName() const;
+
+	MemoryTracker::SuballocatorStats GetMemoryStats() const;
+
 	void RegisterForUpdates(BufferAllocatorUpdateListener* listener);
 	void UnregisterFromUpdates(BufferAllocatorUpdateListener* listener);
 
@@ -107,4 +114,5 @@ private:
 	size_t m_usedSpace = 0;
 	unsigned int m_stride;
 	BufferType m_type;
+	const char* m_name;
 };
\ No newline at end of file
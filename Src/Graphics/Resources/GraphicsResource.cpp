@@ -15,7 +15,12 @@ GraphicsResource::GraphicsResource(DXGI_FORMAT format, CPUAccess cpuAccess, D3D1
 
 ID3D12Resource* GraphicsResource::GetResource() const
 {
-	return m_pResource.Get();
+	return m_pResource ? m_pResource->GetNative() : nullptr;
+}
+
+D3D12_RESOURCE_DESC GraphicsResource::GetResourceDesc() const
+{
+	return m_pResource->GetDesc();
 }
 
 void GraphicsResource::CopyResourcesTo(Graphics& graphics, CommandList* copyCommandList, GraphicsResource* dst)
@@ -37,22 +42,7 @@ void GraphicsResource::CopyResourcesTo(Graphics& graphics, CommandList* copyComm
 
 ResourceFootprint GraphicsResource::GetResourceFootprint(Graphics& graphics, unsigned int targetSubresource)
 {
-	ResourceFootprint footprint = {};
-
-	D3D12_RESOURCE_DESC resourceDesc = m_pResource->GetDesc();
-
-	THROW_INFO_ERROR(graphics.GetDeviceResources().GetDevice()->GetCopyableFootprints(
-		&resourceDesc,
-		targetSubresource,
-		1,
-		0,
-		&footprint.layout,
-		&footprint.numRows,
-		&footprint.rowSizeInBytes,
-		&footprint.totalBytes
-	));
-
-	return footprint;
+	return graphics.GetDevice().GetCopyableFootprint(graphics, GetResourceDesc(), targetSubresource);
 }
 
 DXGI_FORMAT GraphicsResource::GetFormat() const
@@ -62,7 +52,7 @@ DXGI_FORMAT GraphicsResource::GetFormat() const
 
 D3D12_GPU_VIRTUAL_ADDRESS GraphicsResource::GetGPUAddress() const
 {
-	return m_pResource->GetGPUVirtualAddress();
+	return m_pResource->GetGPUAddress();
 }
 
 D3D12_RESOURCE_STATES GraphicsResource::GetResourceState(unsigned int targetSubresource) const
@@ -99,6 +89,38 @@ GraphicsResource::CPUAccess GraphicsResource::GetCPUAccess() const
 	return m_cpuAccess;
 }
 
+void GraphicsResource::MarkPendingDeletion()
+{
+	m_trackedMemory.MarkPendingDeletion();
+}
+
+void GraphicsResource::CreateCommittedResource(Graphics& graphics, const D3D12_HEAP_PROPERTIES& heapProperties, const D3D12_RESOURCE_DESC& resourceDesc, const D3D12_CLEAR_VALUE* clearValue)
+{
+	m_trackedMemory = MemoryTracker::Track(GetMemoryCategory(resourceDesc), graphics.GetDevice().GetResourceAllocationInfo(resourceDesc).SizeInBytes);
+
+	bool cpuAccess = m_cpuAccess == CPUAccess::readwrite || m_cpuAccess == CPUAccess::write;
+
+	// this is very incorrect practice since creating many different commited resources for one purpose is bad practice. It is only temporary solution
+	m_pResource = graphics.GetDevice().CreateCommittedResource(graphics, heapProperties, resourceDesc, clearValue, cpuAccess);
+}
+
+void GraphicsResource::CreatePlacedResource(Graphics& graphics, ID3D12Heap* pHeap, size_t heapOffset, const D3D12_RESOURCE_DESC& resourceDesc, const D3D12_CLEAR_VALUE* clearValue)
+{
+	m_trackedMemory = {};
+
+	m_pResource = graphics.GetDevice().CreatePlacedResource(graphics, pHeap, heapOffset, resourceDesc, clearValue);
+}
+
+void* GraphicsResource::MapResource(Graphics& graphics, const D3D12_RANGE* readRange)
+{
+	return m_pResource->Map(graphics, readRange);
+}
+
+void GraphicsResource::UnmapResource(const D3D12_RANGE* writtenRange)
+{
+	m_pResource->Unmap(writtenRange);
+}
+
 D3D12_CPU_PAGE_PROPERTY GraphicsResource::GetHardwareHeapUsagePropety(CPUAccess cpuAccess)
 {
 	switch (cpuAccess)
@@ -136,4 +158,15 @@ D3D12_HEAP_TYPE GraphicsResource::GetHardwareHeapType(CPUAccess cpuAccess)
 
 	default:  return D3D12_HEAP_TYPE_DEFAULT;
 	}
+}
+
+MemoryCategory GraphicsResource::GetMemoryCategory(const D3D12_RESOURCE_DESC& resourceDesc) const
+{
+	if (resourceDesc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+		return m_cpuAccess == CPUAccess::write ? MemoryCategory::UploadBuffers : MemoryCategory::Buffers;
+
+	if (resourceDesc.Flags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL))
+		return MemoryCategory::RenderTargets;
+
+	return MemoryCategory::Textures;
 }
\ No newline at end of file
@@ -3,17 +3,12 @@
 #include "Includes/DirectXIncludes.h"
 #include "Includes/WRLNoWarnings.h"
 
+#include "Graphics/Core/RenderDevice.h"
+#include "Graphics/Profiler/MemoryTracker.h"
+
 class Graphics;
 class CommandList;
 
-struct ResourceFootprint
-{
-	D3D12_PLACED_SUBRESOURCE_FOOTPRINT layout = {};
-	UINT numRows = 0;
-	UINT64 rowSizeInBytes = 0;
-	UINT64 totalBytes = 0;
-};
-
 enum class GraphicsResourceType
 {
 	unknown,
@@ -47,8 +42,11 @@ public:
 	GraphicsResource(GraphicsResource&&) noexcept = default;
 
 public:
+	// nullptr when graphics runs on null device
 	ID3D12Resource* GetResource() const;
 
+	D3D12_RESOURCE_DESC GetResourceDesc() const;
+
 	void CopyResourcesTo(Graphics& graphics, CommandList* copyCommandList, GraphicsResource* dst);
 	virtual void CopyResourcesToTexture(Graphics& graphics, CommandList* copyCommandList, GraphicsResource* dst, int targetMip = 0) = 0;
 
@@ -69,14 +67,29 @@ public:
 
 	virtual GraphicsResourceType GetResourceType() = 0;
 
+	// memory stays accounted until resource is destroyed, but is shown as waiting for frames in flight
+	void MarkPendingDeletion();
+
+protected:
+	void CreateCommittedResource(Graphics& graphics, const D3D12_HEAP_PROPERTIES& heapProperties, const D3D12_RESOURCE_DESC& resourceDesc, const D3D12_CLEAR_VALUE* clearValue);
+
+	// memory of placed resource belongs to the heap, so it's accounted by owner of the heap
+	void CreatePlacedResource(Graphics& graphics, ID3D12Heap* pHeap, size_t heapOffset, const D3D12_RESOURCE_DESC& resourceDesc, const D3D12_CLEAR_VALUE* clearValue);
+
+	void* MapResource(Graphics& graphics, const D3D12_RANGE* readRange);
+	void UnmapResource(const D3D12_RANGE* writtenRange);
+
 protected:
 	static D3D12_CPU_PAGE_PROPERTY GetHardwareHeapUsagePropety(CPUAccess cpuAccess);
 	static D3D12_MEMORY_POOL GetHardwareHeapMemoryPool(CPUAccess cpuAccess);
 	static D3D12_HEAP_TYPE GetHardwareHeapType(CPUAccess cpuAccess);
 
+	MemoryCategory GetMemoryCategory(const D3D12_RESOURCE_DESC& resourceDesc) const;
+
 protected:
-	Microsoft::WRL::ComPtr<ID3D12Resource> m_pResource;
+	std::unique_ptr<DeviceResource> m_pResource;
 	DXGI_FORMAT m_format;
 	CPUAccess m_cpuAccess;
 	ResourceStates m_state;
+	MemoryTracker::Allocation m_trackedMemory;
 };
\ No newline at end of file
@@ -53,7 +53,6 @@ GraphicsTexture::GraphicsTexture(Graphics& graphics, GraphicsTextureDimensions d
 
 void GraphicsTexture::Initialize(Graphics& graphics, D3D12_RESOURCE_FLAGS flags, D3D12_CLEAR_VALUE* clearValue)
 {
-	HRESULT hr;
 	unsigned int numberOfBuffers = graphics.GetBufferCount();
 
 	// creating resource
@@ -77,17 +76,37 @@ void GraphicsTexture::Initialize(Graphics& graphics, D3D12_RESOURCE_FLAGS flags,
 		resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
 		resourceDesc.Flags = flags;
 
-		THROW_ERROR(graphics.GetDeviceResources().GetDevice()->CreateCommittedResource(
-			&heapPropeties,
-			D3D12_HEAP_FLAG_NONE,
-			&resourceDesc,
-			D3D12_RESOURCE_STATE_COMMON,
-			clearValue,
-			IID_PPV_ARGS(&m_pResource)
-		));
+		CreateCommittedResource(graphics, heapPropeties, resourceDesc, clearValue);
 	}
 }
 
+void GraphicsTexture::PlaceInHeap(Graphics& graphics, ID3D12Heap* pHeap, size_t heapOffset)
+{
+	D3D12_RESOURCE_DESC resourceDesc = GetResourceDesc();
+
+	D3D12_CLEAR_VALUE clearValue = {};
+	clearValue.Format = m_format;
+
+	if (m_type == GraphicsTextureType::renderTarget)
+	{
+		clearValue.Color[0] = m_clearValue.renderTarget.x;
+		clearValue.Color[1] = m_clearValue.renderTarget.y;
+		clearValue.Color[2] = m_clearValue.renderTarget.z;
+		clearValue.Color[3] = m_clearValue.renderTarget.w;
+	}
+	else if (m_type == GraphicsTextureType::depthStencil)
+	{
+		clearValue.DepthStencil.Depth = m_clearValue.depthStencil.depth;
+		clearValue.DepthStencil.Stencil = m_clearValue.depthStencil.stencil;
+	}
+
+	m_pResource.reset();
+
+	CreatePlacedResource(graphics, pHeap, heapOffset, resourceDesc, m_type != GraphicsTextureType::unkown ? &clearValue : nullptr);
+
+	SetAllResourceStates(D3D12_RESOURCE_STATE_COMMON);
+}
+
 void GraphicsTexture::CopyResourcesToTexture(Graphics& graphics, CommandList* copyCommandList, GraphicsResource* dst, int targetMip)
 {
 	THROW_INTERNAL_ERROR_IF("Dest resource was NULL", dst == nullptr);
@@ -199,19 +218,11 @@ void GraphicsTexture::UpdateLocalResource(Graphics& graphics, const void* data,
 {
     THROW_INTERNAL_ERROR_IF("GraphicsTextures weren't same dimensions", m_dimensions.width != width || m_dimensions.height != height || m_format != format);
 
-    HRESULT hr;
-
     int bitWidth = width * GetPixelSize(format);
     float byteWidth = std::ceil(static_cast<float>(bitWidth) / 8.0f);
 
     // passing data to upload resource
-	THROW_ERROR(m_pResource->WriteToSubresource(
-        0,
-        nullptr,
-		data,
-        byteWidth,
-		0
-    ));
+    m_pResource->WriteToSubresource(graphics, data, unsigned int(byteWidth), height);
 }
 
 int GraphicsTexture::GetPixelSize(DXGI_FORMAT format)
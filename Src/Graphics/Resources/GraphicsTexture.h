@@ -64,6 +64,10 @@ public:
 
 	virtual GraphicsResourceType GetResourceType() override;
 
+public:
+	// moves texture to given place in heap, its previous content is lost. Used for transient textures that share memory
+	void PlaceInHeap(Graphics& graphics, ID3D12Heap* pHeap, size_t heapOffset);
+
 public:
 	void Update(Graphics& graphics, const void* data, unsigned int width, unsigned int height, unsigned int rowPitch, unsigned int targetMip, DXGI_FORMAT format);
 	void Update(Graphics& graphics, Pipeline& pipeline, const void* data, unsigned int rowSize, unsigned int numRows, unsigned int rowPitch, unsigned int targetMip, DXGI_FORMAT format);
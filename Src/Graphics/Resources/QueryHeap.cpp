@@ -7,17 +7,12 @@ QueryHeap::QueryHeap(Graphics& graphics, unsigned int numEntries)
 	:
 	m_numElements(numEntries)
 {
-	HRESULT hr;
-
 	D3D12_QUERY_HEAP_DESC queryHeapDesc = {};
 	queryHeapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
 	queryHeapDesc.Count = numEntries;
 	queryHeapDesc.NodeMask = 0;
 
-	THROW_ERROR(graphics.GetDeviceResources().GetDevice()->CreateQueryHeap(
-		&queryHeapDesc,
-		IID_PPV_ARGS(&m_pResource))
-	);
+	m_pResource = graphics.GetDevice().CreateQueryHeap(graphics, queryHeapDesc);
 }
 
 unsigned int QueryHeap::GetNumElements() const
@@ -0,0 +1,226 @@
+#include "CameraPath.h"
+
+#include "Objects/Camera.h"
+
+#include <imgui.h>
+
+namespace
+{
+	constexpr const char* defaultPathFile = "camera_path.tcam";
+}
+
+void CameraPath::StartRecording()
+{
+	StopReplay();
+
+	m_keyframes.clear();
+	m_recording = true;
+}
+
+bool CameraPath::StopRecording(const std::filesystem::path& path)
+{
+	m_recording = false;
+
+	std::ofstream file(path, std::ios::binary);
+
+	if (!file.is_open())
+		return false;
+
+	uint32_t header[3] = { fileMagic, fileVersion, uint32_t(m_keyframes.size()) };
+
+	file.write(reinterpret_cast<const char*>(header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(m_keyframes.data()), std::streamsize(m_keyframes.size() * sizeof(Keyframe)));
+
+	return true;
+}
+
+bool CameraPath::IsRecording() const
+{
+	return m_recording;
+}
+
+void CameraPath::Record(Camera& camera)
+{
+	m_keyframes.push_back({ camera.GetTransform()->GetPosition(), camera.GetPitch(), camera.GetYaw() });
+}
+
+bool CameraPath::LoadFromFile(const std::filesystem::path& path)
+{
+	std::ifstream file(path, std::ios::binary);
+
+	if (!file.is_open())
+		return false;
+
+	uint32_t header[3] = {};
+
+	if (!file.read(reinterpret_cast<char*>(header), sizeof(header)) || header[0] != fileMagic || header[1] != fileVersion || header[2] == 0)
+		return false;
+
+	// count is read from file, keyframes are allocated only when the file really holds them
+	std::error_code error;
+	uintmax_t fileSize = std::filesystem::file_size(path, error);
+
+	if (error || fileSize - sizeof(header) < uintmax_t(header[2]) * sizeof(Keyframe))
+		return false;
+
+	std::vector<Keyframe> keyframes(header[2]);
+
+	if (!file.read(reinterpret_cast<char*>(keyframes.data()), std::streamsize(keyframes.size() * sizeof(Keyframe))))
+		return false;
+
+	m_keyframes = std::move(keyframes);
+
+	return true;
+}
+
+void CameraPath::StartReplay()
+{
+	if (m_keyframes.empty())
+		return;
+
+	m_recording = false;
+	m_replaying = true;
+	m_replayFrame = 0;
+
+	m_frameTimes.clear();
+	m_frameTimes.reserve(m_keyframes.size());
+}
+
+void CameraPath::StopReplay()
+{
+	m_replaying = false;
+}
+
+bool CameraPath::IsReplaying() const
+{
+	return m_replaying;
+}
+
+float CameraPath::Replay(Camera& camera)
+{
+	std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+
+	// time since the last call is the time of previous frame
+	if (m_replayFrame > numWarmUpFrames)
+		m_frameTimes.push_back(std::chrono::duration<float, std::milli>(frameStart - m_lastReplayFrameStart).count());
+
+	m_lastReplayFrameStart = frameStart;
+
+	if (m_replayFrame == numWarmUpFrames + m_keyframes.size())
+	{
+		FinishReplay();
+		return fixedDeltaTime;
+	}
+
+	// camera waits on the first pose during warm up
+	const Keyframe& keyframe = m_keyframes.at(m_replayFrame < numWarmUpFrames ? 0 : m_replayFrame - numWarmUpFrames);
+	camera.SetView(keyframe.position, keyframe.pitch, keyframe.yaw);
+
+	m_replayFrame++;
+
+	return fixedDeltaTime;
+}
+
+const CameraPath::ReplayResult& CameraPath::GetLastReplayResult() const
+{
+	return m_lastReplayResult;
+}
+
+bool CameraPath::SaveReplayResult(const std::filesystem::path& path) const
+{
+	std::ofstream file(path);
+
+	if (!file.is_open())
+		return false;
+
+	const ReplayResult& result = m_lastReplayResult;
+
+	file << "{\"frames\":" << result.numFrames << ",\"avgMs\":" << result.avgMs << ",\"p50Ms\":" << result.p50Ms << ",\"p90Ms\":" << result.p90Ms;
+	file << ",\"p99Ms\":" << result.p99Ms << ",\"maxMs\":" << result.maxMs << "}\n";
+
+	return true;
+}
+
+void CameraPath::Draw()
+{
+	if (!ImGui::Begin("Camera path"))
+	{
+		ImGui::End();
+		return;
+	}
+
+	if (m_recording)
+	{
+		ImGui::Text("Recording, %u frames", unsigned int(m_keyframes.size()));
+
+		if (ImGui::Button("Stop recording"))
+			m_lastResult = StopRecording(defaultPathFile) ? "Saved " + std::to_string(m_keyframes.size()) + " frames to " + defaultPathFile : std::string("Failed to open ") + defaultPathFile;
+	}
+	else if (m_replaying)
+	{
+		ImGui::Text("Replaying, frame %u of %u", m_replayFrame, unsigned int(numWarmUpFrames + m_keyframes.size()));
+
+		if (ImGui::Button("Stop replay"))
+			StopReplay();
+	}
+	else
+	{
+		if (ImGui::Button("Record"))
+			StartRecording();
+
+		ImGui::SameLine();
+
+		if (ImGui::Button("Replay"))
+		{
+			if (LoadFromFile(defaultPathFile))
+				StartReplay();
+			else
+				m_lastResult = std::string("Failed to load ") + defaultPathFile;
+		}
+	}
+
+	if (!m_lastResult.empty())
+		ImGui::Text("%s", m_lastResult.c_str());
+
+	const ReplayResult& result = m_lastReplayResult;
+
+	if (result.numFrames != 0)
+	{
+		ImGui::Text("Frames: %u", result.numFrames);
+		ImGui::Text("Avg: %.3f ms, p50: %.3f ms", result.avgMs, result.p50Ms);
+		ImGui::Text("p90: %.3f ms, p99: %.3f ms, max: %.3f ms", result.p90Ms, result.p99Ms, result.maxMs);
+	}
+
+	ImGui::End();
+}
+
+void CameraPath::FinishReplay()
+{
+	m_replaying = false;
+
+	std::vector<float>& samples = m_frameTimes;
+
+	if (samples.empty())
+		return;
+
+	std::sort(samples.begin(), samples.end());
+
+	float sum = 0.0f;
+
+	for (float sample : samples)
+		sum += sample;
+
+	size_t numSamples = samples.size();
+
+	auto getPercentile = [&](float percentile)
+		{
+			return samples[std::min(numSamples - 1, size_t(std::ceil(float(numSamples) * percentile)) - 1)];
+		};
+
+	m_lastReplayResult.numFrames = unsigned int(numSamples);
+	m_lastReplayResult.avgMs = sum / float(numSamples);
+	m_lastReplayResult.p50Ms = getPercentile(0.5f);
+	m_lastReplayResult.p90Ms = getPercentile(0.9f);
+	m_lastReplayResult.p99Ms = getPercentile(0.99f);
+	m_lastReplayResult.maxMs = samples.back();
+}
\ No newline at end of file
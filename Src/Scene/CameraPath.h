@@ -0,0 +1,80 @@
+#pragma once
+#include "Includes/CppIncludes.h"
+#include "Includes/DirectXIncludes.h"
+
+class Camera;
+
+// records pose of active camera every frame and replays it with fixed timestep, so performance runs see the same frames.
+// Pose is recorded instead of input, so replay doesn't depend on camera speed, sensitivity or cursor state.
+// Frame times of replay are gathered after few warm up frames on the first pose and summarized as percentiles
+class CameraPath
+{
+public:
+	static constexpr uint32_t fileMagic = 0x4D414354; // "TCAM"
+	static constexpr uint32_t fileVersion = 1;
+	static constexpr float fixedDeltaTime = 1.0f / 60.0f;
+	static constexpr unsigned int numWarmUpFrames = 8;
+
+	struct Keyframe
+	{
+		DirectX::XMFLOAT3 position;
+		float pitch;
+		float yaw;
+	};
+
+	struct ReplayResult
+	{
+		unsigned int numFrames = 0;
+		float avgMs = 0.0f;
+		float p50Ms = 0.0f;
+		float p90Ms = 0.0f;
+		float p99Ms = 0.0f;
+		float maxMs = 0.0f;
+	};
+
+public:
+	void StartRecording();
+
+	// saves recorded path, false when file couldn't be opened
+	bool StopRecording(const std::filesystem::path& path);
+
+	bool IsRecording() const;
+
+	// has to be called once per frame after camera was updated
+	void Record(Camera& camera);
+
+public:
+	// false when file is not a camera path of current version or path is empty
+	bool LoadFromFile(const std::filesystem::path& path);
+
+	void StartReplay();
+
+	void StopReplay();
+
+	bool IsReplaying() const;
+
+	// has to be called once per frame before scene is updated, places camera on next pose and returns delta time the frame should use
+	float Replay(Camera& camera);
+
+	const ReplayResult& GetLastReplayResult() const;
+
+	// false when file couldn't be opened
+	bool SaveReplayResult(const std::filesystem::path& path) const;
+
+	void Draw();
+
+private:
+	void FinishReplay();
+
+private:
+	std::vector<Keyframe> m_keyframes;
+	bool m_recording = false;
+
+	bool m_replaying = false;
+	unsigned int m_replayFrame = 0;
+	std::chrono::steady_clock::time_point m_lastReplayFrameStart;
+	std::vector<float> m_frameTimes; // milliseconds
+
+	ReplayResult m_lastReplayResult;
+	std::string m_lastResult;
+};
\ No newline at end of file
@@ -216,11 +216,6 @@ void Material::InitializeGraphicResources(Graphics& graphics, Pipeline& pipeline
 	m_initialized = true;
 }
 
-void Material::Update()
-{
-	m_bindableContainer.Update();
-}
-
 ObjectRasterizerStateOptions Material::GetRasterizerOptions() const
 {
 	return m_rasterizerOptions;
@@ -73,8 +73,6 @@ public:
 
 	void InitializeGraphicResources(Graphics& graphics, Pipeline& pipeline);
 
-	void Update();
-
 	D3D12_GPU_DESCRIPTOR_HANDLE GetDescriptorHeapGPUHandle(Graphics& graphics) const;
 
 	ObjectRasterizerStateOptions GetRasterizerOptions() const;
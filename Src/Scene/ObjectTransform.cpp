@@ -1,4 +1,5 @@
 #include "ObjectTransform.h"
+#include "TransformHierarchy.h"
 #include "Scene/Objects/Camera.h"
 
 #include "Graphics/Core/Graphics.h"
@@ -7,28 +8,28 @@ void ObjectTransform::SetPosition(DirectX::XMFLOAT3 position)
 {
 	m_position = position;
 
-	m_localTransformChanged = true;
+	OnLocalTransformChanged();
 }
 
 void ObjectTransform::SetQuaternionRotation(DirectX::XMVECTOR rotation)
 {
 	m_rotation = rotation;
 
-	m_localTransformChanged = true;
+	OnLocalTransformChanged();
 }
 
 void ObjectTransform::SetEulerRotation(DirectX::XMFLOAT3 rotation)
 {
 	m_rotation = DirectX::XMQuaternionRotationRollPitchYaw(rotation.x, rotation.y, rotation.z);
 
-	m_localTransformChanged = true;
+	OnLocalTransformChanged();
 }
 
 void ObjectTransform::SetScale(DirectX::XMFLOAT3 scale)
 {
 	m_scale = scale;
 
-	m_localTransformChanged = true;
+	OnLocalTransformChanged();
 }
 
 void ObjectTransform::SetFromMatrix(DirectX::XMMATRIX transform, DirectX::XMFLOAT3 basePosition, float scale)
@@ -63,7 +64,7 @@ DirectX::XMFLOAT3 ObjectTransform::GetPosition() const
 DirectX::XMFLOAT3 ObjectTransform::GetWorldPosition() const
 {
 	DirectX::XMFLOAT4 row;
-	DirectX::XMStoreFloat4(&row, m_worldTransform.r[3]);
+	DirectX::XMStoreFloat4(&row, GetWorldTransform().r[3]);
 
 	return { row.x, row.y, row.z };
 }
@@ -95,27 +96,30 @@ DirectX::XMFLOAT3& ObjectTransform::GetScaleLVal()
 
 DirectX::XMMATRIX ObjectTransform::GetWorldTransform() const
 {
-	return m_worldTransform;
+	if (m_hierarchy)
+		return m_hierarchy->GetWorldTransform(m_hierarchyNode);
+
+	return GetLocalTransform();
 }
 
-void ObjectTransform::SetParentTransform(DirectX::XMMATRIX accumulatedParentTransform)
+DirectX::XMMATRIX ObjectTransform::GetLocalTransform() const
 {
-	m_parentTransformChanged = !IsEqual(m_accumulatedParentTransform, accumulatedParentTransform);
-
-	m_accumulatedParentTransform = accumulatedParentTransform;
-
-	UpdateWorldTransform();
+	return
+		DirectX::XMMatrixScaling(m_scale.x, m_scale.y, m_scale.z) *
+		DirectX::XMMatrixRotationQuaternion(m_rotation) *
+		DirectX::XMMatrixTranslation(m_position.x, m_position.y, m_position.z);
 }
 
-void ObjectTransform::UpdateLocalTransformIfNeeded()
+void ObjectTransform::SetHierarchyNode(TransformHierarchy* hierarchy, unsigned int node)
 {
-	if (m_localTransformChanged)
-		UpdateLocalTransform();
+	m_hierarchy = hierarchy;
+	m_hierarchyNode = node;
 }
 
 void ObjectTransform::CheckIsTransformChanged(bool transformChanged)
 {
-	m_localTransformChanged |= transformChanged;
+	if (transformChanged)
+		OnLocalTransformChanged();
 }
 
 bool ObjectTransform::GetTransformChanged() const
@@ -128,17 +132,10 @@ void ObjectTransform::SetUpdated()
 	m_localTransformChanged = false;
 }
 
-void ObjectTransform::UpdateLocalTransform()
+void ObjectTransform::OnLocalTransformChanged()
 {
-	m_localTransform =
-		DirectX::XMMatrixScaling(m_scale.x, m_scale.y, m_scale.z) *
-		DirectX::XMMatrixRotationQuaternion(m_rotation) *
-		DirectX::XMMatrixTranslation(m_position.x, m_position.y, m_position.z);
-
-	UpdateWorldTransform();
-}
+	m_localTransformChanged = true;
 
-void ObjectTransform::UpdateWorldTransform()
-{
-	m_worldTransform =  m_localTransform * m_accumulatedParentTransform;
+	if (m_hierarchy)
+		m_hierarchy->MarkLocalTransformChanged(m_hierarchyNode);
 }
\ No newline at end of file
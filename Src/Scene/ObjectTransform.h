@@ -4,6 +4,7 @@
 
 class Graphics;
 class Camera;
+class TransformHierarchy;
 
 class ObjectTransform
 {
@@ -26,29 +27,27 @@ public:
 	DirectX::XMFLOAT3& GetScaleLVal();
 
 public:
+	// world transform is calculated by scene's TransformHierarchy, objects outside of it use local transform
 	DirectX::XMMATRIX GetWorldTransform() const;
-	void SetParentTransform(DirectX::XMMATRIX accumulatedParentTransform);
+	DirectX::XMMATRIX GetLocalTransform() const;
+
+	void SetHierarchyNode(TransformHierarchy* hierarchy, unsigned int node);
 
 public:
-	void UpdateLocalTransformIfNeeded();
 	void CheckIsTransformChanged(bool transformChanged);
 	bool GetTransformChanged() const;
 	void SetUpdated();
 
 private:
-	void UpdateLocalTransform();
-	void UpdateWorldTransform();
+	void OnLocalTransformChanged();
 
 private:
 	DirectX::XMFLOAT3 m_position = {0.0f, 0.0f, 0.0f};
 	DirectX::XMVECTOR m_rotation = DirectX::XMQuaternionIdentity();
 	DirectX::XMFLOAT3 m_scale = {1.0f, 1.0f, 1.0f};
 
-	DirectX::XMMATRIX m_worldTransform = DirectX::XMMatrixIdentity();
-	DirectX::XMMATRIX m_accumulatedParentTransform = DirectX::XMMatrixIdentity();
-	DirectX::XMMATRIX m_localTransform = DirectX::XMMatrixIdentity();
+	TransformHierarchy* m_hierarchy = nullptr;
+	unsigned int m_hierarchyNode = 0;
 
 	bool m_localTransformChanged = false;
-	bool m_parentTransformChanged = false;
-	uint8_t m_buffersLeftToChange = 0;
 };
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "Box.h"
+#include "Graphics/Core/Graphics.h"
+
+#include "Includes/BindablesInclude.h"
+
+#include "Graphics/Core/OcclusionPrimitives.h"
+#include "Graphics/Core/OcclusionCuller.h"
+#include "Graphics/Data/DynamicVertex.h"
+
+#include "Graphics/RenderGraph/Steps/RenderGraphicsGeometryStep.h"
+#include "Scene/RenderTechnique.h"
+
+#include "Scene/Material.h"
+
+Box::Box(Graphics& graphics, SceneObject* pParent, std::shared_ptr<Material> material, DirectX::XMFLOAT3 position)
+	:
+	SceneObject(pParent)
+{
+	m_transform.SetPosition(position);
+
+	Mesh boxMesh;
+
+	RenderTechnique technique(RenderJob::JobType::GBuffer);
+	RenderGraphicsGeometryStep step(this);
+	{
+		static constexpr unsigned int numVertices = 24;
+
+		DynamicVertex::DynamicVertexLayout vertexLayout;
+		vertexLayout.AddElement<DynamicVertex::ElementType::Position>();
+		vertexLayout.AddElement<DynamicVertex::ElementType::Normal>();
+
+		DynamicVertex::DynamicVertexLayout positionOnlyVertexLayout;
+		positionOnlyVertexLayout.AddElement<DynamicVertex::ElementType::Position>();
+
+		DynamicVertex::DynamicVertex vertexBuffer(vertexLayout, numVertices);
+		DynamicVertex::DynamicVertex positionOnlyVertexBuffer(positionOnlyVertexLayout, numVertices);
+		std::shared_ptr<OccluderMesh> occluderMesh = std::make_shared<OccluderMesh>();
+
+		// every face has its own vertices so normals stay flat, faces go +x, -x, +y, -y, +z, -z
+		for (unsigned int face = 0; face < 6; face++)
+		{
+			unsigned int axis = face / 2;
+			float sign = face % 2 == 0 ? 1.0f : -1.0f;
+
+			unsigned int firstVertex = face * 4;
+
+			for (unsigned int corner = 0; corner < 4; corner++)
+			{
+				float position[3] = {};
+				position[axis] = 0.5f * sign;
+				position[(axis + 1) % 3] = (corner & 1) != 0 ? 0.5f : -0.5f;
+				position[(axis + 2) % 3] = (corner & 2) != 0 ? 0.5f : -0.5f;
+
+				float normal[3] = {};
+				normal[axis] = sign;
+
+				vertexBuffer.EmplaceBack();
+				vertexBuffer.Back().GetPropety<DynamicVertex::ElementType::Position>() = { position[0], position[1], position[2] };
+				vertexBuffer.Back().GetPropety<DynamicVertex::ElementType::Normal>() = { normal[0], normal[1], normal[2] };
+
+				positionOnlyVertexBuffer.EmplaceBack();
+				positionOnlyVertexBuffer.Back().GetPropety<DynamicVertex::ElementType::Position>() = { position[0], position[1], position[2] };
+
+				occluderMesh->positions.push_back({ position[0], position[1], position[2] });
+			}
+
+			// clockwise when looking at the face from outside
+			if (sign > 0.0f)
+				occluderMesh->indices.insert(occluderMesh->indices.end(), { firstVertex, firstVertex + 1, firstVertex + 3, firstVertex, firstVertex + 3, firstVertex + 2 });
+			else
+				occluderMesh->indices.insert(occluderMesh->indices.end(), { firstVertex, firstVertex + 3, firstVertex + 1, firstVertex, firstVertex + 2, firstVertex + 3 });
+		}
+
+		step.SetBoundingBox(BoundingBox(positionOnlyVertexBuffer));
+		occluderMesh->boundingBox = step.GetBoundingBox();
+
+		// buffers are created only for the first box, others get them from resource list
+		step.SetAttributeBufferEntry(VertexBufferEntry::GetResource(graphics, "Box#AttributeBuffer", vertexBuffer));
+		step.SetPositionBufferEntry(VertexBufferEntry::GetResource(graphics, "Box#PositionBuffer", positionOnlyVertexBuffer));
+		step.SetIndexBufferEntry(IndexBufferEntry::GetResource(graphics, "Box#IndexBuffer", std::vector<unsigned int>(occluderMesh->indices)));
+
+		step.SetOccluderMesh(std::move(occluderMesh));
+
+		step.SetMaterial(std::move(material));
+
+		step.AddBindable(InputLayout::GetResource(graphics, vertexLayout));
+		step.AddBindable(PrimitiveTechnology::GetResource(graphics, D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE));
+	}
+	technique.AddStep(std::move(step));
+	boxMesh.AddTechnique(std::move(technique));
+	AddMesh(boxMesh);
+}
\ No newline at end of file
@@ -0,0 +1,12 @@
+#pragma once
+#include "Scene/SceneObject.h"
+
+class Graphics;
+class Material;
+
+// unit cube drawn with given material, geometry is shared between all boxes
+class Box : public SceneObject
+{
+public:
+	Box(Graphics& graphics, SceneObject* pParent, std::shared_ptr<Material> material, DirectX::XMFLOAT3 position = { 0.0f, 0.0f, 0.0f });
+};
\ No newline at end of file
@@ -24,6 +24,10 @@ void CameraBase::Initialize(Graphics& graphics, Pipeline& pipeline)
 	THROW_INTERNAL_ERROR_IF("Camera index was not assigned", m_cameraIndex == -1);
 
 	m_pCameraBuffer = static_cast<CachedConstantBuffer*>(pipeline.GetStaticResource("cameraBuffer").get());
+
+	const DynamicConstantBuffer::Layout& cameraBufferLayout = m_pCameraBuffer->GetData().GetLayout();
+	m_viewHandle = cameraBufferLayout.GetArrayHandle<DynamicConstantBuffer::ElementType::Matrix>("cameraBuffers", "view");
+	m_projectionHandle = cameraBufferLayout.GetArrayHandle<DynamicConstantBuffer::ElementType::Matrix>("cameraBuffers", "projection");
 }
 
 DirectX::XMMATRIX CameraBase::GetViewMatrix() const
@@ -310,12 +314,11 @@ void Camera::UpdateCameraBuffer()
 		return;
 
 	DynamicConstantBuffer::Data& bufferData = m_pCameraBuffer->GetData();
-	DynamicConstantBuffer::ArrayData array = bufferData.GetArrayData("cameraBuffers");
 
 	m_frustum.Update(m_view * m_perspective);
 
-	*array.Get<DynamicConstantBuffer::ElementType::Matrix>(m_cameraIndex, "view") = GetViewMatrix();
-	*array.Get<DynamicConstantBuffer::ElementType::Matrix>(m_cameraIndex, "projection") = GetPerspectiveMatrix();
+	*bufferData.Get(m_viewHandle, m_cameraIndex) = GetViewMatrix();
+	*bufferData.Get(m_projectionHandle, m_cameraIndex) = GetPerspectiveMatrix();
 }
 
 void Camera::DrawTransformPropeties(Scene& scene)
@@ -416,6 +419,27 @@ bool Camera::IsActive() const
 	return m_active;
 }
 
+void Camera::SetView(DirectX::XMFLOAT3 position, float pitch, float yaw)
+{
+	m_pitch = pitch;
+	m_yaw = yaw;
+
+	m_transform.SetEulerRotation(DirectX::XMFLOAT3{ m_pitch, m_yaw, 0.0f });
+	m_transform.SetPosition(position);
+
+	UpdateViewMatrix();
+}
+
+float Camera::GetPitch() const
+{
+	return m_pitch;
+}
+
+float Camera::GetYaw() const
+{
+	return m_yaw;
+}
+
 void Camera::UpdateDecoratedName()
 {
 	m_decoratedName = m_originalName;
@@ -542,7 +566,6 @@ void ShadowCamera::UpdateCameraBuffer()
 	m_transform.SetUpdated();
 
 	DynamicConstantBuffer::Data& bufferData = m_pCameraBuffer->GetData();
-	DynamicConstantBuffer::ArrayData array = bufferData.GetArrayData("cameraBuffers");
 
 	static constexpr float angle = DirectX::XM_PIDIV2;
 
@@ -575,8 +598,8 @@ void ShadowCamera::UpdateCameraBuffer()
 
 		m_frustumSides[i].Update(m_view* m_perspective); // also updating our CPU sided frustum
 
-		*array.Get<DynamicConstantBuffer::ElementType::Matrix>(m_cameraIndex + i, "view") = m_view;
-		*array.Get<DynamicConstantBuffer::ElementType::Matrix>(m_cameraIndex + i, "projection") = m_perspective;
+		*bufferData.Get(m_viewHandle, m_cameraIndex + i) = m_view;
+		*bufferData.Get(m_projectionHandle, m_cameraIndex + i) = m_perspective;
 	}
 	m_transform.SetUpdated();
 }
@@ -3,6 +3,7 @@
 #include "Includes/WRLNoWarnings.h"
 
 #include "Graphics/Core/OcclusionPrimitives.h"
+#include "Graphics/Data/DynamicConstantBuffer.h"
 
 #include "Scene/SceneObject.h"
 
@@ -56,6 +57,8 @@ protected:
 
 protected:
 	CachedConstantBuffer* m_pCameraBuffer = nullptr;
+	DynamicConstantBuffer::ArrayElementHandle<DynamicConstantBuffer::ElementType::Matrix> m_viewHandle = {};
+	DynamicConstantBuffer::ArrayElementHandle<DynamicConstantBuffer::ElementType::Matrix> m_projectionHandle = {};
 	unsigned int m_cameraIndex = -1;
 
 	DirectX::XMMATRIX m_perspective;
@@ -87,6 +90,12 @@ public:
 	void SetActive(bool active);
 	bool IsActive() const;
 
+	// places camera directly, used when camera is driven by recorded path instead of input
+	void SetView(DirectX::XMFLOAT3 position, float pitch, float yaw);
+
+	float GetPitch() const;
+	float GetYaw() const;
+
 	virtual void UpdateDecoratedName() override;
 
 private:
@@ -5,6 +5,7 @@
 #include "Graphics/Resources/GraphicsTexture.h"
 
 #include "Graphics/Core/OcclusionPrimitives.h"
+#include "Graphics/Core/OcclusionCuller.h"
 #include "Graphics/Data/DynamicVertex.h"
 #include "Graphics/Data/DynamicConstantBuffer.h"
 
@@ -127,6 +128,45 @@ void HandleIndiceData(Graphics& graphics, RenderGraphicsGeometryStep& step, aiMe
 	step.SetIndexBufferEntry(IndexBufferEntry::GetResource(graphics, ibName, std::move(indices)));
 }
 
+void HandleOccluderData(RenderGraphicsGeometryStep& step, aiMesh* mesh, float scale, const MaterialProperties::MaterialProperties& materialProperties)
+{
+	// see-through surfaces can't hide anything
+	if (materialProperties.twoSided || materialProperties.opacity < 1.0f)
+		return;
+
+	OccluderMesh fullMesh;
+
+	fullMesh.positions.reserve(mesh->mNumVertices);
+	for (size_t vertexIndex = 0; vertexIndex < mesh->mNumVertices; vertexIndex++)
+		fullMesh.positions.push_back({ mesh->mVertices[vertexIndex].x * scale, mesh->mVertices[vertexIndex].y * scale, mesh->mVertices[vertexIndex].z * scale });
+
+	fullMesh.indices.reserve(mesh->mNumFaces * 3);
+	for (size_t faceIndex = 0; faceIndex < mesh->mNumFaces; faceIndex++)
+	{
+		const aiFace& face = mesh->mFaces[faceIndex];
+
+		if (face.mNumIndices != 3)
+			continue;
+
+		fullMesh.indices.insert(fullMesh.indices.end(), face.mIndices, face.mIndices + 3);
+	}
+
+	std::shared_ptr<OccluderMesh> occluderMesh;
+
+	// dense meshes are too expensive to rasterize on CPU, the largest ones are usually the best occluders so they get simplified proxy.
+	// Meshes that can't be simplified without covering more than themselves don't occlude anything
+	if (fullMesh.indices.size() / 3 <= OcclusionCuller::maxOccluderTriangles)
+		occluderMesh = std::make_shared<OccluderMesh>(std::move(fullMesh));
+	else if (std::optional<OccluderMesh> simplifiedMesh = OcclusionCuller::CreateSimplifiedOccluder(fullMesh.positions, fullMesh.indices))
+		occluderMesh = std::make_shared<OccluderMesh>(std::move(*simplifiedMesh));
+	else
+		return;
+
+	occluderMesh->boundingBox = step.GetBoundingBox();
+
+	step.SetOccluderMesh(std::move(occluderMesh));
+}
+
 Model::Model(Graphics& graphics, Model* pParent, aiNode* node, std::vector<std::pair<aiMesh*, std::shared_ptr<Material>>> modelMeshes, float scale, DirectX::XMFLOAT3 position)
 	:
 	SceneObject(pParent)
@@ -154,6 +194,8 @@ Model::Model(Graphics& graphics, Model* pParent, aiNode* node, std::vector<std::
 
 			HandleIndiceData(graphics, step, mesh);
 
+			HandleOccluderData(step, mesh, scale, materialPropeties);
+
 			step.SetMaterial(material);
 
 			step.AddBindable(PrimitiveTechnology::GetResource(graphics, D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE));
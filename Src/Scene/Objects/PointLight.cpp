@@ -40,6 +40,12 @@ void PointLight::Initialize(Graphics& graphics, Pipeline& pipeline)
 	m_pLightBuffer = static_cast<CachedConstantBuffer*>(pipeline.GetStaticResource("lightBuffer").get());
 
 	DynamicConstantBuffer::Data& bufferData = m_pLightBuffer->GetData();
+	m_lightPositionHandle = bufferData.GetLayout().GetArrayHandle<DynamicConstantBuffer::ElementType::Float3>("lightBuffers", "lightPosition");
+	m_diffuseColorHandle = bufferData.GetLayout().GetArrayHandle<DynamicConstantBuffer::ElementType::Float3>("lightBuffers", "diffuseColor");
+	m_attenuationQuadraticHandle = bufferData.GetLayout().GetArrayHandle<DynamicConstantBuffer::ElementType::Float>("lightBuffers", "attenuationQuadratic");
+	m_attenuationLinearHandle = bufferData.GetLayout().GetArrayHandle<DynamicConstantBuffer::ElementType::Float>("lightBuffers", "attenuationLinear");
+	m_attenuationConstantHandle = bufferData.GetLayout().GetArrayHandle<DynamicConstantBuffer::ElementType::Float>("lightBuffers", "attenuationConstant");
+
 	DynamicConstantBuffer::ArrayData array = bufferData.GetArrayData("lightBuffers");
 	*array.Get<DynamicConstantBuffer::ElementType::Float3>(m_lightIndex, "diffuseColor") = m_color;
 	*array.Get<DynamicConstantBuffer::ElementType::Float>(m_lightIndex, "attenuationQuadratic") = 0.2f;
@@ -71,9 +77,7 @@ void PointLight::UpdateLight(Graphics& graphics, Scene& scene)
 
 		DirectX::XMStoreFloat3(&resultPosition, vResultPosition);
 
-		DynamicConstantBuffer::Data& bufferData = m_pLightBuffer->GetData();
-		DynamicConstantBuffer::ArrayData array = bufferData.GetArrayData("lightBuffers");
-		*array.Get<DynamicConstantBuffer::ElementType::Float3>(m_lightIndex, "lightPosition") = resultPosition;
+		*m_pLightBuffer->GetData().Get(m_lightPositionHandle, m_lightIndex) = resultPosition;
 	}
 }
 
@@ -132,4 +136,38 @@ void PointLight::SetLightIndex(unsigned int lightIndex)
 ShadowCamera* PointLight::GetShadowCamera()
 {
 	return &m_shadowCamera;
+}
+
+unsigned int PointLight::GetLightIndex() const
+{
+	return m_lightIndex;
+}
+
+float PointLight::GetRange() const
+{
+	// light is cut off where it gets dimmer than one step of 8 bit color
+	static constexpr float cutoffIntensity = 1.0f / 256.0f;
+
+	const DynamicConstantBuffer::Data& bufferData = m_pLightBuffer->GetData();
+
+	DirectX::XMFLOAT3 color = *bufferData.Get(m_diffuseColorHandle, m_lightIndex);
+	float quadratic = *bufferData.Get(m_attenuationQuadraticHandle, m_lightIndex);
+	float linear = *bufferData.Get(m_attenuationLinearHandle, m_lightIndex);
+	float constant = *bufferData.Get(m_attenuationConstantHandle, m_lightIndex);
+
+	// solving constant + linear * d + quadratic * d^2 = maxColor / cutoffIntensity
+	float attenuationAtRange = std::max(color.x, std::max(color.y, color.z)) / cutoffIntensity;
+
+	if (quadratic > 0.0f)
+		return (-linear + std::sqrt(linear * linear - 4.0f * quadratic * (constant - attenuationAtRange))) / (2.0f * quadratic);
+
+	if (linear > 0.0f)
+		return std::max(attenuationAtRange - constant, 0.0f) / linear;
+
+	return m_shadowCamera.GetSettings()->FarZ;
+}
+
+DirectX::XMFLOAT3 PointLight::GetPositionInCameraSpace() const
+{
+	return *m_pLightBuffer->GetData().Get(m_lightPositionHandle, m_lightIndex);
 }
\ No newline at end of file
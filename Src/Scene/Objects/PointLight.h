@@ -12,6 +12,10 @@ class Pipeline;
 
 class PointLight : public SceneObject
 {
+public:
+	// light buffer elements holding rects of shadow cube faces in shadow atlas
+	static constexpr const char* shadowFaceNames[6] = { "shadowFace0", "shadowFace1", "shadowFace2", "shadowFace3", "shadowFace4", "shadowFace5" };
+
 public:
 	PointLight(Graphics& graphics, Scene& scene, DirectX::XMFLOAT3 position = {-1.5f, 1.0f, -1.5f}, DirectX::XMFLOAT3 color = { 1.0f, 1.0f, 1.0f });
 
@@ -32,6 +36,14 @@ public:
 
 	ShadowCamera* GetShadowCamera();
 
+	unsigned int GetLightIndex() const;
+
+	// distance at which light's contribution becomes invisible, decided by its attenuation
+	float GetRange() const;
+
+	// position written to light buffer during last UpdateLight()
+	DirectX::XMFLOAT3 GetPositionInCameraSpace() const;
+
 private:
 	DirectX::XMFLOAT3 m_color;
 	
@@ -40,6 +52,11 @@ private:
 	ShadowCamera m_shadowCamera;
 
 	CachedConstantBuffer* m_pLightBuffer = nullptr;
+	DynamicConstantBuffer::ArrayElementHandle<DynamicConstantBuffer::ElementType::Float3> m_lightPositionHandle = {};
+	DynamicConstantBuffer::ArrayElementHandle<DynamicConstantBuffer::ElementType::Float3> m_diffuseColorHandle = {};
+	DynamicConstantBuffer::ArrayElementHandle<DynamicConstantBuffer::ElementType::Float> m_attenuationQuadraticHandle = {};
+	DynamicConstantBuffer::ArrayElementHandle<DynamicConstantBuffer::ElementType::Float> m_attenuationLinearHandle = {};
+	DynamicConstantBuffer::ArrayElementHandle<DynamicConstantBuffer::ElementType::Float> m_attenuationConstantHandle = {};
 	unsigned int m_lightIndex = -1;
 };
 
@@ -12,6 +12,10 @@
 #include <imgui.h>
 
 #include "Graphics/Core/Pix.h"
+#include "Graphics/Profiler/MemoryTracker.h"
+
+// NUM_CAMERAS in VS.hlsl, the whole 64KB constant buffer. Every point light takes 6 cameras
+static constexpr unsigned int maxCameras = 512;
 
 void Scene::AddSceneObjectFromFile(Graphics& graphics, const char* path, float scale)
 {
@@ -93,6 +97,8 @@ void Scene::FinishInitialization(Graphics& graphics)
 
 void Scene::InitializeCameraBuffer(Graphics& graphics, Pipeline& pipeline)
 {
+	THROW_INTERNAL_ERROR_IF("Scene has more cameras than camera buffer in shaders can hold", m_cameraBufferSize > maxCameras);
+
 	DynamicConstantBuffer::ArrayDataInfo array = {};
 	array.numElements = m_cameraBufferSize;
 	array.layout.Add<DynamicConstantBuffer::ElementType::Matrix>("view");
@@ -120,6 +126,10 @@ void Scene::InitializeLightBuffer(Graphics& graphics, Pipeline& pipeline)
 	array.layout.Add<DynamicConstantBuffer::ElementType::Float>("nearZ", DynamicConstantBuffer::ImguiFloatData{ false });
 	array.layout.Add<DynamicConstantBuffer::ElementType::Float>("farZ", DynamicConstantBuffer::ImguiFloatData{ false });
 
+	// rects of cube faces in shadow atlas, written by ShadowPass. Zero sized rect means light has no shadows
+	for (const char* shadowFaceName : PointLight::shadowFaceNames)
+		array.layout.Add<DynamicConstantBuffer::ElementType::Float4>(shadowFaceName, DynamicConstantBuffer::ImguiColorData{ false });
+
 	DynamicConstantBuffer::Layout layout;
 	layout.AddArray("lightBuffers", array);
 
@@ -136,11 +146,16 @@ void Scene::InitializeTransformBuffer(Graphics& graphics, Pipeline& pipeline)
 
 	DynamicConstantBuffer::ArrayDataInfo array = {};
 	array.numElements = numElements;
-	array.layout.Add<DynamicConstantBuffer::ElementType::Matrix>("transform");
+	// affine transform stored as 3x4 transposed matrix, last column is always (0, 0, 0, 1)
+	array.layout.Add<DynamicConstantBuffer::ElementType::Float4>("row0");
+	array.layout.Add<DynamicConstantBuffer::ElementType::Float4>("row1");
+	array.layout.Add<DynamicConstantBuffer::ElementType::Float4>("row2");
 
 	DynamicConstantBuffer::Layout layout;
 	layout.AddArray("transforms", array);
 
+	MemoryOwnerScope ownerScope("Scene transforms");
+
 	m_transformBuffer = std::make_shared<Buffer>(graphics, numElements, layout, ResourceTargets{{ShaderVisibilityGraphic::VertexShader, 0}});
 
 	pipeline.AddStaticResource("transformBuffer", m_transformBuffer);
@@ -161,26 +176,52 @@ void Scene::ResizeTransformBufferIfNeeded(Graphics& graphics)
 	{
 		prevSceneObjectNum = sceneObjectNum;
 
-		m_transformBuffer->Resize(graphics, sceneObjectNum * sizeof(DirectX::XMMATRIX));
+		MemoryOwnerScope ownerScope("Scene transforms");
+
+		m_transformBuffer->Resize(graphics, sceneObjectNum * sizeof(DirectX::XMFLOAT3X4));
 	}
 }
 
 void Scene::UpdateTransformBuffer(Graphics& graphics)
 {
-	static std::vector<DirectX::XMMATRIX> m_currentFrameMatrices(m_sceneObjects.size(), {});
+	constexpr size_t transformSize = sizeof(DirectX::XMFLOAT3X4);
 
-	if (m_currentFrameMatrices.size() != m_sceneObjects.size())
-		m_currentFrameMatrices.resize(m_sceneObjects.size());
+	// scene indices are assigned in AddSceneObject, growing scene could reallocate the buffer so everything is reuploaded then
+	bool uploadAll = m_transformData.size() != m_sceneObjects.size();
 
-	for (size_t i = 0; i < m_sceneObjects.size(); i++)
-	{
-		auto& sceneObject = m_sceneObjects.at(i);
+	if (uploadAll)
+		m_transformData.resize(m_sceneObjects.size());
+
+	m_transformDirtyRanges.clear();
 
-		sceneObject->SetSceneIndex(i);
-		m_currentFrameMatrices.at(i) = m_sceneObjects.at(i)->GetTransform()->GetWorldTransform();
+	auto writeTransform = [&](unsigned int sceneIndex)
+		{
+			DirectX::XMStoreFloat3x4(&m_transformData.at(sceneIndex), m_sceneObjects.at(sceneIndex)->GetTransform()->GetWorldTransform());
+
+			size_t offset = sceneIndex * transformSize;
+
+			if (!m_transformDirtyRanges.empty() && m_transformDirtyRanges.back().GetEnd() == offset)
+				m_transformDirtyRanges.back().size += transformSize;
+			else
+				m_transformDirtyRanges.push_back({ offset, transformSize });
+		};
+
+	if (uploadAll)
+	{
+		for (unsigned int sceneIndex = 0; sceneIndex < m_sceneObjects.size(); sceneIndex++)
+			writeTransform(sceneIndex);
 	}
+	else
+	{
+		// changed transforms are sorted, so neighbouring objects end up in one range
+		for (unsigned int sceneIndex : m_transformHierarchy.GetChangedTransforms())
+			writeTransform(sceneIndex);
+	}
+
+	if (m_transformDirtyRanges.empty())
+		return;
 
-	m_transformBuffer->Update(graphics, m_currentFrameMatrices.data(), m_currentFrameMatrices.size() * sizeof(m_currentFrameMatrices.front()));
+	m_transformBuffer->Update(graphics, m_transformData.data(), m_transformDirtyRanges);
 }
 
 void Scene::AssignJobs(Graphics& graphics)
@@ -262,6 +303,71 @@ void Scene::DrawObjectInspector(Graphics& graphics)
 
 	ImGui::End();
 
+	if (ImGui::Begin("Benchmarks"))
+	{
+		if (ImGui::Button("Transform hierarchy (100k nodes)"))
+			m_transformBenchmarkResult = TransformHierarchy::Benchmark(graphics.GetJobSystem(), 100000);
+
+		const TransformHierarchy::BenchmarkResult& result = m_transformBenchmarkResult;
+
+		if (result.numNodes != 0)
+		{
+			ImGui::Text("Nodes: %u, threads: %u, median of %u runs", result.numNodes, result.numThreads, result.numIterations);
+			ImGui::Text("Rebuild: %.3f ms", result.rebuildMs);
+			ImGui::Text("Full update: %.3f ms", result.fullUpdateMs);
+			ImGui::Text("1%% changed: %.3f ms", result.partialUpdateMs);
+			ImGui::Text("No changes: %.3f ms", result.staticUpdateMs);
+		}
+
+		ImGui::Separator();
+
+		if (ImGui::Button("Light clusters (1024 lights)"))
+			m_lightClustersBenchmarkResult = LightClusters::Benchmark(graphics.GetJobSystem(), 1024);
+
+		ImGui::SameLine();
+
+		if (ImGui::Button("Light clusters (4096 lights)"))
+			m_lightClustersBenchmarkResult = LightClusters::Benchmark(graphics.GetJobSystem(), 4096);
+
+		const LightClusters::BenchmarkResult& clustersResult = m_lightClustersBenchmarkResult;
+
+		if (clustersResult.numLights != 0)
+		{
+			ImGui::Text("Lights: %u, clusters: %u, threads: %u", clustersResult.numLights, clustersResult.numClusters, clustersResult.numThreads);
+			ImGui::Text("Light indices: %u", clustersResult.numLightIndices);
+			ImGui::Text("Single thread: %.3f ms", clustersResult.singleThreadMs);
+			ImGui::Text("Job system: %.3f ms", clustersResult.parallelMs);
+			ImGui::Text("Brute force: %.3f ms", clustersResult.bruteForceMs);
+		}
+
+		ImGui::Separator();
+
+		ImGui::Checkbox("Occlusion culling", &m_occlusionCullingEnabled);
+
+		if (m_occlusionCullingEnabled)
+		{
+			const OcclusionCuller::Stats& stats = m_occlusionCuller.GetStats();
+
+			ImGui::Text("Occluders: %u, triangles: %u", stats.numOccluders, stats.numTriangles);
+			ImGui::Text("Occluded: %u of %u tested", stats.numOccluded, stats.numTested);
+		}
+
+		if (ImGui::Button("Occlusion culling (128 walls, 10k boxes)"))
+			m_occlusionBenchmarkResult = OcclusionCuller::Benchmark(128, 10000);
+
+		const OcclusionCuller::BenchmarkResult& occlusionResult = m_occlusionBenchmarkResult;
+
+		if (occlusionResult.numCandidates != 0)
+		{
+			ImGui::Text("Occluders: %u, triangles: %u", occlusionResult.numOccluders, occlusionResult.numTriangles);
+			ImGui::Text("Occluded: %u of %u", occlusionResult.numOccluded, occlusionResult.numCandidates);
+			ImGui::Text("Rasterization: %.3f ms", occlusionResult.rasterizeMs);
+			ImGui::Text("Tests: %.3f ms", occlusionResult.testMs);
+		}
+	}
+
+	ImGui::End();
+
 	END_CPU_EVENT();
 }
 
@@ -290,14 +396,13 @@ void Scene::Update(Graphics& graphics, const Input& input, bool isCursorLocked)
 	for (auto& sceneObject : m_sceneObjects)
 		sceneObject->InternalUpdate(graphics, graphics.GetRenderer().GetPipeline());
 
-	for (const auto& [key, material] : m_materials)
-		material->Update();
-
 	ResizeTransformBufferIfNeeded(graphics);
 
 	UpdateGraphicResources(graphics);
 
+	START_CPU_EVENT(PIX_COLOR(0, 0, 255), "Buffer upload");
 	UpdateBuffersIfNeeded(graphics);
+	END_CPU_EVENT();
 
 	// Updating passes
 	graphics.GetRenderer().UpdatePasses(graphics, *this);
@@ -306,23 +411,35 @@ void Scene::Update(Graphics& graphics, const Input& input, bool isCursorLocked)
 
 	UpdateObjectMatrices(graphics);
 
+	START_CPU_EVENT(PIX_COLOR(0, 0, 255), "Culling");
 	UpdateVisibility();
+	END_CPU_EVENT();
 
 	END_CPU_EVENT();
 }
 
 void Scene::UpdateVisibility()
 {
-	auto HandleFrustum = [&](const auto& cameraFrustum, unsigned int cameraIndex)
+	auto HandleFrustum = [&](const auto& cameraFrustum, unsigned int cameraIndex, OcclusionCuller* occlusionCuller = nullptr)
 		{
-			auto& visibilityVector = m_visibilityData[cameraIndex];
+			CameraVisibility& cameraVisibility = m_visibilityData[cameraIndex];
+			auto& visibilityVector = cameraVisibility.visible;
+
+			cameraVisibility.changed = visibilityVector.size() != m_sceneObjects.size();
 			visibilityVector.resize(m_sceneObjects.size());
 
 			for (auto& sceneObject : m_sceneObjects)
 			{
 				bool visible = cameraFrustum.HasInside(sceneObject->GetBoundingBox() + sceneObject->GetTransform()->GetWorldPosition());
 
-				visibilityVector.at(sceneObject->GetSceneIndex()) = visible;
+				if (visible && occlusionCuller != nullptr)
+					visible = occlusionCuller->IsVisible(sceneObject->GetBoundingBox(), sceneObject->GetTransform()->GetWorldTransform());
+
+				if (visibilityVector.at(sceneObject->GetSceneIndex()) != visible)
+				{
+					visibilityVector.at(sceneObject->GetSceneIndex()) = visible;
+					cameraVisibility.changed = true;
+				}
 			}
 		};
 
@@ -339,46 +456,64 @@ void Scene::UpdateVisibility()
 		{
 			Camera* camera = static_cast<Camera*>(cameraBase);
 
-			if(camera->IsActive())
-				HandleFrustum(camera->GetFrustum(), camera->GetCameraIndex());
+			if (camera->IsActive())
+			{
+				if (m_occlusionCullingEnabled)
+				{
+					RasterizeOccluders(camera);
+
+					HandleFrustum(camera->GetFrustum(), camera->GetCameraIndex(), &m_occlusionCuller);
+				}
+				else
+				{
+					HandleFrustum(camera->GetFrustum(), camera->GetCameraIndex());
+				}
+			}
 		}
 	}
 }
 
+void Scene::SetOcclusionCullingEnabled(bool enabled)
+{
+	m_occlusionCullingEnabled = enabled;
+}
+
 bool Scene::IsVisible(unsigned int cameraIndex, unsigned int sceneIndex)
 {
 	auto found = m_visibilityData.find(cameraIndex);
 
 	THROW_INTERNAL_ERROR_IF("Tried to use invalid camera index", found == m_visibilityData.end());
 
-	const auto& visibilityVector = found->second;
+	const auto& visibilityVector = found->second.visible;
 
 	THROW_INTERNAL_ERROR_IF("Tried to use invalid scene object index", visibilityVector.size() < sceneIndex);
 
 	return visibilityVector.at(sceneIndex);
 }
 
-void Scene::UpdateBuffersIfNeeded(Graphics& graphics)
+bool Scene::VisibilityChanged(unsigned int cameraIndex) const
 {
-	{	
-		//bool lightBufferShouldUpdate = false;
-		//for (const auto& light : m_pointlights)
-		//	if (light->BufferChanged();)
-		//		lightBufferShouldUpdate = true;
-		//
-		//if (lightBufferShouldUpdate)
-			m_lightBuffer->Update(graphics);
-	}
+	auto found = m_visibilityData.find(cameraIndex);
 
-	{
-		bool cameraBufferShouldUpdate = false;
-		for (const auto& camera : m_cameras)
-			if (camera->ViewChanged() || camera->PerspectiveChanged())
-				cameraBufferShouldUpdate = true;
+	THROW_INTERNAL_ERROR_IF("Tried to use invalid camera index", found == m_visibilityData.end());
 
-		if (cameraBufferShouldUpdate)
-			m_cameraBuffer->Update(graphics);
-	}
+	return found->second.changed;
+}
+
+const std::vector<unsigned int>& Scene::GetChangedTransforms() const
+{
+	return m_transformHierarchy.GetChangedTransforms();
+}
+
+void Scene::UpdateBuffersIfNeeded(Graphics& graphics)
+{
+	// lights write their data through handles, so buffer knows which ranges changed
+	if (m_lightBuffer->IsDirty())
+		m_lightBuffer->Update(graphics);
+
+	// only matrices of cameras that changed are marked as dirty
+	if (m_cameraBuffer->IsDirty())
+		m_cameraBuffer->Update(graphics);
 }
 
 void Scene::InitializeNewObjects(Graphics& graphics)
@@ -482,16 +617,62 @@ unsigned int Scene::GetOriginalNameIndex(std::string name)
 
 void Scene::UpdateObjectMatrices(Graphics& graphics)
 {
-	// calculating transform matrix for each object that needs it
-	for (auto& sceneObject : m_sceneObjects)
-		sceneObject->UpdateLocalTransformIfNeeded();
+	// hierarchy layout changes only when objects are added
+	if (m_transformHierarchy.GetNumNodes() != m_sceneObjects.size())
+		RebuildTransformHierarchy(graphics);
 
-	// passing calculated matrix down the object hierarchy
-	for (auto& sceneObject : m_sceneObjects)
-		if (!sceneObject->isChild())
-			sceneObject->UpdateParentMatrix();
+	START_CPU_EVENT(PIX_COLOR(0, 0, 255), "Transforms");
+	m_transformHierarchy.Update(graphics.GetJobSystem());
+	END_CPU_EVENT();
 
+	START_CPU_EVENT(PIX_COLOR(0, 0, 255), "Transform upload");
 	UpdateTransformBuffer(graphics);
+	END_CPU_EVENT();
+}
+
+void Scene::RebuildTransformHierarchy(Graphics& graphics)
+{
+	std::vector<ObjectTransform*> transforms(m_sceneObjects.size(), nullptr);
+	std::vector<int> parentIndices(m_sceneObjects.size(), -1);
+
+	for (unsigned int sceneIndex = 0; sceneIndex < m_sceneObjects.size(); sceneIndex++)
+	{
+		SceneObject* sceneObject = m_sceneObjects.at(sceneIndex).get();
+
+		transforms.at(sceneIndex) = sceneObject->GetTransform();
+
+		for (SceneObject* child : sceneObject->GetChildren())
+			parentIndices.at(child->GetSceneIndex()) = int(sceneIndex);
+	}
+
+	m_transformHierarchy.Rebuild(transforms, parentIndices, graphics.GetJobSystem().GetNumThreads());
+}
+
+void Scene::RasterizeOccluders(Camera* camera)
+{
+	START_CPU_EVENT(PIX_COLOR(0, 0, 255), "Rasterize occluders");
+
+	m_occlusionCuller.BeginFrame(camera->GetViewMatrix() * camera->GetPerspectiveMatrix());
+
+	const Frustum& frustum = camera->GetFrustum();
+
+	for (auto& sceneObject : m_sceneObjects)
+	{
+		if (!frustum.HasInside(sceneObject->GetBoundingBox() + sceneObject->GetTransform()->GetWorldPosition()))
+			continue;
+
+		DirectX::XMMATRIX world = sceneObject->GetTransform()->GetWorldTransform();
+
+		for (auto& mesh : sceneObject->GetMeshes())
+			for (auto& technique : mesh.GetTechniques())
+				for (auto& step : technique.GetSteps())
+					if (const OccluderMesh* occluderMesh = step.GetOccluderMesh())
+						m_occlusionCuller.AddOccluder(occluderMesh, world);
+	}
+
+	m_occlusionCuller.RasterizeOccluders();
+
+	END_CPU_EVENT();
 }
 
 void Scene::m_SetActiveCamera(Camera* camera)
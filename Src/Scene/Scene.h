@@ -4,7 +4,10 @@
 #include "Graphics/Imgui/ImguiLayer.h"
 
 #include "Material.h"
+#include "TransformHierarchy.h"
 #include "Graphics/Bindables/ConstantBuffer.h"
+#include "Graphics/RenderGraph/LightClusters.h"
+#include "Graphics/Core/OcclusionCuller.h"
 
 class Input;
 class Graphics;
@@ -59,8 +62,16 @@ public:
 
 	void UpdateVisibility();
 
+	void SetOcclusionCullingEnabled(bool enabled);
+
 	bool IsVisible(unsigned int cameraIndex, unsigned int sceneIndex);
 
+	// true when any object entered or left camera's frustum during last visibility update
+	bool VisibilityChanged(unsigned int cameraIndex) const;
+
+	// scene indices of objects which world transforms changed this frame, sorted
+	const std::vector<unsigned int>& GetChangedTransforms() const;
+
 private:
 	void UpdateBuffersIfNeeded(Graphics& graphics);
 
@@ -84,6 +95,11 @@ private:
 
 	void UpdateObjectMatrices(Graphics& graphics);
 
+	void RebuildTransformHierarchy(Graphics& graphics);
+
+	// fills occlusion buffer with occluders of objects inside of camera's frustum
+	void RasterizeOccluders(Camera* camera);
+
 	void m_SetActiveCamera(Camera* camera);
 
 	void AddCamera(SceneObject* pSceneObject);
@@ -101,12 +117,28 @@ private:
 	Camera* m_activeCamera = nullptr;
 	unsigned int m_cameraBufferSize = 0;
 
-	std::unordered_map<unsigned int, std::vector<bool>> m_visibilityData; // mapping: cameraID -> vector of bools, bool for each SceneObject
+	struct CameraVisibility
+	{
+		std::vector<bool> visible; // bool for each SceneObject
+		bool changed = true;
+	};
+
+	std::unordered_map<unsigned int, CameraVisibility> m_visibilityData; // mapping: cameraID -> visibility of SceneObjects
 
 	std::vector<PointLight*> m_pointlights;
 	std::shared_ptr<CachedConstantBuffer> m_lightBuffer;
 	std::shared_ptr<CachedConstantBuffer> m_cameraBuffer;
+	TransformHierarchy m_transformHierarchy;
+	TransformHierarchy::BenchmarkResult m_transformBenchmarkResult;
+	LightClusters::BenchmarkResult m_lightClustersBenchmarkResult;
+	OcclusionCuller::BenchmarkResult m_occlusionBenchmarkResult;
+
+	OcclusionCuller m_occlusionCuller;
+	bool m_occlusionCullingEnabled = true;
+
 	std::shared_ptr<Buffer> m_transformBuffer;
+	std::vector<DirectX::XMFLOAT3X4> m_transformData; // CPU copy of transform buffer, affine matrices stored transposed
+	std::vector<DataRange> m_transformDirtyRanges;
 
 	std::unordered_map<std::string, std::shared_ptr<Material>> m_materials;
 };
\ No newline at end of file
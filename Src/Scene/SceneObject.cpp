@@ -28,31 +28,12 @@ void SceneObject::InternalInitialize(Graphics& graphics, Pipeline& pipeline)
 		return;
 	m_initialized = true;
 
-	// initializing modelSceneIndex
-	{
-		DynamicConstantBuffer::Layout layout;
-		layout.Add<DynamicConstantBuffer::ElementType::Uint>("modelSceneIndex");
-
-		layout.GetFinished(DynamicConstantBuffer::Layout::LayoutType::data);
-
-		DynamicConstantBuffer::Data bufferData(layout);
-		*bufferData.Get<DynamicConstantBuffer::ElementType::Uint>("modelSceneIndex") = m_sceneIndex;
-
-		m_sceneIndexConstant = std::make_shared<RootSignatureConstants>(bufferData, ResourceTargets{{ShaderVisibilityGraphic::VertexShader, 3}});
-	}
-
+	// scene index isn't bound per object, geometry passes write it to their instance buffers
 	Initialize(graphics, pipeline);
 
 	for (auto& mesh : m_meshes)
 		mesh.Initialize(graphics, pipeline);
 
-	// adding modelSceneIndex bind to all meshe's steps
-	// specificly after mesh.Initialize() since meshes create implicit techniques there
-	for (auto& mesh : m_meshes)
-		for (auto& technique : mesh.GetTechniques())
-			for (auto& step : technique.GetSteps())
-				step.AddBindable(m_sceneIndexConstant);
-
 	UpdateBoundingBox();
 }
 
@@ -72,19 +53,6 @@ void SceneObject::InternalAddStaticResources(Pipeline& pipeline)
 	AddStaticResources(pipeline);
 }
 
-void SceneObject::UpdateParentMatrix(DirectX::XMMATRIX parentMatrix)
-{
-	m_transform.SetParentTransform(parentMatrix);
-
-	for (auto& child : m_children)
-		child->UpdateParentMatrix(m_transform.GetWorldTransform());
-}
-
-void SceneObject::UpdateLocalTransformIfNeeded()
-{
-	m_transform.UpdateLocalTransformIfNeeded();
-}
-
 void SceneObject::Initialize(Graphics& graphics, Pipeline& pipeline)
 {
 
@@ -269,11 +237,21 @@ ObjectTransform* SceneObject::GetTransform()
 	return &m_transform;
 }
 
+const std::vector<SceneObject*>& SceneObject::GetChildren() const
+{
+	return m_children;
+}
+
 const BoundingBox& SceneObject::GetBoundingBox() const
 {
 	return m_boundingBox;
 }
 
+std::vector<Mesh>& SceneObject::GetMeshes()
+{
+	return m_meshes;
+}
+
 void SceneObject::SetSceneIndex(unsigned int sceneIndex)
 {
 	m_sceneIndex = sceneIndex;
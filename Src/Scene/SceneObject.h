@@ -33,10 +33,6 @@ public:
 
 	void InternalAddStaticResources(Pipeline& pipeline);
 
-	void UpdateParentMatrix(DirectX::XMMATRIX parentMatrix = DirectX::XMMatrixIdentity());
-
-	void UpdateLocalTransformIfNeeded();
-
 protected:
 	void UpdateBoundingBox();
 
@@ -76,8 +72,12 @@ protected:
 public:
 	ObjectTransform* GetTransform();
 
+	const std::vector<SceneObject*>& GetChildren() const;
+
 	const BoundingBox& GetBoundingBox() const;
 
+	std::vector<Mesh>& GetMeshes();
+
 	void SetSceneIndex(unsigned int sceneIndex);
 	unsigned int GetSceneIndex();
 
@@ -111,5 +111,4 @@ protected:
 	bool m_initialized = false;
 
 	unsigned int m_sceneIndex = 0;
-	std::shared_ptr<RootSignatureConstants> m_sceneIndexConstant;
 };
\ No newline at end of file
@@ -0,0 +1,296 @@
+#include "SyntheticScene.h"
+
+#include "Macros/ErrorMacros.h"
+
+#include "Graphics/Core/Graphics.h"
+#include "Graphics/Profiler/ZoneProfiler.h"
+#include "Graphics/Profiler/RenderStats.h"
+#include "Graphics/Profiler/MemoryTracker.h"
+#include "Graphics/RenderGraph/RenderJob/RenderGraphicsGeometryJob.h"
+#include "Graphics/RenderGraph/RenderPass/Geometry/GeometryPass.h"
+
+#include "System/Input.h"
+
+#include "Scene.h"
+#include "Material.h"
+#include "Objects/Box.h"
+#include "Objects/Camera.h"
+#include "Objects/PointLight.h"
+
+void SyntheticScene::Generate(Graphics& graphics, Scene& scene, const Params& params)
+{
+	THROW_INTERNAL_ERROR_IF("Synthetic scene needs at least one material", params.numMaterials == 0);
+
+	std::mt19937 randomEngine(params.seed);
+	std::uniform_real_distribution<float> unitDistribution(0.0f, 1.0f);
+	std::uniform_int_distribution<unsigned int> materialDistribution(0, params.numMaterials - 1);
+
+	auto getRandom = [&]()
+		{
+			return unitDistribution(randomEngine);
+		};
+
+	// materials without maps, so nothing has to be loaded from disk
+	std::vector<std::shared_ptr<Material>> materials;
+	materials.reserve(params.numMaterials);
+
+	for (unsigned int materialIndex = 0; materialIndex < params.numMaterials; materialIndex++)
+	{
+		MaterialProperties::MaterialProperties properties;
+		properties.albedo = { getRandom(), getRandom(), getRandom() };
+		properties.metalness = getRandom();
+		properties.roughness = 0.1f + getRandom() * 0.9f;
+
+		std::shared_ptr<Material> material = std::make_shared<Material>(graphics, "", properties);
+		materials.push_back(material);
+
+		scene.AddMaterial("Synthetic@Material" + std::to_string(materialIndex), std::move(material));
+	}
+
+	// objects are grouped into trees where node k is child of node (k - 1) / 2, so tree of depth d has 2^d - 1 nodes
+	unsigned int hierarchyDepth = std::clamp(params.hierarchyDepth, 1u, 16u);
+	unsigned int nodesPerTree = (1u << hierarchyDepth) - 1;
+	unsigned int numTrees = (params.numObjects + nodesPerTree - 1) / nodesPerTree;
+	unsigned int gridSize = std::max(1u, unsigned int(std::ceil(std::sqrt(float(numTrees)))));
+
+	constexpr float treeSpacing = 4.0f;
+	float gridExtent = float(gridSize) * treeSpacing;
+
+	m_movingObjects.clear();
+
+	std::vector<SceneObject*> treeNodes(nodesPerTree, nullptr);
+
+	for (unsigned int objectIndex = 0; objectIndex < params.numObjects; objectIndex++)
+	{
+		unsigned int treeIndex = objectIndex / nodesPerTree;
+		unsigned int treeNode = objectIndex % nodesPerTree;
+
+		SceneObject* pParent = nullptr;
+		DirectX::XMFLOAT3 position;
+
+		if (treeNode == 0)
+		{
+			position = { float(treeIndex % gridSize) * treeSpacing, 0.0f, float(treeIndex / gridSize) * treeSpacing };
+		}
+		else
+		{
+			// children are stacked above their parents, position is relative to parent
+			pParent = treeNodes.at((treeNode - 1) / 2);
+			position = { getRandom() * 2.0f - 1.0f, 1.5f, getRandom() * 2.0f - 1.0f };
+		}
+
+		std::shared_ptr<Box> box = std::make_shared<Box>(graphics, pParent, materials.at(materialDistribution(randomEngine)), position);
+		box->SetName("Box");
+
+		if (getRandom() < params.motionFraction)
+			m_movingObjects.push_back({ box->GetTransform(), position, getRandom() * DirectX::XM_2PI });
+
+		treeNodes.at(treeNode) = box.get();
+		scene.AddSceneObject(std::move(box));
+	}
+
+	for (unsigned int lightIndex = 0; lightIndex < params.numLights; lightIndex++)
+	{
+		DirectX::XMFLOAT3 position = { getRandom() * gridExtent, 3.0f + getRandom() * 2.0f, getRandom() * gridExtent };
+		DirectX::XMFLOAT3 color = { 0.5f + getRandom() * 0.5f, 0.5f + getRandom() * 0.5f, 0.5f + getRandom() * 0.5f };
+
+		scene.AddSceneObject(std::make_shared<PointLight>(graphics, scene, position, color));
+	}
+
+	// looking down at the grid from its front edge, so part of objects is outside of frustum
+	scene.AddSceneObject(std::make_shared<Camera>(graphics, DirectX::XMFLOAT3{ gridExtent * 0.5f, 10.0f, -10.0f }, DirectX::XMFLOAT3{ 0.5f, 0.0f, 0.0f }));
+}
+
+void SyntheticScene::Update(float time)
+{
+	for (const MovingObject& movingObject : m_movingObjects)
+	{
+		float movingTime = time + movingObject.phase;
+
+		movingObject.transform->SetPosition({ movingObject.basePosition.x, movingObject.basePosition.y + std::sin(movingTime) * 0.5f, movingObject.basePosition.z });
+		movingObject.transform->SetEulerRotation({ 0.0f, movingTime, 0.0f });
+	}
+}
+
+unsigned int SyntheticScene::GetNumMovingObjects() const
+{
+	return unsigned int(m_movingObjects.size());
+}
+
+SyntheticScene::BenchmarkResult SyntheticScene::Benchmark(const Params& params, unsigned int numFrames)
+{
+	using Clock = std::chrono::steady_clock;
+
+	auto getElapsedMs = [](Clock::time_point start)
+		{
+			return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+		};
+
+	constexpr unsigned int numWarmUpFrames = 8;
+	constexpr float deltaTime = 1.0f / 60.0f;
+
+	BenchmarkResult result = {};
+	result.params = params;
+	result.numFrames = numFrames;
+
+	Graphics graphics(1280, 720, DXGI_FORMAT_R8G8B8A8_UNORM);
+	Scene scene;
+	SyntheticScene syntheticScene;
+	Input input; // never receives events, so camera stays where it was placed
+
+	result.numThreads = graphics.GetJobSystem().GetNumThreads();
+
+	bool drawPacketsEnabled = RenderGraphicsGeometryJob::AreDrawPacketsEnabled();
+	RenderGraphicsGeometryJob::SetDrawPacketsEnabled(params.drawPackets);
+
+	bool instancingEnabled = GeometryPass::IsInstancingEnabled();
+	GeometryPass::SetInstancingEnabled(params.instancing);
+
+	Clock::time_point start = Clock::now();
+	scene.BeginInitialization(graphics);
+	syntheticScene.Generate(graphics, scene, params);
+	result.generationMs = getElapsedMs(start);
+
+	start = Clock::now();
+	scene.FinishInitialization(graphics);
+	result.initializationMs = getElapsedMs(start);
+
+	result.numMovingObjects = syntheticScene.GetNumMovingObjects();
+
+	std::vector<float> frameSamples;
+	frameSamples.reserve(numFrames);
+
+	std::vector<std::vector<float>> stageSamples(stageNames.size());
+	RenderStats::Counters counterSums = {};
+
+	// zones and counters of a frame are closed in BeginFrame() of the next one, so there is one more frame at the end
+	unsigned int numRunFrames = numWarmUpFrames + numFrames + 1;
+
+	for (unsigned int frame = 0; frame < numRunFrames; frame++)
+	{
+		start = Clock::now();
+
+		graphics.BeginFrame(deltaTime);
+
+		if (frame > numWarmUpFrames)
+		{
+			for (size_t stage = 0; stage < stageNames.size(); stage++)
+			{
+				std::optional<ZoneProfiler::ZoneStats> stats = ZoneProfiler::Get().GetZoneStats(stageNames[stage]);
+
+				stageSamples[stage].push_back(stats && stats->calls != 0 ? stats->lastMs : 0.0f);
+			}
+
+			const RenderStats::Counters& frameTotals = RenderStats::Get().GetLastFrameTotals();
+
+			for (unsigned int counter = 0; counter < RenderStats::numCounters; counter++)
+				counterSums[counter] += frameTotals[counter];
+		}
+
+		syntheticScene.Update(float(frame) * deltaTime);
+
+		scene.Update(graphics, input, false);
+
+		graphics.Render(scene, deltaTime);
+
+		graphics.FinishFrame();
+
+		if (frame >= numWarmUpFrames && frame < numRunFrames - 1)
+			frameSamples.push_back(getElapsedMs(start));
+	}
+
+	result.frame = CalculateStageResult(frameSamples);
+
+	for (size_t stage = 0; stage < stageNames.size(); stage++)
+		result.stages[stage] = CalculateStageResult(stageSamples[stage]);
+
+	float numMeasuredFrames = float(std::max(numFrames, 1u));
+
+	result.drawCalls = float(counterSums[size_t(RenderCounter::DrawCalls)]) / numMeasuredFrames;
+	result.instances = float(counterSums[size_t(RenderCounter::Instances)]) / numMeasuredFrames;
+	result.pipelineStates = float(counterSums[size_t(RenderCounter::PipelineStates)]) / numMeasuredFrames;
+	result.uploadedBytes = float(counterSums[size_t(RenderCounter::UploadedBytes)]) / numMeasuredFrames;
+	result.droppedLightIndices = float(counterSums[size_t(RenderCounter::DroppedLightIndices)]) / numMeasuredFrames;
+	result.peakMemoryBytes = MemoryTracker::Get().GetPeakTotalBytes();
+
+	float recordingMs = result.stages[recordingStage].avgMs;
+	result.drawsPerMs = recordingMs > 0.0f ? result.drawCalls / recordingMs : 0.0f;
+
+	RenderGraphicsGeometryJob::SetDrawPacketsEnabled(drawPacketsEnabled);
+	GeometryPass::SetInstancingEnabled(instancingEnabled);
+
+	return result;
+}
+
+bool SyntheticScene::SaveBenchmarkResult(const BenchmarkResult& result, const std::filesystem::path& path)
+{
+	std::ofstream file(path);
+
+	if (!file.is_open())
+		return false;
+
+	auto writeStage = [&](const char* name, const StageResult& stage)
+		{
+			file << "{\"name\":\"" << name << "\",\"avgMs\":" << stage.avgMs << ",\"p50Ms\":" << stage.p50Ms << ",\"p99Ms\":" << stage.p99Ms << ",\"maxMs\":" << stage.maxMs << "}";
+		};
+
+	file << "{\n";
+	file << "\"objects\":" << result.params.numObjects << ",\n";
+	file << "\"materials\":" << result.params.numMaterials << ",\n";
+	file << "\"lights\":" << result.params.numLights << ",\n";
+	file << "\"hierarchyDepth\":" << result.params.hierarchyDepth << ",\n";
+	file << "\"motionFraction\":" << result.params.motionFraction << ",\n";
+	file << "\"seed\":" << result.params.seed << ",\n";
+	file << "\"drawPackets\":" << (result.params.drawPackets ? "true" : "false") << ",\n";
+	file << "\"instancing\":" << (result.params.instancing ? "true" : "false") << ",\n";
+	file << "\"movingObjects\":" << result.numMovingObjects << ",\n";
+	file << "\"frames\":" << result.numFrames << ",\n";
+	file << "\"threads\":" << result.numThreads << ",\n";
+	file << "\"generationMs\":" << result.generationMs << ",\n";
+	file << "\"initializationMs\":" << result.initializationMs << ",\n";
+	file << "\"drawCalls\":" << result.drawCalls << ",\n";
+	file << "\"instances\":" << result.instances << ",\n";
+	file << "\"pipelineStates\":" << result.pipelineStates << ",\n";
+	file << "\"uploadedBytes\":" << result.uploadedBytes << ",\n";
+	file << "\"droppedLightIndices\":" << result.droppedLightIndices << ",\n";
+	file << "\"drawsPerMs\":" << result.drawsPerMs << ",\n";
+	file << "\"peakMemoryBytes\":" << result.peakMemoryBytes << ",\n";
+
+	// zone names don't contain characters that need escaping
+	file << "\"stages\":[\n";
+	writeStage("Frame", result.frame);
+
+	for (size_t stage = 0; stage < stageNames.size(); stage++)
+	{
+		file << ",\n";
+		writeStage(stageNames[stage], result.stages[stage]);
+	}
+
+	file << "\n]\n}\n";
+
+	return true;
+}
+
+SyntheticScene::StageResult SyntheticScene::CalculateStageResult(std::vector<float>& samples)
+{
+	StageResult result = {};
+
+	if (samples.empty())
+		return result;
+
+	std::sort(samples.begin(), samples.end());
+
+	float sum = 0.0f;
+
+	for (float sample : samples)
+		sum += sample;
+
+	size_t numSamples = samples.size();
+
+	result.avgMs = sum / float(numSamples);
+	result.p50Ms = samples[numSamples / 2];
+	result.p99Ms = samples[std::min(numSamples - 1, size_t(std::ceil(float(numSamples) * 0.99f)) - 1)];
+	result.maxMs = samples.back();
+
+	return result;
+}
\ No newline at end of file
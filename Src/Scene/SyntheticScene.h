@@ -0,0 +1,89 @@
+#pragma once
+#include "Includes/CppIncludes.h"
+#include "Includes/DirectXIncludes.h"
+
+class Graphics;
+class Scene;
+class ObjectTransform;
+
+// procedurally generated scene for measuring how CPU side of a frame scales with amount of objects, materials and lights.
+// Generation depends only on params, so runs with the same params see the same scene.
+// Benchmark runs on headless graphics and reads per stage times from ZoneProfiler zones
+class SyntheticScene
+{
+public:
+	struct Params
+	{
+		unsigned int numObjects = 1000;
+		unsigned int numMaterials = 16;
+		unsigned int numLights = 4;
+		unsigned int hierarchyDepth = 1; // 1 means all objects are roots
+		float motionFraction = 0.1f; // objects which local transform changes every frame
+		unsigned int seed = 1;
+		bool drawPackets = true; // geometry jobs record from baked draw packets instead of bindable containers
+		bool instancing = true; // geometry passes draw visible jobs with the same draw packet as instances of one draw
+	};
+
+	// zones timed by the benchmark, they are in the order frame goes through them
+	static constexpr std::array<const char*, 9> stageNames = { "Update", "Buffer upload", "Transforms", "Transform upload", "Culling", "Job sort", "Rendering", "Copy calls", "Recording" };
+	static constexpr size_t recordingStage = 8;
+
+	struct StageResult
+	{
+		float avgMs = 0.0f;
+		float p50Ms = 0.0f;
+		float p99Ms = 0.0f;
+		float maxMs = 0.0f;
+	};
+
+	struct BenchmarkResult
+	{
+		Params params;
+		unsigned int numMovingObjects = 0;
+		unsigned int numFrames = 0;
+		unsigned int numThreads = 0;
+		float generationMs = 0.0f;
+		float initializationMs = 0.0f;
+		StageResult frame;
+		std::array<StageResult, stageNames.size()> stages = {};
+
+		// averages per frame
+		float drawCalls = 0.0f;
+		float instances = 0.0f;
+		float pipelineStates = 0.0f;
+		float uploadedBytes = 0.0f;
+		float droppedLightIndices = 0.0f; // non zero means lighting was incomplete
+		float drawsPerMs = 0.0f; // draw calls recorded per millisecond of recording
+
+		size_t peakMemoryBytes = 0; // tracked by MemoryTracker since start of process
+	};
+
+public:
+	// adds materials, objects, lights and camera looking at them into scene, has to be called during scene initialization
+	void Generate(Graphics& graphics, Scene& scene, const Params& params);
+
+	// moves objects chosen to be animated
+	void Update(float time);
+
+	unsigned int GetNumMovingObjects() const;
+
+public:
+	// generates scene on headless graphics and runs numFrames frames with fixed timestep after few warm up frames
+	static BenchmarkResult Benchmark(const Params& params, unsigned int numFrames);
+
+	// false when file couldn't be opened
+	static bool SaveBenchmarkResult(const BenchmarkResult& result, const std::filesystem::path& path);
+
+private:
+	static StageResult CalculateStageResult(std::vector<float>& samples);
+
+private:
+	struct MovingObject
+	{
+		ObjectTransform* transform;
+		DirectX::XMFLOAT3 basePosition;
+		float phase;
+	};
+
+	std::vector<MovingObject> m_movingObjects;
+};
\ No newline at end of file
@@ -0,0 +1,364 @@
+#include "TransformHierarchy.h"
+#include "ObjectTransform.h"
+#include "System/JobSystem.h"
+
+#include "Macros/ErrorMacros.h"
+
+void TransformHierarchy::Rebuild(std::span<ObjectTransform* const> transforms, std::span<const int> parentIndices, unsigned int numThreads)
+{
+	THROW_INTERNAL_ERROR_IF("Number of parent indices doesn't match number of transforms", transforms.size() != parentIndices.size());
+
+	unsigned int numNodes = unsigned int(transforms.size());
+
+	// children of source index i are stored in childIndices at [childOffsets[i], childOffsets[i + 1])
+	std::vector<unsigned int> childOffsets(numNodes + 1, 0);
+	std::vector<unsigned int> childIndices(numNodes, 0);
+	{
+		for (unsigned int sourceIndex = 0; sourceIndex < numNodes; sourceIndex++)
+		{
+			int parentIndex = parentIndices[sourceIndex];
+
+			THROW_INTERNAL_ERROR_IF("Invalid parent index in transform hierarchy", parentIndex >= int(numNodes) || parentIndex == int(sourceIndex));
+
+			if (parentIndex >= 0)
+				childOffsets[parentIndex + 1]++;
+		}
+
+		for (unsigned int sourceIndex = 0; sourceIndex < numNodes; sourceIndex++)
+			childOffsets[sourceIndex + 1] += childOffsets[sourceIndex];
+
+		std::vector<unsigned int> nextChildSlot(childOffsets.begin(), childOffsets.end() - 1);
+
+		for (unsigned int sourceIndex = 0; sourceIndex < numNodes; sourceIndex++)
+			if (parentIndices[sourceIndex] >= 0)
+				childIndices[nextChildSlot[parentIndices[sourceIndex]]++] = sourceIndex;
+	}
+
+	// sorting nodes in depth first order
+	{
+		m_sourceIndices.clear();
+		m_sourceIndices.reserve(numNodes);
+
+		std::vector<unsigned int> stack;
+
+		for (unsigned int rootIndex = 0; rootIndex < numNodes; rootIndex++)
+		{
+			if (parentIndices[rootIndex] >= 0)
+				continue;
+
+			stack.push_back(rootIndex);
+
+			while (!stack.empty())
+			{
+				unsigned int sourceIndex = stack.back();
+				stack.pop_back();
+
+				m_sourceIndices.push_back(sourceIndex);
+
+				// pushing children in reverse, so they keep their original order
+				for (unsigned int childSlot = childOffsets[sourceIndex + 1]; childSlot > childOffsets[sourceIndex]; childSlot--)
+					stack.push_back(childIndices[childSlot - 1]);
+			}
+		}
+
+		THROW_INTERNAL_ERROR_IF("Transform hierarchy contains a cycle", m_sourceIndices.size() != numNodes);
+	}
+
+	std::vector<unsigned int> sourceToNode(numNodes, 0);
+
+	for (unsigned int node = 0; node < numNodes; node++)
+		sourceToNode[m_sourceIndices[node]] = node;
+
+	m_parentIndices.resize(numNodes);
+	m_positions.resize(numNodes);
+	m_rotations.resize(numNodes);
+	m_scales.resize(numNodes);
+	m_worldTransforms.resize(numNodes);
+	m_subtreeEnds.assign(numNodes, 1);
+	m_localDirty.assign(numNodes, 1);
+	m_transforms.resize(numNodes);
+
+	m_dirtyNodes.clear();
+	m_changedTransforms.clear();
+
+	for (unsigned int node = 0; node < numNodes; node++)
+	{
+		unsigned int sourceIndex = m_sourceIndices[node];
+		int parentIndex = parentIndices[sourceIndex];
+
+		m_parentIndices[node] = parentIndex < 0 ? -1 : int(sourceToNode[parentIndex]);
+
+		SetLocalTransform(node, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f }, { 1.0f, 1.0f, 1.0f });
+		DirectX::XMStoreFloat4x4(&m_worldTransforms[node], DirectX::XMMatrixIdentity());
+
+		m_transforms[node] = transforms[sourceIndex];
+
+		if (m_transforms[node])
+			m_transforms[node]->SetHierarchyNode(this, node);
+
+		// local transforms are gathered from objects in next update
+		m_dirtyNodes.push_back(node);
+	}
+
+	// calculating subtree sizes starting from leaves, then converting them to subtree ends
+	for (unsigned int node = numNodes; node > 0; node--)
+		if (m_parentIndices[node - 1] >= 0)
+			m_subtreeEnds[m_parentIndices[node - 1]] += m_subtreeEnds[node - 1];
+
+	for (unsigned int node = 0; node < numNodes; node++)
+		m_subtreeEnds[node] += node;
+
+	BuildRanges(numThreads);
+}
+
+void TransformHierarchy::Update(JobSystem& jobSystem)
+{
+	m_changedTransforms.clear();
+
+	GatherLocalTransforms();
+
+	m_rangesToUpdate.clear();
+
+	for (unsigned int rangeIndex = 0; rangeIndex < m_ranges.size(); rangeIndex++)
+	{
+		if (!m_rangeDirty[rangeIndex])
+			continue;
+
+		m_rangesToUpdate.push_back(rangeIndex);
+		m_rangeDirty[rangeIndex] = 0;
+	}
+
+	jobSystem.ParallelFor(unsigned int(m_rangesToUpdate.size()), [this](unsigned int jobIndex)
+		{
+			UpdateRange(m_rangesToUpdate[jobIndex]);
+		});
+
+	for (unsigned int rangeIndex : m_rangesToUpdate)
+	{
+		const std::vector<unsigned int>& changedInRange = m_changedPerRange[rangeIndex];
+
+		m_changedTransforms.insert(m_changedTransforms.end(), changedInRange.begin(), changedInRange.end());
+	}
+
+	std::sort(m_changedTransforms.begin(), m_changedTransforms.end());
+}
+
+void TransformHierarchy::MarkLocalTransformChanged(unsigned int node)
+{
+	if (m_localDirty.at(node))
+		return;
+
+	m_localDirty[node] = 1;
+	m_dirtyNodes.push_back(node);
+}
+
+DirectX::XMMATRIX TransformHierarchy::GetWorldTransform(unsigned int node) const
+{
+	return DirectX::XMLoadFloat4x4(&m_worldTransforms.at(node));
+}
+
+const std::vector<unsigned int>& TransformHierarchy::GetChangedTransforms() const
+{
+	return m_changedTransforms;
+}
+
+unsigned int TransformHierarchy::GetNumNodes() const
+{
+	return unsigned int(m_parentIndices.size());
+}
+
+TransformHierarchy::BenchmarkResult TransformHierarchy::Benchmark(JobSystem& jobSystem, unsigned int numNodes, unsigned int numIterations)
+{
+	using Clock = std::chrono::steady_clock;
+
+	auto getElapsedMs = [](Clock::time_point start)
+		{
+			return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+		};
+
+	auto getMedian = [](std::vector<float>& samples)
+		{
+			if (samples.empty())
+				return 0.0f;
+
+			auto middle = samples.begin() + samples.size() / 2;
+			std::nth_element(samples.begin(), middle, samples.end());
+
+			return *middle;
+		};
+
+	// forest of trees similar to imported models, every node is attached to one of previous nodes of the same tree
+	constexpr unsigned int nodesPerTree = 64;
+
+	std::vector<int> parentIndices(numNodes, -1);
+	std::vector<ObjectTransform*> transforms(numNodes, nullptr);
+
+	for (unsigned int sourceIndex = 0; sourceIndex < numNodes; sourceIndex++)
+	{
+		unsigned int treeStart = sourceIndex - sourceIndex % nodesPerTree;
+
+		if (sourceIndex != treeStart)
+			parentIndices[sourceIndex] = int(treeStart + (sourceIndex * 2654435761u) % (sourceIndex - treeStart));
+	}
+
+	BenchmarkResult result = {};
+	result.numNodes = numNodes;
+	result.numThreads = jobSystem.GetNumThreads();
+	result.numIterations = numIterations;
+
+	std::vector<float> rebuildSamples;
+	std::vector<float> fullUpdateSamples;
+	std::vector<float> partialUpdateSamples;
+	std::vector<float> staticUpdateSamples;
+
+	for (unsigned int iteration = 0; iteration < numWarmUpIterations + numIterations; iteration++)
+	{
+		TransformHierarchy hierarchy;
+
+		Clock::time_point start = Clock::now();
+		hierarchy.Rebuild(transforms, parentIndices, result.numThreads);
+		float rebuildMs = getElapsedMs(start);
+
+		for (unsigned int node = 0; node < numNodes; node++)
+			hierarchy.SetLocalTransform(node, { float(node % 16), 1.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f }, { 1.0f, 1.0f, 1.0f });
+
+		start = Clock::now();
+		hierarchy.Update(jobSystem);
+		float fullUpdateMs = getElapsedMs(start);
+
+		// 1% of nodes spread over the whole hierarchy
+		for (unsigned int node = 0; node < numNodes; node += 100)
+		{
+			hierarchy.SetLocalTransform(node, { 0.0f, float(node % 16), 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f }, { 2.0f, 2.0f, 2.0f });
+			hierarchy.MarkLocalTransformChanged(node);
+		}
+
+		start = Clock::now();
+		hierarchy.Update(jobSystem);
+		float partialUpdateMs = getElapsedMs(start);
+
+		start = Clock::now();
+		hierarchy.Update(jobSystem);
+		float staticUpdateMs = getElapsedMs(start);
+
+		if (iteration < numWarmUpIterations)
+			continue;
+
+		rebuildSamples.push_back(rebuildMs);
+		fullUpdateSamples.push_back(fullUpdateMs);
+		partialUpdateSamples.push_back(partialUpdateMs);
+		staticUpdateSamples.push_back(staticUpdateMs);
+	}
+
+	result.rebuildMs = getMedian(rebuildSamples);
+	result.fullUpdateMs = getMedian(fullUpdateSamples);
+	result.partialUpdateMs = getMedian(partialUpdateSamples);
+	result.staticUpdateMs = getMedian(staticUpdateSamples);
+
+	return result;
+}
+
+void TransformHierarchy::BuildRanges(unsigned int numThreads)
+{
+	unsigned int numNodes = GetNumNodes();
+
+	// few ranges per thread so threads that got cheaper ranges can take next ones
+	unsigned int targetRangeSize = std::max(minNodesPerRange, numNodes / (std::max(numThreads, 1u) * 4) + 1);
+
+	m_ranges.clear();
+
+	NodeRange currentRange = {};
+
+	// every root subtree ends where next root starts
+	for (unsigned int rootNode = 0; rootNode < numNodes; rootNode = m_subtreeEnds[rootNode])
+	{
+		currentRange.end = m_subtreeEnds[rootNode];
+
+		if (currentRange.end - currentRange.begin >= targetRangeSize)
+		{
+			m_ranges.push_back(currentRange);
+			currentRange.begin = currentRange.end;
+		}
+	}
+
+	if (currentRange.end != currentRange.begin)
+		m_ranges.push_back(currentRange);
+
+	m_nodeRanges.resize(numNodes);
+
+	for (unsigned int rangeIndex = 0; rangeIndex < m_ranges.size(); rangeIndex++)
+		for (unsigned int node = m_ranges[rangeIndex].begin; node < m_ranges[rangeIndex].end; node++)
+			m_nodeRanges[node] = rangeIndex;
+
+	m_rangeDirty.assign(m_ranges.size(), 1);
+	m_changedPerRange.clear();
+	m_changedPerRange.resize(m_ranges.size());
+}
+
+void TransformHierarchy::GatherLocalTransforms()
+{
+	for (unsigned int node : m_dirtyNodes)
+	{
+		if (const ObjectTransform* transform = m_transforms[node])
+		{
+			DirectX::XMFLOAT4 rotation;
+			DirectX::XMStoreFloat4(&rotation, transform->GetQuaternionRotation());
+
+			SetLocalTransform(node, transform->GetPosition(), rotation, transform->GetScale());
+		}
+
+		m_rangeDirty[m_nodeRanges[node]] = 1;
+	}
+
+	m_dirtyNodes.clear();
+}
+
+void TransformHierarchy::UpdateRange(unsigned int rangeIndex)
+{
+	const NodeRange& range = m_ranges[rangeIndex];
+	std::vector<unsigned int>& changedTransforms = m_changedPerRange[rangeIndex];
+
+	changedTransforms.clear();
+
+	for (unsigned int node = range.begin; node < range.end;)
+	{
+		if (!m_localDirty[node])
+		{
+			node++;
+			continue;
+		}
+
+		// whole subtree of changed node gets new world matrices, parents are always calculated before their children
+		unsigned int subtreeEnd = m_subtreeEnds[node];
+
+		for (unsigned int subtreeNode = node; subtreeNode < subtreeEnd; subtreeNode++)
+		{
+			const DirectX::XMFLOAT3& position = m_positions[subtreeNode];
+			const DirectX::XMFLOAT3& scale = m_scales[subtreeNode];
+
+			DirectX::XMMATRIX transform =
+				DirectX::XMMatrixScaling(scale.x, scale.y, scale.z) *
+				DirectX::XMMatrixRotationQuaternion(DirectX::XMLoadFloat4(&m_rotations[subtreeNode])) *
+				DirectX::XMMatrixTranslation(position.x, position.y, position.z);
+
+			int parentNode = m_parentIndices[subtreeNode];
+
+			if (parentNode >= 0)
+				transform = transform * DirectX::XMLoadFloat4x4(&m_worldTransforms[parentNode]);
+
+			DirectX::XMStoreFloat4x4(&m_worldTransforms[subtreeNode], transform);
+
+			m_localDirty[subtreeNode] = 0;
+			changedTransforms.push_back(m_sourceIndices[subtreeNode]);
+		}
+
+		node = subtreeEnd;
+	}
+}
+
+void TransformHierarchy::SetLocalTransform(unsigned int node, DirectX::XMFLOAT3 position, DirectX::XMFLOAT4 rotation, DirectX::XMFLOAT3 scale)
+{
+	m_positions[node] = position;
+	m_rotations[node] = rotation;
+	m_scales[node] = scale;
+}
\ No newline at end of file
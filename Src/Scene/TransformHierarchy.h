@@ -0,0 +1,90 @@
+#pragma once
+#include "Includes/CppIncludes.h"
+#include "Includes/DirectXIncludes.h"
+
+class JobSystem;
+class ObjectTransform;
+
+// transforms of scene objects stored as flat arrays sorted in depth first order.
+// parent always has lower node index than its children and every subtree occupies continuous range of nodes,
+// so world matrices can be calculated with a single linear pass
+class TransformHierarchy
+{
+public:
+	struct BenchmarkResult
+	{
+		unsigned int numNodes = 0;
+		unsigned int numThreads = 0;
+		unsigned int numIterations = 0;
+
+		// medians of measured iterations
+		float rebuildMs = 0.0f;
+		float fullUpdateMs = 0.0f;
+		float partialUpdateMs = 0.0f;
+		float staticUpdateMs = 0.0f;
+	};
+
+public:
+	// parentIndices.at(i) is index of transforms.at(i) parent or -1 for roots. Transforms can be null, then node starts with identity transform
+	void Rebuild(std::span<ObjectTransform* const> transforms, std::span<const int> parentIndices, unsigned int numThreads);
+
+	// recalculates world matrices of dirty subtrees
+	void Update(JobSystem& jobSystem);
+
+	void MarkLocalTransformChanged(unsigned int node);
+
+	DirectX::XMMATRIX GetWorldTransform(unsigned int node) const;
+
+	// indices of transforms passed to Rebuild() which world matrix changed in last Update(), sorted
+	const std::vector<unsigned int>& GetChangedTransforms() const;
+
+	unsigned int GetNumNodes() const;
+
+public:
+	// builds synthetic forest of numNodes nodes and measures Rebuild() and Update() with all, 1% and none of the nodes changed.
+	// Every iteration starts from new hierarchy, warm up iterations aren't measured
+	static BenchmarkResult Benchmark(JobSystem& jobSystem, unsigned int numNodes, unsigned int numIterations = 10);
+
+private:
+	void BuildRanges(unsigned int numThreads);
+
+	void GatherLocalTransforms();
+
+	void UpdateRange(unsigned int rangeIndex);
+
+	void SetLocalTransform(unsigned int node, DirectX::XMFLOAT3 position, DirectX::XMFLOAT4 rotation, DirectX::XMFLOAT3 scale);
+
+private:
+	struct NodeRange
+	{
+		unsigned int begin = 0;
+		unsigned int end = 0;
+	};
+
+	// minimal amount of nodes that is worth being processed as separate job
+	static constexpr unsigned int minNodesPerRange = 1024;
+
+	static constexpr unsigned int numWarmUpIterations = 2;
+
+private:
+	// per node data
+	std::vector<int> m_parentIndices;
+	std::vector<DirectX::XMFLOAT3> m_positions;
+	std::vector<DirectX::XMFLOAT4> m_rotations;
+	std::vector<DirectX::XMFLOAT3> m_scales;
+	std::vector<DirectX::XMFLOAT4X4> m_worldTransforms;
+	std::vector<unsigned int> m_subtreeEnds;
+	std::vector<uint8_t> m_localDirty;
+	std::vector<unsigned int> m_nodeRanges;
+	std::vector<unsigned int> m_sourceIndices;
+	std::vector<ObjectTransform*> m_transforms;
+
+	// ranges are made of whole root subtrees, so they can be updated independently
+	std::vector<NodeRange> m_ranges;
+	std::vector<uint8_t> m_rangeDirty;
+	std::vector<std::vector<unsigned int>> m_changedPerRange;
+
+	std::vector<unsigned int> m_dirtyNodes;
+	std::vector<unsigned int> m_rangesToUpdate;
+	std::vector<unsigned int> m_changedTransforms;
+};
\ No newline at end of file
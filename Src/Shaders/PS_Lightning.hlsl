@@ -6,7 +6,10 @@ Texture2D t_rt2 : register(t2);
 
 Texture2D t_depth : register(t3);
 
-TextureCube t_shadowMap : register(t4);
+Texture2D t_shadowAtlas : register(t4);
+
+StructuredBuffer<uint4> t_clusterRanges : register(t5); // offset and count of two clusters in each element
+StructuredBuffer<uint4> t_clusterLightIndices : register(t6); // four light indices in each element
 
 struct PointLightData
 {
@@ -17,6 +20,7 @@ struct PointLightData
     float attenuationConstant;
     float nearZ;
     float farZ;
+    float4 shadowFaces[6]; // xy - offset, zw - size of face tile in atlas UV. Zero size when light has no shadows
 };
 
 #ifndef NUM_POINTLIGHTS
@@ -34,6 +38,15 @@ cbuffer transforms : register(b2)
     matrix b_inverseView;
 };
 
+cbuffer clusterParams : register(b3)
+{
+    uint b_tilesX;
+    uint b_tilesY;
+    uint b_slicesZ;
+    float b_sliceScale; // depth slices are exponential, slice = log(viewZ) * scale + bias
+    float b_sliceBias;
+};
+
 float NormalDistribution(float alpha, float NdotH)
 {
     const float alpha2 = alpha * alpha;
@@ -99,21 +112,87 @@ float CalculateLightDepth(PointLightData pointlight, float3 positionInLightSpace
 
 #define FLT_EPSILON 0.00001f
 
-float SampleShadowMap(float3 sampleDir)
+// face selection and face coordinates follow D3D cube map addressing, the same one shadow cameras render with
+float2 GetCubeFaceCoordinates(float3 sampleDir, out uint face)
 {
-    return t_shadowMap.Sample(s_sampler, normalize(sampleDir)).r;
+    const float3 absSampleVec = abs(sampleDir);
+    float2 coordinates;
+    float majorAxis;
+    
+    if (absSampleVec.x >= absSampleVec.y && absSampleVec.x >= absSampleVec.z)
+    {
+        face = sampleDir.x > 0.0f ? 0 : 1;
+        coordinates = float2(sampleDir.x > 0.0f ? -sampleDir.z : sampleDir.z, -sampleDir.y);
+        majorAxis = absSampleVec.x;
+    }
+    else if (absSampleVec.y >= absSampleVec.z)
+    {
+        face = sampleDir.y > 0.0f ? 2 : 3;
+        coordinates = float2(sampleDir.x, sampleDir.y > 0.0f ? sampleDir.z : -sampleDir.z);
+        majorAxis = absSampleVec.y;
+    }
+    else
+    {
+        face = sampleDir.z > 0.0f ? 4 : 5;
+        coordinates = float2(sampleDir.z > 0.0f ? sampleDir.x : -sampleDir.x, -sampleDir.y);
+        majorAxis = absSampleVec.z;
+    }
+    
+    return (coordinates / majorAxis) * 0.5f + 0.5f;
+}
+
+float SampleShadowMap(PointLightData pointlightData, float3 sampleDir)
+{
+    uint face;
+    const float2 faceCoordinates = GetCubeFaceCoordinates(sampleDir, face);
+    const float4 faceRect = pointlightData.shadowFaces[face];
+    
+    float2 atlasSize;
+    t_shadowAtlas.GetDimensions(atlasSize.x, atlasSize.y);
+    
+    // filtering can't reach into neighbouring tiles
+    const float2 halfTexel = 0.5f / atlasSize;
+    const float2 atlasCoordinates = clamp(faceRect.xy + faceCoordinates * faceRect.zw, faceRect.xy + halfTexel, faceRect.xy + faceRect.zw - halfTexel);
+    
+    return t_shadowAtlas.Sample(s_sampler, atlasCoordinates).r;
 }
 
 bool GetOcclusion(PointLightData pointlightData, float3 worldPos)
 {
+    // light without tiles in atlas doesn't cast shadows
+    if (pointlightData.shadowFaces[0].z == 0.0f)
+        return false;
+    
     const float3 positionInLightSpace = worldPos - GetWorldPosition(pointlightData.lightPositionInCameraSpace);
     
-    const float sampledDepth = SampleShadowMap(positionInLightSpace);
+    const float sampledDepth = SampleShadowMap(pointlightData, positionInLightSpace);
     const float calculatedDepth = CalculateLightDepth(pointlightData, positionInLightSpace);
 
     return sampledDepth < (calculatedDepth - FLT_EPSILON);
 }
 
+// tiles go from the top left corner of the screen, the same way as texture coordinates
+uint GetClusterIndex(float2 textureCoords, float viewDepth)
+{
+    const uint tileX = min(uint(textureCoords.x * b_tilesX), b_tilesX - 1);
+    const uint tileY = min(uint(textureCoords.y * b_tilesY), b_tilesY - 1);
+    const uint slice = min(uint(max(log(viewDepth) * b_sliceScale + b_sliceBias, 0.0f)), b_slicesZ - 1);
+    
+    return (slice * b_tilesY + tileY) * b_tilesX + tileX;
+}
+
+uint2 GetClusterRange(uint clusterIndex)
+{
+    const uint4 rangePair = t_clusterRanges[clusterIndex / 2];
+    
+    return (clusterIndex & 1) ? rangePair.zw : rangePair.xy;
+}
+
+uint GetClusterLightIndex(uint index)
+{
+    return t_clusterLightIndices[index / 4][index % 4];
+}
+
 static const float _pi = 3.14159265358979f;
 
 #define FLAG_WORKFLOW_METALNESS (1 << 0)
@@ -169,10 +248,12 @@ float4 PSMain(float2 textureCoords : TEXCOORDS) : SV_TARGET
     
     float3 accumulatedLight = float3(0.0f, 0.0f, 0.0f);
     
-    [unroll]
-    for (int pointLightIndex = 0; pointLightIndex < 1; pointLightIndex++)
+    // only lights which range reaches pixel's cluster
+    const uint2 clusterRange = GetClusterRange(GetClusterIndex(textureCoords, viewPosition.z));
+    
+    for (uint clusterLight = 0; clusterLight < clusterRange.y; clusterLight++)
     {
-        PointLightData pointlightData = b_pointlights[pointLightIndex];
+        PointLightData pointlightData = b_pointlights[GetClusterLightIndex(clusterRange.x + clusterLight)];
 
         const float3 L = normalize(pointlightData.lightPositionInCameraSpace - viewPosition); // light
         
@@ -1,12 +1,14 @@
+// affine transform stored as transposed 3x4 matrix
 struct TransformModelData
 {
-    row_major matrix transform;
+    float4 rows[3];
 };
 
 StructuredBuffer<TransformModelData> modelTransforms : register(t0);
 
+// every point light uses 6 cameras, array fills whole constant buffer
 #ifndef NUM_CAMERAS
-#define NUM_CAMERAS 10
+#define NUM_CAMERAS 512
 #endif
 
 struct CameraData
@@ -25,10 +27,8 @@ cbuffer cameraConstants : register(b2)
     int cameraTransformIndex;
 }
 
-cbuffer modelConstants : register(b3)
-{
-    int modelTransformIndex;
-}
+// scene indices of instances drawn by current draw
+StructuredBuffer<uint> instanceSceneIndices : register(t1);
 
 struct VSOut
 {
@@ -74,9 +74,12 @@ VSOut VSMain(
      , float3 bitangent : BITANGENT
 #endif	
 
+	, uint instanceID : SV_InstanceID
 	)
 {
-    row_major matrix transform = modelTransforms[modelTransformIndex].transform;
+    uint modelTransformIndex = instanceSceneIndices[instanceID];
+    TransformModelData transformData = modelTransforms[modelTransformIndex];
+    row_major matrix transform = transpose(float4x4(transformData.rows[0], transformData.rows[1], transformData.rows[2], float4(0.0f, 0.0f, 0.0f, 1.0f)));
     
     matrix transformInCameraSpace = mul(transform, cameras[cameraTransformIndex].view);
     matrix transformInCameraView = mul(transformInCameraSpace, cameras[cameraTransformIndex].projection);
@@ -0,0 +1,121 @@
+#include "JobSystem.h"
+
+#include "Graphics/Profiler/ZoneProfiler.h"
+
+JobSystem::JobSystem(unsigned int numWorkers)
+{
+	m_workers.reserve(numWorkers);
+
+	for (unsigned int i = 0; i < numWorkers; i++)
+		m_workers.emplace_back(&JobSystem::WorkerLoop, this);
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+
+	m_workAvailable.notify_all();
+
+	for (auto& worker : m_workers)
+		worker.join();
+}
+
+void JobSystem::ParallelFor(unsigned int numJobs, const std::function<void(unsigned int)>& job)
+{
+	if (numJobs == 0)
+		return;
+
+	// no reason to wake workers for single job
+	if (numJobs == 1 || m_workers.empty())
+	{
+		for (unsigned int jobIndex = 0; jobIndex < numJobs; jobIndex++)
+			job(jobIndex);
+
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		m_job = &job;
+		m_numJobs = numJobs;
+		m_nextJob = 0;
+		m_generation++;
+	}
+
+	m_workAvailable.notify_all();
+
+	RunJobs(&job, numJobs);
+
+	// all jobs were taken at this point, waiting for workers that are still processing theirs
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_workFinished.wait(lock, [this] { return m_activeWorkers == 0; });
+
+		m_job = nullptr;
+		m_numJobs = 0;
+	}
+}
+
+unsigned int JobSystem::GetNumThreads() const
+{
+	return static_cast<unsigned int>(m_workers.size()) + 1;
+}
+
+unsigned int JobSystem::GetDefaultNumWorkers()
+{
+	unsigned int numHardwareThreads = std::thread::hardware_concurrency();
+
+	return numHardwareThreads > 1 ? numHardwareThreads - 1 : 0;
+}
+
+void JobSystem::WorkerLoop()
+{
+	ZoneProfiler::SetThreadName("Job worker");
+
+	uint64_t lastGeneration = 0;
+
+	while (true)
+	{
+		const std::function<void(unsigned int)>* job = nullptr;
+		unsigned int numJobs = 0;
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_workAvailable.wait(lock, [&] { return m_stop || m_generation != lastGeneration; });
+
+			if (m_stop)
+				return;
+
+			lastGeneration = m_generation;
+
+			// woke after ParallelFor already finished. Claiming a job now would take index from the next ParallelFor
+			if (!m_job || m_numJobs == 0)
+				continue;
+
+			job = m_job;
+			numJobs = m_numJobs;
+			m_activeWorkers++;
+		}
+
+		RunJobs(job, numJobs);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_activeWorkers--;
+		}
+
+		m_workFinished.notify_one();
+	}
+}
+
+void JobSystem::RunJobs(const std::function<void(unsigned int)>* job, unsigned int numJobs)
+{
+	PROFILE_ZONE("Jobs");
+
+	for (unsigned int jobIndex = m_nextJob.fetch_add(1); jobIndex < numJobs; jobIndex = m_nextJob.fetch_add(1))
+		(*job)(jobIndex);
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+#include "Includes/CppIncludes.h"
+
+// fixed pool of worker threads for splitting CPU work into independent jobs
+class JobSystem
+{
+public:
+	JobSystem(unsigned int numWorkers = GetDefaultNumWorkers());
+	JobSystem(const JobSystem&) = delete;
+
+	~JobSystem();
+
+public:
+	// calls job(jobIndex) for every index in [0, numJobs) and returns when all of them finished. Calling thread takes part in the work.
+	// only one ParallelFor can run at the time and jobs can't call it recursively
+	void ParallelFor(unsigned int numJobs, const std::function<void(unsigned int)>& job);
+
+	// number of threads that can process jobs at the same time, including calling thread
+	unsigned int GetNumThreads() const;
+
+	static unsigned int GetDefaultNumWorkers();
+
+private:
+	void WorkerLoop();
+
+	void RunJobs(const std::function<void(unsigned int)>* job, unsigned int numJobs);
+
+private:
+	std::vector<std::thread> m_workers;
+
+	std::mutex m_mutex;
+	std::condition_variable m_workAvailable;
+	std::condition_variable m_workFinished;
+
+	const std::function<void(unsigned int)>* m_job = nullptr;
+	unsigned int m_numJobs = 0;
+	std::atomic<unsigned int> m_nextJob = 0;
+	unsigned int m_activeWorkers = 0;
+	uint64_t m_generation = 0;
+	bool m_stop = false;
+};
\ No newline at end of file
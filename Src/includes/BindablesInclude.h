@@ -18,4 +18,5 @@
 #include "Graphics/Bindables/DepthStencilView.h"
 #include "Graphics/Bindables/UnorderedAccessView.h"
 #include "Graphics/Bindables/DepthStencilState.h"
-#include "Graphics/Bindables/RootSignatureConstants.h"
\ No newline at end of file
+#include "Graphics/Bindables/RootSignatureConstants.h"
+#include "Graphics/Bindables/InstanceBuffer.h"
\ No newline at end of file
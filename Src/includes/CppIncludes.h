@@ -1,6 +1,6 @@
 #pragma once
 
-
+#ifdef _MSC_VER
 // warning "move assignment operator implicitly deleted" is not needed since its logical in every case
 #pragma warning(disable:4626)
 
@@ -9,6 +9,7 @@
 
 //turning off "unreferenced parameter" error
 #pragma warning(disable:4100)
+#endif
 
 // pi just in case 
 static constexpr float _pi = 3.14159265358979f;
@@ -29,7 +30,16 @@ static constexpr float _pi = 3.14159265358979f;
 #include <span>
 #include <typeindex>
 #include <bitset>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <queue>
+#include <random>
+#include <fstream>
+#include <iomanip>
 
+#ifdef _WIN32
 // stripping windows.h not needed stuff
 #define NOGDICAPMASKS
 #define NOMENUS
@@ -60,6 +70,7 @@ static constexpr float _pi = 3.14159265358979f;
 #define NOTAPE
 
 #include <windows.h>
+#endif
 
 #ifdef _DEBUG
 	#include <iostream>
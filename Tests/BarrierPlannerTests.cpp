@@ -0,0 +1,149 @@
+#include "TestFramework.h"
+#include "Graphics/RenderGraph/BarrierPlanner.h"
+
+using ResourceHandle = FrameGraphCompiler::ResourceHandle;
+using PassHandle = FrameGraphCompiler::PassHandle;
+
+// values of D3D12_RESOURCE_STATES that RenderGraph feeds to the planner
+static constexpr BarrierPlanner::ResourceState statePresent = 0x0;
+static constexpr BarrierPlanner::ResourceState stateRenderTarget = 0x4;
+static constexpr BarrierPlanner::ResourceState stateDepthWrite = 0x10;
+static constexpr BarrierPlanner::ResourceState stateDepthRead = 0x20;
+static constexpr BarrierPlanner::ResourceState statePixelShaderResource = 0x80;
+static constexpr BarrierPlanner::ResourceState stateAllShaderResource = 0xc0;
+static constexpr BarrierPlanner::ResourceState stateGenericRead = 0xac3;
+
+static unsigned int CountBarriers(const std::vector<BarrierPlanner::Barrier>& barriers, BarrierPlanner::BarrierType type)
+{
+	return static_cast<unsigned int>(std::count_if(barriers.begin(), barriers.end(), [type](const BarrierPlanner::Barrier& barrier) { return barrier.type == type; }));
+}
+
+// the same passes and resources RenderGraph declares, regressions in planning show up as changed counts
+TEST_CASE("engine frame graph keeps its barrier counts")
+{
+	FrameGraphCompiler frameGraph;
+	BarrierPlanner barrierPlanner(stateGenericRead | stateDepthRead);
+
+	ResourceHandle depth = frameGraph.ImportResource("depthStencil");
+	ResourceHandle backBuffer = frameGraph.ImportResource("backBuffer");
+	ResourceHandle swapChain = frameGraph.ImportResource("swapChain");
+	ResourceHandle shadowAtlas = frameGraph.ImportResource("shadowAtlas");
+	ResourceHandle gBuffer[] = {
+		frameGraph.CreateTransientResource("gBuffer0", 1 << 20, 1 << 16),
+		frameGraph.CreateTransientResource("gBuffer1", 1 << 20, 1 << 16),
+		frameGraph.CreateTransientResource("gBuffer2", 1 << 20, 1 << 16),
+	};
+
+	auto addPass = [&](std::string name, std::vector<std::pair<ResourceHandle, BarrierPlanner::ResourceState>> reads, std::vector<std::pair<ResourceHandle, BarrierPlanner::ResourceState>> writes)
+		{
+			std::vector<ResourceHandle> readHandles;
+			std::vector<ResourceHandle> writeHandles;
+
+			for (const auto& [resource, state] : reads)
+				readHandles.push_back(resource);
+
+			for (const auto& [resource, state] : writes)
+				writeHandles.push_back(resource);
+
+			PassHandle pass = frameGraph.AddPass(std::move(name), readHandles, writeHandles);
+
+			for (const auto& [resource, state] : reads)
+				barrierPlanner.SetUsageState(pass, resource, state);
+
+			for (const auto& [resource, state] : writes)
+				barrierPlanner.SetUsageState(pass, resource, state);
+		};
+
+	addPass("PreDepth", {}, { { depth, stateDepthWrite } });
+	addPass("Shadow", {}, { { shadowAtlas, stateDepthWrite } });
+	addPass("GBuffer", { { depth, stateDepthWrite } }, { { gBuffer[0], stateRenderTarget }, { gBuffer[1], stateRenderTarget }, { gBuffer[2], stateRenderTarget } });
+	addPass("Lightning", {
+		{ gBuffer[0], stateAllShaderResource }, { gBuffer[1], stateAllShaderResource }, { gBuffer[2], stateAllShaderResource },
+		{ depth, stateAllShaderResource }, { shadowAtlas, stateAllShaderResource } }, { { backBuffer, stateRenderTarget } });
+	addPass("Emissive", { { depth, stateDepthWrite } }, { { backBuffer, stateRenderTarget } });
+	addPass("Skybox", { { depth, stateDepthWrite } }, { { backBuffer, stateRenderTarget } });
+	addPass("Fullscreen", { { backBuffer, stateAllShaderResource } }, { { swapChain, stateRenderTarget } });
+	addPass("Gui", {}, { { swapChain, stateRenderTarget } });
+
+	frameGraph.MarkOutput(swapChain);
+	barrierPlanner.SetFinalState(swapChain, statePresent);
+
+	FrameGraphCompiler::CompiledGraph compiledGraph = frameGraph.Compile();
+	BarrierPlanner::Plan plan = barrierPlanner.Compile(frameGraph, compiledGraph);
+
+	CHECK_EQUAL(14u, plan.numBarriers);
+	CHECK_EQUAL(7u, plan.numSplitBarriers);
+	CHECK_EQUAL(7u, plan.numBatches);
+	CHECK_EQUAL(14u, plan.numUnbatchedBarriers);
+
+	// everything written later starts its transition right after the first pass
+	CHECK_EQUAL(6u, CountBarriers(plan.passBarriers.at(0), BarrierPlanner::BarrierType::begin));
+	CHECK_EQUAL(0u, CountBarriers(plan.passBarriers.at(0), BarrierPlanner::BarrierType::full));
+
+	// gbuffer, shadow atlas, depth and back buffer are all switched to reading before lightning
+	CHECK_EQUAL(6u, plan.passBarriers.at(3).size());
+
+	CHECK(plan.passBarriers.at(5).empty());
+	CHECK(plan.passBarriers.at(7).empty());
+
+	CHECK_EQUAL(1u, plan.finalBarriers.size());
+	CHECK_EQUAL(swapChain, plan.finalBarriers.at(0).resource);
+	CHECK_EQUAL(statePresent, plan.finalBarriers.at(0).stateAfter);
+
+	CHECK(barrierPlanner.GetReport(frameGraph, compiledGraph, plan).find("Barriers: 14 in 7 batches, 7 split") != std::string::npos);
+}
+
+TEST_CASE("consecutive reads are combined into one state")
+{
+	FrameGraphCompiler frameGraph;
+	BarrierPlanner barrierPlanner(stateGenericRead | stateDepthRead);
+
+	ResourceHandle depth = frameGraph.ImportResource("depth");
+
+	PassHandle write = frameGraph.AddPass("write", {}, { depth });
+	PassHandle depthTest = frameGraph.AddPass("depthTest", { depth }, {});
+	PassHandle sample = frameGraph.AddPass("sample", { depth }, {});
+
+	barrierPlanner.SetUsageState(write, depth, stateDepthWrite);
+	barrierPlanner.SetUsageState(depthTest, depth, stateDepthRead);
+	barrierPlanner.SetUsageState(sample, depth, statePixelShaderResource);
+
+	BarrierPlanner::Plan plan = barrierPlanner.Compile(frameGraph, frameGraph.Compile());
+
+	CHECK_EQUAL(2u, plan.numBarriers);
+	CHECK_EQUAL(3u, plan.numUnbatchedBarriers);
+	CHECK_EQUAL(0u, plan.numSplitBarriers);
+
+	CHECK_EQUAL(1u, plan.passBarriers.at(1).size());
+	CHECK_EQUAL(stateDepthRead | statePixelShaderResource, plan.passBarriers.at(1).at(0).stateAfter);
+	CHECK(plan.passBarriers.at(2).empty());
+
+	CHECK(plan.frameStartStates.at(depth).has_value());
+	CHECK_EQUAL(stateDepthRead | statePixelShaderResource, *plan.frameStartStates.at(depth));
+}
+
+TEST_CASE("transition over unused passes is split")
+{
+	FrameGraphCompiler frameGraph;
+	BarrierPlanner barrierPlanner(stateGenericRead | stateDepthRead);
+
+	ResourceHandle target = frameGraph.ImportResource("target");
+	ResourceHandle other = frameGraph.ImportResource("other");
+
+	PassHandle write = frameGraph.AddPass("write", {}, { target });
+	PassHandle unrelated = frameGraph.AddPass("unrelated", {}, { other });
+	PassHandle read = frameGraph.AddPass("read", { target }, {});
+
+	barrierPlanner.SetUsageState(write, target, stateRenderTarget);
+	barrierPlanner.SetUsageState(unrelated, other, stateRenderTarget);
+	barrierPlanner.SetUsageState(read, target, statePixelShaderResource);
+
+	BarrierPlanner::Plan plan = barrierPlanner.Compile(frameGraph, frameGraph.Compile());
+
+	CHECK_EQUAL(1u, CountBarriers(plan.passBarriers.at(1), BarrierPlanner::BarrierType::begin));
+	CHECK_EQUAL(1u, CountBarriers(plan.passBarriers.at(2), BarrierPlanner::BarrierType::end));
+	CHECK_EQUAL(1u, plan.numSplitBarriers);
+
+	// pass can't use resource in states that can't be combined
+	CHECK_THROWS(barrierPlanner.SetUsageState(read, target, stateRenderTarget));
+}
\ No newline at end of file
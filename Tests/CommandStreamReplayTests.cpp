@@ -0,0 +1,152 @@
+#include "TestFramework.h"
+#include "Graphics/Profiler/CommandStreamReplay.h"
+
+#include <cstring>
+
+namespace
+{
+	using Strategy = CommandStreamReplay::Strategy;
+
+	std::filesystem::path GetCapturePath()
+	{
+		return std::filesystem::temp_directory_path() / "command_stream_replay_tests.tcmd";
+	}
+
+	// one frame with three draws, the last one returns to state of the first one
+	std::vector<uint8_t> CaptureFrame(uint32_t rootIndex = 0)
+	{
+		CommandStream& stream = CommandStream::Get();
+
+		stream.StartCapture(1, GetCapturePath());
+		stream.EndFrame();
+
+		CommandStream::Record(StreamCommand::OpenList, 1, 0);
+		CommandStream::Record(StreamCommand::BeginPass, CommandStream::GetNameIndex("GeometryPass"));
+		CommandStream::Record(StreamCommand::SetPipelineState, 1);
+		CommandStream::Record(StreamCommand::SetGraphicsRootSignature, 1);
+		CommandStream::Record(StreamCommand::SetVertexBuffer, 1);
+		CommandStream::Record(StreamCommand::SetIndexBuffer, 1);
+		CommandStream::Record(StreamCommand::SetPrimitiveTopology, 4);
+		CommandStream::Record(StreamCommand::SetGraphicsRootParam, rootIndex, 5);
+		CommandStream::Record(StreamCommand::DrawIndexed, 36, 0, 0, 1);
+		CommandStream::Record(StreamCommand::SetPipelineState, 2);
+		CommandStream::Record(StreamCommand::DrawIndexed, 6, 0, 0, 1);
+		CommandStream::Record(StreamCommand::SetPipelineState, 1);
+		CommandStream::Record(StreamCommand::SetGraphicsRootParam, rootIndex, 5);
+		CommandStream::Record(StreamCommand::DrawIndexed, 36, 0, 0, 1);
+		CommandStream::Record(StreamCommand::EndPass);
+		CommandStream::Record(StreamCommand::CloseList, 1);
+
+		stream.EndFrame();
+
+		return stream.GetLastCapture();
+	}
+}
+
+TEST_CASE("captured stream is loaded with its names and frames")
+{
+	std::vector<uint8_t> capture = CaptureFrame();
+	CommandStreamReplay replay;
+
+	CHECK(replay.Load(capture));
+	CHECK_EQUAL(1u, replay.GetNumFrames());
+	CHECK_EQUAL(size_t(17), replay.GetCommands().size());
+	CHECK_EQUAL(size_t(1), replay.GetNames().size());
+	CHECK(replay.GetNames().front() == "GeometryPass");
+
+	const CommandStreamReplay::Command& draw = replay.GetCommands().at(9);
+	CHECK(draw.command == StreamCommand::DrawIndexed);
+	CHECK_EQUAL(36u, draw.arguments[0]);
+	CHECK_EQUAL(1u, draw.arguments[3]);
+
+	// capture was saved to file too
+	CommandStreamReplay fileReplay;
+
+	CHECK(fileReplay.LoadFromFile(GetCapturePath()));
+	CHECK_EQUAL(replay.GetCommands().size(), fileReplay.GetCommands().size());
+
+	std::filesystem::remove(GetCapturePath());
+	CHECK(!fileReplay.LoadFromFile(GetCapturePath()));
+}
+
+TEST_CASE("redundant calls are counted the way command list filters them")
+{
+	CommandStreamReplay replay;
+	CHECK(replay.Load(CaptureFrame()));
+
+	CommandStreamReplay::RedundancyStats stats = replay.AnalyzeRedundancy();
+
+	CHECK_EQUAL(uint64_t(3), stats.numDraws);
+	CHECK_EQUAL(uint64_t(3), stats.numInstances);
+	CHECK_EQUAL(uint64_t(1), stats.numDrawSegments);
+	CHECK_EQUAL(2u, stats.numPipelineStates);
+	CHECK_EQUAL(1u, stats.numRootSignatures);
+
+	const CommandStreamReplay::CommandRedundancy& rootParams = stats.commands[size_t(StreamCommand::SetGraphicsRootParam)];
+	CHECK_EQUAL(uint64_t(2), rootParams.requested);
+	CHECK_EQUAL(uint64_t(1), rootParams.redundant);
+	CHECK_EQUAL(uint64_t(0), stats.commands[size_t(StreamCommand::SetPipelineState)].redundant);
+}
+
+TEST_CASE("strategies reorder and merge draws of one segment")
+{
+	CommandStreamReplay replay;
+	CHECK(replay.Load(CaptureFrame()));
+
+	CommandStreamReplay::StrategyResult asRecorded = replay.Retime(Strategy::AsRecorded, 1);
+	CHECK_EQUAL(uint64_t(3), asRecorded.numDrawCalls);
+	CHECK_EQUAL(uint64_t(8), asRecorded.numStateChanges);
+
+	CommandStreamReplay::StrategyResult sorted = replay.Retime(Strategy::SortByPipelineState, 1);
+	CHECK_EQUAL(uint64_t(3), sorted.numDrawCalls);
+	CHECK_EQUAL(uint64_t(7), sorted.numStateChanges);
+
+	CommandStreamReplay::StrategyResult batched = replay.Retime(Strategy::SortByStateAndBatch, 1);
+	CHECK_EQUAL(uint64_t(2), batched.numDrawCalls);
+
+	CHECK(replay.GetReport(1).find("Sort by state and batch: 2 draw calls") != std::string::npos);
+}
+
+TEST_CASE("truncated streams are rejected")
+{
+	std::vector<uint8_t> capture = CaptureFrame();
+	CommandStreamReplay replay;
+
+	for (size_t size = 0; size < capture.size(); size++)
+	{
+		CHECK(!replay.Load(std::span(capture.data(), size)));
+		CHECK(replay.GetCommands().empty());
+	}
+
+	CHECK(replay.Load(capture));
+}
+
+TEST_CASE("streams with wrong magic or version are rejected")
+{
+	std::vector<uint8_t> capture = CaptureFrame();
+	CommandStreamReplay replay;
+
+	std::vector<uint8_t> badMagic = capture;
+	badMagic.at(0) ^= 0xFF;
+	CHECK(!replay.Load(badMagic));
+
+	std::vector<uint8_t> badVersion = capture;
+	uint32_t version = CommandStream::fileVersion + 1;
+	std::memcpy(badVersion.data() + sizeof(uint32_t), &version, sizeof(version));
+	CHECK(!replay.Load(badVersion));
+
+	CHECK(!replay.Load({}));
+}
+
+TEST_CASE("commands out of range are rejected")
+{
+	CommandStreamReplay replay;
+
+	// the last command is one byte of CloseList and its argument
+	std::vector<uint8_t> unknownCommand = CaptureFrame();
+	unknownCommand.at(unknownCommand.size() - 1 - sizeof(uint32_t)) = uint8_t(StreamCommand::Count);
+	CHECK(!replay.Load(unknownCommand));
+
+	CHECK(!replay.Load(CaptureFrame(64)));
+	CHECK(replay.Load(CaptureFrame(63)));
+}
\ No newline at end of file
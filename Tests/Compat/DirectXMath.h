@@ -0,0 +1,231 @@
+#pragma once
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// scalar stand-in for the part of DirectXMath used by modules under test, so they build where the real headers aren't available.
+// Follows DirectXMath conventions: row vectors multiplied from the left, comparisons return lanes with all bits set
+namespace DirectX
+{
+	constexpr float XM_PIDIV2 = 1.570796327f;
+
+	struct XMFLOAT2
+	{
+		float x, y;
+
+		XMFLOAT2() = default;
+		constexpr XMFLOAT2(float x_, float y_) : x(x_), y(y_) {}
+	};
+
+	struct XMFLOAT3
+	{
+		float x, y, z;
+
+		XMFLOAT3() = default;
+		constexpr XMFLOAT3(float x_, float y_, float z_) : x(x_), y(y_), z(z_) {}
+	};
+
+	struct XMFLOAT4
+	{
+		float x, y, z, w;
+
+		XMFLOAT4() = default;
+		constexpr XMFLOAT4(float x_, float y_, float z_, float w_) : x(x_), y(y_), z(z_), w(w_) {}
+	};
+
+	struct XMFLOAT4X4
+	{
+		union
+		{
+			struct
+			{
+				float _11, _12, _13, _14;
+				float _21, _22, _23, _24;
+				float _31, _32, _33, _34;
+				float _41, _42, _43, _44;
+			};
+			float m[4][4];
+		};
+	};
+
+	struct XMVECTOR
+	{
+		float f[4];
+	};
+
+	struct XMMATRIX
+	{
+		XMVECTOR r[4];
+	};
+
+	namespace Compat
+	{
+		inline uint32_t GetBits(float value)
+		{
+			uint32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			return bits;
+		}
+
+		inline float FromBits(uint32_t bits)
+		{
+			float value;
+			std::memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+
+		inline float Mask(bool condition)
+		{
+			return FromBits(condition ? 0xFFFFFFFFu : 0u);
+		}
+	}
+
+	inline XMVECTOR XMVectorSet(float x, float y, float z, float w) { return { { x, y, z, w } }; }
+	inline XMVECTOR XMVectorZero() { return { { 0.0f, 0.0f, 0.0f, 0.0f } }; }
+	inline XMVECTOR XMVectorReplicate(float value) { return { { value, value, value, value } }; }
+
+	inline XMVECTOR XMLoadFloat3(const XMFLOAT3* source) { return { { source->x, source->y, source->z, 0.0f } }; }
+	inline XMVECTOR XMLoadFloat4(const XMFLOAT4* source) { return { { source->x, source->y, source->z, source->w } }; }
+	inline void XMStoreFloat4(XMFLOAT4* destination, XMVECTOR v) { *destination = { v.f[0], v.f[1], v.f[2], v.f[3] }; }
+
+	inline XMVECTOR XMVectorAdd(XMVECTOR a, XMVECTOR b)
+	{
+		return { { a.f[0] + b.f[0], a.f[1] + b.f[1], a.f[2] + b.f[2], a.f[3] + b.f[3] } };
+	}
+
+	inline XMVECTOR XMVectorMultiplyAdd(XMVECTOR a, XMVECTOR b, XMVECTOR c)
+	{
+		return { { a.f[0] * b.f[0] + c.f[0], a.f[1] * b.f[1] + c.f[1], a.f[2] * b.f[2] + c.f[2], a.f[3] * b.f[3] + c.f[3] } };
+	}
+
+	inline XMVECTOR XMVectorMin(XMVECTOR a, XMVECTOR b)
+	{
+		return { { std::fmin(a.f[0], b.f[0]), std::fmin(a.f[1], b.f[1]), std::fmin(a.f[2], b.f[2]), std::fmin(a.f[3], b.f[3]) } };
+	}
+
+	inline XMVECTOR XMVectorGreaterOrEqual(XMVECTOR a, XMVECTOR b)
+	{
+		XMVECTOR result;
+		for (int lane = 0; lane < 4; lane++)
+			result.f[lane] = Compat::Mask(a.f[lane] >= b.f[lane]);
+		return result;
+	}
+
+	inline XMVECTOR XMVectorAndInt(XMVECTOR a, XMVECTOR b)
+	{
+		XMVECTOR result;
+		for (int lane = 0; lane < 4; lane++)
+			result.f[lane] = Compat::FromBits(Compat::GetBits(a.f[lane]) & Compat::GetBits(b.f[lane]));
+		return result;
+	}
+
+	// lanes of b where control bits are set, lanes of a elsewhere
+	inline XMVECTOR XMVectorSelect(XMVECTOR a, XMVECTOR b, XMVECTOR control)
+	{
+		XMVECTOR result;
+		for (int lane = 0; lane < 4; lane++)
+		{
+			uint32_t mask = Compat::GetBits(control.f[lane]);
+			result.f[lane] = Compat::FromBits((Compat::GetBits(a.f[lane]) & ~mask) | (Compat::GetBits(b.f[lane]) & mask));
+		}
+		return result;
+	}
+
+	inline bool XMVector4EqualInt(XMVECTOR a, XMVECTOR b)
+	{
+		for (int lane = 0; lane < 4; lane++)
+			if (Compat::GetBits(a.f[lane]) != Compat::GetBits(b.f[lane]))
+				return false;
+		return true;
+	}
+
+	inline bool XMVector4Equal(XMVECTOR a, XMVECTOR b)
+	{
+		return a.f[0] == b.f[0] && a.f[1] == b.f[1] && a.f[2] == b.f[2] && a.f[3] == b.f[3];
+	}
+
+	inline XMVECTOR XMVector4Transform(XMVECTOR v, const XMMATRIX& m)
+	{
+		XMVECTOR result;
+		for (int column = 0; column < 4; column++)
+			result.f[column] = v.f[0] * m.r[0].f[column] + v.f[1] * m.r[1].f[column] + v.f[2] * m.r[2].f[column] + v.f[3] * m.r[3].f[column];
+		return result;
+	}
+
+	// w of input is treated as 1
+	inline XMVECTOR XMVector3Transform(XMVECTOR v, const XMMATRIX& m)
+	{
+		return XMVector4Transform(XMVectorSet(v.f[0], v.f[1], v.f[2], 1.0f), m);
+	}
+
+	inline XMMATRIX operator*(const XMMATRIX& a, const XMMATRIX& b)
+	{
+		XMMATRIX result;
+		for (int row = 0; row < 4; row++)
+			result.r[row] = XMVector4Transform(a.r[row], b);
+		return result;
+	}
+
+	inline XMMATRIX XMLoadFloat4x4(const XMFLOAT4X4* source)
+	{
+		XMMATRIX result;
+		for (int row = 0; row < 4; row++)
+			result.r[row] = XMVectorSet(source->m[row][0], source->m[row][1], source->m[row][2], source->m[row][3]);
+		return result;
+	}
+
+	inline void XMStoreFloat4x4(XMFLOAT4X4* destination, const XMMATRIX& m)
+	{
+		for (int row = 0; row < 4; row++)
+			for (int column = 0; column < 4; column++)
+				destination->m[row][column] = m.r[row].f[column];
+	}
+
+	inline XMMATRIX XMMatrixIdentity()
+	{
+		return { { XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f), XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f) } };
+	}
+
+	inline XMMATRIX XMMatrixScaling(float x, float y, float z)
+	{
+		return { { XMVectorSet(x, 0.0f, 0.0f, 0.0f), XMVectorSet(0.0f, y, 0.0f, 0.0f), XMVectorSet(0.0f, 0.0f, z, 0.0f), XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f) } };
+	}
+
+	inline XMMATRIX XMMatrixTranslation(float x, float y, float z)
+	{
+		return { { XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f), XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), XMVectorSet(x, y, z, 1.0f) } };
+	}
+
+	inline XMMATRIX XMMatrixLookToLH(XMVECTOR eyePosition, XMVECTOR eyeDirection, XMVECTOR upDirection)
+	{
+		auto dot = [](XMVECTOR a, XMVECTOR b) { return a.f[0] * b.f[0] + a.f[1] * b.f[1] + a.f[2] * b.f[2]; };
+		auto cross = [](XMVECTOR a, XMVECTOR b) { return XMVectorSet(a.f[1] * b.f[2] - a.f[2] * b.f[1], a.f[2] * b.f[0] - a.f[0] * b.f[2], a.f[0] * b.f[1] - a.f[1] * b.f[0], 0.0f); };
+		auto normalize = [&](XMVECTOR v) { float length = std::sqrt(dot(v, v)); return XMVectorSet(v.f[0] / length, v.f[1] / length, v.f[2] / length, 0.0f); };
+
+		XMVECTOR zAxis = normalize(eyeDirection);
+		XMVECTOR xAxis = normalize(cross(upDirection, zAxis));
+		XMVECTOR yAxis = cross(zAxis, xAxis);
+
+		return { {
+			XMVectorSet(xAxis.f[0], yAxis.f[0], zAxis.f[0], 0.0f),
+			XMVectorSet(xAxis.f[1], yAxis.f[1], zAxis.f[1], 0.0f),
+			XMVectorSet(xAxis.f[2], yAxis.f[2], zAxis.f[2], 0.0f),
+			XMVectorSet(-dot(xAxis, eyePosition), -dot(yAxis, eyePosition), -dot(zAxis, eyePosition), 1.0f)
+		} };
+	}
+
+	inline XMMATRIX XMMatrixPerspectiveFovLH(float fovAngleY, float aspectRatio, float nearZ, float farZ)
+	{
+		float height = 1.0f / std::tan(fovAngleY * 0.5f);
+		float width = height / aspectRatio;
+		float range = farZ / (farZ - nearZ);
+
+		return { {
+			XMVectorSet(width, 0.0f, 0.0f, 0.0f),
+			XMVectorSet(0.0f, height, 0.0f, 0.0f),
+			XMVectorSet(0.0f, 0.0f, range, 1.0f),
+			XMVectorSet(0.0f, 0.0f, -range * nearZ, 0.0f)
+		} };
+	}
+}
\ No newline at end of file
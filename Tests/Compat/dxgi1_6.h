@@ -0,0 +1,4 @@
+#pragma once
+#include <dxgiformat.h>
+
+// stand-in, modules under test only use formats
\ No newline at end of file
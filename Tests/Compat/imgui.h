@@ -0,0 +1,11 @@
+#pragma once
+
+// no-op stand-in for the few imgui calls of modules that draw their own debug window, tests never draw them
+namespace ImGui
+{
+	inline bool Begin(const char*, bool* = nullptr, int = 0) { return false; }
+	inline void End() {}
+	inline bool Button(const char*) { return false; }
+	inline void Text(const char*, ...) {}
+	inline void TextUnformatted(const char*, const char* = nullptr) {}
+}
\ No newline at end of file
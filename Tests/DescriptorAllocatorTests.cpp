@@ -0,0 +1,132 @@
+#include "TestFramework.h"
+#include "Graphics/Resources/DescriptorAllocator.h"
+
+namespace
+{
+	// stands in for GPU fence, frames complete only when test says so
+	class FakeFence
+	{
+	public:
+		// the same as DescriptorHeap::BeginFrame(), frames that GPU finished are retired in allocator
+		void BeginFrame(DescriptorAllocator& allocator)
+		{
+			m_frameNumber++;
+
+			if (m_completedFrame)
+				allocator.Retire(*m_completedFrame);
+		}
+
+		void CompleteFrame(size_t frameNumber)
+		{
+			m_completedFrame = frameNumber;
+		}
+
+		size_t GetFrameNumber() const
+		{
+			return m_frameNumber;
+		}
+
+	private:
+		size_t m_frameNumber = 0;
+		std::optional<size_t> m_completedFrame;
+	};
+}
+
+TEST_CASE("freed range isn't reused before its frame completes")
+{
+	DescriptorAllocator allocator(8);
+	FakeFence fence;
+
+	CHECK_EQUAL(std::optional<unsigned int>(0), allocator.Allocate(4));
+	CHECK_EQUAL(std::optional<unsigned int>(4), allocator.Allocate(4));
+
+	allocator.Free(0, 4, fence.GetFrameNumber());
+	CHECK_EQUAL(4u, allocator.GetNumPending());
+
+	// GPU is still behind, frame that freed the range can read it
+	fence.BeginFrame(allocator);
+	fence.BeginFrame(allocator);
+	CHECK(!allocator.Allocate(1).has_value());
+
+	fence.CompleteFrame(0);
+	fence.BeginFrame(allocator);
+
+	CHECK_EQUAL(0u, allocator.GetNumPending());
+	CHECK_EQUAL(std::optional<unsigned int>(0), allocator.Allocate(4));
+}
+
+TEST_CASE("ranges freed in different frames retire separately")
+{
+	DescriptorAllocator allocator(16);
+	FakeFence fence;
+
+	CHECK_EQUAL(std::optional<unsigned int>(0), allocator.Allocate(4));
+	CHECK_EQUAL(std::optional<unsigned int>(4), allocator.Allocate(4));
+	CHECK_EQUAL(std::optional<unsigned int>(8), allocator.Allocate(4));
+
+	allocator.Free(0, 4, fence.GetFrameNumber());
+	fence.BeginFrame(allocator);
+	allocator.Free(4, 4, fence.GetFrameNumber());
+	fence.BeginFrame(allocator);
+
+	fence.CompleteFrame(0);
+	fence.BeginFrame(allocator);
+
+	CHECK_EQUAL(4u, allocator.GetNumPending());
+
+	// only the first range is back, it isn't contiguous with the free end of heap
+	CHECK_EQUAL(8u, allocator.GetNumFree());
+	CHECK(!allocator.Allocate(8).has_value());
+
+	fence.CompleteFrame(1);
+	fence.BeginFrame(allocator);
+
+	// neighbouring ranges were merged
+	CHECK_EQUAL(std::optional<unsigned int>(0), allocator.Allocate(8));
+}
+
+TEST_CASE("range at the end of used part goes back to bump allocation")
+{
+	DescriptorAllocator allocator(8);
+	FakeFence fence;
+
+	allocator.Allocate(2);
+	allocator.Allocate(6);
+
+	allocator.Free(2, 6, fence.GetFrameNumber());
+	fence.CompleteFrame(0);
+	fence.BeginFrame(allocator);
+
+	CHECK_EQUAL(2u, allocator.GetUsedExtent());
+	CHECK_EQUAL(6u, allocator.GetNumFree());
+}
+
+TEST_CASE("grown allocator keeps handed out indices")
+{
+	DescriptorAllocator allocator(4);
+
+	CHECK_EQUAL(std::optional<unsigned int>(0), allocator.Allocate(4));
+	CHECK(!allocator.Allocate(1).has_value());
+
+	allocator.Grow(8);
+
+	CHECK_EQUAL(std::optional<unsigned int>(4), allocator.Allocate(4));
+	CHECK_THROWS(allocator.Grow(4));
+}
+
+TEST_CASE("double free and free of never allocated range throw")
+{
+	DescriptorAllocator allocator(8);
+	FakeFence fence;
+
+	allocator.Allocate(4);
+
+	CHECK_THROWS(allocator.Free(4, 2, fence.GetFrameNumber()));
+
+	allocator.Allocate(2);
+	allocator.Free(0, 2, fence.GetFrameNumber());
+	allocator.Free(0, 2, fence.GetFrameNumber());
+
+	fence.CompleteFrame(0);
+	CHECK_THROWS(fence.BeginFrame(allocator));
+}
\ No newline at end of file
@@ -0,0 +1,189 @@
+#include "TestFramework.h"
+#include "Graphics/RenderGraph/FrameGraphCompiler.h"
+
+using ResourceHandle = FrameGraphCompiler::ResourceHandle;
+using PassHandle = FrameGraphCompiler::PassHandle;
+
+static unsigned int GetPosition(const FrameGraphCompiler::CompiledGraph& compiledGraph, PassHandle pass)
+{
+	auto passIt = std::find(compiledGraph.passOrder.begin(), compiledGraph.passOrder.end(), pass);
+
+	return static_cast<unsigned int>(passIt - compiledGraph.passOrder.begin());
+}
+
+TEST_CASE("readers are ordered after writers declared later")
+{
+	FrameGraphCompiler frameGraph;
+
+	ResourceHandle color = frameGraph.CreateTransientResource("color", 1024, 256);
+	ResourceHandle output = frameGraph.ImportResource("output");
+
+	PassHandle present = frameGraph.AddPass("present", { color }, { output });
+	PassHandle draw = frameGraph.AddPass("draw", {}, { color });
+
+	FrameGraphCompiler::CompiledGraph compiledGraph = frameGraph.Compile();
+
+	CHECK_EQUAL(2u, compiledGraph.passOrder.size());
+	CHECK(GetPosition(compiledGraph, draw) < GetPosition(compiledGraph, present));
+}
+
+TEST_CASE("reader is placed between writers and independent passes keep declaration order")
+{
+	FrameGraphCompiler frameGraph;
+
+	ResourceHandle depth = frameGraph.ImportResource("depth");
+	ResourceHandle color = frameGraph.ImportResource("color");
+
+	PassHandle clear = frameGraph.AddPass("clear", {}, { depth });
+	PassHandle read = frameGraph.AddPass("read", { depth }, { color });
+	PassHandle overwrite = frameGraph.AddPass("overwrite", {}, { depth });
+	PassHandle independent = frameGraph.AddPass("independent", {}, {});
+
+	FrameGraphCompiler::CompiledGraph compiledGraph = frameGraph.Compile();
+
+	CHECK(GetPosition(compiledGraph, clear) < GetPosition(compiledGraph, read));
+	CHECK(GetPosition(compiledGraph, read) < GetPosition(compiledGraph, overwrite));
+	CHECK_EQUAL(3u, GetPosition(compiledGraph, independent));
+}
+
+TEST_CASE("cycle is reported")
+{
+	FrameGraphCompiler frameGraph;
+
+	ResourceHandle a = frameGraph.ImportResource("a");
+	ResourceHandle b = frameGraph.ImportResource("b");
+
+	frameGraph.AddPass("first", { b }, { a });
+	frameGraph.AddPass("second", { a }, { b });
+	frameGraph.AddPass("third", {}, { b });
+
+	CHECK_THROWS(frameGraph.Compile());
+}
+
+TEST_CASE("lifetimes span from first to last use")
+{
+	FrameGraphCompiler frameGraph;
+
+	ResourceHandle a = frameGraph.CreateTransientResource("a", 100, 1);
+	ResourceHandle b = frameGraph.CreateTransientResource("b", 100, 1);
+	ResourceHandle unused = frameGraph.CreateTransientResource("unused", 100, 1);
+
+	frameGraph.AddPass("writeA", {}, { a });
+	frameGraph.AddPass("readA", { a }, { b });
+	frameGraph.AddPass("readB", { b }, {});
+
+	FrameGraphCompiler::CompiledGraph compiledGraph = frameGraph.Compile();
+
+	CHECK_EQUAL(0u, compiledGraph.lifetimes.at(a).firstUse);
+	CHECK_EQUAL(1u, compiledGraph.lifetimes.at(a).lastUse);
+	CHECK_EQUAL(1u, compiledGraph.lifetimes.at(b).firstUse);
+	CHECK_EQUAL(2u, compiledGraph.lifetimes.at(b).lastUse);
+
+	CHECK(!compiledGraph.lifetimes.at(unused).IsUsed());
+	CHECK(compiledGraph.lifetimes.at(a).Overlaps(compiledGraph.lifetimes.at(b)));
+}
+
+TEST_CASE("resources that aren't alive at the same time share memory")
+{
+	FrameGraphCompiler frameGraph;
+
+	ResourceHandle a = frameGraph.CreateTransientResource("a", 1000, 256);
+	ResourceHandle b = frameGraph.CreateTransientResource("b", 500, 256);
+	ResourceHandle c = frameGraph.CreateTransientResource("c", 800, 256);
+	ResourceHandle output = frameGraph.ImportResource("output");
+
+	frameGraph.AddPass("writeA", {}, { a });
+	frameGraph.AddPass("readAWriteB", { a }, { b });
+	frameGraph.AddPass("readBWriteC", { b }, { c });
+	frameGraph.AddPass("readC", { c }, { output });
+	frameGraph.MarkOutput(output);
+
+	FrameGraphCompiler::CompiledGraph compiledGraph = frameGraph.Compile();
+
+	// a and c never live together, b overlaps both
+	CHECK_EQUAL(size_t(0), compiledGraph.memoryOffsets.at(a));
+	CHECK_EQUAL(size_t(0), compiledGraph.memoryOffsets.at(c));
+	CHECK_EQUAL(size_t(1024), compiledGraph.memoryOffsets.at(b));
+
+	CHECK_EQUAL(size_t(1024 + 500), compiledGraph.aliasedMemorySize);
+	CHECK_EQUAL(size_t(1024 + 512 + 800), compiledGraph.unaliasedMemorySize);
+}
+
+TEST_CASE("aliasing barrier is planned at first use of resource that takes over memory")
+{
+	FrameGraphCompiler frameGraph;
+
+	ResourceHandle a = frameGraph.CreateTransientResource("a", 1000, 256);
+	ResourceHandle b = frameGraph.CreateTransientResource("b", 500, 256);
+	ResourceHandle c = frameGraph.CreateTransientResource("c", 800, 256);
+	ResourceHandle output = frameGraph.ImportResource("output");
+
+	frameGraph.AddPass("writeA", {}, { a });
+	frameGraph.AddPass("readAWriteB", { a }, { b });
+	frameGraph.AddPass("readBWriteC", { b }, { c });
+	frameGraph.AddPass("readC", { c }, { output });
+
+	FrameGraphCompiler::CompiledGraph compiledGraph = frameGraph.Compile();
+
+	CHECK_EQUAL(4u, compiledGraph.aliasingBarriers.size());
+
+	// a is the first user of its memory in the frame, c used it last in previous one
+	CHECK_EQUAL(1u, compiledGraph.aliasingBarriers.at(0).size());
+	CHECK_EQUAL(FrameGraphCompiler::invalidResource, compiledGraph.aliasingBarriers.at(0).at(0).resourceBefore);
+	CHECK_EQUAL(a, compiledGraph.aliasingBarriers.at(0).at(0).resourceAfter);
+
+	// b doesn't share memory with anything
+	CHECK(compiledGraph.aliasingBarriers.at(1).empty());
+
+	CHECK_EQUAL(1u, compiledGraph.aliasingBarriers.at(2).size());
+	CHECK_EQUAL(a, compiledGraph.aliasingBarriers.at(2).at(0).resourceBefore);
+	CHECK_EQUAL(c, compiledGraph.aliasingBarriers.at(2).at(0).resourceAfter);
+
+	CHECK(compiledGraph.aliasingBarriers.at(3).empty());
+}
+
+TEST_CASE("imported resources are never placed or aliased")
+{
+	FrameGraphCompiler frameGraph;
+
+	ResourceHandle imported = frameGraph.ImportResource("imported");
+	ResourceHandle transient = frameGraph.CreateTransientResource("transient", 64, 64);
+
+	frameGraph.AddPass("write", {}, { imported, transient });
+	frameGraph.AddPass("read", { transient }, {});
+
+	FrameGraphCompiler::CompiledGraph compiledGraph = frameGraph.Compile();
+
+	CHECK_EQUAL(size_t(64), compiledGraph.aliasedMemorySize);
+
+	for (const std::vector<FrameGraphCompiler::AliasingBarrier>& barriers : compiledGraph.aliasingBarriers)
+		CHECK(barriers.empty());
+
+	CHECK_THROWS(frameGraph.CreateTransientResource("badAlignment", 64, 3));
+}
+
+TEST_CASE("passes that don't contribute to outputs are culled")
+{
+	FrameGraphCompiler frameGraph;
+
+	ResourceHandle color = frameGraph.CreateTransientResource("color", 64, 64);
+	ResourceHandle debug = frameGraph.CreateTransientResource("debug", 64, 64);
+	ResourceHandle output = frameGraph.ImportResource("output");
+
+	PassHandle draw = frameGraph.AddPass("draw", {}, { color });
+	PassHandle drawDebug = frameGraph.AddPass("drawDebug", {}, { debug });
+	PassHandle present = frameGraph.AddPass("present", { color }, { output });
+	frameGraph.MarkOutput(output);
+
+	FrameGraphCompiler::CompiledGraph compiledGraph = frameGraph.Compile();
+
+	std::vector<bool> livePasses = frameGraph.GetLivePasses(compiledGraph, { true, true, true });
+
+	CHECK(livePasses.at(draw));
+	CHECK(!livePasses.at(drawDebug));
+	CHECK(livePasses.at(present));
+
+	// nothing needs color when its reader is disabled
+	livePasses = frameGraph.GetLivePasses(compiledGraph, { true, true, false });
+	CHECK(!livePasses.at(draw));
+}
\ No newline at end of file
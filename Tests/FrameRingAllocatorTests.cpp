@@ -0,0 +1,94 @@
+#include "TestFramework.h"
+#include "Graphics/Resources/FrameRingAllocator.h"
+
+TEST_CASE("allocations are aligned and follow each other")
+{
+	FrameRingAllocator ring(1024);
+
+	CHECK_EQUAL(std::optional<size_t>(0), ring.Allocate(10, 16));
+	CHECK_EQUAL(std::optional<size_t>(16), ring.Allocate(10, 16));
+	CHECK_EQUAL(std::optional<size_t>(256), ring.Allocate(4, 256));
+
+	CHECK_EQUAL(size_t(260), ring.GetUsedSize());
+	CHECK_THROWS(ring.Allocate(4, 3));
+}
+
+TEST_CASE("allocation that doesn't fit at the end wraps to beginning")
+{
+	FrameRingAllocator ring(256);
+
+	CHECK_EQUAL(std::optional<size_t>(0), ring.Allocate(128, 1));
+	ring.FinishFrame(1);
+
+	CHECK_EQUAL(std::optional<size_t>(128), ring.Allocate(96, 1));
+	ring.FinishFrame(2);
+
+	// frame 1 is still in flight, so wrapped allocation has no space
+	CHECK(!ring.Allocate(64, 1).has_value());
+
+	ring.Retire(1);
+	CHECK_EQUAL(size_t(96), ring.GetUsedSize());
+
+	// 32 bytes at the end are skipped and counted as padding of the new frame
+	CHECK_EQUAL(std::optional<size_t>(0), ring.Allocate(64, 1));
+	CHECK_EQUAL(size_t(96 + 32 + 64), ring.GetUsedSize());
+	ring.FinishFrame(3);
+
+	// wrapped allocation can't overwrite frame 2 which is still alive
+	CHECK(!ring.Allocate(96, 1).has_value());
+	CHECK_EQUAL(std::optional<size_t>(64), ring.Allocate(64, 1));
+}
+
+TEST_CASE("retire releases only completed frames")
+{
+	FrameRingAllocator ring(1024);
+
+	for (size_t frameNumber = 1; frameNumber <= 3; frameNumber++)
+	{
+		ring.Allocate(100, 4);
+		ring.FinishFrame(frameNumber);
+	}
+
+	CHECK_EQUAL(3u, ring.GetNumFramesInFlight());
+
+	ring.Retire(0);
+	CHECK_EQUAL(3u, ring.GetNumFramesInFlight());
+
+	ring.Retire(2);
+	CHECK_EQUAL(1u, ring.GetNumFramesInFlight());
+	CHECK_EQUAL(size_t(100), ring.GetUsedSize());
+
+	ring.Retire(3);
+	CHECK_EQUAL(0u, ring.GetNumFramesInFlight());
+	CHECK_EQUAL(size_t(0), ring.GetUsedSize());
+
+	// empty ring starts from beginning again
+	CHECK_EQUAL(std::optional<size_t>(0), ring.Allocate(8, 4));
+}
+
+TEST_CASE("frame without allocations isn't tracked and frame numbers have to increase")
+{
+	FrameRingAllocator ring(64);
+
+	ring.FinishFrame(1);
+	CHECK_EQUAL(0u, ring.GetNumFramesInFlight());
+
+	ring.Allocate(8, 4);
+	ring.FinishFrame(2);
+	CHECK_THROWS(ring.FinishFrame(2));
+}
+
+TEST_CASE("reset drops every allocation")
+{
+	FrameRingAllocator ring(64);
+
+	ring.Allocate(32, 4);
+	ring.FinishFrame(1);
+
+	ring.Reset(128);
+
+	CHECK_EQUAL(size_t(128), ring.GetCapacity());
+	CHECK_EQUAL(size_t(0), ring.GetUsedSize());
+	CHECK_EQUAL(0u, ring.GetNumFramesInFlight());
+	CHECK_EQUAL(std::optional<size_t>(0), ring.Allocate(128, 4));
+}
\ No newline at end of file
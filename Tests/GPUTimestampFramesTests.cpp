@@ -0,0 +1,121 @@
+#include "TestFramework.h"
+#include "Graphics/Profiler/GPUTimestampFrames.h"
+
+namespace
+{
+	constexpr uint64_t frequency = 1000000; // one tick is a microsecond
+}
+
+TEST_CASE("frame slots wrap around to their own query ranges")
+{
+	GPUTimestampFrames frames(2, 8);
+
+	CHECK_EQUAL(16u, frames.GetNumQueriesTotal());
+
+	for (size_t frameNumber = 1; frameNumber <= 3; frameNumber++)
+	{
+		unsigned int frameSlot = static_cast<unsigned int>(frameNumber % 2);
+
+		frames.BeginFrame(frameSlot, frameNumber, {});
+
+		CHECK_EQUAL(std::optional<unsigned int>(frames.GetFirstQuery(frameSlot)), frames.BeginZone("Frame"));
+		CHECK_EQUAL(std::optional<unsigned int>(frames.GetFirstQuery(frameSlot) + 1), frames.EndZone());
+	}
+
+	CHECK_EQUAL(0u, frames.GetFirstQuery(0));
+	CHECK_EQUAL(8u, frames.GetFirstQuery(1));
+
+	// frame 3 reused slot of frame 1, so only its timestamps are resolved
+	std::vector<uint64_t> timestamps = { 100, 350 };
+
+	CHECK(frames.ResolveFrame(1, 3, timestamps, frequency));
+	CHECK_EQUAL(size_t(1), frames.GetResolvedZones().size());
+	CHECK_EQUAL(0.25, frames.GetResolvedZones()[0].durationMs);
+}
+
+TEST_CASE("zones that don't fit are dropped with their children")
+{
+	GPUTimestampFrames frames(1, 3);
+
+	frames.BeginFrame(0, 1, {});
+
+	CHECK(frames.BeginZone("Frame").has_value());
+	CHECK(!frames.BeginZone("Pass").has_value()); // end query of frame has to stay available
+	CHECK(!frames.BeginZone("Draw").has_value());
+	CHECK(!frames.EndZone().has_value());
+	CHECK(!frames.EndZone().has_value());
+	CHECK(frames.EndZone().has_value());
+
+	CHECK_EQUAL(2u, frames.GetNumQueries(0));
+	CHECK_THROWS(frames.EndZone());
+}
+
+TEST_CASE("frame that wasn't retired isn't resolved")
+{
+	GPUTimestampFrames frames(2, 8);
+	std::vector<uint64_t> timestamps = { 10, 20, 30, 40 };
+
+	frames.BeginFrame(0, 4, {});
+	frames.BeginZone("Frame");
+	frames.BeginZone("Pass");
+	frames.EndZone();
+	frames.EndZone();
+
+	// GPU may still be writing queries of frame 4
+	CHECK(!frames.ResolveFrame(0, 3, timestamps, frequency));
+
+	CHECK(frames.ResolveFrame(0, 4, timestamps, frequency));
+	CHECK_EQUAL(size_t(2), frames.GetResolvedZones().size());
+
+	// slot that was never recorded has nothing to resolve
+	CHECK(!frames.ResolveFrame(1, 4, timestamps, frequency));
+
+	std::vector<uint64_t> missingTimestamps = { 10, 20 };
+	CHECK_THROWS(frames.ResolveFrame(0, 4, missingTimestamps, frequency));
+}
+
+TEST_CASE("zone start is moved to CPU time through calibration of its frame")
+{
+	GPUTimestampFrames frames(2, 8);
+
+	GPUTimestampFrames::ClockCalibration firstCalibration = {};
+	firstCalibration.gpuTimestamp = 1000;
+	firstCalibration.cpuTime = 5000000000ull;
+
+	GPUTimestampFrames::ClockCalibration secondCalibration = {};
+	secondCalibration.gpuTimestamp = 2000;
+	secondCalibration.cpuTime = 9000000000ull;
+
+	frames.BeginFrame(0, 1, firstCalibration);
+	frames.BeginZone("Frame");
+	frames.EndZone();
+
+	frames.BeginFrame(1, 2, secondCalibration);
+	frames.BeginZone("Frame");
+	frames.EndZone();
+
+	std::vector<uint64_t> timestamps = { 1500, 1600 };
+
+	CHECK(frames.ResolveFrame(0, 2, timestamps, frequency));
+	CHECK_EQUAL(uint64_t(5000500000ull), frames.GetResolvedZones()[0].cpuStartTime);
+
+	CHECK(frames.ResolveFrame(1, 2, timestamps, frequency));
+	CHECK_EQUAL(uint64_t(8999500000ull), frames.GetResolvedZones()[0].cpuStartTime);
+}
+
+TEST_CASE("tick conversion doesn't overflow")
+{
+	constexpr uint64_t performanceFrequency = 10000000;
+
+	// a year of ticks would overflow if multiplied before division
+	uint64_t ticks = 365ull * 24 * 3600 * performanceFrequency + 1;
+
+	CHECK_EQUAL(uint64_t(365ull * 24 * 3600 * 1000000000ull + 100), GPUTimestampFrames::TicksToNanoseconds(ticks, performanceFrequency));
+
+	GPUTimestampFrames::ClockCalibration calibration = {};
+	calibration.gpuTimestamp = 1000;
+	calibration.cpuTime = 100;
+
+	// timestamp from before CPU clock started is clamped
+	CHECK_EQUAL(uint64_t(0), GPUTimestampFrames::ToCpuTime(calibration, 0, frequency));
+}
\ No newline at end of file
@@ -0,0 +1,172 @@
+#include "TestFramework.h"
+#include "Graphics/Core/NullDevice.h"
+
+namespace
+{
+	NullDevice::ResourceDesc BufferDesc(uint64_t byteSize)
+	{
+		NullDevice::ResourceDesc desc = {};
+		desc.dimension = NullDevice::ResourceDesc::Dimension::buffer;
+		desc.width = byteSize;
+
+		return desc;
+	}
+
+	NullDevice::ResourceDesc TextureDesc(unsigned int width, unsigned int height, unsigned int bitsPerTexel, unsigned int mipLevels = 1, bool blockCompressed = false)
+	{
+		NullDevice::ResourceDesc desc = {};
+		desc.dimension = NullDevice::ResourceDesc::Dimension::texture;
+		desc.width = width;
+		desc.height = height;
+		desc.mipLevels = mipLevels;
+		desc.bitsPerTexel = bitsPerTexel;
+		desc.blockCompressed = blockCompressed;
+
+		return desc;
+	}
+}
+
+TEST_CASE("resources are counted while alive and peak memory is kept")
+{
+	NullDevice device;
+
+	{
+		std::unique_ptr<NullDevice::Resource> first = device.CreateResource(BufferDesc(1000), false);
+		std::unique_ptr<NullDevice::Resource> second = device.CreateResource(BufferDesc(24), false);
+
+		CHECK_EQUAL(size_t(2), device.GetStats().numResources);
+		CHECK_EQUAL(size_t(1024), device.GetStats().resourceBytes);
+
+		// gpu addresses are unique, zero stays reserved for null address
+		CHECK(first->GetGPUVirtualAddress() != 0);
+		CHECK(first->GetGPUVirtualAddress() != second->GetGPUVirtualAddress());
+	}
+
+	NullDevice::Stats stats = device.GetStats();
+
+	CHECK_EQUAL(size_t(0), stats.numResources);
+	CHECK_EQUAL(size_t(2), stats.numCreatedResources);
+	CHECK_EQUAL(size_t(0), stats.resourceBytes);
+	CHECK_EQUAL(size_t(1024), stats.peakResourceBytes);
+}
+
+TEST_CASE("resources can outlive the device")
+{
+	std::unique_ptr<NullDevice::Resource> resource;
+
+	{
+		NullDevice device;
+		resource = device.CreateResource(BufferDesc(64), true);
+	}
+
+	CHECK_EQUAL(size_t(64), resource->GetByteSize());
+	resource.reset();
+}
+
+TEST_CASE("texture rows are aligned to pitch alignment")
+{
+	NullDevice device;
+
+	// 100 RGBA8 texels take 400 bytes, upload rows are 512 bytes apart
+	NullDevice::ResourceDesc desc = TextureDesc(100, 50, 32);
+	NullDevice::Footprint footprint = device.GetCopyableFootprint(desc, 0);
+
+	CHECK_EQUAL(size_t(400), footprint.rowSize);
+	CHECK_EQUAL(size_t(512), footprint.rowPitch);
+	CHECK_EQUAL(size_t(50), footprint.numRows);
+	CHECK_EQUAL(size_t(49 * 512 + 400), footprint.totalBytes);
+
+	NullDevice::AllocationInfo allocationInfo = device.GetResourceAllocationInfo(desc);
+
+	CHECK_EQUAL(NullDevice::placementAlignment, allocationInfo.sizeInBytes);
+	CHECK_EQUAL(NullDevice::placementAlignment, allocationInfo.alignment);
+
+	// texture reports memory it would take, not its packed size
+	std::unique_ptr<NullDevice::Resource> texture = device.CreateResource(desc, false);
+	CHECK_EQUAL(NullDevice::placementAlignment, texture->GetByteSize());
+}
+
+TEST_CASE("block compressed footprints count rows of blocks")
+{
+	NullDevice device;
+
+	// BC1 stores 4x4 texels in 8 bytes
+	NullDevice::ResourceDesc desc = TextureDesc(64, 64, 4, 3, true);
+
+	NullDevice::Footprint topMip = device.GetCopyableFootprint(desc, 0);
+	CHECK_EQUAL(size_t(128), topMip.rowSize);
+	CHECK_EQUAL(size_t(16), topMip.numRows);
+	CHECK_EQUAL(64u, topMip.width);
+
+	NullDevice::Footprint secondMip = device.GetCopyableFootprint(desc, 1);
+	CHECK_EQUAL(size_t(64), secondMip.rowSize);
+	CHECK_EQUAL(size_t(8), secondMip.numRows);
+	CHECK_EQUAL(32u, secondMip.width);
+
+	// mips smaller than a block still take one
+	NullDevice::Footprint tinyMip = device.GetCopyableFootprint(TextureDesc(2, 2, 4, 1, true), 0);
+	CHECK_EQUAL(size_t(8), tinyMip.rowSize);
+	CHECK_EQUAL(size_t(1), tinyMip.numRows);
+}
+
+TEST_CASE("only resources with CPU access can be written")
+{
+	NullDevice device;
+
+	std::unique_ptr<NullDevice::Resource> upload = device.CreateResource(TextureDesc(2, 2, 32), true);
+	std::unique_ptr<NullDevice::Resource> gpuOnly = device.CreateResource(TextureDesc(2, 2, 32), false);
+
+	const uint32_t texels[] = { 1, 2, 3, 4 };
+	upload->WriteToSubresource(texels, sizeof(uint32_t) * 2, 2, sizeof(uint32_t) * 2);
+
+	const uint32_t* mapped = static_cast<const uint32_t*>(upload->Map());
+	CHECK(mapped != nullptr);
+	CHECK_EQUAL(3u, mapped[2]);
+
+	CHECK(gpuOnly->Map() == nullptr);
+	CHECK_THROWS(gpuOnly->WriteToSubresource(texels, sizeof(uint32_t) * 2, 2, sizeof(uint32_t) * 2));
+}
+
+TEST_CASE("descriptor heaps don't overlap and only shader visible ones have GPU start")
+{
+	NullDevice device;
+
+	NullDevice::DescriptorHeap first = device.CreateDescriptorHeap(1000, false);
+	NullDevice::DescriptorHeap second = device.CreateDescriptorHeap(1000, true);
+
+	CHECK_EQUAL(uint64_t(0), first.gpuStart);
+	CHECK(second.gpuStart != 0);
+	CHECK(second.cpuStart >= first.cpuStart + 1000 * NullDevice::descriptorHandleIncrementSize);
+	CHECK_EQUAL(size_t(2), device.GetStats().numDescriptorHeaps);
+}
+
+TEST_CASE("back buffer index advances with presents")
+{
+	NullDevice device;
+
+	CHECK_EQUAL(0u, device.GetCurrentBackBufferIndex(2));
+	device.Present();
+	CHECK_EQUAL(1u, device.GetCurrentBackBufferIndex(2));
+	device.Present();
+	CHECK_EQUAL(0u, device.GetCurrentBackBufferIndex(2));
+}
+
+TEST_CASE("recorded and executed work is counted")
+{
+	NullDevice device;
+
+	device.CreateCommandList();
+
+	for (int i = 0; i < 5; i++)
+		device.RecordCommand();
+
+	device.ExecuteCommandLists(1);
+	device.Signal();
+
+	NullDevice::Stats stats = device.GetStats();
+
+	CHECK_EQUAL(size_t(1), stats.numCommandLists);
+	CHECK_EQUAL(size_t(5), stats.numRecordedCommands);
+	CHECK_EQUAL(size_t(1), stats.numExecutedCommandLists);
+	CHECK_EQUAL(size_t(1), stats.numSignals);
+}
\ No newline at end of file
@@ -0,0 +1,281 @@
+#include "TestFramework.h"
+#include "Graphics/Core/OcclusionCuller.h"
+
+namespace
+{
+	// identity view projection, so positions are already in clip space with depth in z
+	OccluderMesh CreateQuad(float minX, float maxX, float depth)
+	{
+		OccluderMesh quad;
+		quad.positions = { { minX, -1.0f, depth }, { maxX, -1.0f, depth }, { minX, 1.0f, depth }, { maxX, 1.0f, depth } };
+		quad.indices = { 0, 2, 1, 1, 2, 3 };
+		quad.boundingBox = BoundingBox(DirectX::XMFLOAT3(minX, -1.0f, depth), DirectX::XMFLOAT3(maxX, 1.0f, depth));
+
+		return quad;
+	}
+
+	BoundingBox CreateBox(float x, float minDepth, float maxDepth)
+	{
+		return BoundingBox(DirectX::XMFLOAT3(x - 0.1f, -0.1f, minDepth), DirectX::XMFLOAT3(x + 0.1f, 0.1f, maxDepth));
+	}
+
+	float GetDepth(const OcclusionCuller& culler, unsigned int x, unsigned int y)
+	{
+		return culler.GetDepth()[y * culler.GetWidth() + x];
+	}
+
+	// flat grid of 0.1 sized quads at z = 0 facing +z, quads for which skipQuad returns true are left out
+	void CreateGrid(unsigned int quadsPerSide, std::vector<DirectX::XMFLOAT3>& positions, std::vector<unsigned int>& indices, const std::function<bool(unsigned int, unsigned int)>& skipQuad = {})
+	{
+		for (unsigned int y = 0; y <= quadsPerSide; y++)
+			for (unsigned int x = 0; x <= quadsPerSide; x++)
+				positions.push_back({ float(x) * 0.1f, float(y) * 0.1f, 0.0f });
+
+		for (unsigned int y = 0; y < quadsPerSide; y++)
+		{
+			for (unsigned int x = 0; x < quadsPerSide; x++)
+			{
+				if (skipQuad && skipQuad(x, y))
+					continue;
+
+				unsigned int corner = y * (quadsPerSide + 1) + x;
+				indices.insert(indices.end(), { corner, corner + 1, corner + quadsPerSide + 1, corner + 1, corner + quadsPerSide + 2, corner + quadsPerSide + 1 });
+			}
+		}
+	}
+
+	float GetSignedArea(const OccluderMesh& mesh, unsigned int triangle)
+	{
+		const DirectX::XMFLOAT3& v0 = mesh.positions[mesh.indices[triangle * 3]];
+		const DirectX::XMFLOAT3& v1 = mesh.positions[mesh.indices[triangle * 3 + 1]];
+		const DirectX::XMFLOAT3& v2 = mesh.positions[mesh.indices[triangle * 3 + 2]];
+
+		return 0.5f * ((v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x));
+	}
+
+	// true when point on z = 0 plane is strictly inside of any triangle
+	bool Covers(const OccluderMesh& mesh, float x, float y)
+	{
+		for (size_t index = 0; index + 2 < mesh.indices.size(); index += 3)
+		{
+			auto edge = [&](unsigned int from, unsigned int to)
+				{
+					const DirectX::XMFLOAT3& a = mesh.positions[mesh.indices[index + from]];
+					const DirectX::XMFLOAT3& b = mesh.positions[mesh.indices[index + to]];
+
+					return (b.x - a.x) * (y - a.y) - (b.y - a.y) * (x - a.x);
+				};
+
+			if (edge(0, 1) > 0.0f && edge(1, 2) > 0.0f && edge(2, 0) > 0.0f)
+				return true;
+		}
+
+		return false;
+	}
+}
+
+TEST_CASE("full screen quad writes its depth to every pixel")
+{
+	OcclusionCuller culler(64, 64);
+	OccluderMesh quad = CreateQuad(-1.0f, 1.0f, 0.5f);
+
+	culler.BeginFrame(DirectX::XMMatrixIdentity());
+	culler.AddOccluder(&quad, DirectX::XMMatrixIdentity());
+	culler.RasterizeOccluders();
+
+	CHECK_EQUAL(1u, culler.GetStats().numOccluders);
+	CHECK_EQUAL(2u, culler.GetStats().numTriangles);
+
+	bool allCovered = true;
+
+	for (float depth : culler.GetDepth())
+		allCovered = allCovered && std::abs(depth - 0.5f) < 0.0001f;
+
+	CHECK(allCovered);
+}
+
+TEST_CASE("quad over left half leaves right half at far plane")
+{
+	OcclusionCuller culler(64, 64);
+	OccluderMesh quad = CreateQuad(-1.0f, 0.0f, 0.25f);
+
+	culler.BeginFrame(DirectX::XMMatrixIdentity());
+	culler.AddOccluder(&quad, DirectX::XMMatrixIdentity());
+	culler.RasterizeOccluders();
+
+	CHECK(std::abs(GetDepth(culler, 0, 0) - 0.25f) < 0.0001f);
+	CHECK(std::abs(GetDepth(culler, 31, 63) - 0.25f) < 0.0001f);
+	CHECK_EQUAL(1.0f, GetDepth(culler, 32, 0));
+	CHECK_EQUAL(1.0f, GetDepth(culler, 63, 63));
+}
+
+TEST_CASE("closer occluder wins regardless of order")
+{
+	OcclusionCuller culler(64, 64);
+	OccluderMesh farQuad = CreateQuad(-1.0f, 1.0f, 0.75f);
+	OccluderMesh nearQuad = CreateQuad(-1.0f, 1.0f, 0.25f);
+
+	culler.BeginFrame(DirectX::XMMatrixIdentity());
+	culler.AddOccluder(&nearQuad, DirectX::XMMatrixIdentity());
+	culler.AddOccluder(&farQuad, DirectX::XMMatrixIdentity());
+	culler.RasterizeOccluders();
+
+	CHECK(std::abs(GetDepth(culler, 20, 20) - 0.25f) < 0.0001f);
+}
+
+TEST_CASE("boxes are hidden only behind occluded pixels")
+{
+	OcclusionCuller culler(64, 64);
+	OccluderMesh quad = CreateQuad(-1.0f, 0.0f, 0.5f);
+
+	culler.BeginFrame(DirectX::XMMatrixIdentity());
+	culler.AddOccluder(&quad, DirectX::XMMatrixIdentity());
+	culler.RasterizeOccluders();
+
+	// behind the quad
+	CHECK(!culler.IsVisible(CreateBox(-0.5f, 0.7f, 0.8f), DirectX::XMMatrixIdentity()));
+
+	// in front of the quad
+	CHECK(culler.IsVisible(CreateBox(-0.5f, 0.2f, 0.3f), DirectX::XMMatrixIdentity()));
+
+	// behind the quad depth, but in the empty half
+	CHECK(culler.IsVisible(CreateBox(0.5f, 0.7f, 0.8f), DirectX::XMMatrixIdentity()));
+
+	// half of the box sticks out of the quad
+	CHECK(culler.IsVisible(CreateBox(0.0f, 0.7f, 0.8f), DirectX::XMMatrixIdentity()));
+
+	// crossing near plane
+	CHECK(culler.IsVisible(CreateBox(-0.5f, -0.1f, 0.8f), DirectX::XMMatrixIdentity()));
+
+	CHECK_EQUAL(5u, culler.GetStats().numTested);
+	CHECK_EQUAL(1u, culler.GetStats().numOccluded);
+}
+
+TEST_CASE("occluders over triangle budget are skipped")
+{
+	OcclusionCuller culler(64, 64);
+	culler.SetBudget({ 8, 3 });
+
+	OccluderMesh first = CreateQuad(-1.0f, 0.0f, 0.5f);
+	OccluderMesh second = CreateQuad(0.0f, 1.0f, 0.5f);
+
+	culler.BeginFrame(DirectX::XMMatrixIdentity());
+	culler.AddOccluder(&first, DirectX::XMMatrixIdentity());
+	culler.AddOccluder(&second, DirectX::XMMatrixIdentity());
+	culler.RasterizeOccluders();
+
+	CHECK_EQUAL(1u, culler.GetStats().numOccluders);
+	CHECK_EQUAL(2u, culler.GetStats().numTriangles);
+}
+
+TEST_CASE("dense mesh is simplified under triangle limit and stays inside its bounds")
+{
+	std::vector<DirectX::XMFLOAT3> positions;
+	std::vector<unsigned int> indices;
+
+	CreateGrid(100, positions, indices);
+
+	std::optional<OccluderMesh> simplified = OcclusionCuller::CreateSimplifiedOccluder(positions, indices);
+
+	CHECK(simplified.has_value());
+
+	if (!simplified)
+		return;
+
+	CHECK(!simplified->indices.empty());
+	CHECK(simplified->indices.size() / 3 <= OcclusionCuller::maxOccluderTriangles);
+	CHECK(simplified->positions.size() < positions.size());
+
+	bool insideBounds = true;
+
+	for (const auto& position : simplified->positions)
+		insideBounds = insideBounds && position.x >= 0.0f && position.x <= 10.0f && position.y >= 0.0f && position.y <= 10.0f && position.z == 0.0f;
+
+	CHECK(insideBounds);
+
+	bool validIndices = true;
+
+	for (unsigned int index : simplified->indices)
+		validIndices = validIndices && index < simplified->positions.size();
+
+	CHECK(validIndices);
+
+	// removed vertices are collapsed into neighbours, so the proxy covers exactly the same square
+	float area = 0.0f;
+
+	for (unsigned int triangle = 0; triangle < simplified->indices.size() / 3; triangle++)
+		area += GetSignedArea(*simplified, triangle);
+
+	CHECK(std::abs(area - 100.0f) < 0.01f);
+}
+
+TEST_CASE("simplified occluder doesn't cover openings of its mesh")
+{
+	// wall with a doorway at its bottom edge and a window in the middle
+	auto isOpening = [](unsigned int x, unsigned int y)
+		{
+			bool doorway = x >= 20 && x < 30 && y < 40;
+			bool window = x >= 50 && x < 60 && y >= 30 && y < 40;
+
+			return doorway || window;
+		};
+
+	std::vector<DirectX::XMFLOAT3> positions;
+	std::vector<unsigned int> indices;
+
+	CreateGrid(80, positions, indices, isOpening);
+
+	std::optional<OccluderMesh> simplified = OcclusionCuller::CreateSimplifiedOccluder(positions, indices, 256);
+
+	CHECK(simplified.has_value());
+
+	if (!simplified)
+		return;
+
+	CHECK(simplified->indices.size() / 3 <= 256);
+
+	bool allFacingFront = true;
+	float area = 0.0f;
+
+	for (unsigned int triangle = 0; triangle < simplified->indices.size() / 3; triangle++)
+	{
+		float triangleArea = GetSignedArea(*simplified, triangle);
+
+		allFacingFront = allFacingFront && triangleArea > 0.0f;
+		area += triangleArea;
+	}
+
+	CHECK(allFacingFront);
+	CHECK(std::abs(area - (64.0f - 4.0f - 1.0f)) < 0.01f);
+
+	bool openingCovered = false;
+
+	for (unsigned int y = 0; y < 80; y++)
+		for (unsigned int x = 0; x < 80; x++)
+			if (isOpening(x, y))
+				openingCovered = openingCovered || Covers(*simplified, float(x) * 0.1f + 0.05f, float(y) * 0.1f + 0.05f);
+
+	CHECK(!openingCovered);
+}
+
+TEST_CASE("dense curved mesh is left out of occluders")
+{
+	std::vector<DirectX::XMFLOAT3> positions;
+	std::vector<unsigned int> indices;
+
+	CreateGrid(100, positions, indices);
+
+	// no triangles around any vertex lie in one plane, so nothing can be removed without covering more than the mesh
+	for (auto& position : positions)
+		position.z = std::sin(position.x) * std::cos(position.y);
+
+	CHECK(!OcclusionCuller::CreateSimplifiedOccluder(positions, indices).has_value());
+}
+
+TEST_CASE("mesh without area can't be simplified")
+{
+	std::vector<DirectX::XMFLOAT3> positions(3, DirectX::XMFLOAT3(1.0f, 1.0f, 1.0f));
+	std::vector<unsigned int> indices = { 0, 1, 2 };
+
+	CHECK(!OcclusionCuller::CreateSimplifiedOccluder(positions, indices).has_value());
+}
\ No newline at end of file
@@ -0,0 +1,269 @@
+#include "TestFramework.h"
+#include "Graphics/RenderGraph/ShadowAtlas.h"
+
+namespace
+{
+	float GetFreeCost(unsigned int, unsigned int)
+	{
+		return 0.0f;
+	}
+
+	std::vector<ShadowAtlas::LightInput> CreateLights(size_t numLights, float screenCoverage)
+	{
+		ShadowAtlas::LightInput light;
+		light.screenCoverage = screenCoverage;
+
+		return std::vector<ShadowAtlas::LightInput>(numLights, light);
+	}
+
+	bool Overlap(const ShadowAtlas::Tile& a, const ShadowAtlas::Tile& b)
+	{
+		return a.x < b.x + b.size && b.x < a.x + a.size && a.y < b.y + b.size && b.y < a.y + a.size;
+	}
+
+	// every face of every light has its own tile inside of the atlas
+	bool TilesArePacked(const ShadowAtlas& atlas, unsigned int numLights)
+	{
+		std::vector<ShadowAtlas::Tile> tiles;
+
+		for (unsigned int light = 0; light < numLights; light++)
+		{
+			for (unsigned int face = 0; face < ShadowAtlas::numFaces; face++)
+			{
+				const ShadowAtlas::Tile& tile = atlas.GetFaceTile(light, face);
+
+				if (!tile.IsValid() || tile.x + tile.size > atlas.GetAtlasSize() || tile.y + tile.size > atlas.GetAtlasSize())
+					return false;
+
+				for (const ShadowAtlas::Tile& otherTile : tiles)
+					if (Overlap(tile, otherTile))
+						return false;
+
+				tiles.push_back(tile);
+			}
+		}
+
+		return true;
+	}
+
+	unsigned int CountFaces(const std::vector<ShadowAtlas::FaceUpdate>& faceUpdates, unsigned int light)
+	{
+		return static_cast<unsigned int>(std::count_if(faceUpdates.begin(), faceUpdates.end(),
+			[light](const ShadowAtlas::FaceUpdate& faceUpdate)
+			{
+				return faceUpdate.light == light;
+			}
+		));
+	}
+}
+
+TEST_CASE("sizes that aren't powers of two are rejected")
+{
+	CHECK_THROWS(ShadowAtlas(1000, 64, 256));
+	CHECK_THROWS(ShadowAtlas(1024, 64, 2048));
+	CHECK_THROWS(ShadowAtlas(1024, 256, 64));
+}
+
+TEST_CASE("tile size follows screen coverage")
+{
+	ShadowAtlas atlas(1024, 64, 256);
+
+	CHECK_EQUAL(64u, atlas.GetTileSize(0.0f));
+	CHECK_EQUAL(128u, atlas.GetTileSize(0.3f));
+	CHECK_EQUAL(256u, atlas.GetTileSize(0.6f));
+	CHECK_EQUAL(256u, atlas.GetTileSize(5.0f));
+}
+
+TEST_CASE("faces of all lights get separate tiles")
+{
+	ShadowAtlas atlas(1024, 64, 256);
+	std::vector<ShadowAtlas::LightInput> lights = CreateLights(3, 1.0f);
+	lights.at(1).screenCoverage = 0.3f;
+	lights.at(2).screenCoverage = 0.0f;
+
+	atlas.Update(lights, GetFreeCost);
+
+	CHECK(TilesArePacked(atlas, 3));
+	CHECK_EQUAL(256u, atlas.GetFaceTile(0, 0).size);
+	CHECK_EQUAL(128u, atlas.GetFaceTile(1, 0).size);
+	CHECK_EQUAL(64u, atlas.GetFaceTile(2, 0).size);
+	CHECK_EQUAL(size_t(3), atlas.GetChangedLights().size());
+}
+
+TEST_CASE("freed tiles merge back into bigger ones")
+{
+	ShadowAtlas atlas(1024, 64, 256);
+
+	// small tiles split most of the quadtree
+	atlas.Update(CreateLights(16, 0.0f), GetFreeCost);
+	CHECK(TilesArePacked(atlas, 16));
+
+	// 12 biggest tiles fit only when all freed small tiles merge again
+	atlas.Update(CreateLights(2, 1.0f), GetFreeCost);
+	CHECK(TilesArePacked(atlas, 2));
+
+	for (unsigned int light = 0; light < 2; light++)
+		for (unsigned int face = 0; face < ShadowAtlas::numFaces; face++)
+			CHECK_EQUAL(256u, atlas.GetFaceTile(light, face).size);
+
+	// and back, the whole atlas is free again after that
+	atlas.Update({}, GetFreeCost);
+	atlas.Update(CreateLights(16, 0.0f), GetFreeCost);
+	CHECK(TilesArePacked(atlas, 16));
+}
+
+TEST_CASE("lights that don't fit get smaller tiles")
+{
+	ShadowAtlas atlas(512, 64, 256);
+	std::vector<ShadowAtlas::LightInput> lights = CreateLights(4, 1.0f);
+	lights.at(3).screenCoverage = 0.9f;
+
+	atlas.Update(lights, GetFreeCost);
+
+	CHECK(TilesArePacked(atlas, 4));
+
+	// the least important light is halved first
+	CHECK(atlas.GetFaceTile(3, 0).size <= atlas.GetFaceTile(0, 0).size);
+}
+
+TEST_CASE("smaller coverage keeps tiles within hysteresis")
+{
+	ShadowAtlas atlas(1024, 64, 256);
+	std::vector<ShadowAtlas::LightInput> lights = CreateLights(1, 0.5f);
+
+	atlas.Update(lights, GetFreeCost);
+	CHECK_EQUAL(128u, atlas.GetFaceTile(0, 0).size);
+
+	lights.at(0).screenCoverage = 0.45f;
+	atlas.Update(lights, GetFreeCost);
+	CHECK_EQUAL(128u, atlas.GetFaceTile(0, 0).size);
+	CHECK(atlas.GetChangedLights().empty());
+
+	lights.at(0).screenCoverage = 0.2f;
+	atlas.Update(lights, GetFreeCost);
+	CHECK_EQUAL(64u, atlas.GetFaceTile(0, 0).size);
+	CHECK_EQUAL(size_t(1), atlas.GetChangedLights().size());
+}
+
+TEST_CASE("faces above the frame budget wait for next frames")
+{
+	ShadowAtlas atlas(1024, 64, 256);
+	atlas.SetBudget({ 12, 2.5f });
+
+	auto getFaceCost = [](unsigned int, unsigned int)
+		{
+			return 1.0f;
+		};
+
+	std::vector<ShadowAtlas::LightInput> lights = CreateLights(1, 1.0f);
+
+	CHECK_EQUAL(size_t(2), atlas.Update(lights, getFaceCost).size());
+	CHECK_EQUAL(size_t(2), atlas.Update(lights, getFaceCost).size());
+	CHECK(!atlas.IsLightReady(0));
+	CHECK_EQUAL(size_t(2), atlas.Update(lights, getFaceCost).size());
+	CHECK(atlas.IsLightReady(0));
+	CHECK(atlas.Update(lights, getFaceCost).empty());
+}
+
+TEST_CASE("one face is rendered even when it is over the budget")
+{
+	ShadowAtlas atlas(1024, 64, 256);
+	atlas.SetBudget({ 12, 2.0f });
+
+	auto getFaceCost = [](unsigned int, unsigned int)
+		{
+			return 10.0f;
+		};
+
+	std::vector<ShadowAtlas::LightInput> lights = CreateLights(1, 1.0f);
+
+	for (unsigned int frame = 0; frame < ShadowAtlas::numFaces; frame++)
+	{
+		CHECK(!atlas.IsLightReady(0));
+		CHECK_EQUAL(size_t(1), atlas.Update(lights, getFaceCost).size());
+	}
+
+	CHECK(atlas.IsLightReady(0));
+}
+
+TEST_CASE("face count budget limits updates")
+{
+	ShadowAtlas atlas(1024, 64, 256);
+	atlas.SetBudget({ 4, 100.0f });
+
+	std::vector<ShadowAtlas::LightInput> lights = CreateLights(2, 0.0f);
+
+	CHECK_EQUAL(size_t(4), atlas.Update(lights, GetFreeCost).size());
+	CHECK_EQUAL(size_t(4), atlas.Update(lights, GetFreeCost).size());
+	CHECK_EQUAL(size_t(4), atlas.Update(lights, GetFreeCost).size());
+	CHECK(atlas.IsLightReady(0));
+	CHECK(atlas.IsLightReady(1));
+}
+
+TEST_CASE("outdated faces are rendered again and light stays ready")
+{
+	ShadowAtlas atlas(1024, 64, 256);
+	std::vector<ShadowAtlas::LightInput> lights = CreateLights(1, 1.0f);
+
+	CHECK_EQUAL(size_t(ShadowAtlas::numFaces), atlas.Update(lights, GetFreeCost).size());
+	CHECK(atlas.IsLightReady(0));
+	CHECK_EQUAL(size_t(1), atlas.GetChangedLights().size());
+
+	lights.at(0).outdatedFaces.at(2) = true;
+	const std::vector<ShadowAtlas::FaceUpdate>& faceUpdates = atlas.Update(lights, GetFreeCost);
+
+	CHECK_EQUAL(size_t(1), faceUpdates.size());
+	CHECK_EQUAL(2u, faceUpdates.front().face);
+	CHECK(atlas.IsLightReady(0));
+	CHECK(atlas.GetChangedLights().empty());
+}
+
+TEST_CASE("lights that aren't ready are finished first")
+{
+	ShadowAtlas atlas(1024, 64, 256);
+	atlas.SetBudget({ ShadowAtlas::numFaces, 100.0f });
+
+	std::vector<ShadowAtlas::LightInput> lights = CreateLights(1, 1.0f);
+	atlas.Update(lights, GetFreeCost);
+	CHECK(atlas.IsLightReady(0));
+
+	// ready light covering the whole screen waits for the small new one
+	lights.push_back({});
+	lights.at(0).outdatedFaces.fill(true);
+
+	const std::vector<ShadowAtlas::FaceUpdate>& faceUpdates = atlas.Update(lights, GetFreeCost);
+
+	CHECK_EQUAL(ShadowAtlas::numFaces, CountFaces(faceUpdates, 1));
+	CHECK_EQUAL(0u, CountFaces(faceUpdates, 0));
+	CHECK(atlas.IsLightReady(0));
+	CHECK(atlas.IsLightReady(1));
+
+	lights.at(0).outdatedFaces.fill(false);
+	CHECK_EQUAL(ShadowAtlas::numFaces, CountFaces(atlas.Update(lights, GetFreeCost), 0));
+}
+
+TEST_CASE("light with new tiles isn't ready until all faces are rendered")
+{
+	ShadowAtlas atlas(1024, 64, 256);
+	atlas.SetBudget({ 3, 100.0f });
+
+	std::vector<ShadowAtlas::LightInput> lights = CreateLights(1, 0.0f);
+
+	atlas.Update(lights, GetFreeCost);
+	atlas.Update(lights, GetFreeCost);
+	CHECK(atlas.IsLightReady(0));
+
+	// bigger tiles don't have any depth yet
+	lights.at(0).screenCoverage = 1.0f;
+	atlas.Update(lights, GetFreeCost);
+	CHECK(!atlas.IsLightReady(0));
+	CHECK_EQUAL(256u, atlas.GetFaceTile(0, 0).size);
+
+	atlas.Update(lights, GetFreeCost);
+	CHECK(atlas.IsLightReady(0));
+
+	// removed light is never ready
+	atlas.Update({}, GetFreeCost);
+	CHECK(!atlas.IsLightReady(0));
+	CHECK_THROWS(atlas.GetFaceTile(0, 0));
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#pragma once
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+#define TEST_CONCAT_INNER(a, b) a##b
+#define TEST_CONCAT(a, b) TEST_CONCAT_INNER(a, b)
+
+#define TEST_CASE(name) \
+	static void TEST_CONCAT(TestFunction_, __LINE__)(); \
+	static TestFramework::Registrar TEST_CONCAT(testRegistrar_, __LINE__)(name, &TEST_CONCAT(TestFunction_, __LINE__)); \
+	static void TEST_CONCAT(TestFunction_, __LINE__)()
+
+#define CHECK(statement) \
+	do { if (!(statement)) TestFramework::ReportFailure(__FILE__, __LINE__, #statement); } while (0)
+
+#define CHECK_EQUAL(expected, actual) \
+	do { if (!((expected) == (actual))) TestFramework::ReportFailure(__FILE__, __LINE__, #expected " == " #actual); } while (0)
+
+#define CHECK_THROWS(statement) \
+	do \
+	{ \
+		bool thrown = false; \
+		try { statement; } catch (...) { thrown = true; } \
+		if (!thrown) TestFramework::ReportFailure(__FILE__, __LINE__, #statement " throws"); \
+	} while (0)
+
+// minimal test registry, every TEST_CASE registers itself before main runs
+namespace TestFramework
+{
+	struct TestCase
+	{
+		const char* name;
+		std::function<void()> function;
+	};
+
+	inline std::vector<TestCase>& GetTestCases()
+	{
+		static std::vector<TestCase> testCases;
+		return testCases;
+	}
+
+	inline unsigned int& GetNumFailures()
+	{
+		static unsigned int numFailures = 0;
+		return numFailures;
+	}
+
+	struct Registrar
+	{
+		Registrar(const char* name, std::function<void()> function)
+		{
+			GetTestCases().push_back({ name, std::move(function) });
+		}
+	};
+
+	inline void ReportFailure(const char* file, int line, const char* expression)
+	{
+		std::printf("%s(%d): check failed: %s\n", file, line, expression);
+		GetNumFailures()++;
+	}
+
+	inline int RunAll()
+	{
+		for (const TestCase& testCase : GetTestCases())
+		{
+			unsigned int failuresBefore = GetNumFailures();
+
+			try
+			{
+				testCase.function();
+			}
+			catch (...)
+			{
+				std::printf("%s: unexpected exception\n", testCase.name);
+				GetNumFailures()++;
+			}
+
+			std::printf("[%s] %s\n", GetNumFailures() == failuresBefore ? "passed" : "FAILED", testCase.name);
+		}
+
+		return GetNumFailures() == 0 ? 0 : 1;
+	}
+}
\ No newline at end of file
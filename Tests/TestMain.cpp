@@ -0,0 +1,6 @@
+#include "TestFramework.h"
+
+int main()
+{
+	return TestFramework::RunAll();
+}
\ No newline at end of file